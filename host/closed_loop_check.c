@@ -0,0 +1,222 @@
+/*H**********************************************************************
+ * FILENAME :        closed_loop_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the encoder monitor and the autotune search.
+ *
+ * NOTES :
+ *       The encoder monitor must find stalls and following errors, also
+ *       across the wrap of the count, and the autotune search must end within
+ *       its resolution and margin below the limits of a simulated motor.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: closed_loop_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <math.h>
+#include "closed_loop.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 200000 // Random inputs per check
+#define CHECK_VALUE_TOLERANCE 1e-9L     // Allowed long double error of a found value
+#define CHECK_AUTOTUNE_TRIALS 10000     // A search running longer than this does not end
+
+/**
+ * @brief Trial of the autotune on a motor whose torque falls linearly to 0 at the pull-out frequency.
+ */
+static bool Autotune_Trial_Passes(uint32_t Frequency_Hz, uint32_t Acceleration, uint32_t Max_Frequency_Hz, uint32_t Max_Acceleration, uint32_t Pull_Out_Hz)
+{
+    return (Frequency_Hz <= Max_Frequency_Hz) && (Frequency_Hz < Pull_Out_Hz) &&
+           ((uint64_t)Acceleration * Pull_Out_Hz <= (uint64_t)Max_Acceleration * (Pull_Out_Hz - Frequency_Hz));
+}
+
+/**
+ * @brief Check a found value against the highest passing one of its phase.
+ */
+static bool Autotune_Value_Fits(uint32_t Value, uint32_t Limit, const Autotune_Config_t *Config)
+{
+    long double Highest = (long double)Limit * Config->Margin_Percent / 100;
+    long double Lowest = Highest / (1.0L + (Config->Resolution_Percent / 100.0L)) - 1;
+
+    return (Value <= Highest + CHECK_VALUE_TOLERANCE) && (Value >= Lowest);
+}
+
+static void Check_Closed_Loop(uint32_t Iterations)
+{
+    Closed_Loop_Config_t Config;
+    Closed_Loop_Monitor_t Monitor;
+    char Detail[200];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        int32_t Counts = (int32_t)Host_Check_Random_Value();
+        int32_t Counts_Per_Step_Q16 = (int32_t)(Host_Check_Random() % 0x7FFFFF) + 1;
+
+        Counts_Per_Step_Q16 = (Host_Check_Random() & 1) ? -Counts_Per_Step_Q16 : Counts_Per_Step_Q16;
+
+        Closed_Loop_Default_Config(&Config, Counts_Per_Step_Q16);
+
+        long double Exact = (long double)Counts * 65536 / Counts_Per_Step_Q16;
+        long double Expected = (Exact < 0) ? -floorl(-Exact + 0.5L) : floorl(Exact + 0.5L);
+
+        if ((fabsl(Expected) < INT32_MAX) && (Closed_Loop_Counts_To_Steps(&Config, Counts) != (int32_t)Expected))
+        {
+            snprintf(Detail, sizeof(Detail), "%" PRId32 " counts at %" PRId32 " Q16", Counts, Counts_Per_Step_Q16);
+            Host_Check_Fail("closed_loop_steps", Detail);
+        }
+    }
+
+    Closed_Loop_Default_Config(&Config, 5 << 14); // 1.25 counts per step, 4000 counts per revolution at 3200 steps
+
+    int32_t Counts_Start = INT32_MAX - 1000; // The count wraps during the moves
+    int32_t Commanded = 0;
+
+    Closed_Loop_Begin(&Monitor, &Config, 100, Counts_Start);
+
+    for (Commanded = 100; Commanded <= 10100; Commanded++)
+    {
+        if (Closed_Loop_Update(&Monitor, Commanded, (int32_t)((uint32_t)Counts_Start + (uint32_t)(((Commanded - 100) * 5) / 4))) != CLOSED_LOOP_OK)
+        {
+            Host_Check_Fail("closed_loop_follow", "fault on an exact follow");
+            break;
+        }
+    }
+
+    if (Monitor.Max_Error > 1)
+    {
+        Host_Check_Fail("closed_loop_follow", "error above a step on an exact follow");
+    }
+
+    Closed_Loop_Begin(&Monitor, &Config, 0, Counts_Start);
+
+    for (Commanded = 0; (Commanded < 1000) && (Closed_Loop_Update(&Monitor, Commanded, Counts_Start + 5) == CLOSED_LOOP_OK); Commanded++)
+    {
+    }
+
+    if ((Monitor.Fault != CLOSED_LOOP_STALL) || (Commanded != CLOSED_LOOP_DEFAULT_STALL_STEPS))
+    {
+        Host_Check_Fail("closed_loop_stall", "stall not found after the stall steps");
+    }
+
+    if (Closed_Loop_Update(&Monitor, 4, Counts_Start + 5) != CLOSED_LOOP_STALL)
+    {
+        Host_Check_Fail("closed_loop_stall", "fault not latched");
+    }
+
+    Closed_Loop_Begin(&Monitor, &Config, 0, Counts_Start);
+
+    for (Commanded = 0; (Commanded < 1000) && (Closed_Loop_Update(&Monitor, Commanded, Counts_Start + (((Commanded / 2) * 5) / 4)) == CLOSED_LOOP_OK); Commanded++)
+    {
+    }
+
+    if ((Monitor.Fault != CLOSED_LOOP_FOLLOWING_ERROR) || (Monitor.Max_Error != CLOSED_LOOP_DEFAULT_FOLLOWING_LIMIT + 1))
+    {
+        Host_Check_Fail("closed_loop_following", "slip at half speed not found at the following limit");
+    }
+
+    uint32_t Searches = Iterations / 100;
+    uint32_t Results = 0;
+
+    for (uint32_t Iteration = 0; Iteration < Searches; Iteration++)
+    {
+        Autotune_Search_t Search;
+        Autotune_Config_t Search_Config = {
+            .Start_Frequency_Hz = (uint32_t)(Host_Check_Random() % 5000) + 1,      // First frequency
+            .Max_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000) + 5000,   // Highest frequency
+            .Start_Acceleration = (uint32_t)(Host_Check_Random() % 50000) + 1,     // First acceleration
+            .Max_Acceleration = (uint32_t)(Host_Check_Random() % 2000000) + 50000, // Highest acceleration
+            .Growth_Percent = (uint32_t)(Host_Check_Random() % 100) + 1,           // Growth until the first failure
+            .Resolution_Percent = (uint32_t)(Host_Check_Random() % 10),            // End of the halving
+            .Margin_Percent = (uint32_t)(Host_Check_Random() % 100) + 1,           // Share taken
+        };
+        uint32_t Motor_Max_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000) + 1;
+        uint32_t Motor_Max_Acceleration = (uint32_t)(Host_Check_Random() % 2000000) + 1;
+        uint32_t Pull_Out_Hz = Motor_Max_Frequency_Hz + (uint32_t)(Host_Check_Random() % 100000) + 1;
+        uint32_t Frequency_Hz = 0;
+        uint32_t Acceleration = 0;
+        uint32_t Trials = 0;
+
+        snprintf(Detail, sizeof(Detail), "motor %" PRIu32 " Hz, %" PRIu32 " steps/s^2, pull-out %" PRIu32 " Hz, search %" PRIu32 "-%" PRIu32 " Hz, %" PRIu32 "-%" PRIu32 " steps/s^2",
+                 Motor_Max_Frequency_Hz, Motor_Max_Acceleration, Pull_Out_Hz, Search_Config.Start_Frequency_Hz, Search_Config.Max_Frequency_Hz,
+                 Search_Config.Start_Acceleration, Search_Config.Max_Acceleration);
+
+        if (!Autotune_Begin(&Search, &Search_Config))
+        {
+            Host_Check_Fail("autotune_begin", Detail);
+            continue;
+        }
+
+        for (; (Trials < CHECK_AUTOTUNE_TRIALS) && Autotune_Next_Trial(&Search, &Frequency_Hz, &Acceleration); Trials++)
+        {
+            Autotune_Report(&Search, Autotune_Trial_Passes(Frequency_Hz, Acceleration, Motor_Max_Frequency_Hz, Motor_Max_Acceleration, Pull_Out_Hz));
+        }
+
+        bool Start_Passes = Autotune_Trial_Passes(Search_Config.Start_Frequency_Hz, Search_Config.Start_Acceleration, Motor_Max_Frequency_Hz, Motor_Max_Acceleration, Pull_Out_Hz);
+
+        if (Trials == CHECK_AUTOTUNE_TRIALS)
+        {
+            Host_Check_Fail("autotune_end", Detail);
+            continue;
+        }
+
+        if (!Autotune_Result(&Search, &Frequency_Hz, &Acceleration))
+        {
+            if (Start_Passes && Autotune_Trial_Passes(Search.Frequency_Hz, Search_Config.Start_Acceleration, Motor_Max_Frequency_Hz, Motor_Max_Acceleration, Pull_Out_Hz))
+            {
+                Host_Check_Fail("autotune_result", Detail); // Both start values pass, a result is expected
+            }
+
+            continue;
+        }
+
+        Results++;
+
+        uint32_t Frequency_Limit_Hz = 0;
+        uint32_t Acceleration_Limit = 0;
+
+        for (uint32_t Step = 1U << 31; Step > 0; Step >>= 1) // Highest passing values by bisection of the monotone model
+        {
+            uint32_t Frequency_Try = Frequency_Limit_Hz + Step;
+            uint32_t Acceleration_Try = Acceleration_Limit + Step;
+
+            Frequency_Limit_Hz = ((Frequency_Try > Frequency_Limit_Hz) && (Frequency_Try <= Search_Config.Max_Frequency_Hz) &&
+                                  Autotune_Trial_Passes(Frequency_Try, Search_Config.Start_Acceleration, Motor_Max_Frequency_Hz, Motor_Max_Acceleration, Pull_Out_Hz))
+                                     ? Frequency_Try
+                                     : Frequency_Limit_Hz;
+            Acceleration_Limit = ((Acceleration_Try > Acceleration_Limit) && (Acceleration_Try <= Search_Config.Max_Acceleration) &&
+                                  Autotune_Trial_Passes(Search.Frequency_Hz, Acceleration_Try, Motor_Max_Frequency_Hz, Motor_Max_Acceleration, Pull_Out_Hz))
+                                     ? Acceleration_Try
+                                     : Acceleration_Limit;
+        }
+
+        if (!Autotune_Value_Fits(Frequency_Hz, Frequency_Limit_Hz, &Search_Config) || !Autotune_Value_Fits(Acceleration, Acceleration_Limit, &Search_Config))
+        {
+            Host_Check_Fail("autotune_limits", Detail);
+        }
+    }
+
+    printf("closed_loop  : %" PRIu32 " conversions, %" PRIu32 " searches, %" PRIu32 " with a result\n", Iterations, Searches, Results);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Closed_Loop(Iterations);
+
+    return Host_Check_Result();
+}
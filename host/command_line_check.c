@@ -0,0 +1,196 @@
+/*H**********************************************************************
+ * FILENAME :        command_line_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the console command line parser.
+ *
+ * NOTES :
+ *       Console lines must split and parse into the expected values or fail
+ *       at the expected word, and the line editor must drop escape sequences
+ *       and lines longer than its buffer.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: command_line_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "command_line.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 200000 // Random integers parsed
+
+/**
+ * @brief Split and parse one line with the options of Check_Command_Line().
+ *
+ * @return Result of the split or the parse.
+ */
+static Command_Parse_Result_t Parse_Check_Line(const char *Text, const Command_Option_t *Options, size_t Option_Count, Command_Value_t *Values, int *Error_Position)
+{
+    static char Line[COMMAND_LINE_MAX_LENGTH + 1]; // The text values point into it after the return
+    char *Words[COMMAND_LINE_MAX_WORDS];
+
+    snprintf(Line, sizeof(Line), "%s", Text);
+
+    int Word_Count = Command_Line_Split(Line, Words, COMMAND_LINE_MAX_WORDS);
+
+    if (Word_Count < 0)
+    {
+        return COMMAND_PARSE_SPLIT_FAILED;
+    }
+
+    return Command_Line_Parse(Options, Option_Count, Word_Count, Words, Values, Error_Position);
+}
+
+static void Check_Command_Line(uint32_t Iterations)
+{
+    static const Command_Option_t Options[] = {
+        {"frq", COMMAND_OPTION_INT, true, "<t>", "Frequency"},
+        {"save", COMMAND_OPTION_FLAG, false, NULL, "Save"},
+        {NULL, COMMAND_OPTION_TEXT, false, "<file>", "File"},
+        {"angle", COMMAND_OPTION_TEXT, false, "<t>", "Angle"},
+    };
+    static const struct
+    {
+        const char *Line;              // Command line
+        Command_Parse_Result_t Result; // Expected result
+        int Error_Position;            // Expected word or option of a failure
+        int32_t Frequency;             // Expected --frq if parsed
+        const char *File;              // Expected positional argument if parsed
+    } Cases[] = {
+        {"run --frq 1000", COMMAND_PARSE_OK, 0, 1000, ""},
+        {"run --frq=-5 --save \"a b.txt\"", COMMAND_PARSE_OK, 0, -5, "a b.txt"},
+        {"run a\\ b --frq 0x10", COMMAND_PARSE_OK, 0, 16, "a b"},
+        {"run --frq -2147483648", COMMAND_PARSE_OK, 0, INT32_MIN, ""},
+        {"run --frq 2147483648", COMMAND_PARSE_BAD_VALUE, 2, 0, NULL},
+        {"run --frq 12x", COMMAND_PARSE_BAD_VALUE, 2, 0, NULL},
+        {"run --frq=", COMMAND_PARSE_BAD_VALUE, 1, 0, NULL},
+        {"run --save=1 --frq 1", COMMAND_PARSE_BAD_VALUE, 1, 0, NULL},
+        {"run --frq", COMMAND_PARSE_NO_VALUE, 1, 0, NULL},
+        {"run --fr 1", COMMAND_PARSE_UNKNOWN, 1, 0, NULL},
+        {"run --frqq 1", COMMAND_PARSE_UNKNOWN, 1, 0, NULL},
+        {"run --frq 1 --frq 2", COMMAND_PARSE_REPEATED, 3, 0, NULL},
+        {"run a b --frq 1", COMMAND_PARSE_EXTRA_WORD, 2, 0, NULL},
+        {"run --save a", COMMAND_PARSE_MISSING, 0, 0, NULL},
+        {"run --frq 1 \"open", COMMAND_PARSE_SPLIT_FAILED, 0, 0, NULL},
+        {"run 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16", COMMAND_PARSE_SPLIT_FAILED, 0, 0, NULL},
+    };
+    const size_t Option_Count = sizeof(Options) / sizeof(Options[0]);
+    Command_Value_t Values[COMMAND_LINE_MAX_OPTIONS];
+    char Detail[300];
+
+    for (size_t Case = 0; Case < sizeof(Cases) / sizeof(Cases[0]); Case++)
+    {
+        int Error_Position = 0;
+        Command_Parse_Result_t Result = Parse_Check_Line(Cases[Case].Line, Options, Option_Count, Values, &Error_Position);
+
+        snprintf(Detail, sizeof(Detail), "'%s': %s at %d", Cases[Case].Line, Command_Parse_Result_Name(Result), Error_Position);
+
+        if ((Result != Cases[Case].Result) || ((Result != COMMAND_PARSE_OK) && (Result != COMMAND_PARSE_SPLIT_FAILED) && (Error_Position != Cases[Case].Error_Position)) ||
+            ((Result == COMMAND_PARSE_OK) && ((Values[0].Value != Cases[Case].Frequency) || (strcmp(Values[2].Text, Cases[Case].File) != 0))))
+        {
+            Host_Check_Fail("command_parse", Detail);
+        }
+    }
+
+    int Error_Position = 0;
+
+    if ((Parse_Check_Line("run --frq 7", Options, Option_Count, Values, &Error_Position) != COMMAND_PARSE_OK) || (Values[1].Count != 0) || (Values[3].Count != 0) ||
+        (strcmp(Values[3].Text, "") != 0) || (Parse_Check_Line("  run\t--frq 7 --angle=1.5 --save  ", Options, Option_Count, Values, &Error_Position) != COMMAND_PARSE_OK) ||
+        (Values[1].Count != 1) || (strcmp(Values[3].Text, "1.5") != 0))
+    {
+        Host_Check_Fail("command_parse", "values of the options not given or given");
+    }
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        int32_t Value = (int32_t)Host_Check_Random_Value();
+        char Text[64];
+
+        snprintf(Text, sizeof(Text), (Iteration & 1) ? "run --frq=%" PRId32 : "run --frq %" PRId32, Value);
+
+        if ((Parse_Check_Line(Text, Options, Option_Count, Values, &Error_Position) != COMMAND_PARSE_OK) || (Values[0].Value != Value))
+        {
+            Host_Check_Fail("command_parse_int", Text);
+        }
+    }
+
+    static const struct
+    {
+        const char *Input;         // Received bytes
+        Command_Line_Event_t Last; // Event of the last byte
+        const char *Text;          // Line once done
+    } Edits[] = {
+        {"move\r", COMMAND_LINE_DONE, "move"},
+        {"mpv\x7F\x7Fove\n", COMMAND_LINE_DONE, "move"},
+        {"\bmo\x1B[A\x1B[1;5Dve\r", COMMAND_LINE_DONE, "move"},
+        {"mo\x1BOCve\x03\r", COMMAND_LINE_DONE, "move"},
+        {"\r", COMMAND_LINE_DONE, ""},
+    };
+    Command_Line_t Line;
+    Command_Line_Event_t Event = COMMAND_LINE_NONE;
+
+    memset(&Line, 0, sizeof(Line));
+
+    for (size_t Edit = 0; Edit < sizeof(Edits) / sizeof(Edits[0]); Edit++)
+    {
+        for (const char *Byte = Edits[Edit].Input; *Byte != '\0'; Byte++)
+        {
+            Event = Command_Line_Feed(&Line, (uint8_t)*Byte);
+        }
+
+        if ((Event != Edits[Edit].Last) || (strcmp(Line.Text, Edits[Edit].Text) != 0))
+        {
+            snprintf(Detail, sizeof(Detail), "edit %zu: '%s'", Edit, Line.Text);
+            Host_Check_Fail("command_edit", Detail);
+        }
+
+        Command_Line_Reset(&Line);
+    }
+
+    Event = Command_Line_Feed(&Line, 'a');
+    Event = (Event == COMMAND_LINE_ECHO) ? Command_Line_Feed(&Line, '\r') : Event;
+    Command_Line_Reset(&Line);
+
+    if ((Event != COMMAND_LINE_DONE) || (Command_Line_Feed(&Line, '\n') != COMMAND_LINE_NONE) || (Command_Line_Feed(&Line, '\n') != COMMAND_LINE_DONE))
+    {
+        Host_Check_Fail("command_edit", "CRLF ends more or less than one line");
+    }
+
+    Command_Line_Reset(&Line);
+
+    for (uint32_t Byte = 0; Byte <= COMMAND_LINE_MAX_LENGTH; Byte++)
+    {
+        Event = Command_Line_Feed(&Line, 'x');
+    }
+
+    if ((Event != COMMAND_LINE_NONE) || (Command_Line_Feed(&Line, '\r') != COMMAND_LINE_TOO_LONG) || (Command_Line_Feed(&Line, 'y') != COMMAND_LINE_ECHO) ||
+        (Command_Line_Feed(&Line, '\r') != COMMAND_LINE_DONE) || (strcmp(Line.Text, "y") != 0))
+    {
+        Host_Check_Fail("command_edit", "line longer than the buffer not dropped");
+    }
+
+    printf("command_line : %zu lines, %" PRIu32 " integers, %zu edits\n", sizeof(Cases) / sizeof(Cases[0]), Iterations, sizeof(Edits) / sizeof(Edits[0]));
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Command_Line(Iterations);
+
+    return Host_Check_Result();
+}
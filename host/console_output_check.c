@@ -0,0 +1,142 @@
+/*H**********************************************************************
+ * FILENAME :        console_output_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the output ring of the console.
+ *
+ * NOTES :
+ *       The console output ring must hand out what was written with CRLF line
+ *       endings, in order across the wrap of its indices, and drop a write
+ *       whole exactly when it does not fit.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: console_output_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "console_output.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 200000 // Random ring operations
+
+static void Check_Console_Output(uint32_t Iterations)
+{
+    static Console_Output_t Output;
+    static uint8_t Expected[CONSOLE_OUTPUT_BUFFER_SIZE]; // Bytes the ring must hand out, at the same indices
+    char Text[CONSOLE_OUTPUT_BUFFER_SIZE / 4];
+    uint32_t Pending = 0; // Bytes the ring must hold
+    uint32_t Written = 0;
+    uint32_t Dropped = 0;
+    uint32_t Drops = 0;
+    uint32_t High_Water = 0;
+    char Detail[96];
+
+    Console_Output_Reset(&Output);
+
+    Output.Head = UINT32_MAX - (CONSOLE_OUTPUT_BUFFER_SIZE / 2); // Both indices wrap early in the run
+    Output.Tail = Output.Head;
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        snprintf(Detail, sizeof(Detail), "iteration %" PRIu32 ", %" PRIu32 " pending", Iteration, Pending);
+
+        if (Console_Output_Pending(&Output) != Pending)
+        {
+            Host_Check_Fail("output_pending", Detail);
+        }
+
+        if ((Host_Check_Random() % 3) != 0)
+        {
+            size_t Length = (size_t)(Host_Check_Random() % sizeof(Text));
+            size_t Needed = Length;
+
+            for (size_t Index = 0; Index < Length; Index++)
+            {
+                Text[Index] = ((Host_Check_Random() % 8) == 0) ? '\n' : (char)(' ' + (Host_Check_Random() % 95));
+                Needed += (Text[Index] == '\n') ? 1 : 0;
+            }
+
+            bool Fits = (Needed <= (CONSOLE_OUTPUT_BUFFER_SIZE - Pending));
+
+            if (Console_Output_Write(&Output, Text, Length) != Fits)
+            {
+                Host_Check_Fail("output_write", Detail);
+            }
+
+            if (!Fits)
+            {
+                Dropped += (uint32_t)Length;
+                Drops++;
+                continue;
+            }
+
+            uint32_t Head = Output.Tail + Pending;
+
+            for (size_t Index = 0; Index < Length; Index++)
+            {
+                if (Text[Index] == '\n')
+                {
+                    Expected[Head++ & (CONSOLE_OUTPUT_BUFFER_SIZE - 1)] = '\r';
+                }
+
+                Expected[Head++ & (CONSOLE_OUTPUT_BUFFER_SIZE - 1)] = (uint8_t)Text[Index];
+            }
+
+            Pending += (uint32_t)Needed;
+            Written += (uint32_t)Needed;
+            High_Water = (Pending > High_Water) ? Pending : High_Water;
+        }
+        else
+        {
+            const uint8_t *Data = NULL;
+            uint32_t Offset = Output.Tail & (CONSOLE_OUTPUT_BUFFER_SIZE - 1);
+            size_t Length = Console_Output_Peek(&Output, &Data);
+            size_t Contiguous = CONSOLE_OUTPUT_BUFFER_SIZE - Offset;
+
+            if ((Length != ((Pending < Contiguous) ? Pending : Contiguous)) || ((Length > 0) && (memcmp(Data, &Expected[Offset], Length) != 0)))
+            {
+                Host_Check_Fail("output_peek", Detail);
+            }
+
+            size_t Sent = (Length == 0) ? 0 : (size_t)(Host_Check_Random() % (Length + 1)); // Also a part, like a short UART write
+
+            Console_Output_Consume(&Output, Sent);
+            Pending -= (uint32_t)Sent;
+        }
+    }
+
+    if ((Output.Written != Written) || (Output.Dropped != Dropped) || (Output.Drops != Drops) || (Output.High_Water != High_Water))
+    {
+        Host_Check_Fail("output_counters", "counters differ from the writes");
+    }
+
+    if (!Console_Output_Write(&Output, "", 0) || (Console_Output_Pending(&Output) != Pending))
+    {
+        Host_Check_Fail("output_empty", "an empty write must fit and add nothing");
+    }
+
+    printf("console out  : %" PRIu32 " operations, %" PRIu32 " writes dropped\n", Iterations, Drops);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Console_Output(Iterations);
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,96 @@
+/*H**********************************************************************
+ * FILENAME :        dda_bench.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host benchmark of the DDA step interpolator.
+ *
+ * NOTES :
+ *       Times the same 4 axis line and full circle as the dda_bench console
+ *       command on the ESP32, see Multi_Axis_Benchmark(), and reports the
+ *       interpolator ticks and the steps of all axes per second, so a change
+ *       of the interpolator can be compared before it is flashed.
+ *
+ *       Usage: dda_bench [repeat]
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "dda_interpolator.h"
+
+#define BENCH_TICKS 100000 // Ticks of one line, same as MULTI_AXIS_BENCHMARK_TICKS
+
+/**
+ * @brief Seconds since an earlier time.
+ */
+static double Seconds_Since(const struct timespec *Start)
+{
+    struct timespec End;
+
+    clock_gettime(CLOCK_MONOTONIC, &End);
+
+    return (End.tv_sec - Start->tv_sec) + ((End.tv_nsec - Start->tv_nsec) / 1e9);
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t Delta[DDA_MAX_AXES] = {BENCH_TICKS, -71234, 33333, -777};
+    uint32_t Repeat = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 100;
+    uint64_t Line_Ticks = 0;
+    uint64_t Line_Steps = 0;
+    uint64_t Arc_Ticks = 0;
+    uint8_t Direction_Mask = 0;
+    struct timespec Start;
+
+    if (Repeat == 0)
+    {
+        fprintf(stderr, "Usage: %s [repeat]\n", argv[0]);
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+
+    for (uint32_t Run = 0; Run < Repeat; Run++)
+    {
+        DDA_Line_t Line;
+
+        DDA_Line_Begin(&Line, Delta, DDA_MAX_AXES);
+
+        while (!DDA_Line_Done(&Line))
+        {
+            Line_Steps += __builtin_popcount(DDA_Line_Step(&Line, &Direction_Mask));
+            Line_Ticks++;
+        }
+    }
+
+    double Line_Seconds = Seconds_Since(&Start);
+
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+
+    for (uint32_t Run = 0; Run < Repeat; Run++)
+    {
+        DDA_Arc_t Arc;
+
+        DDA_Arc_Begin(&Arc, BENCH_TICKS / 6, 0, BENCH_TICKS / 6, 0, false); // Full circle of about the same tick count
+
+        while (!DDA_Arc_Done(&Arc))
+        {
+            DDA_Arc_Step(&Arc, &Direction_Mask);
+            Arc_Ticks++;
+        }
+    }
+
+    double Arc_Seconds = Seconds_Since(&Start);
+
+    printf("LINE        : %.0f ticks/s, 4 axes, %llu ticks\n", Line_Ticks / Line_Seconds, (unsigned long long)Line_Ticks);
+    printf("AGGREGATE   : %.0f steps/s of all axes\n", Line_Steps / Line_Seconds);
+    printf("ARC         : %.0f ticks/s, %llu ticks\n", Arc_Ticks / Arc_Seconds, (unsigned long long)Arc_Ticks);
+    printf("TICK COST   : %.1f ns line, %.1f ns arc\n", (Line_Seconds * 1e9) / Line_Ticks, (Arc_Seconds * 1e9) / Arc_Ticks);
+
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*H**********************************************************************
+ * FILENAME :        dda_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the DDA step interpolator of the multi-axis moves.
+ *
+ * NOTES :
+ *       Every axis of a line must have exactly its Bresenham share of steps
+ *       after every tick, the minor axes centred inside the major axis
+ *       steps, so all axes are on their target at the last tick and none
+ *       steps after it, axes without steps and single axis lines included.
+ *       An arc must stay within one step of its circle and end exactly on
+ *       its end point, in the tick count DDA_Arc_Count_Ticks() planned.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: dda_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <math.h>
+#include "dda_interpolator.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 2000 // Random lines and arcs
+#define CHECK_MAX_LINE_STEPS 20000    // Longest random axis delta
+#define CHECK_MAX_RADIUS 3000         // Largest random arc radius
+
+/**
+ * @brief Run one line to its end and check every tick against the exact Bresenham share.
+ */
+static void Check_Line(const int32_t *Delta, uint8_t Axis_Count)
+{
+    DDA_Line_t Line;
+    uint32_t Steps[DDA_MAX_AXES] = {0};
+    uint64_t Major_Steps = 0;
+    uint8_t Expected_Direction = 0;
+    uint8_t Direction_Mask = 0;
+    char Detail[160];
+
+    snprintf(Detail, sizeof(Detail), "%u axes, delta %" PRId32 " %" PRId32 " %" PRId32 " %" PRId32, Axis_Count, Delta[0], (Axis_Count > 1) ? Delta[1] : 0,
+             (Axis_Count > 2) ? Delta[2] : 0, (Axis_Count > 3) ? Delta[3] : 0);
+
+    for (uint8_t Axis = 0; Axis < Axis_Count; Axis++)
+    {
+        uint64_t Abs_Delta = (uint64_t)llabs(Delta[Axis]);
+
+        Major_Steps = (Abs_Delta > Major_Steps) ? Abs_Delta : Major_Steps;
+        Expected_Direction |= (Delta[Axis] < 0) ? (uint8_t)(1U << Axis) : 0;
+    }
+
+    DDA_Line_Begin(&Line, Delta, Axis_Count);
+
+    for (uint64_t Tick = 1; Tick <= Major_Steps; Tick++)
+    {
+        if (DDA_Line_Done(&Line))
+        {
+            Host_Check_Fail("line_done_early", Detail);
+            return;
+        }
+
+        uint8_t Step_Mask = DDA_Line_Step(&Line, &Direction_Mask);
+
+        if (Direction_Mask != Expected_Direction)
+        {
+            Host_Check_Fail("line_direction", Detail);
+            return;
+        }
+
+        for (uint8_t Axis = 0; Axis < Axis_Count; Axis++)
+        {
+            uint64_t Abs_Delta = (uint64_t)llabs(Delta[Axis]);
+            uint64_t Expected = ((Tick * Abs_Delta) + (Major_Steps / 2)) / Major_Steps; // Accumulator starts at half a major step, the share is rounded
+
+            if ((Step_Mask & (1U << Axis)) != 0)
+            {
+                Steps[Axis]++;
+            }
+
+            if (Steps[Axis] != Expected)
+            {
+                Host_Check_Fail("line_bresenham", Detail);
+                return;
+            }
+
+            if ((Abs_Delta == Major_Steps) && ((Step_Mask & (1U << Axis)) == 0))
+            {
+                Host_Check_Fail("line_major_axis", Detail); // The longest axis steps on every tick
+                return;
+            }
+        }
+
+        if ((Step_Mask >> Axis_Count) != 0)
+        {
+            Host_Check_Fail("line_extra_axis", Detail);
+            return;
+        }
+    }
+
+    for (uint8_t Axis = 0; Axis < Axis_Count; Axis++)
+    {
+        if (Steps[Axis] != (uint32_t)llabs(Delta[Axis]))
+        {
+            Host_Check_Fail("line_steps", Detail); // Every axis is on its target at the last tick
+        }
+    }
+
+    if (!DDA_Line_Done(&Line) || (DDA_Line_Step(&Line, &Direction_Mask) != 0))
+    {
+        Host_Check_Fail("line_done", Detail);
+    }
+}
+
+/**
+ * @brief Random lines, with axes left out, single axis lines and zero length lines.
+ */
+static void Check_Lines(uint32_t Iterations)
+{
+    int32_t Delta[DDA_MAX_AXES];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        uint8_t Axis_Count = (uint8_t)(1 + (Host_Check_Random() % DDA_MAX_AXES));
+
+        for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+        {
+            uint64_t Random = Host_Check_Random();
+
+            Delta[Axis] = ((Random % 4) == 0) ? 0 : (int32_t)((Random >> 8) % (2 * CHECK_MAX_LINE_STEPS + 1)) - CHECK_MAX_LINE_STEPS; // A quarter of the axes stand still
+        }
+
+        Check_Line(Delta, Axis_Count);
+    }
+
+    const int32_t Zero[DDA_MAX_AXES] = {0, 0, 0, 0};
+    const int32_t Single[DDA_MAX_AXES] = {-1234, 0, 0, 0};
+    const int32_t Equal[DDA_MAX_AXES] = {500, -500, 500, -500};
+    const int32_t One_Step[DDA_MAX_AXES] = {0, 0, 1, 0};
+
+    Check_Line(Zero, DDA_MAX_AXES);
+    Check_Line(Single, 1);
+    Check_Line(Single, DDA_MAX_AXES);
+    Check_Line(Equal, DDA_MAX_AXES);
+    Check_Line(One_Step, DDA_MAX_AXES);
+
+    printf("dda lines    : %" PRIu32 " random, 5 fixed\n", Iterations);
+}
+
+/**
+ * @brief Run one arc to its end and check that it stays on its circle and ends on its end point.
+ */
+static void Check_Arc(int32_t Start_X, int32_t Start_Y, int32_t End_X, int32_t End_Y, bool Clockwise)
+{
+    DDA_Arc_t Arc;
+    uint8_t Direction_Mask = 0;
+    int32_t X = Start_X;
+    int32_t Y = Start_Y;
+    double Radius = sqrt(((double)Start_X * Start_X) + ((double)Start_Y * Start_Y));
+    char Detail[160];
+
+    snprintf(Detail, sizeof(Detail), "start %" PRId32 " %" PRId32 ", end %" PRId32 " %" PRId32 ", %s", Start_X, Start_Y, End_X, End_Y, Clockwise ? "cw" : "ccw");
+
+    if (!DDA_Arc_Begin(&Arc, Start_X, Start_Y, End_X, End_Y, Clockwise))
+    {
+        Host_Check_Fail("arc_begin", Detail);
+        return;
+    }
+
+    uint32_t Planned_Ticks = DDA_Arc_Count_Ticks(Start_X, Start_Y, End_X, End_Y, Clockwise);
+
+    while (!DDA_Arc_Done(&Arc))
+    {
+        uint8_t Step_Mask = DDA_Arc_Step(&Arc, &Direction_Mask);
+
+        if ((Step_Mask == 0) || ((Step_Mask & ~0x03U) != 0) || ((Direction_Mask & ~Step_Mask) != 0))
+        {
+            Host_Check_Fail("arc_step", Detail);
+            return;
+        }
+
+        X += ((Step_Mask & 0x01) == 0) ? 0 : (((Direction_Mask & 0x01) != 0) ? -1 : 1);
+        Y += ((Step_Mask & 0x02) == 0) ? 0 : (((Direction_Mask & 0x02) != 0) ? -1 : 1);
+
+        if ((X != Arc.X) || (Y != Arc.Y) || (fabs(sqrt(((double)X * X) + ((double)Y * Y)) - Radius) > 1.0))
+        {
+            Host_Check_Fail("arc_circle", Detail);
+            return;
+        }
+    }
+
+    if ((X != End_X) || (Y != End_Y))
+    {
+        Host_Check_Fail("arc_end", Detail);
+    }
+
+    if ((Arc.Tick != Planned_Ticks) || (Arc.Tick >= Arc.Max_Ticks))
+    {
+        Host_Check_Fail("arc_ticks", Detail); // Ended by the safety limit or not in the planned tick count
+    }
+
+    if (DDA_Arc_Step(&Arc, &Direction_Mask) != 0)
+    {
+        Host_Check_Fail("arc_done", Detail);
+    }
+}
+
+/**
+ * @brief Random arcs in both directions, full circles and arcs of a few steps.
+ */
+static void Check_Arcs(uint32_t Iterations)
+{
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        double Radius = 2.0 + (double)(Host_Check_Random() % CHECK_MAX_RADIUS);
+        double Start_Angle = (double)(Host_Check_Random() % 3600) * M_PI / 1800.0;
+        double End_Angle = (double)(Host_Check_Random() % 3600) * M_PI / 1800.0;
+        int32_t Start_X = (int32_t)lround(Radius * cos(Start_Angle));
+        int32_t Start_Y = (int32_t)lround(Radius * sin(Start_Angle));
+        double Start_Radius = sqrt(((double)Start_X * Start_X) + ((double)Start_Y * Start_Y)); // End on the circle of the rounded start
+
+        Check_Arc(Start_X, Start_Y, (int32_t)lround(Start_Radius * cos(End_Angle)), (int32_t)lround(Start_Radius * sin(End_Angle)), (Host_Check_Random() & 1) != 0);
+    }
+
+    Check_Arc(1000, 0, 1000, 0, false); // Full circles
+    Check_Arc(0, -777, 0, -777, true);
+    Check_Arc(1000, 0, 0, 1000, false); // Quarter circles
+    Check_Arc(1000, 0, 0, -1000, true);
+    Check_Arc(1, 0, 0, 1, false); // Smallest radius
+    Check_Arc(500, 0, 500, 1, false);
+    Check_Arc(500, 0, 500, 1, true); // Almost a full circle the long way round
+
+    printf("dda arcs     : %" PRIu32 " random, 7 fixed\n", Iterations);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Lines(Iterations);
+    Check_Arcs(Iterations);
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,200 @@
+/*H**********************************************************************
+ * FILENAME :        gcode_bench.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host benchmark of the G-code parser and look-ahead planner.
+ *
+ * NOTES :
+ *       Runs a recorded G-code file through the same parser, look-ahead
+ *       planner and block planner as the G-code task on the ESP32 and
+ *       reports the throughput and how much of the path keeps its speed
+ *       across block junctions.
+ *
+ *       Usage: gcode_bench <file.gcode> [repeat]
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "gcode_parser.h"
+#include "lookahead_planner.h"
+#include "motion_planner.h"
+
+#define BENCH_PATH_ACCELERATION 100000.0f // Same as GCODE_PATH_ACCELERATION on the target
+#define BENCH_SEGMENT_TIME_US 10000       // Same as MOTION_SEGMENT_TIME_US at 100 Hz ticks
+
+/** Counters of one benchmark run */
+typedef struct
+{
+    uint32_t Lines;        // Lines read
+    uint32_t Errors;       // Lines rejected by the parser or interpreter
+    uint32_t Blocks;       // Blocks planned
+    uint32_t Flying_Joins; // Blocks entered at a non-zero speed
+    uint64_t Planned_us;   // Planned duration of all blocks
+    uint32_t Max_Segments; // Largest segment table of one block
+} Bench_Result_t;
+
+/**
+ * @brief Plan the oldest block of the look-ahead planner like the motion task does.
+ */
+static bool Plan_Next_Block(Lookahead_Planner_t *Planner, Bench_Result_t *Result)
+{
+    static Motion_Profile_t Profile;
+    Lookahead_Output_t Block;
+
+    if (!Lookahead_Pop_Block(Planner, &Block))
+    {
+        return false;
+    }
+
+    Motion_Planner_Config_t Config = {
+        .Max_Frequency_Hz = Block.Nominal_Frequency_Hz, // Cruise frequency of the longest axis
+        .Acceleration = Block.Acceleration,             // Acceleration of the longest axis
+        .Jerk = 0,                                      // Blocks use trapezoidal ramps
+        .Segment_Time_us = BENCH_SEGMENT_TIME_US,       // Ramp slice duration
+    };
+
+    Motion_Planner_Plan_Block(&Config, Block.Major_Steps, Block.Entry_Frequency_Hz, Block.Exit_Frequency_Hz, &Profile);
+
+    Result->Blocks++;
+    Result->Flying_Joins += (Block.Entry_Frequency_Hz > 0) ? 1 : 0;
+    Result->Planned_us += Profile.Duration_us;
+    Result->Max_Segments = (Profile.Segment_Count > Result->Max_Segments) ? Profile.Segment_Count : Result->Max_Segments;
+
+    return true;
+}
+
+/**
+ * @brief Run all lines of a program through the interpreter and planners.
+ */
+static void Run_Program(char **Lines, uint32_t Line_Count, Bench_Result_t *Result)
+{
+    Gcode_Config_t Config;
+    Gcode_State_t State;
+    Lookahead_Planner_t Planner;
+
+    Gcode_Default_Config(&Config);
+    Gcode_Init(&State, &Config);
+    Lookahead_Init(&Planner, BENCH_PATH_ACCELERATION, LOOKAHEAD_DEFAULT_JUNCTION_DEVIATION);
+
+    for (uint32_t Index = 0; Index < Line_Count; Index++)
+    {
+        Gcode_Block_t Block;
+        Gcode_Action_t Action;
+
+        Result->Lines++;
+
+        if (!Gcode_Parse_Line(Lines[Index], &Block) || !Gcode_Execute_Block(&State, &Block, &Action))
+        {
+            Result->Errors++;
+            continue;
+        }
+
+        if (Action.Type == GCODE_ACTION_MOVE)
+        {
+            if (Lookahead_Is_Full(&Planner))
+            {
+                Plan_Next_Block(&Planner, Result);
+            }
+
+            Lookahead_Add_Block(&Planner, Action.Steps, Action.Nominal_Speed);
+        }
+        else if (Action.Type != GCODE_ACTION_NONE)
+        {
+            while (Plan_Next_Block(&Planner, Result))
+            {
+                // Dwell and driver commands stop the path
+            }
+        }
+    }
+
+    while (Plan_Next_Block(&Planner, Result))
+    {
+        // End of program
+    }
+}
+
+/**
+ * @brief Read a file into memory, one string per line without line endings.
+ */
+static char **Load_Lines(const char *Path, uint32_t *Line_Count)
+{
+    FILE *File = fopen(Path, "r");
+    char Buffer[GCODE_MAX_LINE_LENGTH + 1];
+    char **Lines = NULL;
+    uint32_t Capacity = 0;
+
+    *Line_Count = 0;
+
+    if (File == NULL)
+    {
+        return NULL;
+    }
+
+    while (fgets(Buffer, sizeof(Buffer), File) != NULL)
+    {
+        Buffer[strcspn(Buffer, "\r\n")] = '\0';
+
+        if (*Line_Count == Capacity)
+        {
+            Capacity = (Capacity == 0) ? 1024 : (2 * Capacity);
+            Lines = realloc(Lines, Capacity * sizeof(*Lines));
+        }
+
+        Lines[(*Line_Count)++] = strdup(Buffer);
+    }
+
+    fclose(File);
+
+    return Lines;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Line_Count = 0;
+    Bench_Result_t Result = {0};
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <file.gcode> [repeat]\n", argv[0]);
+        return 1;
+    }
+
+    uint32_t Repeat = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+    char **Lines = Load_Lines(argv[1], &Line_Count);
+
+    if (Lines == NULL)
+    {
+        fprintf(stderr, "Cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    struct timespec Start;
+    struct timespec End;
+
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+
+    for (uint32_t Run = 0; Run < Repeat; Run++)
+    {
+        Run_Program(Lines, Line_Count, &Result);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &End);
+
+    double Seconds = (End.tv_sec - Start.tv_sec) + ((End.tv_nsec - Start.tv_nsec) / 1e9);
+
+    printf("LINES       : %u (%u errors)\n", Result.Lines, Result.Errors);
+    printf("BLOCKS      : %u, %u entered at speed\n", Result.Blocks, Result.Flying_Joins);
+    printf("PLAN TIME   : %.3f s\n", Seconds);
+    printf("THROUGHPUT  : %.0f lines/s, %.0f blocks/s\n", Result.Lines / Seconds, Result.Blocks / Seconds);
+    printf("MOTION TIME : %.3f s per run\n", (Result.Planned_us / 1e6) / Repeat);
+    printf("MAX SEGMENTS: %u per block\n", Result.Max_Segments);
+
+    return 0;
+}
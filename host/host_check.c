@@ -0,0 +1,95 @@
+/*H**********************************************************************
+ * FILENAME :        host_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Common part of the host checks: the seeded random inputs, the
+ *       failure count and the command line.
+ *
+ * NOTES :
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "host_check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+static uint64_t Random_State = 0x9E3779B97F4A7C15ULL; // Fixed seed of the xorshift generator
+static uint32_t Failures = 0;                         // Failed checks
+
+/**
+ * @brief Next pseudo random value, xorshift64*.
+ */
+uint64_t Host_Check_Random(void)
+{
+    Random_State ^= Random_State >> 12;
+    Random_State ^= Random_State << 25;
+    Random_State ^= Random_State >> 27;
+
+    return Random_State * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Pseudo random value with a random bit length, so small and large values are both covered.
+ */
+uint64_t Host_Check_Random_Value(void)
+{
+    uint8_t Bits = (uint8_t)(Host_Check_Random() % 65);
+
+    return (Bits == 64) ? Host_Check_Random() : (Host_Check_Random() & ((1ULL << Bits) - 1));
+}
+
+/**
+ * @brief Count and report a failed check.
+ */
+void Host_Check_Fail(const char *Check, const char *Detail)
+{
+    if (Failures < HOST_CHECK_MAX_REPORTED)
+    {
+        printf("FAIL %s: %s\n", Check, Detail);
+    }
+
+    Failures++;
+}
+
+/**
+ * @brief Read the optional iteration count of the command line.
+ *
+ * @param argc Argument count of main().
+ * @param argv Arguments of main().
+ * @param Default_Iterations Iterations without an argument.
+ * @param Iterations Returns the iterations to run.
+ * @return false after printing the usage if the arguments are wrong.
+ */
+bool Host_Check_Arguments(int argc, char **argv, uint32_t Default_Iterations, uint32_t *Iterations)
+{
+    *Iterations = Default_Iterations;
+
+    if (argc == 2)
+    {
+        *Iterations = (uint32_t)strtoul(argv[1], NULL, 10);
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Print the result line.
+ *
+ * @return Exit status of the check, 1 if a check failed.
+ */
+int Host_Check_Result(void)
+{
+    printf("%s: %" PRIu32 " failed checks\n", (Failures == 0) ? "PASS" : "FAIL", Failures);
+
+    return (Failures == 0) ? 0 : 1;
+}
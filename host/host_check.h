@@ -0,0 +1,32 @@
+/*H**********************************************************************
+ * FILENAME :        host_check.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Common part of the host checks: the seeded random inputs, the
+ *       failure count and the command line.
+ *
+ * NOTES :
+ *       Every check executable starts from the same seed, so every run of
+ *       it checks the same values.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HOST_CHECK_MAX_REPORTED 20 // Failures printed, the rest are only counted
+
+uint64_t Host_Check_Random(void);
+uint64_t Host_Check_Random_Value(void);
+void Host_Check_Fail(const char *Check, const char *Detail);
+bool Host_Check_Arguments(int argc, char **argv, uint32_t Default_Iterations, uint32_t *Iterations);
+int Host_Check_Result(void);
+
+#endif // HOST_CHECK_H
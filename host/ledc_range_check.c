@@ -0,0 +1,153 @@
+/*H**********************************************************************
+ * FILENAME :        ledc_range_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the LEDC range selection of the step output.
+ *
+ * NOTES :
+ *       Every LEDC step frequency must get the lowest duty resolution with a
+ *       valid divider, the nearest divider and the achieved frequency and
+ *       error of a long double reference, and the duty scaled for a peak
+ *       frequency must stay below the full count at every lower frequency.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: ledc_range_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <math.h>
+#include "ledc_range.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 200000 // Random step frequencies
+
+/**
+ * @brief Nearest divider of a clock for a frequency at a resolution, in 10.8 fixed point.
+ */
+static uint64_t Ledc_Reference_Divider(Ledc_Range_Clock_t Clock, uint32_t Frequency_Hz, uint8_t Bits)
+{
+    return (uint64_t)llroundl(((long double)Ledc_Range_Clock_Hz(Clock) * 256.0L) / ((long double)Frequency_Hz * (long double)(1ULL << Bits)));
+}
+
+static void Check_Ledc_Range(uint32_t Iterations)
+{
+    char Detail[160];
+    uint32_t Selected = 0;
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        uint32_t Frequency_Hz = (uint32_t)(Host_Check_Random_Value() % (LEDC_RANGE_MAX_FREQUENCY_HZ + 2ULL)); // Also 0 and one above the range
+        uint8_t Min_Bits = ((Iteration % 4) == 0) ? (uint8_t)(Host_Check_Random() % (LEDC_RANGE_MAX_BITS + 2)) : LEDC_RANGE_MIN_BITS;
+        uint8_t Lowest_Bits = (Min_Bits < LEDC_RANGE_MIN_BITS) ? LEDC_RANGE_MIN_BITS : Min_Bits;
+        Ledc_Range_t Range;
+
+        snprintf(Detail, sizeof(Detail), "%" PRIu32 " Hz from %u bits", Frequency_Hz, Min_Bits);
+
+        if (!Ledc_Range_Select(Frequency_Hz, Min_Bits, &Range))
+        {
+            bool Fits = false;
+
+            for (int Clock = LEDC_RANGE_APB; (Frequency_Hz > 0) && (Clock <= LEDC_RANGE_REF_TICK); Clock++)
+            {
+                for (uint8_t Bits = Lowest_Bits; Bits <= LEDC_RANGE_MAX_BITS; Bits++)
+                {
+                    uint64_t Divider = Ledc_Reference_Divider((Ledc_Range_Clock_t)Clock, Frequency_Hz, Bits);
+
+                    Fits = Fits || ((Divider >= LEDC_RANGE_MIN_DIVIDER) && (Divider <= LEDC_RANGE_MAX_DIVIDER));
+                }
+            }
+
+            if (Fits)
+            {
+                Host_Check_Fail("ledc_range_rejected", Detail);
+            }
+
+            continue;
+        }
+
+        Selected++;
+
+        uint64_t Divider = Ledc_Reference_Divider(Range.Clock, Frequency_Hz, Range.Resolution_Bits);
+        long double Achieved_Hz = ((long double)Ledc_Range_Clock_Hz(Range.Clock) * 256.0L) / ((long double)Range.Divider * (long double)(1ULL << Range.Resolution_Bits));
+        long double Error_ppb = ((Achieved_Hz / (long double)Frequency_Hz) - 1.0L) * 1e9L;
+
+        if ((Range.Requested_Hz != Frequency_Hz) || (Range.Resolution_Bits < Lowest_Bits) || (Range.Resolution_Bits > LEDC_RANGE_MAX_BITS) ||
+            (Range.Divider < LEDC_RANGE_MIN_DIVIDER) || (Range.Divider > LEDC_RANGE_MAX_DIVIDER) || (Range.Divider != Divider))
+        {
+            Host_Check_Fail("ledc_range_divider", Detail);
+        }
+        else if ((Range.Resolution_Bits > Lowest_Bits) && (Ledc_Reference_Divider(Range.Clock, Frequency_Hz, Range.Resolution_Bits - 1) <= LEDC_RANGE_MAX_DIVIDER))
+        {
+            Host_Check_Fail("ledc_range_resolution", Detail); // A lower resolution had a valid divider
+        }
+        else if ((fabsl((long double)Range.Achieved_mHz - (Achieved_Hz * 1000.0L)) > 0.5001L) || (fabsl((long double)Range.Error_ppb - Error_ppb) > 1.0L) ||
+                 (fabsl(Error_ppb) > (1e9L / (2.0L * (long double)Range.Divider)) + 1.0L))
+        {
+            Host_Check_Fail("ledc_range_error", Detail);
+        }
+
+        uint32_t Duty = (uint32_t)(Host_Check_Random() % ((1U << LEDC_RANGE_DUTY_BITS) + 1));
+        uint32_t Duty_Register = Ledc_Range_Duty(&Range, Duty);
+        uint8_t Duty_Bits = Ledc_Range_Duty_Bits(Duty_Register);
+        uint32_t Lower_Hz = (uint32_t)(1 + (Host_Check_Random() % Frequency_Hz));
+        Ledc_Range_t Lower;
+
+        if (((Duty == 0) != (Duty_Register == 0)) || (Duty_Register >= (1UL << Range.Resolution_Bits)) || (Duty_Bits > Range.Resolution_Bits))
+        {
+            Host_Check_Fail("ledc_range_duty", Detail);
+        }
+        else if (!Ledc_Range_Select(Lower_Hz, Duty_Bits, &Lower) || (Duty_Register >= (1UL << Lower.Resolution_Bits)))
+        {
+            snprintf(Detail, sizeof(Detail), "duty %" PRIu32 " of %" PRIu32 " Hz at %" PRIu32 " Hz", Duty_Register, Frequency_Hz, Lower_Hz);
+            Host_Check_Fail("ledc_range_duty_fit", Detail); // The running output would stay high and lose steps
+        }
+    }
+
+    static const struct
+    {
+        uint32_t Frequency_Hz; // Requested frequency
+        uint8_t Bits;          // Expected resolution
+        uint32_t Duty;         // Expected register of PWM_DUTY_CYCLE_50
+    } Cases[] = {
+        {1000, 7, 64},
+        {20000, 2, 2},
+        {400000, 1, 1},
+        {40000000, 1, 1},
+    };
+
+    for (size_t Case = 0; Case < sizeof(Cases) / sizeof(Cases[0]); Case++)
+    {
+        Ledc_Range_t Range;
+
+        if (!Ledc_Range_Select(Cases[Case].Frequency_Hz, LEDC_RANGE_MIN_BITS, &Range) || (Range.Resolution_Bits != Cases[Case].Bits) ||
+            (Ledc_Range_Duty(&Range, 512) != Cases[Case].Duty) || (Range.Error_ppb != 0))
+        {
+            snprintf(Detail, sizeof(Detail), "%" PRIu32 " Hz", Cases[Case].Frequency_Hz);
+            Host_Check_Fail("ledc_range_case", Detail);
+        }
+    }
+
+    printf("ledc_range   : %" PRIu32 " frequencies, %" PRIu32 " selected\n", Iterations, Selected);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Ledc_Range(Iterations);
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,362 @@
+/*H**********************************************************************
+ * FILENAME :        motion_math_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the integer motion math and the generated ramp tables.
+ *
+ * NOTES :
+ *       Compares main/motion_math.c with the 128 bit integers of the host
+ *       compiler, the ramps of the planner with the ideal positions in long
+ *       double precision and every generated ramp table with the segments the
+ *       planner computes at runtime.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: motion_math_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+#include "motion_math.h"
+#include "motion_planner.h"
+#include "ramp_tables.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 200000 // Random inputs per check
+#define CHECK_RAMP_ITERATIONS 20000     // Random ramps and moves checked
+#define CHECK_SEGMENT_TIME_US 10000     // Same as MOTION_SEGMENT_TIME_US at 100 Hz ticks
+#define CHECK_POSITION_TOLERANCE 1e-9L  // Allowed long double error on top of half a step
+
+typedef unsigned __int128 uint128_t;
+
+/**
+ * @brief Reference of Motion_Math_Mul_Div() and Motion_Math_Mul_Div_Round().
+ */
+static uint64_t Reference_Mul_Div(uint64_t A, uint64_t B, uint64_t Divisor, bool Round)
+{
+    if (Divisor == 0)
+    {
+        return UINT64_MAX;
+    }
+
+    uint128_t Product = (uint128_t)A * B;
+    uint128_t Quotient = Product / Divisor;
+    uint128_t Remainder = Product % Divisor;
+
+    if (Round && ((2 * Remainder) >= Divisor))
+    {
+        Quotient++;
+    }
+
+    return (Quotient > UINT64_MAX) ? UINT64_MAX : (uint64_t)Quotient;
+}
+
+static void Check_Mul_Div(uint32_t Iterations)
+{
+    static const uint64_t Edges[] = {0, 1, 2, 3, 0xFFFFFFFFULL, 0x100000000ULL, 0x7FFFFFFFFFFFFFFFULL, UINT64_MAX - 1, UINT64_MAX};
+    const size_t Edge_Count = sizeof(Edges) / sizeof(Edges[0]);
+    char Detail[128];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations + (Edge_Count * Edge_Count * Edge_Count); Iteration++)
+    {
+        uint64_t A = 0;
+        uint64_t B = 0;
+        uint64_t Divisor = 0;
+
+        if (Iteration < (Edge_Count * Edge_Count * Edge_Count))
+        {
+            A = Edges[Iteration % Edge_Count];
+            B = Edges[(Iteration / Edge_Count) % Edge_Count];
+            Divisor = Edges[Iteration / (Edge_Count * Edge_Count)];
+        }
+        else
+        {
+            A = Host_Check_Random_Value();
+            B = Host_Check_Random_Value();
+            Divisor = Host_Check_Random_Value();
+        }
+
+        uint128_t Product = (uint128_t)A * B;
+
+        if ((Motion_Math_Mul_Div(A, B, Divisor) != Reference_Mul_Div(A, B, Divisor, false)) ||
+            (Motion_Math_Mul_Div_Round(A, B, Divisor) != Reference_Mul_Div(A, B, Divisor, true)) ||
+            (Motion_Math_Mul_Sat(A, B) != ((Product > UINT64_MAX) ? UINT64_MAX : (uint64_t)Product)))
+        {
+            snprintf(Detail, sizeof(Detail), "%" PRIu64 " * %" PRIu64 " / %" PRIu64, A, B, Divisor);
+            Host_Check_Fail("mul_div", Detail);
+        }
+    }
+
+    printf("mul_div      : %" PRIu32 " cases\n", Iterations);
+}
+
+static void Check_Isqrt(uint32_t Iterations)
+{
+    char Detail[64];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        uint64_t Value = Host_Check_Random_Value();
+
+        if ((Iteration % 3) == 1) // Perfect squares and their neighbours
+        {
+            uint64_t Root = Host_Check_Random() & 0xFFFFFFFFULL;
+
+            Value = (Root * Root) - ((Root > 0) && (Iteration % 2) ? 1 : 0);
+        }
+
+        uint64_t Root = Motion_Math_Isqrt(Value);
+
+        if (((uint128_t)Root * Root > Value) || ((uint128_t)(Root + 1) * (Root + 1) <= Value))
+        {
+            snprintf(Detail, sizeof(Detail), "isqrt(%" PRIu64 ") = %" PRIu64, Value, Root);
+            Host_Check_Fail("isqrt", Detail);
+        }
+    }
+
+    if (Motion_Math_Isqrt(UINT64_MAX) != UINT32_MAX)
+    {
+        Host_Check_Fail("isqrt", "isqrt(UINT64_MAX)");
+    }
+
+    printf("isqrt        : %" PRIu32 " cases\n", Iterations);
+}
+
+static void Check_Parse_Fixed(void)
+{
+    static const struct
+    {
+        const char *Text;
+        bool Valid;
+        int64_t Value;
+    } Cases[] = {
+        {"90", true, 90000000},
+        {"90.5", true, 90500000},
+        {"0.1125", true, 112500},
+        {"-45.25", true, -45250000},
+        {"+1.", true, 1000000},
+        {".5", true, 500000},
+        {"0.0000005", true, 1},
+        {"0.00000049", true, 0},
+        {"359.9999999", true, 360000000},
+        {"9223372036854.775807", true, INT64_MAX},
+        {"9223372036854.775808", false, 0},
+        {"", false, 0},
+        {"-", false, 0},
+        {".", false, 0},
+        {"1.2.3", false, 0},
+        {"12a", false, 0},
+        {"1e3", false, 0},
+    };
+    char Detail[96];
+
+    for (size_t Index = 0; Index < (sizeof(Cases) / sizeof(Cases[0])); Index++)
+    {
+        int64_t Value = 0;
+        bool Valid = Motion_Math_Parse_Fixed(Cases[Index].Text, MOTION_MATH_ANGLE_DECIMALS, &Value);
+
+        if ((Valid != Cases[Index].Valid) || (Valid && (Value != Cases[Index].Value)))
+        {
+            snprintf(Detail, sizeof(Detail), "'%s' gave %d %" PRId64, Cases[Index].Text, Valid, Value);
+            Host_Check_Fail("parse_fixed", Detail);
+        }
+    }
+
+    printf("parse_fixed  : %zu cases\n", sizeof(Cases) / sizeof(Cases[0]));
+}
+
+static void Check_Steps(uint32_t Iterations)
+{
+    char Detail[96];
+    uint32_t Steps = 0;
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        uint32_t Steps_Per_Revolution = (uint32_t)Host_Check_Random_Value();
+        uint64_t Angle_udeg = Host_Check_Random_Value() >> 1;
+        uint64_t Expected = Reference_Mul_Div(Steps_Per_Revolution, Angle_udeg, MOTION_MATH_REVOLUTION_UDEG, true);
+        bool Valid = Motion_Math_Steps_For_Angle(Steps_Per_Revolution, Angle_udeg, &Steps);
+
+        if ((Valid != (Expected <= UINT32_MAX)) || (Valid && (Steps != Expected)))
+        {
+            snprintf(Detail, sizeof(Detail), "%" PRIu32 " steps, %" PRIu64 " udeg", Steps_Per_Revolution, Angle_udeg);
+            Host_Check_Fail("steps_for_angle", Detail);
+        }
+
+        uint32_t Rotations = (uint32_t)Host_Check_Random_Value();
+        uint64_t Product = (uint64_t)Steps_Per_Revolution * Rotations;
+
+        Valid = Motion_Math_Steps_For_Rotations(Steps_Per_Revolution, Rotations, &Steps);
+
+        if ((Valid != (Product <= UINT32_MAX)) || (Valid && (Steps != Product)))
+        {
+            snprintf(Detail, sizeof(Detail), "%" PRIu32 " steps, %" PRIu32 " rotations", Steps_Per_Revolution, Rotations);
+            Host_Check_Fail("steps_for_rotations", Detail);
+        }
+    }
+
+    // The float conversion this replaced gave 0 steps for 0.1125 degrees at 3200 steps
+    if (!Motion_Math_Steps_For_Angle(3200, 1000000, &Steps) || (Steps != 9) ||
+        !Motion_Math_Steps_For_Angle(3200, 112500, &Steps) || (Steps != 1) ||
+        !Motion_Math_Steps_For_Angle(200, 90000000, &Steps) || (Steps != 50))
+    {
+        Host_Check_Fail("steps_for_angle", "known angles");
+    }
+
+    printf("steps        : %" PRIu32 " cases\n", Iterations);
+}
+
+/**
+ * @brief Check one ramp against the ideal constant acceleration positions.
+ *
+ * Every segment has to end at the rounded ideal position of a slice
+ * boundary, and the segments have to add up to the ramp steps exactly.
+ */
+static void Check_Ramp(uint32_t Start_Frequency_Hz, uint32_t End_Frequency_Hz, uint32_t Ramp_Steps)
+{
+    Motion_Segment_t Segments[MOTION_PLANNER_MAX_RAMP_SEGMENTS];
+    uint16_t Segment_Count = Motion_Planner_Build_Linear_Ramp(Start_Frequency_Hz, End_Frequency_Hz, Ramp_Steps, CHECK_SEGMENT_TIME_US, Segments);
+    long double Frequency_Sum = (long double)Start_Frequency_Hz + End_Frequency_Hz;
+    uint128_t Slice_Denominator = ((uint128_t)Start_Frequency_Hz + End_Frequency_Hz) * CHECK_SEGMENT_TIME_US;
+    uint128_t Ceil_Slices = (((uint128_t)2 * Ramp_Steps * 1000000) + Slice_Denominator - 1) / Slice_Denominator; // Ramp duration in nominal slices
+    uint32_t Slices = (Ceil_Slices > MOTION_PLANNER_MAX_RAMP_SEGMENTS) ? MOTION_PLANNER_MAX_RAMP_SEGMENTS : ((Ceil_Slices == 0) ? 1 : (uint32_t)Ceil_Slices);
+    uint32_t Slice = 0;
+    uint64_t Position = 0;
+    char Detail[96];
+
+    snprintf(Detail, sizeof(Detail), "%" PRIu32 " -> %" PRIu32 " Hz, %" PRIu32 " steps", Start_Frequency_Hz, End_Frequency_Hz, Ramp_Steps);
+
+    if ((Segment_Count == 0) || (Segment_Count > Slices))
+    {
+        Host_Check_Fail("ramp", Detail);
+        return;
+    }
+
+    for (uint16_t Index = 0; Index < Segment_Count; Index++)
+    {
+        Position += Segments[Index].Steps;
+
+        bool Found = false;
+
+        while (!Found && (Slice < Slices))
+        {
+            Slice++;
+
+            long double Fraction = (long double)Slice / Slices;
+            long double Ideal = Ramp_Steps * ((Start_Frequency_Hz * ((2.0L * Fraction) - (Fraction * Fraction))) + (End_Frequency_Hz * Fraction * Fraction)) / Frequency_Sum;
+
+            Found = fabsl(Ideal - (long double)Position) <= (0.5L + CHECK_POSITION_TOLERANCE);
+        }
+
+        if (!Found || (Segments[Index].Steps == 0) || (Segments[Index].Frequency_Hz == 0))
+        {
+            Host_Check_Fail("ramp", Detail);
+            return;
+        }
+    }
+
+    if (Position != Ramp_Steps)
+    {
+        Host_Check_Fail("ramp", Detail);
+    }
+}
+
+static void Check_Ramps(uint32_t Iterations)
+{
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        uint32_t Start_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000);
+        uint32_t End_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000) + 1;
+        uint32_t Ramp_Steps = (uint32_t)(Host_Check_Random_Value() % 1000000) + 1;
+
+        Check_Ramp(Start_Frequency_Hz, End_Frequency_Hz, Ramp_Steps);
+    }
+
+    printf("ramps        : %" PRIu32 " cases\n", Iterations);
+}
+
+static void Check_Ramp_Tables(void)
+{
+    Motion_Segment_t Segments[MOTION_PLANNER_MAX_RAMP_SEGMENTS];
+    char Detail[96];
+
+    for (uint16_t Index = 0; Index < Motion_Ramp_Table_Count; Index++)
+    {
+        const Motion_Ramp_Table_t *Table = &Motion_Ramp_Tables[Index];
+        uint16_t Segment_Count = Motion_Planner_Build_Linear_Ramp(0, Table->Frequency_Hz, Table->Ramp_Steps, Table->Segment_Time_us, Segments);
+
+        snprintf(Detail, sizeof(Detail), "%" PRIu32 " steps/s^2, %" PRIu32 " Hz", Table->Acceleration, Table->Frequency_Hz);
+
+        if ((Table->Ramp_Steps != Motion_Planner_Ramp_Steps(Table->Frequency_Hz, Table->Acceleration)) || (Segment_Count != Table->Segment_Count) ||
+            (memcmp(Segments, Table->Segments, Segment_Count * sizeof(Motion_Segment_t)) != 0))
+        {
+            Host_Check_Fail("ramp_table", Detail);
+        }
+
+        Check_Ramp(0, Table->Frequency_Hz, Table->Ramp_Steps);
+    }
+
+    printf("ramp_tables  : %" PRIu16 " tables\n", Motion_Ramp_Table_Count);
+}
+
+static void Check_Profiles(uint32_t Iterations)
+{
+    static Motion_Profile_t Profile;
+    char Detail[128];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        Motion_Planner_Config_t Config = {
+            .Max_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000) + 1, // Cruise frequency
+            .Acceleration = (uint32_t)(Host_Check_Random() % 1000000) + 1,    // Acceleration limit
+            .Jerk = 0,                                                        // Trapezoidal ramps
+            .Segment_Time_us = CHECK_SEGMENT_TIME_US,                         // Ramp slice duration
+        };
+        uint32_t Steps = (uint32_t)Host_Check_Random_Value();
+        uint32_t Entry_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000);
+        uint32_t Exit_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000);
+
+        snprintf(Detail, sizeof(Detail), "%" PRIu32 " steps at %" PRIu32 " Hz, %" PRIu32 " steps/s^2", Steps, Config.Max_Frequency_Hz, Config.Acceleration);
+
+        if (!Motion_Planner_Plan_Move(&Config, Steps, &Profile) || (Profile.Total_Steps != Steps) || (Profile.Peak_Frequency_Hz > Config.Max_Frequency_Hz))
+        {
+            Host_Check_Fail("plan_move", Detail);
+        }
+
+        if (!Motion_Planner_Plan_Block(&Config, Steps, Entry_Frequency_Hz, Exit_Frequency_Hz, &Profile) || (Profile.Total_Steps != Steps))
+        {
+            Host_Check_Fail("plan_block", Detail);
+        }
+    }
+
+    printf("profiles     : %" PRIu32 " cases\n", Iterations);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Mul_Div(Iterations);
+    Check_Isqrt(Iterations);
+    Check_Parse_Fixed();
+    Check_Steps(Iterations);
+    Check_Ramps(CHECK_RAMP_ITERATIONS);
+    Check_Ramp_Tables();
+    Check_Profiles(CHECK_RAMP_ITERATIONS);
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,87 @@
+/*H**********************************************************************
+ * FILENAME :        motion_script_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the motion script compiler.
+ *
+ * NOTES :
+ *       Motion scripts must compile to the expected bytecode summary or fail
+ *       in the expected line.
+ *
+ *       Usage: motion_script_check
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "motion_script.h"
+#include "host_check.h"
+
+static void Check_Motion_Script(void)
+{
+    static const struct
+    {
+        const char *Text;
+        bool Valid;
+        uint32_t Line;  // Line of the error
+        uint16_t Ops;   // Operations of a valid script
+        uint32_t Moves; // Moves per run
+        uint64_t Steps; // Relative steps per run
+    } Cases[] = {
+        {"speed 500\nmove 100\nmove -50\n", true, 0, 3, 2, 150},
+        {"loop 3\n  loop 4 # inner\n    move 10\n  end\n  move_to 0\nend", true, 0, 6, 15, 120},
+        {"; only\r\nMOVE +7\r\n", true, 0, 1, 1, 7},
+        {"loop 1000000\nloop 1000000\nloop 1000000\nmove 2147483647\nend\nend\nend\n", true, 0, 7, UINT32_MAX, UINT64_MAX},
+        {"move 0\n", false, 1, 0, 0, 0},
+        {"speed 70001\n", false, 1, 0, 0, 0},
+        {"move -2147483648\n", false, 1, 0, 0, 0},
+        {"dwell\n", false, 1, 0, 0, 0},
+        {"dwell 5ms\n", false, 1, 0, 0, 0},
+        {"\n\nend\n", false, 3, 0, 0, 0},
+        {"move 1\nloop 2\nmove 1\n", false, 2, 0, 0, 0},
+        {"loop 2\nend\n", false, 2, 0, 0, 0},
+        {"loop 2\nloop 2\nloop 2\nloop 2\nloop 2\nloop 2\nloop 2\nloop 2\nloop 2\n", false, 9, 0, 0, 0},
+        {"# nothing\n", false, 0, 0, 0, 0},
+    };
+    static Motion_Script_t Script;
+    Motion_Script_Error_t Error;
+    char Detail[96];
+
+    for (size_t Index = 0; Index < (sizeof(Cases) / sizeof(Cases[0])); Index++)
+    {
+        bool Valid = Motion_Script_Compile(Cases[Index].Text, strlen(Cases[Index].Text), &Script, &Error);
+
+        snprintf(Detail, sizeof(Detail), "case %zu gave %d, line %" PRIu32 ", %u ops", Index, Valid, Error.Line, Script.Op_Count);
+
+        if ((Valid != Cases[Index].Valid) || (!Valid && (Error.Line != Cases[Index].Line)))
+        {
+            Host_Check_Fail("script_compile", Detail);
+        }
+        else if (Valid && ((Script.Op_Count != Cases[Index].Ops) || (Script.Moves_Per_Run != Cases[Index].Moves) || (Script.Steps_Per_Run != Cases[Index].Steps)))
+        {
+            Host_Check_Fail("script_summary", Detail);
+        }
+    }
+
+    Motion_Script_Compile(Cases[1].Text, strlen(Cases[1].Text), &Script, &Error);
+
+    if ((Script.Ops[3].Argument != 2) || (Script.Ops[5].Argument != 1))
+    {
+        Host_Check_Fail("script_loops", "end does not point to the first operation of its loop body");
+    }
+
+    printf("motion script: %zu cases\n", sizeof(Cases) / sizeof(Cases[0]));
+}
+
+int main(void)
+{
+    Check_Motion_Script();
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,108 @@
+/*H**********************************************************************
+ * FILENAME :        resonance_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the resonance bands of the planner.
+ *
+ * NOTES :
+ *       Profiles passed through resonance bands must keep their steps and
+ *       only cross a band in its middle segment.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: resonance_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "motion_planner.h"
+#include "resonance.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 20000 // Random profiles checked
+#define CHECK_SEGMENT_TIME_US 10000    // Same as MOTION_SEGMENT_TIME_US at 100 Hz ticks
+
+static void Check_Resonance(uint32_t Iterations)
+{
+    static Motion_Profile_t Profile;
+    char Detail[160];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        Resonance_Table_t Table;
+        Motion_Planner_Config_t Config = {
+            .Max_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000) + 1, // Cruise frequency
+            .Acceleration = (uint32_t)(Host_Check_Random() % 1000000) + 1,    // Acceleration limit
+            .Jerk = 0,                                                        // Trapezoidal ramps
+            .Segment_Time_us = CHECK_SEGMENT_TIME_US,                         // Ramp slice duration
+        };
+        uint32_t Steps = (uint32_t)(Host_Check_Random() % 1000000) + 1;
+
+        Resonance_Init_Table(&Table);
+
+        Table.Crossing_Acceleration = (uint32_t)(Host_Check_Random() % 4000000);
+
+        for (uint32_t Band = (uint32_t)(Host_Check_Random() % 4); Band > 0; Band--)
+        {
+            uint32_t Low_Hz = (uint32_t)(Host_Check_Random() % 200000) + 1;
+
+            Resonance_Add_Band(&Table, Low_Hz, Low_Hz + 2 + (uint32_t)(Host_Check_Random() % 20000));
+        }
+
+        Config.Max_Frequency_Hz = Resonance_Snap_Frequency(&Table, Config.Max_Frequency_Hz);
+
+        snprintf(Detail, sizeof(Detail), "%" PRIu32 " steps at %" PRIu32 " Hz, %" PRIu32 " steps/s^2, %u bands", Steps, Config.Max_Frequency_Hz, Config.Acceleration, Table.Band_Count);
+
+        if (!Motion_Planner_Plan_Move(&Config, Steps, &Profile))
+        {
+            Host_Check_Fail("resonance_plan", Detail);
+            continue;
+        }
+
+        Resonance_Apply_To_Profile(&Table, &Profile);
+
+        if ((Profile.Total_Steps != Steps) || (Profile.Segment_Count != (Profile.Accel_Segments + Profile.Cruise_Segments + Profile.Decel_Segments)) ||
+            (Profile.Peak_Frequency_Hz > Config.Max_Frequency_Hz))
+        {
+            Host_Check_Fail("resonance_profile", Detail);
+        }
+
+        for (uint16_t Index = 0; Index < Profile.Segment_Count; Index++)
+        {
+            for (uint8_t Band = 0; Band < Table.Band_Count; Band++)
+            {
+                const Resonance_Band_t *Edges = &Table.Bands[Band];
+                uint32_t Frequency_Hz = Profile.Segments[Index].Frequency_Hz;
+                uint32_t Middle_Hz = Edges->Low_Hz + ((Edges->High_Hz - Edges->Low_Hz) / 2);
+
+                if ((Frequency_Hz > Edges->Low_Hz) && (Frequency_Hz < Edges->High_Hz) &&
+                    ((Frequency_Hz != Middle_Hz) || (Table.Crossing_Acceleration == 0)))
+                {
+                    Host_Check_Fail("resonance_band", Detail); // Dwells in a band outside of a crossing segment
+                }
+            }
+        }
+    }
+
+    printf("resonance    : %" PRIu32 " cases\n", Iterations);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Resonance(Iterations);
+
+    return Host_Check_Result();
+}
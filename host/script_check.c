@@ -0,0 +1,99 @@
+/*H**********************************************************************
+ * FILENAME :        script_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Offline validation of motion scripts for the run_script command.
+ *
+ * NOTES :
+ *       Compiles every file with the same compiler as the ESP32, see
+ *       main/motion_script.h, and prints the per run summary, or the first
+ *       error as file:line: message. With --list the bytecode is printed
+ *       too. The limits of the target apply, a file larger than the script
+ *       buffer of the target is rejected.
+ *
+ *       Usage: script_check [--list] file...
+ *       Exits with 1 if a script has an error.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "motion_script.h"
+
+#define SCRIPT_CHECK_MAX_TEXT 4096 // Same as MOTOR_SCRIPT_MAX_TEXT on the target
+
+/**
+ * @brief Compile one file and report it.
+ *
+ * @return false if the file is not readable, too large or has an error.
+ */
+static bool Check_File(const char *Path, bool List)
+{
+    static char Text[SCRIPT_CHECK_MAX_TEXT + 1];
+    static Motion_Script_t Script;
+    Motion_Script_Error_t Error;
+    FILE *File = fopen(Path, "rb");
+
+    if (File == NULL)
+    {
+        fprintf(stderr, "%s: cannot read\n", Path);
+        return false;
+    }
+
+    size_t Length = fread(Text, 1, sizeof(Text), File);
+
+    fclose(File);
+
+    if (Length > SCRIPT_CHECK_MAX_TEXT)
+    {
+        fprintf(stderr, "%s: larger than %d bytes\n", Path, SCRIPT_CHECK_MAX_TEXT);
+        return false;
+    }
+
+    if (!Motion_Script_Compile(Text, Length, &Script, &Error))
+    {
+        fprintf(stderr, "%s:%" PRIu32 ": %s\n", Path, Error.Line, Error.Message);
+        return false;
+    }
+
+    printf("%s: %u ops, %" PRIu32 " moves, %" PRIu64 " steps, %" PRIu64 " ms dwell per run\n",
+           Path, Script.Op_Count, Script.Moves_Per_Run, Script.Steps_Per_Run, Script.Dwell_ms_Per_Run);
+
+    for (uint16_t Index = 0; List && (Index < Script.Op_Count); Index++)
+    {
+        printf("  %5u %-8s %" PRId32 "\n", Index, Motion_Script_Op_Name(Script.Ops[Index].Opcode), Script.Ops[Index].Argument);
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    bool List = false;
+    int Failed = 0;
+    int Index = 1;
+
+    if ((Index < argc) && (strcmp(argv[Index], "--list") == 0))
+    {
+        List = true;
+        Index++;
+    }
+
+    if (Index >= argc)
+    {
+        fprintf(stderr, "Usage: %s [--list] file...\n", argv[0]);
+        return 2;
+    }
+
+    for (; Index < argc; Index++)
+    {
+        Failed += Check_File(argv[Index], List) ? 0 : 1;
+    }
+
+    return (Failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,275 @@
+/*H**********************************************************************
+ * FILENAME :        segment_encoder_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the pulse items the segment encoder streams for the
+ *       RMT pulse engine against the ideal timing of the profiles.
+ *
+ * NOTES :
+ *       Planned moves and random profiles are encoded in random chunks at
+ *       the tick rates of the pulse engines. Every item half must last 1 to
+ *       32767 ticks, every step must start with one high half, and the
+ *       items must add up to the encoded steps and ticks. The encoded
+ *       duration may only differ from the exact sum of 1/frequency, with
+ *       periods under 2 ticks lengthened to 2, by the Q16 truncation of the
+ *       periods and one tick per segment. Segment_Encoder_Timing_Error_ns()
+ *       must report that difference like a long double reference, also for
+ *       a stream aborted after the high half of its last step.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: segment_encoder_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <math.h>
+#include "segment_encoder.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 2000  // Random profiles encoded
+#define CHECK_SEGMENT_TIME_US 10000    // Same as MOTION_SEGMENT_TIME_US at 100 Hz ticks
+#define CHECK_MAX_MOVE_STEPS 20000     // Longest planned move
+#define CHECK_MAX_ITEMS 64             // Largest chunk encoded at once, the RMT block is smaller
+#define CHECK_REFERENCE_TOLERANCE_NS 2 // Allowed error of the reported timing error on top of the truncation to ns
+
+/** Tick rate and pulse high time of a pulse engine */
+typedef struct
+{
+    uint32_t Tick_Hz;    // Tick rate
+    uint32_t High_Ticks; // High time of a step pulse
+} Engine_t;
+
+/** Totals of the encoded items */
+typedef struct
+{
+    uint64_t Ticks; // Duration of all item halves
+    uint32_t Steps; // High halves, one per step
+} Item_Totals_t;
+
+/**
+ * @brief Random profile of constant frequency segments, some of them held.
+ *
+ * A few segments step faster than the 2 tick period the encoder can emit.
+ */
+static void Random_Profile(Motion_Profile_t *Profile, uint32_t Tick_Hz)
+{
+    memset(Profile, 0, sizeof(*Profile));
+
+    Profile->Segment_Count = (uint16_t)(Host_Check_Random() % 32) + 1;
+
+    for (uint16_t Index = 0; Index < Profile->Segment_Count; Index++)
+    {
+        uint32_t Kind = (uint32_t)(Host_Check_Random() % 8);
+        uint32_t Max_Frequency_Hz = (Kind < 2) ? 100 : ((Kind == 2) ? Tick_Hz : (Tick_Hz / 2)); // Periods longer than one item, clamped or emitted as planned
+
+        Profile->Segments[Index].Frequency_Hz = (uint32_t)(Host_Check_Random() % Max_Frequency_Hz) + 1;
+        Profile->Segments[Index].Steps = ((Host_Check_Random() % 16) == 0) ? 0 : ((uint32_t)(Host_Check_Random() % ((Kind < 2) ? 20 : 2000)) + 1);
+        Profile->Total_Steps += Profile->Segments[Index].Steps;
+    }
+}
+
+/**
+ * @brief Steps the encoder must emit, up to the first held segment.
+ */
+static uint32_t Encoded_Steps(const Motion_Profile_t *Profile)
+{
+    uint32_t Steps = 0;
+
+    for (uint16_t Index = 0; (Index < Profile->Segment_Count) && (Profile->Segments[Index].Steps > 0); Index++)
+    {
+        Steps += Profile->Segments[Index].Steps;
+    }
+
+    return Steps;
+}
+
+/**
+ * @brief Exact duration of the first steps of a profile.
+ *
+ * @param Profile Profile encoded.
+ * @param Steps Steps from the start of the profile.
+ * @param Tick_Hz Tick rate of the encoder.
+ * @param Ideal_s Returns the sum of 1/frequency over the steps.
+ * @param Clamped_s Returns the same sum with periods shorter than 2 ticks lengthened to 2 ticks.
+ * @return Segments the steps were taken from.
+ */
+static uint16_t Ideal_Duration(const Motion_Profile_t *Profile, uint32_t Steps, uint32_t Tick_Hz, long double *Ideal_s, long double *Clamped_s)
+{
+    uint16_t Index = 0;
+
+    *Ideal_s = 0;
+    *Clamped_s = 0;
+
+    for (; (Index < Profile->Segment_Count) && (Steps > 0); Index++)
+    {
+        const Motion_Segment_t *Segment = &Profile->Segments[Index];
+        uint32_t Segment_Steps = (Segment->Steps < Steps) ? Segment->Steps : Steps;
+        long double Period_s = 1.0L / Segment->Frequency_Hz;
+
+        *Ideal_s += Segment_Steps * Period_s;
+        *Clamped_s += Segment_Steps * (((Segment->Frequency_Hz * 2ULL) > Tick_Hz) ? (2.0L / Tick_Hz) : Period_s);
+        Steps -= Segment_Steps;
+    }
+
+    return Index;
+}
+
+/**
+ * @brief Check and add up the items of one chunk.
+ */
+static void Check_Items(const Pulse_Item_t *Items, size_t Count, Item_Totals_t *Totals, const char *Detail)
+{
+    for (size_t Index = 0; Index < Count; Index++)
+    {
+        const Pulse_Item_t *Item = &Items[Index];
+
+        if ((Item->Duration0 == 0) || (Item->Duration1 == 0) || (Item->Level1 != 0))
+        {
+            Host_Check_Fail("encoder_item", Detail); // A zero duration ends the RMT transmission
+        }
+
+        Totals->Ticks += Item->Duration0 + Item->Duration1;
+        Totals->Steps += Item->Level0;
+    }
+}
+
+static void Check_Segment_Encoder(uint32_t Iterations)
+{
+    static const Engine_t Engines[] = {
+        {10000000, 25}, // RMT pulse engine
+        {40000000, 50}, // Step timer of the multi-axis moves
+        {1000000, 2},   // Coarse ticks, periods close to the 2 tick minimum
+    };
+    static Motion_Profile_t Profile;
+    static Pulse_Item_t Items[CHECK_MAX_ITEMS];
+    int64_t Largest_Error_ns = 0;
+    uint32_t Aborts = 0;
+    char Detail[160];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        const Engine_t *Engine = &Engines[Host_Check_Random() % (sizeof(Engines) / sizeof(Engines[0]))];
+        Segment_Encoder_t Encoder;
+        Item_Totals_t Totals = {0};
+        uint32_t Steps_Done = 0;
+        bool Aborted = false;
+
+        if (Host_Check_Random() & 1)
+        {
+            Motion_Planner_Config_t Config = {
+                .Max_Frequency_Hz = (uint32_t)(Host_Check_Random() % 200000) + 1, // Cruise frequency
+                .Acceleration = (uint32_t)(Host_Check_Random() % 1000000) + 1,    // Acceleration limit
+                .Jerk = 0,                                                        // Trapezoidal ramps
+                .Segment_Time_us = CHECK_SEGMENT_TIME_US,                         // Ramp slice duration
+            };
+
+            if (!Motion_Planner_Plan_Move(&Config, (uint32_t)(Host_Check_Random() % CHECK_MAX_MOVE_STEPS) + 1, &Profile))
+            {
+                Host_Check_Fail("encoder_plan", "planner refused a move");
+                continue;
+            }
+        }
+        else
+        {
+            Random_Profile(&Profile, Engine->Tick_Hz);
+        }
+
+        uint32_t Steps = Encoded_Steps(&Profile);
+        uint32_t Abort_At = ((Host_Check_Random() % 8) == 0) ? (uint32_t)(Host_Check_Random() % (Steps + 1)) : UINT32_MAX;
+
+        snprintf(Detail, sizeof(Detail), "profile %" PRIu32 ", %" PRIu32 " steps in %u segments at %" PRIu32 " Hz ticks", Iteration, Steps, Profile.Segment_Count,
+                 Engine->Tick_Hz);
+
+        Segment_Encoder_Begin(&Encoder, &Profile, Engine->Tick_Hz, Engine->High_Ticks);
+
+        while (true)
+        {
+            uint32_t Chunk_Steps = 0;
+            size_t Count = Segment_Encoder_Fill(&Encoder, Items, (size_t)(Host_Check_Random() % CHECK_MAX_ITEMS) + 1, &Chunk_Steps);
+
+            Check_Items(Items, Count, &Totals, Detail);
+
+            Steps_Done += Chunk_Steps;
+
+            if (Count == 0)
+            {
+                break;
+            }
+
+            if (Segment_Encoder_Done(&Encoder) != ((Steps_Done == Steps) && (Totals.Steps == Steps)))
+            {
+                Host_Check_Fail("encoder_done", Detail);
+            }
+
+            if (Totals.Steps >= Abort_At)
+            {
+                uint32_t Steps_Before = Encoder.Steps_Encoded;
+
+                Segment_Encoder_Abort(&Encoder);
+                Aborted = true;
+                Aborts++;
+
+                if (!Segment_Encoder_Done(&Encoder) || (Segment_Encoder_Fill(&Encoder, Items, CHECK_MAX_ITEMS, NULL) != 0))
+                {
+                    Host_Check_Fail("encoder_abort", Detail);
+                }
+
+                Steps_Done += Encoder.Steps_Encoded - Steps_Before; // The step of the last high half counts
+                Steps = Totals.Steps;
+                break;
+            }
+        }
+
+        if ((Steps_Done != Encoder.Steps_Encoded) || (Totals.Steps != Steps) || (Encoder.Steps_Encoded != Steps) || (Totals.Ticks != Encoder.Ticks_Encoded))
+        {
+            Host_Check_Fail("encoder_totals", Detail);
+            continue;
+        }
+
+        long double Ideal_s = 0;
+        long double Clamped_s = 0;
+        uint16_t Segments = Ideal_Duration(&Profile, Steps, Engine->Tick_Hz, &Ideal_s, &Clamped_s);
+        long double Tick_ns = 1e9L / Engine->Tick_Hz;
+        long double Error_ns = ((long double)Encoder.Ticks_Encoded * Tick_ns) - (Ideal_s * 1e9L);
+        long double Bound_ns = (((long double)Steps / 65536.0L) + Segments) * Tick_ns; // Q16 truncation of every period, the phase carried at each segment
+        int64_t Reported_ns = Segment_Encoder_Timing_Error_ns(&Encoder);
+
+        if (!Aborted && (fabsl(((long double)Encoder.Ticks_Encoded * Tick_ns) - (Clamped_s * 1e9L)) > Bound_ns))
+        {
+            snprintf(Detail + strlen(Detail), sizeof(Detail) - strlen(Detail), ", error %.1Lf ns", Error_ns);
+            Host_Check_Fail("encoder_timing", Detail); // The low time of an aborted last step is dropped
+        }
+
+        if (fabsl((long double)Reported_ns - Error_ns) > (Segments + CHECK_REFERENCE_TOLERANCE_NS))
+        {
+            Host_Check_Fail("encoder_timing_error", Detail); // Each segment and the total truncate to whole ns
+        }
+
+        Largest_Error_ns = (llabs(Reported_ns) > Largest_Error_ns) ? llabs(Reported_ns) : Largest_Error_ns;
+    }
+
+    printf("seg encoder  : %" PRIu32 " profiles, %" PRIu32 " aborted, largest error %" PRId64 " ns\n", Iterations, Aborts, Largest_Error_ns);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Segment_Encoder(Iterations);
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,99 @@
+/*H**********************************************************************
+ * FILENAME :        segment_ring_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the segment ring of the timer pulse engine.
+ *
+ * NOTES :
+ *       The segment ring must hand out what was pushed in order, also across
+ *       the wrap of its indices.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: segment_ring_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "segment_ring.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 200000 // Random ring operations
+
+static void Check_Segment_Ring(uint32_t Iterations)
+{
+    static Segment_Ring_t Ring;
+    Segment_Ring_Item_t Item;
+    uint64_t Pushed = 0; // Sequence number of the next pushed segment
+    uint64_t Popped = 0; // Sequence number of the next expected segment
+    char Detail[96];
+
+    Segment_Ring_Reset(&Ring);
+
+    Ring.Head = UINT32_MAX - (SEGMENT_RING_SIZE / 2); // Both indices wrap early in the run
+    Ring.Tail = Ring.Head;
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        bool Push = (Host_Check_Random() & 1) != 0;
+
+        snprintf(Detail, sizeof(Detail), "iteration %" PRIu32 ", %" PRIu64 " pushed, %" PRIu64 " popped", Iteration, Pushed, Popped);
+
+        if (Segment_Ring_Count(&Ring) != (uint32_t)(Pushed - Popped))
+        {
+            Host_Check_Fail("ring_count", Detail);
+        }
+
+        if (Push)
+        {
+            bool Accepted = Segment_Ring_Push(&Ring, Pushed << 16, (uint32_t)Pushed);
+
+            if (Accepted != ((Pushed - Popped) < SEGMENT_RING_SIZE))
+            {
+                Host_Check_Fail("ring_push", Detail);
+            }
+
+            Pushed += Accepted ? 1 : 0;
+        }
+        else
+        {
+            bool Taken = Segment_Ring_Pop(&Ring, &Item);
+
+            if ((Taken != (Pushed > Popped)) || (Taken && ((Item.Period_Q16 != (Popped << 16)) || (Item.Steps != (uint32_t)Popped))))
+            {
+                Host_Check_Fail("ring_pop", Detail);
+            }
+
+            Popped += Taken ? 1 : 0;
+        }
+    }
+
+    Segment_Ring_Drain(&Ring);
+
+    if ((Segment_Ring_Count(&Ring) != 0) || Segment_Ring_Pop(&Ring, &Item))
+    {
+        Host_Check_Fail("ring_drain", "segments left after a drain");
+    }
+
+    printf("segment ring : %" PRIu32 " operations\n", Iterations);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Segment_Ring(Iterations);
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,70 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_GPIO_H
+#define SIM_GPIO_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum
+{
+    GPIO_NUM_NC = -1,
+    GPIO_NUM_0 = 0, GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_3, GPIO_NUM_4, GPIO_NUM_5, GPIO_NUM_6, GPIO_NUM_7,
+    GPIO_NUM_8, GPIO_NUM_9, GPIO_NUM_10, GPIO_NUM_11, GPIO_NUM_12, GPIO_NUM_13, GPIO_NUM_14, GPIO_NUM_15,
+    GPIO_NUM_16, GPIO_NUM_17, GPIO_NUM_18, GPIO_NUM_19, GPIO_NUM_20, GPIO_NUM_21, GPIO_NUM_22, GPIO_NUM_23,
+    GPIO_NUM_24, GPIO_NUM_25, GPIO_NUM_26, GPIO_NUM_27, GPIO_NUM_28, GPIO_NUM_29, GPIO_NUM_30, GPIO_NUM_31,
+    GPIO_NUM_32, GPIO_NUM_33, GPIO_NUM_34, GPIO_NUM_35, GPIO_NUM_36, GPIO_NUM_37, GPIO_NUM_38, GPIO_NUM_39,
+    GPIO_NUM_MAX,
+} gpio_num_t;
+
+#define GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) (((gpio_num) >= 0) && ((gpio_num) < GPIO_NUM_34)) // GPIO 34 to 39 are inputs only
+
+typedef enum
+{
+    GPIO_MODE_DISABLE = 0,
+    GPIO_MODE_INPUT = 1,
+    GPIO_MODE_OUTPUT = 2,
+    GPIO_MODE_INPUT_OUTPUT = 3,
+} gpio_mode_t;
+
+typedef enum
+{
+    GPIO_INTR_DISABLE = 0,
+    GPIO_INTR_POSEDGE = 1,
+    GPIO_INTR_NEGEDGE = 2,
+    GPIO_INTR_ANYEDGE = 3,
+    GPIO_INTR_LOW_LEVEL = 4,
+    GPIO_INTR_HIGH_LEVEL = 5,
+    GPIO_INTR_MAX,
+} gpio_int_type_t;
+
+typedef void (*gpio_isr_t)(void *Arg);
+
+// Plain values, the example mixes the pull-up and pull-down constants
+#define GPIO_PIN_INTR_DISABLE 0
+#define GPIO_PULLUP_DISABLE 0
+#define GPIO_PULLUP_ENABLE 1
+#define GPIO_PULLDOWN_DISABLE 0
+#define GPIO_PULLDOWN_ENABLE 1
+
+typedef struct
+{
+    uint64_t pin_bit_mask;
+    gpio_mode_t mode;
+    uint32_t pull_up_en;
+    uint32_t pull_down_en;
+    uint32_t intr_type;
+} gpio_config_t;
+
+esp_err_t gpio_config(const gpio_config_t *Config);
+esp_err_t gpio_set_level(gpio_num_t Gpio, uint32_t Level);
+int gpio_get_level(gpio_num_t Gpio);
+esp_err_t gpio_set_direction(gpio_num_t Gpio, gpio_mode_t Mode);
+esp_err_t gpio_set_intr_type(gpio_num_t Gpio, gpio_int_type_t Type); // Edge types only, level interrupts never fire
+esp_err_t gpio_intr_enable(gpio_num_t Gpio);
+esp_err_t gpio_intr_disable(gpio_num_t Gpio);
+esp_err_t gpio_install_isr_service(int Intr_Alloc_Flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t Gpio, gpio_isr_t Handler, void *Arg);
+esp_err_t gpio_isr_handler_remove(gpio_num_t Gpio);
+
+#endif // SIM_GPIO_H
@@ -0,0 +1,18 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h.
+ * The simulation drives the LEDC engine, only the types are provided. */
+
+#ifndef SIM_RMT_H
+#define SIM_RMT_H
+
+#include "esp_err.h"
+
+typedef enum
+{
+    RMT_CHANNEL_0 = 0,
+    RMT_CHANNEL_1,
+    RMT_CHANNEL_2,
+    RMT_CHANNEL_3,
+    RMT_CHANNEL_MAX,
+} rmt_channel_t;
+
+#endif // SIM_RMT_H
@@ -0,0 +1,81 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_TIMER_H
+#define SIM_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#define TIMER_BASE_CLK 80000000 // APB clock
+
+typedef enum
+{
+    TIMER_GROUP_0 = 0,
+    TIMER_GROUP_1,
+    TIMER_GROUP_MAX,
+} timer_group_t;
+
+typedef enum
+{
+    TIMER_0 = 0,
+    TIMER_1,
+    TIMER_MAX,
+} timer_idx_t;
+
+typedef enum
+{
+    TIMER_COUNT_DOWN = 0,
+    TIMER_COUNT_UP,
+} timer_count_dir_t;
+
+typedef enum
+{
+    TIMER_PAUSE = 0,
+    TIMER_START,
+} timer_start_t;
+
+typedef enum
+{
+    TIMER_ALARM_DIS = 0,
+    TIMER_ALARM_EN,
+} timer_alarm_t;
+
+typedef enum
+{
+    TIMER_AUTORELOAD_DIS = 0,
+    TIMER_AUTORELOAD_EN,
+} timer_autoreload_t;
+
+typedef enum
+{
+    TIMER_INTR_LEVEL = 0,
+} timer_intr_mode_t;
+
+typedef struct
+{
+    timer_alarm_t alarm_en;
+    timer_start_t counter_en;
+    timer_intr_mode_t intr_type;
+    timer_count_dir_t counter_dir;
+    timer_autoreload_t auto_reload;
+    uint32_t divider;
+} timer_config_t;
+
+typedef void *timer_isr_handle_t;
+
+esp_err_t timer_init(timer_group_t Group, timer_idx_t Timer, const timer_config_t *Config);
+esp_err_t timer_set_counter_value(timer_group_t Group, timer_idx_t Timer, uint64_t Value);
+esp_err_t timer_set_alarm_value(timer_group_t Group, timer_idx_t Timer, uint64_t Value);
+esp_err_t timer_set_alarm(timer_group_t Group, timer_idx_t Timer, timer_alarm_t Alarm);
+esp_err_t timer_enable_intr(timer_group_t Group, timer_idx_t Timer);
+esp_err_t timer_isr_register(timer_group_t Group, timer_idx_t Timer, void (*Handler)(void *), void *Arg, int Intr_Alloc_Flags, timer_isr_handle_t *Handle);
+esp_err_t timer_start(timer_group_t Group, timer_idx_t Timer);
+esp_err_t timer_pause(timer_group_t Group, timer_idx_t Timer);
+void timer_group_clr_intr_status_in_isr(timer_group_t Group, timer_idx_t Timer);
+void timer_group_set_counter_enable_in_isr(timer_group_t Group, timer_idx_t Timer, timer_start_t Enable);
+void timer_group_set_alarm_value_in_isr(timer_group_t Group, timer_idx_t Timer, uint64_t Value);
+void timer_group_enable_alarm_in_isr(timer_group_t Group, timer_idx_t Timer);
+uint64_t timer_group_get_counter_value_in_isr(timer_group_t Group, timer_idx_t Timer);
+
+#endif // SIM_TIMER_H
@@ -0,0 +1,11 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_ROM_GPIO_H
+#define SIM_ROM_GPIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+void gpio_matrix_out(uint32_t Gpio, uint32_t Signal_Index, bool Out_Invert, bool Enable_Invert);
+
+#endif // SIM_ROM_GPIO_H
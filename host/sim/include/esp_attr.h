@@ -0,0 +1,8 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_ESP_ATTR_H
+#define SIM_ESP_ATTR_H
+
+#define IRAM_ATTR // One memory on the host
+
+#endif // SIM_ESP_ATTR_H
@@ -0,0 +1,33 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_ESP_ERR_H
+#define SIM_ESP_ERR_H
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_NOT_SUPPORTED 0x106
+#define ESP_ERR_TIMEOUT 0x107
+#define ESP_ERR_INVALID_RESPONSE 0x108
+
+const char *esp_err_to_name(esp_err_t code);
+
+void Sim_Error_Check_Failed(esp_err_t Code, const char *File, int Line); // Prints the error and aborts
+
+#define ESP_ERROR_CHECK(x)                                          \
+    do                                                              \
+    {                                                               \
+        esp_err_t Check_Error = (x);                                \
+        if (Check_Error != ESP_OK)                                  \
+        {                                                           \
+            Sim_Error_Check_Failed(Check_Error, __FILE__, __LINE__); \
+        }                                                           \
+    } while (0)
+
+#endif // SIM_ESP_ERR_H
@@ -0,0 +1,8 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_ESP_INTR_ALLOC_H
+#define SIM_ESP_INTR_ALLOC_H
+
+#define ESP_INTR_FLAG_IRAM (1 << 10) // Handler placed in IRAM, ignored by the simulation
+
+#endif // SIM_ESP_INTR_ALLOC_H
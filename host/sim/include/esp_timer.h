@@ -0,0 +1,10 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_ESP_TIMER_H
+#define SIM_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void); // Virtual time in us
+
+#endif // SIM_ESP_TIMER_H
@@ -0,0 +1,10 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_QUEUE_H
+#define SIM_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *QueueHandle_t;
+
+#endif // SIM_QUEUE_H
@@ -0,0 +1,26 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_TASK_H
+#define SIM_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite,
+} eNotifyAction;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t Ticks);
+BaseType_t xTaskNotify(TaskHandle_t Task, uint32_t Value, eNotifyAction Action);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t Task, uint32_t Value, eNotifyAction Action, BaseType_t *Higher_Priority_Task_Woken);
+BaseType_t xTaskNotifyWait(unsigned long Clear_On_Entry, unsigned long Clear_On_Exit, uint32_t *Value, TickType_t Ticks); // unsigned long so ULONG_MAX fits on 64 bit hosts
+
+#endif // SIM_TASK_H
@@ -0,0 +1,39 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_NVS_H
+#define SIM_NVS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+typedef uint32_t nvs_handle_t;
+
+typedef enum
+{
+    NVS_READONLY,
+    NVS_READWRITE,
+} nvs_open_mode_t;
+
+#define NVS_KEY_NAME_MAX_SIZE 16
+
+#define ESP_ERR_NVS_BASE 0x1100
+#define ESP_ERR_NVS_NOT_INITIALIZED (ESP_ERR_NVS_BASE + 0x01)
+#define ESP_ERR_NVS_NOT_FOUND (ESP_ERR_NVS_BASE + 0x02)
+#define ESP_ERR_NVS_READ_ONLY (ESP_ERR_NVS_BASE + 0x04)
+#define ESP_ERR_NVS_NOT_ENOUGH_SPACE (ESP_ERR_NVS_BASE + 0x05)
+#define ESP_ERR_NVS_INVALID_NAME (ESP_ERR_NVS_BASE + 0x06)
+#define ESP_ERR_NVS_INVALID_HANDLE (ESP_ERR_NVS_BASE + 0x07)
+#define ESP_ERR_NVS_INVALID_LENGTH (ESP_ERR_NVS_BASE + 0x0c)
+#define ESP_ERR_NVS_NO_FREE_PAGES (ESP_ERR_NVS_BASE + 0x0d)
+#define ESP_ERR_NVS_NEW_VERSION_FOUND (ESP_ERR_NVS_BASE + 0x10)
+
+esp_err_t nvs_open(const char *Name, nvs_open_mode_t Open_Mode, nvs_handle_t *Handle);
+void nvs_close(nvs_handle_t Handle);
+esp_err_t nvs_set_blob(nvs_handle_t Handle, const char *Key, const void *Value, size_t Length);
+esp_err_t nvs_get_blob(nvs_handle_t Handle, const char *Key, void *Value, size_t *Length);
+esp_err_t nvs_erase_key(nvs_handle_t Handle, const char *Key);
+esp_err_t nvs_erase_all(nvs_handle_t Handle);
+esp_err_t nvs_commit(nvs_handle_t Handle);
+
+#endif // SIM_NVS_H
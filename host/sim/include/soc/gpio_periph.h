@@ -0,0 +1,10 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_GPIO_PERIPH_H
+#define SIM_GPIO_PERIPH_H
+
+#include <stdint.h>
+
+extern const uint32_t GPIO_PIN_MUX_REG[]; // Holds the pin number, the simulation has no IO MUX
+
+#endif // SIM_GPIO_PERIPH_H
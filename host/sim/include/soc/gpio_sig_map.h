@@ -0,0 +1,11 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_GPIO_SIG_MAP_H
+#define SIM_GPIO_SIG_MAP_H
+
+#define LEDC_HS_SIG_OUT0_IDX 71
+#define LEDC_LS_SIG_OUT0_IDX 79
+#define RMT_SIG_OUT0_IDX 87
+#define SIG_GPIO_OUT_IDX 256
+
+#endif // SIM_GPIO_SIG_MAP_H
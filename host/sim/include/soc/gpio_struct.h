@@ -0,0 +1,19 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h.
+ * Writes to the set and clear registers are applied by the simulation on
+ * its next HAL call, so each of them may be written once in between. */
+
+#ifndef SIM_GPIO_STRUCT_H
+#define SIM_GPIO_STRUCT_H
+
+#include <stdint.h>
+
+typedef struct
+{
+    volatile uint32_t out;      // Output levels of GPIO 0 to 31
+    volatile uint32_t out_w1ts; // Write 1 to set
+    volatile uint32_t out_w1tc; // Write 1 to clear
+} gpio_dev_t;
+
+extern gpio_dev_t GPIO;
+
+#endif // SIM_GPIO_STRUCT_H
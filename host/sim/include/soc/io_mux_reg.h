@@ -0,0 +1,8 @@
+/* Host stand-in for the ESP-IDF header of the same name, see host/sim/sim_hal.h */
+
+#ifndef SIM_IO_MUX_REG_H
+#define SIM_IO_MUX_REG_H
+
+#define PIN_INPUT_ENABLE(PIN_NAME) ((void)(PIN_NAME)) // Pads are always readable in the simulation
+
+#endif // SIM_IO_MUX_REG_H
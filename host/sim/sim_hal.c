@@ -0,0 +1,2202 @@
+/*H**********************************************************************
+ * FILENAME :        sim_hal.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Simulated hardware of the stepper motor example for the Linux host.
+ *
+ * NOTES :
+ *       Models only what the example uses: GPIO output pads and the GPIO
+ *       matrix, input pads at their pull level or driven by the limit
+ *       switch model, edge interrupts of the pads, LEDC low speed channels,
+ *       PCNT units with both channels counting edges up or down under their
+ *       control pad, reset at the enabled limits, timer group alarms with
+ *       auto reload and the task notification of the single simulated task.
+ *       A console writer can share the CPU of that task, see
+ *       Sim_Set_Console_Load().
+ *
+ *       A new LEDC frequency, divider or duty resolution takes effect at
+ *       the next period, like on the chip. Writes to GPIO.out_w1ts and
+ *       GPIO.out_w1tc are applied at the next call into the simulation.
+ *
+ *       The NVS partition is a table in RAM holding blobs. It survives
+ *       Sim_Reset() like flash survives a reboot, and is only cleared by
+ *       nvs_flash_erase().
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim_hal.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/ledc.h"
+#include "driver/pcnt.h"
+#include "driver/timer.h"
+#include "soc/gpio_struct.h"
+#include "soc/gpio_sig_map.h"
+#include "soc/gpio_periph.h"
+#include "esp32/rom/gpio.h"
+#include "esp_timer.h"
+#include "nvs_flash.h"
+
+#define SIM_NO_EVENT UINT64_MAX                                 // Time of an event that is not scheduled
+#define SIM_TICK_PERIOD_NS (1000000000ULL / configTICK_RATE_HZ) // Duration of one RTOS tick
+#define SIM_APB_CLK_HZ 80000000                                 // Source clock of the LEDC timers
+#define SIM_REF_TICK_HZ 1000000                                 // Second source clock of the LEDC timers
+#define SIM_INITIAL_EVENT_CAPACITY 4096                         // Timeline entries allocated at first use
+#define SIM_NVS_ENTRIES 32                                      // Keys the simulated NVS partition holds
+#define SIM_NVS_VALUE_SIZE 1024                                 // Largest blob of one key
+#define SIM_NVS_HANDLES 8                                       // Handles open at the same time
+#define SIM_LOAD_STANDSTILL_NS 20000000ULL                      // A step this long after the previous one starts from standstill
+#define SIM_LOAD_WINDOW_NS 50000000ULL                          // Shortest time the acceleration of the rotor is averaged over, several ramp slices
+#define SIM_LOAD_PULL_IN_HZ 500                                 // The rotor follows any acceleration below this step rate
+#define SIM_CONSOLE_CALL_NS 2000                                // CPU time of one driver call of the task under a console load
+
+/** Source driving a pad */
+typedef enum
+{
+    SIM_PAD_GPIO = 0, // GPIO output register
+    SIM_PAD_LEDC,     // LEDC low speed channel
+    SIM_PAD_INPUT,    // Input, at its pull level or driven by the limit switch
+} Sim_Pad_Source_t;
+
+/** Edge interrupt of one pad */
+typedef struct
+{
+    gpio_int_type_t Type; // Edges that fire the interrupt
+    bool Enabled;         // Interrupt enabled
+    gpio_isr_t Handler;   // Interrupt handler
+    void *Handler_Arg;    // Argument of the handler
+} Sim_Gpio_Isr_t;
+
+/** One LEDC low speed timer */
+typedef struct
+{
+    uint32_t Frequency_Hz;    // Output frequency, rounded
+    uint64_t Period_ps;       // Length of one period, 0 while unset
+    uint32_t Resolution_Bits; // Duty resolution
+} Sim_Ledc_Timer_t;
+
+/** One LEDC low speed channel */
+typedef struct
+{
+    ledc_timer_t Timer;    // Timer clocking the channel
+    uint32_t Duty;         // Applied duty
+    uint32_t Pending_Duty; // Duty applied by the next update
+    bool Output_Enabled;   // False after ledc_stop() until the next update
+    uint8_t Idle_Level;    // Level while stopped
+    uint8_t Level;         // Current output level
+    uint64_t Next_Rise_ns; // Start of the next period
+    uint64_t Next_Fall_ns; // End of the high time of the current period
+    uint32_t Remainder_ps; // Fraction of a ns carried to the next period
+} Sim_Ledc_Channel_t;
+
+/** One channel of a PCNT unit */
+typedef struct
+{
+    int Pulse_Gpio;              // Pad whose edges are counted
+    int Ctrl_Gpio;               // Pad whose level selects the mode, low if not used
+    pcnt_count_mode_t Pos_Mode;  // Action on a rising edge
+    pcnt_count_mode_t Neg_Mode;  // Action on a falling edge
+    pcnt_ctrl_mode_t Lctrl_Mode; // Mode while the control pad is low
+    pcnt_ctrl_mode_t Hctrl_Mode; // Mode while the control pad is high
+} Sim_Pcnt_Channel_t;
+
+/** One PCNT unit */
+typedef struct
+{
+    Sim_Pcnt_Channel_t Channels[PCNT_CHANNEL_MAX]; // Channels counting into the unit
+    bool Running;                                  // False while paused
+    int16_t Count;                                 // Counter value
+    int16_t High_Limit;                            // Counter resets and interrupts here
+    int16_t Low_Limit;                             // and here
+    uint32_t Events;                               // Enabled events
+    uint32_t Event_Status;                         // Events of the last interrupt
+    void (*Handler)(void *Arg);                    // Interrupt handler
+    void *Handler_Arg;                             // Argument of the handler
+} Sim_Pcnt_Unit_t;
+
+/** One timer of a timer group */
+typedef struct
+{
+    uint32_t Divider;           // Prescaler of the APB clock
+    bool Counting;              // Counter running
+    bool Alarm_Enabled;         // Alarm armed, cleared when it fires
+    bool Auto_Reload;           // Counter restarts at 0 on an alarm
+    uint64_t Alarm_Value;       // Counter value of the alarm
+    uint64_t Counter_Base;      // Counter value at Base_ns
+    uint64_t Base_ns;           // Time the counter was last loaded or started
+    void (*Handler)(void *Arg); // Interrupt handler
+    void *Handler_Arg;          // Argument of the handler
+} Sim_Timer_t;
+
+/** One key of the simulated NVS partition */
+typedef struct
+{
+    bool Used;                             // Entry holds a key
+    char Namespace[NVS_KEY_NAME_MAX_SIZE]; // Namespace of the key
+    char Key[NVS_KEY_NAME_MAX_SIZE];       // Key name
+    uint8_t Value[SIM_NVS_VALUE_SIZE];     // Blob
+    size_t Length;                         // Bytes in Value
+} Sim_Nvs_Entry_t;
+
+/** One open NVS handle */
+typedef struct
+{
+    bool Open;                             // Handle in use
+    bool Writable;                         // Opened with NVS_READWRITE
+    char Namespace[NVS_KEY_NAME_MAX_SIZE]; // Namespace of the handle
+} Sim_Nvs_Handle_t;
+
+static const uint8_t Encoder_Phase_A[4] = {0, 1, 1, 0}; // Level of encoder phase A at the count modulo 4, A leads B counting up
+static const uint8_t Encoder_Phase_B[4] = {0, 0, 1, 1}; // Level of encoder phase B
+
+gpio_dev_t GPIO;                                     // Output registers written by the example
+const uint32_t GPIO_PIN_MUX_REG[GPIO_NUM_MAX] = {0}; // No IO MUX in the simulation
+
+static uint64_t Now_ns = 0;                                // Virtual time
+static uint64_t Gpio_Out = 0;                              // Output register levels of all pads
+static uint8_t Pad_Level[GPIO_NUM_MAX];                    // Level of every pad
+static Sim_Pad_Source_t Pad_Source[GPIO_NUM_MAX];          // Source driving every pad
+static uint8_t Pad_Ledc_Channel[GPIO_NUM_MAX];             // LEDC channel of pads driven by the LEDC
+static char Pin_Names[GPIO_NUM_MAX][SIM_PIN_NAME_LENGTH];  // Names used in the exported timeline
+static Sim_Gpio_Isr_t Gpio_Isr[GPIO_NUM_MAX];              // Edge interrupts of the pads
+static bool Gpio_Isr_Service = false;                      // gpio_install_isr_service() was called
+static Sim_Ledc_Timer_t Ledc_Timers[LEDC_TIMER_MAX];       // LEDC low speed timers
+static Sim_Ledc_Channel_t Ledc_Channels[LEDC_CHANNEL_MAX]; // LEDC low speed channels
+static Sim_Pcnt_Unit_t Pcnt_Units[PCNT_UNIT_MAX];          // Pulse counter units
+static Sim_Timer_t Timers[TIMER_GROUP_MAX][TIMER_MAX];     // Timer group timers
+static uint32_t Notify_Value = 0;                          // Notification value of the task
+static bool Notify_Pending = false;                        // A notification was sent and not taken yet
+static int Sim_Task = 0;                                   // Address used as the handle of the task
+static Sim_Event_t *Events = NULL;                         // Recorded timeline
+static size_t Event_Count = 0;                             // Entries in Events
+static size_t Event_Capacity = 0;                          // Allocated entries of Events
+static Sim_Nvs_Entry_t Nvs_Entries[SIM_NVS_ENTRIES];       // NVS partition, kept over Sim_Reset() like flash
+static Sim_Nvs_Handle_t Nvs_Handles[SIM_NVS_HANDLES];      // Open NVS handles
+static bool Nvs_Initialized = false;                       // nvs_flash_init() was called
+static uint32_t Isr_Depth = 0;                             // Interrupt handlers running, see xPortInIsrContext()
+static uint64_t External_Irq_ns = SIM_NO_EVENT;            // Time of the interrupt set by Sim_Schedule_Interrupt()
+static void (*External_Irq_Handler)(void *Arg) = NULL;     // Handler of that interrupt
+static void *External_Irq_Arg = NULL;                      // Argument of that handler
+static uint8_t Input_Level[GPIO_NUM_MAX];                  // Level of the input pads
+static int Axis_Step_Gpio = -1;                            // Step pad of the simulated axis, -1 if not tracked
+static int Axis_Dir_Gpio = -1;                             // Direction pad of the simulated axis, high counts up
+static int32_t Axis_Position = 0;                          // Steps the simulated axis moved
+static int Switch_Gpio = -1;                               // Pad of the limit switch, -1 if there is none
+static uint8_t Switch_Active_Level = 0;                    // Pad level while the switch is pressed
+static int32_t Switch_Position = 0;                        // Axis position the switch is pressed at
+static bool Switch_Active_Below = false;                   // Pressed at and below Switch_Position, at and above otherwise
+static int Resonance_Gpio = -1;                            // Pad of the vibration sensor, -1 if there is none
+static uint32_t Resonance_Low_Hz = 0;                      // The axis resonates above this step rate
+static uint32_t Resonance_High_Hz = 0;                     // and below this one
+static uint64_t Last_Step_ns = SIM_NO_EVENT;               // Time of the last step of the axis
+static int Encoder_A_Gpio = -1;                            // Pad of encoder phase A, -1 if there is no encoder
+static int Encoder_B_Gpio = -1;                            // Pad of encoder phase B
+static int32_t Encoder_Counts_Per_Step_Q16 = 0;            // Encoder counts per rotor step in 16.16
+static int32_t Encoder_Count = 0;                          // Count the phase pads show
+static int32_t Rotor_Position = 0;                         // Steps the rotor really moved
+static bool Rotor_Stalled = false;                         // The rotor lost the step field and stands
+static uint32_t Load_Pull_Out_Hz = 0;                      // Highest step rate the motor holds, 0 if the rotor follows every step
+static uint32_t Load_Max_Acceleration = 0;                 // Highest acceleration at standstill in steps/s^2
+static uint64_t Rotor_Window_ns = SIM_NO_EVENT;            // Start of the window the acceleration is taken over
+static uint32_t Rotor_Window_Rate_Hz = 0;                  // Step rate at that start
+static uint64_t Rotor_Acceleration = 0;                    // Size of the acceleration of the last window in steps/s^2
+static uint64_t Console_Period_ns = 0;                     // Interval of the console writer turns, 0 without a console load
+static uint64_t Console_Busy_ns = 0;                       // CPU time the writer takes at the start of every turn
+static uint64_t Console_Start_ns = 0;                      // Start of the first writer turn
+
+static void Sync_Gpio(void);
+static void Update_Pad(int Gpio);
+
+/**
+ * @brief Drive the switch pad from the axis position.
+ */
+static void Update_Limit_Switch(void)
+{
+    if (Switch_Gpio < 0)
+    {
+        return;
+    }
+
+    bool Pressed = Switch_Active_Below ? (Axis_Position <= Switch_Position) : (Axis_Position >= Switch_Position);
+
+    Input_Level[Switch_Gpio] = Pressed ? Switch_Active_Level : !Switch_Active_Level;
+
+    if (Pad_Source[Switch_Gpio] == SIM_PAD_INPUT)
+    {
+        Update_Pad(Switch_Gpio);
+    }
+}
+
+/**
+ * @brief Toggle the sensor pad on a step of the axis taken at a resonant step rate.
+ */
+static void Update_Resonance_Sensor(void)
+{
+    uint64_t Interval_ns = (Last_Step_ns == SIM_NO_EVENT) ? 0 : (Now_ns - Last_Step_ns);
+
+    Last_Step_ns = Now_ns;
+
+    if ((Resonance_Gpio < 0) || (Interval_ns == 0))
+    {
+        return;
+    }
+
+    uint64_t Rate_Hz = 1000000000ULL / Interval_ns;
+
+    if ((Rate_Hz > Resonance_Low_Hz) && (Rate_Hz < Resonance_High_Hz))
+    {
+        Input_Level[Resonance_Gpio] = !Input_Level[Resonance_Gpio]; // One sensor edge every step
+
+        if (Pad_Source[Resonance_Gpio] == SIM_PAD_INPUT)
+        {
+            Update_Pad(Resonance_Gpio);
+        }
+    }
+}
+
+/**
+ * @brief Drive the phase pads of the encoder to the count of the rotor position.
+ */
+static void Update_Encoder(void)
+{
+    if (Encoder_A_Gpio < 0)
+    {
+        return;
+    }
+
+    int32_t Target = (int32_t)(((int64_t)Rotor_Position * Encoder_Counts_Per_Step_Q16) >> 16);
+
+    while (Encoder_Count != Target)
+    {
+        Encoder_Count += (Target > Encoder_Count) ? 1 : -1;
+
+        Input_Level[Encoder_A_Gpio] = Encoder_Phase_A[Encoder_Count & 3];
+        Input_Level[Encoder_B_Gpio] = Encoder_Phase_B[Encoder_Count & 3];
+
+        if (Pad_Source[Encoder_A_Gpio] == SIM_PAD_INPUT)
+        {
+            Update_Pad(Encoder_A_Gpio);
+        }
+
+        if (Pad_Source[Encoder_B_Gpio] == SIM_PAD_INPUT)
+        {
+            Update_Pad(Encoder_B_Gpio);
+        }
+    }
+}
+
+/**
+ * @brief Move the rotor with a step of the axis unless the load makes it stall.
+ *
+ * Runs before Update_Resonance_Sensor(), Last_Step_ns is still the time of
+ * the previous step.
+ */
+static void Update_Rotor(int32_t Step)
+{
+    uint64_t Interval_ns = (Last_Step_ns == SIM_NO_EVENT) ? SIM_LOAD_STANDSTILL_NS : (Now_ns - Last_Step_ns);
+    uint32_t Rate_Hz = (Interval_ns >= SIM_LOAD_STANDSTILL_NS) ? 0 : (Interval_ns == 0) ? UINT32_MAX : (uint32_t)(1000000000ULL / Interval_ns);
+
+    if (Rate_Hz == 0)
+    {
+        Rotor_Stalled = false; // A first step from standstill is always taken
+        Rotor_Window_ns = SIM_NO_EVENT;
+        Rotor_Acceleration = 0;
+    }
+    else if (Rotor_Window_ns == SIM_NO_EVENT)
+    {
+        Rotor_Window_ns = Now_ns;
+        Rotor_Window_Rate_Hz = Rate_Hz;
+    }
+    else if ((Now_ns - Rotor_Window_ns) >= SIM_LOAD_WINDOW_NS)
+    {
+        uint32_t Change_Hz = (Rate_Hz > Rotor_Window_Rate_Hz) ? (Rate_Hz - Rotor_Window_Rate_Hz) : (Rotor_Window_Rate_Hz - Rate_Hz);
+
+        Rotor_Acceleration = ((uint64_t)Change_Hz * 1000000000ULL) / (Now_ns - Rotor_Window_ns);
+        Rotor_Window_ns = Now_ns;
+        Rotor_Window_Rate_Hz = Rate_Hz;
+    }
+
+    if (Rotor_Stalled && (Rate_Hz <= SIM_LOAD_PULL_IN_HZ))
+    {
+        Rotor_Stalled = false; // Slow enough to catch the step field again
+    }
+    else if (!Rotor_Stalled && (Load_Pull_Out_Hz != 0) && (Rate_Hz > SIM_LOAD_PULL_IN_HZ))
+    {
+        uint64_t Torque_Left = (Rate_Hz >= Load_Pull_Out_Hz) ? 0 : (((uint64_t)Load_Max_Acceleration * (Load_Pull_Out_Hz - Rate_Hz)) / Load_Pull_Out_Hz);
+
+        Rotor_Stalled = (Rate_Hz > Load_Pull_Out_Hz) || (Rotor_Acceleration > Torque_Left);
+    }
+
+    if (!Rotor_Stalled)
+    {
+        Rotor_Position += Step;
+    }
+
+    Update_Encoder();
+}
+
+/**
+ * @brief Count an edge on the PCNT channels watching the pad.
+ */
+static void Count_Edge(int Gpio, uint8_t Level)
+{
+    for (int Unit = 0; Unit < PCNT_UNIT_MAX; Unit++)
+    {
+        Sim_Pcnt_Unit_t *Counter = &Pcnt_Units[Unit];
+
+        for (int Index = 0; Index < PCNT_CHANNEL_MAX; Index++)
+        {
+            const Sim_Pcnt_Channel_t *Channel = &Counter->Channels[Index];
+
+            if ((Channel->Pulse_Gpio != Gpio) || !Counter->Running)
+            {
+                continue;
+            }
+
+            uint8_t Ctrl_Level = (Channel->Ctrl_Gpio < 0) ? 0 : Pad_Level[Channel->Ctrl_Gpio];
+            pcnt_ctrl_mode_t Ctrl_Mode = Ctrl_Level ? Channel->Hctrl_Mode : Channel->Lctrl_Mode;
+            pcnt_count_mode_t Mode = Level ? Channel->Pos_Mode : Channel->Neg_Mode;
+
+            if ((Mode == PCNT_COUNT_DIS) || (Ctrl_Mode == PCNT_MODE_DISABLE))
+            {
+                continue;
+            }
+
+            bool Up = (Mode == PCNT_COUNT_INC) != (Ctrl_Mode == PCNT_MODE_REVERSE);
+            uint32_t Event = 0;
+
+            Counter->Count += Up ? 1 : -1;
+
+            if ((Counter->Events & PCNT_EVT_H_LIM) && (Counter->High_Limit > 0) && (Counter->Count >= Counter->High_Limit))
+            {
+                Event = PCNT_EVT_H_LIM;
+            }
+            else if ((Counter->Events & PCNT_EVT_L_LIM) && (Counter->Low_Limit < 0) && (Counter->Count <= Counter->Low_Limit))
+            {
+                Event = PCNT_EVT_L_LIM;
+            }
+
+            if (Event == 0)
+            {
+                continue;
+            }
+
+            Counter->Count = 0; // The unit resets itself on a limit
+            Counter->Event_Status = Event;
+
+            if (Counter->Handler != NULL)
+            {
+                Isr_Depth++;
+                Counter->Handler(Counter->Handler_Arg);
+                Isr_Depth--;
+
+                Sync_Gpio();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Append a level change to the timeline.
+ */
+static void Record_Event(int Gpio, uint8_t Level)
+{
+    if (Event_Count == Event_Capacity)
+    {
+        size_t Capacity = (Event_Capacity == 0) ? SIM_INITIAL_EVENT_CAPACITY : (2 * Event_Capacity);
+        Sim_Event_t *Grown = realloc(Events, Capacity * sizeof(Sim_Event_t));
+
+        if (Grown == NULL)
+        {
+            fprintf(stderr, "sim: timeline out of memory\n");
+            abort();
+        }
+
+        Events = Grown;
+        Event_Capacity = Capacity;
+    }
+
+    Events[Event_Count].Time_ns = Now_ns;
+    Events[Event_Count].Gpio = (uint8_t)Gpio;
+    Events[Event_Count].Level = Level;
+    Event_Count++;
+}
+
+/**
+ * @brief Bring a pad to the level of its source and record a change.
+ */
+static void Update_Pad(int Gpio)
+{
+    uint8_t Level = 0;
+
+    if (Pad_Source[Gpio] == SIM_PAD_LEDC)
+    {
+        Level = Ledc_Channels[Pad_Ledc_Channel[Gpio]].Level;
+    }
+    else if (Pad_Source[Gpio] == SIM_PAD_INPUT)
+    {
+        Level = Input_Level[Gpio];
+    }
+    else
+    {
+        Level = (uint8_t)((Gpio_Out >> Gpio) & 1);
+    }
+
+    if (Level == Pad_Level[Gpio])
+    {
+        return;
+    }
+
+    Pad_Level[Gpio] = Level;
+
+    Record_Event(Gpio, Level);
+
+    Count_Edge(Gpio, Level);
+
+    if (Level && (Gpio == Axis_Step_Gpio))
+    {
+        int32_t Step = ((Axis_Dir_Gpio >= 0) && Pad_Level[Axis_Dir_Gpio]) ? 1 : -1;
+
+        Axis_Position += Step;
+
+        Update_Limit_Switch();
+        Update_Rotor(Step);
+        Update_Resonance_Sensor();
+    }
+
+    const Sim_Gpio_Isr_t *Isr = &Gpio_Isr[Gpio];
+
+    if (Isr->Enabled && (Isr->Handler != NULL) && (Isr->Type & (Level ? GPIO_INTR_POSEDGE : GPIO_INTR_NEGEDGE)) && (Isr->Type <= GPIO_INTR_ANYEDGE))
+    {
+        Isr_Depth++;
+        Isr->Handler(Isr->Handler_Arg);
+        Isr_Depth--;
+    }
+}
+
+/**
+ * @brief Apply the set and clear registers written since the last call.
+ */
+static void Sync_Gpio(void)
+{
+    uint32_t Set = GPIO.out_w1ts;
+    uint32_t Clear = GPIO.out_w1tc;
+
+    GPIO.out_w1ts = 0;
+    GPIO.out_w1tc = 0;
+
+    Gpio_Out = (Gpio_Out & ~0xFFFFFFFFULL) | ((uint32_t)((GPIO.out | Set) & ~Clear));
+    GPIO.out = (uint32_t)Gpio_Out;
+
+    for (int Gpio = 0; Gpio < GPIO_NUM_MAX; Gpio++)
+    {
+        if (Pad_Source[Gpio] == SIM_PAD_GPIO)
+        {
+            Update_Pad(Gpio);
+        }
+    }
+}
+
+/**
+ * @brief Drive an LEDC channel and the pads routed to it.
+ */
+static void Set_Ledc_Level(ledc_channel_t Channel, uint8_t Level)
+{
+    Ledc_Channels[Channel].Level = Level;
+
+    for (int Gpio = 0; Gpio < GPIO_NUM_MAX; Gpio++)
+    {
+        if ((Pad_Source[Gpio] == SIM_PAD_LEDC) && (Pad_Ledc_Channel[Gpio] == Channel))
+        {
+            Update_Pad(Gpio);
+        }
+    }
+}
+
+/**
+ * @brief Start or stop the periods of an LEDC channel after a change.
+ */
+static void Update_Ledc_Channel(ledc_channel_t Channel)
+{
+    Sim_Ledc_Channel_t *Output = &Ledc_Channels[Channel];
+    bool Active = Output->Output_Enabled && (Output->Duty > 0) && (Ledc_Timers[Output->Timer].Period_ps > 0);
+
+    if (Active)
+    {
+        if (Output->Next_Rise_ns == SIM_NO_EVENT)
+        {
+            Output->Next_Rise_ns = Now_ns; // Periods start right away
+            Output->Remainder_ps = 0;
+        }
+
+        return;
+    }
+
+    Output->Next_Rise_ns = SIM_NO_EVENT;
+    Output->Next_Fall_ns = SIM_NO_EVENT;
+
+    Set_Ledc_Level(Channel, Output->Output_Enabled ? 0 : Output->Idle_Level);
+}
+
+/**
+ * @brief Start a period of an LEDC channel.
+ */
+static void Ledc_Rise(ledc_channel_t Channel)
+{
+    Sim_Ledc_Channel_t *Output = &Ledc_Channels[Channel];
+    const Sim_Ledc_Timer_t *Timer = &Ledc_Timers[Output->Timer];
+
+    uint64_t Period_ps = Timer->Period_ps + Output->Remainder_ps;
+    uint64_t Period_ns = Period_ps / 1000;
+    uint64_t High_ns = (Period_ns * Output->Duty) >> Timer->Resolution_Bits;
+
+    Output->Remainder_ps = (uint32_t)(Period_ps % 1000);
+    Output->Next_Rise_ns = Now_ns + Period_ns;
+    Output->Next_Fall_ns = (High_ns < Period_ns) ? (Now_ns + High_ns) : SIM_NO_EVENT; // Full duty stays high
+
+    Set_Ledc_Level(Channel, 1);
+}
+
+/**
+ * @brief Counter value of a timer at the current time.
+ */
+static uint64_t Timer_Counter(const Sim_Timer_t *Timer)
+{
+    if (!Timer->Counting)
+    {
+        return Timer->Counter_Base;
+    }
+
+    return Timer->Counter_Base + (((Now_ns - Timer->Base_ns) * (SIM_APB_CLK_HZ / 1000000)) / (Timer->Divider * 1000ULL));
+}
+
+/**
+ * @brief Time at which the alarm of a timer fires.
+ */
+static uint64_t Timer_Alarm_Time(const Sim_Timer_t *Timer)
+{
+    if (!Timer->Counting || !Timer->Alarm_Enabled || (Timer->Handler == NULL) || (Timer->Alarm_Value <= Timer->Counter_Base))
+    {
+        return SIM_NO_EVENT; // An alarm below the counter would only fire after the counter wraps
+    }
+
+    uint64_t Ticks = Timer->Alarm_Value - Timer->Counter_Base;
+
+    return Timer->Base_ns + (((Ticks * Timer->Divider * 1000ULL) + (SIM_APB_CLK_HZ / 1000000) - 1) / (SIM_APB_CLK_HZ / 1000000));
+}
+
+/**
+ * @brief Find and run the earliest scheduled hardware event up to a deadline.
+ *
+ * @return false if no event is due up to the deadline.
+ */
+static bool Run_Next_Event(uint64_t Deadline_ns)
+{
+    uint64_t Next_ns = SIM_NO_EVENT;
+    int Kind = -1; // 0 LEDC fall, 1 LEDC rise, 2 timer alarm, 3 external interrupt
+    int Index = 0; // Channel or timer of the event
+
+    for (int Channel = 0; Channel < LEDC_CHANNEL_MAX; Channel++)
+    {
+        if (Ledc_Channels[Channel].Next_Fall_ns < Next_ns)
+        {
+            Next_ns = Ledc_Channels[Channel].Next_Fall_ns;
+            Kind = 0;
+            Index = Channel;
+        }
+
+        if (Ledc_Channels[Channel].Next_Rise_ns < Next_ns)
+        {
+            Next_ns = Ledc_Channels[Channel].Next_Rise_ns;
+            Kind = 1;
+            Index = Channel;
+        }
+    }
+
+    for (int Timer = 0; Timer < (TIMER_GROUP_MAX * TIMER_MAX); Timer++)
+    {
+        uint64_t Alarm_ns = Timer_Alarm_Time(&Timers[Timer / TIMER_MAX][Timer % TIMER_MAX]);
+
+        if (Alarm_ns < Next_ns)
+        {
+            Next_ns = Alarm_ns;
+            Kind = 2;
+            Index = Timer;
+        }
+    }
+
+    if ((External_Irq_Handler != NULL) && (External_Irq_ns < Next_ns))
+    {
+        Next_ns = External_Irq_ns;
+        Kind = 3;
+    }
+
+    if ((Kind < 0) || (Next_ns > Deadline_ns))
+    {
+        return false;
+    }
+
+    Now_ns = (Next_ns > Now_ns) ? Next_ns : Now_ns;
+
+    if (Kind == 0)
+    {
+        Ledc_Channels[Index].Next_Fall_ns = SIM_NO_EVENT;
+
+        Set_Ledc_Level((ledc_channel_t)Index, 0);
+    }
+    else if (Kind == 1)
+    {
+        Ledc_Rise((ledc_channel_t)Index);
+    }
+    else if (Kind == 2)
+    {
+        Sim_Timer_t *Timer = &Timers[Index / TIMER_MAX][Index % TIMER_MAX];
+
+        Timer->Alarm_Enabled = false; // The alarm disarms itself when it fires
+
+        if (Timer->Auto_Reload)
+        {
+            Timer->Counter_Base = 0;
+        }
+        else
+        {
+            Timer->Counter_Base = Timer->Alarm_Value;
+        }
+
+        Timer->Base_ns = Now_ns;
+
+        Isr_Depth++;
+        Timer->Handler(Timer->Handler_Arg);
+        Isr_Depth--;
+
+        Sync_Gpio();
+    }
+    else
+    {
+        External_Irq_ns = SIM_NO_EVENT;
+
+        Isr_Depth++;
+        External_Irq_Handler(External_Irq_Arg);
+        Isr_Depth--;
+
+        Sync_Gpio();
+    }
+
+    return true;
+}
+
+/**
+ * @brief Advance the virtual clock, running every hardware event on the way.
+ *
+ * @param Deadline_ns Time to stop at, SIM_NO_EVENT to run while events are scheduled.
+ * @param Stop_On_Notify Stop as soon as the task has a notification.
+ */
+static void Run_Until(uint64_t Deadline_ns, bool Stop_On_Notify)
+{
+    Sync_Gpio();
+
+    while (!(Stop_On_Notify && Notify_Pending))
+    {
+        if (!Run_Next_Event(Deadline_ns))
+        {
+            if ((Deadline_ns != SIM_NO_EVENT) && (Deadline_ns > Now_ns))
+            {
+                Now_ns = Deadline_ns;
+            }
+
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Let the console writer finish its turn before the task runs on.
+ *
+ * Called where the task enters the simulation. Without a console load the
+ * task runs in zero time. With one, it waits while the writer holds the
+ * CPU and every entry costs SIM_CONSOLE_CALL_NS, so a writer turn can fall
+ * between two driver calls of the task. Interrupts are not delayed.
+ */
+static void Wait_For_Cpu(void)
+{
+    if ((Console_Period_ns == 0) || (Isr_Depth > 0))
+    {
+        return;
+    }
+
+    uint64_t Phase_ns = (Now_ns - Console_Start_ns) % Console_Period_ns;
+    uint64_t Resume_ns = Now_ns + ((Phase_ns < Console_Busy_ns) ? (Console_Busy_ns - Phase_ns) : 0);
+
+    Run_Until(Resume_ns + SIM_CONSOLE_CALL_NS, false);
+}
+
+/**
+ * @brief Put the simulated hardware and the virtual clock back to power on.
+ *
+ * Pin names are kept. The state of the example modules is not touched, so
+ * their initialization functions have to run again afterwards.
+ */
+void Sim_Reset(void)
+{
+    Now_ns = 0;
+    Gpio_Out = 0;
+    Notify_Value = 0;
+    Notify_Pending = false;
+    Event_Count = 0;
+
+    memset(&GPIO, 0, sizeof(GPIO));
+    memset(Pad_Level, 0, sizeof(Pad_Level));
+    memset(Pad_Source, 0, sizeof(Pad_Source));
+    memset(Pad_Ledc_Channel, 0, sizeof(Pad_Ledc_Channel));
+    memset(Ledc_Timers, 0, sizeof(Ledc_Timers));
+    memset(Pcnt_Units, 0, sizeof(Pcnt_Units));
+    memset(Timers, 0, sizeof(Timers));
+    memset(Gpio_Isr, 0, sizeof(Gpio_Isr));
+    Gpio_Isr_Service = false;
+    External_Irq_ns = SIM_NO_EVENT;
+    External_Irq_Handler = NULL;
+    memset(Input_Level, 0, sizeof(Input_Level));
+    Axis_Step_Gpio = -1;
+    Axis_Dir_Gpio = -1;
+    Axis_Position = 0;
+    Switch_Gpio = -1;
+    Resonance_Gpio = -1;
+    Last_Step_ns = SIM_NO_EVENT;
+    Encoder_A_Gpio = -1;
+    Encoder_B_Gpio = -1;
+    Encoder_Count = 0;
+    Rotor_Position = 0;
+    Rotor_Stalled = false;
+    Load_Pull_Out_Hz = 0;
+    Load_Max_Acceleration = 0;
+    Rotor_Window_ns = SIM_NO_EVENT;
+    Rotor_Acceleration = 0;
+    Console_Period_ns = 0;
+    Console_Busy_ns = 0;
+
+    for (int Channel = 0; Channel < LEDC_CHANNEL_MAX; Channel++)
+    {
+        memset(&Ledc_Channels[Channel], 0, sizeof(Ledc_Channels[Channel]));
+        Ledc_Channels[Channel].Next_Rise_ns = SIM_NO_EVENT;
+        Ledc_Channels[Channel].Next_Fall_ns = SIM_NO_EVENT;
+    }
+
+    for (int Unit = 0; Unit < PCNT_UNIT_MAX; Unit++)
+    {
+        for (int Channel = 0; Channel < PCNT_CHANNEL_MAX; Channel++)
+        {
+            Pcnt_Units[Unit].Channels[Channel].Pulse_Gpio = PCNT_PIN_NOT_USED;
+            Pcnt_Units[Unit].Channels[Channel].Ctrl_Gpio = PCNT_PIN_NOT_USED;
+        }
+    }
+}
+
+/**
+ * @brief Current virtual time.
+ */
+uint64_t Sim_Get_Time_ns(void)
+{
+    return Now_ns;
+}
+
+/**
+ * @brief Let the hardware run for a while without the task doing anything.
+ */
+void Sim_Run_For_us(uint64_t Duration_us)
+{
+    Run_Until(Now_ns + (Duration_us * 1000), false);
+}
+
+/**
+ * @brief Run a handler as an interrupt after a delay, e.g. an e-stop input.
+ *
+ * Only one interrupt is scheduled at a time, a new call replaces it.
+ *
+ * @param Delay_us Virtual time from now until the interrupt fires.
+ * @param Handler Interrupt handler, NULL cancels the scheduled interrupt.
+ * @param Arg Argument of the handler.
+ */
+void Sim_Schedule_Interrupt(uint64_t Delay_us, void (*Handler)(void *Arg), void *Arg)
+{
+    External_Irq_ns = Now_ns + (Delay_us * 1000);
+    External_Irq_Handler = Handler;
+    External_Irq_Arg = Arg;
+}
+
+/**
+ * @brief Share the CPU of the task with a console writer printing without pause.
+ *
+ * The writer runs above the task, like the console writer task draining
+ * printed text into the UART, and takes the CPU for Busy_us at the start
+ * of every Period_us from now on, see Wait_For_Cpu().
+ *
+ * @param Period_us Interval of the writer turns, 0 removes the load.
+ * @param Busy_us CPU time of one turn, below Period_us.
+ */
+void Sim_Set_Console_Load(uint32_t Period_us, uint32_t Busy_us)
+{
+    Console_Period_ns = (uint64_t)Period_us * 1000;
+    Console_Busy_ns = (Busy_us < Period_us) ? ((uint64_t)Busy_us * 1000) : 0;
+    Console_Start_ns = Now_ns;
+}
+
+/**
+ * @brief Track the position of an axis from its step and direction pads.
+ *
+ * Every rising edge of the step pad moves the axis by one step, up while
+ * the direction pad is high. The position starts at 0.
+ */
+void Sim_Set_Axis_Pins(gpio_num_t Step_Gpio, gpio_num_t Dir_Gpio)
+{
+    Sync_Gpio();
+
+    Axis_Step_Gpio = Step_Gpio;
+    Axis_Dir_Gpio = Dir_Gpio;
+    Axis_Position = 0;
+    Rotor_Position = 0;
+}
+
+/**
+ * @brief Steps the tracked axis moved, see Sim_Set_Axis_Pins().
+ */
+int32_t Sim_Get_Axis_Position(void)
+{
+    Sync_Gpio();
+
+    return Axis_Position;
+}
+
+/**
+ * @brief Put a limit switch on the tracked axis.
+ *
+ * The switch drives the input pad to Active_Level while it is pressed and
+ * to the other level otherwise. It is pressed from Trigger_Position on,
+ * toward lower positions if Active_Below is set.
+ */
+void Sim_Set_Limit_Switch(gpio_num_t Gpio, uint8_t Active_Level, int32_t Trigger_Position, bool Active_Below)
+{
+    if ((Gpio < 0) || (Gpio >= GPIO_NUM_MAX))
+    {
+        return;
+    }
+
+    Sync_Gpio();
+
+    Switch_Gpio = Gpio;
+    Switch_Active_Level = Active_Level ? 1 : 0;
+    Switch_Position = Trigger_Position;
+    Switch_Active_Below = Active_Below;
+
+    Update_Limit_Switch();
+}
+
+/**
+ * @brief Put a vibration sensor on the tracked axis.
+ *
+ * The sensor toggles the input pad on every step taken less than 1/Low_Hz
+ * and more than 1/High_Hz after the previous one. A Low_Hz at or above
+ * High_Hz removes the resonance.
+ */
+void Sim_Set_Resonance(gpio_num_t Gpio, uint32_t Low_Hz, uint32_t High_Hz)
+{
+    if ((Gpio < 0) || (Gpio >= GPIO_NUM_MAX))
+    {
+        return;
+    }
+
+    Sync_Gpio();
+
+    Resonance_Gpio = (Low_Hz < High_Hz) ? Gpio : -1;
+    Resonance_Low_Hz = Low_Hz;
+    Resonance_High_Hz = High_Hz;
+}
+
+/**
+ * @brief Put a quadrature encoder on the rotor of the tracked axis.
+ *
+ * The phase pads become inputs that follow the rotor position, A leads B
+ * while it moves forward. A Gpio of -1 removes the encoder.
+ *
+ * @param A_Gpio Pad of phase A.
+ * @param B_Gpio Pad of phase B.
+ * @param Counts_Per_Step_Q16 Encoder counts per step in 16.16 fixed point.
+ */
+void Sim_Set_Encoder(gpio_num_t A_Gpio, gpio_num_t B_Gpio, int32_t Counts_Per_Step_Q16)
+{
+    Sync_Gpio();
+
+    if ((A_Gpio < 0) || (A_Gpio >= GPIO_NUM_MAX) || (B_Gpio < 0) || (B_Gpio >= GPIO_NUM_MAX))
+    {
+        Encoder_A_Gpio = -1;
+        Encoder_B_Gpio = -1;
+        return;
+    }
+
+    Encoder_A_Gpio = A_Gpio;
+    Encoder_B_Gpio = B_Gpio;
+    Encoder_Counts_Per_Step_Q16 = Counts_Per_Step_Q16;
+    Encoder_Count = (int32_t)(((int64_t)Rotor_Position * Counts_Per_Step_Q16) >> 16);
+    Input_Level[A_Gpio] = Encoder_Phase_A[Encoder_Count & 3];
+    Input_Level[B_Gpio] = Encoder_Phase_B[Encoder_Count & 3];
+    Pad_Source[A_Gpio] = SIM_PAD_INPUT; // The encoder drives its pads
+    Pad_Source[B_Gpio] = SIM_PAD_INPUT;
+
+    Update_Pad(A_Gpio);
+    Update_Pad(B_Gpio);
+}
+
+/**
+ * @brief Give the motor of the tracked axis a load it can stall on.
+ *
+ * Above SIM_LOAD_PULL_IN_HZ the rotor only follows the steps while their
+ * rate stays below Pull_Out_Hz and its acceleration below Max_Acceleration
+ * scaled down linearly to 0 at the pull-out rate, like the falling torque
+ * curve of a stepper. A stalled rotor stands until the rate is back at the
+ * pull-in rate or the axis stood still. A Pull_Out_Hz of 0 removes the
+ * load, the rotor follows every step.
+ */
+void Sim_Set_Motor_Load(uint32_t Pull_Out_Hz, uint32_t Max_Acceleration)
+{
+    Sync_Gpio();
+
+    Load_Pull_Out_Hz = Pull_Out_Hz;
+    Load_Max_Acceleration = Max_Acceleration;
+    Rotor_Stalled = false;
+}
+
+/**
+ * @brief Steps the rotor of the tracked axis really moved.
+ */
+int32_t Sim_Get_Rotor_Position(void)
+{
+    Sync_Gpio();
+
+    return Rotor_Position;
+}
+
+/**
+ * @brief Name a pad in the exported timeline, unnamed pads are called gpio<N>.
+ */
+void Sim_Set_Pin_Name(gpio_num_t Gpio, const char *Name)
+{
+    if ((Gpio >= 0) && (Gpio < GPIO_NUM_MAX))
+    {
+        snprintf(Pin_Names[Gpio], sizeof(Pin_Names[Gpio]), "%s", Name);
+    }
+}
+
+/**
+ * @brief Current level of a pad.
+ */
+int Sim_Get_Level(gpio_num_t Gpio)
+{
+    Sync_Gpio();
+
+    return ((Gpio >= 0) && (Gpio < GPIO_NUM_MAX)) ? Pad_Level[Gpio] : 0;
+}
+
+/**
+ * @brief Number of recorded level changes.
+ */
+size_t Sim_Get_Event_Count(void)
+{
+    return Event_Count;
+}
+
+/**
+ * @brief Recorded level changes, ordered by time.
+ */
+const Sim_Event_t *Sim_Get_Events(void)
+{
+    return Events;
+}
+
+/**
+ * @brief Rising edges of a pad in [From_ns, To_ns).
+ */
+uint32_t Sim_Count_Rising_Edges(gpio_num_t Gpio, uint64_t From_ns, uint64_t To_ns)
+{
+    uint32_t Edges = 0;
+
+    for (size_t Index = 0; Index < Event_Count; Index++)
+    {
+        const Sim_Event_t *Event = &Events[Index];
+
+        if ((Event->Gpio == Gpio) && Event->Level && (Event->Time_ns >= From_ns) && (Event->Time_ns < To_ns))
+        {
+            Edges++;
+        }
+    }
+
+    return Edges;
+}
+
+/**
+ * @brief Name of a pad in the exported timeline.
+ */
+static const char *Pin_Name(int Gpio, char *Buffer, size_t Size)
+{
+    if (Pin_Names[Gpio][0] != '\0')
+    {
+        return Pin_Names[Gpio];
+    }
+
+    snprintf(Buffer, Size, "gpio%d", Gpio);
+
+    return Buffer;
+}
+
+/**
+ * @brief Write the timeline as a value change dump with a 1 ns timescale.
+ *
+ * Named pads and every pad that changed are included, all start low.
+ *
+ * @return false if the file could not be written.
+ */
+bool Sim_Export_VCD(const char *Path)
+{
+    bool Used[GPIO_NUM_MAX] = {false};
+    char Name[SIM_PIN_NAME_LENGTH];
+    FILE *File = fopen(Path, "w");
+
+    if (File == NULL)
+    {
+        return false;
+    }
+
+    for (size_t Index = 0; Index < Event_Count; Index++)
+    {
+        Used[Events[Index].Gpio] = true;
+    }
+
+    fprintf(File, "$timescale 1 ns $end\n$scope module stepper $end\n");
+
+    for (int Gpio = 0; Gpio < GPIO_NUM_MAX; Gpio++)
+    {
+        Used[Gpio] = Used[Gpio] || (Pin_Names[Gpio][0] != '\0');
+
+        if (Used[Gpio])
+        {
+            fprintf(File, "$var wire 1 %c %s $end\n", '!' + Gpio, Pin_Name(Gpio, Name, sizeof(Name)));
+        }
+    }
+
+    fprintf(File, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+
+    for (int Gpio = 0; Gpio < GPIO_NUM_MAX; Gpio++)
+    {
+        if (Used[Gpio])
+        {
+            fprintf(File, "0%c\n", '!' + Gpio);
+        }
+    }
+
+    fprintf(File, "$end\n");
+
+    uint64_t Last_Time_ns = 0;
+
+    for (size_t Index = 0; Index < Event_Count; Index++)
+    {
+        if (Events[Index].Time_ns != Last_Time_ns)
+        {
+            Last_Time_ns = Events[Index].Time_ns;
+
+            fprintf(File, "#%llu\n", (unsigned long long)Last_Time_ns);
+        }
+
+        fprintf(File, "%u%c\n", Events[Index].Level, '!' + Events[Index].Gpio);
+    }
+
+    return fclose(File) == 0;
+}
+
+/**
+ * @brief Write the timeline as CSV: time_ns,gpio,name,level.
+ *
+ * @return false if the file could not be written.
+ */
+bool Sim_Export_CSV(const char *Path)
+{
+    char Name[SIM_PIN_NAME_LENGTH];
+    FILE *File = fopen(Path, "w");
+
+    if (File == NULL)
+    {
+        return false;
+    }
+
+    fprintf(File, "time_ns,gpio,name,level\n");
+
+    for (size_t Index = 0; Index < Event_Count; Index++)
+    {
+        const Sim_Event_t *Event = &Events[Index];
+
+        fprintf(File, "%llu,%u,%s,%u\n", (unsigned long long)Event->Time_ns, Event->Gpio, Pin_Name(Event->Gpio, Name, sizeof(Name)), Event->Level);
+    }
+
+    return fclose(File) == 0;
+}
+
+/* ------------------------------------------------------------------------
+ * ESP-IDF and FreeRTOS stand-ins
+ * ------------------------------------------------------------------------ */
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:
+        return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED:
+        return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_RESPONSE:
+        return "ESP_ERR_INVALID_RESPONSE";
+    case ESP_ERR_NVS_NOT_INITIALIZED:
+        return "ESP_ERR_NVS_NOT_INITIALIZED";
+    case ESP_ERR_NVS_NOT_FOUND:
+        return "ESP_ERR_NVS_NOT_FOUND";
+    case ESP_ERR_NVS_NOT_ENOUGH_SPACE:
+        return "ESP_ERR_NVS_NOT_ENOUGH_SPACE";
+    default:
+        return "UNKNOWN ERROR";
+    }
+}
+
+void Sim_Error_Check_Failed(esp_err_t Code, const char *File, int Line)
+{
+    fprintf(stderr, "ESP_ERROR_CHECK failed: %s (0x%x) at %s:%d\n", esp_err_to_name(Code), Code, File, Line);
+    abort();
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)(Now_ns / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return &Sim_Task;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(Now_ns / SIM_TICK_PERIOD_NS);
+}
+
+void vTaskDelay(TickType_t Ticks)
+{
+    Run_Until(Now_ns + ((uint64_t)Ticks * SIM_TICK_PERIOD_NS), false);
+    Wait_For_Cpu();
+}
+
+BaseType_t xTaskNotify(TaskHandle_t Task, uint32_t Value, eNotifyAction Action)
+{
+    (void)Task;
+
+    if (Action == eSetBits)
+    {
+        Notify_Value |= Value;
+    }
+    else if (Action == eIncrement)
+    {
+        Notify_Value++;
+    }
+    else if (Action != eNoAction)
+    {
+        Notify_Value = Value;
+    }
+
+    Notify_Pending = true;
+
+    return pdPASS;
+}
+
+BaseType_t xPortInIsrContext(void)
+{
+    return (Isr_Depth > 0) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t Task, uint32_t Value, eNotifyAction Action, BaseType_t *Higher_Priority_Task_Woken)
+{
+    if (Higher_Priority_Task_Woken != NULL)
+    {
+        *Higher_Priority_Task_Woken = pdTRUE;
+    }
+
+    return xTaskNotify(Task, Value, Action);
+}
+
+BaseType_t xTaskNotifyWait(unsigned long Clear_On_Entry, unsigned long Clear_On_Exit, uint32_t *Value, TickType_t Ticks)
+{
+    if (!Notify_Pending)
+    {
+        Notify_Value &= ~(uint32_t)Clear_On_Entry;
+    }
+
+    Run_Until((Ticks == portMAX_DELAY) ? SIM_NO_EVENT : (Now_ns + ((uint64_t)Ticks * SIM_TICK_PERIOD_NS)), true);
+    Wait_For_Cpu();
+
+    if (!Notify_Pending)
+    {
+        if (Ticks == portMAX_DELAY)
+        {
+            fprintf(stderr, "sim: task waits forever, nothing is scheduled\n");
+        }
+
+        return pdFALSE;
+    }
+
+    if (Value != NULL)
+    {
+        *Value = Notify_Value;
+    }
+
+    Notify_Value &= ~(uint32_t)Clear_On_Exit;
+    Notify_Pending = false;
+
+    return pdTRUE;
+}
+
+esp_err_t gpio_config(const gpio_config_t *Config)
+{
+    if ((Config->pin_bit_mask >> GPIO_NUM_MAX) != 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    for (int Gpio = 0; Gpio < GPIO_NUM_MAX; Gpio++)
+    {
+        if ((Config->pin_bit_mask & (1ULL << Gpio)) && (Config->mode & GPIO_MODE_OUTPUT))
+        {
+            Pad_Source[Gpio] = SIM_PAD_GPIO;
+
+            Update_Pad(Gpio);
+        }
+        else if ((Config->pin_bit_mask & (1ULL << Gpio)) && (Config->mode == GPIO_MODE_INPUT))
+        {
+            Pad_Source[Gpio] = SIM_PAD_INPUT;
+            Gpio_Isr[Gpio].Type = (gpio_int_type_t)Config->intr_type;
+            Input_Level[Gpio] = Config->pull_up_en ? 1 : 0; // Nothing drives an open input but its pull
+
+            if (Gpio == Switch_Gpio)
+            {
+                Update_Limit_Switch();
+            }
+            else
+            {
+                Update_Pad(Gpio);
+            }
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t Gpio, uint32_t Level)
+{
+    Wait_For_Cpu();
+
+    if ((Gpio < 0) || (Gpio >= GPIO_NUM_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    Gpio_Out = Level ? (Gpio_Out | (1ULL << Gpio)) : (Gpio_Out & ~(1ULL << Gpio));
+    GPIO.out = (uint32_t)Gpio_Out;
+
+    Update_Pad(Gpio);
+
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t Gpio)
+{
+    return Sim_Get_Level(Gpio);
+}
+
+esp_err_t gpio_set_direction(gpio_num_t Gpio, gpio_mode_t Mode)
+{
+    (void)Mode;
+
+    return ((Gpio >= 0) && (Gpio < GPIO_NUM_MAX)) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t Gpio, gpio_int_type_t Type)
+{
+    if ((Gpio < 0) || (Gpio >= GPIO_NUM_MAX) || (Type >= GPIO_INTR_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Gpio_Isr[Gpio].Type = Type;
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t Gpio)
+{
+    if ((Gpio < 0) || (Gpio >= GPIO_NUM_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio(); // Edges written before are not seen by the interrupt
+
+    Gpio_Isr[Gpio].Enabled = true;
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t Gpio)
+{
+    if ((Gpio < 0) || (Gpio >= GPIO_NUM_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Gpio_Isr[Gpio].Enabled = false;
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int Intr_Alloc_Flags)
+{
+    (void)Intr_Alloc_Flags;
+
+    if (Gpio_Isr_Service)
+    {
+        return ESP_ERR_INVALID_STATE; // Like ESP-IDF, the service is installed once
+    }
+
+    Gpio_Isr_Service = true;
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t Gpio, gpio_isr_t Handler, void *Arg)
+{
+    if (!Gpio_Isr_Service)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if ((Gpio < 0) || (Gpio >= GPIO_NUM_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Gpio_Isr[Gpio].Handler = Handler;
+    Gpio_Isr[Gpio].Handler_Arg = Arg;
+    Gpio_Isr[Gpio].Enabled = true; // Adding a handler enables the interrupt, like ESP-IDF
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t Gpio)
+{
+    if ((Gpio < 0) || (Gpio >= GPIO_NUM_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Gpio_Isr[Gpio].Handler = NULL;
+    Gpio_Isr[Gpio].Handler_Arg = NULL;
+    Gpio_Isr[Gpio].Enabled = false;
+
+    return ESP_OK;
+}
+
+void gpio_matrix_out(uint32_t Gpio, uint32_t Signal_Index, bool Out_Invert, bool Enable_Invert)
+{
+    (void)Out_Invert;
+    (void)Enable_Invert;
+
+    if (Gpio >= GPIO_NUM_MAX)
+    {
+        return;
+    }
+
+    Sync_Gpio();
+
+    if ((Signal_Index >= LEDC_LS_SIG_OUT0_IDX) && (Signal_Index < (LEDC_LS_SIG_OUT0_IDX + LEDC_CHANNEL_MAX)))
+    {
+        Pad_Source[Gpio] = SIM_PAD_LEDC;
+        Pad_Ledc_Channel[Gpio] = (uint8_t)(Signal_Index - LEDC_LS_SIG_OUT0_IDX);
+    }
+    else
+    {
+        Pad_Source[Gpio] = SIM_PAD_GPIO; // Other peripherals are not simulated
+    }
+
+    Update_Pad((int)Gpio);
+}
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *Config)
+{
+    if ((Config->speed_mode != LEDC_LOW_SPEED_MODE) || (Config->timer_num >= LEDC_TIMER_MAX))
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    Ledc_Timers[Config->timer_num].Resolution_Bits = Config->duty_resolution;
+
+    return ledc_set_freq(Config->speed_mode, Config->timer_num, Config->freq_hz);
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *Config)
+{
+    if ((Config->speed_mode != LEDC_LOW_SPEED_MODE) || (Config->channel >= LEDC_CHANNEL_MAX) || (Config->gpio_num < 0) || (Config->gpio_num >= GPIO_NUM_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    Sim_Ledc_Channel_t *Output = &Ledc_Channels[Config->channel];
+
+    Output->Timer = Config->timer_sel;
+    Output->Duty = Config->duty;
+    Output->Pending_Duty = Config->duty;
+    Output->Output_Enabled = true;
+
+    Pad_Source[Config->gpio_num] = SIM_PAD_LEDC;
+    Pad_Ledc_Channel[Config->gpio_num] = (uint8_t)Config->channel;
+
+    Update_Ledc_Channel(Config->channel);
+    Update_Pad(Config->gpio_num);
+
+    return ESP_OK;
+}
+
+esp_err_t ledc_fade_func_install(int Intr_Alloc_Flags)
+{
+    (void)Intr_Alloc_Flags;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Restart or stop the channels of an LEDC timer after it changed.
+ */
+static void Update_Ledc_Timer_Channels(ledc_timer_t Timer)
+{
+    for (int Channel = 0; Channel < LEDC_CHANNEL_MAX; Channel++)
+    {
+        if (Ledc_Channels[Channel].Timer == Timer)
+        {
+            Update_Ledc_Channel((ledc_channel_t)Channel);
+        }
+    }
+}
+
+esp_err_t ledc_timer_set(ledc_mode_t Speed_Mode, ledc_timer_t Timer, uint32_t Clock_Divider, uint32_t Duty_Resolution, ledc_clk_src_t Clock_Source)
+{
+    Wait_For_Cpu();
+
+    if ((Speed_Mode != LEDC_LOW_SPEED_MODE) || (Timer >= LEDC_TIMER_MAX) || (Clock_Divider < 256) || (Clock_Divider >= (1UL << 18)) ||
+        (Duty_Resolution < LEDC_TIMER_1_BIT) || (Duty_Resolution > LEDC_TIMER_20_BIT))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    uint32_t Clock_Hz = (Clock_Source == LEDC_REF_TICK) ? SIM_REF_TICK_HZ : SIM_APB_CLK_HZ;
+    uint64_t Cycles_Q8 = (uint64_t)Clock_Divider << Duty_Resolution; // Source clock cycles of a period, divider in 10.8 fixed point
+
+    Ledc_Timers[Timer].Period_ps = (Cycles_Q8 * 15625) / (Clock_Hz / 250000); // 10^12 / 256 ps per cycle, exact for both clocks
+    Ledc_Timers[Timer].Frequency_Hz = (uint32_t)(((((uint64_t)Clock_Hz << 8) + (Cycles_Q8 / 2)) / Cycles_Q8));
+    Ledc_Timers[Timer].Resolution_Bits = Duty_Resolution; // Together with the divider at the next period, like the overflow update of the chip
+
+    Update_Ledc_Timer_Channels(Timer);
+
+    return ESP_OK;
+}
+
+esp_err_t ledc_set_freq(ledc_mode_t Speed_Mode, ledc_timer_t Timer, uint32_t Frequency_Hz)
+{
+    Wait_For_Cpu();
+
+    if ((Speed_Mode != LEDC_LOW_SPEED_MODE) || (Timer >= LEDC_TIMER_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    if ((Frequency_Hz == 0) || (((uint64_t)Frequency_Hz << Ledc_Timers[Timer].Resolution_Bits) > SIM_APB_CLK_HZ))
+    {
+        return ESP_FAIL; // No clock divider for this frequency and resolution
+    }
+
+    Ledc_Timers[Timer].Frequency_Hz = Frequency_Hz; // Running channels switch at their next period
+    Ledc_Timers[Timer].Period_ps = 1000000000000ULL / Frequency_Hz;
+
+    Update_Ledc_Timer_Channels(Timer);
+
+    return ESP_OK;
+}
+
+uint32_t ledc_get_freq(ledc_mode_t Speed_Mode, ledc_timer_t Timer)
+{
+    return ((Speed_Mode == LEDC_LOW_SPEED_MODE) && (Timer < LEDC_TIMER_MAX)) ? Ledc_Timers[Timer].Frequency_Hz : 0;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t Speed_Mode, ledc_channel_t Channel, uint32_t Duty)
+{
+    Wait_For_Cpu();
+
+    if ((Speed_Mode != LEDC_LOW_SPEED_MODE) || (Channel >= LEDC_CHANNEL_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Ledc_Channels[Channel].Pending_Duty = Duty;
+
+    return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t Speed_Mode, ledc_channel_t Channel)
+{
+    Wait_For_Cpu();
+
+    if ((Speed_Mode != LEDC_LOW_SPEED_MODE) || (Channel >= LEDC_CHANNEL_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    Ledc_Channels[Channel].Duty = Ledc_Channels[Channel].Pending_Duty;
+    Ledc_Channels[Channel].Output_Enabled = true; // An update also restarts a stopped channel
+
+    Update_Ledc_Channel(Channel);
+
+    return ESP_OK;
+}
+
+esp_err_t ledc_set_duty_and_update(ledc_mode_t Speed_Mode, ledc_channel_t Channel, uint32_t Duty, uint32_t Hpoint)
+{
+    (void)Hpoint;
+
+    esp_err_t Function_Error = ledc_set_duty(Speed_Mode, Channel, Duty);
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    return ledc_update_duty(Speed_Mode, Channel);
+}
+
+esp_err_t ledc_stop(ledc_mode_t Speed_Mode, ledc_channel_t Channel, uint32_t Idle_Level)
+{
+    Wait_For_Cpu();
+
+    if ((Speed_Mode != LEDC_LOW_SPEED_MODE) || (Channel >= LEDC_CHANNEL_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    Ledc_Channels[Channel].Output_Enabled = false;
+    Ledc_Channels[Channel].Idle_Level = Idle_Level ? 1 : 0;
+
+    Update_Ledc_Channel(Channel);
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_config(const pcnt_config_t *Config)
+{
+    if ((Config->unit >= PCNT_UNIT_MAX) || (Config->channel >= PCNT_CHANNEL_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sim_Pcnt_Unit_t *Counter = &Pcnt_Units[Config->unit];
+    Sim_Pcnt_Channel_t *Channel = &Counter->Channels[Config->channel];
+
+    Channel->Pulse_Gpio = Config->pulse_gpio_num;
+    Channel->Ctrl_Gpio = Config->ctrl_gpio_num;
+    Channel->Pos_Mode = Config->pos_mode;
+    Channel->Neg_Mode = Config->neg_mode;
+    Channel->Lctrl_Mode = Config->lctrl_mode;
+    Channel->Hctrl_Mode = Config->hctrl_mode;
+    Counter->High_Limit = Config->counter_h_lim;
+    Counter->Low_Limit = Config->counter_l_lim;
+    Counter->Count = 0;
+    Counter->Running = true;
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_set_filter_value(pcnt_unit_t Unit, uint16_t Filter_Value)
+{
+    (void)Filter_Value;
+
+    return (Unit < PCNT_UNIT_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_filter_enable(pcnt_unit_t Unit)
+{
+    return (Unit < PCNT_UNIT_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_event_enable(pcnt_unit_t Unit, pcnt_evt_type_t Event)
+{
+    if (Unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Pcnt_Units[Unit].Events |= Event;
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_set_event_value(pcnt_unit_t Unit, pcnt_evt_type_t Event, int16_t Value)
+{
+    Wait_For_Cpu();
+
+    if (Unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (Event == PCNT_EVT_H_LIM)
+    {
+        Pcnt_Units[Unit].High_Limit = Value;
+    }
+    else if (Event == PCNT_EVT_L_LIM)
+    {
+        Pcnt_Units[Unit].Low_Limit = Value;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_get_event_status(pcnt_unit_t Unit, uint32_t *Status)
+{
+    if (Unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *Status = Pcnt_Units[Unit].Event_Status;
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_get_counter_value(pcnt_unit_t Unit, int16_t *Count)
+{
+    Wait_For_Cpu();
+
+    if (Unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *Count = Pcnt_Units[Unit].Count;
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_counter_pause(pcnt_unit_t Unit)
+{
+    Wait_For_Cpu();
+
+    if (Unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Pcnt_Units[Unit].Running = false;
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_counter_resume(pcnt_unit_t Unit)
+{
+    Wait_For_Cpu();
+
+    if (Unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Pcnt_Units[Unit].Running = true;
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_counter_clear(pcnt_unit_t Unit)
+{
+    Wait_For_Cpu();
+
+    if (Unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Pcnt_Units[Unit].Count = 0;
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_isr_service_install(int Intr_Alloc_Flags)
+{
+    (void)Intr_Alloc_Flags;
+
+    return ESP_OK;
+}
+
+esp_err_t pcnt_isr_handler_add(pcnt_unit_t Unit, void (*Handler)(void *), void *Arg)
+{
+    if (Unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Pcnt_Units[Unit].Handler = Handler;
+    Pcnt_Units[Unit].Handler_Arg = Arg;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Timer of a group, NULL for an invalid index.
+ */
+static Sim_Timer_t *Get_Timer(timer_group_t Group, timer_idx_t Timer)
+{
+    return ((Group < TIMER_GROUP_MAX) && (Timer < TIMER_MAX)) ? &Timers[Group][Timer] : NULL;
+}
+
+/**
+ * @brief Load the counter of a timer.
+ */
+static void Load_Timer_Counter(Sim_Timer_t *Timer, uint64_t Value)
+{
+    Timer->Counter_Base = Value;
+    Timer->Base_ns = Now_ns;
+}
+
+esp_err_t timer_init(timer_group_t Group, timer_idx_t Timer, const timer_config_t *Config)
+{
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    if ((Step_Timer == NULL) || (Config->divider < 2) || (Config->counter_dir != TIMER_COUNT_UP))
+    {
+        return ESP_ERR_INVALID_ARG; // Counting down is not simulated
+    }
+
+    Step_Timer->Divider = Config->divider;
+    Step_Timer->Counting = (Config->counter_en == TIMER_START);
+    Step_Timer->Alarm_Enabled = (Config->alarm_en == TIMER_ALARM_EN);
+    Step_Timer->Auto_Reload = (Config->auto_reload == TIMER_AUTORELOAD_EN);
+
+    Load_Timer_Counter(Step_Timer, 0);
+
+    return ESP_OK;
+}
+
+esp_err_t timer_set_counter_value(timer_group_t Group, timer_idx_t Timer, uint64_t Value)
+{
+    Wait_For_Cpu();
+
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    if (Step_Timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    Load_Timer_Counter(Step_Timer, Value);
+
+    return ESP_OK;
+}
+
+esp_err_t timer_set_alarm_value(timer_group_t Group, timer_idx_t Timer, uint64_t Value)
+{
+    Wait_For_Cpu();
+
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    if (Step_Timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    Step_Timer->Alarm_Value = Value;
+
+    return ESP_OK;
+}
+
+esp_err_t timer_set_alarm(timer_group_t Group, timer_idx_t Timer, timer_alarm_t Alarm)
+{
+    Wait_For_Cpu();
+
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    if (Step_Timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Step_Timer->Alarm_Enabled = (Alarm == TIMER_ALARM_EN);
+
+    return ESP_OK;
+}
+
+esp_err_t timer_enable_intr(timer_group_t Group, timer_idx_t Timer)
+{
+    return (Get_Timer(Group, Timer) != NULL) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t timer_isr_register(timer_group_t Group, timer_idx_t Timer, void (*Handler)(void *), void *Arg, int Intr_Alloc_Flags, timer_isr_handle_t *Handle)
+{
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    (void)Intr_Alloc_Flags;
+
+    if (Step_Timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Step_Timer->Handler = Handler;
+    Step_Timer->Handler_Arg = Arg;
+
+    if (Handle != NULL)
+    {
+        *Handle = Step_Timer;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t timer_start(timer_group_t Group, timer_idx_t Timer)
+{
+    Wait_For_Cpu();
+
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    if (Step_Timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    timer_group_set_counter_enable_in_isr(Group, Timer, TIMER_START);
+
+    return ESP_OK;
+}
+
+esp_err_t timer_pause(timer_group_t Group, timer_idx_t Timer)
+{
+    Wait_For_Cpu();
+
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    if (Step_Timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Sync_Gpio();
+
+    timer_group_set_counter_enable_in_isr(Group, Timer, TIMER_PAUSE);
+
+    return ESP_OK;
+}
+
+void timer_group_clr_intr_status_in_isr(timer_group_t Group, timer_idx_t Timer)
+{
+    (void)Group;
+    (void)Timer;
+}
+
+void timer_group_set_counter_enable_in_isr(timer_group_t Group, timer_idx_t Timer, timer_start_t Enable)
+{
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+    bool Counting = (Enable == TIMER_START);
+
+    if ((Step_Timer == NULL) || (Step_Timer->Counting == Counting))
+    {
+        return;
+    }
+
+    Load_Timer_Counter(Step_Timer, Timer_Counter(Step_Timer)); // Freeze or restart at the current count
+
+    Step_Timer->Counting = Counting;
+}
+
+void timer_group_set_alarm_value_in_isr(timer_group_t Group, timer_idx_t Timer, uint64_t Value)
+{
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    if (Step_Timer != NULL)
+    {
+        Step_Timer->Alarm_Value = Value;
+    }
+}
+
+void timer_group_enable_alarm_in_isr(timer_group_t Group, timer_idx_t Timer)
+{
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    if (Step_Timer != NULL)
+    {
+        Step_Timer->Alarm_Enabled = true;
+    }
+}
+
+uint64_t timer_group_get_counter_value_in_isr(timer_group_t Group, timer_idx_t Timer)
+{
+    Sim_Timer_t *Step_Timer = Get_Timer(Group, Timer);
+
+    return (Step_Timer != NULL) ? Timer_Counter(Step_Timer) : 0;
+}
+
+/**
+ * @brief Handle entry of an open NVS handle, NULL if the handle is not open.
+ */
+static Sim_Nvs_Handle_t *Get_Nvs_Handle(nvs_handle_t Handle)
+{
+    if ((Handle == 0) || (Handle > SIM_NVS_HANDLES) || !Nvs_Handles[Handle - 1].Open)
+    {
+        return NULL;
+    }
+
+    return &Nvs_Handles[Handle - 1];
+}
+
+/**
+ * @brief Entry of a key in the namespace of a handle, NULL if not stored.
+ */
+static Sim_Nvs_Entry_t *Find_Nvs_Entry(const Sim_Nvs_Handle_t *Nvs_Handle, const char *Key)
+{
+    for (int Index = 0; Index < SIM_NVS_ENTRIES; Index++)
+    {
+        Sim_Nvs_Entry_t *Entry = &Nvs_Entries[Index];
+
+        if (Entry->Used && (strcmp(Entry->Namespace, Nvs_Handle->Namespace) == 0) && (strcmp(Entry->Key, Key) == 0))
+        {
+            return Entry;
+        }
+    }
+
+    return NULL;
+}
+
+esp_err_t nvs_flash_init(void)
+{
+    Nvs_Initialized = true;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    memset(Nvs_Entries, 0, sizeof(Nvs_Entries));
+    memset(Nvs_Handles, 0, sizeof(Nvs_Handles));
+    Nvs_Initialized = false;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *Name, nvs_open_mode_t Open_Mode, nvs_handle_t *Handle)
+{
+    if (!Nvs_Initialized)
+    {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    if ((Name == NULL) || (strlen(Name) >= NVS_KEY_NAME_MAX_SIZE))
+    {
+        return ESP_ERR_NVS_INVALID_NAME;
+    }
+
+    for (int Index = 0; Index < SIM_NVS_HANDLES; Index++)
+    {
+        if (!Nvs_Handles[Index].Open)
+        {
+            Nvs_Handles[Index].Open = true;
+            Nvs_Handles[Index].Writable = (Open_Mode == NVS_READWRITE);
+            strcpy(Nvs_Handles[Index].Namespace, Name);
+            *Handle = (nvs_handle_t)(Index + 1);
+
+            return ESP_OK;
+        }
+    }
+
+    return ESP_ERR_NO_MEM;
+}
+
+void nvs_close(nvs_handle_t Handle)
+{
+    Sim_Nvs_Handle_t *Nvs_Handle = Get_Nvs_Handle(Handle);
+
+    if (Nvs_Handle != NULL)
+    {
+        Nvs_Handle->Open = false;
+    }
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t Handle, const char *Key, const void *Value, size_t Length)
+{
+    Sim_Nvs_Handle_t *Nvs_Handle = Get_Nvs_Handle(Handle);
+
+    if (Nvs_Handle == NULL)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+
+    if (!Nvs_Handle->Writable)
+    {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+
+    if ((Key == NULL) || (strlen(Key) >= NVS_KEY_NAME_MAX_SIZE))
+    {
+        return ESP_ERR_NVS_INVALID_NAME;
+    }
+
+    if (Length > SIM_NVS_VALUE_SIZE)
+    {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+
+    Sim_Nvs_Entry_t *Entry = Find_Nvs_Entry(Nvs_Handle, Key);
+
+    for (int Index = 0; (Entry == NULL) && (Index < SIM_NVS_ENTRIES); Index++)
+    {
+        if (!Nvs_Entries[Index].Used)
+        {
+            Entry = &Nvs_Entries[Index];
+            Entry->Used = true;
+            strcpy(Entry->Namespace, Nvs_Handle->Namespace);
+            strcpy(Entry->Key, Key);
+        }
+    }
+
+    if (Entry == NULL)
+    {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+
+    memcpy(Entry->Value, Value, Length);
+    Entry->Length = Length;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t Handle, const char *Key, void *Value, size_t *Length)
+{
+    Sim_Nvs_Handle_t *Nvs_Handle = Get_Nvs_Handle(Handle);
+
+    if (Nvs_Handle == NULL)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+
+    Sim_Nvs_Entry_t *Entry = Find_Nvs_Entry(Nvs_Handle, Key);
+
+    if (Entry == NULL)
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    if (Value == NULL) // Only the length is asked for
+    {
+        *Length = Entry->Length;
+        return ESP_OK;
+    }
+
+    if (*Length < Entry->Length)
+    {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    memcpy(Value, Entry->Value, Entry->Length);
+    *Length = Entry->Length;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t Handle, const char *Key)
+{
+    Sim_Nvs_Handle_t *Nvs_Handle = Get_Nvs_Handle(Handle);
+
+    if (Nvs_Handle == NULL)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+
+    Sim_Nvs_Entry_t *Entry = Find_Nvs_Entry(Nvs_Handle, Key);
+
+    if (Entry == NULL)
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    Entry->Used = false;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t Handle)
+{
+    Sim_Nvs_Handle_t *Nvs_Handle = Get_Nvs_Handle(Handle);
+
+    if (Nvs_Handle == NULL)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+
+    for (int Index = 0; Index < SIM_NVS_ENTRIES; Index++)
+    {
+        if (Nvs_Entries[Index].Used && (strcmp(Nvs_Entries[Index].Namespace, Nvs_Handle->Namespace) == 0))
+        {
+            Nvs_Entries[Index].Used = false;
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t Handle)
+{
+    return (Get_Nvs_Handle(Handle) != NULL) ? ESP_OK : ESP_ERR_NVS_INVALID_HANDLE;
+}
@@ -0,0 +1,78 @@
+/*H**********************************************************************
+ * FILENAME :        sim_hal.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Simulated hardware of the stepper motor example for the Linux host.
+ *
+ * NOTES :
+ *       The headers in host/sim/include stand in for the ESP-IDF drivers
+ *       used by main.c, pulse_counter.c and multi_axis.c, so those files
+ *       are compiled unchanged. Everything runs on one thread and on a
+ *       virtual clock: a task only advances the clock while it waits in
+ *       xTaskNotifyWait() or vTaskDelay(), and the LEDC output, the pulse
+ *       counter and the step timer produce their edges and interrupts at
+ *       the exact virtual time they are due. Interrupts run without latency.
+ *       A console writer printing without pause can take the CPU from the
+ *       task for a part of every period, see Sim_Set_Console_Load(); the
+ *       driver calls of the task then take CPU time as well.
+ *
+ *       An axis can be tracked from its step and direction pads, and a
+ *       limit switch on that axis drives an input pad from the axis
+ *       position, see Sim_Set_Limit_Switch(). A vibration sensor on that
+ *       axis toggles an input pad at resonant step rates, see
+ *       Sim_Set_Resonance(). Its rotor drives the phase pads of a quadrature
+ *       encoder, see Sim_Set_Encoder(), and stalls under a load once the
+ *       step rate or the acceleration is too high for the falling torque
+ *       of the motor, see Sim_Set_Motor_Load().
+ *
+ *       Every level change of a GPIO pad is recorded with its time, and the
+ *       timeline can be exported as VCD for a waveform viewer or as CSV for
+ *       scripted checks.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "driver/gpio.h"
+
+#define SIM_PIN_NAME_LENGTH 16 // Longest pin name in the exported timeline
+
+/** One level change of a pad */
+typedef struct
+{
+    uint64_t Time_ns; // Virtual time of the change
+    uint8_t Gpio;     // Pad that changed
+    uint8_t Level;    // New level
+} Sim_Event_t;
+
+void Sim_Reset(void);
+uint64_t Sim_Get_Time_ns(void);
+void Sim_Run_For_us(uint64_t Duration_us);
+void Sim_Schedule_Interrupt(uint64_t Delay_us, void (*Handler)(void *Arg), void *Arg);
+void Sim_Set_Console_Load(uint32_t Period_us, uint32_t Busy_us);
+void Sim_Set_Pin_Name(gpio_num_t Gpio, const char *Name);
+int Sim_Get_Level(gpio_num_t Gpio);
+void Sim_Set_Axis_Pins(gpio_num_t Step_Gpio, gpio_num_t Dir_Gpio);
+int32_t Sim_Get_Axis_Position(void);
+void Sim_Set_Limit_Switch(gpio_num_t Gpio, uint8_t Active_Level, int32_t Trigger_Position, bool Active_Below);
+void Sim_Set_Resonance(gpio_num_t Gpio, uint32_t Low_Hz, uint32_t High_Hz);
+void Sim_Set_Encoder(gpio_num_t A_Gpio, gpio_num_t B_Gpio, int32_t Counts_Per_Step_Q16);
+void Sim_Set_Motor_Load(uint32_t Pull_Out_Hz, uint32_t Max_Acceleration);
+int32_t Sim_Get_Rotor_Position(void);
+
+size_t Sim_Get_Event_Count(void);
+const Sim_Event_t *Sim_Get_Events(void);
+uint32_t Sim_Count_Rising_Edges(gpio_num_t Gpio, uint64_t From_ns, uint64_t To_ns);
+
+bool Sim_Export_VCD(const char *Path);
+bool Sim_Export_CSV(const char *Path);
+
+#endif // SIM_HAL_H
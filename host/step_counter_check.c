@@ -0,0 +1,444 @@
+/*H**********************************************************************
+ * FILENAME :        step_counter_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the window accounting of the pulse counted moves on a
+ *       mocked PCNT unit.
+ *
+ * NOTES :
+ *       The mocked unit counts up to its limit, restarts at 0 and raises its
+ *       event, like the PCNT unit on the step pad. The interrupt and the
+ *       retarget of main/pulse_counter.c run on it as they do on the
+ *       target. Random profiles with segments without steps and longer than
+ *       a 16 bit window, continuous profiles and retargets during a move,
+ *       also right at the end of the running move, must be counted to the
+ *       step, with the steps seen before the interrupt reads the unit and
+ *       those seen while a new limit is armed. Every window must end on the
+ *       next segment boundary, armed late only by the steps seen meanwhile,
+ *       and the move must end on its last planned step.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: step_counter_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "step_counter.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 20000 // Random moves counted
+#define CHECK_MAX_SEGMENTS 12          // Segments of one random profile
+#define CHECK_MAX_SEGMENT_STEPS 200000 // Longest random segment, several 16 bit windows
+#define CHECK_MAX_LATENCY_STEPS 3      // Steps counted before the interrupt reads the unit
+#define CHECK_CONTINUOUS_STEPS 500000  // A continuous move is retargeted by this position
+
+/** Mocked PCNT unit counting the steps of one move */
+typedef struct
+{
+    uint32_t Count;              // Counter value
+    uint32_t Limit;              // High limit, the counter restarts at 0 when it is reached
+    bool Event;                  // Limit reached, the interrupt did not run yet
+    bool Counting;               // Same as in pulse_counter.c
+    uint32_t Shift;              // Steps seen while the running window was programmed, it ends that much later
+    Step_Counter_t Step_Counter; // Accounting under test
+    uint64_t Emitted;            // Steps put out since the start
+} Mock_Unit_t;
+
+/** What the accounting of the running profile must show */
+typedef struct
+{
+    const Motion_Profile_t *Profile;   // Running profile
+    uint64_t Ends[CHECK_MAX_SEGMENTS]; // Absolute step count at the end of every segment
+    uint64_t Target;                   // Absolute step count of the last step, UINT64_MAX for a continuous profile
+    uint32_t Windows;                  // Windows programmed for the profile
+    uint32_t Max_Windows;              // Windows the profile may need at most
+} Reference_t;
+
+/**
+ * @brief Random profile, with segments without steps and longer than a window.
+ */
+static void Random_Profile(Motion_Profile_t *Profile, bool Continuous)
+{
+    memset(Profile, 0, sizeof(*Profile));
+
+    Profile->Segment_Count = (uint16_t)(Host_Check_Random() % CHECK_MAX_SEGMENTS) + 1;
+    Profile->Continuous = Continuous;
+
+    for (uint16_t Index = 0; Index < Profile->Segment_Count; Index++)
+    {
+        uint32_t Kind = (uint32_t)(Host_Check_Random() % 8);
+        uint32_t Steps = 0;
+
+        if (Kind == 0)
+        {
+            Steps = 0;
+        }
+        else if (Kind < 3)
+        {
+            Steps = (uint32_t)(Host_Check_Random() % 10) + 1;
+        }
+        else if (Kind < 6)
+        {
+            Steps = (uint32_t)(Host_Check_Random() % 5000) + 1;
+        }
+        else
+        {
+            Steps = (uint32_t)(Host_Check_Random() % CHECK_MAX_SEGMENT_STEPS) + 1;
+        }
+
+        Profile->Segments[Index].Frequency_Hz = 1000;
+        Profile->Segments[Index].Steps = Steps;
+        Profile->Total_Steps += Steps;
+    }
+}
+
+/**
+ * @brief Reference of a profile started or retargeted at a position.
+ */
+static void Load_Reference(Reference_t *Reference, const Motion_Profile_t *Profile, uint64_t Position)
+{
+    uint64_t End = Position;
+
+    Reference->Profile = Profile;
+    Reference->Windows = 0;
+    Reference->Max_Windows = Profile->Segment_Count + 1;
+
+    for (uint16_t Index = 0; Index < Profile->Segment_Count; Index++)
+    {
+        End += Profile->Segments[Index].Steps;
+        Reference->Ends[Index] = End;
+        Reference->Max_Windows += (Profile->Segments[Index].Steps / STEP_COUNTER_MAX_WINDOW) + 1;
+    }
+
+    Reference->Max_Windows += Profile->Continuous ? ((CHECK_CONTINUOUS_STEPS / STEP_COUNTER_MAX_WINDOW) + 1) : 0; // Held segment until the retarget
+    Reference->Target = Profile->Continuous ? UINT64_MAX : (Position + Profile->Total_Steps);
+}
+
+/**
+ * @brief Check the segment and the window programmed at a counted position.
+ */
+static void Check_Window(const Mock_Unit_t *Unit, Reference_t *Reference, const char *Detail)
+{
+    const Step_Counter_t *Counter = &Unit->Step_Counter;
+    uint64_t Position = Unit->Emitted - Unit->Shift; // The window was computed before the steps seen meanwhile
+    uint16_t Index = 0;
+
+    while ((Index < (Reference->Profile->Segment_Count - 1)) && (Reference->Ends[Index] <= Position))
+    {
+        Index++;
+    }
+
+    uint64_t Segment_End = Reference->Ends[Index];
+
+    if (Reference->Profile->Continuous && (Segment_End <= Position))
+    {
+        Segment_End = STEP_COUNTER_ENDLESS; // Held segment
+    }
+
+    uint64_t Remaining = Segment_End - Position;
+    uint64_t Window = (Remaining > STEP_COUNTER_MAX_WINDOW) ? STEP_COUNTER_MAX_WINDOW : Remaining;
+
+    if ((Counter->Counted_Steps != Unit->Emitted) || (Counter->Segment_Index != Index) || (Counter->Segment_End != Segment_End))
+    {
+        Host_Check_Fail("counter_segment", Detail);
+    }
+
+    if ((Counter->Window_Steps != Window) || (Counter->Window_Steps == 0) || (Unit->Limit != Window))
+    {
+        Host_Check_Fail("counter_window", Detail);
+    }
+
+    if (++Reference->Windows > Reference->Max_Windows)
+    {
+        Host_Check_Fail("counter_windows", Detail);
+    }
+}
+
+/**
+ * @brief Put out steps up to the limit, the unit counts them.
+ */
+static void Mock_Emit(Mock_Unit_t *Unit, uint32_t Steps)
+{
+    uint32_t Left = Unit->Limit - Unit->Count;
+
+    Steps = (Steps < Left) ? Steps : Left;
+
+    Unit->Count += Steps;
+    Unit->Emitted += Steps;
+
+    if (Unit->Count == Unit->Limit)
+    {
+        Unit->Count = 0; // The unit restarts at its limit
+        Unit->Event = true;
+    }
+}
+
+/**
+ * @brief Steps seen while a new limit is programmed, before the clear that loads it.
+ */
+static void Mock_Arm(Mock_Unit_t *Unit, uint32_t Limit, uint32_t Meanwhile)
+{
+    Meanwhile = (Meanwhile < Limit) ? Meanwhile : (Limit - 1); // Fewer than the window, as a few CPU cycles are
+
+    Unit->Limit = Limit;
+    Unit->Count += Meanwhile;
+    Unit->Emitted += Meanwhile;
+    Unit->Shift = Meanwhile;
+}
+
+/**
+ * @brief Interrupt of the limit event, as Pulse_Counter_ISR().
+ *
+ * @param Unit Mocked unit, Count holds the steps seen since the limit was reached.
+ * @param Meanwhile Steps seen while the next limit is programmed.
+ * @return Result of Step_Counter_Window_End().
+ */
+static Step_Counter_Event_t Mock_Interrupt(Mock_Unit_t *Unit, uint32_t Meanwhile)
+{
+    uint32_t Early_Steps = Unit->Count; // Read and clear
+
+    Unit->Count = 0;
+    Unit->Event = false;
+
+    Step_Counter_Event_t Event = Step_Counter_Window_End(&Unit->Step_Counter, Early_Steps);
+
+    if (Event == STEP_COUNTER_MOVE_DONE)
+    {
+        Unit->Counting = false; // Output stopped
+    }
+    else
+    {
+        Mock_Arm(Unit, Unit->Step_Counter.Window_Steps, Meanwhile);
+
+        Unit->Step_Counter.Counted_Steps += Unit->Count; // Read and clear, keep any step seen meanwhile
+        Unit->Count = 0;
+    }
+
+    return Event;
+}
+
+/**
+ * @brief Retarget, as Pulse_Counter_Retarget().
+ *
+ * @param Unit Mocked unit.
+ * @param Profile Profile that continues the move.
+ * @param Meanwhile Steps seen while the new limit is programmed.
+ * @return 0 if taken, 1 if the running move ends first, 2 if the window is about to end.
+ */
+static int Mock_Retarget(Mock_Unit_t *Unit, const Motion_Profile_t *Profile, uint32_t Meanwhile)
+{
+    uint32_t Window_Count = Unit->Count;
+    uint32_t Window = 0;
+
+    if ((Window_Count + STEP_COUNTER_RETARGET_MARGIN) >= Unit->Step_Counter.Window_Steps)
+    {
+        return 2;
+    }
+
+    if (!Step_Counter_Retarget(&Unit->Step_Counter, Profile, Window_Count, &Window))
+    {
+        return 1;
+    }
+
+    if (Window > 0)
+    {
+        Mock_Arm(Unit, Window, Meanwhile);
+    }
+    else
+    {
+        Unit->Counting = false; // Output stopped right here
+        Unit->Shift = 0;
+    }
+
+    Unit->Step_Counter.Counted_Steps += Unit->Count - Window_Count; // Read and clear, keep any step seen meanwhile
+    Unit->Count = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Random steps seen by the unit before the interrupt runs, short of the last step.
+ */
+static uint32_t Random_Latency(const Mock_Unit_t *Unit, uint64_t Target)
+{
+    uint64_t Left = Target - Unit->Emitted;
+    uint32_t Latency = (uint32_t)(Host_Check_Random() % (CHECK_MAX_LATENCY_STEPS + 1));
+
+    return (Latency < Left) ? Latency : (uint32_t)(Left - 1);
+}
+
+static void Check_Step_Counter(uint32_t Iterations)
+{
+    static Motion_Profile_t Profiles[2]; // Started profile and its replacement
+    Reference_t Reference;
+    Mock_Unit_t Unit;
+    uint32_t Retargets = 0;
+    uint32_t Shifted = 0;
+    uint64_t Windows = 0;
+    char Detail[160];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        bool Continuous = (Host_Check_Random() % 4) == 0;
+        bool Retarget = Continuous || ((Host_Check_Random() % 2) == 0); // A continuous move only ends by a retarget
+        uint64_t Retarget_At = 0;
+
+        Random_Profile(&Profiles[0], Continuous);
+        Random_Profile(&Profiles[1], false);
+
+        Retarget_At = Host_Check_Random() % (Continuous ? CHECK_CONTINUOUS_STEPS : ((uint64_t)Profiles[0].Total_Steps + 1));
+
+        memset(&Unit, 0, sizeof(Unit));
+
+        uint32_t Window = Step_Counter_Begin(&Unit.Step_Counter, &Profiles[0]); // As Pulse_Counter_Start()
+
+        Unit.Limit = Window;
+        Unit.Counting = (Window > 0);
+
+        Load_Reference(&Reference, &Profiles[0], 0);
+
+        snprintf(Detail, sizeof(Detail), "move %" PRIu32 ", %" PRIu32 " steps in %u segments%s", Iteration, Profiles[0].Total_Steps, Profiles[0].Segment_Count,
+                 Continuous ? ", continuous" : "");
+
+        if (Unit.Counting != (Continuous || (Profiles[0].Total_Steps > 0)))
+        {
+            Host_Check_Fail("counter_begin", Detail);
+        }
+
+        if (Unit.Counting)
+        {
+            Check_Window(&Unit, &Reference, Detail);
+        }
+
+        while (Unit.Counting)
+        {
+            if (Retarget && (Unit.Emitted >= Retarget_At))
+            {
+                uint64_t Position = Unit.Emitted;
+
+                if (!Continuous && ((Host_Check_Random() % 4) == 0))
+                {
+                    Profiles[1].Segment_Count = 1; // Ends one step before, with or after the running move
+                    Profiles[1].Segments[0].Steps = (uint32_t)(Reference.Target - Position - 1 + (Host_Check_Random() % 3));
+                    Profiles[1].Total_Steps = Profiles[1].Segments[0].Steps;
+                }
+
+                int Result = Mock_Retarget(&Unit, &Profiles[1], (uint32_t)(Host_Check_Random() % (CHECK_MAX_LATENCY_STEPS + 1)));
+
+                if (Result == 2)
+                {
+                    Retarget_At = Unit.Emitted + STEP_COUNTER_RETARGET_MARGIN + 1; // Try again in the next window
+                    continue;
+                }
+
+                if ((Result == 0) != ((Reference.Target - Position) > Profiles[1].Total_Steps))
+                {
+                    Host_Check_Fail("counter_retarget", Detail);
+                }
+
+                if (Result == 0)
+                {
+                    Load_Reference(&Reference, &Profiles[1], Position);
+
+                    Retargets++;
+
+                    if (Unit.Counting)
+                    {
+                        Check_Window(&Unit, &Reference, Detail);
+                    }
+                    else if (Unit.Emitted != Reference.Target)
+                    {
+                        Host_Check_Fail("counter_stop", Detail);
+                    }
+                }
+
+                Retarget = false;
+                continue;
+            }
+
+            uint32_t Left = Unit.Limit - Unit.Count;
+            uint32_t Burst = (Host_Check_Random() & 1) ? Left : ((uint32_t)(Host_Check_Random() % Left) + 1);
+
+            if (Retarget && ((Unit.Emitted + Burst) > Retarget_At))
+            {
+                Burst = (uint32_t)(Retarget_At - Unit.Emitted);
+            }
+
+            Mock_Emit(&Unit, Burst);
+
+            if (!Unit.Event)
+            {
+                if (Step_Counter_Executed(&Unit.Step_Counter, Unit.Count) != Unit.Emitted)
+                {
+                    Host_Check_Fail("counter_executed", Detail);
+                }
+
+                continue;
+            }
+
+            uint64_t Limit_Reached = Unit.Emitted;
+            uint32_t Shift = Unit.Shift; // Steps the window that ended was armed late
+
+            Windows++;
+            Shifted += (Shift > 0) ? 1 : 0;
+
+            if (Limit_Reached < Reference.Target)
+            {
+                uint32_t Early_Steps = Random_Latency(&Unit, Reference.Target);
+
+                Unit.Count += Early_Steps; // Steps seen before the interrupt reads the unit
+                Unit.Emitted += Early_Steps;
+            }
+
+            uint32_t Meanwhile = ((Unit.Emitted < Reference.Target) && ((Host_Check_Random() % 4) == 0)) ? Random_Latency(&Unit, Reference.Target) : 0; // Rare, a few CPU cycles
+            Step_Counter_Event_t Event = Mock_Interrupt(&Unit, Meanwhile);
+
+            if ((Event == STEP_COUNTER_MOVE_DONE) != (Limit_Reached >= Reference.Target))
+            {
+                Host_Check_Fail("counter_done", Detail);
+                break;
+            }
+
+            if (Event == STEP_COUNTER_MOVE_DONE)
+            {
+                if (((Limit_Reached - Reference.Target) > Shift) || (Unit.Step_Counter.Counted_Steps != Unit.Emitted))
+                {
+                    Host_Check_Fail("counter_last_step", Detail); // Stops on the last step, later only by the steps seen while arming
+                }
+            }
+            else
+            {
+                Check_Window(&Unit, &Reference, Detail);
+            }
+        }
+
+        if (Step_Counter_Executed(&Unit.Step_Counter, 0) != Unit.Emitted)
+        {
+            Host_Check_Fail("counter_total", Detail);
+        }
+    }
+
+    printf("step_counter : %" PRIu32 " moves, %" PRIu32 " retargets, %" PRIu64 " windows, %" PRIu32 " shifted\n", Iterations, Retargets, Windows, Shifted);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Step_Counter(Iterations);
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,71 @@
+/*H**********************************************************************
+ * FILENAME :        stepper_bench.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Runs the benchmark suite of main/motion_benchmark.c on the
+ *       simulated hardware of host/sim.
+ *
+ * NOTES :
+ *       Prints the same JSON records as the motion_bench console command
+ *       on the ESP32, with target "host-sim". The times are virtual and
+ *       interrupts run without latency, so the idle latency records show
+ *       the delay added by the motor control itself, and the records of two
+ *       builds can be compared to catch regressions. Under console load a
+ *       simulated console writer takes a part of the CPU of the task, see
+ *       Sim_Set_Console_Load(), and the latency must stay below its limit.
+ *       Built as stepper_bench_timer it runs on the timer pulse engine
+ *       instead of LEDC.
+ *
+ *       Usage: stepper_bench [--vcd file]
+ *       Exits with 1 if a check of the suite failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <string.h>
+#include "main.h"
+#include "motion_benchmark.h"
+#include "sim_hal.h"
+
+int main(int argc, char **argv)
+{
+    const char *Vcd_Path = NULL;
+
+    if ((argc == 3) && (strcmp(argv[1], "--vcd") == 0))
+    {
+        Vcd_Path = argv[2];
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "Usage: %s [--vcd file]\n", argv[0]);
+        return 2;
+    }
+
+    Sim_Reset();
+
+    Sim_Set_Pin_Name(STEPPER_MOTOR_EN_PIN, "EN");
+    Sim_Set_Pin_Name(STEPPER_MOTOR_DIR_PIN, "X_DIR");
+    Sim_Set_Pin_Name(STEPPER_MOTOR_PUL_PIN, "X_PUL");
+
+    ESP_ERROR_CHECK(Initialize_Stepper_Motor());
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    ESP_ERROR_CHECK(Initialize_Timer_Pulse_Engine());
+#endif
+    ESP_ERROR_CHECK(Stop_Stepper_Motor());
+    ESP_ERROR_CHECK(nvs_flash_init()); // The ramps the suite holds become hot and are persisted
+    ESP_ERROR_CHECK(Initialize_Ramp_Cache());
+
+    esp_err_t Function_Error = Motion_Benchmark_Run(true);
+
+    if ((Vcd_Path != NULL) && !Sim_Export_VCD(Vcd_Path))
+    {
+        fprintf(stderr, "Cannot write %s\n", Vcd_Path);
+        return 2;
+    }
+
+    return (Function_Error == ESP_OK) ? 0 : 1;
+}
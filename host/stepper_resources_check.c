@@ -0,0 +1,276 @@
+/*H**********************************************************************
+ * FILENAME :        stepper_resources_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the LEDC and PCNT resource allocator of the motors.
+ *
+ * NOTES :
+ *       The stepper resources must give every LEDC channel and timer and
+ *       every PCNT unit to at most one motor, serve requests until the timers
+ *       run out and refuse resources that are in use or invalid.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: stepper_resources_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "stepper_resources.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 200000 // Random allocations and releases
+
+/**
+ * @brief Check that an allocation is valid, fits the request and takes nothing in use.
+ */
+static void Check_Allocation(const Stepper_Resources_t *Before, const Stepper_Resources_t *After, const Stepper_Resource_t *Request, const Stepper_Resource_t *Allocation,
+                             const char *Detail)
+{
+    uint8_t Mode = Allocation->Speed_Mode;
+
+    if ((Mode >= STEPPER_RESOURCES_SPEED_MODES) || (Allocation->Timer >= STEPPER_RESOURCES_TIMERS) || (Allocation->Channel >= STEPPER_RESOURCES_CHANNELS) ||
+        (Allocation->Pcnt_Unit >= STEPPER_RESOURCES_PCNT_UNITS))
+    {
+        Host_Check_Fail("resource_range", Detail);
+        return;
+    }
+
+    if (((Request->Speed_Mode != STEPPER_RESOURCE_ANY) && (Request->Speed_Mode != Mode)) || ((Request->Timer != STEPPER_RESOURCE_ANY) && (Request->Timer != Allocation->Timer)) ||
+        ((Request->Channel != STEPPER_RESOURCE_ANY) && (Request->Channel != Allocation->Channel)) ||
+        ((Request->Pcnt_Unit != STEPPER_RESOURCE_ANY) && (Request->Pcnt_Unit != Allocation->Pcnt_Unit)))
+    {
+        Host_Check_Fail("resource_request", Detail);
+    }
+
+    if (((Before->Timers[Mode] >> Allocation->Timer) & 1) || ((Before->Channels[Mode] >> Allocation->Channel) & 1) || ((Before->Pcnt_Units >> Allocation->Pcnt_Unit) & 1))
+    {
+        Host_Check_Fail("resource_shared", Detail);
+    }
+
+    Stepper_Resources_t Expected = *Before;
+
+    Expected.Timers[Mode] |= (uint8_t)(1U << Allocation->Timer);
+    Expected.Channels[Mode] |= (uint8_t)(1U << Allocation->Channel);
+    Expected.Pcnt_Units |= (uint8_t)(1U << Allocation->Pcnt_Unit);
+
+    if (memcmp(&Expected, After, sizeof(Expected)) != 0)
+    {
+        Host_Check_Fail("resource_mask", Detail);
+    }
+}
+
+static void Check_Stepper_Resources(uint32_t Iterations)
+{
+    static const Stepper_Resource_t Any = {STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY};
+    Stepper_Resources_t Resources;
+    Stepper_Resources_t Before;
+    Stepper_Resource_t Allocations[STEPPER_RESOURCES_MAX_MOTORS];
+    Stepper_Resource_t Allocation;
+    Stepper_Resource_t Request;
+    uint32_t Allocated = 0;
+    char Detail[96];
+
+    for (uint8_t Reserved = 0; Reserved < 2; Reserved++) // Fresh, then with the timer, channel and units of the motor of main.c and the encoder
+    {
+        uint8_t Motors = 0;
+
+        Stepper_Resources_Init(&Resources);
+
+        if (Reserved != 0)
+        {
+            Request = (Stepper_Resource_t){1, 0, 0, 0}; // Low speed timer 0, channel 0, PCNT unit 0
+
+            if (!Stepper_Resources_Allocate(&Resources, &Request, &Allocation) || !Stepper_Resources_Reserve_Unit(&Resources, 1) ||
+                Stepper_Resources_Reserve_Unit(&Resources, 1) || Stepper_Resources_Reserve_Unit(&Resources, STEPPER_RESOURCES_PCNT_UNITS))
+            {
+                Host_Check_Fail("resource_reserve", "reservation of the primary motor");
+            }
+        }
+
+        uint8_t Free_Motors = Stepper_Resources_Free_Motors(&Resources);
+
+        while (true)
+        {
+            snprintf(Detail, sizeof(Detail), "reserved %u, motor %u", Reserved, Motors);
+
+            Before = Resources;
+
+            if (!Stepper_Resources_Allocate(&Resources, &Any, &Allocation))
+            {
+                if (memcmp(&Before, &Resources, sizeof(Before)) != 0)
+                {
+                    Host_Check_Fail("resource_refused", Detail);
+                }
+
+                break;
+            }
+
+            Check_Allocation(&Before, &Resources, &Any, &Allocation, Detail);
+            Allocations[Motors++] = Allocation;
+
+            if (Motors > STEPPER_RESOURCES_MAX_MOTORS)
+            {
+                Host_Check_Fail("resource_count", Detail);
+                break;
+            }
+        }
+
+        uint8_t Expected_Motors = (Reserved != 0) ? (STEPPER_RESOURCES_PCNT_UNITS - 2) : STEPPER_RESOURCES_MAX_MOTORS; // Units run out before the timers with the reservations
+
+        if ((Motors != Expected_Motors) || (Free_Motors != Expected_Motors) || (Stepper_Resources_Free_Motors(&Resources) != 0))
+        {
+            snprintf(Detail, sizeof(Detail), "reserved %u, %u motors, %u free", Reserved, Motors, Free_Motors);
+            Host_Check_Fail("resource_exhausted", Detail);
+        }
+
+        for (uint8_t Motor = 0; Motor < Motors; Motor++)
+        {
+            Stepper_Resources_Release(&Resources, &Allocations[Motor]);
+        }
+
+        if (Stepper_Resources_Free_Motors(&Resources) != Free_Motors)
+        {
+            Host_Check_Fail("resource_release", "released motors not free again");
+        }
+    }
+
+    for (uint8_t Mode = 0; Mode < STEPPER_RESOURCES_SPEED_MODES; Mode++) // Every channel and timer on its own, and twice
+    {
+        for (uint8_t Channel = 0; Channel < STEPPER_RESOURCES_CHANNELS; Channel++)
+        {
+            uint8_t Timer = Channel % STEPPER_RESOURCES_TIMERS;
+
+            snprintf(Detail, sizeof(Detail), "mode %u, timer %u, channel %u", Mode, Timer, Channel);
+
+            Stepper_Resources_Init(&Resources);
+            Request = (Stepper_Resource_t){Mode, Timer, Channel, STEPPER_RESOURCE_ANY};
+            Before = Resources;
+
+            if (!Stepper_Resources_Allocate(&Resources, &Request, &Allocation))
+            {
+                Host_Check_Fail("resource_explicit", Detail);
+                continue;
+            }
+
+            Check_Allocation(&Before, &Resources, &Request, &Allocation, Detail);
+
+            Before = Resources;
+
+            if (Stepper_Resources_Allocate(&Resources, &Request, &Allocation) || (memcmp(&Before, &Resources, sizeof(Before)) != 0))
+            {
+                Host_Check_Fail("resource_conflict", Detail);
+            }
+
+            Request.Channel = STEPPER_RESOURCE_ANY; // Timer still in use
+
+            if (Stepper_Resources_Allocate(&Resources, &Request, &Allocation))
+            {
+                Host_Check_Fail("resource_timer_shared", Detail);
+            }
+        }
+    }
+
+    static const Stepper_Resource_t Invalid[] = {
+        {STEPPER_RESOURCES_SPEED_MODES, STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY},
+        {STEPPER_RESOURCE_ANY, STEPPER_RESOURCES_TIMERS, STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY},
+        {STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY, STEPPER_RESOURCES_CHANNELS, STEPPER_RESOURCE_ANY},
+        {STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY, STEPPER_RESOURCES_PCNT_UNITS},
+    };
+
+    Stepper_Resources_Init(&Resources);
+
+    for (size_t Case = 0; Case < (sizeof(Invalid) / sizeof(Invalid[0])); Case++)
+    {
+        if (Stepper_Resources_Allocate(&Resources, &Invalid[Case], &Allocation) || (Stepper_Resources_Free_Motors(&Resources) != STEPPER_RESOURCES_MAX_MOTORS))
+        {
+            snprintf(Detail, sizeof(Detail), "invalid request %zu", Case);
+            Host_Check_Fail("resource_invalid", Detail);
+        }
+    }
+
+    uint8_t Motors = 0;
+
+    Stepper_Resources_Init(&Resources);
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++) // Random requests and releases against the masks
+    {
+        snprintf(Detail, sizeof(Detail), "iteration %" PRIu32 ", %u motors", Iteration, Motors);
+
+        if ((Motors > 0) && ((Host_Check_Random() % 2) == 0))
+        {
+            uint8_t Motor = (uint8_t)(Host_Check_Random() % Motors);
+
+            Stepper_Resources_Release(&Resources, &Allocations[Motor]);
+            Allocations[Motor] = Allocations[--Motors];
+            continue;
+        }
+
+        static const uint8_t Counts[4] = {STEPPER_RESOURCES_SPEED_MODES, STEPPER_RESOURCES_TIMERS, STEPPER_RESOURCES_CHANNELS, STEPPER_RESOURCES_PCNT_UNITS};
+        uint8_t Fields[4];
+
+        for (uint8_t Field = 0; Field < 4; Field++)
+        {
+            Fields[Field] = ((Host_Check_Random() % 3) == 0) ? (uint8_t)(Host_Check_Random() % Counts[Field]) : STEPPER_RESOURCE_ANY;
+        }
+
+        Request = (Stepper_Resource_t){Fields[0], Fields[1], Fields[2], Fields[3]};
+        Before = Resources;
+
+        bool Possible = false; // Whether a speed mode has the wanted timer, channel and unit free
+
+        for (uint8_t Mode = 0; Mode < STEPPER_RESOURCES_SPEED_MODES; Mode++)
+        {
+            bool Mode_Ok = (Request.Speed_Mode == STEPPER_RESOURCE_ANY) || (Request.Speed_Mode == Mode);
+            bool Timer_Ok = (Request.Timer == STEPPER_RESOURCE_ANY) ? (Resources.Timers[Mode] != 0x0F) : (((Resources.Timers[Mode] >> Request.Timer) & 1) == 0);
+            bool Channel_Ok = (Request.Channel == STEPPER_RESOURCE_ANY) ? (Resources.Channels[Mode] != 0xFF) : (((Resources.Channels[Mode] >> Request.Channel) & 1) == 0);
+            bool Unit_Ok = (Request.Pcnt_Unit == STEPPER_RESOURCE_ANY) ? (Resources.Pcnt_Units != 0xFF) : (((Resources.Pcnt_Units >> Request.Pcnt_Unit) & 1) == 0);
+
+            Possible = Possible || (Mode_Ok && Timer_Ok && Channel_Ok && Unit_Ok);
+        }
+
+        if (Stepper_Resources_Allocate(&Resources, &Request, &Allocation) != Possible)
+        {
+            Host_Check_Fail("resource_random", Detail);
+            Resources = Before;
+            continue;
+        }
+
+        if (!Possible)
+        {
+            if (memcmp(&Before, &Resources, sizeof(Before)) != 0)
+            {
+                Host_Check_Fail("resource_refused", Detail);
+            }
+
+            continue;
+        }
+
+        Check_Allocation(&Before, &Resources, &Request, &Allocation, Detail);
+        Allocations[Motors++] = Allocation;
+        Allocated++;
+    }
+
+    printf("resources    : %" PRIu32 " requests, %" PRIu32 " allocated\n", Iterations, Allocated);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Stepper_Resources(Iterations);
+
+    return Host_Check_Result();
+}
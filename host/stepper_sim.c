@@ -0,0 +1,767 @@
+/*H**********************************************************************
+ * FILENAME :        stepper_sim.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Runs motion commands of the stepper motor example on the simulated
+ *       hardware of host/sim and reports their timing.
+ *
+ * NOTES :
+ *       main.c, pulse_counter.c and multi_axis.c are the same files that run
+ *       on the ESP32. The commands are executed one after the other on the
+ *       virtual clock. For every command the steps seen on the pulse pins,
+ *       the time to the first step and the peak step rate are printed, and
+ *       the whole timeline can be written as VCD or CSV. NVS lives in RAM
+ *       for the whole run, so "cache 1" shows what a warm boot would load.
+ *       Axis X is tracked from its pins and carries a home switch, the
+ *       position the firmware counts is printed next to it. A vibration
+ *       sensor on axis X drives the resonance sense pin, see "resonate".
+ *       The motion script given with --script is read from the host file
+ *       system and run by "script", compiled once like on the target. The
+ *       trajectory given with --trajectory stands in for the trajectory
+ *       partition, "trajectory" plays it, with the timer pulse engine of
+ *       stepper_sim_timer only. The rotor of axis X drives the encoder
+ *       pins and stalls under the load set by "load", so the moves are
+ *       monitored and "autotune" finds the limits of that load.
+ *
+ *       Usage: stepper_sim [--vcd file] [--csv file] [--script file] [--trajectory file] command...
+ *         move <frq> <steps> <dir>       Move_Stepper_Motor()
+ *         rotate <frq> <steps> <dir>     Rotate_Stepper_Motor()
+ *         run <frq> <dir> <ms>           Start_Stepper_Motor(), run, Decelerate_Stepper_Motor()
+ *         linear <frq> <x> <y>           Move_Stepper_Axes_Linear()
+ *         arc <frq> <x> <y> <i> <j> <cw> Move_Stepper_Axes_Arc()
+ *         wait <ms>                      Let the virtual clock run
+ *         cache <reload>                 Ramp cache counters, 1 reloads it from NVS like a reboot
+ *         trace <dump>                   Trace latency histograms, 1 prints the events instead
+ *         jog <velocity> <ms>            Ramp toward a signed velocity for a time, like the jog mode
+ *         estop <ms> <decel>             Quick-stop from an interrupt that many ms into the next
+ *                                        command, at decel steps/s^2, 0 keeps the configured one
+ *         stop <ms> <decel>              Same from the motion task side, a controlled stop
+ *                                        request at decel, 0 for the default acceleration
+ *         moveto <frq> <pos>             Move_Stepper_Motor_To()
+ *         home <switch> <fast> <slow>    Home_Stepper_Motor() toward a switch pressed at and
+ *                                        below axis position switch, 0 takes the default speed
+ *         band <low> <high>              Add a resonance band to the table, 0 0 clears it
+ *         resonate <low> <high>          Let the axis resonate between the step rates, 0 0 stops it
+ *         sweep <from> <to> <step>       Motor_Resonance_Sweep() with the default dwell and threshold
+ *         script <repeat>                Motor_Script_Run() of the --script file, repeated back to back
+ *         trajectory <plays>             Trajectory_Player_Run() of the --trajectory file, played back to back
+ *         load <pull_out> <accel>        Load the motor, it stalls above pull_out steps/s or above accel
+ *                                        steps/s^2 falling to 0 at pull_out, 0 0 removes the load
+ *         autotune <travel> <save>       Motor_Encoder_Autotune() with the default search, 1 saves the limits
+ *
+ *       Checks on the command before, a failed check makes the exit code 1:
+ *         ends <frq>                     Its last step on axis X ran below frq steps/s
+ *         steps <count> <pos>            It emitted count steps on axis X, which ended at pos
+ *         counted <pos>                  The firmware counts axis X at pos
+ *         ramp <frq>                     Its step rate on axis X rose monotonically to a peak of frq steps/s and
+ *                                        fell monotonically from there, both within 1 %
+ *         result <err>                   It returned the esp_err_t err, which is not counted as a failure
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "main.h"
+#include "homing.h"
+#include "motor_script.h"
+#include "trajectory_player.h"
+#include "sim_hal.h"
+
+#define SIM_SHAPE_TOLERANCE 100 // Checked ramps may deviate by a 100th of the period before, the peak rate by a 100th
+
+/** One command of the command line */
+typedef struct
+{
+    const char *Name; // Command word
+    int Arguments;    // Number of numeric arguments
+} Sim_Command_t;
+
+/** Step timing of axis X during one command */
+typedef struct
+{
+    uint32_t Pulses;       // Rising edges of the pulse pin
+    uint64_t Shortest_ns;  // Shortest step period, the peak rate
+    uint64_t Last_ns;      // Period of the last step, 0 with a single step
+    uint32_t Shape_Errors; // Periods growing on the way up to the peak rate or shrinking after it
+} Step_Scan_t;
+
+static const Sim_Command_t Commands[] = {
+    {"move", 3},
+    {"rotate", 3},
+    {"run", 3},
+    {"linear", 3},
+    {"arc", 6},
+    {"wait", 1},
+    {"cache", 1},
+    {"trace", 1},
+    {"jog", 2},
+    {"estop", 2},
+    {"stop", 2},
+    {"moveto", 2},
+    {"home", 3},
+    {"band", 2},
+    {"resonate", 2},
+    {"sweep", 3},
+    {"script", 1},
+    {"trajectory", 1},
+    {"load", 2},
+    {"autotune", 2},
+    {"ends", 1},
+    {"steps", 2},
+    {"counted", 1},
+    {"ramp", 1},
+    {"result", 1},
+};
+
+static uint32_t Stop_Deceleration = 0;    // Deceleration of the request made by the "stop" command
+static const char *Script_Path = NULL;    // Motion script of the "script" command
+static uint32_t *Trajectory_Image = NULL; // Contents of the --trajectory file, word aligned like the mapped partition
+static size_t Trajectory_Size = 0;        // Bytes of the --trajectory file
+static size_t Checked_Event = 0;          // First timeline entry of the command the checks look at
+static esp_err_t Checked_Error = ESP_OK;  // Result of the command the checks look at
+
+/**
+ * @brief E-stop input interrupt.
+ */
+static void Estop_ISR(void *Arg)
+{
+    Quick_Stop_Stepper_Motor();
+}
+
+/**
+ * @brief Controlled stop request, raised on the virtual clock like from another task.
+ */
+static void Stop_Request(void *Arg)
+{
+    Request_Stepper_Motor_Stop(Stop_Deceleration);
+}
+
+/**
+ * @brief Read a trajectory file into a word aligned buffer.
+ *
+ * @return The buffer, NULL if the file is not readable.
+ */
+static uint32_t *Read_Trajectory(const char *Path, size_t *Size)
+{
+    FILE *File = fopen(Path, "rb");
+    uint32_t *Image = NULL;
+    long Length = -1;
+
+    if ((File != NULL) && (fseek(File, 0, SEEK_END) == 0))
+    {
+        Length = ftell(File);
+        rewind(File);
+    }
+
+    if (Length >= 0)
+    {
+        Image = calloc(1, (size_t)Length + sizeof(uint32_t));
+    }
+
+    if ((Image != NULL) && (fread(Image, 1, (size_t)Length, File) == (size_t)Length))
+    {
+        *Size = (size_t)Length;
+    }
+    else
+    {
+        fprintf(stderr, "%s: cannot read\n", Path);
+        free(Image);
+        Image = NULL;
+    }
+
+    if (File != NULL)
+    {
+        fclose(File);
+    }
+
+    return Image;
+}
+
+/**
+ * @brief Bring up the simulated hardware like app_main() does.
+ */
+static void Initialize_Simulation(void)
+{
+    Sim_Reset();
+
+    Sim_Set_Pin_Name(STEPPER_MOTOR_EN_PIN, "EN");
+    Sim_Set_Pin_Name(STEPPER_MOTOR_DIR_PIN, "X_DIR");
+    Sim_Set_Pin_Name(STEPPER_MOTOR_PUL_PIN, "X_PUL");
+    Sim_Set_Pin_Name(AXIS_Y_DIR_PIN, "Y_DIR");
+    Sim_Set_Pin_Name(AXIS_Y_PUL_PIN, "Y_PUL");
+    Sim_Set_Pin_Name(HOMING_SWITCH_PIN, "X_HOME");
+    Sim_Set_Pin_Name(RESONANCE_SENSE_PIN, "X_SENSE");
+    Sim_Set_Pin_Name(MOTOR_ENCODER_A_PIN, "X_ENC_A");
+    Sim_Set_Pin_Name(MOTOR_ENCODER_B_PIN, "X_ENC_B");
+
+    ESP_ERROR_CHECK(Initialize_Stepper_Motor());
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    ESP_ERROR_CHECK(Initialize_Timer_Pulse_Engine());
+#endif
+    ESP_ERROR_CHECK(Stop_Stepper_Motor());
+    ESP_ERROR_CHECK(Initialize_Multi_Axis());
+    ESP_ERROR_CHECK(Initialize_Homing());
+    ESP_ERROR_CHECK(nvs_flash_init());
+    ESP_ERROR_CHECK(Initialize_Ramp_Cache());
+    ESP_ERROR_CHECK(Initialize_Motor_Resonance());
+    ESP_ERROR_CHECK(Initialize_Motor_Encoder());
+
+    Motor_Encoder_Status_t Encoder_Status;
+
+    Motor_Encoder_Get_Status(&Encoder_Status);
+
+    Sim_Set_Axis_Pins(STEPPER_MOTOR_PUL_PIN, STEPPER_MOTOR_DIR_PIN);
+    Sim_Set_Limit_Switch(HOMING_SWITCH_PIN, HOMING_SWITCH_ACTIVE_LEVEL, INT32_MIN, true); // Out of reach until "home" places it
+    Sim_Set_Encoder(MOTOR_ENCODER_A_PIN, MOTOR_ENCODER_B_PIN, Encoder_Status.Config.Counts_Per_Step_Q16);
+}
+
+/**
+ * @brief Print the steps and timing of one axis from a timeline entry on.
+ */
+static void Report_Axis(const char *Axis, gpio_num_t Pul_Pin, uint64_t Start_ns, size_t First_Event)
+{
+    const Sim_Event_t *Events = Sim_Get_Events();
+    uint32_t Pulses = 0;
+    uint64_t First_ns = 0;
+    uint64_t Last_ns = 0;
+    uint64_t Shortest_ns = 0;
+
+    for (size_t Index = First_Event; Index < Sim_Get_Event_Count(); Index++)
+    {
+        const Sim_Event_t *Event = &Events[Index];
+
+        if ((Event->Gpio != Pul_Pin) || !Event->Level)
+        {
+            continue;
+        }
+
+        if (Pulses == 0)
+        {
+            First_ns = Event->Time_ns;
+        }
+        else if ((Shortest_ns == 0) || ((Event->Time_ns - Last_ns) < Shortest_ns))
+        {
+            Shortest_ns = Event->Time_ns - Last_ns;
+        }
+
+        Last_ns = Event->Time_ns;
+        Pulses++;
+    }
+
+    if (Pulses == 0)
+    {
+        return;
+    }
+
+    printf("  %s PULSES    : %u\n", Axis, Pulses);
+    printf("  %s LATENCY   : %.1f us to the first step\n", Axis, (First_ns - Start_ns) / 1e3);
+    printf("  %s STEP TIME : %.3f ms first to last step\n", Axis, (Last_ns - First_ns) / 1e6);
+    printf("  %s PEAK RATE : %.0f steps/s\n", Axis, (Shortest_ns > 0) ? (1e9 / Shortest_ns) : 0.0);
+}
+
+/**
+ * @brief Print the resonance bands of the motor.
+ */
+static void Report_Resonance_Table(void)
+{
+    Resonance_Table_t Table;
+
+    Motor_Resonance_Get_Table(&Table);
+
+    printf("  BANDS     : %u, crossed at %u steps/s^2\n", Table.Band_Count, Table.Crossing_Acceleration);
+
+    for (uint8_t Index = 0; Index < Table.Band_Count; Index++)
+    {
+        printf("    %u - %u Hz\n", Table.Bands[Index].Low_Hz, Table.Bands[Index].High_Hz);
+    }
+}
+
+/**
+ * @brief Step timing of axis X during the command the checks look at.
+ *
+ * The periods have to shrink up to the shortest one and grow after it,
+ * each within SIM_SHAPE_TOLERANCE of the one before, for the ramp to count
+ * as monotonic.
+ */
+static void Scan_Steps(Step_Scan_t *Scan)
+{
+    const Sim_Event_t *Events = Sim_Get_Events();
+    uint64_t Previous_ns = 0;     // Rising edge before
+    uint64_t Previous_Period = 0; // Period before
+    size_t Shortest_Edge = 0;     // Timeline entry ending the shortest period
+
+    memset(Scan, 0, sizeof(*Scan));
+
+    for (int Pass = 0; Pass < 2; Pass++) // The shortest period is found first, the shape checked around it
+    {
+        uint32_t Pulses = 0;
+
+        for (size_t Index = Checked_Event; Index < Sim_Get_Event_Count(); Index++)
+        {
+            if ((Events[Index].Gpio != STEPPER_MOTOR_PUL_PIN) || !Events[Index].Level)
+            {
+                continue;
+            }
+
+            uint64_t Period_ns = (Pulses > 0) ? (Events[Index].Time_ns - Previous_ns) : 0;
+
+            if ((Pass == 0) && (Period_ns > 0) && ((Scan->Shortest_ns == 0) || (Period_ns < Scan->Shortest_ns)))
+            {
+                Scan->Shortest_ns = Period_ns;
+                Shortest_Edge = Index;
+            }
+
+            if ((Pass == 1) && (Period_ns > 0) && (Previous_Period > 0))
+            {
+                bool Rising = (Index <= Shortest_Edge); // Still on the way up to the peak rate
+
+                if (Rising ? (Period_ns > (Previous_Period + (Previous_Period / SIM_SHAPE_TOLERANCE))) : ((Period_ns + (Previous_Period / SIM_SHAPE_TOLERANCE)) < Previous_Period))
+                {
+                    Scan->Shape_Errors++;
+                }
+            }
+
+            Previous_ns = Events[Index].Time_ns;
+            Previous_Period = Period_ns;
+            Scan->Last_ns = Period_ns;
+            Pulses++;
+        }
+
+        Scan->Pulses = Pulses;
+    }
+}
+
+/**
+ * @brief Check the command before against an expectation and report it.
+ *
+ * @return ESP_OK if the expectation holds, ESP_FAIL otherwise.
+ */
+static esp_err_t Run_Check(const char *Name, const long *Value)
+{
+    bool Passed = false;
+    Step_Scan_t Scan;
+
+    Scan_Steps(&Scan);
+
+    double Last_Hz = (Scan.Last_ns > 0) ? (1e9 / Scan.Last_ns) : 0.0;
+    double Peak_Hz = (Scan.Shortest_ns > 0) ? (1e9 / Scan.Shortest_ns) : 0.0;
+
+    if (strcmp(Name, "ends") == 0)
+    {
+        Passed = (Scan.Last_ns > 0) && (Last_Hz < Value[0]);
+
+        printf("%-9s : %s, last step at %.0f steps/s, expected below %ld\n", Name, Passed ? "ok" : "FAILED", Last_Hz, Value[0]);
+    }
+    else if (strcmp(Name, "steps") == 0)
+    {
+        Passed = (Scan.Pulses == (uint32_t)Value[0]) && (Sim_Get_Axis_Position() == Value[1]);
+
+        printf("%-9s : %s, %u steps to %d on the axis, expected %ld to %ld\n", Name, Passed ? "ok" : "FAILED", Scan.Pulses, (int)Sim_Get_Axis_Position(), Value[0], Value[1]);
+    }
+    else if (strcmp(Name, "counted") == 0)
+    {
+        Passed = (Get_Stepper_Motor_Position() == Value[0]);
+
+        printf("%-9s : %s, %d counted, expected %ld\n", Name, Passed ? "ok" : "FAILED", (int)Get_Stepper_Motor_Position(), Value[0]);
+    }
+    else if (strcmp(Name, "ramp") == 0)
+    {
+        Passed = (Scan.Shape_Errors == 0) && (fabs(Peak_Hz - Value[0]) <= (Value[0] / (double)SIM_SHAPE_TOLERANCE));
+
+        printf("%-9s : %s, peak %.0f steps/s, %u periods off the ramp, expected a monotonic ramp to %ld\n", Name, Passed ? "ok" : "FAILED", Peak_Hz, Scan.Shape_Errors, Value[0]);
+    }
+    else
+    {
+        Passed = (Checked_Error == (esp_err_t)Value[0]);
+
+        printf("%-9s : %s, %s, expected %s\n", Name, Passed ? "ok" : "FAILED", esp_err_to_name(Checked_Error), esp_err_to_name((esp_err_t)Value[0]));
+    }
+
+    return Passed ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Execute one command on the virtual clock and report it.
+ */
+static esp_err_t Run_Command(const char *Name, const long *Value)
+{
+    esp_err_t Function_Error = ESP_OK;
+    uint32_t Executed = 0;
+    uint64_t Start_ns = Sim_Get_Time_ns();
+    size_t First_Event = Sim_Get_Event_Count(); // Edges of earlier commands at the same time are not counted
+
+    if ((strcmp(Name, "ends") == 0) || (strcmp(Name, "steps") == 0) || (strcmp(Name, "counted") == 0) || (strcmp(Name, "ramp") == 0) || (strcmp(Name, "result") == 0))
+    {
+        return Run_Check(Name, Value);
+    }
+
+    Checked_Event = First_Event;
+
+    if (strcmp(Name, "move") == 0)
+    {
+        Function_Error = Move_Stepper_Motor((uint)Value[0], (uint8_t)Value[2], (uint32_t)Value[1], &Executed);
+    }
+    else if (strcmp(Name, "rotate") == 0)
+    {
+        Function_Error = Rotate_Stepper_Motor((uint)Value[0], (uint8_t)Value[2], (uint32_t)Value[1], &Executed);
+    }
+    else if (strcmp(Name, "run") == 0)
+    {
+        Function_Error = Start_Stepper_Motor((uint8_t)Value[1], (uint)Value[0], PWM_DUTY_CYCLE_50);
+
+        vTaskDelay(pdMS_TO_TICKS(Value[2]));
+
+        Function_Error += Decelerate_Stepper_Motor(&Executed);
+    }
+    else if (strcmp(Name, "linear") == 0)
+    {
+        const int32_t Axis_Steps[DDA_MAX_AXES] = {(int32_t)Value[1], (int32_t)Value[2], 0, 0};
+
+        Function_Error = Move_Stepper_Axes_Linear((uint)Value[0], Axis_Steps, &Executed);
+    }
+    else if (strcmp(Name, "arc") == 0)
+    {
+        Function_Error = Move_Stepper_Axes_Arc((uint)Value[0], (int32_t)Value[1], (int32_t)Value[2], (int32_t)Value[3], (int32_t)Value[4], Value[5] != 0, &Executed);
+    }
+    else if (strcmp(Name, "cache") == 0)
+    {
+        Ramp_Cache_Stats_t Stats;
+
+        if (Value[0] != 0)
+        {
+            Function_Error = Initialize_Ramp_Cache(); // Drop the RAM cache and load the hot ramps again
+        }
+
+        Ramp_Cache_Get_Stats(&Stats);
+
+        printf("  HITS %u, MISSES %u, EVICTIONS %u, ENTRIES %u, NVS LOADED %u, NVS WRITES %u, NVS ERRORS %u\n",
+               Stats.Hits, Stats.Misses, Stats.Evictions, Stats.Entries, Stats.Nvs_Loaded, Stats.Nvs_Writes, Stats.Nvs_Errors);
+    }
+    else if (strcmp(Name, "jog") == 0)
+    {
+        Velocity_Ramp_t Ramp;
+
+        Velocity_Ramp_Begin(&Ramp, Get_Stepper_Motor_Velocity(), MOTION_DEFAULT_ACCELERATION, MOTION_JOG_MIN_FREQUENCY_HZ);
+
+        // One update per RTOS tick, like the jog loop of motion_queue.c
+        for (long Tick = 0; (Tick < (long)pdMS_TO_TICKS(Value[1])) && (Function_Error == ESP_OK); Tick++)
+        {
+            vTaskDelay(1);
+
+            Function_Error = Set_Stepper_Motor_Velocity(Velocity_Ramp_Update(&Ramp, (int32_t)Value[0], MOTION_SEGMENT_TIME_US), PWM_DUTY_CYCLE_50);
+        }
+
+        printf("  VELOCITY  : %d Hz\n", (int)Get_Stepper_Motor_Velocity());
+
+        if (Get_Stepper_Motor_Velocity() == 0)
+        {
+            Function_Error += Decelerate_Stepper_Motor(&Executed); // Stood still at a target of 0, the jog mode ends
+        }
+    }
+    else if ((strcmp(Name, "estop") == 0) || (strcmp(Name, "stop") == 0))
+    {
+        if (Name[0] == 'e')
+        {
+            Function_Error = (Value[1] != 0) ? Set_Stepper_Motor_Quick_Stop_Deceleration((uint32_t)Value[1]) : ESP_OK;
+
+            Sim_Schedule_Interrupt((uint64_t)Value[0] * 1000, Estop_ISR, NULL);
+        }
+        else
+        {
+            Stop_Deceleration = (Value[1] != 0) ? (uint32_t)Value[1] : MOTION_DEFAULT_ACCELERATION;
+
+            Sim_Schedule_Interrupt((uint64_t)Value[0] * 1000, Stop_Request, NULL);
+        }
+
+        return Function_Error; // Fires during the next command
+    }
+    else if (strcmp(Name, "moveto") == 0)
+    {
+        Function_Error = Move_Stepper_Motor_To((uint)Value[0], (int32_t)Value[1], &Executed);
+    }
+    else if (strcmp(Name, "home") == 0)
+    {
+        Homing_Config_t Config;
+        Homing_Result_t Result;
+
+        Homing_Get_Default_Config(&Config);
+
+        Config.Fast_Frequency_Hz = (Value[1] != 0) ? (uint32_t)Value[1] : Config.Fast_Frequency_Hz;
+        Config.Slow_Frequency_Hz = (Value[2] != 0) ? (uint32_t)Value[2] : Config.Slow_Frequency_Hz;
+
+        Sim_Set_Limit_Switch(HOMING_SWITCH_PIN, HOMING_SWITCH_ACTIVE_LEVEL, (int32_t)Value[0], true);
+
+        Function_Error = Home_Stepper_Motor(&Config);
+
+        Homing_Get_Result(&Result);
+
+        printf("  LATCHES   : fast %d, slow %d, %d steps apart\n", (int)Result.Fast_Latch, (int)Result.Slow_Latch, (int)Result.Latch_Error);
+        printf("  FAST      : %u Hz at the latch, %u steps overtravel, %u us latch delay, %u us in the ISR\n",
+               Result.Fast_Speed_Hz, Result.Overtravel_Steps, Result.Latch_Delay_us, Result.Isr_Latch_us);
+        printf("  PHASES    : fast %.3f ms, back-off %.3f ms, slow %.3f ms, total %.3f ms\n",
+               Result.Fast_Approach_us / 1e3, Result.Backoff_us / 1e3, Result.Slow_Approach_us / 1e3, Result.Total_us / 1e3);
+    }
+    else if (strcmp(Name, "band") == 0)
+    {
+        Resonance_Table_t Table;
+
+        Motor_Resonance_Get_Table(&Table);
+
+        if ((Value[0] == 0) && (Value[1] == 0))
+        {
+            Table.Band_Count = 0;
+        }
+        else if (!Resonance_Add_Band(&Table, (uint32_t)Value[0], (uint32_t)Value[1]))
+        {
+            Function_Error = ESP_ERR_INVALID_ARG;
+        }
+
+        Function_Error = (Function_Error == ESP_OK) ? Motor_Resonance_Set_Table(&Table, false) : Function_Error;
+
+        Report_Resonance_Table();
+    }
+    else if (strcmp(Name, "resonate") == 0)
+    {
+        Sim_Set_Resonance(RESONANCE_SENSE_PIN, (uint32_t)Value[0], (uint32_t)Value[1]);
+    }
+    else if (strcmp(Name, "sweep") == 0)
+    {
+        Resonance_Sweep_Config_t Config;
+        Resonance_Sweep_Report_t Report;
+
+        Motor_Resonance_Get_Default_Sweep(&Config);
+
+        Config.Start_Hz = (uint32_t)Value[0];
+        Config.End_Hz = (uint32_t)Value[1];
+        Config.Step_Hz = (uint32_t)Value[2];
+
+        Function_Error = Motor_Resonance_Sweep(&Config);
+
+        Motor_Resonance_Get_Sweep(&Report);
+
+        printf("  SWEEP     : %u points, %u bands found\n", Report.Points, Report.Bands_Found);
+
+        for (uint16_t Point = 0; Point < Report.Points; Point++)
+        {
+            if (Report.Counts[Point] > 0)
+            {
+                printf("    %u Hz: %u sense edges\n", Report.Start_Hz + (Point * Report.Step_Hz), Report.Counts[Point]);
+            }
+        }
+
+        Report_Resonance_Table();
+    }
+    else if (strcmp(Name, "script") == 0)
+    {
+        Motor_Script_Handle_t Handle;
+        Motion_Script_Error_t Error;
+        Motor_Script_Stats_t Stats;
+
+        Function_Error = (Script_Path != NULL) ? Motor_Script_Load(Script_Path, &Handle, &Error) : ESP_ERR_NOT_FOUND;
+
+        if ((Function_Error == ESP_ERR_INVALID_ARG) && (Error.Message != NULL))
+        {
+            printf("  %s:%u: %s\n", Script_Path, Error.Line, Error.Message);
+        }
+
+        if (Function_Error == ESP_OK)
+        {
+            Function_Error = Motor_Script_Run(&Handle, (uint32_t)Value[0], &Executed);
+
+            Motor_Script_Get_Stats(&Handle, &Stats);
+
+            printf("  SCRIPT    : %u ops, %s, %u moves and %llu steps per run\n", Stats.Op_Count, Handle.Cached ? "cached" : "compiled",
+                   Stats.Moves_Per_Run, (unsigned long long)Stats.Steps_Per_Run);
+            printf("  RUNS      : %u, %u failed, min %.3f ms, mean %.3f ms, max %.3f ms\n", Stats.Runs, Stats.Failed_Runs, Stats.Min_Run_us / 1e3,
+                   (Stats.Runs > 0) ? (Stats.Sum_Run_us / 1e3 / Stats.Runs) : 0.0, Stats.Max_Run_us / 1e3);
+        }
+    }
+    else if (strcmp(Name, "trajectory") == 0)
+    {
+        Trajectory_Player_Info_t Info;
+
+        Function_Error = (Trajectory_Image != NULL) ? Trajectory_Player_Attach(Trajectory_Image, Trajectory_Size) : ESP_ERR_NOT_FOUND;
+
+        for (long Play = 0; (Function_Error == ESP_OK) && (Play < Value[0]); Play++)
+        {
+            uint32_t Steps = 0;
+
+            Function_Error = Trajectory_Player_Run(&Steps);
+            Executed += Steps;
+        }
+
+        Trajectory_Player_Get_Info(&Info);
+
+        printf("  TRAJECTORY: %s, %u records, %u steps, %u ms planned\n", Trajectory_Result_Name(Info.Result), Info.Record_Count, Info.Total_Steps, Info.Duration_ms);
+        printf("  PLAYS     : %u, %u failed, last %.3f ms\n", Info.Plays, Info.Failed_Plays, Info.Last_Play_us / 1e3);
+    }
+    else if (strcmp(Name, "load") == 0)
+    {
+        Sim_Set_Motor_Load((uint32_t)Value[0], (uint32_t)Value[1]);
+    }
+    else if (strcmp(Name, "autotune") == 0)
+    {
+        Autotune_Config_t Config;
+        Motor_Encoder_Autotune_Report_t Report;
+        uint32_t Max_Frequency_Hz = 0;
+        uint32_t Acceleration = 0;
+
+        Motor_Encoder_Get_Default_Autotune(&Config);
+
+        Function_Error = Motor_Encoder_Autotune(&Config, (uint32_t)Value[0], Value[1] != 0);
+
+        Motor_Encoder_Get_Autotune(&Report);
+        Get_Stepper_Motor_Limits(&Max_Frequency_Hz, &Acceleration);
+
+        printf("  AUTOTUNE  : %u trials, %u failed, found %u Hz and %u steps/s^2%s\n", Report.Trials, Report.Failed_Trials, Report.Max_Frequency_Hz,
+               Report.Acceleration, Report.Saved ? ", saved" : "");
+        printf("  LIMITS    : %u Hz, %u steps/s^2\n", Max_Frequency_Hz, Acceleration);
+    }
+    else if (strcmp(Name, "trace") == 0)
+    {
+        Function_Error = (Value[0] != 0) ? Motion_Trace_Dump() : Motion_Trace_Print_Stats();
+    }
+    else
+    {
+        vTaskDelay(pdMS_TO_TICKS(Value[0]));
+    }
+
+    Clear_Stepper_Motor_Stop(); // Like the motion task once the motor stands still
+
+    uint64_t End_ns = Sim_Get_Time_ns();
+
+    printf("%-9s : %s at %.3f ms, took %.3f ms, %u steps reported\n", Name, esp_err_to_name(Function_Error), Start_ns / 1e6, (End_ns - Start_ns) / 1e6, Executed);
+
+    Report_Axis("X", STEPPER_MOTOR_PUL_PIN, Start_ns, First_Event);
+    Report_Axis("Y", AXIS_Y_PUL_PIN, Start_ns, First_Event);
+
+    printf("  POSITION  : %d counted, %d on the axis, %u emitted since start%s\n", (int)Get_Stepper_Motor_Position(), (int)Sim_Get_Axis_Position(), (unsigned)Get_Stepper_Motor_Emitted_Steps(), Stepper_Motor_Position_Referenced() ? ", referenced" : "");
+
+    if (Motor_Encoder_Active())
+    {
+        Motor_Encoder_Status_t Encoder_Status;
+
+        Motor_Encoder_Get_Status(&Encoder_Status);
+
+        printf("  ENCODER   : %d measured, %d on the rotor, max error %u, %u faults, last %s\n", (int)Encoder_Status.Measured_Steps, (int)Sim_Get_Rotor_Position(),
+               Encoder_Status.Max_Error, Encoder_Status.Faults, Closed_Loop_Fault_Name(Encoder_Status.Last_Fault));
+    }
+
+    Checked_Error = Function_Error;
+
+    return Function_Error;
+}
+
+int main(int argc, char **argv)
+{
+    const char *Vcd_Path = NULL;
+    const char *Csv_Path = NULL;
+    int Failed = 0;
+    int Index = 1;
+
+    while ((Index + 1 < argc) && (strncmp(argv[Index], "--", 2) == 0))
+    {
+        if (strcmp(argv[Index], "--vcd") == 0)
+        {
+            Vcd_Path = argv[Index + 1];
+        }
+        else if (strcmp(argv[Index], "--csv") == 0)
+        {
+            Csv_Path = argv[Index + 1];
+        }
+        else if (strcmp(argv[Index], "--script") == 0)
+        {
+            Script_Path = argv[Index + 1];
+        }
+        else if (strcmp(argv[Index], "--trajectory") == 0)
+        {
+            Trajectory_Image = Read_Trajectory(argv[Index + 1], &Trajectory_Size);
+
+            if (Trajectory_Image == NULL)
+            {
+                return 2;
+            }
+        }
+        else
+        {
+            break;
+        }
+
+        Index += 2;
+    }
+
+    if (Index >= argc)
+    {
+        fprintf(stderr, "Usage: %s [--vcd file] [--csv file] [--script file] [--trajectory file] command...\n"
+                        "  move <frq> <steps> <dir>, rotate <frq> <steps> <dir>, run <frq> <dir> <ms>,\n"
+                        "  linear <frq> <x> <y>, arc <frq> <x> <y> <i> <j> <cw>, wait <ms>,\n"
+                        "  cache <reload>, trace <dump>, jog <velocity> <ms>,\n"
+                        "  estop <ms> <decel>, stop <ms> <decel>, moveto <frq> <pos>,\n"
+                        "  home <switch> <fast> <slow>, band <low> <high>, resonate <low> <high>,\n"
+                        "  sweep <from> <to> <step>, script <repeat>, trajectory <plays>,\n"
+                        "  load <pull_out> <accel>, autotune <travel> <save>, ends <frq>,\n"
+                        "  steps <count> <pos>, counted <pos>, ramp <frq>, result <err>\n",
+                argv[0]);
+        return 2;
+    }
+
+    Initialize_Simulation();
+
+    while (Index < argc)
+    {
+        const Sim_Command_t *Command = NULL;
+        long Value[6] = {0};
+
+        for (size_t Entry = 0; Entry < (sizeof(Commands) / sizeof(Commands[0])); Entry++)
+        {
+            if (strcmp(argv[Index], Commands[Entry].Name) == 0)
+            {
+                Command = &Commands[Entry];
+            }
+        }
+
+        if ((Command == NULL) || ((Index + Command->Arguments) >= argc))
+        {
+            fprintf(stderr, "Unknown command or missing arguments: %s\n", argv[Index]);
+            return 2;
+        }
+
+        for (int Argument = 0; Argument < Command->Arguments; Argument++)
+        {
+            Value[Argument] = strtol(argv[Index + 1 + Argument], NULL, 0);
+        }
+
+        esp_err_t Result = Run_Command(Command->Name, Value);
+
+        if ((strcmp(Command->Name, "result") == 0) && (Result == ESP_OK) && (Checked_Error != ESP_OK))
+        {
+            Failed--; // The error of the command before was expected
+        }
+        else if (Result != ESP_OK)
+        {
+            Failed++;
+        }
+
+        Index += 1 + Command->Arguments;
+    }
+
+    if ((Vcd_Path != NULL) && !Sim_Export_VCD(Vcd_Path))
+    {
+        fprintf(stderr, "Cannot write %s\n", Vcd_Path);
+        return 2;
+    }
+
+    if ((Csv_Path != NULL) && !Sim_Export_CSV(Csv_Path))
+    {
+        fprintf(stderr, "Cannot write %s\n", Csv_Path);
+        return 2;
+    }
+
+    return (Failed > 0) ? 1 : 0;
+}
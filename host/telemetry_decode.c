@@ -0,0 +1,168 @@
+/*H**********************************************************************
+ * FILENAME :        telemetry_decode.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host decoder of the telemetry frames of the binary link.
+ *
+ * NOTES :
+ *       Reads the byte stream of the binary link UART from a serial device,
+ *       a capture file or stdin ('-'), decodes it with the codec of the
+ *       target, see main/binary_protocol.h, and prints one line per
+ *       telemetry frame, JSON by default or CSV with --csv. Frames lost on
+ *       the way show up as a gap of the sequence, counted in "lost". Other
+ *       frames, e.g. acks, are skipped.
+ *
+ *       With --period the telemetry is switched on first by sending
+ *       PROTOCOL_OP_TELEMETRY to the device, 0 switches it off. The serial
+ *       device has to be set up before, e.g.
+ *         stty -F /dev/ttyUSB1 921600 raw -echo
+ *
+ *       Usage: telemetry_decode [--period ms] [--csv] device|file|-
+ *       Exits with 1 if the input cannot be opened or the request not sent.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "binary_protocol.h"
+
+#define TELEMETRY_DECODE_READ_SIZE 256 // Bytes read at once
+#define TELEMETRY_DECODE_SEQUENCE 0x54 // Sequence of the PROTOCOL_OP_TELEMETRY request, echoed by its ack
+
+/**
+ * @brief Send PROTOCOL_OP_TELEMETRY with the given period.
+ *
+ * @return false if the frame could not be written.
+ */
+static bool Send_Period(int Device, uint16_t Period_ms)
+{
+    uint8_t Payload[2] = {(uint8_t)Period_ms, (uint8_t)(Period_ms >> 8)};
+    uint8_t Frame[PROTOCOL_HEADER_SIZE + sizeof(Payload) + PROTOCOL_CRC_SIZE];
+    size_t Size = Protocol_Encode_Frame(PROTOCOL_OP_TELEMETRY, TELEMETRY_DECODE_SEQUENCE, Payload, sizeof(Payload), Frame, sizeof(Frame));
+
+    return (Size > 0) && (write(Device, Frame, Size) == (ssize_t)Size);
+}
+
+/**
+ * @brief Print one telemetry frame.
+ *
+ * @param Telemetry Decoded frame.
+ * @param Sequence Sequence of the frame.
+ * @param Lost Frames missing before this one.
+ * @param Csv Print a CSV line instead of JSON.
+ */
+static void Print_Telemetry(const Protocol_Telemetry_t *Telemetry, uint8_t Sequence, uint32_t Lost, bool Csv)
+{
+    if (Csv)
+    {
+        printf("%u,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRId32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%u,%" PRIu32 ",%" PRIu32 ",%u\n",
+               Sequence, Lost, Telemetry->Uptime_ms, Telemetry->Step_Rate_Hz, Telemetry->Position, Telemetry->Queue_Depth, Telemetry->Steps_Emitted,
+               Telemetry->Missed_Deadlines, Telemetry->Motion_Busy_ms, Telemetry->Motion_Load, Telemetry->Free_Heap, Telemetry->Min_Free_Heap, Telemetry->Flags);
+    }
+    else
+    {
+        printf("{\"seq\": %u, \"lost\": %" PRIu32 ", \"uptime_ms\": %" PRIu32 ", \"step_rate_hz\": %" PRIu32 ", \"position\": %" PRId32
+               ", \"queue_depth\": %" PRIu32 ", \"steps_emitted\": %" PRIu32 ", \"missed_deadlines\": %" PRIu32 ", \"motion_busy_ms\": %" PRIu32
+               ", \"motion_load\": %.3f, \"free_heap\": %" PRIu32 ", \"min_free_heap\": %" PRIu32
+               ", \"busy\": %s, \"running\": %s, \"jogging\": %s, \"referenced\": %s}\n",
+               Sequence, Lost, Telemetry->Uptime_ms, Telemetry->Step_Rate_Hz, Telemetry->Position,
+               Telemetry->Queue_Depth, Telemetry->Steps_Emitted, Telemetry->Missed_Deadlines, Telemetry->Motion_Busy_ms,
+               Telemetry->Motion_Load / 1000.0, Telemetry->Free_Heap, Telemetry->Min_Free_Heap,
+               (Telemetry->Flags & PROTOCOL_TELEMETRY_BUSY) ? "true" : "false",
+               (Telemetry->Flags & PROTOCOL_TELEMETRY_RUNNING) ? "true" : "false",
+               (Telemetry->Flags & PROTOCOL_TELEMETRY_JOGGING) ? "true" : "false",
+               (Telemetry->Flags & PROTOCOL_TELEMETRY_REFERENCED) ? "true" : "false");
+    }
+
+    fflush(stdout); // One complete record at a time for the consumer of the pipe
+}
+
+int main(int argc, char **argv)
+{
+    static Protocol_Decoder_t Decoder;
+    static Protocol_Frame_t Frame;
+    uint8_t Buffer[TELEMETRY_DECODE_READ_SIZE];
+    long Period_ms = -1; // Telemetry left as it is
+    bool Csv = false;
+    bool First = true;
+    uint8_t Next_Sequence = 0;
+    int Index = 1;
+
+    for (; (Index < argc) && (strncmp(argv[Index], "--", 2) == 0); Index++)
+    {
+        if ((strcmp(argv[Index], "--period") == 0) && (Index + 1 < argc))
+        {
+            Period_ms = strtol(argv[++Index], NULL, 0);
+        }
+        else if (strcmp(argv[Index], "--csv") == 0)
+        {
+            Csv = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if ((Index != argc - 1) || (Period_ms > UINT16_MAX))
+    {
+        fprintf(stderr, "usage: %s [--period ms] [--csv] device|file|-\n", argv[0]);
+        return 1;
+    }
+
+    int Device = (strcmp(argv[Index], "-") == 0) ? STDIN_FILENO : open(argv[Index], (Period_ms >= 0) ? O_RDWR : O_RDONLY);
+
+    if (Device < 0)
+    {
+        fprintf(stderr, "%s: cannot open\n", argv[Index]);
+        return 1;
+    }
+
+    if ((Period_ms >= 0) && !Send_Period(Device, (uint16_t)Period_ms))
+    {
+        fprintf(stderr, "%s: cannot send the telemetry period\n", argv[Index]);
+        return 1;
+    }
+
+    if (Csv)
+    {
+        printf("seq,lost,uptime_ms,step_rate_hz,position,queue_depth,steps_emitted,missed_deadlines,motion_busy_ms,motion_load_permille,free_heap,min_free_heap,flags\n");
+    }
+
+    Protocol_Decoder_Reset(&Decoder);
+
+    ssize_t Count;
+
+    while ((Count = read(Device, Buffer, sizeof(Buffer))) > 0)
+    {
+        for (ssize_t Byte = 0; Byte < Count; Byte++)
+        {
+            if ((Protocol_Decoder_Feed(&Decoder, Buffer[Byte], &Frame) != PROTOCOL_DECODE_FRAME) ||
+                (Frame.Opcode != PROTOCOL_OP_TELEMETRY_FRAME) || (Frame.Length != PROTOCOL_TELEMETRY_SIZE))
+            {
+                continue; // Partial, broken or not a telemetry frame
+            }
+
+            Protocol_Telemetry_t Telemetry;
+            uint32_t Lost = First ? 0 : (uint8_t)(Frame.Sequence - Next_Sequence); // Gaps above 255 frames are not seen
+
+            Protocol_Unpack_Telemetry(Frame.Payload, &Telemetry);
+            Print_Telemetry(&Telemetry, Frame.Sequence, Lost, Csv);
+
+            First = false;
+            Next_Sequence = Frame.Sequence + 1;
+        }
+    }
+
+    fprintf(stderr, "%" PRIu32 " broken frames\n", Decoder.Bad_Frames);
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+/*H**********************************************************************
+ * FILENAME :        trajectory_check.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Host check of the trajectory image format.
+ *
+ * NOTES :
+ *       Random trajectories must decode to the segments they were written
+ *       from, and every single bit flip of an image must be rejected.
+ *       Pseudo random inputs come from a fixed seed, so every run checks
+ *       the same values.
+ *
+ *       Usage: trajectory_check [iterations]
+ *       Exits with 1 if a check failed.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <math.h>
+#include "trajectory_format.h"
+#include "host_check.h"
+
+#define CHECK_DEFAULT_ITERATIONS 20000    // Random trajectories checked
+#define CHECK_TRAJECTORY_TICK_HZ 10000000 // Same as TIMER_PULSE_ENGINE_TICK_HZ on the target
+#define CHECK_TRAJECTORY_ITEMS 64         // Segments and pauses of one random trajectory
+
+/**
+ * @brief Take Amount from the decoded records, which must continue with the same kind of segment.
+ *
+ * @return false if the records differ from the written segment.
+ */
+static bool Consume_Trajectory(const Trajectory_View_t *View, uint32_t *Record, uint64_t *Left, bool Pause, bool Forward, uint64_t Period_Q16, uint64_t Amount)
+{
+    Trajectory_Segment_t Segment;
+
+    while (Amount > 0)
+    {
+        if (*Record >= View->Header->Record_Count)
+        {
+            return false;
+        }
+
+        Trajectory_Decode(View, *Record, &Segment);
+
+        if (*Left == 0)
+        {
+            *Left = Segment.Pause ? Segment.Pause_us : Segment.Steps;
+        }
+
+        if ((Segment.Pause != Pause) || (!Pause && ((Segment.Forward != Forward) || (Segment.Period_Q16 != Period_Q16))))
+        {
+            return false;
+        }
+
+        uint64_t Taken = (Amount < *Left) ? Amount : *Left;
+
+        Amount -= Taken;
+        *Left -= Taken;
+        *Record += (*Left == 0) ? 1 : 0;
+    }
+
+    return true;
+}
+
+static void Check_Trajectory(uint32_t Iterations)
+{
+    static uint32_t Image[(sizeof(Trajectory_Header_t) + (CHECK_TRAJECTORY_ITEMS * 2 * sizeof(Trajectory_Record_t))) / sizeof(uint32_t)];
+    static struct
+    {
+        bool Pause;
+        bool Forward;
+        uint32_t Frequency_Hz;
+        uint32_t Amount; // Steps, or the pause in us
+    } Items[CHECK_TRAJECTORY_ITEMS];
+    Trajectory_Writer_t Writer;
+    Trajectory_View_t View;
+    char Detail[96];
+
+    for (uint32_t Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        uint32_t Count = 1 + (uint32_t)(Host_Check_Random() % CHECK_TRAJECTORY_ITEMS);
+        uint64_t Steps = 0;
+        long double Duration_s = 0;
+
+        snprintf(Detail, sizeof(Detail), "iteration %" PRIu32 ", %" PRIu32 " items", Iteration, Count);
+
+        Trajectory_Begin(&Writer, Image, sizeof(Image), CHECK_TRAJECTORY_TICK_HZ);
+
+        for (uint32_t Index = 0; Index < Count; Index++)
+        {
+            uint64_t Random = Host_Check_Random();
+
+            Items[Index].Pause = (Random % 8) == 0;
+            Items[Index].Forward = ((Random >> 3) & 3) != 0;
+            Items[Index].Frequency_Hz = (((Random >> 5) % 4) == 0) && (Index > 0) ? Items[Index - 1].Frequency_Hz : 1 + (uint32_t)((Random >> 8) % 200000); // Repeated to merge
+            Items[Index].Amount = 1 + (uint32_t)((Random >> 32) % 100000);
+
+            if ((Random % 997) == 0)
+            {
+                Items[Index].Amount = 0x50000000; // Split into two records
+            }
+
+            bool Added = Items[Index].Pause ? Trajectory_Add_Pause(&Writer, Items[Index].Amount)
+                                            : Trajectory_Add_Steps(&Writer, Items[Index].Forward, Items[Index].Frequency_Hz, Items[Index].Amount);
+
+            if (!Added)
+            {
+                Host_Check_Fail("trajectory_add", Detail);
+            }
+
+            if (Items[Index].Pause)
+            {
+                Duration_s += Items[Index].Amount / 1e6L;
+            }
+            else
+            {
+                Steps += Items[Index].Amount;
+                Duration_s += (long double)((((uint64_t)CHECK_TRAJECTORY_TICK_HZ << 8) / Items[Index].Frequency_Hz) * Items[Index].Amount) / 256.0L / CHECK_TRAJECTORY_TICK_HZ;
+            }
+        }
+
+        size_t Size = Trajectory_Finish(&Writer);
+
+        if ((Steps > UINT32_MAX) || (Duration_s * 1000 > UINT32_MAX))
+        {
+            if (Size != 0)
+            {
+                Host_Check_Fail("trajectory_totals", Detail);
+            }
+
+            continue;
+        }
+
+        Trajectory_Result_t Result = Trajectory_Open(Image, Size, &View);
+
+        if ((Size == 0) || (Result != TRAJECTORY_OK))
+        {
+            Host_Check_Fail("trajectory_open", Detail);
+            continue;
+        }
+
+        if ((View.Header->Total_Steps != Steps) || (fabsl((View.Header->Duration_ms / 1000.0L) - Duration_s) > 0.002L))
+        {
+            Host_Check_Fail("trajectory_header", Detail);
+        }
+
+        uint32_t Record = 0;
+        uint64_t Left = 0;
+
+        for (uint32_t Index = 0; Index < Count; Index++)
+        {
+            uint64_t Period_Q16 = Items[Index].Pause ? 0 : ((((uint64_t)CHECK_TRAJECTORY_TICK_HZ << 8) / Items[Index].Frequency_Hz) << 8);
+
+            if (!Consume_Trajectory(&View, &Record, &Left, Items[Index].Pause, Items[Index].Forward, Period_Q16, Items[Index].Amount))
+            {
+                Host_Check_Fail("trajectory_decode", Detail);
+                break;
+            }
+        }
+
+        if ((Record != View.Header->Record_Count) || (Left != 0))
+        {
+            Host_Check_Fail("trajectory_records", Detail);
+        }
+
+        // Every single bit flip is caught by a CRC-32 or the header checks
+        size_t Bit = (size_t)(Host_Check_Random() % (Size * 8));
+
+        ((uint8_t *)Image)[Bit / 8] ^= (uint8_t)(1 << (Bit % 8));
+
+        if (Trajectory_Open(Image, Size, &View) == TRAJECTORY_OK)
+        {
+            Host_Check_Fail("trajectory_bit_flip", Detail);
+        }
+
+        ((uint8_t *)Image)[Bit / 8] ^= (uint8_t)(1 << (Bit % 8));
+
+        if ((Trajectory_Open(Image, Size - 1, &View) != TRAJECTORY_TOO_SMALL) && (Size > sizeof(Trajectory_Header_t)))
+        {
+            Host_Check_Fail("trajectory_truncated", Detail);
+        }
+    }
+
+    Trajectory_Begin(&Writer, Image, sizeof(Trajectory_Header_t) + sizeof(Trajectory_Record_t), CHECK_TRAJECTORY_TICK_HZ);
+
+    if (!Trajectory_Add_Steps(&Writer, true, 1000, 10) || Trajectory_Add_Steps(&Writer, false, 1000, 10) || (Trajectory_Finish(&Writer) != 0))
+    {
+        Host_Check_Fail("trajectory_overflow", "a full image was accepted");
+    }
+
+    if (Trajectory_Add_Steps(&Writer, true, (CHECK_TRAJECTORY_TICK_HZ / TRAJECTORY_MIN_PERIOD_TICKS) + 1, 1))
+    {
+        Host_Check_Fail("trajectory_period", "a period below TRAJECTORY_MIN_PERIOD_TICKS was accepted");
+    }
+
+    printf("trajectory   : %" PRIu32 " images\n", Iterations);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = 0;
+
+    if (!Host_Check_Arguments(argc, argv, CHECK_DEFAULT_ITERATIONS, &Iterations))
+    {
+        return 2;
+    }
+
+    Check_Trajectory(Iterations);
+
+    return Host_Check_Result();
+}
@@ -0,0 +1,387 @@
+/*H**********************************************************************
+ * FILENAME :        trajectory_compiler.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Compiles a motion script into a precompiled trajectory for the
+ *       trajectory partition, see main/trajectory_format.h.
+ *
+ * NOTES :
+ *       The script is compiled with the compiler of the target, see
+ *       main/motion_script.h, and executed here: loops are unrolled, every
+ *       move is planned with the planner of the target and its segments
+ *       become records, a dwell becomes a pause. Positions of move_to are
+ *       relative to where the play starts. The resonance bands of the
+ *       target are not known here, cruise speeds are taken as given.
+ *
+ *       The written file is opened and decoded again like on the target
+ *       and its totals are compared with the planned ones. A warning is
+ *       printed where SEGMENT_RING_SIZE records in a row are shorter than
+ *       the refill interval of the timer pulse engine, the ring could run
+ *       empty there.
+ *
+ *       Usage: trajectory_compiler [--accel n] [--jerk n] [--segment-us n]
+ *                                  [--size bytes] [--list] script output
+ *       Exits with 1 if the script has an error or does not fit.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "motion_script.h"
+#include "motion_planner.h"
+#include "trajectory_format.h"
+#include "segment_ring.h"
+
+#define COMPILER_MAX_TEXT 65536          // Largest script file, the target limit of run_script does not apply
+#define COMPILER_TICK_HZ 10000000        // Same as TIMER_PULSE_ENGINE_TICK_HZ on the target
+#define COMPILER_MAX_FREQUENCY_HZ 125000 // Same as TIMER_PULSE_ENGINE_MAX_FREQUENCY_HZ on the target
+#define COMPILER_ACCELERATION 100000     // Same as MOTION_DEFAULT_ACCELERATION on the target
+#define COMPILER_JERK 0                  // Same as MOTION_DEFAULT_JERK on the target
+#define COMPILER_SEGMENT_TIME_US 10000   // Same as MOTION_SEGMENT_TIME_US at 100 Hz ticks
+#define COMPILER_REFILL_US 20000         // Two RTOS ticks, the engine refills its ring once per tick
+#define COMPILER_IMAGE_SIZE 0xC0000      // Size of the trajectory partition, see partitions.csv
+
+/** Planned totals, compared with the decoded file */
+typedef struct
+{
+    int64_t Position;     // Position reached, relative to the start
+    uint64_t Moved_Steps; // Steps of all moves
+    uint32_t Moves;       // Moves planned
+} Compiler_Totals_t;
+
+/**
+ * @brief Plan one move and append its segments.
+ *
+ * @return false if the move cannot be planned or the image is full.
+ */
+static bool Add_Move(Trajectory_Writer_t *Writer, const Motion_Planner_Config_t *Config, int64_t Distance, Compiler_Totals_t *Totals)
+{
+    static Motion_Profile_t Profile;
+    uint64_t Left = (Distance > 0) ? (uint64_t)Distance : (uint64_t)(-Distance);
+
+    while (Left > 0)
+    {
+        uint32_t Steps = (Left > UINT32_MAX) ? UINT32_MAX : (uint32_t)Left; // A move_to across the whole range needs two
+
+        if (!Motion_Planner_Plan_Move(Config, Steps, &Profile))
+        {
+            return false;
+        }
+
+        for (uint16_t Index = 0; Index < Profile.Segment_Count; Index++)
+        {
+            if (!Trajectory_Add_Steps(Writer, Distance > 0, Profile.Segments[Index].Frequency_Hz, Profile.Segments[Index].Steps))
+            {
+                return false;
+            }
+        }
+
+        Totals->Moved_Steps += Profile.Total_Steps;
+        Totals->Moves++;
+        Left -= Steps;
+    }
+
+    Totals->Position += Distance;
+
+    return true;
+}
+
+/**
+ * @brief Execute the bytecode once, like Execute_Script() of the target, into the writer.
+ *
+ * @return NULL if successful, else what went wrong.
+ */
+static const char *Compile_Script(const Motion_Script_t *Script, Motion_Planner_Config_t Config, Trajectory_Writer_t *Writer, Compiler_Totals_t *Totals)
+{
+    uint32_t Remaining[MOTION_SCRIPT_MAX_DEPTH]; // Repetitions left of every open loop
+    uint8_t Depth = 0;
+    uint16_t Next = 0;
+
+    Config.Max_Frequency_Hz = MOTION_SCRIPT_DEFAULT_SPEED_HZ;
+
+    while (Next < Script->Op_Count)
+    {
+        const Motion_Script_Op_t *Op = &Script->Ops[Next++];
+        bool Added = true;
+
+        switch (Op->Opcode)
+        {
+        case MOTION_SCRIPT_OP_SPEED:
+            Config.Max_Frequency_Hz = (uint32_t)Op->Argument;
+            break;
+
+        case MOTION_SCRIPT_OP_MOVE:
+            Added = Add_Move(Writer, &Config, Op->Argument, Totals);
+            break;
+
+        case MOTION_SCRIPT_OP_MOVE_TO:
+            Added = Add_Move(Writer, &Config, Op->Argument - Totals->Position, Totals);
+            break;
+
+        case MOTION_SCRIPT_OP_DWELL:
+            Added = Trajectory_Add_Pause(Writer, (uint32_t)Op->Argument * 1000);
+            break;
+
+        case MOTION_SCRIPT_OP_LOOP:
+            Remaining[Depth++] = (uint32_t)Op->Argument; // Nesting checked by the compiler
+            break;
+
+        case MOTION_SCRIPT_OP_END:
+            if (--Remaining[Depth - 1] > 0)
+            {
+                Next = (uint16_t)Op->Argument; // Body again
+            }
+            else
+            {
+                Depth--;
+            }
+            break;
+
+        default:
+            return "unknown operation";
+        }
+
+        if (!Added)
+        {
+            return Writer->Overflow ? "trajectory larger than the image" : "move cannot be planned";
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Decode the image like the target and compare it with the planned totals.
+ *
+ * Also warns about runs of short records the timer pulse engine may not keep up with.
+ *
+ * @return false if the image does not decode to the planned trajectory, or is faster than the engine.
+ */
+static bool Verify_Image(const void *Image, size_t Size, const Compiler_Totals_t *Totals, bool List)
+{
+    Trajectory_View_t View;
+    Trajectory_Segment_t Segment;
+    Trajectory_Result_t Result = Trajectory_Open(Image, Size, &View);
+    uint64_t Window_Q8[SEGMENT_RING_SIZE] = {0}; // Durations of the last records in Q8 ticks, without pauses
+    uint64_t Window_Sum_Q8 = 0;
+    uint32_t Window_Count = 0;
+    uint32_t Short_Runs = 0;
+    uint64_t Peak_Frequency_Hz = 0;
+    int64_t Position = 0;
+    bool Forward = true;
+
+    if (Result != TRAJECTORY_OK)
+    {
+        fprintf(stderr, "decoded image: %s\n", Trajectory_Result_Name(Result));
+        return false;
+    }
+
+    for (uint32_t Index = 0; Index < View.Header->Record_Count; Index++)
+    {
+        Trajectory_Decode(&View, Index, &Segment);
+
+        if (List)
+        {
+            if (Segment.Pause)
+            {
+                printf("  %7" PRIu32 " pause %" PRIu32 " us\n", Index, Segment.Pause_us);
+            }
+            else
+            {
+                printf("  %7" PRIu32 " %c%-10" PRIu32 " at %.1f Hz\n", Index, Segment.Forward ? '+' : '-', Segment.Steps, ((double)COMPILER_TICK_HZ * 65536.0) / Segment.Period_Q16);
+            }
+        }
+
+        if (Segment.Pause || (Segment.Forward != Forward))
+        {
+            memset(Window_Q8, 0, sizeof(Window_Q8)); // The ring is filled again before the next run starts
+            Window_Sum_Q8 = 0;
+            Window_Count = 0;
+            Forward = Segment.Forward;
+        }
+
+        if (Segment.Pause)
+        {
+            continue;
+        }
+
+        uint64_t Duration_Q8 = (Segment.Period_Q16 >> 8) * Segment.Steps;
+        uint64_t Frequency_Hz = ((uint64_t)COMPILER_TICK_HZ << 16) / Segment.Period_Q16;
+
+        Peak_Frequency_Hz = (Frequency_Hz > Peak_Frequency_Hz) ? Frequency_Hz : Peak_Frequency_Hz;
+        Position += Segment.Forward ? (int64_t)Segment.Steps : -(int64_t)Segment.Steps;
+
+        Window_Sum_Q8 += Duration_Q8 - Window_Q8[Window_Count % SEGMENT_RING_SIZE];
+        Window_Q8[Window_Count % SEGMENT_RING_SIZE] = Duration_Q8;
+        Window_Count++;
+
+        if ((Window_Count >= SEGMENT_RING_SIZE) && ((Window_Sum_Q8 >> 8) < ((uint64_t)COMPILER_TICK_HZ / (1000000 / COMPILER_REFILL_US))))
+        {
+            if (Short_Runs++ == 0)
+            {
+                fprintf(stderr, "warning: records %" PRIu32 " to %" PRIu32 " last less than %d us, the pulse engine may run out of segments\n",
+                        Index + 1 - SEGMENT_RING_SIZE, Index, COMPILER_REFILL_US);
+            }
+        }
+    }
+
+    if (Short_Runs > 1)
+    {
+        fprintf(stderr, "warning: %" PRIu32 " more windows of short records\n", Short_Runs - 1);
+    }
+
+    if (Peak_Frequency_Hz > COMPILER_MAX_FREQUENCY_HZ)
+    {
+        fprintf(stderr, "decoded image: %" PRIu64 " Hz is above the %d Hz of the timer pulse engine\n", Peak_Frequency_Hz, COMPILER_MAX_FREQUENCY_HZ);
+        return false;
+    }
+
+    if ((View.Header->Total_Steps != Totals->Moved_Steps) || (Position != Totals->Position))
+    {
+        fprintf(stderr, "decoded image: %" PRIu32 " steps to %" PRId64 ", planned %" PRIu64 " steps to %" PRId64 "\n",
+                View.Header->Total_Steps, Position, Totals->Moved_Steps, Totals->Position);
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    static char Text[COMPILER_MAX_TEXT + 1];
+    static Motion_Script_t Script;
+    Motion_Script_Error_t Error;
+    Trajectory_Writer_t Writer;
+    Compiler_Totals_t Totals = {0};
+    Motion_Planner_Config_t Config = {
+        .Acceleration = COMPILER_ACCELERATION,
+        .Jerk = COMPILER_JERK,
+        .Segment_Time_us = COMPILER_SEGMENT_TIME_US,
+    };
+    size_t Image_Size = COMPILER_IMAGE_SIZE;
+    bool List = false;
+    int Index = 1;
+
+    while ((Index < argc) && (strncmp(argv[Index], "--", 2) == 0))
+    {
+        if (strcmp(argv[Index], "--list") == 0)
+        {
+            List = true;
+            Index++;
+            continue;
+        }
+
+        if (Index + 1 >= argc)
+        {
+            break;
+        }
+
+        unsigned long Value = strtoul(argv[Index + 1], NULL, 0);
+
+        if (strcmp(argv[Index], "--accel") == 0)
+        {
+            Config.Acceleration = (uint32_t)Value;
+        }
+        else if (strcmp(argv[Index], "--jerk") == 0)
+        {
+            Config.Jerk = (uint32_t)Value;
+        }
+        else if (strcmp(argv[Index], "--segment-us") == 0)
+        {
+            Config.Segment_Time_us = (uint32_t)Value;
+        }
+        else if (strcmp(argv[Index], "--size") == 0)
+        {
+            Image_Size = (size_t)Value;
+        }
+        else
+        {
+            break;
+        }
+
+        Index += 2;
+    }
+
+    if ((Index + 2 != argc) || (Config.Acceleration == 0) || (Config.Segment_Time_us == 0))
+    {
+        fprintf(stderr, "Usage: %s [--accel n] [--jerk n] [--segment-us n] [--size bytes] [--list] script output\n", argv[0]);
+        return 2;
+    }
+
+    const char *Script_Path = argv[Index];
+    const char *Output_Path = argv[Index + 1];
+    FILE *File = fopen(Script_Path, "rb");
+
+    if (File == NULL)
+    {
+        fprintf(stderr, "%s: cannot read\n", Script_Path);
+        return 1;
+    }
+
+    size_t Length = fread(Text, 1, sizeof(Text), File);
+
+    fclose(File);
+
+    if (Length > COMPILER_MAX_TEXT)
+    {
+        fprintf(stderr, "%s: larger than %d bytes\n", Script_Path, COMPILER_MAX_TEXT);
+        return 1;
+    }
+
+    if (!Motion_Script_Compile(Text, Length, &Script, &Error))
+    {
+        fprintf(stderr, "%s:%" PRIu32 ": %s\n", Script_Path, Error.Line, Error.Message);
+        return 1;
+    }
+
+    uint32_t *Image = calloc(1, Image_Size + sizeof(uint32_t)); // Word aligned like the mapped partition
+
+    if (Image == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    Trajectory_Begin(&Writer, Image, Image_Size, COMPILER_TICK_HZ);
+
+    const char *Message = Compile_Script(&Script, Config, &Writer, &Totals);
+    size_t Size = (Message == NULL) ? Trajectory_Finish(&Writer) : 0;
+
+    if ((Message == NULL) && (Size == 0))
+    {
+        Message = "totals do not fit the header";
+    }
+
+    if (Message != NULL)
+    {
+        fprintf(stderr, "%s: %s\n", Script_Path, Message);
+        free(Image);
+        return 1;
+    }
+
+    bool Verified = Verify_Image(Image, Size, &Totals, List);
+
+    File = Verified ? fopen(Output_Path, "wb") : NULL;
+
+    if (Verified && ((File == NULL) || (fwrite(Image, 1, Size, File) != Size) || (fclose(File) != 0)))
+    {
+        fprintf(stderr, "%s: cannot write\n", Output_Path);
+        Verified = false;
+    }
+
+    if (Verified)
+    {
+        printf("%s: %" PRIu32 " moves, %" PRIu32 " records, %zu of %zu bytes, %" PRIu32 " steps to %" PRId64 ", %" PRIu32 " ms\n", Output_Path, Totals.Moves,
+               Writer.Header.Record_Count, Size, Image_Size, Writer.Header.Total_Steps, Totals.Position, Writer.Header.Duration_ms);
+    }
+
+    free(Image);
+
+    return Verified ? 0 : 1;
+}
@@ -0,0 +1,484 @@
+/*H**********************************************************************
+ * FILENAME :        binary_link.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Binary command link of the stepper motor example.
+ *
+ * NOTES :
+ *       A batch is queued record by record without waiting. If the motion
+ *       queue fills up the ack reports how many records were accepted, and
+ *       the host resends the rest.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "binary_link.h"
+#include "motion_queue.h"
+#include "main.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+
+#define TELEMETRY_FRAME_SIZE (PROTOCOL_HEADER_SIZE + PROTOCOL_TELEMETRY_SIZE + PROTOCOL_CRC_SIZE) // Encoded telemetry frame
+
+/** Counters of the previous telemetry sample, the rates are taken over the period since */
+typedef struct
+{
+    int64_t Time_us;        // esp_timer_get_time() of the sample
+    uint32_t Steps_Emitted; // Get_Stepper_Motor_Emitted_Steps() of the sample
+    uint64_t Busy_us;       // Motion_Queue_Status_t.Busy_us of the sample
+} Telemetry_Baseline_t;
+
+static Protocol_Decoder_t Link_Decoder;                    // Decoder of the received byte stream
+static Protocol_Frame_t Link_Frame;                        // Last decoded request
+static uint8_t Link_Tx_Buffer[PROTOCOL_MAX_FRAME];         // Encoded reply
+static uint8_t Telemetry_Payload[PROTOCOL_TELEMETRY_SIZE]; // Packed telemetry sample, only used by the telemetry task
+static uint8_t Telemetry_Tx_Buffer[TELEMETRY_FRAME_SIZE];  // Encoded telemetry frame, only used by the telemetry task
+static volatile uint32_t Telemetry_Period_ms = 0;          // Period of the telemetry frames, 0 while off
+static volatile uint32_t Telemetry_Frames = 0;             // Telemetry frames sent since boot, its low byte is the frame sequence
+static TaskHandle_t Telemetry_Task_Handle = NULL;          // Telemetry task, woken when the telemetry is switched on
+
+/**
+ * @brief Encode and send one reply frame.
+ */
+static void Send_Reply(uint8_t Opcode, uint8_t Sequence, const uint8_t *Payload, uint16_t Length)
+{
+    size_t Size = Protocol_Encode_Frame(Opcode, Sequence, Payload, Length, Link_Tx_Buffer, sizeof(Link_Tx_Buffer));
+
+    uart_write_bytes(BINARY_LINK_UART, (const char *)Link_Tx_Buffer, Size);
+}
+
+/**
+ * @brief Send the ack of a request.
+ */
+static void Send_Ack(uint8_t Sequence, Protocol_Result_t Result, uint8_t Accepted)
+{
+    uint8_t Payload[PROTOCOL_ACK_SIZE];
+    Protocol_Ack_t Ack = {
+        .Sequence = Sequence, // Request being answered
+        .Result = Result,     // Outcome of the request
+        .Accepted = Accepted, // Records queued
+    };
+
+    Protocol_Pack_Ack(&Ack, Payload);
+    Send_Reply(PROTOCOL_OP_ACK, Sequence, Payload, sizeof(Payload));
+}
+
+/**
+ * @brief Send the motion queue state.
+ */
+static void Send_Status(uint8_t Sequence)
+{
+    uint8_t Payload[PROTOCOL_STATUS_SIZE];
+    Motion_Queue_Status_t Queue_Status;
+
+    Motion_Queue_Get_Status(&Queue_Status);
+
+    Protocol_Status_t Status = {
+        .Pending = Queue_Status.Pending,                                                                 // Commands waiting
+        .Current_Id = Queue_Status.Current_Id,                                                           // Command being executed
+        .Completed = Queue_Status.Completed,                                                             // Commands finished
+        .Last_Executed_Steps = Queue_Status.Last_Executed_Steps,                                         // Steps of the last move
+        .Busy = Queue_Status.Busy,                                                                       // Executing a command
+        .Running = Queue_Status.Running,                                                                 // Running continuously
+        .Last_Result = (Queue_Status.Last_Error == ESP_OK) ? PROTOCOL_RESULT_OK : PROTOCOL_RESULT_ERROR, // Result of the last command
+    };
+
+    Protocol_Pack_Status(&Status, Payload);
+    Send_Reply(PROTOCOL_OP_STATUS_REPLY, Sequence, Payload, sizeof(Payload));
+}
+
+/**
+ * @brief Take one telemetry sample.
+ *
+ * The step rate and the motion load are averaged over the time since the
+ * baseline, which then moves to this sample.
+ *
+ * @param Telemetry Output sample.
+ * @param Baseline Previous sample, updated.
+ */
+static void Sample_Telemetry(Protocol_Telemetry_t *Telemetry, Telemetry_Baseline_t *Baseline)
+{
+    Motion_Queue_Status_t Queue_Status;
+
+    Motion_Queue_Get_Status(&Queue_Status);
+
+    int64_t Time_us = esp_timer_get_time();
+    uint32_t Steps_Emitted = Get_Stepper_Motor_Emitted_Steps();
+    uint64_t Elapsed_us = (Time_us > Baseline->Time_us) ? (uint64_t)(Time_us - Baseline->Time_us) : 1;
+    uint64_t Load = ((Queue_Status.Busy_us - Baseline->Busy_us) * 1000) / Elapsed_us;
+
+    Telemetry->Uptime_ms = (uint32_t)(Time_us / 1000);
+    Telemetry->Step_Rate_Hz = (uint32_t)(((uint64_t)(Steps_Emitted - Baseline->Steps_Emitted) * 1000000) / Elapsed_us);
+    Telemetry->Position = Get_Stepper_Motor_Position();
+    Telemetry->Queue_Depth = Queue_Status.Pending;
+    Telemetry->Steps_Emitted = Steps_Emitted;
+    Telemetry->Missed_Deadlines = Queue_Status.Missed_Deadlines;
+    Telemetry->Motion_Busy_ms = (uint32_t)(Queue_Status.Busy_us / 1000);
+    Telemetry->Free_Heap = esp_get_free_heap_size();
+    Telemetry->Min_Free_Heap = esp_get_minimum_free_heap_size();
+    Telemetry->Motion_Load = (uint16_t)((Load > 1000) ? 1000 : Load); // The busy time includes the command still running
+    Telemetry->Flags = (Queue_Status.Busy ? PROTOCOL_TELEMETRY_BUSY : 0) |
+                       (Queue_Status.Running ? PROTOCOL_TELEMETRY_RUNNING : 0) |
+                       (Queue_Status.Jogging ? PROTOCOL_TELEMETRY_JOGGING : 0) |
+                       (Stepper_Motor_Position_Referenced() ? PROTOCOL_TELEMETRY_REFERENCED : 0);
+
+    Baseline->Time_us = Time_us;
+    Baseline->Steps_Emitted = Steps_Emitted;
+    Baseline->Busy_us = Queue_Status.Busy_us;
+}
+
+/**
+ * @brief Telemetry task, sends one telemetry frame every period.
+ *
+ * Sleeps while the telemetry is off. The frame is packed and encoded in
+ * static buffers, sending it does not allocate.
+ */
+static void Telemetry_Task(void *arg)
+{
+    Telemetry_Baseline_t Baseline = {0};
+    Protocol_Telemetry_t Telemetry;
+    TickType_t Last_Wake = xTaskGetTickCount();
+
+    while (true)
+    {
+        uint32_t Period_ms = Telemetry_Period_ms;
+
+        if (Period_ms == 0)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Woken by Binary_Link_Set_Telemetry_Period()
+
+            Sample_Telemetry(&Telemetry, &Baseline); // The first rates cover the first period only
+            Last_Wake = xTaskGetTickCount();
+
+            continue;
+        }
+
+        vTaskDelayUntil(&Last_Wake, pdMS_TO_TICKS(Period_ms));
+
+        if (Telemetry_Period_ms == 0)
+        {
+            continue; // Switched off while waiting
+        }
+
+        Sample_Telemetry(&Telemetry, &Baseline);
+        Protocol_Pack_Telemetry(&Telemetry, Telemetry_Payload);
+
+        size_t Size = Protocol_Encode_Frame(PROTOCOL_OP_TELEMETRY_FRAME, (uint8_t)Telemetry_Frames, Telemetry_Payload, sizeof(Telemetry_Payload), Telemetry_Tx_Buffer, sizeof(Telemetry_Tx_Buffer));
+
+        uart_write_bytes(BINARY_LINK_UART, (const char *)Telemetry_Tx_Buffer, Size); // Whole frames, the driver serializes the writers
+
+        Telemetry_Frames++;
+    }
+}
+
+/**
+ * @brief Queue every record of a batch frame.
+ *
+ * @param Frame Request holding the records.
+ * @param Record_Size Encoded size of one record.
+ * @param Accepted Returns the number of records queued.
+ * @return Result for the ack.
+ */
+static Protocol_Result_t Queue_Batch(const Protocol_Frame_t *Frame, size_t Record_Size, uint8_t *Accepted)
+{
+    *Accepted = 0;
+
+    if ((Frame->Length == 0) || ((Frame->Length % Record_Size) != 0) || ((Frame->Length / Record_Size) > UINT8_MAX))
+    {
+        return PROTOCOL_RESULT_BAD_PAYLOAD;
+    }
+
+    for (size_t Offset = 0; Offset < Frame->Length; Offset += Record_Size)
+    {
+        Motion_Command_t Command = {0};
+
+        if (Frame->Opcode == PROTOCOL_OP_MOVE)
+        {
+            Protocol_Move_t Move;
+
+            Protocol_Unpack_Move(&Frame->Payload[Offset], &Move);
+
+            Command.Type = MOTION_COMMAND_MOVE;
+            Command.Frequency_Hz = Move.Frequency_Hz;
+            Command.Steps = Move.Steps;
+            Command.Direction = Move.Direction ? MOTOR_DIRECTION_FORWARD : MOTOR_DIRECTION_BACKWARD;
+        }
+        else
+        {
+            Protocol_Linear_t Linear;
+
+            Protocol_Unpack_Linear(&Frame->Payload[Offset], &Linear);
+
+            Command.Type = MOTION_COMMAND_LINEAR;
+            Command.Frequency_Hz = Linear.Frequency_Hz;
+
+            for (uint8_t Axis = 0; Axis < PROTOCOL_LINEAR_AXES; Axis++)
+            {
+                Command.Axis_Steps[Axis] = Linear.Steps[Axis];
+            }
+        }
+
+        if (Motion_Queue_Enqueue_Wait(&Command, 0) != ESP_OK) // Never block the link on a full queue
+        {
+            return PROTOCOL_RESULT_QUEUE_FULL;
+        }
+
+        (*Accepted)++;
+    }
+
+    return PROTOCOL_RESULT_OK;
+}
+
+/**
+ * @brief Execute one decoded request and answer it.
+ */
+static void Handle_Frame(const Protocol_Frame_t *Frame)
+{
+    Protocol_Result_t Result = PROTOCOL_RESULT_OK;
+    uint8_t Accepted = 0;
+    Motion_Command_t Command = {0};
+
+    switch (Frame->Opcode)
+    {
+    case PROTOCOL_OP_PING:
+        break;
+
+    case PROTOCOL_OP_MOVE:
+        Result = Queue_Batch(Frame, PROTOCOL_MOVE_RECORD_SIZE, &Accepted);
+        break;
+
+    case PROTOCOL_OP_LINEAR:
+        Result = Queue_Batch(Frame, PROTOCOL_LINEAR_RECORD_SIZE, &Accepted);
+        break;
+
+    case PROTOCOL_OP_RUN:
+    {
+        Protocol_Run_t Run;
+
+        if (Frame->Length != PROTOCOL_RUN_RECORD_SIZE)
+        {
+            Result = PROTOCOL_RESULT_BAD_PAYLOAD;
+            break;
+        }
+
+        Protocol_Unpack_Run(Frame->Payload, &Run);
+
+        Command.Type = MOTION_COMMAND_RUN;
+        Command.Frequency_Hz = Run.Frequency_Hz;
+        Command.Duty_Cycle = Run.Duty_Cycle;
+        Command.Direction = Run.Direction ? MOTOR_DIRECTION_FORWARD : MOTOR_DIRECTION_BACKWARD;
+
+        Result = (Motion_Queue_Enqueue_Wait(&Command, 0) == ESP_OK) ? PROTOCOL_RESULT_OK : PROTOCOL_RESULT_QUEUE_FULL;
+        Accepted = (Result == PROTOCOL_RESULT_OK) ? 1 : 0;
+        break;
+    }
+
+    case PROTOCOL_OP_JOG:
+    {
+        Protocol_Jog_t Jog;
+
+        if (Frame->Length != PROTOCOL_JOG_RECORD_SIZE)
+        {
+            Result = PROTOCOL_RESULT_BAD_PAYLOAD;
+            break;
+        }
+
+        Protocol_Unpack_Jog(Frame->Payload, &Jog);
+
+        switch (Motion_Queue_Jog(Jog.Velocity_Hz))
+        {
+        case ESP_OK:
+            Result = PROTOCOL_RESULT_OK;
+            break;
+
+        case ESP_ERR_TIMEOUT:
+            Result = PROTOCOL_RESULT_QUEUE_FULL;
+            break;
+
+        default:
+            Result = PROTOCOL_RESULT_ERROR; // Velocity out of range
+            break;
+        }
+
+        Accepted = (Result == PROTOCOL_RESULT_OK) ? 1 : 0;
+        break;
+    }
+
+    case PROTOCOL_OP_STOP:
+        Command.Type = MOTION_COMMAND_STOP;
+
+        Result = (Motion_Queue_Enqueue_Wait(&Command, 0) == ESP_OK) ? PROTOCOL_RESULT_OK : PROTOCOL_RESULT_QUEUE_FULL;
+        break;
+
+    case PROTOCOL_OP_ABORT:
+        Result = (Motion_Queue_Abort() == ESP_OK) ? PROTOCOL_RESULT_OK : PROTOCOL_RESULT_ERROR;
+        break;
+
+    case PROTOCOL_OP_HALT:
+        if (Frame->Length != 1)
+        {
+            Result = PROTOCOL_RESULT_BAD_PAYLOAD;
+            break;
+        }
+
+        Result = (Motion_Queue_Stop(Frame->Payload[0] != 0) == ESP_OK) ? PROTOCOL_RESULT_OK : PROTOCOL_RESULT_ERROR;
+        break;
+
+    case PROTOCOL_OP_FLUSH:
+        Result = (Motion_Queue_Flush() == ESP_OK) ? PROTOCOL_RESULT_OK : PROTOCOL_RESULT_ERROR;
+        break;
+
+    case PROTOCOL_OP_STATUS:
+        Send_Status(Frame->Sequence);
+        return;
+
+    case PROTOCOL_OP_TELEMETRY:
+        if (Frame->Length != 2)
+        {
+            Result = PROTOCOL_RESULT_BAD_PAYLOAD;
+            break;
+        }
+
+        Result = (Binary_Link_Set_Telemetry_Period(Frame->Payload[0] | (Frame->Payload[1] << 8)) == ESP_OK) ? PROTOCOL_RESULT_OK : PROTOCOL_RESULT_ERROR;
+        break;
+
+    default:
+        Result = PROTOCOL_RESULT_BAD_OPCODE;
+        break;
+    }
+
+    Send_Ack(Frame->Sequence, Result, Accepted);
+}
+
+/**
+ * @brief Link task, decodes the received bytes and executes the requests.
+ */
+static void Binary_Link_Task(void *arg)
+{
+    uint8_t Buffer[BINARY_LINK_READ_SIZE];
+
+    while (true)
+    {
+        int Count = uart_read_bytes(BINARY_LINK_UART, Buffer, sizeof(Buffer), portMAX_DELAY);
+
+        for (int Index = 0; Index < Count; Index++)
+        {
+            switch (Protocol_Decoder_Feed(&Link_Decoder, Buffer[Index], &Link_Frame))
+            {
+            case PROTOCOL_DECODE_FRAME:
+                Handle_Frame(&Link_Frame);
+                break;
+
+            case PROTOCOL_DECODE_BAD_CRC:
+                Send_Ack(Link_Frame.Sequence, PROTOCOL_RESULT_BAD_CRC, 0); // Host resends the frame
+                break;
+
+            case PROTOCOL_DECODE_TOO_LONG:
+            case PROTOCOL_DECODE_PENDING:
+            default:
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Initialize the UART of the binary link and start the link task.
+ *
+ * @return
+ *     - Sum of all ESP return values, ESP_ERR_NO_MEM if the task could not be created
+ */
+esp_err_t Initialize_Binary_Link(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    const uart_config_t uart_config = {
+        .baud_rate = BINARY_LINK_BAUDRATE,     // Set the baud rate
+        .data_bits = UART_DATA_8_BITS,         // Set data bits to 8
+        .parity = UART_PARITY_DISABLE,         // Disable parity, frames carry a CRC
+        .stop_bits = UART_STOP_BITS_1,         // Set stop bits to 1
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE, // No hardware flow control, acks pace the host
+        .source_clk = UART_SCLK_APB,           // Set the UART clock source to APB
+    };
+
+    Protocol_Decoder_Reset(&Link_Decoder);
+
+    Function_Error += uart_driver_install(BINARY_LINK_UART, BINARY_LINK_RX_BUFFER_SIZE, 0, 0, NULL, 0);
+    Function_Error += uart_param_config(BINARY_LINK_UART, &uart_config);
+    Function_Error += uart_set_pin(BINARY_LINK_UART, BINARY_LINK_TX_PIN, BINARY_LINK_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    if (xTaskCreate(Binary_Link_Task, "binary_link", BINARY_LINK_TASK_STACK_SIZE, NULL, BINARY_LINK_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreate(Telemetry_Task, "telemetry", BINARY_LINK_TELEMETRY_STACK_SIZE, NULL, BINARY_LINK_TELEMETRY_PRIORITY, &Telemetry_Task_Handle) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Change the baud rate of the binary link.
+ *
+ * @param Baudrate New baud rate.
+ * @return Result of uart_set_baudrate().
+ */
+esp_err_t Binary_Link_Set_Baudrate(uint32_t Baudrate)
+{
+    return uart_set_baudrate(BINARY_LINK_UART, Baudrate);
+}
+
+/**
+ * @brief Set the period of the telemetry frames.
+ *
+ * @param Period_ms Period from BINARY_LINK_TELEMETRY_MIN_PERIOD_MS to BINARY_LINK_TELEMETRY_MAX_PERIOD_MS, 0 switches the telemetry off.
+ * @return
+ *     - ESP_OK: Period set
+ *     - ESP_ERR_INVALID_ARG: Period out of range
+ *     - ESP_ERR_INVALID_STATE: Binary link not initialized
+ */
+esp_err_t Binary_Link_Set_Telemetry_Period(uint32_t Period_ms)
+{
+    if ((Period_ms != 0) && ((Period_ms < BINARY_LINK_TELEMETRY_MIN_PERIOD_MS) || (Period_ms > BINARY_LINK_TELEMETRY_MAX_PERIOD_MS)))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (Telemetry_Task_Handle == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    Telemetry_Period_ms = Period_ms;
+
+    xTaskNotifyGive(Telemetry_Task_Handle); // Starts a sleeping telemetry task, ignored by a running one
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Get the period of the telemetry frames, 0 while off.
+ */
+uint32_t Binary_Link_Get_Telemetry_Period(void)
+{
+    return Telemetry_Period_ms;
+}
+
+/**
+ * @brief Get the number of telemetry frames sent since boot.
+ */
+uint32_t Binary_Link_Get_Telemetry_Frames(void)
+{
+    return Telemetry_Frames;
+}
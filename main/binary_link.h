@@ -0,0 +1,49 @@
+/*H**********************************************************************
+ * FILENAME :        binary_link.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Binary command link of the stepper motor example.
+ *
+ * NOTES :
+ *       Runs the framed protocol of binary_protocol.h on its own UART next
+ *       to the text console. Every request is answered with a binary ack,
+ *       batches of moves are queued to the motion queue in one frame.
+ *
+ *       Telemetry is off at start-up. Once a period is set, with the
+ *       telemetry command or PROTOCOL_OP_TELEMETRY, a telemetry frame is
+ *       sent unasked every period, see host/telemetry_decode.c.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef BINARY_LINK_H
+#define BINARY_LINK_H
+
+#include <stdint.h>
+#include "driver/uart.h"
+#include "driver/gpio.h"
+#include "binary_protocol.h"
+
+#define BINARY_LINK_UART UART_NUM_1      // UART of the binary link, the console keeps UART 0
+#define BINARY_LINK_TX_PIN GPIO_NUM_26   // TX pin of the binary link
+#define BINARY_LINK_RX_PIN GPIO_NUM_27   // RX pin of the binary link
+#define BINARY_LINK_BAUDRATE 921600      // Default baud rate, changed at run time with link_baud
+#define BINARY_LINK_RX_BUFFER_SIZE 4096  // UART driver receive buffer in bytes
+#define BINARY_LINK_READ_SIZE 128        // Bytes read from the driver at once
+#define BINARY_LINK_TASK_STACK_SIZE 4096 // Stack size of the link task in bytes
+#define BINARY_LINK_TASK_PRIORITY 9      // Below the motion task, above the console task
+#define BINARY_LINK_TELEMETRY_MIN_PERIOD_MS 10    // Shortest telemetry period, one RTOS tick
+#define BINARY_LINK_TELEMETRY_MAX_PERIOD_MS 60000 // Longest telemetry period
+#define BINARY_LINK_TELEMETRY_STACK_SIZE 2048     // Stack size of the telemetry task in bytes
+#define BINARY_LINK_TELEMETRY_PRIORITY 2          // Above the console task, below everything that moves the motor
+
+esp_err_t Initialize_Binary_Link(void);
+esp_err_t Binary_Link_Set_Baudrate(uint32_t Baudrate);
+esp_err_t Binary_Link_Set_Telemetry_Period(uint32_t Period_ms);
+uint32_t Binary_Link_Get_Telemetry_Period(void);
+uint32_t Binary_Link_Get_Telemetry_Frames(void);
+
+#endif // BINARY_LINK_H
@@ -0,0 +1,451 @@
+/*H**********************************************************************
+ * FILENAME :        binary_protocol.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent encoder and decoder of the binary command
+ *       protocol of the stepper motor example.
+ *
+ * NOTES :
+ *       Records are packed field by field in little endian order, so the
+ *       encoding does not depend on the struct layout of either side.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "binary_protocol.h"
+
+/**
+ * @brief Store a 16 bit value little endian.
+ */
+static void Put_U16(uint8_t *Output, uint16_t Value)
+{
+    Output[0] = (uint8_t)Value;
+    Output[1] = (uint8_t)(Value >> 8);
+}
+
+/**
+ * @brief Store a 32 bit value little endian.
+ */
+static void Put_U32(uint8_t *Output, uint32_t Value)
+{
+    Output[0] = (uint8_t)Value;
+    Output[1] = (uint8_t)(Value >> 8);
+    Output[2] = (uint8_t)(Value >> 16);
+    Output[3] = (uint8_t)(Value >> 24);
+}
+
+/**
+ * @brief Load a 16 bit little endian value.
+ */
+static uint16_t Get_U16(const uint8_t *Input)
+{
+    return (uint16_t)(Input[0] | (Input[1] << 8));
+}
+
+/**
+ * @brief Load a 32 bit little endian value.
+ */
+static uint32_t Get_U32(const uint8_t *Input)
+{
+    return (uint32_t)Input[0] | ((uint32_t)Input[1] << 8) | ((uint32_t)Input[2] << 16) | ((uint32_t)Input[3] << 24);
+}
+
+/**
+ * @brief Update a CRC-16/CCITT with more data.
+ *
+ * @param Crc CRC so far, 0xFFFF to start.
+ * @param Data Bytes to add.
+ * @param Size Number of bytes.
+ * @return Updated CRC.
+ */
+uint16_t Protocol_Crc16(uint16_t Crc, const uint8_t *Data, size_t Size)
+{
+    for (size_t Index = 0; Index < Size; Index++)
+    {
+        Crc ^= (uint16_t)(Data[Index] << 8);
+
+        for (uint8_t Bit = 0; Bit < 8; Bit++)
+        {
+            Crc = (Crc & 0x8000) ? (uint16_t)((Crc << 1) ^ 0x1021) : (uint16_t)(Crc << 1);
+        }
+    }
+
+    return Crc;
+}
+
+/**
+ * @brief Build a complete frame.
+ *
+ * @param Opcode Opcode of the frame.
+ * @param Sequence Sequence number of the frame.
+ * @param Payload Payload bytes, may be NULL if Length is 0.
+ * @param Length Payload size, at most PROTOCOL_MAX_PAYLOAD.
+ * @param Output Output buffer.
+ * @param Output_Size Size of the output buffer.
+ * @return Size of the frame, 0 if it does not fit.
+ */
+size_t Protocol_Encode_Frame(uint8_t Opcode, uint8_t Sequence, const uint8_t *Payload, uint16_t Length, uint8_t *Output, size_t Output_Size)
+{
+    size_t Frame_Size = PROTOCOL_HEADER_SIZE + Length + PROTOCOL_CRC_SIZE;
+
+    if ((Length > PROTOCOL_MAX_PAYLOAD) || (Frame_Size > Output_Size))
+    {
+        return 0;
+    }
+
+    Output[0] = PROTOCOL_SYNC_0;
+    Output[1] = PROTOCOL_SYNC_1;
+    Put_U16(&Output[2], Length);
+    Output[4] = Opcode;
+    Output[5] = Sequence;
+
+    if (Length > 0)
+    {
+        memcpy(&Output[PROTOCOL_HEADER_SIZE], Payload, Length);
+    }
+
+    uint16_t Crc = Protocol_Crc16(0xFFFF, &Output[2], PROTOCOL_HEADER_SIZE - 2 + Length); // Sync bytes are not covered
+
+    Put_U16(&Output[PROTOCOL_HEADER_SIZE + Length], Crc);
+
+    return Frame_Size;
+}
+
+/**
+ * @brief Reset the decoder to wait for the next sync bytes.
+ *
+ * @param Decoder Decoder state.
+ */
+void Protocol_Decoder_Reset(Protocol_Decoder_t *Decoder)
+{
+    memset(Decoder, 0, sizeof(*Decoder));
+}
+
+/**
+ * @brief Feed one received byte to the decoder.
+ *
+ * After a broken frame the decoder hunts for the next sync bytes, so a
+ * stream resynchronises on its own.
+ *
+ * @param Decoder Decoder state.
+ * @param Byte Received byte.
+ * @param Frame Receives the frame when PROTOCOL_DECODE_FRAME is returned.
+ *              For PROTOCOL_DECODE_BAD_CRC only Opcode and Sequence are valid.
+ * @return Decoding result.
+ */
+Protocol_Decode_Result_t Protocol_Decoder_Feed(Protocol_Decoder_t *Decoder, uint8_t Byte, Protocol_Frame_t *Frame)
+{
+    switch (Decoder->State)
+    {
+    case PROTOCOL_STATE_SYNC_0:
+        if (Byte == PROTOCOL_SYNC_0)
+        {
+            Decoder->State = PROTOCOL_STATE_SYNC_1;
+        }
+        break;
+
+    case PROTOCOL_STATE_SYNC_1:
+        if (Byte == PROTOCOL_SYNC_1)
+        {
+            Decoder->State = PROTOCOL_STATE_HEADER;
+            Decoder->Index = 0;
+        }
+        else if (Byte != PROTOCOL_SYNC_0)
+        {
+            Decoder->State = PROTOCOL_STATE_SYNC_0; // A repeated first sync byte keeps the hunt going
+        }
+        break;
+
+    case PROTOCOL_STATE_HEADER:
+        Decoder->Header[Decoder->Index++] = Byte;
+
+        if (Decoder->Index == sizeof(Decoder->Header))
+        {
+            Decoder->Frame.Length = Get_U16(&Decoder->Header[0]);
+            Decoder->Frame.Opcode = Decoder->Header[2];
+            Decoder->Frame.Sequence = Decoder->Header[3];
+            Decoder->Crc = Protocol_Crc16(0xFFFF, Decoder->Header, sizeof(Decoder->Header));
+            Decoder->Index = 0;
+
+            if (Decoder->Frame.Length > PROTOCOL_MAX_PAYLOAD)
+            {
+                Decoder->State = PROTOCOL_STATE_SYNC_0;
+                Decoder->Bad_Frames++;
+
+                return PROTOCOL_DECODE_TOO_LONG;
+            }
+
+            Decoder->State = (Decoder->Frame.Length > 0) ? PROTOCOL_STATE_PAYLOAD : PROTOCOL_STATE_CRC;
+        }
+        break;
+
+    case PROTOCOL_STATE_PAYLOAD:
+        Decoder->Frame.Payload[Decoder->Index++] = Byte;
+
+        if (Decoder->Index == Decoder->Frame.Length)
+        {
+            Decoder->Crc = Protocol_Crc16(Decoder->Crc, Decoder->Frame.Payload, Decoder->Frame.Length);
+            Decoder->State = PROTOCOL_STATE_CRC;
+            Decoder->Index = 0;
+        }
+        break;
+
+    case PROTOCOL_STATE_CRC:
+    default:
+        Decoder->Crc_Bytes[Decoder->Index++] = Byte;
+
+        if (Decoder->Index < PROTOCOL_CRC_SIZE)
+        {
+            break;
+        }
+
+        Decoder->State = PROTOCOL_STATE_SYNC_0;
+
+        if (Get_U16(Decoder->Crc_Bytes) != Decoder->Crc)
+        {
+            Frame->Opcode = Decoder->Frame.Opcode;
+            Frame->Sequence = Decoder->Frame.Sequence;
+            Frame->Length = 0;
+            Decoder->Bad_Frames++;
+
+            return PROTOCOL_DECODE_BAD_CRC;
+        }
+
+        Frame->Opcode = Decoder->Frame.Opcode;
+        Frame->Sequence = Decoder->Frame.Sequence;
+        Frame->Length = Decoder->Frame.Length;
+        memcpy(Frame->Payload, Decoder->Frame.Payload, Decoder->Frame.Length);
+
+        return PROTOCOL_DECODE_FRAME;
+    }
+
+    return PROTOCOL_DECODE_PENDING;
+}
+
+/**
+ * @brief Encode a move record.
+ *
+ * @return PROTOCOL_MOVE_RECORD_SIZE
+ */
+size_t Protocol_Pack_Move(const Protocol_Move_t *Move, uint8_t *Output)
+{
+    Put_U32(&Output[0], Move->Frequency_Hz);
+    Put_U32(&Output[4], Move->Steps);
+    Output[8] = Move->Direction;
+
+    return PROTOCOL_MOVE_RECORD_SIZE;
+}
+
+/**
+ * @brief Decode a move record.
+ *
+ * @return PROTOCOL_MOVE_RECORD_SIZE
+ */
+size_t Protocol_Unpack_Move(const uint8_t *Input, Protocol_Move_t *Move)
+{
+    Move->Frequency_Hz = Get_U32(&Input[0]);
+    Move->Steps = Get_U32(&Input[4]);
+    Move->Direction = Input[8];
+
+    return PROTOCOL_MOVE_RECORD_SIZE;
+}
+
+/**
+ * @brief Encode a linear move record.
+ *
+ * @return PROTOCOL_LINEAR_RECORD_SIZE
+ */
+size_t Protocol_Pack_Linear(const Protocol_Linear_t *Linear, uint8_t *Output)
+{
+    Put_U32(&Output[0], Linear->Frequency_Hz);
+
+    for (uint8_t Axis = 0; Axis < PROTOCOL_LINEAR_AXES; Axis++)
+    {
+        Put_U32(&Output[4 + (4 * Axis)], (uint32_t)Linear->Steps[Axis]);
+    }
+
+    return PROTOCOL_LINEAR_RECORD_SIZE;
+}
+
+/**
+ * @brief Decode a linear move record.
+ *
+ * @return PROTOCOL_LINEAR_RECORD_SIZE
+ */
+size_t Protocol_Unpack_Linear(const uint8_t *Input, Protocol_Linear_t *Linear)
+{
+    Linear->Frequency_Hz = Get_U32(&Input[0]);
+
+    for (uint8_t Axis = 0; Axis < PROTOCOL_LINEAR_AXES; Axis++)
+    {
+        Linear->Steps[Axis] = (int32_t)Get_U32(&Input[4 + (4 * Axis)]);
+    }
+
+    return PROTOCOL_LINEAR_RECORD_SIZE;
+}
+
+/**
+ * @brief Encode a run record.
+ *
+ * @return PROTOCOL_RUN_RECORD_SIZE
+ */
+size_t Protocol_Pack_Run(const Protocol_Run_t *Run, uint8_t *Output)
+{
+    Put_U32(&Output[0], Run->Frequency_Hz);
+    Put_U32(&Output[4], Run->Duty_Cycle);
+    Output[8] = Run->Direction;
+
+    return PROTOCOL_RUN_RECORD_SIZE;
+}
+
+/**
+ * @brief Decode a run record.
+ *
+ * @return PROTOCOL_RUN_RECORD_SIZE
+ */
+size_t Protocol_Unpack_Run(const uint8_t *Input, Protocol_Run_t *Run)
+{
+    Run->Frequency_Hz = Get_U32(&Input[0]);
+    Run->Duty_Cycle = Get_U32(&Input[4]);
+    Run->Direction = Input[8];
+
+    return PROTOCOL_RUN_RECORD_SIZE;
+}
+
+/**
+ * @brief Encode a jog record.
+ *
+ * @return PROTOCOL_JOG_RECORD_SIZE
+ */
+size_t Protocol_Pack_Jog(const Protocol_Jog_t *Jog, uint8_t *Output)
+{
+    Put_U32(&Output[0], (uint32_t)Jog->Velocity_Hz);
+
+    return PROTOCOL_JOG_RECORD_SIZE;
+}
+
+/**
+ * @brief Decode a jog record.
+ *
+ * @return PROTOCOL_JOG_RECORD_SIZE
+ */
+size_t Protocol_Unpack_Jog(const uint8_t *Input, Protocol_Jog_t *Jog)
+{
+    Jog->Velocity_Hz = (int32_t)Get_U32(&Input[0]);
+
+    return PROTOCOL_JOG_RECORD_SIZE;
+}
+
+/**
+ * @brief Encode an ack.
+ *
+ * @return PROTOCOL_ACK_SIZE
+ */
+size_t Protocol_Pack_Ack(const Protocol_Ack_t *Ack, uint8_t *Output)
+{
+    Output[0] = Ack->Sequence;
+    Output[1] = Ack->Result;
+    Output[2] = Ack->Accepted;
+    Output[3] = 0;
+
+    return PROTOCOL_ACK_SIZE;
+}
+
+/**
+ * @brief Decode an ack.
+ *
+ * @return PROTOCOL_ACK_SIZE
+ */
+size_t Protocol_Unpack_Ack(const uint8_t *Input, Protocol_Ack_t *Ack)
+{
+    Ack->Sequence = Input[0];
+    Ack->Result = Input[1];
+    Ack->Accepted = Input[2];
+    Ack->Reserved = Input[3];
+
+    return PROTOCOL_ACK_SIZE;
+}
+
+/**
+ * @brief Encode a status reply.
+ *
+ * @return PROTOCOL_STATUS_SIZE
+ */
+size_t Protocol_Pack_Status(const Protocol_Status_t *Status, uint8_t *Output)
+{
+    Put_U32(&Output[0], Status->Pending);
+    Put_U32(&Output[4], Status->Current_Id);
+    Put_U32(&Output[8], Status->Completed);
+    Put_U32(&Output[12], Status->Last_Executed_Steps);
+    Output[16] = Status->Busy;
+    Output[17] = Status->Running;
+    Output[18] = Status->Last_Result;
+
+    return PROTOCOL_STATUS_SIZE;
+}
+
+/**
+ * @brief Decode a status reply.
+ *
+ * @return PROTOCOL_STATUS_SIZE
+ */
+size_t Protocol_Unpack_Status(const uint8_t *Input, Protocol_Status_t *Status)
+{
+    Status->Pending = Get_U32(&Input[0]);
+    Status->Current_Id = Get_U32(&Input[4]);
+    Status->Completed = Get_U32(&Input[8]);
+    Status->Last_Executed_Steps = Get_U32(&Input[12]);
+    Status->Busy = Input[16];
+    Status->Running = Input[17];
+    Status->Last_Result = Input[18];
+
+    return PROTOCOL_STATUS_SIZE;
+}
+
+/**
+ * @brief Encode a telemetry frame.
+ *
+ * @return PROTOCOL_TELEMETRY_SIZE
+ */
+size_t Protocol_Pack_Telemetry(const Protocol_Telemetry_t *Telemetry, uint8_t *Output)
+{
+    Put_U32(&Output[0], Telemetry->Uptime_ms);
+    Put_U32(&Output[4], Telemetry->Step_Rate_Hz);
+    Put_U32(&Output[8], (uint32_t)Telemetry->Position);
+    Put_U32(&Output[12], Telemetry->Queue_Depth);
+    Put_U32(&Output[16], Telemetry->Steps_Emitted);
+    Put_U32(&Output[20], Telemetry->Missed_Deadlines);
+    Put_U32(&Output[24], Telemetry->Motion_Busy_ms);
+    Put_U32(&Output[28], Telemetry->Free_Heap);
+    Put_U32(&Output[32], Telemetry->Min_Free_Heap);
+    Put_U16(&Output[36], Telemetry->Motion_Load);
+    Output[38] = Telemetry->Flags;
+
+    return PROTOCOL_TELEMETRY_SIZE;
+}
+
+/**
+ * @brief Decode a telemetry frame.
+ *
+ * @return PROTOCOL_TELEMETRY_SIZE
+ */
+size_t Protocol_Unpack_Telemetry(const uint8_t *Input, Protocol_Telemetry_t *Telemetry)
+{
+    Telemetry->Uptime_ms = Get_U32(&Input[0]);
+    Telemetry->Step_Rate_Hz = Get_U32(&Input[4]);
+    Telemetry->Position = (int32_t)Get_U32(&Input[8]);
+    Telemetry->Queue_Depth = Get_U32(&Input[12]);
+    Telemetry->Steps_Emitted = Get_U32(&Input[16]);
+    Telemetry->Missed_Deadlines = Get_U32(&Input[20]);
+    Telemetry->Motion_Busy_ms = Get_U32(&Input[24]);
+    Telemetry->Free_Heap = Get_U32(&Input[28]);
+    Telemetry->Min_Free_Heap = Get_U32(&Input[32]);
+    Telemetry->Motion_Load = Get_U16(&Input[36]);
+    Telemetry->Flags = Input[38];
+
+    return PROTOCOL_TELEMETRY_SIZE;
+}
@@ -0,0 +1,209 @@
+/*H**********************************************************************
+ * FILENAME :        binary_protocol.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent encoder and decoder of the binary command
+ *       protocol of the stepper motor example.
+ *
+ * NOTES :
+ *       Frame layout, all multi-byte fields little endian:
+ *
+ *         0xA5 0x5A | length (2) | opcode (1) | sequence (1) | payload | crc (2)
+ *
+ *       The length counts the payload bytes only. The CRC is CRC-16/CCITT
+ *       (poly 0x1021, init 0xFFFF) over length, opcode, sequence and
+ *       payload. This module only depends on the C standard library and is
+ *       also built as a shared library for host tools.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef BINARY_PROTOCOL_H
+#define BINARY_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define PROTOCOL_SYNC_0 0xA5                                                                 // First sync byte of every frame
+#define PROTOCOL_SYNC_1 0x5A                                                                 // Second sync byte of every frame
+#define PROTOCOL_HEADER_SIZE 6                                                               // Sync, length, opcode and sequence
+#define PROTOCOL_CRC_SIZE 2                                                                  // CRC after the payload
+#define PROTOCOL_MAX_PAYLOAD 512                                                             // Largest payload accepted by the decoder
+#define PROTOCOL_MAX_FRAME (PROTOCOL_HEADER_SIZE + PROTOCOL_MAX_PAYLOAD + PROTOCOL_CRC_SIZE) // Largest encoded frame
+
+#define PROTOCOL_MOVE_RECORD_SIZE 9    // Encoded size of one Protocol_Move_t
+#define PROTOCOL_LINEAR_RECORD_SIZE 20 // Encoded size of one Protocol_Linear_t
+#define PROTOCOL_RUN_RECORD_SIZE 9     // Encoded size of one Protocol_Run_t
+#define PROTOCOL_JOG_RECORD_SIZE 4     // Encoded size of one Protocol_Jog_t
+#define PROTOCOL_ACK_SIZE 4            // Encoded size of one Protocol_Ack_t
+#define PROTOCOL_STATUS_SIZE 19        // Encoded size of one Protocol_Status_t
+#define PROTOCOL_TELEMETRY_SIZE 39     // Encoded size of one Protocol_Telemetry_t
+#define PROTOCOL_LINEAR_AXES 4         // Axes carried by a Protocol_Linear_t
+
+#define PROTOCOL_TELEMETRY_BUSY 0x01       // Flag of Protocol_Telemetry_t: a command is being executed
+#define PROTOCOL_TELEMETRY_RUNNING 0x02    // Flag of Protocol_Telemetry_t: the motor runs continuously
+#define PROTOCOL_TELEMETRY_JOGGING 0x04    // Flag of Protocol_Telemetry_t: the jog mode follows the set-point
+#define PROTOCOL_TELEMETRY_REFERENCED 0x08 // Flag of Protocol_Telemetry_t: the position is referenced
+
+/** Opcodes, requests from the host below 0x80, replies from the device from 0x80 */
+typedef enum
+{
+    PROTOCOL_OP_PING = 0x01,            // No payload, answered with an ack
+    PROTOCOL_OP_MOVE = 0x10,            // Batch of Protocol_Move_t records
+    PROTOCOL_OP_LINEAR = 0x11,          // Batch of Protocol_Linear_t records
+    PROTOCOL_OP_RUN = 0x12,             // One Protocol_Run_t record
+    PROTOCOL_OP_STOP = 0x13,            // No payload, stop after the queued commands
+    PROTOCOL_OP_ABORT = 0x14,           // No payload, drop the queue and stop now
+    PROTOCOL_OP_FLUSH = 0x15,           // No payload, drop the queued commands
+    PROTOCOL_OP_JOG = 0x16,             // One Protocol_Jog_t record, may be streamed
+    PROTOCOL_OP_HALT = 0x17,            // One byte, 1 quick stop, 0 controlled stop, drops the queue
+    PROTOCOL_OP_STATUS = 0x20,          // No payload, answered with a status frame
+    PROTOCOL_OP_TELEMETRY = 0x21,       // Two bytes, telemetry period in ms, 0 stops the telemetry frames
+    PROTOCOL_OP_ACK = 0x80,             // Protocol_Ack_t
+    PROTOCOL_OP_STATUS_REPLY = 0xA0,    // Protocol_Status_t
+    PROTOCOL_OP_TELEMETRY_FRAME = 0xA1, // Protocol_Telemetry_t, sent unasked every period, the sequence counts the frames
+} Protocol_Opcode_t;
+
+/** Result codes carried by an ack */
+typedef enum
+{
+    PROTOCOL_RESULT_OK = 0,      // All records accepted
+    PROTOCOL_RESULT_QUEUE_FULL,  // Motion queue full, records from Accepted on were dropped
+    PROTOCOL_RESULT_BAD_PAYLOAD, // Payload size does not match the opcode
+    PROTOCOL_RESULT_BAD_OPCODE,  // Unknown opcode
+    PROTOCOL_RESULT_BAD_CRC,     // Frame dropped, sequence is the one of the broken frame
+    PROTOCOL_RESULT_ERROR,       // Command failed
+} Protocol_Result_t;
+
+/** One decoded frame */
+typedef struct
+{
+    uint8_t Opcode;                        // Protocol_Opcode_t
+    uint8_t Sequence;                      // Sequence number chosen by the sender
+    uint16_t Length;                       // Payload bytes
+    uint8_t Payload[PROTOCOL_MAX_PAYLOAD]; // Payload
+} Protocol_Frame_t;
+
+/** Fixed step move of the single axis motor */
+typedef struct
+{
+    uint32_t Frequency_Hz; // Cruise step frequency
+    uint32_t Steps;        // Steps to move
+    uint8_t Direction;     // 1 forward, 0 backward
+} Protocol_Move_t;
+
+/** Interpolated straight line over up to four axes */
+typedef struct
+{
+    uint32_t Frequency_Hz;               // Step frequency of the longest axis
+    int32_t Steps[PROTOCOL_LINEAR_AXES]; // Signed steps of X, Y, Z and A
+} Protocol_Linear_t;
+
+/** Continuous run of the single axis motor */
+typedef struct
+{
+    uint32_t Frequency_Hz; // Cruise step frequency
+    uint32_t Duty_Cycle;   // PWM duty cycle
+    uint8_t Direction;     // 1 forward, 0 backward
+} Protocol_Run_t;
+
+/** Jog set-point of the single axis motor */
+typedef struct
+{
+    int32_t Velocity_Hz; // Signed step frequency, negative backward, 0 stops
+} Protocol_Jog_t;
+
+/** Reply to every request except PROTOCOL_OP_STATUS */
+typedef struct
+{
+    uint8_t Sequence; // Sequence of the request being answered
+    uint8_t Result;   // Protocol_Result_t
+    uint8_t Accepted; // Records of a batch that were queued
+    uint8_t Reserved; // Always 0
+} Protocol_Ack_t;
+
+/** Reply to PROTOCOL_OP_STATUS */
+typedef struct
+{
+    uint32_t Pending;             // Commands waiting in the queue
+    uint32_t Current_Id;          // Command being executed, or the last one executed
+    uint32_t Completed;           // Commands finished since boot
+    uint32_t Last_Executed_Steps; // Steps of the last finished move
+    uint8_t Busy;                 // 1 while a command is being executed
+    uint8_t Running;              // 1 while the motor runs continuously
+    uint8_t Last_Result;          // Protocol_Result_t of the last finished command
+} Protocol_Status_t;
+
+/** Periodic sample of the motion and run time statistics */
+typedef struct
+{
+    uint32_t Uptime_ms;        // Time of the sample since boot
+    uint32_t Step_Rate_Hz;     // Steps per second over the last period
+    int32_t Position;          // Absolute position in steps
+    uint32_t Queue_Depth;      // Commands waiting in the motion queue
+    uint32_t Steps_Emitted;    // Steps emitted since boot in both directions, wraps
+    uint32_t Missed_Deadlines; // Commands that did not end in time since boot
+    uint32_t Motion_Busy_ms;   // Time the motion task spent executing commands since boot, wraps
+    uint32_t Free_Heap;        // Free heap in bytes
+    uint32_t Min_Free_Heap;    // Lowest free heap since boot in bytes
+    uint16_t Motion_Load;      // Share of the last period the motion task was executing commands, in 1/1000
+    uint8_t Flags;             // PROTOCOL_TELEMETRY_BUSY, _RUNNING, _JOGGING, _REFERENCED
+} Protocol_Telemetry_t;
+
+/** Decoder state machine */
+typedef enum
+{
+    PROTOCOL_STATE_SYNC_0 = 0, // Waiting for the first sync byte
+    PROTOCOL_STATE_SYNC_1,     // Waiting for the second sync byte
+    PROTOCOL_STATE_HEADER,     // Collecting length, opcode and sequence
+    PROTOCOL_STATE_PAYLOAD,    // Collecting the payload
+    PROTOCOL_STATE_CRC,        // Collecting the CRC
+} Protocol_Decoder_State_t;
+
+/** Result of feeding bytes to the decoder */
+typedef enum
+{
+    PROTOCOL_DECODE_PENDING = 0, // Frame not complete yet
+    PROTOCOL_DECODE_FRAME,       // A valid frame is in the output
+    PROTOCOL_DECODE_BAD_CRC,     // A frame with a wrong CRC was dropped
+    PROTOCOL_DECODE_TOO_LONG,    // A frame with a payload above PROTOCOL_MAX_PAYLOAD was dropped
+} Protocol_Decode_Result_t;
+
+/** Byte wise frame decoder */
+typedef struct
+{
+    Protocol_Decoder_State_t State;       // Current state
+    uint8_t Header[4];                    // Length, opcode and sequence
+    uint16_t Index;                       // Bytes collected in the current state
+    uint16_t Crc;                         // Running CRC of the frame
+    uint8_t Crc_Bytes[PROTOCOL_CRC_SIZE]; // Received CRC
+    Protocol_Frame_t Frame;               // Frame being collected
+    uint32_t Bad_Frames;                  // Frames dropped since the decoder was reset
+} Protocol_Decoder_t;
+
+uint16_t Protocol_Crc16(uint16_t Crc, const uint8_t *Data, size_t Size);
+size_t Protocol_Encode_Frame(uint8_t Opcode, uint8_t Sequence, const uint8_t *Payload, uint16_t Length, uint8_t *Output, size_t Output_Size);
+
+void Protocol_Decoder_Reset(Protocol_Decoder_t *Decoder);
+Protocol_Decode_Result_t Protocol_Decoder_Feed(Protocol_Decoder_t *Decoder, uint8_t Byte, Protocol_Frame_t *Frame);
+
+size_t Protocol_Pack_Move(const Protocol_Move_t *Move, uint8_t *Output);
+size_t Protocol_Unpack_Move(const uint8_t *Input, Protocol_Move_t *Move);
+size_t Protocol_Pack_Linear(const Protocol_Linear_t *Linear, uint8_t *Output);
+size_t Protocol_Unpack_Linear(const uint8_t *Input, Protocol_Linear_t *Linear);
+size_t Protocol_Pack_Run(const Protocol_Run_t *Run, uint8_t *Output);
+size_t Protocol_Unpack_Run(const uint8_t *Input, Protocol_Run_t *Run);
+size_t Protocol_Pack_Jog(const Protocol_Jog_t *Jog, uint8_t *Output);
+size_t Protocol_Unpack_Jog(const uint8_t *Input, Protocol_Jog_t *Jog);
+size_t Protocol_Pack_Ack(const Protocol_Ack_t *Ack, uint8_t *Output);
+size_t Protocol_Unpack_Ack(const uint8_t *Input, Protocol_Ack_t *Ack);
+size_t Protocol_Pack_Status(const Protocol_Status_t *Status, uint8_t *Output);
+size_t Protocol_Unpack_Status(const uint8_t *Input, Protocol_Status_t *Status);
+size_t Protocol_Pack_Telemetry(const Protocol_Telemetry_t *Telemetry, uint8_t *Output);
+size_t Protocol_Unpack_Telemetry(const uint8_t *Input, Protocol_Telemetry_t *Telemetry);
+
+#endif // BINARY_PROTOCOL_H
@@ -0,0 +1,294 @@
+/*H**********************************************************************
+ * FILENAME :        closed_loop.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent encoder feedback of the stepper motor example:
+ *       following error and stall monitor, and the search of the autotune.
+ *
+ * NOTES :
+ *       The monitor only sees the samples it is updated with. A stall is
+ *       found within the stall steps plus the steps of one update period,
+ *       a short slip between two updates only shows as following error.
+ *
+ *       The search only needs the result of every trial, the trial moves
+ *       are left to the caller, see motor_encoder.c. Every phase ends after
+ *       about log(max / start) / log(1 + growth) trials plus the halvings
+ *       of the resolution.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "closed_loop.h"
+
+/**
+ * @brief Fill a monitor configuration with the default limits of closed_loop.h.
+ *
+ * @param Config Configuration to fill.
+ * @param Counts_Per_Step_Q16 Encoder counts per step in 16.16 fixed point.
+ */
+void Closed_Loop_Default_Config(Closed_Loop_Config_t *Config, int32_t Counts_Per_Step_Q16)
+{
+    Config->Counts_Per_Step_Q16 = Counts_Per_Step_Q16;
+    Config->Following_Limit = CLOSED_LOOP_DEFAULT_FOLLOWING_LIMIT;
+    Config->Stall_Steps = CLOSED_LOOP_DEFAULT_STALL_STEPS;
+}
+
+/**
+ * @brief Convert encoder counts into steps, rounded to the nearest step.
+ *
+ * @return 0 if the configuration has no counts per step.
+ */
+int32_t Closed_Loop_Counts_To_Steps(const Closed_Loop_Config_t *Config, int32_t Counts)
+{
+    if (Config->Counts_Per_Step_Q16 == 0)
+    {
+        return 0;
+    }
+
+    int64_t Scaled = (int64_t)Counts * 65536;
+    int64_t Divisor = Config->Counts_Per_Step_Q16;
+    int64_t Half = ((Divisor < 0) ? -Divisor : Divisor) / 2;
+
+    return (int32_t)((Scaled + ((Scaled < 0) ? -Half : Half)) / Divisor); // Half a step away from zero, then truncated
+}
+
+/**
+ * @brief Start monitoring a move.
+ *
+ * @param Monitor Monitor to start, the fault of an earlier move is cleared.
+ * @param Config Encoder and limits, copied.
+ * @param Commanded Commanded position in steps at the start.
+ * @param Counts Encoder count at the start.
+ */
+void Closed_Loop_Begin(Closed_Loop_Monitor_t *Monitor, const Closed_Loop_Config_t *Config, int32_t Commanded, int32_t Counts)
+{
+    memset(Monitor, 0, sizeof(*Monitor));
+
+    Monitor->Config = *Config;
+    Monitor->Commanded_Start = Commanded;
+    Monitor->Counts_Start = Counts;
+    Monitor->Progress_Commanded = Commanded;
+    Monitor->Progress_Measured = Commanded;
+    Monitor->Fault = CLOSED_LOOP_OK;
+}
+
+/**
+ * @brief Compare the commanded position with the measured one.
+ *
+ * A limit of 0 switches its check off. Once a fault is found it is
+ * returned without a new comparison until the next Closed_Loop_Begin().
+ *
+ * @param Monitor Started monitor.
+ * @param Commanded Commanded position in steps.
+ * @param Counts Encoder count at the same time.
+ * @return CLOSED_LOOP_OK or the latched fault.
+ */
+Closed_Loop_Fault_t Closed_Loop_Update(Closed_Loop_Monitor_t *Monitor, int32_t Commanded, int32_t Counts)
+{
+    if (Monitor->Fault != CLOSED_LOOP_OK)
+    {
+        return Monitor->Fault;
+    }
+
+    int32_t Moved = Closed_Loop_Counts_To_Steps(&Monitor->Config, (int32_t)((uint32_t)Counts - (uint32_t)Monitor->Counts_Start)); // Also across the wrap of the count
+    int32_t Measured = Monitor->Commanded_Start + Moved;
+    int64_t Stalled_Steps = (int64_t)Commanded - Monitor->Progress_Commanded;
+
+    Monitor->Error = Commanded - Measured;
+
+    uint32_t Distance = (Monitor->Error < 0) ? (uint32_t)(-(int64_t)Monitor->Error) : (uint32_t)Monitor->Error;
+
+    Monitor->Max_Error = (Distance > Monitor->Max_Error) ? Distance : Monitor->Max_Error;
+
+    if (Measured != Monitor->Progress_Measured)
+    {
+        Monitor->Progress_Commanded = Commanded;
+        Monitor->Progress_Measured = Measured;
+    }
+    else if ((Monitor->Config.Stall_Steps != 0) && (((Stalled_Steps < 0) ? -Stalled_Steps : Stalled_Steps) >= Monitor->Config.Stall_Steps))
+    {
+        Monitor->Fault = CLOSED_LOOP_STALL;
+    }
+
+    if ((Monitor->Fault == CLOSED_LOOP_OK) && (Monitor->Config.Following_Limit != 0) && (Distance > Monitor->Config.Following_Limit))
+    {
+        Monitor->Fault = CLOSED_LOOP_FOLLOWING_ERROR;
+    }
+
+    return Monitor->Fault;
+}
+
+/**
+ * @brief Printable name of a fault.
+ */
+const char *Closed_Loop_Fault_Name(Closed_Loop_Fault_t Fault)
+{
+    switch (Fault)
+    {
+    case CLOSED_LOOP_OK:
+        return "ok";
+    case CLOSED_LOOP_FOLLOWING_ERROR:
+        return "following error";
+    case CLOSED_LOOP_STALL:
+        return "stall";
+    default:
+        return "unknown";
+    }
+}
+
+/**
+ * @brief Start a search, the first trial runs at the start frequency and acceleration.
+ *
+ * @param Search Search to start.
+ * @param Config Range and steps, copied.
+ * @return false if a start value is 0 or above its maximum, the growth is 0
+ *         or the margin outside 1 to 100 percent.
+ */
+bool Autotune_Begin(Autotune_Search_t *Search, const Autotune_Config_t *Config)
+{
+    memset(Search, 0, sizeof(*Search));
+
+    Search->Config = *Config;
+    Search->Phase = AUTOTUNE_DONE;
+
+    if ((Config->Start_Frequency_Hz == 0) || (Config->Start_Frequency_Hz > Config->Max_Frequency_Hz) || (Config->Start_Acceleration == 0) ||
+        (Config->Start_Acceleration > Config->Max_Acceleration) || (Config->Growth_Percent == 0) || (Config->Margin_Percent == 0) || (Config->Margin_Percent > 100))
+    {
+        return false;
+    }
+
+    Search->Phase = AUTOTUNE_VELOCITY;
+    Search->Trial = Config->Start_Frequency_Hz;
+
+    return true;
+}
+
+/**
+ * @brief Limits of the next trial move.
+ *
+ * @param Search Running search.
+ * @param Frequency_Hz Returns the cruise frequency of the trial.
+ * @param Acceleration Returns the acceleration of the trial in steps/s^2.
+ * @return false once the search ended.
+ */
+bool Autotune_Next_Trial(const Autotune_Search_t *Search, uint32_t *Frequency_Hz, uint32_t *Acceleration)
+{
+    if (Search->Phase == AUTOTUNE_VELOCITY)
+    {
+        *Frequency_Hz = Search->Trial;
+        *Acceleration = Search->Config.Start_Acceleration;
+    }
+    else if (Search->Phase == AUTOTUNE_ACCELERATION)
+    {
+        *Frequency_Hz = Search->Frequency_Hz;
+        *Acceleration = Search->Trial;
+    }
+
+    return Search->Phase != AUTOTUNE_DONE;
+}
+
+/**
+ * @brief Take the highest passed value of the phase, less the margin, and go on with the next phase.
+ */
+static void End_Autotune_Phase(Autotune_Search_t *Search)
+{
+    uint32_t Value = (uint32_t)(((uint64_t)Search->Passed * Search->Config.Margin_Percent) / 100);
+
+    Value = (Value == 0) ? 1 : Value;
+
+    if (Search->Phase == AUTOTUNE_VELOCITY)
+    {
+        Search->Frequency_Hz = Value;
+        Search->Phase = AUTOTUNE_ACCELERATION;
+        Search->Trial = Search->Config.Start_Acceleration;
+        Search->Passed = 0;
+        Search->Failed = 0;
+    }
+    else
+    {
+        Search->Acceleration = Value;
+        Search->Phase = AUTOTUNE_DONE;
+        Search->Valid = true;
+    }
+}
+
+/**
+ * @brief Report the result of the trial from Autotune_Next_Trial() and pick the next one.
+ *
+ * A failed first trial of a phase ends the search without a result.
+ *
+ * @param Search Running search.
+ * @param Passed The trial moves ended without a fault.
+ */
+void Autotune_Report(Autotune_Search_t *Search, bool Passed)
+{
+    if (Search->Phase == AUTOTUNE_DONE)
+    {
+        return;
+    }
+
+    uint32_t Max_Value = (Search->Phase == AUTOTUNE_VELOCITY) ? Search->Config.Max_Frequency_Hz : Search->Config.Max_Acceleration;
+
+    Search->Trials++;
+    Search->Failed_Trials += Passed ? 0 : 1;
+    Search->Passed = Passed ? Search->Trial : Search->Passed;
+    Search->Failed = Passed ? Search->Failed : Search->Trial;
+
+    if (Search->Passed == 0)
+    {
+        Search->Phase = AUTOTUNE_DONE; // The start value is not safe, nothing to search from
+    }
+    else if (Search->Failed == 0)
+    {
+        uint64_t Grown = (uint64_t)Search->Trial + (((uint64_t)Search->Trial * Search->Config.Growth_Percent) / 100);
+
+        Grown = (Grown == Search->Trial) ? (Grown + 1) : Grown; // Small values still grow
+
+        if (Search->Passed >= Max_Value)
+        {
+            End_Autotune_Phase(Search); // Passed up to the maximum
+        }
+        else
+        {
+            Search->Trial = (Grown > Max_Value) ? Max_Value : (uint32_t)Grown;
+        }
+    }
+    else
+    {
+        uint32_t Gap = Search->Failed - Search->Passed;
+
+        if ((Gap <= 1) || (Gap <= (uint32_t)(((uint64_t)Search->Passed * Search->Config.Resolution_Percent) / 100)))
+        {
+            End_Autotune_Phase(Search);
+        }
+        else
+        {
+            Search->Trial = Search->Passed + (Gap / 2);
+        }
+    }
+}
+
+/**
+ * @brief Limits found by a search.
+ *
+ * @param Search Search to read.
+ * @param Frequency_Hz Returns the highest safe cruise frequency, margin applied.
+ * @param Acceleration Returns the highest safe acceleration at that frequency in steps/s^2, margin applied.
+ * @return false while the search runs, or if it ended without a result.
+ */
+bool Autotune_Result(const Autotune_Search_t *Search, uint32_t *Frequency_Hz, uint32_t *Acceleration)
+{
+    if (!Search->Valid)
+    {
+        return false;
+    }
+
+    *Frequency_Hz = Search->Frequency_Hz;
+    *Acceleration = Search->Acceleration;
+
+    return true;
+}
@@ -0,0 +1,112 @@
+/*H**********************************************************************
+ * FILENAME :        closed_loop.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent encoder feedback of the stepper motor example:
+ *       following error and stall monitor, and the search of the autotune.
+ *
+ * NOTES :
+ *       The monitor compares the commanded position with the position the
+ *       encoder measured since the start of a move. A move fails once they
+ *       are further apart than the following limit, or once the commanded
+ *       position went on by the stall steps while the measured one did not
+ *       move by a step. The first fault of a move is latched.
+ *
+ *       The autotune search first raises the cruise frequency at the start
+ *       acceleration, then the acceleration at the found frequency. Every
+ *       value grows geometrically until a trial fails, the range between
+ *       the last passed and the failed trial is then halved down to the
+ *       resolution. The result keeps a margin below the highest passed
+ *       values.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef CLOSED_LOOP_H
+#define CLOSED_LOOP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CLOSED_LOOP_DEFAULT_FOLLOWING_LIMIT 128 // Default largest distance of commanded and measured position in steps
+#define CLOSED_LOOP_DEFAULT_STALL_STEPS 48      // Default commanded steps without a measured one that are a stall
+
+/** Fault found by the monitor */
+typedef enum
+{
+    CLOSED_LOOP_OK = 0,          // Measured position follows
+    CLOSED_LOOP_FOLLOWING_ERROR, // Commanded and measured position too far apart
+    CLOSED_LOOP_STALL,           // Commanded position moves, the measured one does not
+} Closed_Loop_Fault_t;
+
+/** Encoder and limits of the monitor */
+typedef struct
+{
+    int32_t Counts_Per_Step_Q16; // Encoder counts per step in 16.16 fixed point, negative if the encoder counts backward
+    uint32_t Following_Limit;    // Largest distance of commanded and measured position in steps
+    uint32_t Stall_Steps;        // Commanded steps without a measured one that are a stall
+} Closed_Loop_Config_t;
+
+/** Monitor of one move */
+typedef struct
+{
+    Closed_Loop_Config_t Config; // Encoder and limits
+    int32_t Commanded_Start;     // Commanded position at the start of the move
+    int32_t Counts_Start;        // Encoder count at the start of the move
+    int32_t Progress_Commanded;  // Commanded position when the measured one last moved
+    int32_t Progress_Measured;   // Measured position it moved to
+    int32_t Error;               // Commanded minus measured position of the last update
+    uint32_t Max_Error;          // Largest distance of the move
+    Closed_Loop_Fault_t Fault;   // First fault of the move, latched
+} Closed_Loop_Monitor_t;
+
+/** Phase of the autotune search */
+typedef enum
+{
+    AUTOTUNE_VELOCITY = 0, // Raising the cruise frequency at the start acceleration
+    AUTOTUNE_ACCELERATION, // Raising the acceleration at the found frequency
+    AUTOTUNE_DONE,         // Search ended, see Autotune_Result()
+} Autotune_Phase_t;
+
+/** Range and steps of the autotune search */
+typedef struct
+{
+    uint32_t Start_Frequency_Hz; // First frequency tried, has to pass
+    uint32_t Max_Frequency_Hz;   // Highest frequency tried
+    uint32_t Start_Acceleration; // Acceleration of the frequency trials and first one tried in steps/s^2, has to pass
+    uint32_t Max_Acceleration;   // Highest acceleration tried in steps/s^2
+    uint32_t Growth_Percent;     // Increase after a passed trial until the first failure
+    uint32_t Resolution_Percent; // Search ends once passed and failed value are this close
+    uint32_t Margin_Percent;     // Share of the highest passed value that is taken
+} Autotune_Config_t;
+
+/** State of the autotune search */
+typedef struct
+{
+    Autotune_Config_t Config; // Range and steps
+    Autotune_Phase_t Phase;   // Value searched
+    uint32_t Trial;           // Value of the next trial
+    uint32_t Passed;          // Highest passed value of the phase, 0 if none
+    uint32_t Failed;          // Lowest failed value of the phase, 0 if none
+    uint32_t Frequency_Hz;    // Found frequency, margin applied, valid from AUTOTUNE_ACCELERATION on
+    uint32_t Acceleration;    // Found acceleration, margin applied, valid once done
+    uint16_t Trials;          // Trials reported
+    uint16_t Failed_Trials;   // Trials reported as failed
+    bool Valid;               // Frequency_Hz and Acceleration hold a result
+} Autotune_Search_t;
+
+void Closed_Loop_Default_Config(Closed_Loop_Config_t *Config, int32_t Counts_Per_Step_Q16);
+int32_t Closed_Loop_Counts_To_Steps(const Closed_Loop_Config_t *Config, int32_t Counts);
+void Closed_Loop_Begin(Closed_Loop_Monitor_t *Monitor, const Closed_Loop_Config_t *Config, int32_t Commanded, int32_t Counts);
+Closed_Loop_Fault_t Closed_Loop_Update(Closed_Loop_Monitor_t *Monitor, int32_t Commanded, int32_t Counts);
+const char *Closed_Loop_Fault_Name(Closed_Loop_Fault_t Fault);
+
+bool Autotune_Begin(Autotune_Search_t *Search, const Autotune_Config_t *Config);
+bool Autotune_Next_Trial(const Autotune_Search_t *Search, uint32_t *Frequency_Hz, uint32_t *Acceleration);
+void Autotune_Report(Autotune_Search_t *Search, bool Passed);
+bool Autotune_Result(const Autotune_Search_t *Search, uint32_t *Frequency_Hz, uint32_t *Acceleration);
+
+#endif // CLOSED_LOOP_H
@@ -0,0 +1,362 @@
+/*H**********************************************************************
+ * FILENAME :        command_line.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent command line of the stepper motor example:
+ *       line editor, splitting into words and parsing of the options of a
+ *       command, all in fixed buffers without the heap.
+ *
+ * NOTES :
+ *       Nothing here allocates, the caller owns the line, the word array
+ *       and the value array. The editor does not keep a history and only
+ *       erases at the end of the line, a terminal without escape sequences
+ *       works the same.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "command_line.h"
+
+#define COMMAND_LINE_ESCAPE 0x1B    // Starts an escape sequence of the terminal
+#define COMMAND_LINE_BACKSPACE 0x08 // Sent by some terminals for the backspace key
+#define COMMAND_LINE_DELETE 0x7F    // Sent by most terminals for the backspace key
+
+/**
+ * @brief Start a new line.
+ *
+ * A LF right after the CR that ended the last line is still skipped.
+ *
+ * @param Line Line to clear.
+ */
+void Command_Line_Reset(Command_Line_t *Line)
+{
+    Line->Text[0] = '\0';
+    Line->Length = 0;
+    Line->Overflow = false;
+    Line->Escape = 0;
+}
+
+/**
+ * @brief Add one received byte to the line.
+ *
+ * @param Line Line being edited, reset or zeroed before the first byte.
+ * @param Byte Received byte.
+ * @return What to echo, COMMAND_LINE_DONE once the line is complete.
+ *         A line that did not fit is reset and COMMAND_LINE_TOO_LONG returned.
+ */
+Command_Line_Event_t Command_Line_Feed(Command_Line_t *Line, uint8_t Byte)
+{
+    bool Carriage_Return = Line->Carriage_Return;
+
+    Line->Carriage_Return = (Byte == '\r');
+
+    if (Line->Escape == 1)
+    {
+        Line->Escape = ((Byte == '[') || (Byte == 'O')) ? 2 : 0; // CSI and SS3 sequences end with their final byte, others after one byte
+        return COMMAND_LINE_NONE;
+    }
+
+    if (Line->Escape != 0)
+    {
+        Line->Escape = ((Byte >= 0x40) && (Byte <= 0x7E)) ? 0 : Line->Escape; // Parameters until the final byte
+        return COMMAND_LINE_NONE;
+    }
+
+    if ((Byte == '\r') || (Byte == '\n'))
+    {
+        if ((Byte == '\n') && Carriage_Return)
+        {
+            return COMMAND_LINE_NONE; // Second byte of CRLF
+        }
+
+        if (Line->Overflow)
+        {
+            Command_Line_Reset(Line);
+            return COMMAND_LINE_TOO_LONG;
+        }
+
+        Line->Text[Line->Length] = '\0';
+
+        return COMMAND_LINE_DONE;
+    }
+
+    if ((Byte == COMMAND_LINE_BACKSPACE) || (Byte == COMMAND_LINE_DELETE))
+    {
+        if (Line->Length == 0)
+        {
+            return COMMAND_LINE_NONE;
+        }
+
+        Line->Length--;
+
+        return COMMAND_LINE_ERASE;
+    }
+
+    if (Byte == COMMAND_LINE_ESCAPE)
+    {
+        Line->Escape = 1;
+        return COMMAND_LINE_NONE;
+    }
+
+    if (Byte < 0x20)
+    {
+        return COMMAND_LINE_NONE; // Other control characters
+    }
+
+    if (Line->Length >= COMMAND_LINE_MAX_LENGTH)
+    {
+        Line->Overflow = true;
+        return COMMAND_LINE_NONE;
+    }
+
+    Line->Text[Line->Length++] = (char)Byte;
+
+    return COMMAND_LINE_ECHO;
+}
+
+/**
+ * @brief Split a line into words in place.
+ *
+ * @param Text Line, the words are NUL terminated in it.
+ * @param Words Returns the words.
+ * @param Max_Words Size of Words.
+ * @return Number of words, -1 if there are more than Max_Words or a quote is not closed.
+ */
+int Command_Line_Split(char *Text, char **Words, int Max_Words)
+{
+    char *Read = Text;
+    char *Write = Text; // Never ahead of Read, quotes and backslashes only shorten the words
+    int Count = 0;
+
+    while (true)
+    {
+        while ((*Read == ' ') || (*Read == '\t'))
+        {
+            Read++;
+        }
+
+        if (*Read == '\0')
+        {
+            return Count;
+        }
+
+        if (Count == Max_Words)
+        {
+            return -1;
+        }
+
+        bool Quoted = false;
+
+        Words[Count++] = Write;
+
+        while ((*Read != '\0') && (Quoted || ((*Read != ' ') && (*Read != '\t'))))
+        {
+            if (*Read == '"')
+            {
+                Quoted = !Quoted;
+                Read++;
+            }
+            else if ((*Read == '\\') && (Read[1] != '\0'))
+            {
+                *Write++ = Read[1];
+                Read += 2;
+            }
+            else
+            {
+                *Write++ = *Read++;
+            }
+        }
+
+        if (Quoted)
+        {
+            return -1;
+        }
+
+        bool End = (*Read == '\0');
+
+        *Write++ = '\0';
+
+        if (End)
+        {
+            return Count;
+        }
+
+        Read++;
+    }
+}
+
+/**
+ * @brief Convert the text of an option into its value.
+ *
+ * @return false if an integer is not a whole number in the range of int32_t.
+ */
+static bool Parse_Value(const Command_Option_t *Option, const char *Text, Command_Value_t *Value)
+{
+    Value->Count = 1;
+    Value->Text = Text;
+
+    if (Option->Type != COMMAND_OPTION_INT)
+    {
+        return true;
+    }
+
+    char *End = NULL;
+
+    errno = 0;
+
+    long long Number = strtoll(Text, &End, 0);
+
+    if ((End == Text) || (*End != '\0') || (errno == ERANGE) || (Number < INT32_MIN) || (Number > INT32_MAX))
+    {
+        return false;
+    }
+
+    Value->Value = (int32_t)Number;
+
+    return true;
+}
+
+/**
+ * @brief Parse the words of a command into the values of its options.
+ *
+ * @param Options Options of the command.
+ * @param Option_Count Number of options.
+ * @param Word_Count Number of words, the command included.
+ * @param Words Words of the line, Words[0] is the command.
+ * @param Values Returns the value of every option, in the order of Options.
+ * @param Error_Position Returns the word that failed, or the option for COMMAND_PARSE_MISSING.
+ * @return COMMAND_PARSE_OK, or why the words do not fit the options.
+ */
+Command_Parse_Result_t Command_Line_Parse(const Command_Option_t *Options, size_t Option_Count, int Word_Count, char **Words,
+                                          Command_Value_t *Values, int *Error_Position)
+{
+    size_t Next_Positional = 0;
+
+    for (size_t Option = 0; Option < Option_Count; Option++)
+    {
+        Values[Option].Count = 0;
+        Values[Option].Value = 0;
+        Values[Option].Text = "";
+    }
+
+    for (int Word = 1; Word < Word_Count; Word++)
+    {
+        const char *Text = NULL;
+        size_t Option = 0;
+
+        *Error_Position = Word;
+
+        if ((strncmp(Words[Word], "--", 2) == 0) && (Words[Word][2] != '\0'))
+        {
+            const char *Name = Words[Word] + 2;
+            const char *Equals = strchr(Name, '=');
+            size_t Name_Length = (Equals != NULL) ? (size_t)(Equals - Name) : strlen(Name);
+
+            while ((Option < Option_Count) &&
+                   ((Options[Option].Name == NULL) || (strncmp(Options[Option].Name, Name, Name_Length) != 0) || (Options[Option].Name[Name_Length] != '\0')))
+            {
+                Option++;
+            }
+
+            if (Option == Option_Count)
+            {
+                return COMMAND_PARSE_UNKNOWN;
+            }
+
+            if (Values[Option].Count != 0)
+            {
+                return COMMAND_PARSE_REPEATED;
+            }
+
+            if (Options[Option].Type == COMMAND_OPTION_FLAG)
+            {
+                Values[Option].Count = 1;
+
+                if (Equals != NULL)
+                {
+                    return COMMAND_PARSE_BAD_VALUE;
+                }
+
+                continue;
+            }
+
+            if (Equals != NULL)
+            {
+                Text = Equals + 1;
+            }
+            else if (Word + 1 < Word_Count)
+            {
+                Text = Words[++Word]; // Also a negative number
+                *Error_Position = Word;
+            }
+            else
+            {
+                return COMMAND_PARSE_NO_VALUE;
+            }
+        }
+        else
+        {
+            for (Option = Next_Positional; (Option < Option_Count) && (Options[Option].Name != NULL); Option++)
+            {
+            }
+
+            if (Option == Option_Count)
+            {
+                return COMMAND_PARSE_EXTRA_WORD;
+            }
+
+            Next_Positional = Option + 1;
+            Text = Words[Word];
+        }
+
+        if (!Parse_Value(&Options[Option], Text, &Values[Option]))
+        {
+            return COMMAND_PARSE_BAD_VALUE;
+        }
+    }
+
+    for (size_t Option = 0; Option < Option_Count; Option++)
+    {
+        if (Options[Option].Required && (Values[Option].Count == 0))
+        {
+            *Error_Position = (int)Option;
+            return COMMAND_PARSE_MISSING;
+        }
+    }
+
+    return COMMAND_PARSE_OK;
+}
+
+/**
+ * @brief Printable name of a parse result.
+ */
+const char *Command_Parse_Result_Name(Command_Parse_Result_t Result)
+{
+    switch (Result)
+    {
+    case COMMAND_PARSE_OK:
+        return "ok";
+    case COMMAND_PARSE_UNKNOWN:
+        return "unknown option";
+    case COMMAND_PARSE_NO_VALUE:
+        return "missing value of";
+    case COMMAND_PARSE_BAD_VALUE:
+        return "invalid value";
+    case COMMAND_PARSE_REPEATED:
+        return "given twice";
+    case COMMAND_PARSE_EXTRA_WORD:
+        return "unexpected argument";
+    case COMMAND_PARSE_MISSING:
+        return "missing option";
+    case COMMAND_PARSE_SPLIT_FAILED:
+        return "too many words or an open quote";
+    default:
+        return "unknown";
+    }
+}
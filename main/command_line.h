@@ -0,0 +1,109 @@
+/*H**********************************************************************
+ * FILENAME :        command_line.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent command line of the stepper motor example:
+ *       line editor, splitting into words and parsing of the options of a
+ *       command, all in fixed buffers without the heap.
+ *
+ * NOTES :
+ *       The editor collects the received bytes of one line in its buffer,
+ *       backspace erases, CR or LF ends the line and escape sequences of the
+ *       terminal, e.g. the arrow keys, are dropped. A longer line than
+ *       COMMAND_LINE_MAX_LENGTH is rejected as a whole once it ends.
+ *
+ *       The line is split in place, the words point into the buffer. Double
+ *       quotes group words with spaces, a backslash takes the next byte as
+ *       it is.
+ *
+ *       The options of a command are a constant table. Every option is
+ *       given as "--name value" or "--name=value", a flag as "--name", an
+ *       option without a name takes the next word that is not an option.
+ *       Integers are decimal, hexadecimal with 0x or octal with 0. Every
+ *       option may be given once. The values are written to an array in
+ *       the order of the table, text values point into the line.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define COMMAND_LINE_MAX_LENGTH 256 // Longest command line in bytes
+#define COMMAND_LINE_MAX_WORDS 16   // Most words of one line, the command included
+#define COMMAND_LINE_MAX_OPTIONS 8  // Most options of one command
+
+/** What the received byte did to the line */
+typedef enum
+{
+    COMMAND_LINE_NONE = 0, // Nothing to echo
+    COMMAND_LINE_ECHO,     // Byte appended, echo it
+    COMMAND_LINE_ERASE,    // Last byte erased, echo "\b \b"
+    COMMAND_LINE_DONE,     // Line complete in Text, reset it once run
+    COMMAND_LINE_TOO_LONG, // Line ended but did not fit, dropped
+} Command_Line_Event_t;
+
+/** Line being edited */
+typedef struct
+{
+    char Text[COMMAND_LINE_MAX_LENGTH + 1]; // Received bytes, NUL terminated once done
+    size_t Length;                          // Bytes in Text
+    bool Overflow;                          // Bytes were dropped since the line started
+    bool Carriage_Return;                   // Last byte was CR, a following LF ends no line
+    uint8_t Escape;                         // 0, or the position in an escape sequence being dropped
+} Command_Line_t;
+
+/** Type of the value of an option */
+typedef enum
+{
+    COMMAND_OPTION_INT = 0, // Signed 32 bit integer
+    COMMAND_OPTION_FLAG,    // No value, only given or not
+    COMMAND_OPTION_TEXT,    // Word of the line
+} Command_Option_Type_t;
+
+/** One option of a command */
+typedef struct
+{
+    const char *Name;           // Long name without "--", NULL for a positional argument
+    Command_Option_Type_t Type; // Type of the value
+    bool Required;              // The command fails without it
+    const char *Hint;           // Placeholder of the value in the help, NULL for flags
+    const char *Help;           // Description in the help
+} Command_Option_t;
+
+/** Parsed value of an option */
+typedef struct
+{
+    uint8_t Count;    // 1 if given, 0 if not
+    int32_t Value;    // Integer value, 0 if not given
+    const char *Text; // Text value in the line, "" if not given
+} Command_Value_t;
+
+/** Result of parsing the options of a command */
+typedef enum
+{
+    COMMAND_PARSE_OK = 0,       // All words parsed, all required options given
+    COMMAND_PARSE_UNKNOWN,      // Word is no option of the command
+    COMMAND_PARSE_NO_VALUE,     // Option at the end of the line without its value
+    COMMAND_PARSE_BAD_VALUE,    // Not an integer in range, or a value given to a flag
+    COMMAND_PARSE_REPEATED,     // Option given twice
+    COMMAND_PARSE_EXTRA_WORD,   // More words than positional arguments
+    COMMAND_PARSE_MISSING,      // Required option not given
+    COMMAND_PARSE_SPLIT_FAILED, // Too many words or an open quote, see Command_Line_Split()
+} Command_Parse_Result_t;
+
+void Command_Line_Reset(Command_Line_t *Line);
+Command_Line_Event_t Command_Line_Feed(Command_Line_t *Line, uint8_t Byte);
+int Command_Line_Split(char *Text, char **Words, int Max_Words);
+Command_Parse_Result_t Command_Line_Parse(const Command_Option_t *Options, size_t Option_Count, int Word_Count, char **Words,
+                                          Command_Value_t *Values, int *Error_Position);
+const char *Command_Parse_Result_Name(Command_Parse_Result_t Result);
+
+#endif // COMMAND_LINE_H
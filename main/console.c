@@ -1,58 +1,526 @@
+#include <inttypes.h>
 #include <console.h>
 #include "main.h"
+#include "motion_queue.h"
+#include "gcode_stream.h"
+#include "binary_link.h"
+#include "motion_benchmark.h"
+#include "motion_math.h"
+#include "homing.h"
+#include "motor_script.h"
+#include "trajectory_player.h"
+#include "stepper.h"
+#include "esp_heap_caps.h"
+#if CONFIG_HEAP_TRACING_STANDALONE
+#include "esp_heap_trace.h"
+#endif
 
-esp_err_t Rotate_Angle(int argc, char **argv)
+/** Options of start_motor, the index of their values */
+enum
+{
+    START_MOTOR_ARG_FREQUENCY = 0, // --frq
+    START_MOTOR_ARG_DIRECTION,     // --dir
+    START_MOTOR_ARG_DUTY_CYCLE,    // --duty
+    START_MOTOR_ARG_COUNT,         // Number of options
+};
+
+/** Options of rotate_motor, the index of their values */
+enum
+{
+    ROTATE_MOTOR_ARG_FREQUENCY = 0, // --frq
+    ROTATE_MOTOR_ARG_DIRECTION,     // --dir
+    ROTATE_MOTOR_ARG_STEPS,         // --step
+    ROTATE_MOTOR_ARG_ROTATION,      // --rotation
+    ROTATE_MOTOR_ARG_MOTOR,         // --motor
+    ROTATE_MOTOR_ARG_COUNT,         // Number of options
+};
+
+/** Options of rotate_angle, the index of their values */
+enum
+{
+    ROTATE_ANGLE_ARG_FREQUENCY = 0, // --frq
+    ROTATE_ANGLE_ARG_DIRECTION,     // --dir
+    ROTATE_ANGLE_ARG_STEPS,         // --step
+    ROTATE_ANGLE_ARG_ANGLE,         // --angle
+    ROTATE_ANGLE_ARG_MOTOR,         // --motor
+    ROTATE_ANGLE_ARG_COUNT,         // Number of options
+};
+
+/** Options of move_linear, the index of their values */
+enum
+{
+    MOVE_LINEAR_ARG_FREQUENCY = 0, // --frq
+    MOVE_LINEAR_ARG_X,             // --x
+    MOVE_LINEAR_ARG_Y,             // --y
+    MOVE_LINEAR_ARG_Z,             // --z
+    MOVE_LINEAR_ARG_A,             // --a
+    MOVE_LINEAR_ARG_COUNT,         // Number of options
+};
+
+/** Options of move_arc, the index of their values */
+enum
+{
+    MOVE_ARC_ARG_FREQUENCY = 0, // --frq
+    MOVE_ARC_ARG_X,             // --x
+    MOVE_ARC_ARG_Y,             // --y
+    MOVE_ARC_ARG_I,             // --i
+    MOVE_ARC_ARG_J,             // --j
+    MOVE_ARC_ARG_CLOCKWISE,     // --cw
+    MOVE_ARC_ARG_COUNT,         // Number of options
+};
+
+/** Options of link_baud, the index of their values */
+enum
+{
+    LINK_BAUD_ARG_BAUDRATE = 0, // --baud
+    LINK_BAUD_ARG_COUNT,        // Number of options
+};
+
+/** Options of jog, the index of their values */
+enum
+{
+    JOG_MOTOR_ARG_VELOCITY = 0, // --vel
+    JOG_MOTOR_ARG_COUNT,        // Number of options
+};
+
+/** Options of halt, the index of their values */
+enum
+{
+    HALT_MOTOR_ARG_QUICK = 0,    // --quick
+    HALT_MOTOR_ARG_DECELERATION, // --decel
+    HALT_MOTOR_ARG_MOTOR,        // --motor
+    HALT_MOTOR_ARG_COUNT,        // Number of options
+};
+
+/** Options of ramp_cache, the index of their values */
+enum
+{
+    RAMP_CACHE_ARG_CLEAR = 0, // --clear
+    RAMP_CACHE_ARG_COUNT,     // Number of options
+};
+
+/** Options of trace, the index of their values */
+enum
+{
+    TRACE_ARG_ACTION = 0, // <dump|stats|clear>
+    TRACE_ARG_COUNT,      // Number of options
+};
+
+/** Options of move_to, the index of their values */
+enum
+{
+    MOVE_TO_ARG_FREQUENCY = 0, // --frq
+    MOVE_TO_ARG_POSITION,      // --pos
+    MOVE_TO_ARG_MOTOR,         // --motor
+    MOVE_TO_ARG_COUNT,         // Number of options
+};
+
+/** Options of home, the index of their values */
+enum
+{
+    HOME_MOTOR_ARG_FAST = 0,  // --fast
+    HOME_MOTOR_ARG_SLOW,      // --slow
+    HOME_MOTOR_ARG_BACKOFF,   // --backoff
+    HOME_MOTOR_ARG_TRAVEL,    // --travel
+    HOME_MOTOR_ARG_DIRECTION, // --dir
+    HOME_MOTOR_ARG_COUNT,     // Number of options
+};
+
+/** Options of position, the index of their values */
+enum
+{
+    POSITION_ARG_SET = 0, // --set
+    POSITION_ARG_COUNT,   // Number of options
+};
+
+/** Options of resonance, the index of their values */
+enum
+{
+    RESONANCE_ARG_LOW = 0, // --low
+    RESONANCE_ARG_HIGH,    // --high
+    RESONANCE_ARG_ACCEL,   // --accel
+    RESONANCE_ARG_CLEAR,   // --clear
+    RESONANCE_ARG_SAVE,    // --save
+    RESONANCE_ARG_COUNT,   // Number of options
+};
+
+/** Options of resonance_sweep, the index of their values */
+enum
+{
+    RESONANCE_SWEEP_ARG_FROM = 0,  // --from
+    RESONANCE_SWEEP_ARG_TO,        // --to
+    RESONANCE_SWEEP_ARG_STEP,      // --step
+    RESONANCE_SWEEP_ARG_DWELL,     // --dwell
+    RESONANCE_SWEEP_ARG_THRESHOLD, // --threshold
+    RESONANCE_SWEEP_ARG_DIRECTION, // --dir
+    RESONANCE_SWEEP_ARG_SAVE,      // --save
+    RESONANCE_SWEEP_ARG_COUNT,     // Number of options
+};
+
+/** Options of run_script, the index of their values */
+enum
+{
+    RUN_SCRIPT_ARG_FILE = 0, // <file>
+    RUN_SCRIPT_ARG_REPEAT,   // --repeat
+    RUN_SCRIPT_ARG_CHECK,    // --check
+    RUN_SCRIPT_ARG_STATS,    // --stats
+    RUN_SCRIPT_ARG_COUNT,    // Number of options
+};
+
+/** Options of trajectory, the index of their values */
+enum
+{
+    TRAJECTORY_ARG_RUN = 0, // --run
+    TRAJECTORY_ARG_COUNT,   // Number of options
+};
+
+/** Options of telemetry, the index of their values */
+enum
+{
+    TELEMETRY_ARG_PERIOD = 0, // --period
+    TELEMETRY_ARG_COUNT,      // Number of options
+};
+
+/** Options of encoder, the index of their values */
+enum
+{
+    ENCODER_ARG_SPEED = 0, // --speed
+    ENCODER_ARG_ACCEL,     // --accel
+    ENCODER_ARG_SAVE,      // --save
+    ENCODER_ARG_COUNT,     // Number of options
+};
+
+/** Options of autotune, the index of their values */
+enum
+{
+    AUTOTUNE_ARG_TRAVEL = 0, // --travel
+    AUTOTUNE_ARG_MAX_SPEED,  // --max-speed
+    AUTOTUNE_ARG_MAX_ACCEL,  // --max-accel
+    AUTOTUNE_ARG_SAVE,       // --save
+    AUTOTUNE_ARG_COUNT,      // Number of options
+};
+
+/** Options of step_clock, the index of their values */
+enum
+{
+    STEP_CLOCK_ARG_FREQUENCY = 0, // --frq
+    STEP_CLOCK_ARG_COUNT,         // Number of options
+};
+
+/** Options of console, the index of their values */
+enum
+{
+    CONSOLE_STATUS_ARG_VERBOSITY = 0, // --verbosity
+    CONSOLE_STATUS_ARG_COUNT,         // Number of options
+};
+
+/** Options of motion_status and motion_abort, the index of their values */
+enum
+{
+    MOTOR_SELECT_ARG_MOTOR = 0, // --motor
+    MOTOR_SELECT_ARG_COUNT,     // Number of options
+};
+
+/** Options of motors, the index of their values */
+enum
+{
+    MOTORS_ARG_MOTOR = 0, // --motor
+    MOTORS_ARG_SPEED,     // --speed
+    MOTORS_ARG_ACCEL,     // --accel
+    MOTORS_ARG_COUNT,     // Number of options
+};
+
+/**
+ * printf() of the command handlers that prints at Level and above only,
+ * below it neither the text is formatted nor are the arguments evaluated.
+ */
+#define CONSOLE_PRINTF(Level, ...)        \
+    do                                    \
+    {                                     \
+        if (Console_Verbosity >= (Level)) \
+        {                                 \
+            printf(__VA_ARGS__);          \
+        }                                 \
+    } while (0)
+
+static Console_Verbosity_t Console_Verbosity = CONSOLE_VERBOSITY; // What the command handlers print, see Console_Status()
+static QueueHandle_t Console_Uart_Queue;                          // Events of the console UART driver
+static TaskHandle_t Console_Writer_Task_Handle;                   // Drains Console_Output into the UART
+static Console_Output_t Console_Output;                           // Output of the console task, written without waiting
+static uint32_t Console_Rx_Overflows;                             // Received data dropped by a full FIFO or buffer
+static uint32_t Console_Rx_Errors;                                // Breaks, frame and parity errors
+
+/**
+ * @brief Next received byte of the console UART, waits on the UART event queue.
+ *
+ * The bytes in the driver buffer are read first, an event is only waited
+ * for once it is empty, so bytes of an event that was read in part are not
+ * left behind. A full FIFO or buffer drops what was received so far.
+ *
+ * @return The byte.
+ */
+static uint8_t Console_Read_Byte(void)
+{
+    static uint8_t Buffer[CONSOLE_UART_READ_SIZE];
+    static int Count = 0;    // Bytes in Buffer
+    static int Position = 0; // Next byte of Buffer
+    uart_event_t Event;
+
+    while (Position >= Count)
+    {
+        Position = 0;
+        Count = uart_read_bytes(CONSOLE_UART_0, Buffer, sizeof(Buffer), 0); // Only what was received already
+
+        if (Count > 0)
+        {
+            break;
+        }
+
+        Count = 0;
+
+        if (xQueueReceive(Console_Uart_Queue, &Event, portMAX_DELAY) != pdTRUE)
+        {
+            continue;
+        }
+
+        switch (Event.type)
+        {
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+            Console_Rx_Overflows++;
+            uart_flush_input(CONSOLE_UART_0);
+            xQueueReset(Console_Uart_Queue); // The events of the dropped data
+            break;
+        case UART_BREAK:
+        case UART_PARITY_ERR:
+        case UART_FRAME_ERR:
+            Console_Rx_Errors++;
+            break;
+        default:
+            break; // UART_DATA, read at the top of the loop
+        }
+    }
+
+    return Buffer[Position++];
+}
+
+/**
+ * @brief Read one line of the console UART without echo.
+ *
+ * CR or LF ends the line, the LF of a CRLF gives an empty line.
+ *
+ * @param Line Returns the line, NUL terminated without its ending.
+ * @param Size Size of Line.
+ * @return false if the line was longer than Size - 1 bytes, the rest of it is dropped.
+ */
+static bool Console_Read_Line(char *Line, size_t Size)
+{
+    size_t Length = 0;
+    bool Fits = true;
+
+    while (true)
+    {
+        uint8_t Byte = Console_Read_Byte();
+
+        if ((Byte == '\r') || (Byte == '\n'))
+        {
+            Line[Length] = '\0';
+            return Fits;
+        }
+
+        if ((Length + 1) < Size)
+        {
+            Line[Length++] = (char)Byte;
+        }
+        else
+        {
+            Fits = false;
+        }
+    }
+}
+
+/**
+ * @brief Queue a motion command and report its id.
+ *
+ * @param Command Command to queue, its Id is filled in.
+ * @return ESP_OK if queued, ESP_ERR_TIMEOUT if the motion queue is full.
+ */
+static esp_err_t Queue_Motion_Command(Motion_Command_t *Command)
+{
+    esp_err_t Function_Error = Motion_Queue_Enqueue(Command);
+
+    if (Function_Error == ESP_OK)
+    {
+        CONSOLE_PRINTF(CONSOLE_VERBOSITY_NORMAL, "QUEUED    : '#%d'\n", Command->Id); // Print the id of the queued command
+    }
+    else
+    {
+        printf("Motion queue full\n");
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Report a command queued for a station motor, like Queue_Motion_Command().
+ */
+static void Report_Station_Command(stepper_t Motor, esp_err_t Function_Error)
+{
+    Stepper_Status_t Status;
+
+    Stepper_Get_Status(Motor, &Status);
+
+    if (Function_Error == ESP_OK)
+    {
+        CONSOLE_PRINTF(CONSOLE_VERBOSITY_NORMAL, "QUEUED    : 'motor %u'\n", Status.Number); // Print the motor the command was queued for
+    }
+    else if (Function_Error == ESP_ERR_NO_MEM)
+    {
+        printf("Queue of motor %u full\n", Status.Number);
+    }
+}
+
+/**
+ * @brief Station motor selected by a --motor option.
+ *
+ * @param Value Value of the --motor option.
+ * @param Motor Returns the station motor, NULL for motor 0 on the motion queue or without the option.
+ * @return ESP_OK, ESP_ERR_NOT_FOUND if there is no such motor.
+ */
+static esp_err_t Select_Motor(const Command_Value_t *Value, stepper_t *Motor)
+{
+    *Motor = NULL;
+
+    if ((Value->Count == 0) || (Value->Value == 0))
+    {
+        return ESP_OK;
+    }
+
+    *Motor = ((Value->Value > 0) && (Value->Value <= UINT8_MAX)) ? Stepper_Get((uint8_t)Value->Value) : NULL;
+
+    if (*Motor == NULL)
+    {
+        printf("No motor %d, see motors\n", Value->Value);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Queue a relative move of a station motor and report it.
+ *
+ * @param Motor Station motor to move.
+ * @param Direction MOTOR_DIRECTION_FORWARD or MOTOR_DIRECTION_BACKWARD.
+ * @param Steps Steps to move.
+ * @param Frequency_Hz Cruise frequency.
+ * @return Result of Stepper_Move().
+ */
+static esp_err_t Queue_Station_Move(stepper_t Motor, int Direction, uint32_t Steps, int Frequency_Hz)
+{
+    if ((Steps > INT32_MAX) || (Frequency_Hz < 0))
+    {
+        printf("Invalid step count or frequency\n");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int32_t Signed_Steps = (Direction == MOTOR_DIRECTION_FORWARD) ? (int32_t)Steps : -(int32_t)Steps;
+    esp_err_t Function_Error = Stepper_Move(Motor, Signed_Steps, (uint32_t)Frequency_Hz);
+
+    Report_Station_Command(Motor, Function_Error);
+
+    return Function_Error;
+}
+
+esp_err_t Rotate_Angle(const Command_Value_t *Values)
 {
     esp_err_t Function_Error = ESP_OK;
 
-    int nerrors = arg_parse(argc, argv, (void **)&Rotate_angle_args); // Parse command line arguments
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "FREQUENCY : '%d'\n", Values[ROTATE_ANGLE_ARG_FREQUENCY].Value); // Print Frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "DIRECTION : '%d'\n", Values[ROTATE_ANGLE_ARG_DIRECTION].Value); // Print Direction
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "STEPS     : '%d'\n", Values[ROTATE_ANGLE_ARG_STEPS].Value);     // Print Steps
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "Angle     : '%s'\n", Values[ROTATE_ANGLE_ARG_ANGLE].Text);      // Print Angle
+
+    int64_t Angle_udeg = 0;       // Angle in micro degrees, parsed without floating point
+    uint32_t steps_for_angle = 0; // Total steps for the given angle
 
-    if (nerrors != 0)
+    if (!Motion_Math_Parse_Fixed(Values[ROTATE_ANGLE_ARG_ANGLE].Text, MOTION_MATH_ANGLE_DECIMALS, &Angle_udeg) || (Angle_udeg < 0) || (Values[ROTATE_ANGLE_ARG_STEPS].Value < 0) ||
+        !Motion_Math_Steps_For_Angle((uint32_t)Values[ROTATE_ANGLE_ARG_STEPS].Value, (uint64_t)Angle_udeg, &steps_for_angle))
     {
-        arg_print_errors(stderr, Rotate_angle_args.end, argv[0]); // Print errors if argument parsing fails
-        return 1;
+        printf("Invalid angle or step count\n");
+        return ESP_ERR_INVALID_ARG;
     }
 
-    printf("FREQUENCY : '%d'\n", Rotate_angle_args.Frequency->ival[0]); // Print Frequency
-    printf("DIRECTION : '%d'\n", Rotate_angle_args.Direction->ival[0]); // Print Direction
-    printf("STEPS     : '%d'\n", Rotate_angle_args.Steps->ival[0]);     // Print Steps
-    printf("Angle     : '%f'\n", Rotate_angle_args.Angle->dval[0]);     // Print Angle
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "Steps for %s degrees: %" PRIu32 "\n", Values[ROTATE_ANGLE_ARG_ANGLE].Text, steps_for_angle);
+
+    stepper_t Motor = NULL;
+
+    Function_Error = Select_Motor(&Values[ROTATE_ANGLE_ARG_MOTOR], &Motor);
 
-    float steps_for_angle = (Rotate_angle_args.Steps->ival[0] * Rotate_angle_args.Angle->dval[0]) / 360.0; // Calculate the total steps for the given angle
-    float time_per_step = 1.0 / Rotate_angle_args.Frequency->ival[0];                                      // Calculate time per step in seconds
-    float total_time = (time_per_step * steps_for_angle) * 1000;                                           // Calculate total time for the given angle
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    if (Motor != NULL)
+    {
+        return Queue_Station_Move(Motor, Values[ROTATE_ANGLE_ARG_DIRECTION].Value, steps_for_angle, Values[ROTATE_ANGLE_ARG_FREQUENCY].Value);
+    }
 
-    printf("Time taken for %.2f degrees: %d us\n", Rotate_angle_args.Angle->dval[0], (uint32_t)total_time * 1000);
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_MOVE,                              // Fixed number of steps
+        .Frequency_Hz = Values[ROTATE_ANGLE_ARG_FREQUENCY].Value, // Cruise frequency
+        .Steps = steps_for_angle,                                 // Steps for the angle
+        .Direction = Values[ROTATE_ANGLE_ARG_DIRECTION].Value,    // Direction of the move
+    };
 
-    Function_Error = Rotate_Stepper_Motor(Rotate_angle_args.Frequency->ival[0], Rotate_angle_args.Direction->ival[0], total_time);
+    Function_Error = Queue_Motion_Command(&Command);
 
     return Function_Error;
 }
 
-esp_err_t Rotate_Motor(int argc, char **argv)
+esp_err_t Rotate_Motor(const Command_Value_t *Values)
 {
     esp_err_t Function_Error = ESP_OK;
 
-    int nerrors = arg_parse(argc, argv, (void **)&Rotate_motor_args); // Parse command line arguments
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "FREQUENCY : '%d'\n", Values[ROTATE_MOTOR_ARG_FREQUENCY].Value); // Print Frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "DIRECTION : '%d'\n", Values[ROTATE_MOTOR_ARG_DIRECTION].Value); // Print Direction
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "STEPS     : '%d'\n", Values[ROTATE_MOTOR_ARG_STEPS].Value);     // Print Steps
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "Rotation  : '%d'\n", Values[ROTATE_MOTOR_ARG_ROTATION].Value);  // Print Rotation
 
-    if (nerrors != 0)
+    uint32_t total_steps = 0; // Total steps for all rotations
+
+    if ((Values[ROTATE_MOTOR_ARG_STEPS].Value < 0) || (Values[ROTATE_MOTOR_ARG_ROTATION].Value < 0) ||
+        !Motion_Math_Steps_For_Rotations((uint32_t)Values[ROTATE_MOTOR_ARG_STEPS].Value, (uint32_t)Values[ROTATE_MOTOR_ARG_ROTATION].Value, &total_steps))
     {
-        arg_print_errors(stderr, Rotate_motor_args.end, argv[0]); // Print errors if argument parsing fails
-        return 1;
+        printf("Invalid rotation or step count\n");
+        return ESP_ERR_INVALID_ARG;
     }
 
-    printf("FREQUENCY : '%d'\n", Rotate_motor_args.Frequency->ival[0]); // Print Frequency
-    printf("DIRECTION : '%d'\n", Rotate_motor_args.Direction->ival[0]); // Print Direction
-    printf("STEPS     : '%d'\n", Rotate_motor_args.Steps->ival[0]);     // Print Steps
-    printf("Rotation  : '%d'\n", Rotate_motor_args.Rotation->ival[0]);  // Print Rotation
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "Steps to complete rotations : '%" PRIu32 "'\n", total_steps); // Print total steps
+
+    stepper_t Motor = NULL;
+
+    Function_Error = Select_Motor(&Values[ROTATE_MOTOR_ARG_MOTOR], &Motor);
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
 
-    // Calculate total time for one rotation
-    float time_per_step = 1.0 / Rotate_motor_args.Frequency->ival[0];
-    float total_time = ((time_per_step * Rotate_motor_args.Steps->ival[0]) * 1000) * Rotate_motor_args.Rotation->ival[0];
+    if (Motor != NULL)
+    {
+        return Queue_Station_Move(Motor, Values[ROTATE_MOTOR_ARG_DIRECTION].Value, total_steps, Values[ROTATE_MOTOR_ARG_FREQUENCY].Value);
+    }
 
-    printf("Time to complete rotations : '%d us'\n", (uint32_t)total_time * 1000); // Print Rotation
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_MOVE,                              // Fixed number of steps
+        .Frequency_Hz = Values[ROTATE_MOTOR_ARG_FREQUENCY].Value, // Cruise frequency
+        .Steps = total_steps,                                     // Steps for all rotations
+        .Direction = Values[ROTATE_MOTOR_ARG_DIRECTION].Value,    // Direction of the move
+    };
 
-    Function_Error = Rotate_Stepper_Motor(Rotate_motor_args.Frequency->ival[0], Rotate_motor_args.Direction->ival[0], total_time);
+    Function_Error = Queue_Motion_Command(&Command);
 
     return Function_Error;
 }
@@ -65,15 +533,22 @@ esp_err_t Rotate_Motor(int argc, char **argv)
  * based on these arguments, setting the appropriate GPIO levels, PWM frequency,
  * and duty cycle. The function also prints the parsed arguments for debugging.
  *
- * @return 0 if successful, 1 if argument parsing fails.
+ * @return 0 if successful.
  */
-esp_err_t Quick_Start_Motor(void)
+esp_err_t Quick_Start_Motor(const Command_Value_t *Values)
 {
-    printf("FREQUENCY : 1Khz\n");    // Print Frequency
-    printf("DIRECTION : FORWARD\n"); // Print Direction
-    printf("DUTY CYCLE: 50\n");      // Print Duty cycle
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "FREQUENCY : 1Khz\n");    // Print Frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "DIRECTION : FORWARD\n"); // Print Direction
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "DUTY CYCLE: 50\n");      // Print Duty cycle
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_RUN,           // Continuous run
+        .Frequency_Hz = PWM_FREQUENCY_1KHZ,   // Default frequency
+        .Duty_Cycle = PWM_DUTY_CYCLE_50,      // Default duty cycle
+        .Direction = MOTOR_DIRECTION_FORWARD, // Default direction
+    };
 
-    return Start_Stepper_Motor(MOTOR_DIRECTION_FORWARD, PWM_FREQUENCY_1KHZ, PWM_DUTY_CYCLE_50);
+    return Queue_Motion_Command(&Command);
 }
 
 /**
@@ -84,180 +559,1606 @@ esp_err_t Quick_Start_Motor(void)
  * based on these arguments, setting the appropriate GPIO levels, PWM frequency,
  * and duty cycle. The function also prints the parsed arguments for debugging.
  *
- * @param argc Number of command-line arguments.
- * @param argv Array of command-line argument strings.
- * @return 0 if successful, 1 if argument parsing fails.
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if successful.
  */
-esp_err_t Start_Motor(int argc, char **argv)
+esp_err_t Start_Motor(const Command_Value_t *Values)
 {
     esp_err_t Function_Error = ESP_OK;
 
-    int nerrors = arg_parse(argc, argv, (void **)&Start_motor_args); // Parse command line arguments
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "FREQUENCY : '%d'\n", Values[START_MOTOR_ARG_FREQUENCY].Value);  // Print Frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "DIRECTION : '%d'\n", Values[START_MOTOR_ARG_DIRECTION].Value);  // Print Direction
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "DUTY CYCLE: '%d'\n", Values[START_MOTOR_ARG_DUTY_CYCLE].Value); // Print Steps
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_RUN,                              // Continuous run
+        .Frequency_Hz = Values[START_MOTOR_ARG_FREQUENCY].Value, // Cruise frequency
+        .Duty_Cycle = Values[START_MOTOR_ARG_DUTY_CYCLE].Value,  // PWM duty cycle
+        .Direction = Values[START_MOTOR_ARG_DIRECTION].Value,    // Direction of the motor
+    };
+
+    Function_Error = Queue_Motion_Command(&Command);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Queue a stop of the motor after the commands already queued.
+ *
+ * @return ESP_OK if queued, ESP_ERR_TIMEOUT if the motion queue is full.
+ */
+esp_err_t Stop_Motor(const Command_Value_t *Values)
+{
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_STOP, // Ramp down, stop the output and disable the driver
+    };
+
+    return Queue_Motion_Command(&Command);
+}
+
+/**
+ * @brief Print the state of the motion task and queue, or of a station motor with --motor.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK, ESP_ERR_NOT_FOUND for an unknown motor.
+ */
+esp_err_t Motion_Status(const Command_Value_t *Values)
+{
+    Motion_Queue_Status_t Status;
+    stepper_t Motor = NULL;
+
+    esp_err_t Function_Error = Select_Motor(&Values[MOTOR_SELECT_ARG_MOTOR], &Motor);
 
-    if (nerrors != 0)
+    if (Function_Error != ESP_OK)
     {
-        arg_print_errors(stderr, Start_motor_args.end, argv[0]); // Print errors if argument parsing fails
-        return 1;
+        return Function_Error;
     }
 
-    printf("FREQUENCY : '%d'\n", Start_motor_args.Frequency->ival[0]);  // Print Frequency
-    printf("DIRECTION : '%d'\n", Start_motor_args.Direction->ival[0]);  // Print Direction
-    printf("DUTY CYCLE: '%d'\n", Start_motor_args.Duty_cycle->ival[0]); // Print Steps
+    if (Motor != NULL)
+    {
+        Stepper_Status_t Motor_Status;
+
+        Stepper_Get_Status(Motor, &Motor_Status);
 
-    Function_Error = Start_Stepper_Motor(Start_motor_args.Direction->ival[0], Start_motor_args.Frequency->ival[0], Start_motor_args.Duty_cycle->ival[0]);
+        printf("STATE     : '%s'\n", Motor_Status.Busy ? "BUSY" : "IDLE");             // Print the motor task state
+        printf("FREQUENCY : '%" PRIu32 "' Hz\n", Motor_Status.Frequency_Hz);           // Print the step frequency applied last
+        printf("POSITION  : '%" PRId32 "'\n", Motor_Status.Position);                  // Print the absolute position
+        printf("PENDING   : '%" PRIu32 "'\n", Motor_Status.Pending);                   // Print the number of queued moves
+        printf("COMPLETED : '%" PRIu32 "'\n", Motor_Status.Completed);                 // Print the number of finished moves
+        printf("EXECUTED  : '%" PRIu32 "' steps\n", Motor_Status.Last_Executed_Steps); // Print the steps counted for the last move
+        printf("RESULT    : '%s'\n", esp_err_to_name(Motor_Status.Last_Error));        // Print the result of the last move
 
-    return Function_Error;
+        return ESP_OK;
+    }
+
+
+    Motion_Queue_Get_Status(&Status);
+
+    printf("STATE     : '%s'\n", Status.Jogging ? "JOGGING" : (Status.Busy ? "BUSY" : (Status.Running ? "RUNNING" : "IDLE"))); // Print the motion task state
+    printf("VELOCITY  : '%" PRId32 "' Hz\n", Status.Velocity_Hz);                                                              // Print the signed continuous frequency
+    printf("POSITION  : '%" PRId32 "'\n", Get_Stepper_Motor_Position());                                                       // Print the absolute position
+    printf("CURRENT   : '#%d'\n", Status.Current_Id);                                                                          // Print the command being executed or last executed
+    printf("PENDING   : '%d'\n", Status.Pending);                                                                              // Print the number of queued commands
+    printf("COMPLETED : '%d'\n", Status.Completed);                                                                            // Print the number of finished commands
+    printf("EXECUTED  : '%d' steps\n", Status.Last_Executed_Steps);                                                            // Print the steps counted for the last move
+    printf("RESULT    : '%s'\n", esp_err_to_name(Status.Last_Error));                                                          // Print the result of the last command
+
+    return ESP_OK;
 }
 
 /**
- * @brief Register the start_motor command with the console
+ * @brief Drop all queued motion commands, the running one completes.
  *
- * This function defines the command-line arguments for the start_motor command,
- * creates a console command structure, and registers the command with the console.
+ * @return ESP_OK
+ */
+esp_err_t Motion_Flush(const Command_Value_t *Values)
+{
+    return Motion_Queue_Flush();
+}
+
+/**
+ * @brief Drop all queued motion commands and stop the running one immediately.
  *
- * @return
- *     - ESP_OK: Successfully registered the command
- *     - ESP_ERR_NO_MEM: Insufficient memory to allocate command structure
- *     - ESP_ERR_INVALID_ARG: Invalid argument provided
- *     - ESP_ERR_INVALID_STATE: Console not initialized or other invalid state
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK if the abort was requested, ESP_ERR_TIMEOUT otherwise, ESP_ERR_NOT_FOUND for an unknown motor.
  */
-esp_err_t Register_Start_Motor_CMD(void)
+esp_err_t Motion_Abort(const Command_Value_t *Values)
 {
-    Start_motor_args.Frequency = arg_int0(NULL, "frq", "<t>", "Frequency of the PWM");           // Define timeout argument
-    Start_motor_args.Direction = arg_int0(NULL, "dir", "<t>", "Direction of the stepper motor"); // Define SSID argument
-    Start_motor_args.Duty_cycle = arg_int0(NULL, "duty", "<t>", "Duty cycle of the PWM");        // Define password argument
-    Start_motor_args.end = arg_end(2);                                                           // Define end marker for argument table
+    stepper_t Motor = NULL;
 
-    const esp_console_cmd_t join_cmd = {
-        .command = "start_motor",                      // Command name
-        .help = "Start moving the motor continuously", // Command description
-        .hint = NULL,                                  // Command hint (optional)
-        .func = &Start_Motor,                          // Command handler function
-        .argtable = &Start_motor_args                  // Argument table
-    };
+    esp_err_t Function_Error = Select_Motor(&Values[MOTOR_SELECT_ARG_MOTOR], &Motor);
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
 
-    return esp_console_cmd_register(&join_cmd); // Register the 'join' command with the console
+    return (Motor != NULL) ? Stepper_Abort(Motor) : Motion_Queue_Abort();
 }
 
-esp_err_t Register_Stop_Motor_CMD(void)
+/**
+ * @brief Queue an interpolated straight line over several axes.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if queued, ESP_ERR_TIMEOUT if the queue is full.
+ */
+esp_err_t Move_Linear(const Command_Value_t *Values)
 {
-    const esp_console_cmd_t join_cmd = {
-        .command = "stop_motor",                                 // Command name
-        .help = "Stop motor by disabling and also stop the PWM", // Command description
-        .hint = NULL,                                            // Command hint (optional)
-        .func = &Stop_Stepper_Motor,                             // Command handler function
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_LINEAR,                           // Interpolated line
+        .Frequency_Hz = Values[MOVE_LINEAR_ARG_FREQUENCY].Value, // Cruise frequency of the longest axis
     };
 
-    return esp_console_cmd_register(&join_cmd); // Register the 'join' command with the console
+    // Axes left out of the command do not move
+    Command.Axis_Steps[0] = (Values[MOVE_LINEAR_ARG_X].Count > 0) ? Values[MOVE_LINEAR_ARG_X].Value : 0;
+    Command.Axis_Steps[1] = (Values[MOVE_LINEAR_ARG_Y].Count > 0) ? Values[MOVE_LINEAR_ARG_Y].Value : 0;
+    Command.Axis_Steps[2] = (Values[MOVE_LINEAR_ARG_Z].Count > 0) ? Values[MOVE_LINEAR_ARG_Z].Value : 0;
+    Command.Axis_Steps[3] = (Values[MOVE_LINEAR_ARG_A].Count > 0) ? Values[MOVE_LINEAR_ARG_A].Value : 0;
+
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "FREQUENCY : '%d'\n", Command.Frequency_Hz);                                                                                              // Print Frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "STEPS     : X '%d' Y '%d' Z '%d' A '%d'\n", Command.Axis_Steps[0], Command.Axis_Steps[1], Command.Axis_Steps[2], Command.Axis_Steps[3]); // Print the steps of every axis
+
+    return Queue_Motion_Command(&Command);
 }
 
-esp_err_t Register_Quick_Start_Motor_CMD(void)
+/**
+ * @brief Queue an interpolated circular arc on axes X and Y.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if queued, ESP_ERR_TIMEOUT if the queue is full.
+ */
+esp_err_t Move_Arc(const Command_Value_t *Values)
 {
-    const esp_console_cmd_t join_cmd = {
-        .command = "quick_motor_start",            // Command name
-        .help = "start_motor_with_default_values", // Command description
-        .hint = NULL,                              // Command hint (optional)
-        .func = &Quick_Start_Motor,                // Command handler function
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_ARC,                                                 // Interpolated arc
+        .Frequency_Hz = Values[MOVE_ARC_ARG_FREQUENCY].Value,                       // Cruise tick frequency
+        .Axis_Steps = {Values[MOVE_ARC_ARG_X].Value, Values[MOVE_ARC_ARG_Y].Value}, // End point relative to the start
+        .Center = {Values[MOVE_ARC_ARG_I].Value, Values[MOVE_ARC_ARG_J].Value},     // Center relative to the start
+        .Clockwise = (Values[MOVE_ARC_ARG_CLOCKWISE].Value != 0),                   // Direction of travel
     };
 
-    return esp_console_cmd_register(&join_cmd); // Register the 'join' command with the console
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "FREQUENCY : '%d'\n", Command.Frequency_Hz);                                  // Print Frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "END       : X '%d' Y '%d'\n", Command.Axis_Steps[0], Command.Axis_Steps[1]); // Print the end point
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "CENTER    : I '%d' J '%d'\n", Command.Center[0], Command.Center[1]);         // Print the center
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "DIRECTION : '%s'\n", Command.Clockwise ? "CW" : "CCW");                      // Print the direction
+
+    return Queue_Motion_Command(&Command);
 }
 
-esp_err_t Register_Rotate_Motor_CMD(void)
+/**
+ * @brief Measure and print the throughput of the step interpolator.
+ *
+ * @return ESP_OK
+ */
+esp_err_t DDA_Benchmark(const Command_Value_t *Values)
 {
-    Rotate_motor_args.Frequency = arg_int0(NULL, "frq", "<t>", "Frequency of the PWM signal");        // Define frequency of the PWM
-    Rotate_motor_args.Direction = arg_int0(NULL, "dir", "<t>", "Direction of the stepper motor");     // Define direction of the motor
-    Rotate_motor_args.Steps = arg_int0(NULL, "step", "<t>", "Micro steps of the motor driver");       // Define steps of the motor
-    Rotate_motor_args.Rotation = arg_int0(NULL, "rotation", "<t>", "Number of rotation to be taken"); // Define rotation of the motor
-    Rotate_motor_args.end = arg_end(2);                                                               // Define end marker for argument table
+    Multi_Axis_Benchmark_t Result;
 
-    const esp_console_cmd_t join_cmd = {
-        .command = "rotate_motor",                  // Command name
-        .help = "Rotate motor for fixed rotations", // Command description
-        .hint = NULL,                               // Command hint (optional)
-        .func = &Rotate_Motor,                      // Command handler function
-        .argtable = &Rotate_motor_args              // Argument table
-    };
+    Multi_Axis_Benchmark(&Result);
+
+    printf("LINE      : '%d' ticks/s\n", Result.Line_Ticks_Per_Second); // Print the 4 axis line tick rate
+    printf("AGGREGATE : '%d' steps/s\n", Result.Line_Steps_Per_Second); // Print the steps of all axes per second
+    printf("ARC       : '%d' ticks/s\n", Result.Arc_Ticks_Per_Second);  // Print the circle tick rate
+    printf("TICK COST : '%d' ns\n", Result.Tick_Cost_ns);               // Print the cost of one tick with the profile encoding
 
-    return esp_console_cmd_register(&join_cmd); // Register the 'join' command with the console
+    return ESP_OK;
 }
 
-esp_err_t Register_Rotate_Angle_CMD(void)
+/**
+ * @brief Stream G-code lines from the console to the G-code task.
+ *
+ * Every accepted line is answered with "ok" as soon as it is in the ring
+ * buffer, so a sender can keep the buffer full. Streaming ends with M2,
+ * M30 or a line holding only '%'.
+ *
+ * @return ESP_OK
+ */
+esp_err_t Gcode_Stream(const Command_Value_t *Values)
 {
-    Rotate_angle_args.Frequency = arg_int0(NULL, "frq", "<t>", "Frequency of the PWM signal (in Hz)");                  // Set the PWM frequency for the stepper motor
-    Rotate_angle_args.Direction = arg_int0(NULL, "dir", "<t>", "Direction of the stepper motor (1 for CW, 0 for CCW)"); // Set the rotation direction (1 for clockwise, 0 for counterclockwise)
-    Rotate_angle_args.Steps = arg_int0(NULL, "step", "<t>", "Number of steps per full rotation of the motor");          // Set the number of microsteps per full rotation
-    Rotate_angle_args.Angle = arg_dbl0(NULL, "angle", "<t>", "Angle (in degrees) to rotate the motor");                 // Set the angle (in degrees) to rotate the motor
-    Rotate_angle_args.end = arg_end(2);
+    char Line[GCODE_MAX_LINE_LENGTH]; // Longest accepted line with its NUL
+    Gcode_Block_t Block;
 
-    const esp_console_cmd_t join_cmd = {
-        .command = "rotate_angle",                 // Command name
-        .help = "Moving the motor in fixed angle", // Command description
-        .hint = NULL,                              // Command hint (optional)
-        .func = &Rotate_Angle,                     // Command handler function
-        .argtable = &Rotate_angle_args             // Argument table
-    };
+    printf("G-code streaming, end with M2, M30 or '%%'\n");
+
+    while (true)
+    {
+        if (!Console_Read_Line(Line, sizeof(Line)))
+        {
+            printf("error: line too long\n");
+            continue;
+        }
+
+        if (Line[0] == '\0')
+        {
+            continue; // Nothing to acknowledge
+        }
 
-    return esp_console_cmd_register(&join_cmd); // Register the 'join' command with the console
+        if (strcmp(Line, "%") == 0)
+        {
+            break; // Program delimiter ends streaming
+        }
+
+        if (Gcode_Stream_Send_Line(Line, portMAX_DELAY) != ESP_OK)
+        {
+            printf("error: %s\n", Line);
+            continue;
+        }
+
+        printf("ok\n");
+
+        if (Gcode_Parse_Line(Line, &Block) && ((Block.M == 2) || (Block.M == 30)))
+        {
+            break; // End of program
+        }
+    }
+
+    return ESP_OK;
 }
 
 /**
- * @brief Initialize the console for UART communication and command-line interface.
+ * @brief Change the baud rate of the binary command link.
  *
- * This function configures the UART for console communication, sets up line endings,
- * configures the UART parameters, installs the UART driver, initializes the console,
- * configures the linenoise library for command completion and history, and sets other
- * necessary configurations for the console operation.
+ * @param Values Values of the options, see Console_Commands.
+ * @return Result of Binary_Link_Set_Baudrate().
  */
-void initialize_console(void)
+esp_err_t Link_Baud(const Command_Value_t *Values)
 {
-    /* Drain stdout before reconfiguring it */
-    fflush(stdout);        // Flush stdout to ensure all output is written
-    fsync(fileno(stdout)); // Synchronize the file descriptor for stdout
+    printf("BAUDRATE  : '%d'\n", Values[LINK_BAUD_ARG_BAUDRATE].Value); // Print the new baud rate
 
-    /* Disable buffering on stdin */
-    setvbuf(stdin, NULL, _IONBF, 0); // Disable buffering for stdin
+    return Binary_Link_Set_Baudrate(Values[LINK_BAUD_ARG_BAUDRATE].Value);
+}
 
-    /* Minicom, screen, idf_monitor send CR when ENTER key is pressed */
-    esp_vfs_dev_uart_port_set_rx_line_endings(CONSOLE_UART_0, ESP_LINE_ENDINGS_CR);
-    /* Move the caret to the beginning of the next line on '\n' */
-    esp_vfs_dev_uart_port_set_tx_line_endings(CONSOLE_UART_0, ESP_LINE_ENDINGS_CRLF);
+/**
+ * @brief Run the benchmark suite and print its JSON records.
+ *
+ * The suite drives the motor itself, so the motion queue has to be idle.
+ *
+ * @return Result of Motion_Benchmark_Run(), ESP_ERR_INVALID_STATE if motion commands are pending.
+ */
+esp_err_t Motion_Bench(const Command_Value_t *Values)
+{
+    Motion_Queue_Status_t Status;
 
-    /* Configure UART. Note that REF_TICK is used so that the baud rate remains
-     * correct while APB frequency is changing in light sleep mode.
-     */
-    const uart_config_t uart_config = {
-        .baud_rate = CONSOLE_UART_BAUDRATE_115200, // Set baud rate
-        .data_bits = UART_DATA_8_BITS,             // Set data bits to 8
-        .parity = UART_PARITY_DISABLE,             // Disable parity check
-        .stop_bits = UART_STOP_BITS_1,             // Set stop bits to 1
-        .source_clk = UART_SCLK_REF_TICK,          // Use reference clock
-    };
-    /* Install UART driver for interrupt-driven reads and writes */
-    ESP_ERROR_CHECK(uart_driver_install(CONSOLE_UART_0,
-                                        256, 0, 0, NULL, 0));
-    ESP_ERROR_CHECK(uart_param_config(CONSOLE_UART_0, &uart_config)); // Configure UART parameters
+    Motion_Queue_Get_Status(&Status);
 
-    /* Tell VFS to use UART driver */
-    esp_vfs_dev_uart_use_driver(CONSOLE_UART_0); // Use UART driver for VFS
+    if (Status.Busy || Status.Running || (Status.Pending > 0))
+    {
+        printf("Motion queue not idle, stop the motor first\n");
 
-    /* Initialize the console */
-    esp_console_config_t console_config = {
-        .max_cmdline_args = 8,     // Maximum number of command line arguments
-        .max_cmdline_length = 256, // Maximum command line length
-    };
-    ESP_ERROR_CHECK(esp_console_init(&console_config)); // Initialize the console with the specified configuration
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return Motion_Benchmark_Run(true);
+}
+
+/**
+ * @brief Set the jog velocity, entering the jog mode if needed.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return Result of Motion_Queue_Jog().
+ */
+esp_err_t Jog_Motor(const Command_Value_t *Values)
+{
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "VELOCITY  : '%d'\n", Values[JOG_MOTOR_ARG_VELOCITY].Value); // Print the new set-point
+
+    return Motion_Queue_Jog(Values[JOG_MOTOR_ARG_VELOCITY].Value);
+}
+
+/**
+ * @brief Stop the motor now along a decel ramp and drop the queued commands.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return Result of Motion_Queue_Stop() or Stepper_Stop(), ESP_ERR_INVALID_ARG for a zero deceleration.
+ */
+esp_err_t Halt_Motor(const Command_Value_t *Values)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    if (Values[HALT_MOTOR_ARG_DECELERATION].Count > 0)
+    {
+        Function_Error = Set_Stepper_Motor_Quick_Stop_Deceleration((uint32_t)Values[HALT_MOTOR_ARG_DECELERATION].Value);
 
-    /* Configure linenoise line completion library */
-    linenoiseSetMultiLine(1); // Enable multiline editing
+        if (Function_Error != ESP_OK)
+        {
+            return Function_Error;
+        }
+    }
+
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "STOP      : '%s'\n", (Values[HALT_MOTOR_ARG_QUICK].Count > 0) ? "QUICK" : "CONTROLLED"); // Print the kind of stop
 
-    /* Tell linenoise where to get command completions and hints */
-    linenoiseSetCompletionCallback(&esp_console_get_completion);                // Set completion callback
-    linenoiseSetHintsCallback((linenoiseHintsCallback *)&esp_console_get_hint); // Set hints callback
+    stepper_t Motor = NULL;
 
-    /* Set command history size */
-    linenoiseHistorySetMaxLen(100); // Set the maximum length of command history
+    Function_Error = Select_Motor(&Values[HALT_MOTOR_ARG_MOTOR], &Motor);
 
-    /* Don't return empty lines */
-    linenoiseAllowEmpty(false); // Disallow empty lines
-}
\ No newline at end of file
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    if (Motor != NULL)
+    {
+        return Stepper_Stop(Motor, (Values[HALT_MOTOR_ARG_QUICK].Count > 0) ? Get_Stepper_Motor_Quick_Stop_Deceleration() : 0); // Acceleration limit of the motor unless quick
+    }
+
+    return Motion_Queue_Stop(Values[HALT_MOTOR_ARG_QUICK].Count > 0);
+}
+
+/**
+ * @brief Print the counters of the ramp cache, optionally clear it.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK, the result of Ramp_Cache_Clear() with --clear.
+ */
+esp_err_t Ramp_Cache(const Command_Value_t *Values)
+{
+    Ramp_Cache_Stats_t Stats;
+
+    Ramp_Cache_Get_Stats(&Stats);
+
+    printf("HITS       : '%" PRIu32 "'\n", Stats.Hits);
+    printf("MISSES     : '%" PRIu32 "'\n", Stats.Misses);
+    printf("EVICTIONS  : '%" PRIu32 "'\n", Stats.Evictions);
+    printf("ENTRIES    : '%" PRIu32 "'\n", Stats.Entries);
+    printf("NVS LOADED : '%" PRIu32 "'\n", Stats.Nvs_Loaded);
+    printf("NVS WRITES : '%" PRIu32 "'\n", Stats.Nvs_Writes);
+    printf("NVS ERRORS : '%" PRIu32 "'\n", Stats.Nvs_Errors);
+
+    if (Values[RAMP_CACHE_ARG_CLEAR].Count > 0)
+    {
+        return Ramp_Cache_Clear(true); // Drop the ramps in RAM and NVS
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Print the step event trace or its latency histograms, or clear it.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return Result of the trace function.
+ */
+esp_err_t Trace(const Command_Value_t *Values)
+{
+    const char *Action = Values[TRACE_ARG_ACTION].Text;
+
+    if (strcmp(Action, "dump") == 0)
+    {
+        return Motion_Trace_Dump();
+    }
+
+    if (strcmp(Action, "stats") == 0)
+    {
+        return Motion_Trace_Print_Stats();
+    }
+
+    if (strcmp(Action, "clear") == 0)
+    {
+        return Motion_Trace_Clear();
+    }
+
+    printf("Unknown action '%s', use dump, stats or clear\n", Action);
+
+    return ESP_ERR_INVALID_ARG;
+}
+
+/**
+ * @brief Queue a move to an absolute position.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if queued, ESP_ERR_TIMEOUT if the queue is full.
+ */
+esp_err_t Move_To(const Command_Value_t *Values)
+{
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "FREQUENCY : '%d'\n", Values[MOVE_TO_ARG_FREQUENCY].Value); // Print Frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "POSITION  : '%d'\n", Values[MOVE_TO_ARG_POSITION].Value);  // Print the target position
+
+    stepper_t Motor = NULL;
+
+    esp_err_t Function_Error = Select_Motor(&Values[MOVE_TO_ARG_MOTOR], &Motor);
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    if (Motor != NULL)
+    {
+        if (Values[MOVE_TO_ARG_FREQUENCY].Value < 0)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        Function_Error = Stepper_Move_To(Motor, Values[MOVE_TO_ARG_POSITION].Value, (uint32_t)Values[MOVE_TO_ARG_FREQUENCY].Value);
+
+        Report_Station_Command(Motor, Function_Error);
+
+        return Function_Error;
+    }
+
+    if (!Stepper_Motor_Position_Referenced())
+    {
+        CONSOLE_PRINTF(CONSOLE_VERBOSITY_NORMAL, "Position not referenced, run home or position --set first\n");
+    }
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_MOVE_TO,                      // Absolute move
+        .Frequency_Hz = Values[MOVE_TO_ARG_FREQUENCY].Value, // Cruise frequency
+        .Position = Values[MOVE_TO_ARG_POSITION].Value,      // Target position
+    };
+
+    return Queue_Motion_Command(&Command);
+}
+
+/**
+ * @brief Queue a homing run against the limit switch.
+ *
+ * Options left out take the defaults of homing.h, the result is printed by
+ * the position command once the run finished.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if queued, ESP_ERR_TIMEOUT if the queue is full.
+ */
+esp_err_t Home_Motor(const Command_Value_t *Values)
+{
+    Homing_Config_t Config;
+
+    Homing_Get_Default_Config(&Config);
+
+    Config.Fast_Frequency_Hz = (Values[HOME_MOTOR_ARG_FAST].Count > 0) ? (uint32_t)Values[HOME_MOTOR_ARG_FAST].Value : Config.Fast_Frequency_Hz;
+    Config.Slow_Frequency_Hz = (Values[HOME_MOTOR_ARG_SLOW].Count > 0) ? (uint32_t)Values[HOME_MOTOR_ARG_SLOW].Value : Config.Slow_Frequency_Hz;
+    Config.Backoff_Steps = (Values[HOME_MOTOR_ARG_BACKOFF].Count > 0) ? (uint32_t)Values[HOME_MOTOR_ARG_BACKOFF].Value : Config.Backoff_Steps;
+    Config.Max_Travel_Steps = (Values[HOME_MOTOR_ARG_TRAVEL].Count > 0) ? (uint32_t)Values[HOME_MOTOR_ARG_TRAVEL].Value : Config.Max_Travel_Steps;
+    Config.Direction = (Values[HOME_MOTOR_ARG_DIRECTION].Count > 0) ? (uint8_t)Values[HOME_MOTOR_ARG_DIRECTION].Value : Config.Direction;
+
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "FAST      : '%" PRIu32 "'\n", Config.Fast_Frequency_Hz); // Print the fast approach frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "SLOW      : '%" PRIu32 "'\n", Config.Slow_Frequency_Hz); // Print the slow approach frequency
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "BACKOFF   : '%" PRIu32 "'\n", Config.Backoff_Steps);     // Print the back-off distance
+    CONSOLE_PRINTF(CONSOLE_VERBOSITY_VERBOSE, "DIRECTION : '%d'\n", Config.Direction);                  // Print the direction toward the switch
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_HOME,                   // Homing run
+        .Frequency_Hz = Config.Fast_Frequency_Hz,      // Fast approach
+        .Slow_Frequency_Hz = Config.Slow_Frequency_Hz, // Slow approach
+        .Backoff_Steps = Config.Backoff_Steps,         // Back-off distance
+        .Steps = Config.Max_Travel_Steps,              // Longest search
+        .Direction = Config.Direction,                 // Toward the switch
+    };
+
+    return Queue_Motion_Command(&Command);
+}
+
+/**
+ * @brief Print the absolute position and the last homing report, optionally set the position.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK.
+ */
+esp_err_t Position(const Command_Value_t *Values)
+{
+    Homing_Result_t Result;
+
+    if (Values[POSITION_ARG_SET].Count > 0)
+    {
+        Set_Stepper_Motor_Position(Values[POSITION_ARG_SET].Value); // The motor stands at this position now
+    }
+
+    Homing_Get_Result(&Result);
+
+    printf("POSITION  : '%" PRId32 "'\n", Get_Stepper_Motor_Position());
+    printf("REFERENCED: '%s'\n", Stepper_Motor_Position_Referenced() ? "YES" : "NO");
+    printf("SWITCH    : '%s'\n", Homing_Switch_Pressed() ? "PRESSED" : "RELEASED");
+    printf("HOMING    : '%s'\n", esp_err_to_name(Result.Result));
+    printf("FAST LATCH: '%" PRId32 "'\n", Result.Fast_Latch);
+    printf("SLOW LATCH: '%" PRId32 "'\n", Result.Slow_Latch);
+    printf("LATCH ERR : '%" PRId32 "' steps\n", Result.Latch_Error);
+    printf("OVERTRAVEL: '%" PRIu32 "' steps\n", Result.Overtravel_Steps);
+    printf("FAST SPEED: '%" PRIu32 "' Hz\n", Result.Fast_Speed_Hz);
+    printf("LATCH DLY : '%" PRIu32 "' us\n", Result.Latch_Delay_us);
+    printf("ISR LATCH : '%" PRIu32 "' us\n", Result.Isr_Latch_us);
+    printf("FAST TIME : '%" PRIu32 "' us\n", Result.Fast_Approach_us);
+    printf("BACKOFF   : '%" PRIu32 "' us\n", Result.Backoff_us);
+    printf("SLOW TIME : '%" PRIu32 "' us\n", Result.Slow_Approach_us);
+    printf("TOTAL TIME: '%" PRIu32 "' us\n", Result.Total_us);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Print the resonance bands and the last sweep, optionally change the bands.
+ *
+ * The changes are applied in the order clear, add, acceleration, and take
+ * effect with the next move. Without --save they are lost on a reboot.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG for an invalid or a further band, or the error of the NVS write.
+ */
+esp_err_t Resonance(const Command_Value_t *Values)
+{
+    esp_err_t Function_Error = ESP_OK;
+    Resonance_Table_t Table;
+    Resonance_Sweep_Report_t Report;
+
+    Motor_Resonance_Get_Table(&Table);
+
+    if (Values[RESONANCE_ARG_CLEAR].Count > 0)
+    {
+        Table.Band_Count = 0;
+    }
+
+    if ((Values[RESONANCE_ARG_LOW].Count > 0) != (Values[RESONANCE_ARG_HIGH].Count > 0))
+    {
+        printf("A band needs both --low and --high\n");
+
+        Function_Error = ESP_ERR_INVALID_ARG;
+    }
+    else if ((Values[RESONANCE_ARG_LOW].Count > 0) && !Resonance_Add_Band(&Table, (uint32_t)Values[RESONANCE_ARG_LOW].Value, (uint32_t)Values[RESONANCE_ARG_HIGH].Value))
+    {
+        printf("Band not added, invalid or the table is full\n");
+
+        Function_Error = ESP_ERR_INVALID_ARG;
+    }
+
+    Table.Crossing_Acceleration = (Values[RESONANCE_ARG_ACCEL].Count > 0) ? (uint32_t)Values[RESONANCE_ARG_ACCEL].Value : Table.Crossing_Acceleration;
+
+    if ((Function_Error == ESP_OK) && ((Values[RESONANCE_ARG_CLEAR].Count + Values[RESONANCE_ARG_LOW].Count + Values[RESONANCE_ARG_ACCEL].Count + Values[RESONANCE_ARG_SAVE].Count) > 0))
+    {
+        Function_Error = Motor_Resonance_Set_Table(&Table, Values[RESONANCE_ARG_SAVE].Count > 0);
+    }
+
+    Motor_Resonance_Get_Table(&Table);
+    Motor_Resonance_Get_Sweep(&Report);
+
+    printf("BANDS     : '%u'\n", Table.Band_Count);
+
+    for (uint8_t Index = 0; Index < Table.Band_Count; Index++)
+    {
+        printf("BAND %u    : '%" PRIu32 " - %" PRIu32 "' Hz\n", Index, Table.Bands[Index].Low_Hz, Table.Bands[Index].High_Hz);
+    }
+
+    printf("CROSSING  : '%" PRIu32 "' steps/s^2\n", Table.Crossing_Acceleration);
+    printf("SWEEP     : '%s'\n", esp_err_to_name(Report.Result));
+
+    for (uint16_t Point = 0; Point < Report.Points; Point++)
+    {
+        printf("%6" PRIu32 " Hz : '%" PRIu32 "'\n", Report.Start_Hz + (Point * Report.Step_Hz), Report.Counts[Point]);
+    }
+
+    if (Report.Points > 0)
+    {
+        printf("FOUND     : '%u' bands\n", Report.Bands_Found);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Queue a sweep that finds the resonance bands.
+ *
+ * Options left out take the defaults of motor_resonance.h, the result is
+ * printed by the resonance command once the sweep finished.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if queued, ESP_ERR_TIMEOUT if the queue is full.
+ */
+esp_err_t Resonance_Sweep(const Command_Value_t *Values)
+{
+    Resonance_Sweep_Config_t Config;
+
+    Motor_Resonance_Get_Default_Sweep(&Config);
+
+    Config.Start_Hz = (Values[RESONANCE_SWEEP_ARG_FROM].Count > 0) ? (uint32_t)Values[RESONANCE_SWEEP_ARG_FROM].Value : Config.Start_Hz;
+    Config.End_Hz = (Values[RESONANCE_SWEEP_ARG_TO].Count > 0) ? (uint32_t)Values[RESONANCE_SWEEP_ARG_TO].Value : Config.End_Hz;
+    Config.Step_Hz = (Values[RESONANCE_SWEEP_ARG_STEP].Count > 0) ? (uint32_t)Values[RESONANCE_SWEEP_ARG_STEP].Value : Config.Step_Hz;
+    Config.Dwell_ms = (Values[RESONANCE_SWEEP_ARG_DWELL].Count > 0) ? (uint32_t)Values[RESONANCE_SWEEP_ARG_DWELL].Value : Config.Dwell_ms;
+    Config.Threshold = (Values[RESONANCE_SWEEP_ARG_THRESHOLD].Count > 0) ? (uint32_t)Values[RESONANCE_SWEEP_ARG_THRESHOLD].Value : Config.Threshold;
+    Config.Direction = (Values[RESONANCE_SWEEP_ARG_DIRECTION].Count > 0) ? (uint8_t)Values[RESONANCE_SWEEP_ARG_DIRECTION].Value : Config.Direction;
+    Config.Save = Values[RESONANCE_SWEEP_ARG_SAVE].Count > 0;
+
+    printf("FROM      : '%" PRIu32 "'\n", Config.Start_Hz);  // Print the first frequency
+    printf("TO        : '%" PRIu32 "'\n", Config.End_Hz);    // Print the last frequency
+    printf("STEP      : '%" PRIu32 "'\n", Config.Step_Hz);   // Print the frequency increment
+    printf("DWELL     : '%" PRIu32 "'\n", Config.Dwell_ms);  // Print the time counted at every frequency
+    printf("THRESHOLD : '%" PRIu32 "'\n", Config.Threshold); // Print the sense edges marking a resonance
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_SWEEP,          // Resonance sweep
+        .Entry_Frequency_Hz = Config.Start_Hz, // First frequency
+        .Frequency_Hz = Config.End_Hz,         // Last frequency
+        .Step_Frequency_Hz = Config.Step_Hz,   // Frequency increment
+        .Dwell_ms = Config.Dwell_ms,           // Time counted at every frequency
+        .Threshold = Config.Threshold,         // Sense edges marking a resonance
+        .Direction = Config.Direction,         // Direction of the run
+        .Save = Config.Save,                   // Store the found bands
+    };
+
+    return Queue_Motion_Command(&Command);
+}
+
+/**
+ * @brief Print the summary and the run timing of a cached script.
+ */
+static void Print_Script_Stats(const Motor_Script_Stats_t *Stats)
+{
+    printf("OPS       : '%u'\n", Stats->Op_Count);                                                          // Print the bytecode length
+    printf("MOVES     : '%" PRIu32 "' per run\n", Stats->Moves_Per_Run);                                    // Print the moves of one run
+    printf("STEPS     : '%" PRIu64 "' per run\n", Stats->Steps_Per_Run);                                    // Print the relative steps of one run
+    printf("DWELL     : '%" PRIu64 "' ms per run\n", Stats->Dwell_ms_Per_Run);                              // Print the dwell time of one run
+    printf("COMPILES  : '%" PRIu32 "'\n", Stats->Compiles);                                                 // Print how often the file was compiled
+    printf("RUNS      : '%" PRIu32 "'\n", Stats->Runs);                                                     // Print the complete runs
+    printf("FAILED    : '%" PRIu32 "'\n", Stats->Failed_Runs);                                              // Print the runs ended early
+    printf("EXECUTED  : '%" PRIu64 "' steps\n", Stats->Executed_Steps);                                     // Print the steps of all runs
+    printf("LAST      : '%" PRIu64 "' us, '%s'\n", Stats->Last_Run_us, esp_err_to_name(Stats->Last_Error)); // Print the last run
+
+    if (Stats->Runs > 0)
+    {
+        printf("RUN TIME  : '%" PRIu64 " / %" PRIu64 " / %" PRIu64 "' us min/mean/max\n", Stats->Min_Run_us, Stats->Sum_Run_us / Stats->Runs, Stats->Max_Run_us);
+    }
+}
+
+/**
+ * @brief Compile a motion script from the script partition and queue its runs.
+ *
+ * The compiled script is cached, running the same unchanged file again
+ * neither reads nor parses it. With --check the script is only compiled
+ * and listed, with --stats the timing of the earlier runs is printed
+ * instead of running it.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if queued or printed, else the error of the load or the queue.
+ */
+esp_err_t Run_Script(const Command_Value_t *Values)
+{
+    Motor_Script_Handle_t Handle;
+    Motion_Script_Error_t Error;
+    Motor_Script_Stats_t Stats;
+    char Path[MOTOR_SCRIPT_MAX_PATH + sizeof(MOTOR_SCRIPT_BASE_PATH)];
+
+    const char *File = Values[RUN_SCRIPT_ARG_FILE].Text;
+    uint32_t Repeat = (Values[RUN_SCRIPT_ARG_REPEAT].Count > 0) ? (uint32_t)Values[RUN_SCRIPT_ARG_REPEAT].Value : 1;
+
+    if ((Values[RUN_SCRIPT_ARG_REPEAT].Count > 0) && (Values[RUN_SCRIPT_ARG_REPEAT].Value < 1))
+    {
+        printf("The repeat count must be at least 1\n");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    snprintf(Path, sizeof(Path), (File[0] == '/') ? "%s" : MOTOR_SCRIPT_BASE_PATH "/%s", File); // Names are relative to the script partition
+
+    esp_err_t Function_Error = Motor_Script_Load(Path, &Handle, &Error);
+
+    if (Function_Error != ESP_OK)
+    {
+        if (Error.Message != NULL)
+        {
+            printf("%s:%" PRIu32 ": %s\n", Path, Error.Line, Error.Message);
+        }
+        else
+        {
+            printf("SCRIPT    : '%s', '%s'\n", Path, esp_err_to_name(Function_Error));
+        }
+
+        return Function_Error;
+    }
+
+    printf("SCRIPT    : '%s', %s\n", Path, Handle.Cached ? "cached" : "compiled"); // Print where the bytecode came from
+
+    if (Values[RUN_SCRIPT_ARG_CHECK].Count > 0)
+    {
+        Motion_Script_Op_t Op;
+
+        for (uint16_t Index = 0; Motor_Script_Get_Op(&Handle, Index, &Op) == ESP_OK; Index++)
+        {
+            printf("%5u     : '%s %" PRId32 "'\n", Index, Motion_Script_Op_Name(Op.Opcode), Op.Argument); // Print the bytecode listing
+        }
+    }
+
+    if ((Values[RUN_SCRIPT_ARG_CHECK].Count > 0) || (Values[RUN_SCRIPT_ARG_STATS].Count > 0))
+    {
+        Function_Error = Motor_Script_Get_Stats(&Handle, &Stats);
+
+        if (Function_Error == ESP_OK)
+        {
+            Print_Script_Stats(&Stats);
+        }
+
+        return Function_Error;
+    }
+
+    printf("REPEAT    : '%" PRIu32 "'\n", Repeat); // Print the number of runs
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_SCRIPT, // Script run
+        .Script = Handle,              // Compiled script
+        .Repeat = Repeat,              // Runs back to back
+    };
+
+    return Queue_Motion_Command(&Command);
+}
+
+/**
+ * @brief Print the trajectory of the trajectory partition, and queue its play with --run.
+ *
+ * The trajectory is mapped and checked at start-up, see trajectory_player.h.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if queued or printed, else why the trajectory cannot be played or the error of the queue.
+ */
+esp_err_t Trajectory(const Command_Value_t *Values)
+{
+    Trajectory_Player_Info_t Info;
+
+    Trajectory_Player_Get_Info(&Info);
+
+    printf("PARTITION : '%s', %u bytes\n", TRAJECTORY_PLAYER_PARTITION, (unsigned)Info.Image_Size); // Print the mapped partition
+    printf("FORMAT    : '%s'\n", Trajectory_Result_Name(Info.Result));                              // Print the result of the check
+
+    if (Info.Result == TRAJECTORY_OK)
+    {
+        uint32_t Peak_Hz = (Info.Min_Period_Q8 > 0) ? (uint32_t)(((uint64_t)Info.Tick_Hz << 8) / Info.Min_Period_Q8) : 0;
+
+        printf("VERSION   : '%u'\n", Info.Version);                                                                                                         // Print the format version
+        printf("TICK      : '%" PRIu32 "' Hz\n", Info.Tick_Hz);                                                                                             // Print the tick rate of the periods
+        printf("RECORDS   : '%" PRIu32 "'\n", Info.Record_Count);                                                                                           // Print the number of records
+        printf("STEPS     : '%" PRIu32 "'\n", Info.Total_Steps);                                                                                            // Print the steps of all records
+        printf("DURATION  : '%" PRIu32 "' ms\n", Info.Duration_ms);                                                                                         // Print the planned duration
+        printf("PEAK      : '%" PRIu32 "' Hz\n", Peak_Hz);                                                                                                  // Print the highest step rate
+        printf("PLAYABLE  : '%s'\n", esp_err_to_name(Info.State));                                                                                          // Print whether the pulse engine can emit it
+        printf("PLAYS     : '%" PRIu32 "', '%" PRIu32 "' failed\n", Info.Plays, Info.Failed_Plays);                                                         // Print the plays so far
+        printf("LAST      : '%" PRIu32 "' steps, '%" PRIu64 "' us, '%s'\n", Info.Last_Executed_Steps, Info.Last_Play_us, esp_err_to_name(Info.Last_Error)); // Print the last play
+    }
+
+    if (Values[TRAJECTORY_ARG_RUN].Count == 0)
+    {
+        return ESP_OK;
+    }
+
+    if (Info.State != ESP_OK)
+    {
+        return Info.State; // Nothing playable in the partition
+    }
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_TRAJECTORY, // Trajectory play
+    };
+
+    return Queue_Motion_Command(&Command);
+}
+
+/**
+ * @brief Show the telemetry of the binary link, and set its period with --period.
+ *
+ * The frames go out on the binary link UART, see host/telemetry_decode.c.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return Result of Binary_Link_Set_Telemetry_Period(), 0 without --period.
+ */
+esp_err_t Telemetry(const Command_Value_t *Values)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    if (Values[TELEMETRY_ARG_PERIOD].Count > 0)
+    {
+        Function_Error = Binary_Link_Set_Telemetry_Period(Values[TELEMETRY_ARG_PERIOD].Value);
+    }
+
+    printf("PERIOD    : '%" PRIu32 "' ms, 0 is off\n", Binary_Link_Get_Telemetry_Period()); // Print the period of the frames
+    printf("FRAMES    : '%" PRIu32 "'\n", Binary_Link_Get_Telemetry_Frames());              // Print the frames sent so far
+
+    return Function_Error;
+}
+
+/**
+ * @brief Show the encoder, the monitor and the last autotune, and set the limits by hand.
+ *
+ * --speed and --accel replace the limits of the planner, both are needed.
+ * Without --save they are lost on a reboot.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG for invalid limits, or the error of the NVS write.
+ */
+esp_err_t Encoder(const Command_Value_t *Values)
+{
+    esp_err_t Function_Error = ESP_OK;
+    Motor_Encoder_Status_t Encoder_Status;
+    Motor_Encoder_Autotune_Report_t Report;
+    uint32_t Max_Frequency_Hz = 0;
+    uint32_t Acceleration = 0;
+
+    if ((Values[ENCODER_ARG_SPEED].Count > 0) != (Values[ENCODER_ARG_ACCEL].Count > 0))
+    {
+        printf("The limits need both --speed and --accel\n");
+
+        Function_Error = ESP_ERR_INVALID_ARG;
+    }
+    else if (Values[ENCODER_ARG_SPEED].Count > 0)
+    {
+        Function_Error = Motor_Encoder_Set_Limits((uint32_t)Values[ENCODER_ARG_SPEED].Value, (uint32_t)Values[ENCODER_ARG_ACCEL].Value, Values[ENCODER_ARG_SAVE].Count > 0);
+    }
+
+    Motor_Encoder_Get_Status(&Encoder_Status);
+    Motor_Encoder_Get_Autotune(&Report);
+    Get_Stepper_Motor_Limits(&Max_Frequency_Hz, &Acceleration);
+
+    printf("ACTIVE    : '%s'\n", Encoder_Status.Active ? "yes" : "no");                                                         // Print whether the moves are monitored
+    printf("COUNTS    : '%" PRId32 "'\n", Encoder_Status.Counts);                                                               // Print the encoder count
+    printf("MEASURED  : '%" PRId32 "' steps\n", Encoder_Status.Measured_Steps);                                                 // Print the encoder count in steps
+    printf("ERROR     : '%" PRId32 "' steps\n", Encoder_Status.Error);                                                          // Print the error of the last check
+    printf("MAX ERROR : '%" PRIu32 "' steps\n", Encoder_Status.Max_Error);                                                      // Print the largest error of the last move
+    printf("FOLLOWING : '%" PRIu32 "' steps\n", Encoder_Status.Config.Following_Limit);                                         // Print the following error limit
+    printf("STALL     : '%" PRIu32 "' steps\n", Encoder_Status.Config.Stall_Steps);                                             // Print the steps without progress that are a stall
+    printf("MOVES     : '%" PRIu32 "'\n", Encoder_Status.Moves);                                                                // Print the monitored moves
+    printf("CHECKS    : '%" PRIu32 "'\n", Encoder_Status.Checks);                                                               // Print the checks of all moves
+    printf("FAULTS    : '%" PRIu32 "', last '%s'\n", Encoder_Status.Faults, Closed_Loop_Fault_Name(Encoder_Status.Last_Fault)); // Print the faults
+    printf("LIMITS    : '%" PRIu32 "' Hz, '%" PRIu32 "' steps/s^2\n", Max_Frequency_Hz, Acceleration);                          // Print the limits of the planner
+    printf("AUTOTUNE  : '%s'\n", esp_err_to_name(Report.Result));                                                               // Print the result of the last autotune
+
+    if (Report.Trials > 0)
+    {
+        printf("TRIALS    : '%u', '%u' failed\n", Report.Trials, Report.Failed_Trials);
+        printf("FOUND     : '%" PRIu32 "' Hz, '%" PRIu32 "' steps/s^2%s\n", Report.Max_Frequency_Hz, Report.Acceleration, Report.Saved ? ", saved" : "");
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Queue an autotune of the speed and acceleration limits.
+ *
+ * Needs the encoder, the motor moves forward and back by up to --travel
+ * steps. The result is printed by the encoder command once it finished.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return 0 if queued, ESP_ERR_NOT_SUPPORTED without the encoder, ESP_ERR_TIMEOUT if the queue is full.
+ */
+esp_err_t Autotune(const Command_Value_t *Values)
+{
+    Autotune_Config_t Config;
+
+    if (!Motor_Encoder_Active())
+    {
+        printf("No encoder, build with STEPPER_MOTOR_ENCODER=1\n");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    Motor_Encoder_Get_Default_Autotune(&Config);
+
+    uint32_t Travel = (Values[AUTOTUNE_ARG_TRAVEL].Count > 0) ? (uint32_t)Values[AUTOTUNE_ARG_TRAVEL].Value : MOTOR_ENCODER_AUTOTUNE_TRAVEL;
+
+    Config.Max_Frequency_Hz = (Values[AUTOTUNE_ARG_MAX_SPEED].Count > 0) ? (uint32_t)Values[AUTOTUNE_ARG_MAX_SPEED].Value : Config.Max_Frequency_Hz;
+    Config.Max_Acceleration = (Values[AUTOTUNE_ARG_MAX_ACCEL].Count > 0) ? (uint32_t)Values[AUTOTUNE_ARG_MAX_ACCEL].Value : Config.Max_Acceleration;
+
+    printf("TRAVEL    : '%" PRIu32 "'\n", Travel);                  // Print the steps of one trial
+    printf("MAX SPEED : '%" PRIu32 "'\n", Config.Max_Frequency_Hz); // Print the highest frequency tried
+    printf("MAX ACCEL : '%" PRIu32 "'\n", Config.Max_Acceleration); // Print the highest acceleration tried
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_AUTOTUNE,             // Autotune
+        .Frequency_Hz = Config.Max_Frequency_Hz,     // Highest frequency tried
+        .Acceleration = Config.Max_Acceleration,     // Highest acceleration tried
+        .Steps = Travel,                             // Steps of one trial
+        .Save = Values[AUTOTUNE_ARG_SAVE].Count > 0, // Store the found limits
+    };
+
+    return Queue_Motion_Command(&Command);
+}
+
+/**
+ * @brief Show the LEDC timer setting of the step frequency, with the achieved frequency and its error.
+ *
+ * Without --frq the setting applied last, with it the setting the range
+ * manager would pick for that frequency, the timer is not changed then.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG if no setting reaches --frq, ESP_ERR_NOT_SUPPORTED on another pulse engine.
+ */
+esp_err_t Step_Clock(const Command_Value_t *Values)
+{
+    Ledc_Range_t Range;
+    uint32_t Resolution_Changes = 0;
+    esp_err_t Function_Error = Get_Stepper_Motor_Step_Clock(&Range, &Resolution_Changes);
+
+    if (Values[STEP_CLOCK_ARG_FREQUENCY].Count > 0)
+    {
+        Function_Error = ESP_OK;
+
+        if ((Values[STEP_CLOCK_ARG_FREQUENCY].Value <= 0) || !Ledc_Range_Select((uint32_t)Values[STEP_CLOCK_ARG_FREQUENCY].Value, LEDC_RANGE_MIN_BITS, &Range))
+        {
+            printf("No timer setting for '%" PRId32 "' Hz, 1 to %d Hz\n", Values[STEP_CLOCK_ARG_FREQUENCY].Value, LEDC_RANGE_MAX_FREQUENCY_HZ);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    else if (Function_Error != ESP_OK)
+    {
+        printf("The steps are not driven by the LEDC, see STEPPER_PULSE_ENGINE\n");
+        return Function_Error;
+    }
+
+    uint32_t Error_ppb = (Range.Error_ppb < 0) ? (uint32_t)(-(int64_t)Range.Error_ppb) : (uint32_t)Range.Error_ppb;
+
+    printf("REQUESTED : '%" PRIu32 "' Hz\n", Range.Requested_Hz);                                                                       // Print the frequency asked for
+    printf("ACHIEVED  : '%" PRIu64 ".%03u' Hz\n", Range.Achieved_mHz / 1000, (unsigned)(Range.Achieved_mHz % 1000));                    // Print the frequency the timer runs at
+    printf("ERROR     : '%s%" PRIu32 ".%03u' ppm\n", (Range.Error_ppb < 0) ? "-" : "", Error_ppb / 1000, (unsigned)(Error_ppb % 1000)); // Print the error of the achieved frequency
+    printf("CLOCK     : '%s', '%" PRIu32 "' Hz\n", Ledc_Range_Clock_Name(Range.Clock), Ledc_Range_Clock_Hz(Range.Clock));               // Print the source clock
+    printf("DIVIDER   : '%" PRIu32 " %" PRIu32 "/256'\n", Range.Divider >> LEDC_RANGE_DIVIDER_FRACTION_BITS, Range.Divider & 0xFF);     // Print the clock divider with its fraction
+    printf("RESOLUTION: '%u' bits\n", Range.Resolution_Bits);                                                                           // Print the duty resolution
+
+    if (Values[STEP_CLOCK_ARG_FREQUENCY].Count == 0)
+    {
+        printf("CHANGES   : '%" PRIu32 "'\n", Resolution_Changes); // Print the duty resolution switches since start-up
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Show the console UART and its output ring, optionally set the verbosity.
+ *
+ * At quiet the motion commands print only their errors, at normal also the
+ * id of every queued command and at verbose also their values. The
+ * commands that show something print it at every level.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG for a level out of range.
+ */
+esp_err_t Console_Status(const Command_Value_t *Values)
+{
+    static const char *const Verbosity_Names[CONSOLE_VERBOSITY_COUNT] = {"QUIET", "NORMAL", "VERBOSE"};
+
+    if (Values[CONSOLE_STATUS_ARG_VERBOSITY].Count > 0)
+    {
+        if ((Values[CONSOLE_STATUS_ARG_VERBOSITY].Value < 0) || (Values[CONSOLE_STATUS_ARG_VERBOSITY].Value >= CONSOLE_VERBOSITY_COUNT))
+        {
+            printf("Verbosity 0 to %d\n", CONSOLE_VERBOSITY_COUNT - 1);
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        Console_Verbosity = (Console_Verbosity_t)Values[CONSOLE_STATUS_ARG_VERBOSITY].Value;
+    }
+
+    printf("VERBOSITY : '%d', '%s'\n", Console_Verbosity, Verbosity_Names[Console_Verbosity]);                                                         // Print what the handlers print
+    printf("BAUDRATE  : '%d'\n", CONSOLE_UART_BAUDRATE);                                                                                               // Print the baud rate of the console
+    printf("BUFFERS   : RX '%d', TX '%d', OUTPUT '%d' bytes\n", CONSOLE_UART_RX_BUFFER_SIZE, CONSOLE_UART_TX_BUFFER_SIZE, CONSOLE_OUTPUT_BUFFER_SIZE); // Print the buffer sizes
+    printf("PENDING   : '%" PRIu32 "', most '%" PRIu32 "' bytes\n", Console_Output_Pending(&Console_Output), Console_Output.High_Water);               // Print the output waiting for the UART
+    printf("WRITTEN   : '%" PRIu32 "' bytes\n", Console_Output.Written);                                                                               // Print the output accepted since start-up
+    printf("DROPPED   : '%" PRIu32 "' bytes in '%" PRIu32 "' writes\n", Console_Output.Dropped, Console_Output.Drops);                                 // Print the output lost to a full ring
+    printf("RX LOST   : '%" PRIu32 "' overflows, '%" PRIu32 "' errors\n", Console_Rx_Overflows, Console_Rx_Errors);                                    // Print the receive faults
+
+    return ESP_OK;
+}
+
+/**
+ * @brief List the motors, their pins, resources and limits, and set the limits of a station motor.
+ *
+ * Motor 0 is the motor of the motion queue, the stations are numbered from
+ * 1 and run on their own tasks. --speed and --accel need --motor and both
+ * limits, they apply from the next planned move.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG for invalid limits, ESP_ERR_NOT_FOUND for an unknown motor.
+ */
+esp_err_t Motors(const Command_Value_t *Values)
+{
+    esp_err_t Function_Error = ESP_OK;
+    stepper_t Motor = NULL;
+    Stepper_Config_t Primary;
+
+    if ((Values[MOTORS_ARG_SPEED].Count > 0) || (Values[MOTORS_ARG_ACCEL].Count > 0))
+    {
+        Function_Error = Select_Motor(&Values[MOTORS_ARG_MOTOR], &Motor);
+
+        if (Function_Error != ESP_OK)
+        {
+            return Function_Error;
+        }
+
+        if ((Motor == NULL) || (Values[MOTORS_ARG_SPEED].Count == 0) || (Values[MOTORS_ARG_ACCEL].Count == 0) || (Values[MOTORS_ARG_SPEED].Value <= 0) || (Values[MOTORS_ARG_ACCEL].Value <= 0))
+        {
+            printf("The limits need --motor of a station, --speed and --accel, see encoder for motor 0\n");
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        Function_Error = Stepper_Set_Limits(Motor, (uint32_t)Values[MOTORS_ARG_SPEED].Value, (uint32_t)Values[MOTORS_ARG_ACCEL].Value);
+    }
+
+    Stepper_Get_Config(Stepper_Get(0), &Primary);
+
+    printf("MOTOR     : '0', PUL '%d', DIR '%d', EN '%d'\n", Primary.Step_Pin, Primary.Dir_Pin, Primary.Enable_Pin);                                                                                             // Print the pins of the motor of the motion queue
+    printf("RESOURCES : '%s', T'%u', CH'%u', PCNT'%u'\n", (Primary.Resources.Speed_Mode == LEDC_LOW_SPEED_MODE) ? "LS" : "HS", Primary.Resources.Timer, Primary.Resources.Channel, Primary.Resources.Pcnt_Unit); // Print its LEDC timer and channel and its PCNT unit
+    printf("POSITION  : '%" PRId32 "'\n", Get_Stepper_Motor_Position());                                                                                                                                         // Print its absolute position
+    printf("LIMITS    : '%" PRIu32 "' Hz, '%" PRIu32 "' steps/s^2\n", Primary.Max_Frequency_Hz, Primary.Acceleration);                                                                                           // Print its planner limits
+
+    for (uint8_t Number = 1; Number <= Stepper_Count(); Number++)
+    {
+        Stepper_Config_t Config;
+        Stepper_Status_t Status;
+
+        Motor = Stepper_Get(Number);
+
+        Stepper_Get_Config(Motor, &Config);
+        Stepper_Get_Status(Motor, &Status);
+
+        printf("MOTOR     : '%u', PUL '%d', DIR '%d', EN '%d'\n", Status.Number, Config.Step_Pin, Config.Dir_Pin, Config.Enable_Pin);                                                                            // Print the pins of the station
+        printf("RESOURCES : '%s', T'%u', CH'%u', PCNT'%u'\n", (Status.Resources.Speed_Mode == LEDC_LOW_SPEED_MODE) ? "LS" : "HS", Status.Resources.Timer, Status.Resources.Channel, Status.Resources.Pcnt_Unit); // Print its LEDC timer and channel and its PCNT unit
+        printf("STATE     : '%s', '%" PRIu32 "' pending\n", Status.Busy ? "BUSY" : "IDLE", Status.Pending);                                                                                                      // Print whether it moves
+        printf("POSITION  : '%" PRId32 "'\n", Status.Position);                                                                                                                                                  // Print its absolute position
+        printf("LIMITS    : '%" PRIu32 "' Hz, '%" PRIu32 "' steps/s^2\n", Config.Max_Frequency_Hz, Config.Acceleration);                                                                                         // Print its planner limits
+    }
+
+    return Function_Error;
+}
+
+/* Options of the commands, in the order of the enums at the top of the file */
+
+static const Command_Option_t Start_Motor_Options[START_MOTOR_ARG_COUNT] = {
+    [START_MOTOR_ARG_FREQUENCY] = {"frq", COMMAND_OPTION_INT, false, "<t>", "Frequency of the PWM"},
+    [START_MOTOR_ARG_DIRECTION] = {"dir", COMMAND_OPTION_INT, false, "<t>", "Direction of the stepper motor"},
+    [START_MOTOR_ARG_DUTY_CYCLE] = {"duty", COMMAND_OPTION_INT, false, "<t>", "Duty cycle of the PWM"},
+};
+
+static const Command_Option_t Rotate_Motor_Options[ROTATE_MOTOR_ARG_COUNT] = {
+    [ROTATE_MOTOR_ARG_FREQUENCY] = {"frq", COMMAND_OPTION_INT, false, "<t>", "Frequency of the PWM signal"},
+    [ROTATE_MOTOR_ARG_DIRECTION] = {"dir", COMMAND_OPTION_INT, false, "<t>", "Direction of the stepper motor"},
+    [ROTATE_MOTOR_ARG_STEPS] = {"step", COMMAND_OPTION_INT, false, "<t>", "Micro steps of the motor driver"},
+    [ROTATE_MOTOR_ARG_ROTATION] = {"rotation", COMMAND_OPTION_INT, false, "<t>", "Number of rotation to be taken"},
+    [ROTATE_MOTOR_ARG_MOTOR] = {"motor", COMMAND_OPTION_INT, false, "<t>", "Motor number, 0 (default) for the motion queue, see motors"},
+};
+
+static const Command_Option_t Rotate_Angle_Options[ROTATE_ANGLE_ARG_COUNT] = {
+    [ROTATE_ANGLE_ARG_FREQUENCY] = {"frq", COMMAND_OPTION_INT, false, "<t>", "Frequency of the PWM signal (in Hz)"},
+    [ROTATE_ANGLE_ARG_DIRECTION] = {"dir", COMMAND_OPTION_INT, false, "<t>", "Direction of the stepper motor (1 for CW, 0 for CCW)"},
+    [ROTATE_ANGLE_ARG_STEPS] = {"step", COMMAND_OPTION_INT, false, "<t>", "Number of steps per full rotation of the motor"},
+    [ROTATE_ANGLE_ARG_ANGLE] = {"angle", COMMAND_OPTION_TEXT, false, "<t>", "Angle (in degrees) to rotate the motor"},
+    [ROTATE_ANGLE_ARG_MOTOR] = {"motor", COMMAND_OPTION_INT, false, "<t>", "Motor number, 0 (default) for the motion queue, see motors"},
+};
+
+static const Command_Option_t Move_Linear_Options[MOVE_LINEAR_ARG_COUNT] = {
+    [MOVE_LINEAR_ARG_FREQUENCY] = {"frq", COMMAND_OPTION_INT, true, "<t>", "Step frequency of the longest axis (in Hz)"},
+    [MOVE_LINEAR_ARG_X] = {"x", COMMAND_OPTION_INT, false, "<t>", "Signed steps of axis X"},
+    [MOVE_LINEAR_ARG_Y] = {"y", COMMAND_OPTION_INT, false, "<t>", "Signed steps of axis Y"},
+    [MOVE_LINEAR_ARG_Z] = {"z", COMMAND_OPTION_INT, false, "<t>", "Signed steps of axis Z"},
+    [MOVE_LINEAR_ARG_A] = {"a", COMMAND_OPTION_INT, false, "<t>", "Signed steps of axis A"},
+};
+
+static const Command_Option_t Move_Arc_Options[MOVE_ARC_ARG_COUNT] = {
+    [MOVE_ARC_ARG_FREQUENCY] = {"frq", COMMAND_OPTION_INT, true, "<t>", "Step frequency along the arc (in Hz)"},
+    [MOVE_ARC_ARG_X] = {"x", COMMAND_OPTION_INT, true, "<t>", "End point X relative to the start"},
+    [MOVE_ARC_ARG_Y] = {"y", COMMAND_OPTION_INT, true, "<t>", "End point Y relative to the start"},
+    [MOVE_ARC_ARG_I] = {"i", COMMAND_OPTION_INT, true, "<t>", "Center X relative to the start"},
+    [MOVE_ARC_ARG_J] = {"j", COMMAND_OPTION_INT, true, "<t>", "Center Y relative to the start"},
+    [MOVE_ARC_ARG_CLOCKWISE] = {"cw", COMMAND_OPTION_INT, true, "<t>", "Arc direction (1 for CW, 0 for CCW)"},
+};
+
+static const Command_Option_t Link_Baud_Options[LINK_BAUD_ARG_COUNT] = {
+    [LINK_BAUD_ARG_BAUDRATE] = {"baud", COMMAND_OPTION_INT, true, "<t>", "Baud rate of the binary link"},
+};
+
+static const Command_Option_t Jog_Motor_Options[JOG_MOTOR_ARG_COUNT] = {
+    [JOG_MOTOR_ARG_VELOCITY] = {"vel", COMMAND_OPTION_INT, true, "<t>", "Signed step frequency, negative backward, 0 stops"},
+};
+
+static const Command_Option_t Halt_Motor_Options[HALT_MOTOR_ARG_COUNT] = {
+    [HALT_MOTOR_ARG_QUICK] = {"quick", COMMAND_OPTION_FLAG, false, NULL, "Use the quick stop deceleration"},
+    [HALT_MOTOR_ARG_DECELERATION] = {"decel", COMMAND_OPTION_INT, false, "<t>", "Set the quick stop deceleration first"},
+    [HALT_MOTOR_ARG_MOTOR] = {"motor", COMMAND_OPTION_INT, false, "<t>", "Motor number, 0 (default) for the motion queue, see motors"},
+};
+
+static const Command_Option_t Ramp_Cache_Options[RAMP_CACHE_ARG_COUNT] = {
+    [RAMP_CACHE_ARG_CLEAR] = {"clear", COMMAND_OPTION_FLAG, false, NULL, "Drop the cached ramps in RAM and NVS"},
+};
+
+static const Command_Option_t Trace_Options[TRACE_ARG_COUNT] = {
+    [TRACE_ARG_ACTION] = {NULL, COMMAND_OPTION_TEXT, true, "<dump|stats|clear>", "Print the events, print the latency histograms or drop the events"},
+};
+
+static const Command_Option_t Move_To_Options[MOVE_TO_ARG_COUNT] = {
+    [MOVE_TO_ARG_FREQUENCY] = {"frq", COMMAND_OPTION_INT, true, "<t>", "Cruise frequency of the move (in Hz)"},
+    [MOVE_TO_ARG_POSITION] = {"pos", COMMAND_OPTION_INT, true, "<t>", "Absolute target position in steps"},
+    [MOVE_TO_ARG_MOTOR] = {"motor", COMMAND_OPTION_INT, false, "<t>", "Motor number, 0 (default) for the motion queue, see motors"},
+};
+
+static const Command_Option_t Home_Motor_Options[HOME_MOTOR_ARG_COUNT] = {
+    [HOME_MOTOR_ARG_FAST] = {"fast", COMMAND_OPTION_INT, false, "<t>", "Frequency of the fast approach (in Hz)"},
+    [HOME_MOTOR_ARG_SLOW] = {"slow", COMMAND_OPTION_INT, false, "<t>", "Frequency of the slow approach (in Hz)"},
+    [HOME_MOTOR_ARG_BACKOFF] = {"backoff", COMMAND_OPTION_INT, false, "<t>", "Steps to back off before the slow approach"},
+    [HOME_MOTOR_ARG_TRAVEL] = {"travel", COMMAND_OPTION_INT, false, "<t>", "Longest search for the switch in steps"},
+    [HOME_MOTOR_ARG_DIRECTION] = {"dir", COMMAND_OPTION_INT, false, "<t>", "Direction toward the switch (1 forward, 0 backward)"},
+};
+
+static const Command_Option_t Position_Options[POSITION_ARG_COUNT] = {
+    [POSITION_ARG_SET] = {"set", COMMAND_OPTION_INT, false, "<t>", "Position the motor stands at now"},
+};
+
+static const Command_Option_t Resonance_Options[RESONANCE_ARG_COUNT] = {
+    [RESONANCE_ARG_LOW] = {"low", COMMAND_OPTION_INT, false, "<t>", "Highest safe frequency below a new band (in Hz)"},
+    [RESONANCE_ARG_HIGH] = {"high", COMMAND_OPTION_INT, false, "<t>", "Lowest safe frequency above a new band (in Hz)"},
+    [RESONANCE_ARG_ACCEL] = {"accel", COMMAND_OPTION_INT, false, "<t>", "Acceleration the bands are crossed at (steps/s^2)"},
+    [RESONANCE_ARG_CLEAR] = {"clear", COMMAND_OPTION_FLAG, false, NULL, "Remove all bands"},
+    [RESONANCE_ARG_SAVE] = {"save", COMMAND_OPTION_FLAG, false, NULL, "Write the bands to NVS"},
+};
+
+static const Command_Option_t Resonance_Sweep_Options[RESONANCE_SWEEP_ARG_COUNT] = {
+    [RESONANCE_SWEEP_ARG_FROM] = {"from", COMMAND_OPTION_INT, false, "<t>", "First frequency of the sweep (in Hz)"},
+    [RESONANCE_SWEEP_ARG_TO] = {"to", COMMAND_OPTION_INT, false, "<t>", "Last frequency of the sweep (in Hz)"},
+    [RESONANCE_SWEEP_ARG_STEP] = {"step", COMMAND_OPTION_INT, false, "<t>", "Frequency increment (in Hz)"},
+    [RESONANCE_SWEEP_ARG_DWELL] = {"dwell", COMMAND_OPTION_INT, false, "<t>", "Time counted at every frequency (in ms)"},
+    [RESONANCE_SWEEP_ARG_THRESHOLD] = {"threshold", COMMAND_OPTION_INT, false, "<t>", "Sense edges marking a resonant frequency"},
+    [RESONANCE_SWEEP_ARG_DIRECTION] = {"dir", COMMAND_OPTION_INT, false, "<t>", "Direction of the run (1 forward, 0 backward)"},
+    [RESONANCE_SWEEP_ARG_SAVE] = {"save", COMMAND_OPTION_FLAG, false, NULL, "Write the found bands to NVS"},
+};
+
+static const Command_Option_t Run_Script_Options[RUN_SCRIPT_ARG_COUNT] = {
+    [RUN_SCRIPT_ARG_FILE] = {NULL, COMMAND_OPTION_TEXT, true, "<file>", "Script file, relative to " MOTOR_SCRIPT_BASE_PATH},
+    [RUN_SCRIPT_ARG_REPEAT] = {"repeat", COMMAND_OPTION_INT, false, "<t>", "Runs back to back (default 1)"},
+    [RUN_SCRIPT_ARG_CHECK] = {"check", COMMAND_OPTION_FLAG, false, NULL, "Compile and list the script without running it"},
+    [RUN_SCRIPT_ARG_STATS] = {"stats", COMMAND_OPTION_FLAG, false, NULL, "Print the timing of the earlier runs"},
+};
+
+static const Command_Option_t Trajectory_Options[TRAJECTORY_ARG_COUNT] = {
+    [TRAJECTORY_ARG_RUN] = {"run", COMMAND_OPTION_FLAG, false, NULL, "Queue a play of the trajectory"},
+};
+
+static const Command_Option_t Telemetry_Options[TELEMETRY_ARG_COUNT] = {
+    [TELEMETRY_ARG_PERIOD] = {"period", COMMAND_OPTION_INT, false, "<ms>", "Period of the telemetry frames, 0 switches them off"},
+};
+
+static const Command_Option_t Encoder_Options[ENCODER_ARG_COUNT] = {
+    [ENCODER_ARG_SPEED] = {"speed", COMMAND_OPTION_INT, false, "<t>", "Highest cruise frequency (in Hz)"},
+    [ENCODER_ARG_ACCEL] = {"accel", COMMAND_OPTION_INT, false, "<t>", "Acceleration (steps/s^2)"},
+    [ENCODER_ARG_SAVE] = {"save", COMMAND_OPTION_FLAG, false, NULL, "Write the limits to NVS"},
+};
+
+static const Command_Option_t Autotune_Options[AUTOTUNE_ARG_COUNT] = {
+    [AUTOTUNE_ARG_TRAVEL] = {"travel", COMMAND_OPTION_INT, false, "<t>", "Steps of one trial move, forward and back"},
+    [AUTOTUNE_ARG_MAX_SPEED] = {"max-speed", COMMAND_OPTION_INT, false, "<t>", "Highest frequency tried (in Hz)"},
+    [AUTOTUNE_ARG_MAX_ACCEL] = {"max-accel", COMMAND_OPTION_INT, false, "<t>", "Highest acceleration tried (steps/s^2)"},
+    [AUTOTUNE_ARG_SAVE] = {"save", COMMAND_OPTION_FLAG, false, NULL, "Write the found limits to NVS"},
+};
+
+static const Command_Option_t Step_Clock_Options[STEP_CLOCK_ARG_COUNT] = {
+    [STEP_CLOCK_ARG_FREQUENCY] = {"frq", COMMAND_OPTION_INT, false, "<t>", "Show the setting for this step frequency (in Hz)"},
+};
+
+static const Command_Option_t Console_Status_Options[CONSOLE_STATUS_ARG_COUNT] = {
+    [CONSOLE_STATUS_ARG_VERBOSITY] = {"verbosity", COMMAND_OPTION_INT, false, "<t>", "0 quiet, 1 normal, 2 also the values of the motion commands"},
+};
+
+static const Command_Option_t Motor_Select_Options[MOTOR_SELECT_ARG_COUNT] = {
+    [MOTOR_SELECT_ARG_MOTOR] = {"motor", COMMAND_OPTION_INT, false, "<t>", "Motor number, 0 (default) for the motion queue, see motors"},
+};
+
+static const Command_Option_t Motors_Options[MOTORS_ARG_COUNT] = {
+    [MOTORS_ARG_MOTOR] = {"motor", COMMAND_OPTION_INT, false, "<t>", "Station motor whose limits are set"},
+    [MOTORS_ARG_SPEED] = {"speed", COMMAND_OPTION_INT, false, "<t>", "Highest cruise frequency (in Hz)"},
+    [MOTORS_ARG_ACCEL] = {"accel", COMMAND_OPTION_INT, false, "<t>", "Acceleration (steps/s^2)"},
+};
+
+/** Options of heap, the index of their values */
+enum
+{
+    HEAP_ARG_CLEAR = 0, // --clear
+    HEAP_ARG_COUNT,     // Number of options
+};
+
+static const Command_Option_t Heap_Options[HEAP_ARG_COUNT] = {
+    [HEAP_ARG_CLEAR] = {"clear", COMMAND_OPTION_FLAG, false, NULL, "Restart the counters of the commands"},
+};
+
+/** Command of the console */
+typedef struct
+{
+    const char *Name;                                    // Word that runs the command
+    const char *Help;                                    // Description in the help
+    esp_err_t (*Handler)(const Command_Value_t *Values); // Runs the command with the parsed options
+    const Command_Option_t *Options;                     // Options of the command, NULL if none
+    size_t Option_Count;                                 // Number of options
+} Console_Command_t;
+
+/** Heap use of the commands since start-up or heap --clear */
+typedef struct
+{
+    uint32_t Commands;            // Commands run
+    uint32_t Allocating_Commands; // Commands the heap was used during
+    uint32_t Traced_Allocations;  // Allocations during the commands, with CONFIG_HEAP_TRACING_STANDALONE
+    const char *Last_Allocating;  // Last command the heap was used during, NULL if none
+} Console_Heap_Stats_t;
+
+static esp_err_t Console_Help(const Command_Value_t *Values);
+static esp_err_t Console_Heap(const Command_Value_t *Values);
+
+/** All commands of the console, fixed at compile time */
+static const Console_Command_t Console_Commands[] = {
+    {"help", "Print the commands and their options", &Console_Help, NULL, 0},
+    {"start_motor", "Start moving the motor continuously", &Start_Motor, Start_Motor_Options, START_MOTOR_ARG_COUNT},
+    {"stop_motor", "Stop motor by disabling and also stop the PWM, after the queued commands", &Stop_Motor, NULL, 0},
+    {"quick_motor_start", "start_motor_with_default_values", &Quick_Start_Motor, NULL, 0},
+    {"rotate_motor", "Rotate motor for fixed rotations", &Rotate_Motor, Rotate_Motor_Options, ROTATE_MOTOR_ARG_COUNT},
+    {"rotate_angle", "Moving the motor in fixed angle", &Rotate_Angle, Rotate_Angle_Options, ROTATE_ANGLE_ARG_COUNT},
+    {"motion_status", "Show the state of the motion queue", &Motion_Status, Motor_Select_Options, MOTOR_SELECT_ARG_COUNT},
+    {"motion_flush", "Drop the queued motion commands, the running one ends", &Motion_Flush, NULL, 0},
+    {"motion_abort", "Drop the queued motion commands and stop the motor now", &Motion_Abort, Motor_Select_Options, MOTOR_SELECT_ARG_COUNT},
+    {"move_linear", "Move several axes along a straight line", &Move_Linear, Move_Linear_Options, MOVE_LINEAR_ARG_COUNT},
+    {"move_arc", "Move axes X and Y along a circular arc", &Move_Arc, Move_Arc_Options, MOVE_ARC_ARG_COUNT},
+    {"dda_bench", "Measure the step interpolator throughput", &DDA_Benchmark, NULL, 0},
+    {"gcode", "Stream G-code lines until M2, M30 or a '%' line", &Gcode_Stream, NULL, 0},
+    {"link_baud", "Change the baud rate of the binary link", &Link_Baud, Link_Baud_Options, LINK_BAUD_ARG_COUNT},
+    {"motion_bench", "Benchmark step latency, accuracy and rate, JSON output", &Motion_Bench, NULL, 0},
+    {"jog", "Ramp to a velocity from the current one, stream it", &Jog_Motor, Jog_Motor_Options, JOG_MOTOR_ARG_COUNT},
+    {"halt", "Stop along a decel ramp now, drop the queued moves", &Halt_Motor, Halt_Motor_Options, HALT_MOTOR_ARG_COUNT},
+    {"ramp_cache", "Print the ramp cache counters, or clear it", &Ramp_Cache, Ramp_Cache_Options, RAMP_CACHE_ARG_COUNT},
+    {"trace", "Step event trace and its latency histograms", &Trace, Trace_Options, TRACE_ARG_COUNT},
+    {"move_to", "Move to an absolute step position", &Move_To, Move_To_Options, MOVE_TO_ARG_COUNT},
+    {"home", "Find the limit switch and make it position 0", &Home_Motor, Home_Motor_Options, HOME_MOTOR_ARG_COUNT},
+    {"position", "Show the position and the last homing report", &Position, Position_Options, POSITION_ARG_COUNT},
+    {"resonance", "Show or change the resonance bands and the last sweep", &Resonance, Resonance_Options, RESONANCE_ARG_COUNT},
+    {"resonance_sweep", "Run through the frequencies and find the resonances", &Resonance_Sweep, Resonance_Sweep_Options, RESONANCE_SWEEP_ARG_COUNT},
+    {"run_script", "Run a motion script, compiled once and then cached", &Run_Script, Run_Script_Options, RUN_SCRIPT_ARG_COUNT},
+    {"trajectory", "Show or play the precompiled trajectory from flash", &Trajectory, Trajectory_Options, TRAJECTORY_ARG_COUNT},
+    {"telemetry", "Show or set the binary telemetry of the link UART", &Telemetry, Telemetry_Options, TELEMETRY_ARG_COUNT},
+    {"encoder", "Show the encoder and the last autotune, or set the limits", &Encoder, Encoder_Options, ENCODER_ARG_COUNT},
+    {"autotune", "Find the highest safe speed and acceleration with the encoder", &Autotune, Autotune_Options, AUTOTUNE_ARG_COUNT},
+    {"step_clock", "Show the LEDC clock, divider and resolution of the step rate", &Step_Clock, Step_Clock_Options, STEP_CLOCK_ARG_COUNT},
+    {"console", "Show the console UART and its output, or set the verbosity", &Console_Status, Console_Status_Options, CONSOLE_STATUS_ARG_COUNT},
+    {"motors", "List the motors and their resources, or set the limits of a station", &Motors, Motors_Options, MOTORS_ARG_COUNT},
+    {"heap", "Show the heap use, and the commands that used the heap", &Console_Heap, Heap_Options, HEAP_ARG_COUNT},
+};
+
+_Static_assert(RESONANCE_SWEEP_ARG_COUNT <= COMMAND_LINE_MAX_OPTIONS, "The command with the most options must fit the value array");
+
+static Console_Heap_Stats_t Heap_Stats; // Heap use of the commands, see Console_Execute()
+
+#if CONFIG_HEAP_TRACING_STANDALONE
+static heap_trace_record_t Heap_Trace_Records[CONSOLE_HEAP_TRACE_RECORDS]; // Allocations of the running command
+#endif
+
+/**
+ * @brief Write the usage of one option, e.g. "[--frq=<t>]", into a buffer.
+ */
+static void Format_Option(const Command_Option_t *Option, char *Buffer, size_t Size)
+{
+    const char *Open = Option->Required ? "" : "[";
+    const char *Close = Option->Required ? "" : "]";
+
+    if (Option->Name == NULL)
+    {
+        snprintf(Buffer, Size, "%s%s%s", Open, Option->Hint, Close);
+    }
+    else if (Option->Type == COMMAND_OPTION_FLAG)
+    {
+        snprintf(Buffer, Size, "%s--%s%s", Open, Option->Name, Close);
+    }
+    else
+    {
+        snprintf(Buffer, Size, "%s--%s=%s%s", Open, Option->Name, Option->Hint, Close);
+    }
+}
+
+/**
+ * @brief Print every command with its options.
+ *
+ * @return ESP_OK
+ */
+static esp_err_t Console_Help(const Command_Value_t *Values)
+{
+    char Usage[48];
+
+    for (size_t Command = 0; Command < sizeof(Console_Commands) / sizeof(Console_Commands[0]); Command++)
+    {
+        const Console_Command_t *Entry = &Console_Commands[Command];
+
+        printf("%s", Entry->Name);
+
+        for (size_t Option = 0; Option < Entry->Option_Count; Option++)
+        {
+            Format_Option(&Entry->Options[Option], Usage, sizeof(Usage));
+            printf(" %s", Usage);
+        }
+
+        printf("\n  %s\n", Entry->Help);
+
+        for (size_t Option = 0; Option < Entry->Option_Count; Option++)
+        {
+            Format_Option(&Entry->Options[Option], Usage, sizeof(Usage));
+            printf("  %22s  %s\n", Usage, Entry->Options[Option].Help);
+        }
+
+        printf("\n");
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Print the heap use, and how many commands used the heap while they ran.
+ *
+ * The console itself parses into static buffers, a command that uses the
+ * heap shows up here. A soak test runs its commands and checks that the
+ * count of commands with heap use stays 0.
+ *
+ * @param Values Values of the options, see Console_Commands.
+ * @return ESP_OK
+ */
+static esp_err_t Console_Heap(const Command_Value_t *Values)
+{
+    multi_heap_info_t Info;
+
+    if (Values[HEAP_ARG_CLEAR].Count > 0)
+    {
+        memset(&Heap_Stats, 0, sizeof(Heap_Stats));
+    }
+
+    heap_caps_get_info(&Info, MALLOC_CAP_DEFAULT); // Walks the heap, only on request
+
+    printf("FREE      : '%u' bytes\n", (unsigned)Info.total_free_bytes);                                                     // Print the free heap
+    printf("MIN FREE  : '%u' bytes\n", (unsigned)Info.minimum_free_bytes);                                                   // Print the low-water mark since start-up
+    printf("LARGEST   : '%u' bytes\n", (unsigned)Info.largest_free_block);                                                   // Print the largest free block, low once fragmented
+    printf("BLOCKS    : '%u' allocated, '%u' free\n", (unsigned)Info.allocated_blocks, (unsigned)Info.free_blocks);          // Print the blocks of the heap
+    printf("COMMANDS  : '%" PRIu32 "', '%" PRIu32 "' used the heap\n", Heap_Stats.Commands, Heap_Stats.Allocating_Commands); // Print the commands run and those with heap use
+#if CONFIG_HEAP_TRACING_STANDALONE
+    printf("ALLOCS    : '%" PRIu32 "'\n", Heap_Stats.Traced_Allocations); // Print the traced allocations of all commands
+#endif
+
+    if (Heap_Stats.Last_Allocating != NULL)
+    {
+        printf("LAST      : '%s'\n", Heap_Stats.Last_Allocating); // Print the last command with heap use
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Find a command of the console.
+ *
+ * @return The command, NULL if there is none of this name.
+ */
+static const Console_Command_t *Find_Command(const char *Name)
+{
+    for (size_t Command = 0; Command < sizeof(Console_Commands) / sizeof(Console_Commands[0]); Command++)
+    {
+        if (strcmp(Console_Commands[Command].Name, Name) == 0)
+        {
+            return &Console_Commands[Command];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Split, parse and run one command line.
+ *
+ * The words and values live in static buffers, the console runs in one
+ * task. The free heap and its low-water mark are compared before and after
+ * the command, both are kept per heap, so the check costs no heap walk. A
+ * command that keeps memory or needs more than ever before counts as one
+ * that used the heap. Memory taken and given back within the old low-water
+ * mark is only seen with CONFIG_HEAP_TRACING_STANDALONE, which counts every
+ * allocation while the command runs.
+ *
+ * @param Line Command line, split in place.
+ * @return ESP_OK for an empty line, ESP_ERR_NOT_FOUND for an unknown command,
+ *         ESP_ERR_INVALID_ARG if the options do not parse, else the result of the command.
+ */
+esp_err_t Console_Execute(char *Line)
+{
+    static char *Words[COMMAND_LINE_MAX_WORDS];
+    static Command_Value_t Values[COMMAND_LINE_MAX_OPTIONS];
+    int Error_Position = 0;
+    int Word_Count = Command_Line_Split(Line, Words, COMMAND_LINE_MAX_WORDS);
+
+    if (Word_Count == 0)
+    {
+        return ESP_OK; // Empty line
+    }
+
+    if (Word_Count < 0)
+    {
+        printf("%s\n", Command_Parse_Result_Name(COMMAND_PARSE_SPLIT_FAILED));
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const Console_Command_t *Command = Find_Command(Words[0]);
+
+    if (Command == NULL)
+    {
+        printf("Unrecognized command\n");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    Command_Parse_Result_t Result = Command_Line_Parse(Command->Options, Command->Option_Count, Word_Count, Words, Values, &Error_Position);
+
+    if (Result == COMMAND_PARSE_MISSING)
+    {
+        const Command_Option_t *Option = &Command->Options[Error_Position];
+
+        printf("%s: %s '%s%s'\n", Command->Name, Command_Parse_Result_Name(Result), (Option->Name != NULL) ? "--" : "", (Option->Name != NULL) ? Option->Name : Option->Hint);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (Result != COMMAND_PARSE_OK)
+    {
+        printf("%s: %s '%s'\n", Command->Name, Command_Parse_Result_Name(Result), Words[Error_Position]);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t Free_Before = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    size_t Min_Free_Before = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+    uint32_t Allocations = 0;
+
+#if CONFIG_HEAP_TRACING_STANDALONE
+    heap_trace_start(HEAP_TRACE_ALL); // Clears the records of the last command
+#endif
+
+    esp_err_t Function_Error = Command->Handler(Values);
+
+#if CONFIG_HEAP_TRACING_STANDALONE
+    heap_trace_stop();
+
+    Allocations = (uint32_t)heap_trace_get_count();
+#endif
+
+    bool Used_Heap = (Allocations > 0) || (heap_caps_get_free_size(MALLOC_CAP_DEFAULT) != Free_Before) ||
+                     (heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT) < Min_Free_Before);
+
+    Heap_Stats.Commands++;
+    Heap_Stats.Traced_Allocations += Allocations;
+
+    if (Used_Heap && (Command->Handler != &Console_Heap))
+    {
+        Heap_Stats.Allocating_Commands++;
+        Heap_Stats.Last_Allocating = Command->Name;
+    }
+
+    if (Function_Error != ESP_OK)
+    {
+        printf("Command returned non-zero error code: 0x%x (%s)\n", Function_Error, esp_err_to_name(Function_Error)); // Print error code if command failed
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Write function of the console stdout, hands the text to the writer task.
+ *
+ * @return Length, also for a dropped write, so the stream stays usable.
+ */
+static int Console_Stdout_Write(void *Cookie, const char *Text, int Length)
+{
+    if (Console_Output_Write(&Console_Output, Text, (size_t)Length))
+    {
+        xTaskNotifyGive(Console_Writer_Task_Handle);
+    }
+
+    return Length;
+}
+
+/**
+ * @brief Drain the output ring of the console task into the UART, never returns.
+ *
+ * The writer waits for the UART in place of the console task. It writes
+ * into the transmit ring of the driver and only waits while that is full.
+ */
+static void Console_Writer_Task(void *Parameter)
+{
+    const uint8_t *Data = NULL;
+
+    while (true)
+    {
+        size_t Length = Console_Output_Peek(&Console_Output, &Data);
+
+        if (Length == 0)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Until the console task wrote
+            continue;
+        }
+
+        int Sent = uart_write_bytes(CONSOLE_UART_0, (const char *)Data, Length);
+
+        Console_Output_Consume(&Console_Output, (Sent > 0) ? (size_t)Sent : 0);
+    }
+}
+
+/**
+ * @brief Read and run the command lines of the console UART, never returns.
+ *
+ * The bytes are taken from the UART event queue, edited into a static line,
+ * see command_line.h, and echoed. Runs in the task that called
+ * initialize_console(), its stdout is the output ring.
+ */
+void Run_Console(void)
+{
+    static Command_Line_t Line; // Zeroed, an empty line
+    const char *Prompt = LOG_COLOR_I PROMPT_STR "> " LOG_RESET_COLOR;
+
+    printf("%s", Prompt);
+    fflush(stdout);
+
+    while (true)
+    {
+        uint8_t Byte = Console_Read_Byte(); // Waits on the UART events
+
+        switch (Command_Line_Feed(&Line, Byte))
+        {
+        case COMMAND_LINE_ECHO:
+            putchar(Byte);
+            break;
+        case COMMAND_LINE_ERASE:
+            fputs("\b \b", stdout);
+            break;
+        case COMMAND_LINE_TOO_LONG:
+            printf("\nLine longer than %d bytes, dropped\n%s", COMMAND_LINE_MAX_LENGTH, Prompt);
+            break;
+        case COMMAND_LINE_DONE:
+            putchar('\n');
+            Console_Execute(Line.Text);
+            Command_Line_Reset(&Line);
+            printf("%s", Prompt);
+            break;
+        default:
+            break;
+        }
+
+        fflush(stdout);
+    }
+}
+
+/**
+ * @brief Initialize the console for UART communication.
+ *
+ * This function installs the UART driver with its event queue and transmit
+ * ring, configures the UART parameters and starts the writer task of the
+ * output ring. The stdout of the calling task is replaced by the output
+ * ring, so its prints never wait for the UART; the other tasks print
+ * through the driver. The command line itself needs no initialization, see
+ * Run_Console().
+ */
+void initialize_console(void)
+{
+    static char Stdout_Buffer[CONSOLE_STDOUT_BUFFER_SIZE]; // Line buffer of the console stdout, not on the heap
+
+    /* Drain stdout before reconfiguring it */
+    fflush(stdout);        // Flush stdout to ensure all output is written
+    fsync(fileno(stdout)); // Synchronize the file descriptor for stdout
+
+    /* Move the caret to the beginning of the next line on '\n' */
+    esp_vfs_dev_uart_port_set_tx_line_endings(CONSOLE_UART_0, ESP_LINE_ENDINGS_CRLF);
+
+    /* Configure UART. Note that REF_TICK is used so that the baud rate remains
+     * correct while APB frequency is changing in light sleep mode.
+     */
+    const uart_config_t uart_config = {
+        .baud_rate = CONSOLE_UART_BAUDRATE, // Set baud rate
+        .data_bits = UART_DATA_8_BITS,      // Set data bits to 8
+        .parity = UART_PARITY_DISABLE,      // Disable parity check
+        .stop_bits = UART_STOP_BITS_1,      // Set stop bits to 1
+        .source_clk = UART_SCLK_REF_TICK,   // Use reference clock
+    };
+    /* Install UART driver, the reads wait on its events, the writes go to its transmit ring */
+    ESP_ERROR_CHECK(uart_driver_install(CONSOLE_UART_0, CONSOLE_UART_RX_BUFFER_SIZE, CONSOLE_UART_TX_BUFFER_SIZE,
+                                        CONSOLE_UART_EVENT_QUEUE_LENGTH, &Console_Uart_Queue, 0));
+    ESP_ERROR_CHECK(uart_param_config(CONSOLE_UART_0, &uart_config)); // Configure UART parameters
+
+    /* Tell VFS to use UART driver */
+    esp_vfs_dev_uart_use_driver(CONSOLE_UART_0); // Use UART driver for VFS, the output of the other tasks
+
+    /* Start the writer of the output ring and make the ring stdout of this task */
+    Console_Output_Reset(&Console_Output);
+
+    if (xTaskCreate(Console_Writer_Task, "console_out", CONSOLE_WRITER_STACK_SIZE, NULL, CONSOLE_WRITER_PRIORITY, &Console_Writer_Task_Handle) != pdPASS)
+    {
+        ESP_ERROR_CHECK(ESP_ERR_NO_MEM);
+    }
+
+    FILE *Console_Stdout = fwopen(NULL, &Console_Stdout_Write);
+
+    if (Console_Stdout == NULL)
+    {
+        ESP_ERROR_CHECK(ESP_ERR_NO_MEM);
+    }
+
+    setvbuf(Console_Stdout, Stdout_Buffer, _IOLBF, sizeof(Stdout_Buffer)); // One write to the ring per line
+    stdout = Console_Stdout;                                               // Only for this task, the stdout of every task is its own
+
+#if CONFIG_HEAP_TRACING_STANDALONE
+    ESP_ERROR_CHECK(heap_trace_init_standalone(Heap_Trace_Records, CONSOLE_HEAP_TRACE_RECORDS)); // Counts the allocations of every command
+#endif
+}
@@ -21,57 +21,87 @@
 #include <string.h>
 #include "esp_system.h"
 #include "esp_log.h"
-#include "esp_console.h"
 #include "esp_vfs_dev.h"
 #include "driver/uart.h"
-#include "linenoise/linenoise.h"
-#include "argtable3/argtable3.h"
 #include "esp_vfs_fat.h"
 #include "nvs.h"
 #include "nvs_flash.h"
+#include "command_line.h"
+#include "console_output.h"
 
 #define PROMPT_STR CONFIG_IDF_TARGET // Prompt string for the console
 #define CONSOLE_UART_0 0x00
-#define CONSOLE_UART_BAUDRATE_115200 115200
+#define CONSOLE_HEAP_TRACE_RECORDS 64 // Allocations recorded per command with CONFIG_HEAP_TRACING_STANDALONE
 
-void initialize_console(void);
+#ifndef CONSOLE_UART_BAUDRATE
+#define CONSOLE_UART_BAUDRATE 115200 // Baud rate of the console UART, may be given by the build
+#endif
 
-esp_err_t Register_Start_Motor_CMD(void);
-esp_err_t Register_Stop_Motor_CMD(void);
-esp_err_t Register_Quick_Start_Motor_CMD(void);
-esp_err_t Register_Rotate_Motor_CMD(void);
-esp_err_t Register_Rotate_Angle_CMD(void);
+#ifndef CONSOLE_UART_RX_BUFFER_SIZE
+#define CONSOLE_UART_RX_BUFFER_SIZE 1024 // UART driver receive buffer in bytes, more than 128, may be given by the build
+#endif
 
-esp_err_t Start_Motor(int argc, char **argv);
-esp_err_t Quick_Start_Motor(void);
-esp_err_t Rotate_Motor(int argc, char **argv);
-esp_err_t Rotate_Angle(int argc, char **argv);
+#ifndef CONSOLE_UART_TX_BUFFER_SIZE
+#define CONSOLE_UART_TX_BUFFER_SIZE 1024 // UART driver transmit ring in bytes, 0 or more than 128, may be given by the build
+#endif
 
-/** Arguments used for the stepper motor to run */
-struct
-{
-    struct arg_int *Frequency;  // Argument for Stepper motor PWM frequency
-    struct arg_int *Direction;  // Argument for Stepper motor direction
-    struct arg_int *Duty_cycle; // Argument for Stepper motor PWM Duty cycle
-    struct arg_end *end;        // End marker for argument table
-} Start_motor_args;             // Structure to hold the arguments for the stepper_motor command
+#ifndef CONSOLE_UART_EVENT_QUEUE_LENGTH
+#define CONSOLE_UART_EVENT_QUEUE_LENGTH 16 // UART events waiting for the console task, may be given by the build
+#endif
 
-struct
-{
-    struct arg_int *Frequency; // Argument for Stepper motor PWM frequency
-    struct arg_int *Direction; // Argument for Stepper motor direction
-    struct arg_int *Steps;     // Argument for the number of steps per rotation
-    struct arg_int *Rotation;  // Argument for the number of rotations to rotate the motor
-    struct arg_end *end;       // End marker for argument table
-} Rotate_motor_args;           // Structure to hold the arguments for the stepper_motor command
+#ifndef CONSOLE_VERBOSITY
+#define CONSOLE_VERBOSITY CONSOLE_VERBOSITY_NORMAL // Verbosity at start-up, may be given by the build
+#endif
+
+#define CONSOLE_UART_READ_SIZE 64      // Bytes read from the driver at once
+#define CONSOLE_WRITER_STACK_SIZE 2048 // Stack size of the output writer task in bytes
+#define CONSOLE_WRITER_PRIORITY 2      // Above the console task, waits for the UART most of the time
+#define CONSOLE_STDOUT_BUFFER_SIZE 128 // Line buffer of the console stdout, one write to the ring per line
 
-struct
+/** What the command handlers print */
+typedef enum
 {
-    struct arg_int *Frequency; // Argument for Stepper motor PWM frequency
-    struct arg_int *Direction; // Argument for Stepper motor direction
-    struct arg_int *Steps;     // Argument for the number of steps per rotation
-    struct arg_dbl *Angle;     // Argument for the angle to rotate the motor
-    struct arg_end *end;       // End marker for argument table
-} Rotate_angle_args;           // Structure to hold the arguments for the rotate_motor_angle command
+    CONSOLE_VERBOSITY_QUIET = 0, // Errors and the replies of the query commands only
+    CONSOLE_VERBOSITY_NORMAL,    // Also the id of every queued motion command
+    CONSOLE_VERBOSITY_VERBOSE,   // Also the values of the motion commands
+    CONSOLE_VERBOSITY_COUNT,     // Number of levels
+} Console_Verbosity_t;
+
+void initialize_console(void);
+
+esp_err_t Console_Execute(char *Line);
+void Run_Console(void);
+
+esp_err_t Start_Motor(const Command_Value_t *Values);
+esp_err_t Quick_Start_Motor(const Command_Value_t *Values);
+esp_err_t Rotate_Motor(const Command_Value_t *Values);
+esp_err_t Rotate_Angle(const Command_Value_t *Values);
+esp_err_t Stop_Motor(const Command_Value_t *Values);
+esp_err_t Motion_Status(const Command_Value_t *Values);
+esp_err_t Motion_Flush(const Command_Value_t *Values);
+esp_err_t Motion_Abort(const Command_Value_t *Values);
+esp_err_t Move_Linear(const Command_Value_t *Values);
+esp_err_t Move_Arc(const Command_Value_t *Values);
+esp_err_t DDA_Benchmark(const Command_Value_t *Values);
+esp_err_t Gcode_Stream(const Command_Value_t *Values);
+esp_err_t Link_Baud(const Command_Value_t *Values);
+esp_err_t Motion_Bench(const Command_Value_t *Values);
+esp_err_t Jog_Motor(const Command_Value_t *Values);
+esp_err_t Halt_Motor(const Command_Value_t *Values);
+esp_err_t Ramp_Cache(const Command_Value_t *Values);
+esp_err_t Trace(const Command_Value_t *Values);
+esp_err_t Move_To(const Command_Value_t *Values);
+esp_err_t Home_Motor(const Command_Value_t *Values);
+esp_err_t Position(const Command_Value_t *Values);
+esp_err_t Resonance(const Command_Value_t *Values);
+esp_err_t Resonance_Sweep(const Command_Value_t *Values);
+esp_err_t Run_Script(const Command_Value_t *Values);
+esp_err_t Trajectory(const Command_Value_t *Values);
+esp_err_t Telemetry(const Command_Value_t *Values);
+esp_err_t Encoder(const Command_Value_t *Values);
+esp_err_t Autotune(const Command_Value_t *Values);
+esp_err_t Step_Clock(const Command_Value_t *Values);
+esp_err_t Console_Status(const Command_Value_t *Values);
+esp_err_t Motors(const Command_Value_t *Values);
 
 #endif // CONSOLE_H
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*H**********************************************************************
+ * FILENAME :        console_output.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent output ring of the console: the console task
+ *       writes its text without waiting, a writer task drains it into the
+ *       UART.
+ *
+ * NOTES :
+ *       Each side publishes its index with a release store after the data
+ *       access, so the ring works across both cores without a lock.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "console_output.h"
+
+/**
+ * @brief Empty the ring and clear its counters, only while neither side is using it.
+ */
+void Console_Output_Reset(Console_Output_t *Output)
+{
+    __atomic_store_n(&Output->Head, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&Output->Tail, 0, __ATOMIC_RELEASE);
+
+    Output->Written = 0;
+    Output->Dropped = 0;
+    Output->Drops = 0;
+    Output->High_Water = 0;
+}
+
+/**
+ * @brief Append text, producer side, never waits.
+ *
+ * @param Output Ring to write.
+ * @param Text Text, every LF is written as CRLF.
+ * @param Length Bytes of Text.
+ * @return false if the expanded text does not fit, nothing is written then.
+ */
+bool Console_Output_Write(Console_Output_t *Output, const char *Text, size_t Length)
+{
+    uint32_t Head = Output->Head; // Own index, no other writer
+    size_t Needed = Length;
+
+    for (size_t Index = 0; Index < Length; Index++)
+    {
+        Needed += (Text[Index] == '\n') ? 1 : 0; // Room for the CR
+    }
+
+    uint32_t Used = Head - __atomic_load_n(&Output->Tail, __ATOMIC_ACQUIRE);
+
+    if (Needed > (CONSOLE_OUTPUT_BUFFER_SIZE - Used))
+    {
+        Output->Dropped += (uint32_t)Length;
+        Output->Drops++;
+        return false;
+    }
+
+    for (size_t Index = 0; Index < Length; Index++)
+    {
+        if (Text[Index] == '\n')
+        {
+            Output->Data[Head++ & (CONSOLE_OUTPUT_BUFFER_SIZE - 1)] = '\r';
+        }
+
+        Output->Data[Head++ & (CONSOLE_OUTPUT_BUFFER_SIZE - 1)] = (uint8_t)Text[Index];
+    }
+
+    Used += (uint32_t)Needed;
+
+    Output->Written += (uint32_t)Needed;
+    Output->High_Water = (Used > Output->High_Water) ? Used : Output->High_Water;
+
+    __atomic_store_n(&Output->Head, Head, __ATOMIC_RELEASE); // Publish the bytes
+
+    return true;
+}
+
+/**
+ * @brief Number of bytes waiting, exact for the consumer, an upper bound for the producer.
+ */
+uint32_t Console_Output_Pending(const Console_Output_t *Output)
+{
+    return __atomic_load_n(&Output->Head, __ATOMIC_ACQUIRE) - __atomic_load_n(&Output->Tail, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Oldest waiting bytes that are contiguous in the ring, consumer side.
+ *
+ * @param Output Ring to read.
+ * @param Data Returns the first byte.
+ * @return Number of contiguous bytes, 0 if the ring is empty.
+ */
+size_t Console_Output_Peek(const Console_Output_t *Output, const uint8_t **Data)
+{
+    uint32_t Tail = Output->Tail; // Own index, no other writer
+    uint32_t Pending = __atomic_load_n(&Output->Head, __ATOMIC_ACQUIRE) - Tail;
+    uint32_t Offset = Tail & (CONSOLE_OUTPUT_BUFFER_SIZE - 1);
+    uint32_t Contiguous = CONSOLE_OUTPUT_BUFFER_SIZE - Offset; // Bytes up to the end of the storage
+
+    *Data = &Output->Data[Offset];
+
+    return (Pending < Contiguous) ? Pending : Contiguous;
+}
+
+/**
+ * @brief Release bytes returned by Console_Output_Peek(), consumer side.
+ *
+ * @param Output Ring to read.
+ * @param Length Bytes sent, at most what the last peek returned.
+ */
+void Console_Output_Consume(Console_Output_t *Output, size_t Length)
+{
+    __atomic_store_n(&Output->Tail, Output->Tail + (uint32_t)Length, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,54 @@
+/*H**********************************************************************
+ * FILENAME :        console_output.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent output ring of the console: the console task
+ *       writes its text without waiting, a writer task drains it into the
+ *       UART.
+ *
+ * NOTES :
+ *       Single producer, single consumer like segment_ring.h: only the
+ *       console task writes Head and the counters, only the writer task
+ *       writes Tail. Every LF is written as CRLF. A write that does not fit
+ *       is dropped whole and counted, the console task never waits for the
+ *       UART, so a command that moves the motor is not held up by its own
+ *       messages at 115200 baud.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef CONSOLE_OUTPUT_H
+#define CONSOLE_OUTPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef CONSOLE_OUTPUT_BUFFER_SIZE
+#define CONSOLE_OUTPUT_BUFFER_SIZE 4096 // Bytes the ring holds, a power of two, may be given by the build
+#endif
+
+_Static_assert((CONSOLE_OUTPUT_BUFFER_SIZE & (CONSOLE_OUTPUT_BUFFER_SIZE - 1)) == 0, "CONSOLE_OUTPUT_BUFFER_SIZE must be a power of two");
+
+/** Ring state, free running indices wrap at 2^32 */
+typedef struct
+{
+    uint8_t Data[CONSOLE_OUTPUT_BUFFER_SIZE]; // Text storage
+    uint32_t Head;                            // Next index to write, written by the producer only
+    uint32_t Tail;                            // Next index to read, written by the consumer only
+    uint32_t Written;                         // Bytes accepted, line endings expanded
+    uint32_t Dropped;                         // Bytes of the dropped writes, before expansion
+    uint32_t Drops;                           // Writes dropped for lack of room
+    uint32_t High_Water;                      // Most bytes waiting at once
+} Console_Output_t;
+
+void Console_Output_Reset(Console_Output_t *Output);
+bool Console_Output_Write(Console_Output_t *Output, const char *Text, size_t Length);
+uint32_t Console_Output_Pending(const Console_Output_t *Output);
+size_t Console_Output_Peek(const Console_Output_t *Output, const uint8_t **Data);
+void Console_Output_Consume(Console_Output_t *Output, size_t Length);
+
+#endif // CONSOLE_OUTPUT_H
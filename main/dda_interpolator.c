@@ -0,0 +1,286 @@
+/*H**********************************************************************
+ * FILENAME :        dda_interpolator.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent DDA step interpolator for coordinated
+ *       multi-axis moves.
+ *
+ * NOTES :
+ *       Called from the step timer interrupt, so nothing in here may
+ *       block, allocate or use floating point.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "dda_interpolator.h"
+
+/**
+ * @brief Sign of a value as -1, 0 or 1.
+ */
+static int32_t Sign(int32_t Value)
+{
+    return (Value > 0) - (Value < 0);
+}
+
+/**
+ * @brief Squared distance from the arc radius after moving by (Step_X, Step_Y).
+ */
+static int64_t Radius_Error(const DDA_Arc_t *Arc, int32_t Step_X, int32_t Step_Y)
+{
+    int64_t X = (int64_t)Arc->X + Step_X;
+    int64_t Y = (int64_t)Arc->Y + Step_Y;
+    int64_t Error = (X * X) + (Y * Y) - Arc->Radius_Sq;
+
+    return (Error < 0) ? -Error : Error;
+}
+
+/**
+ * @brief True if the current arc position is at most one step from the end.
+ */
+static bool Near_End(const DDA_Arc_t *Arc)
+{
+    return (abs(Arc->X - Arc->End_X) <= 1) && (abs(Arc->Y - Arc->End_Y) <= 1);
+}
+
+/**
+ * @brief Prepare a coordinated straight line.
+ *
+ * @param Line Line state.
+ * @param Delta Signed number of steps per axis.
+ * @param Axis_Count Number of entries in Delta, at most DDA_MAX_AXES.
+ */
+void DDA_Line_Begin(DDA_Line_t *Line, const int32_t *Delta, uint8_t Axis_Count)
+{
+    if (Axis_Count > DDA_MAX_AXES)
+    {
+        Axis_Count = DDA_MAX_AXES;
+    }
+
+    Line->Axis_Count = Axis_Count;
+    Line->Direction_Mask = 0;
+    Line->Major_Steps = 0;
+    Line->Tick = 0;
+
+    for (uint8_t Axis = 0; Axis < Axis_Count; Axis++)
+    {
+        Line->Abs_Delta[Axis] = (Delta[Axis] < 0) ? (uint32_t)(-(int64_t)Delta[Axis]) : (uint32_t)Delta[Axis];
+
+        if (Delta[Axis] < 0)
+        {
+            Line->Direction_Mask |= (uint8_t)(1U << Axis);
+        }
+
+        if (Line->Abs_Delta[Axis] > Line->Major_Steps)
+        {
+            Line->Major_Steps = Line->Abs_Delta[Axis];
+        }
+    }
+
+    for (uint8_t Axis = 0; Axis < Axis_Count; Axis++)
+    {
+        Line->Error[Axis] = Line->Major_Steps / 2; // Centre the minor axis steps inside the major axis steps
+    }
+}
+
+/**
+ * @brief Advance the line by one tick.
+ *
+ * The longest axis steps on every tick, every other axis steps whenever its
+ * accumulator overflows, so after every tick each axis is within half a
+ * step of its share of the line and all axes are on their target at the
+ * last tick.
+ *
+ * @param Line Line state.
+ * @param Direction_Mask Set to the axes moving in the negative direction.
+ * @return Mask of the axes that step in this tick, 0 once the line is done.
+ */
+uint8_t DDA_Line_Step(DDA_Line_t *Line, uint8_t *Direction_Mask)
+{
+    uint8_t Step_Mask = 0;
+
+    *Direction_Mask = Line->Direction_Mask;
+
+    if (Line->Tick >= Line->Major_Steps)
+    {
+        return 0;
+    }
+
+    for (uint8_t Axis = 0; Axis < Line->Axis_Count; Axis++)
+    {
+        Line->Error[Axis] += Line->Abs_Delta[Axis];
+
+        if (Line->Error[Axis] >= Line->Major_Steps)
+        {
+            Line->Error[Axis] -= Line->Major_Steps;
+            Step_Mask |= (uint8_t)(1U << Axis);
+        }
+    }
+
+    Line->Tick++;
+
+    return Step_Mask;
+}
+
+/**
+ * @brief True once every tick of the line has been emitted.
+ */
+bool DDA_Line_Done(const DDA_Line_t *Line)
+{
+    return Line->Tick >= Line->Major_Steps;
+}
+
+/**
+ * @brief Prepare a circular arc on the first two axes.
+ *
+ * Positions are given in steps relative to the arc center. The radius is
+ * taken from the start point; an end point equal to the start point selects
+ * a full circle.
+ *
+ * @param Arc Arc state.
+ * @param Start_X Start position relative to the center.
+ * @param Start_Y Start position relative to the center.
+ * @param End_X End position relative to the center.
+ * @param End_Y End position relative to the center.
+ * @param Clockwise Direction of travel.
+ * @return false if the end point is not on the circle (within one step).
+ */
+bool DDA_Arc_Begin(DDA_Arc_t *Arc, int32_t Start_X, int32_t Start_Y, int32_t End_X, int32_t End_Y, bool Clockwise)
+{
+    int64_t End_Radius_Sq = ((int64_t)End_X * End_X) + ((int64_t)End_Y * End_Y);
+    int64_t Span = (int64_t)abs(Start_X) + abs(Start_Y);
+
+    Arc->X = Start_X;
+    Arc->Y = Start_Y;
+    Arc->End_X = End_X;
+    Arc->End_Y = End_Y;
+    Arc->Radius_Sq = ((int64_t)Start_X * Start_X) + ((int64_t)Start_Y * Start_Y);
+    Arc->Clockwise = Clockwise;
+    Arc->Tick = 0;
+    Arc->Max_Ticks = (uint32_t)((8 * Span) + 16); // A full circle takes fewer than 8 * radius ticks
+    Arc->Left_Start = !((Start_X == End_X) && (Start_Y == End_Y)) && Near_End(Arc);
+    Arc->Done = (Arc->Radius_Sq == 0);
+
+    // |r_end^2 - r^2| <= 2 * r + 1 keeps the end point within one step of the circle
+    int64_t Difference = End_Radius_Sq - Arc->Radius_Sq;
+
+    if (Difference < 0)
+    {
+        Difference = -Difference;
+    }
+
+    return (Difference <= ((2 * Span) + 2)) && !Arc->Done;
+}
+
+/**
+ * @brief Advance the arc by one tick.
+ *
+ * Out of the steps that follow the direction of travel (X only, Y only or
+ * both) the one that lands closest to the circle is taken. Once the end
+ * point is within one step a final step lands on it exactly.
+ *
+ * @param Arc Arc state.
+ * @param Direction_Mask Set to the axes moving in the negative direction.
+ * @return Mask of the axes that step in this tick, 0 once the arc is done.
+ */
+uint8_t DDA_Arc_Step(DDA_Arc_t *Arc, uint8_t *Direction_Mask)
+{
+    int32_t Step_X = 0;
+    int32_t Step_Y = 0;
+
+    *Direction_Mask = 0;
+
+    if (Arc->Done)
+    {
+        return 0;
+    }
+
+    if (Arc->Left_Start && Near_End(Arc))
+    {
+        Step_X = Sign(Arc->End_X - Arc->X);
+        Step_Y = Sign(Arc->End_Y - Arc->Y);
+        Arc->Done = true;
+    }
+    else
+    {
+        // Tangent of the circle, (-y, x) counter clockwise and (y, -x) clockwise
+        int32_t Tangent_X = Arc->Clockwise ? Sign(Arc->Y) : -Sign(Arc->Y);
+        int32_t Tangent_Y = Arc->Clockwise ? -Sign(Arc->X) : Sign(Arc->X);
+        int64_t Best_Error = INT64_MAX;
+
+        if (Tangent_X != 0)
+        {
+            Best_Error = Radius_Error(Arc, Tangent_X, 0);
+            Step_X = Tangent_X;
+        }
+
+        if ((Tangent_Y != 0) && (Radius_Error(Arc, 0, Tangent_Y) < Best_Error))
+        {
+            Best_Error = Radius_Error(Arc, 0, Tangent_Y);
+            Step_X = 0;
+            Step_Y = Tangent_Y;
+        }
+
+        if ((Tangent_X != 0) && (Tangent_Y != 0) && (Radius_Error(Arc, Tangent_X, Tangent_Y) < Best_Error))
+        {
+            Step_X = Tangent_X;
+            Step_Y = Tangent_Y;
+        }
+    }
+
+    Arc->X += Step_X;
+    Arc->Y += Step_Y;
+    Arc->Tick++;
+
+    if (!Near_End(Arc))
+    {
+        Arc->Left_Start = true;
+    }
+
+    if (((Arc->X == Arc->End_X) && (Arc->Y == Arc->End_Y) && Arc->Left_Start) || (Arc->Tick >= Arc->Max_Ticks))
+    {
+        Arc->Done = true;
+    }
+
+    *Direction_Mask = (uint8_t)(((Step_X < 0) ? 0x01 : 0) | ((Step_Y < 0) ? 0x02 : 0));
+
+    return (uint8_t)(((Step_X != 0) ? 0x01 : 0) | ((Step_Y != 0) ? 0x02 : 0));
+}
+
+/**
+ * @brief True once the arc has reached its end point.
+ */
+bool DDA_Arc_Done(const DDA_Arc_t *Arc)
+{
+    return Arc->Done;
+}
+
+/**
+ * @brief Number of ticks an arc will take.
+ *
+ * Runs the arc once without output so the velocity profile can be planned
+ * over the exact tick count before the move starts.
+ *
+ * @return Number of ticks, 0 if the arc is invalid.
+ */
+uint32_t DDA_Arc_Count_Ticks(int32_t Start_X, int32_t Start_Y, int32_t End_X, int32_t End_Y, bool Clockwise)
+{
+    DDA_Arc_t Arc;
+    uint8_t Direction_Mask;
+
+    if (!DDA_Arc_Begin(&Arc, Start_X, Start_Y, End_X, End_Y, Clockwise))
+    {
+        return 0;
+    }
+
+    while (!DDA_Arc_Done(&Arc))
+    {
+        DDA_Arc_Step(&Arc, &Direction_Mask);
+    }
+
+    return Arc.Tick;
+}
@@ -0,0 +1,64 @@
+/*H**********************************************************************
+ * FILENAME :        dda_interpolator.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent DDA step interpolator for coordinated
+ *       multi-axis moves.
+ *
+ * NOTES :
+ *       Every call of a step function is one interpolator tick. It returns
+ *       the mask of axes that have to emit a step pulse in that tick and
+ *       the mask of axes moving in the negative direction. Lines use a
+ *       Bresenham accumulator per axis, arcs use the midpoint circle rule
+ *       on the first two axes.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef DDA_INTERPOLATOR_H
+#define DDA_INTERPOLATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DDA_MAX_AXES 4 // Highest number of axes interpolated together
+
+/** Coordinated straight line from the current position */
+typedef struct
+{
+    uint8_t Axis_Count;               // Number of axes taking part
+    uint32_t Abs_Delta[DDA_MAX_AXES]; // Absolute steps of every axis
+    uint32_t Error[DDA_MAX_AXES];     // Bresenham accumulator of every axis
+    uint8_t Direction_Mask;           // Axes moving in the negative direction
+    uint32_t Major_Steps;             // Steps of the longest axis, one per tick
+    uint32_t Tick;                    // Ticks done so far
+} DDA_Line_t;
+
+/** Circular arc in the plane of the first two axes */
+typedef struct
+{
+    int32_t X;          // Current position relative to the center
+    int32_t Y;          // Current position relative to the center
+    int32_t End_X;      // End position relative to the center
+    int32_t End_Y;      // End position relative to the center
+    int64_t Radius_Sq;  // Squared radius of the arc
+    bool Clockwise;     // Direction of travel
+    uint32_t Tick;      // Ticks done so far
+    uint32_t Max_Ticks; // Safety limit, a full circle plus margin
+    bool Left_Start;    // True once the arc has moved away from the end point
+    bool Done;          // True once the end point is reached
+} DDA_Arc_t;
+
+void DDA_Line_Begin(DDA_Line_t *Line, const int32_t *Delta, uint8_t Axis_Count);
+uint8_t DDA_Line_Step(DDA_Line_t *Line, uint8_t *Direction_Mask);
+bool DDA_Line_Done(const DDA_Line_t *Line);
+
+bool DDA_Arc_Begin(DDA_Arc_t *Arc, int32_t Start_X, int32_t Start_Y, int32_t End_X, int32_t End_Y, bool Clockwise);
+uint8_t DDA_Arc_Step(DDA_Arc_t *Arc, uint8_t *Direction_Mask);
+bool DDA_Arc_Done(const DDA_Arc_t *Arc);
+uint32_t DDA_Arc_Count_Ticks(int32_t Start_X, int32_t Start_Y, int32_t End_X, int32_t End_Y, bool Clockwise);
+
+#endif // DDA_INTERPOLATOR_H
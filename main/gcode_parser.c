@@ -0,0 +1,314 @@
+/*H**********************************************************************
+ * FILENAME :        gcode_parser.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent parser and interpreter for the G-code subset
+ *       streamed to the stepper motor example.
+ *
+ * NOTES :
+ *       Only the C standard library is used, so recorded programs can be
+ *       run through the parser on a Linux host.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gcode_parser.h"
+
+static const char Axis_Letters[DDA_MAX_AXES] = {'X', 'Y', 'Z', 'A'}; // Axis words in axis order
+
+/**
+ * @brief Fill in the default machine configuration.
+ *
+ * @param Config Output configuration.
+ */
+void Gcode_Default_Config(Gcode_Config_t *Config)
+{
+    for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+    {
+        Config->Steps_Per_Unit[Axis] = GCODE_DEFAULT_STEPS_PER_UNIT;
+    }
+
+    Config->Rapid_Rate = GCODE_DEFAULT_RAPID_RATE;
+}
+
+/**
+ * @brief Reset the interpreter to its power on state.
+ *
+ * Absolute mode, G1, default feed rate, position and origin at 0.
+ *
+ * @param State Interpreter state.
+ * @param Config Machine configuration, copied.
+ */
+void Gcode_Init(Gcode_State_t *State, const Gcode_Config_t *Config)
+{
+    memset(State, 0, sizeof(*State));
+
+    State->Config = *Config;
+    State->Feed_Rate = GCODE_DEFAULT_FEED_RATE;
+}
+
+/**
+ * @brief Split one line into its words.
+ *
+ * @param Line Line without the line ending.
+ * @param Block Output words.
+ * @return false on a malformed number, an unknown word, too many G words or a second M word.
+ */
+bool Gcode_Parse_Line(const char *Line, Gcode_Block_t *Block)
+{
+    const char *Cursor = Line;
+
+    memset(Block, 0, sizeof(*Block));
+    Block->M = -1;
+
+    while (*Cursor != '\0')
+    {
+        char Letter = (char)toupper((unsigned char)*Cursor);
+
+        if (isspace((unsigned char)Letter))
+        {
+            Cursor++;
+            continue;
+        }
+
+        if ((Letter == ';') || (Letter == '*'))
+        {
+            break; // Comment or checksum, rest of the line is ignored
+        }
+
+        if (Letter == '(')
+        {
+            const char *Close = strchr(Cursor, ')');
+
+            if (Close == NULL)
+            {
+                return false; // Unterminated comment
+            }
+
+            Cursor = Close + 1;
+            continue;
+        }
+
+        char *Number_End = NULL;
+        float Value = strtof(Cursor + 1, &Number_End);
+
+        if (Number_End == (Cursor + 1))
+        {
+            return false; // Letter without a number
+        }
+
+        Cursor = Number_End;
+
+        switch (Letter)
+        {
+        case 'G':
+            if ((Block->G_Count >= GCODE_MAX_G_WORDS) || (Value < 0.0f) || (Value != floorf(Value)))
+            {
+                return false; // Too many G words or not an integer code
+            }
+
+            Block->G[Block->G_Count++] = (int16_t)Value;
+            break;
+
+        case 'M':
+            if ((Block->M >= 0) || (Value < 0.0f) || (Value != floorf(Value)))
+            {
+                return false; // Only one integer M code per line is supported
+            }
+
+            Block->M = (int16_t)Value;
+            break;
+
+        case 'F':
+            Block->F = Value;
+            Block->Word_Mask |= GCODE_WORD_F;
+            break;
+
+        case 'P':
+            Block->P = Value;
+            Block->Word_Mask |= GCODE_WORD_P;
+            break;
+
+        case 'N':
+            break; // Line numbers are not checked
+
+        default:
+        {
+            const char *Axis_Letter = memchr(Axis_Letters, Letter, DDA_MAX_AXES);
+
+            if (Axis_Letter == NULL)
+            {
+                return false; // Unsupported word
+            }
+
+            uint8_t Axis = (uint8_t)(Axis_Letter - Axis_Letters);
+
+            Block->Axis[Axis] = Value;
+            Block->Word_Mask |= (uint16_t)(GCODE_WORD_X << Axis);
+            break;
+        }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Apply a parsed line to the modal state and produce its action.
+ *
+ * A line with axis words but no G word moves in the active G0 or G1 mode.
+ *
+ * @param State Interpreter state.
+ * @param Block Parsed words.
+ * @param Action Output action.
+ * @return false for an unsupported G or M code or an invalid value.
+ */
+bool Gcode_Execute_Block(Gcode_State_t *State, const Gcode_Block_t *Block, Gcode_Action_t *Action)
+{
+    bool Move = false;
+
+    memset(Action, 0, sizeof(*Action));
+
+    if (Block->Word_Mask & GCODE_WORD_F)
+    {
+        if (!(Block->F > 0.0f))
+        {
+            return false; // Feed rate must be positive
+        }
+
+        State->Feed_Rate = Block->F;
+    }
+
+    switch (Block->M)
+    {
+    case -1:
+        break;
+
+    case 2:
+    case 30:
+        State->Program_End = true;
+        break;
+
+    case 17:
+        Action->Type = GCODE_ACTION_ENABLE;
+        break;
+
+    case 18:
+    case 84:
+        Action->Type = GCODE_ACTION_DISABLE;
+        break;
+
+    default:
+        return false; // Unsupported M code
+    }
+
+    int16_t Non_Modal = -1; // G0, G1, G4 or G92 of this line
+
+    for (uint8_t Index = 0; Index < Block->G_Count; Index++)
+    {
+        switch (Block->G[Index])
+        {
+        case 21:
+            break; // Units are always mm
+
+        case 90:
+        case 91:
+            State->Relative = (Block->G[Index] == 91); // Modal codes apply before the move of the same line
+            break;
+
+        case 0:
+        case 1:
+        case 4:
+        case 92:
+            if (Non_Modal >= 0)
+            {
+                return false; // Only one motion, dwell or origin code per line
+            }
+
+            Non_Modal = Block->G[Index];
+            break;
+
+        default:
+            return false; // Unsupported G code
+        }
+    }
+
+    switch (Non_Modal)
+    {
+    case -1:
+        Move = (Block->Word_Mask & (GCODE_WORD_X | GCODE_WORD_Y | GCODE_WORD_Z | GCODE_WORD_A)) != 0;
+        break;
+
+    case 0:
+    case 1:
+        State->Rapid = (Non_Modal == 0);
+        Move = true;
+        break;
+
+    case 4:
+        if (!(Block->Word_Mask & GCODE_WORD_P) || (Block->P < 0.0f))
+        {
+            return false; // Dwell needs a time
+        }
+
+        Action->Type = GCODE_ACTION_DWELL;
+        Action->Dwell_ms = (uint32_t)lroundf(Block->P);
+        return true;
+
+    default: // G92
+        for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+        {
+            if (Block->Word_Mask & (GCODE_WORD_X << Axis))
+            {
+                State->Offset[Axis] = State->Position[Axis] - (int32_t)lroundf(Block->Axis[Axis] * State->Config.Steps_Per_Unit[Axis]); // Current position becomes the given value
+            }
+        }
+        return true;
+    }
+
+    if (!Move)
+    {
+        return true;
+    }
+
+    float Length_Steps = 0.0f; // Path length in steps
+    float Length_Units = 0.0f; // Path length in units
+
+    for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+    {
+        if (!(Block->Word_Mask & (GCODE_WORD_X << Axis)))
+        {
+            continue; // Axis keeps its position
+        }
+
+        int32_t Value_Steps = (int32_t)lroundf(Block->Axis[Axis] * State->Config.Steps_Per_Unit[Axis]);
+        int32_t Target = State->Relative ? (State->Position[Axis] + Value_Steps) : (State->Offset[Axis] + Value_Steps);
+
+        Action->Steps[Axis] = Target - State->Position[Axis];
+        State->Position[Axis] = Target;
+
+        float Units = Action->Steps[Axis] / State->Config.Steps_Per_Unit[Axis];
+
+        Length_Steps += (float)Action->Steps[Axis] * (float)Action->Steps[Axis];
+        Length_Units += Units * Units;
+    }
+
+    if (Length_Steps == 0.0f)
+    {
+        return true; // Already at the target
+    }
+
+    float Feed_Rate = State->Rapid ? State->Config.Rapid_Rate : State->Feed_Rate;
+
+    Action->Type = GCODE_ACTION_MOVE;
+    Action->Nominal_Speed = (Feed_Rate / 60.0f) * sqrtf(Length_Steps / Length_Units); // units/min to path steps/s
+
+    return true;
+}
@@ -0,0 +1,95 @@
+/*H**********************************************************************
+ * FILENAME :        gcode_parser.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent parser and interpreter for the G-code subset
+ *       streamed to the stepper motor example.
+ *
+ * NOTES :
+ *       Supported: G0, G1, G4, G21, G90, G91, G92, M17, M18, M2, M30, with the
+ *       words X, Y, Z, A, F, P and the ignored N and *checksum. Comments in
+ *       parentheses and after ';' are skipped. Positions are kept in steps
+ *       so that rounding never accumulates over a program.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef GCODE_PARSER_H
+#define GCODE_PARSER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dda_interpolator.h"
+
+#define GCODE_MAX_LINE_LENGTH 96           // Longest accepted line including the terminator
+#define GCODE_MAX_G_WORDS 4                // G words accepted in one line, e.g. G90 G0
+#define GCODE_DEFAULT_STEPS_PER_UNIT 80.0f // Steps per mm, 1/16 microstepping on a 20 tooth GT2 pulley
+#define GCODE_DEFAULT_FEED_RATE 600.0f     // Feed rate in units/min until the first F word
+#define GCODE_DEFAULT_RAPID_RATE 3000.0f   // Feed rate of G0 moves in units/min
+
+#define GCODE_WORD_X 0x0001 // X word present
+#define GCODE_WORD_Y 0x0002 // Y word present
+#define GCODE_WORD_Z 0x0004 // Z word present
+#define GCODE_WORD_A 0x0008 // A word present
+#define GCODE_WORD_F 0x0010 // F word present
+#define GCODE_WORD_P 0x0020 // P word present
+
+/** Words of one parsed line */
+typedef struct
+{
+    int16_t G[GCODE_MAX_G_WORDS]; // G numbers in the order given
+    uint8_t G_Count;              // Number of valid entries in G
+    int16_t M;                    // M number, -1 if none
+    uint16_t Word_Mask;           // GCODE_WORD_* bits of the words present
+    float Axis[DDA_MAX_AXES];     // X, Y, Z and A values
+    float F;                      // Feed rate in units/min
+    float P;                      // Dwell time in ms
+} Gcode_Block_t;
+
+/** Machine configuration of the interpreter */
+typedef struct
+{
+    float Steps_Per_Unit[DDA_MAX_AXES]; // Steps per unit of X, Y, Z and A
+    float Rapid_Rate;                   // Feed rate of G0 moves in units/min
+} Gcode_Config_t;
+
+/** Modal state of the interpreter */
+typedef struct
+{
+    Gcode_Config_t Config;          // Machine configuration
+    bool Relative;                  // G91 active
+    bool Rapid;                     // G0 active, G1 otherwise
+    float Feed_Rate;                // Last F word in units/min
+    int32_t Position[DDA_MAX_AXES]; // Machine position in steps
+    int32_t Offset[DDA_MAX_AXES];   // G92 origin in machine steps
+    bool Program_End;               // M2 or M30 seen
+} Gcode_State_t;
+
+/** Kind of action produced by one block */
+typedef enum
+{
+    GCODE_ACTION_NONE = 0, // Modal change only
+    GCODE_ACTION_MOVE,     // Straight move
+    GCODE_ACTION_DWELL,    // Wait with the motors stopped
+    GCODE_ACTION_ENABLE,   // Enable the motor drivers
+    GCODE_ACTION_DISABLE,  // Disable the motor drivers
+} Gcode_Action_Type_t;
+
+/** Action produced by one block */
+typedef struct
+{
+    Gcode_Action_Type_t Type;    // Kind of action
+    int32_t Steps[DDA_MAX_AXES]; // Signed steps per axis, GCODE_ACTION_MOVE only
+    float Nominal_Speed;         // Path speed in steps/s, GCODE_ACTION_MOVE only
+    uint32_t Dwell_ms;           // Dwell time, GCODE_ACTION_DWELL only
+} Gcode_Action_t;
+
+void Gcode_Default_Config(Gcode_Config_t *Config);
+void Gcode_Init(Gcode_State_t *State, const Gcode_Config_t *Config);
+bool Gcode_Parse_Line(const char *Line, Gcode_Block_t *Block);
+bool Gcode_Execute_Block(Gcode_State_t *State, const Gcode_Block_t *Block, Gcode_Action_t *Action);
+
+#endif // GCODE_PARSER_H
@@ -0,0 +1,224 @@
+/*H**********************************************************************
+ * FILENAME :        gcode_stream.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Streaming G-code front end for the stepper motor example.
+ *
+ * NOTES :
+ *       Blocks stay in the look-ahead planner until it is full, so every
+ *       block handed to the motion queue has been planned against the
+ *       LOOKAHEAD_DEPTH blocks behind it. When the stream pauses, the
+ *       planner is emptied and the path is brought to a stop.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "gcode_stream.h"
+#include "motion_queue.h"
+#include "main.h"
+
+static RingbufHandle_t Gcode_Ring = NULL; // Received lines waiting for the G-code task
+static Gcode_State_t Gcode_State;         // Interpreter state of the stream
+static Lookahead_Planner_t Gcode_Planner; // Look-ahead planner of the stream
+
+/**
+ * @brief Hand the oldest planned block to the motion queue.
+ *
+ * Waits for space in the motion queue, which throttles the stream to the
+ * speed of the motors.
+ *
+ * @return false if the planner was empty.
+ */
+static bool Commit_Block(void)
+{
+    Lookahead_Output_t Block;
+
+    if (!Lookahead_Pop_Block(&Gcode_Planner, &Block))
+    {
+        return false;
+    }
+
+    Motion_Command_t Command = {
+        .Type = MOTION_COMMAND_BLOCK,                   // Look-ahead planned block
+        .Frequency_Hz = Block.Nominal_Frequency_Hz,     // Cruise frequency of the longest axis
+        .Entry_Frequency_Hz = Block.Entry_Frequency_Hz, // Frequency at the start
+        .Exit_Frequency_Hz = Block.Exit_Frequency_Hz,   // Frequency at the end
+        .Acceleration = Block.Acceleration,             // Acceleration of the longest axis
+    };
+
+    memcpy(Command.Axis_Steps, Block.Steps, sizeof(Command.Axis_Steps));
+
+    Motion_Queue_Enqueue_Wait(&Command, portMAX_DELAY);
+
+    return true;
+}
+
+/**
+ * @brief Queue a non-motion command after the path has been brought to a stop.
+ */
+static void Commit_Command(Motion_Command_Type_t Type, uint32_t Dwell_ms)
+{
+    Motion_Command_t Command = {
+        .Type = Type,         // Dwell, enable or stop
+        .Dwell_ms = Dwell_ms, // Dwell time
+    };
+
+    while (Commit_Block())
+    {
+        // Drain the planner, its last block ends at standstill
+    }
+
+    Motion_Queue_Enqueue_Wait(&Command, portMAX_DELAY);
+}
+
+/**
+ * @brief Execute one received line.
+ */
+static void Execute_Gcode_Line(const char *Line)
+{
+    Gcode_Block_t Block;
+    Gcode_Action_t Action;
+
+    if (!Gcode_Parse_Line(Line, &Block) || !Gcode_Execute_Block(&Gcode_State, &Block, &Action))
+    {
+        printf("error: %s\n", Line);
+
+        return;
+    }
+
+    switch (Action.Type)
+    {
+    case GCODE_ACTION_MOVE:
+        if (Lookahead_Is_Full(&Gcode_Planner))
+        {
+            Commit_Block();
+        }
+
+        Lookahead_Add_Block(&Gcode_Planner, Action.Steps, Action.Nominal_Speed);
+        break;
+
+    case GCODE_ACTION_DWELL:
+        Commit_Command(MOTION_COMMAND_DWELL, Action.Dwell_ms);
+        break;
+
+    case GCODE_ACTION_ENABLE:
+        Commit_Command(MOTION_COMMAND_ENABLE, 0);
+        break;
+
+    case GCODE_ACTION_DISABLE:
+        Commit_Command(MOTION_COMMAND_STOP, 0);
+        break;
+
+    case GCODE_ACTION_NONE:
+    default:
+        break;
+    }
+
+    if (Gcode_State.Program_End)
+    {
+        while (Commit_Block())
+        {
+            // End of program, plan the path to a stop
+        }
+
+        Gcode_State.Program_End = false;
+    }
+}
+
+/**
+ * @brief G-code task, parses the received lines and feeds the planner.
+ */
+static void Gcode_Task(void *arg)
+{
+    TickType_t Wait = portMAX_DELAY;
+    char Line[GCODE_MAX_LINE_LENGTH];
+
+    while (true)
+    {
+        size_t Size = 0;
+        char *Item = xRingbufferReceive(Gcode_Ring, &Size, Wait);
+
+        if (Item == NULL)
+        {
+            while (Commit_Block())
+            {
+                // Stream paused, plan the path to a stop
+            }
+
+            Wait = portMAX_DELAY;
+
+            continue;
+        }
+
+        Size = (Size < sizeof(Line)) ? Size : (sizeof(Line) - 1);
+        memcpy(Line, Item, Size);
+        Line[Size] = '\0';
+
+        vRingbufferReturnItem(Gcode_Ring, Item);
+
+        Execute_Gcode_Line(Line);
+
+        Wait = pdMS_TO_TICKS(GCODE_IDLE_FLUSH_MS);
+    }
+}
+
+/**
+ * @brief Create the line ring buffer and start the G-code task.
+ *
+ * @return
+ *     - ESP_OK: Successfully started the G-code task
+ *     - ESP_ERR_NO_MEM: Insufficient memory for the ring buffer or the task
+ */
+esp_err_t Initialize_Gcode_Stream(void)
+{
+    Gcode_Config_t Config;
+
+    Gcode_Default_Config(&Config);
+    Gcode_Init(&Gcode_State, &Config);
+    Lookahead_Init(&Gcode_Planner, GCODE_PATH_ACCELERATION, LOOKAHEAD_DEFAULT_JUNCTION_DEVIATION);
+
+    Gcode_Ring = xRingbufferCreate(GCODE_RING_BUFFER_SIZE, RINGBUF_TYPE_NOSPLIT);
+
+    if (Gcode_Ring == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreate(Gcode_Task, "gcode", GCODE_TASK_STACK_SIZE, NULL, GCODE_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Put one received line into the ring buffer.
+ *
+ * @param Line Line without the line ending.
+ * @param Wait Longest time to wait for space in the ring buffer.
+ * @return
+ *     - ESP_OK: Line queued
+ *     - ESP_ERR_INVALID_SIZE: Line longer than GCODE_MAX_LINE_LENGTH
+ *     - ESP_ERR_TIMEOUT: Ring buffer still full after the wait
+ */
+esp_err_t Gcode_Stream_Send_Line(const char *Line, TickType_t Wait)
+{
+    size_t Length = strlen(Line);
+
+    if (Length >= GCODE_MAX_LINE_LENGTH)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    if (xRingbufferSend(Gcode_Ring, Line, Length, Wait) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
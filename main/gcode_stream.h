@@ -0,0 +1,39 @@
+/*H**********************************************************************
+ * FILENAME :        gcode_stream.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Streaming G-code front end for the stepper motor example.
+ *
+ * NOTES :
+ *       Lines received on the console are put into a ring buffer and
+ *       acknowledged with "ok" right away. A G-code task parses them,
+ *       runs the look-ahead planner and hands the planned blocks to the
+ *       motion queue, so the sender never waits for a move to finish.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef GCODE_STREAM_H
+#define GCODE_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/ringbuf.h"
+#include "esp_err.h"
+#include "gcode_parser.h"
+#include "lookahead_planner.h"
+
+#define GCODE_RING_BUFFER_SIZE 2048       // Bytes of received lines waiting for the G-code task
+#define GCODE_TASK_STACK_SIZE 4096        // Stack size of the G-code task in bytes
+#define GCODE_TASK_PRIORITY 9             // Below the motion task, above the console task
+#define GCODE_IDLE_FLUSH_MS 50            // Plan the queued blocks to a stop if no line arrives for this long
+#define GCODE_PATH_ACCELERATION 100000.0f // Path acceleration of G-code moves in steps/s^2
+
+esp_err_t Initialize_Gcode_Stream(void);
+esp_err_t Gcode_Stream_Send_Line(const char *Line, TickType_t Wait);
+
+#endif // GCODE_STREAM_H
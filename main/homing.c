@@ -0,0 +1,334 @@
+/*H**********************************************************************
+ * FILENAME :        homing.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Homing of the single axis motor against a limit switch.
+ *
+ * NOTES :
+ *       The position is latched in the edge interrupt of the switch from
+ *       the pulse counter, so it does not depend on how fast the task
+ *       notices the latch. The interrupt is only armed during an approach,
+ *       later edges of a bouncing switch are ignored.
+ *
+ *       The speed at the fast latch is measured from the positions sampled
+ *       by the task every RTOS tick. The distance between the fast and the
+ *       slow latch, divided by that speed, is the delay from the switch
+ *       edge to the latch at full speed, interrupt latency included. The
+ *       slow approach runs at a speed where that delay is below one step.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "homing.h"
+#include "main.h"
+#include "esp_timer.h"
+
+/** Position latched by the switch interrupt */
+typedef struct
+{
+    int32_t Position; // Motor position at the switch edge
+    int64_t Time_us;  // esp_timer_get_time() right after the position was read
+    uint32_t Isr_us;  // Time from entering the interrupt to the latched position
+} Homing_Latch_t;
+
+static Homing_Latch_t Latch;           // Latch of the running approach, written by the interrupt
+static bool Latch_Armed = false;       // The next switch edge latches, accessed atomically
+static bool Latch_Taken = false;       // Latch holds the position of the running approach, accessed atomically
+static Homing_Result_t Last_Result = { // Measurements of the last homing run
+    .Result = ESP_ERR_INVALID_STATE,   // Not homed since boot
+};
+
+/**
+ * @brief Edge interrupt of the home switch.
+ *
+ * Latches the position and requests a quick-stop, once per armed approach.
+ */
+static void Homing_Switch_ISR(void *arg)
+{
+    int64_t Entry_us = esp_timer_get_time();
+
+    if (!__atomic_load_n(&Latch_Armed, __ATOMIC_ACQUIRE))
+    {
+        return; // Not homing, or a bounce after the latch
+    }
+
+    __atomic_store_n(&Latch_Armed, false, __ATOMIC_RELAXED);
+
+    Latch.Position = Get_Stepper_Motor_Position();
+    Latch.Time_us = esp_timer_get_time();
+    Latch.Isr_us = (uint32_t)(Latch.Time_us - Entry_us);
+
+    __atomic_store_n(&Latch_Taken, true, __ATOMIC_RELEASE);
+
+    Quick_Stop_Stepper_Motor();
+
+    MOTION_TRACE(MOTION_TRACE_HOME_LATCH, Latch.Position);
+}
+
+/**
+ * @brief Configure the home switch input and its edge interrupt.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t Initialize_Homing(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    // Configuration structure for the switch input
+    gpio_config_t io_conf = {}; // Zero-initialize the config structure
+
+    io_conf.intr_type = (HOMING_SWITCH_ACTIVE_LEVEL == 0) ? GPIO_INTR_NEGEDGE : GPIO_INTR_POSEDGE; // Interrupt when the switch closes
+    io_conf.mode = GPIO_MODE_INPUT;                                                                // Input only
+    io_conf.pin_bit_mask = (1ULL << HOMING_SWITCH_PIN);                                            // Switch pin
+    io_conf.pull_up_en = (HOMING_SWITCH_ACTIVE_LEVEL == 0) ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
+    io_conf.pull_down_en = (HOMING_SWITCH_ACTIVE_LEVEL == 0) ? GPIO_PULLDOWN_DISABLE : GPIO_PULLDOWN_ENABLE;
+
+    Function_Error += gpio_config(&io_conf);
+
+    esp_err_t Service_Error = gpio_install_isr_service(0);
+
+    if (Service_Error != ESP_ERR_INVALID_STATE) // Already installed by someone else otherwise
+    {
+        Function_Error += Service_Error;
+    }
+
+    Function_Error += gpio_isr_handler_add(HOMING_SWITCH_PIN, Homing_Switch_ISR, NULL);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Fill a homing configuration with the defaults of homing.h.
+ *
+ * The default direction toward the switch is backward.
+ */
+void Homing_Get_Default_Config(Homing_Config_t *Config)
+{
+    Config->Fast_Frequency_Hz = HOMING_FAST_FREQUENCY_HZ;
+    Config->Slow_Frequency_Hz = HOMING_SLOW_FREQUENCY_HZ;
+    Config->Backoff_Steps = HOMING_BACKOFF_STEPS;
+    Config->Max_Travel_Steps = HOMING_MAX_TRAVEL_STEPS;
+    Config->Direction = MOTOR_DIRECTION_BACKWARD;
+}
+
+/**
+ * @brief Check whether the home switch is pressed right now.
+ */
+bool Homing_Switch_Pressed(void)
+{
+    return gpio_get_level(HOMING_SWITCH_PIN) == HOMING_SWITCH_ACTIVE_LEVEL;
+}
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_LEDC
+/**
+ * @brief Run toward the switch until it latches, then stop.
+ *
+ * A ramped approach starts like Start_Stepper_Motor(), an unramped one
+ * starts and stops right at its frequency. The latch requests the stop in
+ * the interrupt, a ramp still running is retargeted to it, a held speed is
+ * ramped down by Decelerate_Stepper_Motor() here.
+ *
+ * @param Frequency_Hz Approach frequency.
+ * @param Direction Direction toward the switch.
+ * @param Max_Travel_Steps Distance after which the search gives up.
+ * @param Ramped Accelerate to the frequency along the planned ramp.
+ * @param Speed_Hz Returns the speed at the latch, measured over the one to two RTOS ticks before it.
+ * @return
+ *     - ESP_OK: Latch holds the position of the switch edge
+ *     - ESP_ERR_NOT_FOUND: Switch not reached within Max_Travel_Steps
+ *     - ESP_ERR_INVALID_STATE: Stopped or aborted from outside
+ *     - Error of the motor functions otherwise
+ */
+static esp_err_t Approach_Switch(uint32_t Frequency_Hz, uint8_t Direction, uint32_t Max_Travel_Steps, bool Ramped, uint32_t *Speed_Hz)
+{
+    esp_err_t Function_Error = ESP_OK;
+    int32_t Toward = (Direction == MOTOR_DIRECTION_FORWARD) ? 1 : -1;
+    int32_t Start_Position = Get_Stepper_Motor_Position();
+    int32_t Sample_Position[2] = {Start_Position, Start_Position};       // Positions at the last two ticks, newest first
+    int64_t Sample_us[2] = {esp_timer_get_time(), esp_timer_get_time()}; // Times of those samples
+    bool Travel_Exceeded = false;
+
+    __atomic_store_n(&Latch_Taken, false, __ATOMIC_RELAXED);
+    __atomic_store_n(&Latch_Armed, true, __ATOMIC_RELEASE);
+
+    if (Ramped)
+    {
+        Function_Error = Start_Stepper_Motor(Direction, Frequency_Hz, PWM_DUTY_CYCLE_50);
+    }
+    else
+    {
+        Function_Error = Set_Stepper_Motor_Velocity(Toward * (int32_t)Frequency_Hz, PWM_DUTY_CYCLE_50);
+    }
+
+    while ((Function_Error == ESP_OK) && (Stepper_Motor_Stop_Requested() == 0) && !Stepper_Motor_Abort_Requested())
+    {
+        int32_t Position = Get_Stepper_Motor_Position();
+        int64_t Now_us = esp_timer_get_time();
+
+        if (__atomic_load_n(&Latch_Taken, __ATOMIC_ACQUIRE))
+        {
+            break; // Latched between the stop request check and here
+        }
+
+        if ((uint32_t)((Position - Start_Position) * Toward) >= Max_Travel_Steps)
+        {
+            Travel_Exceeded = true;
+
+            Request_Stepper_Motor_Stop(MOTION_DEFAULT_ACCELERATION);
+
+            break;
+        }
+
+        Sample_Position[1] = Sample_Position[0];
+        Sample_us[1] = Sample_us[0];
+        Sample_Position[0] = Position;
+        Sample_us[0] = Now_us;
+
+        vTaskDelay(1); // One check per RTOS tick, the latch itself does not wait for it
+    }
+
+    __atomic_store_n(&Latch_Armed, false, __ATOMIC_RELEASE);
+
+    Function_Error += Decelerate_Stepper_Motor(NULL); // Ramps a held speed down, takes the count into the position
+
+    bool Latched = __atomic_load_n(&Latch_Taken, __ATOMIC_ACQUIRE);
+
+    if (Latched || Travel_Exceeded)
+    {
+        Clear_Stepper_Motor_Stop(); // Requested by the homing itself, a stop from outside stays set
+    }
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    if (!Latched)
+    {
+        return Travel_Exceeded ? ESP_ERR_NOT_FOUND : ESP_ERR_INVALID_STATE;
+    }
+
+    // The newest sample may be taken just before the latch, the older one lies at least a tick before it
+    int64_t Elapsed_us = Latch.Time_us - Sample_us[1];
+
+    *Speed_Hz = (Elapsed_us > 0) ? (uint32_t)(((int64_t)(Latch.Position - Sample_Position[1]) * Toward * 1000000) / Elapsed_us) : 0;
+
+    return ESP_OK;
+}
+
+#endif
+
+/**
+ * @brief Find the home switch and make its position 0.
+ *
+ * Runs in the task that executes the motion, blocks until the motor stands
+ * still at the end. If the switch is pressed at the start the motor first
+ * backs off by the back-off distance. The measurements are kept for
+ * Homing_Get_Result(), also if the run fails.
+ *
+ * @param Config Homing parameters, see Homing_Get_Default_Config().
+ * @return
+ *     - ESP_OK: Homed, the position is referenced
+ *     - ESP_ERR_INVALID_ARG: Frequency or distance of 0, or a slow frequency above the fast one
+ *     - ESP_ERR_NOT_FOUND: Switch not reached within the travel limit
+ *     - ESP_ERR_INVALID_STATE: Switch still pressed after backing off, or stopped from outside
+ *     - ESP_ERR_NOT_SUPPORTED: RMT or timer pulse engine
+ *     - Error of the motor functions otherwise
+ */
+esp_err_t Home_Stepper_Motor(const Homing_Config_t *Config)
+{
+    Homing_Result_t Result;
+
+    memset(&Result, 0, sizeof(Result));
+
+#if STEPPER_PULSE_ENGINE != STEPPER_PULSE_ENGINE_LEDC
+    Result.Result = ESP_ERR_NOT_SUPPORTED; // No position while the motor moves
+#else
+    esp_err_t Function_Error = ESP_OK;
+    int32_t Toward = (Config->Direction == MOTOR_DIRECTION_FORWARD) ? 1 : -1;
+    uint8_t Away_Direction = (Config->Direction == MOTOR_DIRECTION_FORWARD) ? MOTOR_DIRECTION_BACKWARD : MOTOR_DIRECTION_FORWARD;
+    uint32_t Slow_Speed_Hz = 0;
+    int64_t Start_us = esp_timer_get_time();
+    int64_t Phase_us = Start_us;
+
+    if ((Config->Fast_Frequency_Hz == 0) || (Config->Slow_Frequency_Hz == 0) || (Config->Slow_Frequency_Hz > Config->Fast_Frequency_Hz) ||
+        (Config->Backoff_Steps == 0) || (Config->Max_Travel_Steps == 0))
+    {
+        Function_Error = ESP_ERR_INVALID_ARG;
+    }
+
+    if ((Function_Error == ESP_OK) && Homing_Switch_Pressed())
+    {
+        Function_Error = Move_Stepper_Motor(Config->Slow_Frequency_Hz, Away_Direction, Config->Backoff_Steps, NULL); // Leave the switch first
+
+        Function_Error = ((Function_Error == ESP_OK) && Homing_Switch_Pressed()) ? ESP_ERR_INVALID_STATE : Function_Error;
+    }
+
+    // Fast approach
+    if (Function_Error == ESP_OK)
+    {
+        Phase_us = esp_timer_get_time();
+
+        Function_Error = Approach_Switch(Config->Fast_Frequency_Hz, Config->Direction, Config->Max_Travel_Steps, true, &Result.Fast_Speed_Hz);
+
+        Result.Fast_Approach_us = (uint32_t)(esp_timer_get_time() - Phase_us);
+    }
+
+    if (Function_Error == ESP_OK)
+    {
+        Result.Fast_Latch = Latch.Position;
+        Result.Overtravel_Steps = (uint32_t)((Get_Stepper_Motor_Position() - Latch.Position) * Toward);
+        Result.Isr_Latch_us = Latch.Isr_us;
+
+        // Back off to the start of the slow approach
+        Phase_us = esp_timer_get_time();
+
+        Function_Error = Move_Stepper_Motor_To(Config->Fast_Frequency_Hz, Result.Fast_Latch - (Toward * (int32_t)Config->Backoff_Steps), NULL);
+
+        Result.Backoff_us = (uint32_t)(esp_timer_get_time() - Phase_us);
+
+        Function_Error = ((Function_Error == ESP_OK) && Homing_Switch_Pressed()) ? ESP_ERR_INVALID_STATE : Function_Error;
+    }
+
+    // Slow approach
+    if (Function_Error == ESP_OK)
+    {
+        Phase_us = esp_timer_get_time();
+
+        Function_Error = Approach_Switch(Config->Slow_Frequency_Hz, Config->Direction, HOMING_SLOW_TRAVEL_FACTOR * Config->Backoff_Steps, false, &Slow_Speed_Hz);
+
+        Result.Slow_Approach_us = (uint32_t)(esp_timer_get_time() - Phase_us);
+    }
+
+    if (Function_Error == ESP_OK)
+    {
+        Result.Slow_Latch = Latch.Position;
+        Result.Latch_Error = (Result.Fast_Latch - Result.Slow_Latch) * Toward;
+        Result.Latch_Delay_us = (Result.Fast_Speed_Hz > 0) ? (uint32_t)(((int64_t)((Result.Latch_Error < 0) ? -Result.Latch_Error : Result.Latch_Error) * 1000000) / Result.Fast_Speed_Hz) : 0;
+
+        Set_Stepper_Motor_Position(Get_Stepper_Motor_Position() - Result.Slow_Latch); // The slow latch becomes 0
+    }
+
+    Result.Total_us = (uint32_t)(esp_timer_get_time() - Start_us);
+    Result.Result = Function_Error;
+#endif
+
+    Last_Result = Result;
+
+    return Result.Result;
+}
+
+/**
+ * @brief Measurements of the last homing run.
+ *
+ * @param Result Output copy, Result is ESP_ERR_INVALID_STATE if there was no run since boot.
+ */
+void Homing_Get_Result(Homing_Result_t *Result)
+{
+    *Result = Last_Result;
+}
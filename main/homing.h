@@ -0,0 +1,75 @@
+/*H**********************************************************************
+ * FILENAME :        homing.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Homing of the single axis motor against a limit switch.
+ *
+ * NOTES :
+ *       The switch closes HOMING_SWITCH_PIN to HOMING_SWITCH_ACTIVE_LEVEL,
+ *       the pin is pulled to the other level otherwise. The motor runs
+ *       toward the switch at the fast frequency. The edge interrupt latches
+ *       the position the moment the switch triggers and requests a
+ *       quick-stop. The motor then backs off to the back-off distance before
+ *       the latch and approaches again at the slow frequency. The second
+ *       latch becomes position 0.
+ *
+ *       Both approaches are timed and the fast one is compared with the slow
+ *       one, see Homing_Result_t. LEDC engine only, the RMT and the timer
+ *       engine cannot read the position while the motor moves.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef HOMING_H
+#define HOMING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver/gpio.h"
+#include "esp_err.h"
+
+#define HOMING_SWITCH_PIN GPIO_NUM_5    // Home limit switch input
+#define HOMING_SWITCH_ACTIVE_LEVEL 0    // Level while the switch is pressed, pulled up otherwise
+#define HOMING_FAST_FREQUENCY_HZ 20000  // Default cruise frequency of the first approach
+#define HOMING_SLOW_FREQUENCY_HZ 400    // Default frequency of the second approach, started without a ramp
+#define HOMING_BACKOFF_STEPS 400        // Default distance from the first latch the second approach starts at
+#define HOMING_MAX_TRAVEL_STEPS 1000000 // Default longest search for the switch
+#define HOMING_SLOW_TRAVEL_FACTOR 2     // The second approach gives up after this many back-off distances
+
+/** Parameters of one homing run */
+typedef struct
+{
+    uint32_t Fast_Frequency_Hz; // Cruise frequency of the first approach
+    uint32_t Slow_Frequency_Hz; // Frequency of the second approach
+    uint32_t Backoff_Steps;     // Distance from the first latch the second approach starts at
+    uint32_t Max_Travel_Steps;  // Longest search for the switch
+    uint8_t Direction;          // Direction toward the switch, MOTOR_DIRECTION_FORWARD or MOTOR_DIRECTION_BACKWARD
+} Homing_Config_t;
+
+/** Measurements of the last homing run, positions before the new zero was set */
+typedef struct
+{
+    esp_err_t Result;           // Result of the run
+    int32_t Fast_Latch;         // Position latched on the fast approach
+    int32_t Slow_Latch;         // Position latched on the slow approach, becomes 0
+    int32_t Latch_Error;        // Steps the fast latch lies past the slow one, toward the switch
+    uint32_t Overtravel_Steps;  // Steps run past the fast latch while stopping
+    uint32_t Fast_Speed_Hz;     // Speed at the fast latch, measured over the RTOS ticks before it
+    uint32_t Latch_Delay_us;    // Latch_Error at Fast_Speed_Hz, the delay from the switch to the latch
+    uint32_t Isr_Latch_us;      // Time from entering the interrupt to the latched position
+    uint32_t Fast_Approach_us;  // Start to standstill after the fast latch
+    uint32_t Backoff_us;        // Back-off move
+    uint32_t Slow_Approach_us;  // Slow approach to standstill after the slow latch
+    uint32_t Total_us;          // Whole run
+} Homing_Result_t;
+
+esp_err_t Initialize_Homing(void);
+void Homing_Get_Default_Config(Homing_Config_t *Config);
+esp_err_t Home_Stepper_Motor(const Homing_Config_t *Config);
+void Homing_Get_Result(Homing_Result_t *Result);
+bool Homing_Switch_Pressed(void);
+
+#endif // HOMING_H
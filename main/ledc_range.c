@@ -0,0 +1,153 @@
+/*H**********************************************************************
+ * FILENAME :        ledc_range.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent frequency range manager of the LEDC step
+ *       output: clock source, divider and duty resolution of the timer for
+ *       every step rate, with the achieved frequency and its error.
+ *
+ * NOTES :
+ *       The divider is rounded to the nearest 1/256, the frequency error is
+ *       computed from the difference of the clock and the divided period so
+ *       it fits 64 bits on the ESP32.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "ledc_range.h"
+
+/**
+ * @brief Setting of one clock at the lowest resolution from Min_Bits on whose divider fits.
+ *
+ * @return false if the frequency is too high for the clock at Min_Bits, Range is not written then.
+ */
+static bool Select_Clock(Ledc_Range_Clock_t Clock, uint32_t Frequency_Hz, uint8_t Min_Bits, Ledc_Range_t *Range)
+{
+    uint64_t Clock_Q8 = (uint64_t)Ledc_Range_Clock_Hz(Clock) << LEDC_RANGE_DIVIDER_FRACTION_BITS; // Source clock, scaled like the divider
+
+    for (uint8_t Bits = Min_Bits; Bits <= LEDC_RANGE_MAX_BITS; Bits++)
+    {
+        uint64_t Ticks_Hz = (uint64_t)Frequency_Hz << Bits;        // Divided clock the frequency needs at this resolution
+        uint64_t Divider = (Clock_Q8 + (Ticks_Hz / 2)) / Ticks_Hz; // Nearest divider
+
+        if (Divider < LEDC_RANGE_MIN_DIVIDER)
+        {
+            return false; // Higher resolutions need an even smaller divider
+        }
+
+        if (Divider > LEDC_RANGE_MAX_DIVIDER)
+        {
+            continue; // Too slow for this resolution, a higher one halves the divider
+        }
+
+        uint64_t Period_Q8 = Divider << Bits;                                     // Source clock cycles of one period, scaled like the divider
+        int64_t Offset = (int64_t)Clock_Q8 - (int64_t)(Period_Q8 * Frequency_Hz); // Achieved minus requested frequency, times the period
+
+        Range->Requested_Hz = Frequency_Hz;
+        Range->Clock = Clock;
+        Range->Divider = (uint32_t)Divider;
+        Range->Resolution_Bits = Bits;
+        Range->Achieved_mHz = ((Clock_Q8 * 1000) + (Period_Q8 / 2)) / Period_Q8;
+        Range->Error_ppb = (int32_t)((Offset * 1000000000) / (int64_t)(Period_Q8 * Frequency_Hz)); // Below 1/512 of the frequency at a divider of 1.0
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Pick the clock, divider and duty resolution of a step frequency.
+ *
+ * @param Frequency_Hz Step frequency, 1 to LEDC_RANGE_MAX_FREQUENCY_HZ.
+ * @param Min_Bits Lowest duty resolution allowed, see Ledc_Range_Duty_Bits().
+ * @param Range Returns the timer setting.
+ * @return false for 0 or a frequency above what Min_Bits allows, Range is not written then.
+ */
+bool Ledc_Range_Select(uint32_t Frequency_Hz, uint8_t Min_Bits, Ledc_Range_t *Range)
+{
+    Ledc_Range_t Ref_Tick;
+
+    if (Frequency_Hz == 0)
+    {
+        return false;
+    }
+
+    Min_Bits = (Min_Bits < LEDC_RANGE_MIN_BITS) ? LEDC_RANGE_MIN_BITS : Min_Bits;
+
+    bool Apb_Fits = Select_Clock(LEDC_RANGE_APB, Frequency_Hz, Min_Bits, Range);
+    bool Ref_Tick_Fits = Select_Clock(LEDC_RANGE_REF_TICK, Frequency_Hz, Min_Bits, &Ref_Tick);
+
+    if (Ref_Tick_Fits && (!Apb_Fits || ((Ref_Tick.Error_ppb == 0) && (Range->Error_ppb != 0))))
+    {
+        *Range = Ref_Tick; // Exact where APB is not
+    }
+
+    return Apb_Fits || Ref_Tick_Fits;
+}
+
+/**
+ * @brief Duty register of a duty given at LEDC_RANGE_DUTY_BITS, at the resolution of a setting.
+ *
+ * A duty above 0 keeps a pulse in every period: it is at least 1 and
+ * below the full count, at 1 bit every duty is half.
+ *
+ * @param Range Setting of the peak frequency of the move.
+ * @param Duty Duty of 0 to 2^LEDC_RANGE_DUTY_BITS.
+ * @return Value for the duty register.
+ */
+uint32_t Ledc_Range_Duty(const Ledc_Range_t *Range, uint32_t Duty)
+{
+    uint32_t Full = 1UL << Range->Resolution_Bits;
+
+    if (Duty == 0)
+    {
+        return 0;
+    }
+
+    uint64_t Scaled = (((uint64_t)Duty << Range->Resolution_Bits) + (1UL << (LEDC_RANGE_DUTY_BITS - 1))) >> LEDC_RANGE_DUTY_BITS; // Nearest count
+
+    if (Scaled == 0)
+    {
+        return 1;
+    }
+
+    return (Scaled >= Full) ? (Full - 1) : (uint32_t)Scaled;
+}
+
+/**
+ * @brief Lowest duty resolution at which a duty register is below the full count.
+ *
+ * Selections for a running output pass it as Min_Bits, a lower resolution
+ * would keep the output high for whole periods and lose the steps.
+ */
+uint8_t Ledc_Range_Duty_Bits(uint32_t Duty)
+{
+    uint8_t Bits = LEDC_RANGE_MIN_BITS;
+
+    while ((Bits < 32) && ((Duty >> Bits) != 0))
+    {
+        Bits++;
+    }
+
+    return Bits;
+}
+
+/**
+ * @brief Frequency of a source clock in Hz.
+ */
+uint32_t Ledc_Range_Clock_Hz(Ledc_Range_Clock_t Clock)
+{
+    return (Clock == LEDC_RANGE_REF_TICK) ? LEDC_RANGE_REF_TICK_HZ : LEDC_RANGE_APB_CLK_HZ;
+}
+
+/**
+ * @brief Printable name of a source clock.
+ */
+const char *Ledc_Range_Clock_Name(Ledc_Range_Clock_t Clock)
+{
+    return (Clock == LEDC_RANGE_REF_TICK) ? "REF_TICK" : "APB";
+}
@@ -0,0 +1,73 @@
+/*H**********************************************************************
+ * FILENAME :        ledc_range.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent frequency range manager of the LEDC step
+ *       output: clock source, divider and duty resolution of the timer for
+ *       every step rate, with the achieved frequency and its error.
+ *
+ * NOTES :
+ *       The low speed timer counts 2^bits ticks of its source clock divided
+ *       by a 10.8 fixed point divider of 1.0 to 1023 + 255/256, so one duty
+ *       resolution covers about one octave at a fine divider. The lowest
+ *       resolution whose divider still fits is taken: it keeps the divider
+ *       large, the quantization of the frequency below 4 ppm up to 39 kHz,
+ *       and reaches 40 MHz at 1 bit. Both clocks are tried, REF_TICK is only
+ *       taken where it hits the frequency exactly and APB does not, so a
+ *       ramp does not switch back and forth between them.
+ *
+ *       A new divider, resolution and clock take effect together at the
+ *       next overflow of the timer, the running period is not cut. The duty
+ *       register of the channel is not rewritten when the resolution
+ *       changes: the duty is scaled once for the peak frequency of a move,
+ *       see Ledc_Range_Duty(), and later selections keep at least the
+ *       resolution it needs, so every period still has its pulse. Below the
+ *       peak the pulse keeps about its width and the duty cycle shrinks.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef LEDC_RANGE_H
+#define LEDC_RANGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LEDC_RANGE_APB_CLK_HZ 80000000                                             // APB clock of the timers
+#define LEDC_RANGE_REF_TICK_HZ 1000000                                             // REF_TICK clock, kept when the APB clock is scaled
+#define LEDC_RANGE_DIVIDER_FRACTION_BITS 8                                         // Fraction bits of the clock divider
+#define LEDC_RANGE_MIN_DIVIDER (1UL << LEDC_RANGE_DIVIDER_FRACTION_BITS)           // Divider 1.0
+#define LEDC_RANGE_MAX_DIVIDER ((1UL << 18) - 1)                                   // Divider 1023 + 255/256, 18 bit register
+#define LEDC_RANGE_MIN_BITS 1                                                      // Lowest duty resolution
+#define LEDC_RANGE_MAX_BITS 20                                                     // Highest duty resolution of the low speed timers
+#define LEDC_RANGE_DUTY_BITS 10                                                    // Resolution of the duty the callers give, 512 is half
+#define LEDC_RANGE_MAX_FREQUENCY_HZ (LEDC_RANGE_APB_CLK_HZ >> LEDC_RANGE_MIN_BITS) // Highest frequency, APB at divider 1.0 and 1 bit
+
+/** Source clock of the timer */
+typedef enum
+{
+    LEDC_RANGE_APB = 0,  // 80 MHz APB clock
+    LEDC_RANGE_REF_TICK, // 1 MHz REF_TICK clock
+} Ledc_Range_Clock_t;
+
+/** Timer setting of one step frequency */
+typedef struct
+{
+    uint32_t Requested_Hz;    // Frequency asked for
+    Ledc_Range_Clock_t Clock; // Source clock
+    uint32_t Divider;         // Clock divider in 10.8 fixed point
+    uint8_t Resolution_Bits;  // Duty resolution, the period is 2^bits divided clock ticks
+    uint64_t Achieved_mHz;    // Frequency the timer runs at in mHz
+    int32_t Error_ppb;        // Achieved minus requested frequency in parts per billion of the requested one
+} Ledc_Range_t;
+
+bool Ledc_Range_Select(uint32_t Frequency_Hz, uint8_t Min_Bits, Ledc_Range_t *Range);
+uint32_t Ledc_Range_Duty(const Ledc_Range_t *Range, uint32_t Duty);
+uint8_t Ledc_Range_Duty_Bits(uint32_t Duty);
+uint32_t Ledc_Range_Clock_Hz(Ledc_Range_Clock_t Clock);
+const char *Ledc_Range_Clock_Name(Ledc_Range_Clock_t Clock);
+
+#endif // LEDC_RANGE_H
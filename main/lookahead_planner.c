@@ -0,0 +1,252 @@
+/*H**********************************************************************
+ * FILENAME :        lookahead_planner.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent look-ahead velocity planner for streamed
+ *       multi-axis moves.
+ *
+ * NOTES :
+ *       Speeds are path speeds in steps/s, so blocks whose longest axis
+ *       differs can be compared. They are converted to the frequency of the
+ *       longest axis only when a block leaves the planner.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lookahead_planner.h"
+
+/**
+ * @brief Ring index of the block at the given position behind the head.
+ */
+static uint8_t Block_Index(const Lookahead_Planner_t *Planner, uint8_t Position)
+{
+    return (uint8_t)((Planner->Head + Position) % LOOKAHEAD_DEPTH);
+}
+
+/**
+ * @brief Highest speed from which the given distance is enough to reach the target speed.
+ */
+static float Reachable_Speed(float Acceleration, float Target_Speed, float Distance)
+{
+    return sqrtf((Target_Speed * Target_Speed) + (2.0f * Acceleration * Distance));
+}
+
+/**
+ * @brief Highest speed at the junction between two directions.
+ *
+ * The corner is replaced by an arc deviating Junction_Deviation from the
+ * corner point; the speed is the one at which the centripetal acceleration
+ * on that arc equals the acceleration limit.
+ */
+static float Junction_Speed(const Lookahead_Planner_t *Planner, const float *Previous, const float *Next)
+{
+    float Cos_Theta = 0.0f; // Cosine of the angle between the reversed previous and the next direction
+
+    for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+    {
+        Cos_Theta -= Previous[Axis] * Next[Axis];
+    }
+
+    if (Cos_Theta > 0.999999f)
+    {
+        return 0.0f; // Full reversal
+    }
+
+    if (Cos_Theta < -0.999999f)
+    {
+        return INFINITY; // Straight continuation, limited by the nominal speeds only
+    }
+
+    float Sin_Half_Theta = sqrtf(0.5f * (1.0f - Cos_Theta));
+
+    return sqrtf((Planner->Acceleration * Planner->Junction_Deviation * Sin_Half_Theta) / (1.0f - Sin_Half_Theta));
+}
+
+/**
+ * @brief Recompute the entry speeds of all queued blocks.
+ *
+ * The reverse pass starts from standstill after the last block and lowers
+ * every entry speed to what can still be braked within the blocks behind
+ * it. The forward pass starts from the locked exit speed of the block
+ * already handed out and lowers every entry speed to what can be reached by
+ * accelerating through the blocks in front of it.
+ */
+static void Recalculate(Lookahead_Planner_t *Planner)
+{
+    float Next_Entry = 0.0f; // Entry speed of the block after the current one, 0 after the last
+
+    for (int16_t Position = Planner->Count - 1; Position >= 0; Position--)
+    {
+        Lookahead_Block_t *Block = &Planner->Blocks[Block_Index(Planner, (uint8_t)Position)];
+
+        Block->Entry_Speed = fminf(Block->Max_Entry_Speed, Reachable_Speed(Planner->Acceleration, Next_Entry, Block->Length));
+        Next_Entry = Block->Entry_Speed;
+    }
+
+    float Previous_Exit = Planner->Locked_Exit_Speed; // Speed the previous block actually ends with
+
+    for (uint8_t Position = 0; Position < Planner->Count; Position++)
+    {
+        Lookahead_Block_t *Block = &Planner->Blocks[Block_Index(Planner, Position)];
+
+        Block->Entry_Speed = (Position == 0) ? Previous_Exit : fminf(Block->Entry_Speed, Previous_Exit);
+        Previous_Exit = fminf(Block->Nominal_Speed, Reachable_Speed(Planner->Acceleration, Block->Entry_Speed, Block->Length));
+    }
+}
+
+/**
+ * @brief Start an empty plan.
+ *
+ * @param Planner Planner state.
+ * @param Acceleration Path acceleration in steps/s^2.
+ * @param Junction_Deviation Allowed deviation from a corner in steps.
+ */
+void Lookahead_Init(Lookahead_Planner_t *Planner, float Acceleration, float Junction_Deviation)
+{
+    memset(Planner, 0, sizeof(*Planner));
+
+    Planner->Acceleration = Acceleration;
+    Planner->Junction_Deviation = Junction_Deviation;
+}
+
+/**
+ * @brief Drop all queued blocks and continue from standstill.
+ *
+ * @param Planner Planner state.
+ */
+void Lookahead_Reset(Lookahead_Planner_t *Planner)
+{
+    Lookahead_Init(Planner, Planner->Acceleration, Planner->Junction_Deviation);
+}
+
+/**
+ * @brief Queue a straight block and replan.
+ *
+ * @param Planner Planner state.
+ * @param Steps Signed steps per axis, DDA_MAX_AXES entries.
+ * @param Nominal_Speed Requested path speed in steps/s.
+ * @return false if the planner is full or the speed is not positive. A block
+ *         without steps is accepted and dropped.
+ */
+bool Lookahead_Add_Block(Lookahead_Planner_t *Planner, const int32_t *Steps, float Nominal_Speed)
+{
+    if (Lookahead_Is_Full(Planner) || !(Nominal_Speed > 0.0f))
+    {
+        return false;
+    }
+
+    Lookahead_Block_t *Block = &Planner->Blocks[Block_Index(Planner, Planner->Count)];
+    float Length_Squared = 0.0f;
+
+    for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+    {
+        Block->Steps[Axis] = Steps[Axis];
+        Length_Squared += (float)Steps[Axis] * (float)Steps[Axis];
+    }
+
+    if (Length_Squared == 0.0f)
+    {
+        return true; // Nothing to move
+    }
+
+    Block->Length = sqrtf(Length_Squared);
+    Block->Nominal_Speed = Nominal_Speed;
+
+    for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+    {
+        Block->Unit_Vector[Axis] = Steps[Axis] / Block->Length;
+    }
+
+    // The first block after a stop starts from standstill
+    bool Moving = (Planner->Count > 0) || (Planner->Locked_Exit_Speed > 0.0f);
+
+    Block->Max_Entry_Speed = Moving ? fminf(fminf(Nominal_Speed, Planner->Previous_Nominal_Speed), Junction_Speed(Planner, Planner->Previous_Unit_Vector, Block->Unit_Vector)) : 0.0f;
+
+    memcpy(Planner->Previous_Unit_Vector, Block->Unit_Vector, sizeof(Planner->Previous_Unit_Vector));
+    Planner->Previous_Nominal_Speed = Nominal_Speed;
+    Planner->Count++;
+
+    Recalculate(Planner);
+
+    return true;
+}
+
+/**
+ * @brief Hand the oldest block to the execution.
+ *
+ * Its exit speed becomes the fixed entry speed of the next block, so later
+ * replanning can never ask for a speed change that already happened.
+ *
+ * @param Planner Planner state.
+ * @param Output Block converted to frequencies of its longest axis.
+ * @return false if the planner is empty.
+ */
+bool Lookahead_Pop_Block(Lookahead_Planner_t *Planner, Lookahead_Output_t *Output)
+{
+    if (Planner->Count == 0)
+    {
+        return false;
+    }
+
+    const Lookahead_Block_t *Block = &Planner->Blocks[Planner->Head];
+    float Exit_Speed = (Planner->Count > 1) ? Planner->Blocks[Block_Index(Planner, 1)].Entry_Speed : 0.0f;
+    uint32_t Major_Steps = 0;
+
+    for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+    {
+        uint32_t Abs_Steps = (uint32_t)abs(Block->Steps[Axis]);
+
+        Output->Steps[Axis] = Block->Steps[Axis];
+
+        if (Abs_Steps > Major_Steps)
+        {
+            Major_Steps = Abs_Steps;
+        }
+    }
+
+    float Scale = Major_Steps / Block->Length; // Path speed to frequency of the longest axis
+
+    Output->Major_Steps = Major_Steps;
+    Output->Nominal_Frequency_Hz = (uint32_t)lroundf(Block->Nominal_Speed * Scale);
+    Output->Entry_Frequency_Hz = (uint32_t)lroundf(Block->Entry_Speed * Scale);
+    Output->Exit_Frequency_Hz = (uint32_t)lroundf(Exit_Speed * Scale);
+    Output->Acceleration = (uint32_t)lroundf(Planner->Acceleration * Scale);
+
+    if (Output->Nominal_Frequency_Hz == 0)
+    {
+        Output->Nominal_Frequency_Hz = 1;
+    }
+
+    if (Output->Acceleration == 0)
+    {
+        Output->Acceleration = 1;
+    }
+
+    Planner->Locked_Exit_Speed = Exit_Speed;
+    Planner->Head = Block_Index(Planner, 1);
+    Planner->Count--;
+
+    return true;
+}
+
+/**
+ * @brief True if no further block can be added.
+ */
+bool Lookahead_Is_Full(const Lookahead_Planner_t *Planner)
+{
+    return Planner->Count >= LOOKAHEAD_DEPTH;
+}
+
+/**
+ * @brief Number of blocks waiting in the planner.
+ */
+uint8_t Lookahead_Count(const Lookahead_Planner_t *Planner)
+{
+    return Planner->Count;
+}
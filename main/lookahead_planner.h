@@ -0,0 +1,74 @@
+/*H**********************************************************************
+ * FILENAME :        lookahead_planner.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent look-ahead velocity planner for streamed
+ *       multi-axis moves.
+ *
+ * NOTES :
+ *       Blocks wait in a small ring until the following blocks are known.
+ *       Junction speeds between blocks are limited with the junction
+ *       deviation rule, and a reverse and a forward pass make sure every
+ *       block can still reach the speed of its neighbours with the given
+ *       acceleration. The last queued block always ends at standstill, so
+ *       the plan is safe at any time.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef LOOKAHEAD_PLANNER_H
+#define LOOKAHEAD_PLANNER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dda_interpolator.h"
+
+#define LOOKAHEAD_DEPTH 16                        // Blocks held for look-ahead
+#define LOOKAHEAD_DEFAULT_JUNCTION_DEVIATION 4.0f // Allowed path deviation at a corner in steps
+
+/** One planned straight block */
+typedef struct
+{
+    int32_t Steps[DDA_MAX_AXES];     // Signed steps per axis
+    float Unit_Vector[DDA_MAX_AXES]; // Direction of travel
+    float Length;                    // Path length in steps
+    float Nominal_Speed;             // Requested path speed in steps/s
+    float Max_Entry_Speed;           // Junction limit with the previous block
+    float Entry_Speed;               // Planned path speed at the start
+} Lookahead_Block_t;
+
+/** Block handed to the execution, in step frequencies of its longest axis */
+typedef struct
+{
+    int32_t Steps[DDA_MAX_AXES];   // Signed steps per axis
+    uint32_t Major_Steps;          // Steps of the longest axis
+    uint32_t Nominal_Frequency_Hz; // Cruise frequency of the longest axis
+    uint32_t Entry_Frequency_Hz;   // Frequency of the longest axis at the start
+    uint32_t Exit_Frequency_Hz;    // Frequency of the longest axis at the end
+    uint32_t Acceleration;         // Acceleration of the longest axis in steps/s^2
+} Lookahead_Output_t;
+
+/** Planner state */
+typedef struct
+{
+    Lookahead_Block_t Blocks[LOOKAHEAD_DEPTH]; // Ring of planned blocks
+    uint8_t Head;                              // Oldest block
+    uint8_t Count;                             // Blocks in the ring
+    float Acceleration;                        // Path acceleration in steps/s^2
+    float Junction_Deviation;                  // Junction deviation in steps
+    float Previous_Unit_Vector[DDA_MAX_AXES];  // Direction of the last block added
+    float Previous_Nominal_Speed;              // Nominal speed of the last block added
+    float Locked_Exit_Speed;                   // Exit speed of the last block handed out, 0 if stopped
+} Lookahead_Planner_t;
+
+void Lookahead_Init(Lookahead_Planner_t *Planner, float Acceleration, float Junction_Deviation);
+bool Lookahead_Add_Block(Lookahead_Planner_t *Planner, const int32_t *Steps, float Nominal_Speed);
+bool Lookahead_Pop_Block(Lookahead_Planner_t *Planner, Lookahead_Output_t *Output);
+bool Lookahead_Is_Full(const Lookahead_Planner_t *Planner);
+uint8_t Lookahead_Count(const Lookahead_Planner_t *Planner);
+void Lookahead_Reset(Lookahead_Planner_t *Planner);
+
+#endif // LOOKAHEAD_PLANNER_H
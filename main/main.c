@@ -15,30 +15,888 @@
  *H*/
 
 #include "main.h"
+#ifndef STEPPER_HOST_SIM // The host simulator of host/sim only builds the motor control
 #include "console.h"
+#include "motion_queue.h"
+#include "gcode_stream.h"
+#include "binary_link.h"
+#include "homing.h"
+#include "motor_script.h"
+#include "trajectory_player.h"
+#endif
 
-esp_err_t Rotate_Stepper_Motor(uint PWM_frequency, uint8_t Motor_Direction, float Motor_run_time)
+static Motion_Profile_t Motion_Profile;                                   // Profile of the move currently being executed
+static stepper_t Motor_0 = NULL;                                          // Motor of this file, created by Initialize_Stepper_Motor()
+static int32_t Motor_Velocity_Hz = 0;                                     // Signed frequency of a continuous run or jog, positive forward, 0 otherwise
+static uint32_t Quick_Stop_Deceleration = MOTION_QUICK_STOP_DECELERATION; // Deceleration used by Quick_Stop_Stepper_Motor()
+static bool Position_Referenced = false;                                  // Position set by homing or by the user, cleared when steps go uncounted
+
+/**
+ * @brief Build the planner configuration for a move at the given frequency.
+ *
+ * @param PWM_frequency The cruise frequency of the move, capped at the frequency limit.
+ * @return Planner configuration with the limits of Set_Stepper_Motor_Limits() and the default jerk limit.
+ */
+static Motion_Planner_Config_t Get_Motion_Planner_Config(uint PWM_frequency)
+{
+    uint32_t Max_Frequency_Hz = 0;
+    uint32_t Acceleration = 0;
+
+    Get_Stepper_Motor_Limits(&Max_Frequency_Hz, &Acceleration);
+
+    Motion_Planner_Config_t Config = {
+        .Max_Frequency_Hz = (PWM_frequency > Max_Frequency_Hz) ? Max_Frequency_Hz : PWM_frequency, // Cruise frequency requested by the caller
+        .Acceleration = Acceleration,                                                              // Acceleration limit
+        .Jerk = MOTION_DEFAULT_JERK,                                                               // Default jerk limit
+        .Segment_Time_us = MOTION_SEGMENT_TIME_US,                                                 // One ramp segment per RTOS tick
+    };
+
+    return Config;
+}
+
+/**
+ * @brief Set the highest cruise frequency and the acceleration of the planned moves.
+ *
+ * Takes effect with the next planned move or continuous run, e.g. with the
+ * limits found by Motor_Encoder_Autotune(). A requested cruise frequency
+ * above the limit is lowered to it.
+ *
+ * @param Max_Frequency_Hz Highest cruise frequency, MOTION_JOG_MIN_FREQUENCY_HZ to MOTION_JOG_MAX_FREQUENCY_HZ.
+ * @param Acceleration Acceleration in steps/s^2, not 0.
+ * @return
+ *     - ESP_OK: Limits taken
+ *     - ESP_ERR_INVALID_ARG: Frequency outside the jog range or acceleration of 0
+ */
+esp_err_t Set_Stepper_Motor_Limits(uint32_t Max_Frequency_Hz, uint32_t Acceleration)
+{
+    if (Max_Frequency_Hz > MOTION_JOG_MAX_FREQUENCY_HZ)
+    {
+        return ESP_ERR_INVALID_ARG; // The motor takes up to STEPPER_MAX_FREQUENCY_HZ, the pulse engine less
+    }
+
+    return Stepper_Set_Limits(Motor_0, Max_Frequency_Hz, Acceleration);
+}
+
+/**
+ * @brief Limits of the planned moves, see Set_Stepper_Motor_Limits().
+ */
+void Get_Stepper_Motor_Limits(uint32_t *Max_Frequency_Hz, uint32_t *Acceleration)
+{
+    Stepper_Config_t Config;
+
+    Stepper_Get_Config(Motor_0, &Config);
+
+    *Max_Frequency_Hz = Config.Max_Frequency_Hz;
+    *Acceleration = Config.Acceleration;
+}
+
+/**
+ * @brief Set the direction pin, the steps counted so far keep their direction.
+ *
+ * Only called while the output is stopped.
+ *
+ * @param Motor_Direction The direction of the motor (0 for low, 1 for high).
+ * @return Result of gpio_set_level().
+ */
+static esp_err_t Set_Motor_Direction(uint8_t Motor_Direction)
+{
+    esp_err_t Function_Error = Stepper_Set_Direction(Motor_0, Motor_Direction == MOTOR_DIRECTION_FORWARD);
+    MOTION_TRACE(MOTION_TRACE_DIRECTION, Motor_Direction);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Timer setting of the step frequency applied last, with the achieved frequency and its error.
+ *
+ * @param Range Returns the setting, Requested_Hz is 0 before the first frequency.
+ * @param Resolution_Changes Returns the duty resolution switches since start-up.
+ * @return ESP_OK, ESP_ERR_NOT_SUPPORTED unless the LEDC engine drives the steps.
+ */
+esp_err_t Get_Stepper_Motor_Step_Clock(Ledc_Range_t *Range, uint32_t *Resolution_Changes)
+{
+    Stepper_Get_Step_Clock(Motor_0, Range, Resolution_Changes);
+
+    return (STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_LEDC) ? ESP_OK : ESP_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @brief Execute a planned profile on the selected pulse engine.
+ *
+ * The move is monitored by the encoder if there is one, see motor_encoder.h.
+ *
+ * @param Profile The profile to execute.
+ * @param PWM_Duty_Cycle The PWM duty cycle of the step pulses, LEDC engine only.
+ * @param Executed_Steps Returns the number of steps actually emitted, may be NULL.
+ * @param Holding Returns true if a continuous profile keeps running, may be NULL.
+ * @return ESP_OK if successful, ESP_ERR_INVALID_RESPONSE if the encoder found
+ *         a following error or a stall, or an error code if any operation fails.
+ */
+static esp_err_t Run_Motion_Profile(const Motion_Profile_t *Profile, uint PWM_Duty_Cycle, uint32_t *Executed_Steps, bool *Holding)
 {
     esp_err_t Function_Error = ESP_OK;
+    uint32_t Steps = 0;
+    bool Held = false;
 
-    gpio_set_level(STEPPER_MOTOR_DIR_PIN, (Motor_Direction == MOTOR_DIRECTION_FORWARD) ? SET_GPIO_LEVEL_HIGH : SET_GPIO_LEVEL_LOW);
+    Motor_Encoder_Begin_Move();
 
-    ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, PWM_DUTY_CYCLE_50, 0);
+#if STEPPER_PULSE_ENGINE != STEPPER_PULSE_ENGINE_LEDC
+    TickType_t Timeout = pdMS_TO_TICKS((Profile->Duration_us / 1000) + MOTION_TIMEOUT_MARGIN_MS); // Longest wait for the transmission
 
-    ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0, PWM_frequency); // Set the PWM frequency
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+    Function_Error = RMT_Pulse_Engine_Run(Profile, Timeout, Stepper_Abort_Flag(Motor_0), &Steps);
+#else
+    Function_Error = Timer_Pulse_Engine_Run(Profile, Timeout, Stepper_Abort_Flag(Motor_0), Stepper_Stop_Deceleration(Motor_0), &Steps);
+#endif
 
-    // Calculate the delay in ticks for a 1000 microsecond (1 millisecond) delay
-    TickType_t delay_ticks = ((Motor_run_time * 1000) * configTICK_RATE_HZ) / 1000000;
+    Held = Profile->Continuous && (Function_Error == ESP_OK) && !Stepper_Motor_Abort_Requested() && (Stepper_Motor_Stop_Requested() == 0);
+
+    Stepper_Add_Steps(Motor_0, Stepper_Get_Direction(Motor_0) * (int32_t)Steps);
+
+    if (Held)
+    {
+        Position_Referenced = false; // The held output is not counted
+    }
+#else
+    Function_Error = Stepper_Run_Profile(Motor_0, Profile, PWM_Duty_Cycle, &Steps, &Held);
+#endif
+
+    if (!Held && (Motor_Encoder_Check() != ESP_OK)) // A held run is checked once it is decelerated
+    {
+        Position_Referenced = false; // Steps lost, the position is not where it was counted
+
+        Function_Error = (Function_Error == ESP_OK) ? ESP_ERR_INVALID_RESPONSE : Function_Error;
+    }
+
+    MOTION_TRACE(MOTION_TRACE_MOVE_STOP, Steps);
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Steps;
+    }
+
+    if (Holding != NULL)
+    {
+        *Holding = Held;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Move the stepper motor by a fixed number of steps and keep the driver enabled.
+ *
+ * The move is planned with accel, cruise and decel phases. The driver stays
+ * enabled afterwards so consecutive moves can be chained without gaps.
+ *
+ * @param PWM_frequency The cruise frequency of the move.
+ * @param Motor_Direction The direction of the motor (0 for low, 1 for high).
+ * @param Steps The number of steps to move.
+ * @param Executed_Steps Returns the number of steps actually emitted, may be NULL.
+ * @return ESP_OK if successful, or an error code if any operation fails.
+ */
+esp_err_t Move_Stepper_Motor(uint PWM_frequency, uint8_t Motor_Direction, uint32_t Steps, uint32_t *Executed_Steps)
+{
+    MOTION_TRACE(MOTION_TRACE_MOVE_START, Steps);
+
+    Motion_Planner_Config_t Config = Get_Motion_Planner_Config(Motor_Resonance_Snap(PWM_frequency)); // Cruise outside the resonance bands
+
+    if (!Motion_Planner_Plan_Move(&Config, Steps, &Motion_Profile))
+    {
+        return ESP_ERR_INVALID_ARG; // Frequency of 0 or invalid limits
+    }
+
+    Motor_Resonance_Apply(&Motion_Profile); // Cross the bands on the ramps
+
+    Set_Motor_Direction(Motor_Direction);
+
+    gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_LOW); // Enable the Motor driver
+    MOTION_TRACE(MOTION_TRACE_ENABLE, 0);
+
+    return Run_Motion_Profile(&Motion_Profile, PWM_DUTY_CYCLE_50, Executed_Steps, NULL); // Accelerate, cruise and decelerate
+}
+
+/**
+ * @brief Rotate the stepper motor by a fixed number of steps.
+ *
+ * Same as Move_Stepper_Motor(), but the motor driver is disabled again once
+ * the profile has been executed.
+ *
+ * @param PWM_frequency The cruise frequency of the move.
+ * @param Motor_Direction The direction of the motor (0 for low, 1 for high).
+ * @param Steps The number of steps to move.
+ * @param Executed_Steps Returns the number of steps actually emitted, may be NULL.
+ * @return ESP_OK if successful, or an error code if any operation fails.
+ */
+esp_err_t Rotate_Stepper_Motor(uint PWM_frequency, uint8_t Motor_Direction, uint32_t Steps, uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    Function_Error = Move_Stepper_Motor(PWM_frequency, Motor_Direction, Steps, Executed_Steps);
 
-    gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_LOW);  // Enable the Motor driver
-    vTaskDelay(delay_ticks);                                   // Delay for the calculated number of ticks
     gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_HIGH); // Disable the Motor driver
+    MOTION_TRACE(MOTION_TRACE_DISABLE, 0);
 
     Stop_Stepper_Motor();
 
     return Function_Error;
 }
 
+/**
+ * @brief Steps axis X made along the first ticks of a multi-axis path.
+ *
+ * A finished path gives its end point, an interrupted one is replayed on a
+ * copy of the interpolator up to the tick it was stopped at.
+ *
+ * @param Path Path in the state it was started with.
+ * @param Ticks Interpolator ticks emitted.
+ * @param Finished True if the path was completed.
+ * @return Signed steps of axis X, positive forward.
+ */
+static int32_t Get_Axis_X_Steps(const Multi_Axis_Path_t *Path, uint32_t Ticks, bool Finished)
+{
+    if (Finished)
+    {
+        if (Path->Arc)
+        {
+            return Path->Circle.End_X - Path->Circle.X;
+        }
+
+        return (Path->Line.Direction_Mask & 0x01) ? -(int32_t)Path->Line.Abs_Delta[0] : (int32_t)Path->Line.Abs_Delta[0];
+    }
+
+    Multi_Axis_Path_t Replay = *Path;
+    int32_t Steps = 0;
+
+    for (uint32_t Tick = 0; Tick < Ticks; Tick++)
+    {
+        uint8_t Direction_Mask = 0;
+        uint8_t Step_Mask = Replay.Arc ? DDA_Arc_Step(&Replay.Circle, &Direction_Mask) : DDA_Line_Step(&Replay.Line, &Direction_Mask);
+
+        if (Step_Mask & 0x01)
+        {
+            Steps += (Direction_Mask & 0x01) ? -1 : 1;
+        }
+    }
+
+    return Steps;
+}
+
+/**
+ * @brief Execute a multi-axis path along the profile planned in Motion_Profile.
+ */
+static esp_err_t Run_Multi_Axis_Path(const Multi_Axis_Path_t *Path, uint32_t *Executed_Ticks)
+{
+    if (Motion_Profile.Peak_Frequency_Hz > MULTI_AXIS_MAX_FREQUENCY_HZ)
+    {
+        return ESP_ERR_INVALID_ARG; // Above the step timer limit
+    }
+
+    TickType_t Timeout = pdMS_TO_TICKS((Motion_Profile.Duration_us / 1000) + MOTION_TIMEOUT_MARGIN_MS); // Longest wait for the move
+
+    gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_LOW); // Enable the Motor drivers, shared by all axes
+    MOTION_TRACE(MOTION_TRACE_ENABLE, 0);
+
+    uint32_t Ticks = 0;
+    esp_err_t Function_Error = Multi_Axis_Run(&Motion_Profile, Path, Timeout, Stepper_Abort_Flag(Motor_0), &Ticks);
+
+    MOTION_TRACE(MOTION_TRACE_MOVE_STOP, Ticks);
+
+    Stepper_Add_Steps(Motor_0, Get_Axis_X_Steps(Path, Ticks, Ticks >= Motion_Profile.Total_Steps)); // Axis X is the single axis motor
+
+    if (Executed_Ticks != NULL)
+    {
+        *Executed_Ticks = Ticks;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Plan a multi-axis path from and to standstill and execute it.
+ */
+static esp_err_t Plan_And_Run_Multi_Axis_Path(uint PWM_frequency, const Multi_Axis_Path_t *Path, uint32_t Ticks, uint32_t *Executed_Ticks)
+{
+    Motion_Planner_Config_t Config = Get_Motion_Planner_Config(PWM_frequency);
+
+    MOTION_TRACE(MOTION_TRACE_MOVE_START, Ticks);
+
+    if (Executed_Ticks != NULL)
+    {
+        *Executed_Ticks = 0;
+    }
+
+    if (!Motion_Planner_Plan_Move(&Config, Ticks, &Motion_Profile))
+    {
+        return ESP_ERR_INVALID_ARG; // Frequency of 0 or invalid limits
+    }
+
+    return Run_Multi_Axis_Path(Path, Executed_Ticks);
+}
+
+/**
+ * @brief Move up to MULTI_AXIS_COUNT axes along a straight line.
+ *
+ * All axes start and arrive together. The frequency is the step rate of
+ * the axis with the most steps, the other axes step proportionally slower.
+ *
+ * @param PWM_frequency The cruise step frequency of the longest axis.
+ * @param Axis_Steps Signed steps of axes X, Y, Z and A, DDA_MAX_AXES entries.
+ * @param Executed_Ticks Returns the number of interpolator ticks emitted, may be NULL.
+ * @return ESP_OK if successful, ESP_ERR_INVALID_ARG if an axis that is not
+ *         driven has to move, or an error code if any operation fails.
+ */
+esp_err_t Move_Stepper_Axes_Linear(uint PWM_frequency, const int32_t *Axis_Steps, uint32_t *Executed_Ticks)
+{
+    Multi_Axis_Path_t Path = {
+        .Arc = false, // Straight line
+    };
+
+    for (uint8_t Axis = MULTI_AXIS_COUNT; Axis < DDA_MAX_AXES; Axis++)
+    {
+        if (Axis_Steps[Axis] != 0)
+        {
+            return ESP_ERR_INVALID_ARG; // Axis not driven in this build
+        }
+    }
+
+    DDA_Line_Begin(&Path.Line, Axis_Steps, MULTI_AXIS_COUNT);
+
+    return Plan_And_Run_Multi_Axis_Path(PWM_frequency, &Path, Path.Line.Major_Steps, Executed_Ticks);
+}
+
+/**
+ * @brief Move axes X and Y along a circular arc.
+ *
+ * End and center are given in steps relative to the current position, like
+ * the X, Y and I, J words of a G2/G3 block. An end point equal to the start
+ * point moves a full circle.
+ *
+ * @param PWM_frequency The cruise tick frequency along the arc.
+ * @param End_X End point relative to the current position.
+ * @param End_Y End point relative to the current position.
+ * @param Center_X Center relative to the current position.
+ * @param Center_Y Center relative to the current position.
+ * @param Clockwise Direction of travel.
+ * @param Executed_Ticks Returns the number of interpolator ticks emitted, may be NULL.
+ * @return ESP_OK if successful, ESP_ERR_INVALID_ARG if the end point is not
+ *         on the circle, or an error code if any operation fails.
+ */
+esp_err_t Move_Stepper_Axes_Arc(uint PWM_frequency, int32_t End_X, int32_t End_Y, int32_t Center_X, int32_t Center_Y, bool Clockwise, uint32_t *Executed_Ticks)
+{
+    Multi_Axis_Path_t Path = {
+        .Arc = true, // Circular arc
+    };
+
+    if (!DDA_Arc_Begin(&Path.Circle, -Center_X, -Center_Y, End_X - Center_X, End_Y - Center_Y, Clockwise))
+    {
+        return ESP_ERR_INVALID_ARG; // Radius of 0 or end point off the circle
+    }
+
+    uint32_t Ticks = DDA_Arc_Count_Ticks(-Center_X, -Center_Y, End_X - Center_X, End_Y - Center_Y, Clockwise);
+
+    return Plan_And_Run_Multi_Axis_Path(PWM_frequency, &Path, Ticks, Executed_Ticks);
+}
+
+/**
+ * @brief Move up to MULTI_AXIS_COUNT axes along one block of a continuous path.
+ *
+ * Like Move_Stepper_Axes_Linear(), but the block starts and ends at the
+ * given frequencies so consecutive blocks join without stopping. All
+ * frequencies and the acceleration refer to the axis with the most steps.
+ *
+ * @param Axis_Steps Signed steps of axes X, Y, Z and A, DDA_MAX_AXES entries.
+ * @param Nominal_Frequency The cruise step frequency of the longest axis.
+ * @param Entry_Frequency The step frequency of the longest axis at the start.
+ * @param Exit_Frequency The step frequency of the longest axis at the end.
+ * @param Acceleration The acceleration of the longest axis in steps/s^2.
+ * @param Executed_Ticks Returns the number of interpolator ticks emitted, may be NULL.
+ * @return ESP_OK if successful, ESP_ERR_INVALID_ARG for invalid limits or
+ *         an axis that is not driven, or an error code if any operation fails.
+ */
+esp_err_t Move_Stepper_Axes_Block(const int32_t *Axis_Steps, uint Nominal_Frequency, uint Entry_Frequency, uint Exit_Frequency, uint Acceleration, uint32_t *Executed_Ticks)
+{
+    Multi_Axis_Path_t Path = {
+        .Arc = false, // Straight line
+    };
+
+    Motion_Planner_Config_t Config = {
+        .Max_Frequency_Hz = Nominal_Frequency,     // Cruise frequency of the block
+        .Acceleration = Acceleration,              // Acceleration of the longest axis
+        .Jerk = 0,                                 // Blocks use trapezoidal ramps
+        .Segment_Time_us = MOTION_SEGMENT_TIME_US, // One ramp segment per RTOS tick
+    };
+
+    if (Executed_Ticks != NULL)
+    {
+        *Executed_Ticks = 0;
+    }
+
+    for (uint8_t Axis = MULTI_AXIS_COUNT; Axis < DDA_MAX_AXES; Axis++)
+    {
+        if (Axis_Steps[Axis] != 0)
+        {
+            return ESP_ERR_INVALID_ARG; // Axis not driven in this build
+        }
+    }
+
+    DDA_Line_Begin(&Path.Line, Axis_Steps, MULTI_AXIS_COUNT);
+
+    MOTION_TRACE(MOTION_TRACE_MOVE_START, Path.Line.Major_Steps);
+
+    if (!Motion_Planner_Plan_Block(&Config, Path.Line.Major_Steps, Entry_Frequency, Exit_Frequency, &Motion_Profile))
+    {
+        return ESP_ERR_INVALID_ARG; // Frequency of 0 or invalid limits
+    }
+
+    return Run_Multi_Axis_Path(&Path, Executed_Ticks);
+}
+
+/**
+ * @brief Abort the profile that is currently being executed.
+ *
+ * Safe to call from any task. The step output is stopped and the task
+ * executing the profile returns with the steps emitted so far. The request
+ * stays set until Clear_Stepper_Motor_Abort() is called, so a move that is
+ * about to start is aborted as well.
+ *
+ * @return ESP_OK
+ */
+esp_err_t Abort_Stepper_Motor(void)
+{
+    Stepper_Request_Abort(Motor_0); // Stops the LEDC pulses, the counter keeps the exact count
+
+    MOTION_TRACE(MOTION_TRACE_ABORT, 0);
+
+    Motor_Velocity_Hz = 0; // Output stopped, a continuous run has nothing left to ramp down
+
+    Multi_Axis_Abort(); // Ends a multi-axis move, no effect otherwise
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+    RMT_Pulse_Engine_Abort();
+#elif STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    Timer_Pulse_Engine_Abort();
+#endif
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Clear an abort request so the next move can run.
+ */
+void Clear_Stepper_Motor_Abort(void)
+{
+    Stepper_Clear_Abort(Motor_0);
+}
+
+/**
+ * @brief Check whether Abort_Stepper_Motor() was called since the last clear.
+ */
+bool Stepper_Motor_Abort_Requested(void)
+{
+    return *Stepper_Abort_Flag(Motor_0);
+}
+
+/**
+ * @brief Request the running motion to stop along a decel ramp.
+ *
+ * Safe to call from any task and from interrupts, e.g. an e-stop input. A
+ * counted LEDC move switches to a decel ramp from its current frequency
+ * and still stops exact to the step, a move or a trajectory of the timer
+ * pulse engine switches to a decel ramp from its current period; a
+ * continuous run or jog is ramped down by Decelerate_Stepper_Motor() in
+ * the task that runs it. RMT and multi-axis moves end like on an abort,
+ * after the steps already handed to the hardware. The request stays set until Clear_Stepper_Motor_Stop(); a
+ * second request can only make the deceleration steeper.
+ *
+ * @param Deceleration Deceleration in steps/s^2, 0 is ignored.
+ */
+void Request_Stepper_Motor_Stop(uint32_t Deceleration)
+{
+    if (!Stepper_Request_Stop(Motor_0, Deceleration)) // Wakes up the task following a counted LEDC move
+    {
+        return; // A steeper or equal stop is already on its way
+    }
+
+    MOTION_TRACE(MOTION_TRACE_STOP, Deceleration);
+
+    Multi_Axis_Abort(); // Ends a multi-axis move, no effect otherwise
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+    RMT_Pulse_Engine_Abort();
+#elif STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    Timer_Pulse_Engine_Request_Stop(); // Decelerates from the current period
+#endif
+}
+
+/**
+ * @brief Request a stop at the quick-stop deceleration, safe from interrupts.
+ */
+void Quick_Stop_Stepper_Motor(void)
+{
+    Request_Stepper_Motor_Stop(__atomic_load_n(&Quick_Stop_Deceleration, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Set the deceleration used by Quick_Stop_Stepper_Motor().
+ *
+ * @param Deceleration Deceleration in steps/s^2.
+ * @return
+ *     - ESP_OK: Deceleration set
+ *     - ESP_ERR_INVALID_ARG: Deceleration of 0
+ */
+esp_err_t Set_Stepper_Motor_Quick_Stop_Deceleration(uint32_t Deceleration)
+{
+    if (Deceleration == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    __atomic_store_n(&Quick_Stop_Deceleration, Deceleration, __ATOMIC_RELAXED);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Deceleration used by Quick_Stop_Stepper_Motor() in steps/s^2.
+ */
+uint32_t Get_Stepper_Motor_Quick_Stop_Deceleration(void)
+{
+    return __atomic_load_n(&Quick_Stop_Deceleration, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Deceleration of the pending stop request.
+ *
+ * @return Deceleration in steps/s^2, 0 if no stop was requested since the last clear.
+ */
+uint32_t Stepper_Motor_Stop_Requested(void)
+{
+    return Stepper_Stop_Requested(Motor_0);
+}
+
+/**
+ * @brief Clear a stop request once the motor stands still.
+ */
+void Clear_Stepper_Motor_Stop(void)
+{
+    Stepper_Clear_Stop(Motor_0);
+}
+
+/**
+ * @brief Absolute position of the single axis motor, which is also axis X.
+ *
+ * Safe to call from any task and from interrupts. With the LEDC engine the
+ * steps of a running move are included as the pulse counter sees them.
+ * With the RMT engine and for multi-axis moves the position changes when
+ * the move ends.
+ *
+ * @return Position in steps, positive forward.
+ */
+int32_t Get_Stepper_Motor_Position(void)
+{
+    return Stepper_Get_Position(Motor_0);
+}
+
+/**
+ * @brief Steps emitted by the single axis motor since boot, both directions.
+ *
+ * Counted like the position, so with the RMT and timer engines the steps
+ * of a move are added when it ends. Setting the position does not change
+ * the count. The count wraps at 2^32.
+ *
+ * @return Emitted steps.
+ */
+uint32_t Get_Stepper_Motor_Emitted_Steps(void)
+{
+    return Stepper_Get_Emitted_Steps(Motor_0);
+}
+
+/**
+ * @brief Give the current position a new value and mark it referenced.
+ *
+ * Used by homing. Also allowed while the motor moves, the steps still to
+ * come are added to the new value.
+ *
+ * @param Position New position in steps.
+ */
+void Set_Stepper_Motor_Position(int32_t Position)
+{
+    Stepper_Set_Position(Motor_0, Position);
+
+    Position_Referenced = true;
+}
+
+/**
+ * @brief Check whether the position was set since boot and no step went uncounted since.
+ */
+bool Stepper_Motor_Position_Referenced(void)
+{
+    return Position_Referenced;
+}
+
+/**
+ * @brief Move the stepper motor to an absolute position.
+ *
+ * Like Move_Stepper_Motor(), the direction and number of steps follow from
+ * the current position. The driver stays enabled.
+ *
+ * @param PWM_frequency The cruise frequency of the move.
+ * @param Position Target position in steps.
+ * @param Executed_Steps Returns the number of steps actually emitted, may be NULL.
+ * @return ESP_OK if successful, or an error code if any operation fails.
+ */
+esp_err_t Move_Stepper_Motor_To(uint PWM_frequency, int32_t Position, uint32_t *Executed_Steps)
+{
+    int64_t Distance = (int64_t)Position - Get_Stepper_Motor_Position();
+
+    if (Distance == 0)
+    {
+        if (Executed_Steps != NULL)
+        {
+            *Executed_Steps = 0;
+        }
+
+        return ESP_OK; // Already there
+    }
+
+    uint8_t Motor_Direction = (Distance > 0) ? MOTOR_DIRECTION_FORWARD : MOTOR_DIRECTION_BACKWARD;
+
+    return Move_Stepper_Motor(PWM_frequency, Motor_Direction, (uint32_t)((Distance > 0) ? Distance : -Distance), Executed_Steps);
+}
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+/** Records of a trajectory streamed to the timer pulse engine, one direction at a time */
+typedef struct
+{
+    const Trajectory_View_t *View; // Trajectory being played
+    uint32_t Index;                // Next record to stream
+    bool Forward;                  // Direction of the records streamed now
+} Trajectory_Source_t;
+
+/**
+ * @brief Segment source of Timer_Pulse_Engine_Stream(), reads the records in place.
+ *
+ * Ends at a pause or at a record in the other direction, the caller
+ * continues from there.
+ */
+static bool Next_Trajectory_Segment(void *Context, uint64_t *Period_Q16, uint32_t *Steps)
+{
+    Trajectory_Source_t *Source = Context;
+    Trajectory_Segment_t Segment;
+
+    if (Source->Index >= Source->View->Header->Record_Count)
+    {
+        return false;
+    }
+
+    Trajectory_Decode(Source->View, Source->Index, &Segment);
+
+    if (Segment.Pause || (Segment.Forward != Source->Forward))
+    {
+        return false;
+    }
+
+    Source->Index++;
+
+    *Period_Q16 = Segment.Period_Q16;
+    *Steps = Segment.Steps;
+
+    return true;
+}
+#endif
+
+/**
+ * @brief Play a precompiled trajectory, see trajectory_format.h.
+ *
+ * The records are streamed from where the view points, e.g. memory mapped
+ * flash, into the timer pulse engine without a copy. The steps of every
+ * run between pauses and direction changes go out back to back, a pause
+ * holds the motor. A stop decelerates the motor from its current period
+ * to standstill and ends the play, an abort ends the output at the next
+ * step. The driver stays enabled.
+ *
+ * @param View Trajectory checked by Trajectory_Open(), in ticks of TIMER_PULSE_ENGINE_TICK_HZ.
+ * @param Executed_Steps Returns the number of steps actually emitted, may be NULL.
+ * @return
+ *     - ESP_OK: The trajectory was played to its end
+ *     - ESP_ERR_NOT_SUPPORTED: Not built with the timer pulse engine
+ *     - ESP_ERR_INVALID_ARG: The periods are given for another tick rate
+ *     - ESP_ERR_INVALID_STATE: Stopped or aborted from outside
+ *     - Other: Result of the pulse engine, e.g. ESP_FAIL on an underrun
+ */
+esp_err_t Run_Stepper_Motor_Trajectory(const Trajectory_View_t *View, uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+    uint32_t Total_Steps = 0;
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    Trajectory_Source_t Source = {.View = View, .Index = 0, .Forward = true};
+    TickType_t Timeout = pdMS_TO_TICKS(View->Header->Duration_ms + MOTION_TIMEOUT_MARGIN_MS); // Longest wait for one run, the whole trajectory
+
+    if (View->Header->Tick_Hz != TIMER_PULSE_ENGINE_TICK_HZ)
+    {
+        Function_Error = ESP_ERR_INVALID_ARG;
+    }
+    else
+    {
+        MOTION_TRACE(MOTION_TRACE_MOVE_START, View->Header->Total_Steps);
+
+        gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_LOW); // Enable the Motor driver
+        MOTION_TRACE(MOTION_TRACE_ENABLE, 0);
+    }
+
+    while ((Function_Error == ESP_OK) && (Source.Index < View->Header->Record_Count))
+    {
+        Trajectory_Segment_t Segment;
+        uint32_t Steps = 0;
+
+        Trajectory_Decode(View, Source.Index, &Segment);
+
+        if (Segment.Pause)
+        {
+            vTaskDelay(pdMS_TO_TICKS((Segment.Pause_us + 999) / 1000)); // Rounded up to the next ms
+            Source.Index++;
+        }
+        else
+        {
+            Source.Forward = Segment.Forward;
+
+            Function_Error += Set_Motor_Direction(Segment.Forward ? MOTOR_DIRECTION_FORWARD : MOTOR_DIRECTION_BACKWARD);
+            Function_Error += Timer_Pulse_Engine_Stream(Next_Trajectory_Segment, &Source, Timeout, Stepper_Abort_Flag(Motor_0), Stepper_Stop_Deceleration(Motor_0), &Steps);
+
+            Stepper_Add_Steps(Motor_0, Stepper_Get_Direction(Motor_0) * (int32_t)Steps);
+
+            Total_Steps += Steps;
+        }
+
+        if ((Function_Error == ESP_OK) && ((Stepper_Motor_Stop_Requested() != 0) || Stepper_Motor_Abort_Requested()))
+        {
+            Function_Error = ESP_ERR_INVALID_STATE;
+        }
+    }
+
+    MOTION_TRACE(MOTION_TRACE_MOVE_STOP, Total_Steps);
+#else
+    Function_Error = ESP_ERR_NOT_SUPPORTED; // The other engines cannot take a segment stream
+#endif
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Total_Steps;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Signed frequency the motor runs at continuously, positive forward.
+ *
+ * @return The frequency set by Start_Stepper_Motor() or
+ *         Set_Stepper_Motor_Velocity(), 0 while stopped or during a move.
+ */
+int32_t Get_Stepper_Motor_Velocity(void)
+{
+    return Motor_Velocity_Hz;
+}
+
+/**
+ * @brief Change the continuous step frequency and direction right away.
+ *
+ * No ramp is applied, the caller limits the change per call, see
+ * velocity_ramp.h. From standstill the driver is enabled, the direction
+ * set and the output started. A sign change stops the output before the
+ * direction pin is switched. A velocity of 0 stops the output and keeps the
+ * driver enabled. With the LEDC engine the steps are counted from the first
+ * start on, Decelerate_Stepper_Motor() returns the count.
+ *
+ * @param Velocity_Hz Signed step frequency, positive forward.
+ * @param PWM_Duty_Cycle The PWM duty cycle of the step pulses, LEDC engine only.
+ * @return ESP_OK if successful, or an error code if any operation fails, the output is stopped then.
+ */
+esp_err_t Set_Stepper_Motor_Velocity(int32_t Velocity_Hz, uint PWM_Duty_Cycle)
+{
+    esp_err_t Function_Error = ESP_OK;
+    uint32_t Frequency_Hz = Motor_Resonance_Snap((Velocity_Hz < 0) ? (uint32_t)(-(int64_t)Velocity_Hz) : (uint32_t)Velocity_Hz); // Jumps across the resonance bands
+    uint8_t Motor_Direction = (Velocity_Hz < 0) ? MOTOR_DIRECTION_BACKWARD : MOTOR_DIRECTION_FORWARD;
+
+    Velocity_Hz = (Velocity_Hz < 0) ? -(int32_t)Frequency_Hz : (int32_t)Frequency_Hz;
+
+    bool Start_Output = (Motor_Velocity_Hz == 0) || ((Motor_Velocity_Hz < 0) != (Velocity_Hz < 0));
+
+    if (Velocity_Hz == Motor_Velocity_Hz)
+    {
+        return ESP_OK;
+    }
+
+    if ((Velocity_Hz == 0) || (Start_Output && (Motor_Velocity_Hz != 0)))
+    {
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+        Function_Error += RMT_Pulse_Engine_Stop();
+#elif STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+        Function_Error += Timer_Pulse_Engine_Stop();
+#else
+        Function_Error += Stepper_Pause_Output(Motor_0); // Output stays low, the count goes on
+#endif
+        Motor_Velocity_Hz = 0;
+
+        MOTION_TRACE(MOTION_TRACE_FREQUENCY, 0);
+    }
+
+    if ((Velocity_Hz == 0) || (Function_Error != ESP_OK))
+    {
+        return Function_Error;
+    }
+
+    if (Start_Output)
+    {
+        Function_Error += gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_LOW); // Enable the Motor driver
+        MOTION_TRACE(MOTION_TRACE_ENABLE, 0);
+
+        Function_Error += Set_Motor_Direction(Motor_Direction);
+    }
+
+#if STEPPER_PULSE_ENGINE != STEPPER_PULSE_ENGINE_LEDC
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+    Function_Error += RMT_Pulse_Engine_Hold(Frequency_Hz);
+#else
+    Function_Error += Timer_Pulse_Engine_Hold(Frequency_Hz);
+#endif
+
+    Position_Referenced = false; // The held output is not counted
+#else
+    uint32_t Duty = Start_Output ? Stepper_Prepare_Duty(Motor_0, MOTION_JOG_MAX_FREQUENCY_HZ, PWM_Duty_Cycle) : 0; // Fits every later velocity
+
+    Function_Error += Stepper_Set_Frequency(Motor_0, Frequency_Hz);
+
+    if (Start_Output && (Function_Error == ESP_OK))
+    {
+        if (!Stepper_Holding(Motor_0))
+        {
+            Motor_Encoder_Begin_Move(); // Checked once decelerated
+        }
+
+        Function_Error += Stepper_Start_Output(Motor_0, Duty); // Counts the steps until Decelerate_Stepper_Motor()
+        MOTION_TRACE(MOTION_TRACE_PULSE_START, Frequency_Hz);
+    }
+#endif
+
+    MOTION_TRACE(MOTION_TRACE_FREQUENCY, Frequency_Hz);
+
+    if (Function_Error != ESP_OK)
+    {
+        printf("Error setting frequency: %" PRIu32 "HZ\n", Frequency_Hz);
+
+        Stop_Stepper_Motor();
+
+        return Function_Error;
+    }
+
+    Motor_Velocity_Hz = Velocity_Hz;
+
+    return ESP_OK;
+}
+
 /**
  * @brief Stop the stepper motor
  *
@@ -54,7 +912,83 @@ esp_err_t Stop_Stepper_Motor(void)
 
     Function_Error += gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_HIGH);
     Function_Error += gpio_set_level(STEPPER_MOTOR_DIR_PIN, SET_GPIO_LEVEL_HIGH);
-    Function_Error += ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, PWM_DUTY_CYCLE_00, 0);
+    MOTION_TRACE(MOTION_TRACE_DISABLE, 0);
+
+    Motor_Velocity_Hz = 0;
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+    Function_Error += RMT_Pulse_Engine_Stop();
+#elif STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    Function_Error += Timer_Pulse_Engine_Stop();
+#else
+    Function_Error += Stepper_Pause_Output(Motor_0);
+
+    Stepper_End_Hold(Motor_0, NULL); // Hard stop, the count of the run is dropped, the position keeps it
+#endif
+
+    return Function_Error;
+}
+
+/**
+ * @brief Ramp a continuous run or jog down to standstill.
+ *
+ * The velocity is lowered every RTOS tick under the deceleration of the
+ * pending stop request, or the acceleration limit if there is none, and
+ * the output stopped below the start/stop frequency. The driver stays
+ * enabled. Does nothing to the output if the motor already stands still.
+ *
+ * @param Executed_Steps Returns the steps emitted since the continuous output
+ *                       was started, counted by the PCNT unit, 0 with the
+ *                       RMT engine. May be NULL.
+ * @return ESP_OK if successful, or an error code if any operation fails.
+ */
+esp_err_t Decelerate_Stepper_Motor(uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+    uint32_t Deceleration = Stepper_Motor_Stop_Requested();
+    Velocity_Ramp_t Ramp;
+    TickType_t Last_Update = xTaskGetTickCount();
+    uint32_t Steps = 0;
+    uint32_t Max_Frequency_Hz = 0;
+    uint32_t Acceleration = 0;
+
+    Get_Stepper_Motor_Limits(&Max_Frequency_Hz, &Acceleration);
+
+    Velocity_Ramp_Begin(&Ramp, Motor_Velocity_Hz, (Deceleration != 0) ? Deceleration : Acceleration, MOTION_JOG_MIN_FREQUENCY_HZ);
+
+    while ((Motor_Velocity_Hz != 0) && (Function_Error == ESP_OK))
+    {
+        vTaskDelay(1); // One update per RTOS tick
+
+        TickType_t Now = xTaskGetTickCount();
+
+        if (Stepper_Motor_Stop_Requested() > Ramp.Acceleration)
+        {
+            Ramp.Acceleration = Stepper_Motor_Stop_Requested(); // Steeper stop requested meanwhile
+        }
+
+        Function_Error = Set_Stepper_Motor_Velocity(Velocity_Ramp_Update(&Ramp, 0, (uint32_t)(Now - Last_Update) * MOTION_SEGMENT_TIME_US), PWM_DUTY_CYCLE_50);
+
+        Last_Update = Now;
+    }
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_LEDC
+    if (Stepper_End_Hold(Motor_0, &Steps)) // Output stands still, exact count of the run
+    {
+        if (Motor_Encoder_Check() != ESP_OK)
+        {
+            Position_Referenced = false; // Steps lost, the position is not where it was counted
+
+            Function_Error = (Function_Error == ESP_OK) ? ESP_ERR_INVALID_RESPONSE : Function_Error;
+        }
+
+        MOTION_TRACE(MOTION_TRACE_MOVE_STOP, Steps);
+    }
+#endif
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Steps;
+    }
 
     return Function_Error;
 }
@@ -63,7 +997,10 @@ esp_err_t Stop_Stepper_Motor(void)
  * @brief Start the stepper motor with specified parameters.
  *
  * This function enables the motor driver, sets the motor direction,
- * configures the PWM frequency, and sets the PWM duty cycle.
+ * sets the PWM duty cycle and ramps the PWM frequency up to the target
+ * along the planned acceleration profile. The ramp is taken from the ramp
+ * cache if it was planned before. The steps of the run are counted until
+ * Decelerate_Stepper_Motor() brings it to standstill.
  *
  * @param Motor_Direction The direction of the motor (0 for low, 1 for high).
  * @param PWM_frequency The PWM frequency for motor control.
@@ -74,182 +1011,163 @@ esp_err_t Start_Stepper_Motor(uint8_t Motor_Direction, uint PWM_frequency, uint
 {
     esp_err_t Function_Error = ESP_OK;
 
+    MOTION_TRACE(MOTION_TRACE_MOVE_START, 0);
+
     // Enable the Motor driver
     Function_Error += gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_LOW);
+    MOTION_TRACE(MOTION_TRACE_ENABLE, 0);
 
-    Function_Error += gpio_set_level(STEPPER_MOTOR_DIR_PIN, (Motor_Direction == MOTOR_DIRECTION_FORWARD) ? SET_GPIO_LEVEL_HIGH : SET_GPIO_LEVEL_LOW);
+    Function_Error += Set_Motor_Direction(Motor_Direction);
 
-    // Set PWM duty cycle for motor
-    Function_Error += ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, PWM_Duty_Cycle, 0);
+    PWM_frequency = Motor_Resonance_Snap(PWM_frequency); // Hold a frequency outside the resonance bands
 
-    // Loop to gradually increase frequency from PWM_START_FREQ to target_frequency
-    for (uint32_t freq = PWM_START_FREQ; freq <= PWM_frequency; freq += PWM_INCREMENT)
+    Motion_Planner_Config_t Config = Get_Motion_Planner_Config(PWM_frequency);
+
+    if (!Ramp_Cache_Plan_Ramp(&Config, STEPPER_MOTOR_MICROSTEPS, &Motion_Profile))
     {
-        Function_Error = ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0, freq); // Set the PWM frequency
+        return ESP_ERR_INVALID_ARG; // Frequency of 0 or invalid limits
+    }
 
-        if (Function_Error != ESP_OK) // Check for errors while setting the frequency
-        {
-            printf("Error setting frequency: %dHZ\n", freq);
+    Motor_Resonance_Apply(&Motion_Profile); // The cache keeps the ramp without the bands
 
-            break; // Exit the loop if an error occurs
-        }
+    // Ramp up to the target frequency and keep running there
+    bool Holding = false; // Not held if a stop request ended the ramp
 
-        vTaskDelay(pdMS_TO_TICKS(PWM_DELAY_MS)); // Delay to allow the motor to adapt to the new frequency
+    Function_Error += Run_Motion_Profile(&Motion_Profile, PWM_Duty_Cycle, NULL, &Holding);
+
+    if (Holding)
+    {
+        Motor_Velocity_Hz = (Motor_Direction == MOTOR_DIRECTION_FORWARD) ? (int32_t)PWM_frequency : -(int32_t)PWM_frequency;
+    }
+
+    // The held frequency needs no segment changes, flash writes cannot delay one now
+    if (Ramp_Cache_Persist_Hot() != ESP_OK)
+    {
+        printf("Ramp cache: NVS write failed\n");
     }
 
     return Function_Error;
 }
 
 /**
- * @brief Initialize GPIO for Stepper Motor Driver
+ * @brief Initialize the motor of this file as motor 0 of stepper.h.
  *
- * This function configures the GPIO pins for the stepper motor driver.
- * It sets the pins to output mode, disables interrupts, and ensures that
- * pull-up and pull-down modes are disabled.
+ * Sets up the enable and direction pins and takes the LEDC timer and
+ * channel and the PCNT unit of the motor, which the LEDC pulse engine
+ * drives and counts the steps with. The other pulse engines set up the
+ * pulse pin themselves. Must be called first, before the pulse engine,
+ * Initialize_Motor_Encoder() and the station motors.
  *
  * @return
- *     - ESP_OK: Successfully configured the GPIO pins
- *     - ESP_ERR_INVALID_ARG: Parameter error
- *     - ESP_ERR_INVALID_STATE: GPIO driver is not initialized
- *     - ESP_FAIL: Other failures
+ *     - ESP_OK: Motor initialized
+ *     - ESP_ERR_INVALID_STATE: The resources of the motor or the encoder are not free
+ *     - Sum of the ESP return values of the hardware configuration otherwise
  */
-esp_err_t Initialize_GPIO_for_Stepper_Motor_Driver(void)
+esp_err_t Initialize_Stepper_Motor(void)
 {
-    // Configuration structure for GPIO settings
-    gpio_config_t io_conf = {}; // Zero-initialize the config structure
+    Stepper_Config_t Config;
 
-    // Set up the GPIO configuration
-    io_conf.intr_type = GPIO_PIN_INTR_DISABLE;  // Disable interrupt for the GPIO pins
-    io_conf.mode = GPIO_MODE_OUTPUT;            // Set the GPIO pins to output mode
-    io_conf.pin_bit_mask = GPIO_OUTPUT_PIN_SEL; // Bit mask of the pins to be configured
-    io_conf.pull_down_en = GPIO_PULLUP_DISABLE; // Disable pull-down mode for the GPIO pins
-    io_conf.pull_up_en = GPIO_PULLDOWN_DISABLE; // Disable pull-up mode for the GPIO pins
+    Stepper_Get_Default_Config(&Config);
 
-    // Configure GPIO with the given settings and return the result
-    return gpio_config(&io_conf);
+    Config.Step_Pin = STEPPER_MOTOR_PUL_PIN;                                  // Pulse pin of the motor
+    Config.Step_Output = (STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_LEDC); // Driven by the LEDC channel of the motor
+    Config.Dir_Pin = STEPPER_MOTOR_DIR_PIN;                                   // Direction pin of the motor
+    Config.Enable_Pin = STEPPER_MOTOR_EN_PIN;                                 // Shared by the drivers of all axes
+    Config.Max_Frequency_Hz = MOTION_JOG_MAX_FREQUENCY_HZ;                    // Highest cruise frequency of the planned moves
+    Config.Acceleration = MOTION_DEFAULT_ACCELERATION;                        // Acceleration limit of the planner
+
+    return Initialize_Steppers(&Config, &Motor_0);
 }
 
+#ifndef STEPPER_HOST_SIM
 /**
- * @brief Initialize PWM for Stepper Motor Driver
+ * @brief Create the STEPPER_STATIONS station motors.
  *
- * This function configures the PWM timer and channel for the stepper motor driver.
- * It sets the timer properties, including speed mode, resolution, timer number,
- * and frequency. It also configures the PWM channel, assigning the GPIO pin,
- * speed mode, channel number, timer selection, duty cycle, and high point.
- * Additionally, it installs the fade function for smooth PWM transitions.
+ * The stations get the default limits and any free LEDC timer, channel and
+ * PCNT unit, and have no enable pin. Must be called after
+ * Initialize_Stepper_Motor().
  *
  * @return
  *     - Sum of all ESP return values
  */
-esp_err_t Initialize_PWM_for_Stepper_Motor_Driver(void)
+static esp_err_t Initialize_Station_Motors(void)
 {
-    esp_err_t Function_Error = ESP_OK;
+    static const gpio_num_t Station_Pins[][2] = {
+        {STATION_1_PUL_PIN, STATION_1_DIR_PIN}, // Station motor 1
+        {STATION_2_PUL_PIN, STATION_2_DIR_PIN}, // Station motor 2
+    };
 
-    // Configuration structure for the PWM timer
-    ledc_timer_config_t PWM_timer = {}; // Zero-initialize the config structure for the timer used for the PWM
+    _Static_assert(STEPPER_STATIONS <= (sizeof(Station_Pins) / sizeof(Station_Pins[0])), "Every station motor needs its pins");
 
-    // Set up the PWM timer configuration
-    PWM_timer.speed_mode = LEDC_LOW_SPEED_MODE;    // Use the low-speed mode for the PWM driver
-    PWM_timer.duty_resolution = LEDC_TIMER_10_BIT; // Set the resolution of the timer to 10 bits
-    PWM_timer.timer_num = LEDC_TIMER_0;            // Use timer 0
-    PWM_timer.freq_hz = PWM_FREQUENCY_1KHZ;        // Set the PWM frequency to 1 kHz
-    PWM_timer.clk_cfg = LEDC_AUTO_CLK;             // Auto-select the clock source
-
-    // Configure the PWM timer with the specified settings
-    Function_Error += ledc_timer_config(&PWM_timer);
+    esp_err_t Function_Error = ESP_OK;
+    uint8_t Stations = STEPPER_STATIONS; // Not compared as a constant, 0 stations would warn
 
-    // Configuration structure for the PWM channel
-    ledc_channel_config_t PWM_channel_for_stepper_motor = {}; // Zero-initialize the config structure for the PWM channel
+    for (uint8_t Station = 0; (Station < Stations) && (Function_Error == ESP_OK); Station++)
+    {
+        Stepper_Config_t Config;
+        stepper_t Motor = NULL;
 
-    // Set up the PWM channel configuration
-    PWM_channel_for_stepper_motor.gpio_num = STEPPER_MOTOR_PUL_PIN; // Assign the GPIO pin for the stepper motor pulse
-    PWM_channel_for_stepper_motor.speed_mode = LEDC_LOW_SPEED_MODE; // Use the low-speed mode for the PWM channel
-    PWM_channel_for_stepper_motor.channel = LEDC_CHANNEL_0;         // Use channel 0
-    PWM_channel_for_stepper_motor.timer_sel = LEDC_TIMER_0;         // Select timer 0 for this channel
-    PWM_channel_for_stepper_motor.duty = 0;                         // Initialize the duty cycle to 0
-    PWM_channel_for_stepper_motor.hpoint = 0;                       // Set the high point to 0
+        Stepper_Get_Default_Config(&Config);
 
-    // Configure the PWM channel with the specified settings
-    Function_Error += ledc_channel_config(&PWM_channel_for_stepper_motor);
+        Config.Step_Pin = Station_Pins[Station][0];
+        Config.Dir_Pin = Station_Pins[Station][1];
 
-    // Install the fade function, allowing smooth PWM transitions and return the result
-    Function_Error += ledc_fade_func_install(0);
+        Function_Error = Stepper_Create(&Config, &Motor);
+    }
 
-    // Return the sum of all ESP return values
     return Function_Error;
 }
 
 void app_main(void)
 {
-    ESP_ERROR_CHECK(Initialize_GPIO_for_Stepper_Motor_Driver());
+    ESP_ERROR_CHECK(Initialize_Stepper_Motor());
 
-    ESP_ERROR_CHECK(Initialize_PWM_for_Stepper_Motor_Driver());
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+    ESP_ERROR_CHECK(Initialize_RMT_Pulse_Engine());
+#elif STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    ESP_ERROR_CHECK(Initialize_Timer_Pulse_Engine());
+#endif
 
     /* Stop the stepper motor */
     ESP_ERROR_CHECK(Stop_Stepper_Motor());
 
-    initialize_console();
+    ESP_ERROR_CHECK(Initialize_Multi_Axis());
 
-    ESP_ERROR_CHECK(esp_console_register_help_command());
+    ESP_ERROR_CHECK(Initialize_Homing());
 
-    ESP_ERROR_CHECK(Register_Start_Motor_CMD());
-    ESP_ERROR_CHECK(Register_Stop_Motor_CMD());
-    ESP_ERROR_CHECK(Register_Quick_Start_Motor_CMD());
-    ESP_ERROR_CHECK(Register_Rotate_Motor_CMD());
-    ESP_ERROR_CHECK(Register_Rotate_Angle_CMD());
+    ESP_ERROR_CHECK(Initialize_Motion_Queue());
 
-    const char *prompt = LOG_COLOR_I PROMPT_STR "> " LOG_RESET_COLOR; // Define the prompt string
+    ESP_ERROR_CHECK(Initialize_Gcode_Stream());
 
-    int probe_status = linenoiseProbe(); // Probe the terminal for capabilities
+    esp_err_t Nvs_Error = nvs_flash_init();
 
-    if (probe_status) // Check if probe was unsuccessful
+    if ((Nvs_Error == ESP_ERR_NVS_NO_FREE_PAGES) || (Nvs_Error == ESP_ERR_NVS_NEW_VERSION_FOUND))
     {
-        printf("\n"
-               "Your terminal application does not support escape sequences.\n"
-               "Line editing and history features are disabled.\n"
-               "On Windows, try using Putty instead.\n");
-
-        linenoiseSetDumbMode(1); // Disable advanced features if terminal does not support escape sequences
+        ESP_ERROR_CHECK(nvs_flash_erase()); // Partition is full or of a newer layout, start over
+        Nvs_Error = nvs_flash_init();
     }
 
-    /* Main loop */
-    while (true)
+    ESP_ERROR_CHECK(Nvs_Error);
+
+    if (Initialize_Ramp_Cache() != ESP_OK)
     {
-        /* Get a line using linenoise.
-         * The line is returned when ENTER is pressed.
-         */
-        char *line = linenoise(prompt); // Read a line of input from the console
-        if (line == NULL)
-        { // Break on EOF or error
-            break;
-        }
-        /* Add the command to the history if not empty */
-        if (strlen(line) > 0)
-        {
-            linenoiseHistoryAdd(line); // Add the command to history if it's not empty
-        }
+        printf("Ramp cache: NVS not readable, starting empty\n");
+    }
 
-        /* Try to run the command */
-        int ret;
-        esp_err_t err = esp_console_run(line, &ret); // Execute the command
-        if (err == ESP_ERR_NOT_FOUND)
-        {
-            printf("Unrecognized command\n"); // Print message if command is not recognized
-        }
-        else if (err == ESP_ERR_INVALID_ARG)
-        {
-            // Command was empty
-        }
-        else if (err == ESP_OK && ret != ESP_OK)
-        {
-            printf("Command returned non-zero error code: 0x%x (%s)\n", ret, esp_err_to_name(ret)); // Print error code if command failed
-        }
-        else if (err != ESP_OK)
-        {
-            printf("Internal error: %s\n", esp_err_to_name(err)); // Print internal error
-        }
+    ESP_ERROR_CHECK(Initialize_Motor_Resonance());
 
-        /* linenoise allocates line buffer on the heap, so need to free it */
-        linenoiseFree(line); // Free the allocated line buffer
-    }
+    ESP_ERROR_CHECK(Initialize_Motor_Encoder());
+
+    ESP_ERROR_CHECK(Initialize_Station_Motors());
+
+    ESP_ERROR_CHECK(Initialize_Motor_Script());
+
+    ESP_ERROR_CHECK(Initialize_Trajectory_Player());
+
+    ESP_ERROR_CHECK(Initialize_Binary_Link());
+
+    initialize_console();
+
+    Run_Console(); // Never returns, see console.c
 }
+#endif // STEPPER_HOST_SIM
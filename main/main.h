@@ -20,11 +20,27 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <inttypes.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
 #include "driver/gpio.h"
 #include "driver/ledc.h"
+#include "nvs_flash.h"
+#include "motion_planner.h"
+#include "pulse_counter.h"
+#include "stepper.h"
+#include "rmt_pulse_engine.h"
+#include "timer_pulse_engine.h"
+#include "multi_axis.h"
+#include "ramp_cache.h"
+#include "motion_trace.h"
+#include "velocity_ramp.h"
+#include "motor_resonance.h"
+#include "motor_encoder.h"
+#include "trajectory_format.h"
+#include "ledc_range.h"
 
 #define SET_GPIO_LEVEL_HIGH 0x01
 #define SET_GPIO_LEVEL_LOW 0x00
@@ -33,24 +49,75 @@
 #define STEPPER_MOTOR_DIR_PIN GPIO_NUM_4
 #define STEPPER_MOTOR_PUL_PIN GPIO_NUM_16
 
-#define GPIO_OUTPUT_PIN_SEL ((1ULL << STEPPER_MOTOR_EN_PIN) | (1ULL << STEPPER_MOTOR_DIR_PIN))
+#ifndef STEPPER_STATIONS
+#define STEPPER_STATIONS 0 // Station motors created at start-up, up to 2 on the pins below, see stepper.h, may be given by the build
+#endif
+
+#define STATION_1_PUL_PIN GPIO_NUM_13 // Step pulse of station motor 1
+#define STATION_1_DIR_PIN GPIO_NUM_14 // Direction of station motor 1
+#define STATION_2_PUL_PIN GPIO_NUM_17 // Step pulse of station motor 2
+#define STATION_2_DIR_PIN GPIO_NUM_2  // Direction of station motor 2
 
 #define PWM_FREQUENCY_0HZ 0000
 #define PWM_FREQUENCY_1KHZ 1000
-#define PWM_DUTY_CYCLE_50 512
+#define PWM_DUTY_CYCLE_50 512 // Half of 2^LEDC_RANGE_DUTY_BITS, scaled to the duty resolution of the timer
 #define PWM_DUTY_CYCLE_00 00
 
-#define PWM_START_FREQ 100 // Starting frequency for PWM
-#define PWM_INCREMENT 100  // Increment step for frequency
-#define PWM_DELAY_MS 10    // Delay between frequency changes in milliseconds
+#define STEPPER_PULSE_ENGINE_LEDC 0  // LEDC PWM output, frequency changed per segment, steps counted by PCNT
+#define STEPPER_PULSE_ENGINE_RMT 1   // RMT output, every step period streamed by the driver interrupt
+#define STEPPER_PULSE_ENGINE_TIMER 2 // GPIO output, every step timed by an IRAM timer interrupt on the APP CPU
+#ifndef STEPPER_PULSE_ENGINE
+#define STEPPER_PULSE_ENGINE STEPPER_PULSE_ENGINE_LEDC // Pulse engine driving STEPPER_MOTOR_PUL_PIN, may be given by the build
+#endif
+
+#define MOTION_DEFAULT_ACCELERATION 100000                    // Acceleration limit of the planner in steps/s^2
+#define MOTION_DEFAULT_JERK 0                                 // Jerk limit of the planner in steps/s^3, 0 for trapezoidal ramps
+#define MOTION_SEGMENT_TIME_US (1000000 / configTICK_RATE_HZ) // Duration of one ramp segment, one RTOS tick
+#define MOTION_NOTIFY_ABORT 0x04                              // Task notification bit: the running move was aborted
+#define MOTION_NOTIFY_STOP 0x08                               // Task notification bit: a stop along a decel ramp was requested
+#define MOTION_QUICK_STOP_DECELERATION 1000000                // Default deceleration of a quick-stop in steps/s^2
+#define MOTION_TIMEOUT_MARGIN_MS 1000                         // Extra time allowed over the planned duration before a move is aborted
+
+#define STEPPER_MOTOR_MICROSTEPS 16 // Microstep setting of the driver, part of the ramp cache key
+
+#define MOTION_JOG_MIN_FREQUENCY_HZ 100 // Start/stop frequency of the jog mode, the motor starts and stops there without a ramp
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_LEDC
+#define MOTION_JOG_MAX_FREQUENCY_HZ 400000 // Highest jog speed, the LEDC timer switches its duty resolution on the way, see ledc_range.h
+#else
+#define MOTION_JOG_MAX_FREQUENCY_HZ 70000 // Highest jog speed
+#endif
 
 #define MOTOR_DIRECTION_FORWARD 01
 #define MOTOR_DIRECTION_BACKWARD 00
 
-esp_err_t Initialize_GPIO_for_Stepper_Motor_Driver(void);
-esp_err_t Initialize_PWM_for_Stepper_Motor_Driver(void);
+esp_err_t Initialize_Stepper_Motor(void);
 esp_err_t Stop_Stepper_Motor(void);
 esp_err_t Start_Stepper_Motor(uint8_t Motor_Direction, uint PWM_frequency, uint PWM_Duty_Cycle);
-esp_err_t Rotate_Stepper_Motor(uint PWM_frequency, uint8_t Motor_Direction, float Motor_run_time);
+esp_err_t Move_Stepper_Motor(uint PWM_frequency, uint8_t Motor_Direction, uint32_t Steps, uint32_t *Executed_Steps);
+esp_err_t Abort_Stepper_Motor(void);
+void Clear_Stepper_Motor_Abort(void);
+esp_err_t Rotate_Stepper_Motor(uint PWM_frequency, uint8_t Motor_Direction, uint32_t Steps, uint32_t *Executed_Steps);
+esp_err_t Set_Stepper_Motor_Velocity(int32_t Velocity_Hz, uint PWM_Duty_Cycle);
+int32_t Get_Stepper_Motor_Velocity(void);
+bool Stepper_Motor_Abort_Requested(void);
+void Request_Stepper_Motor_Stop(uint32_t Deceleration);
+void Quick_Stop_Stepper_Motor(void);
+esp_err_t Set_Stepper_Motor_Quick_Stop_Deceleration(uint32_t Deceleration);
+uint32_t Get_Stepper_Motor_Quick_Stop_Deceleration(void);
+uint32_t Stepper_Motor_Stop_Requested(void);
+void Clear_Stepper_Motor_Stop(void);
+esp_err_t Decelerate_Stepper_Motor(uint32_t *Executed_Steps);
+int32_t Get_Stepper_Motor_Position(void);
+uint32_t Get_Stepper_Motor_Emitted_Steps(void);
+void Set_Stepper_Motor_Position(int32_t Position);
+bool Stepper_Motor_Position_Referenced(void);
+esp_err_t Move_Stepper_Motor_To(uint PWM_frequency, int32_t Position, uint32_t *Executed_Steps);
+esp_err_t Set_Stepper_Motor_Limits(uint32_t Max_Frequency_Hz, uint32_t Acceleration);
+void Get_Stepper_Motor_Limits(uint32_t *Max_Frequency_Hz, uint32_t *Acceleration);
+esp_err_t Get_Stepper_Motor_Step_Clock(Ledc_Range_t *Range, uint32_t *Resolution_Changes);
+esp_err_t Run_Stepper_Motor_Trajectory(const Trajectory_View_t *View, uint32_t *Executed_Steps);
+esp_err_t Move_Stepper_Axes_Linear(uint PWM_frequency, const int32_t *Axis_Steps, uint32_t *Executed_Ticks);
+esp_err_t Move_Stepper_Axes_Block(const int32_t *Axis_Steps, uint Nominal_Frequency, uint Entry_Frequency, uint Exit_Frequency, uint Acceleration, uint32_t *Executed_Ticks);
+esp_err_t Move_Stepper_Axes_Arc(uint PWM_frequency, int32_t End_X, int32_t End_Y, int32_t Center_X, int32_t Center_Y, bool Clockwise, uint32_t *Executed_Ticks);
 
 #endif // HEADER_NAME_H
\ No newline at end of file
@@ -0,0 +1,509 @@
+/*H**********************************************************************
+ * FILENAME :        motion_benchmark.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Benchmark suite of the single axis motor control.
+ *
+ * NOTES :
+ *       The suite calls the motor driver functions directly, so it must
+ *       only run while the motion task is idle. The edge interrupt on the
+ *       pulse pin is only enabled while a measurement is running; it is
+ *       left off during the step rate ceiling search, whose rates are
+ *       beyond what an interrupt per step can follow on the ESP32.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <math.h>
+#include <inttypes.h>
+#include "motion_benchmark.h"
+#include "motion_math.h"
+#include "main.h"
+#include "esp_timer.h"
+
+#ifdef STEPPER_HOST_SIM
+#include "sim_hal.h"
+#define MOTION_BENCHMARK_TARGET "host-sim" // Virtual clock of host/sim, interrupts run without latency
+#else
+#define MOTION_BENCHMARK_TARGET CONFIG_IDF_TARGET
+#endif
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+#define MOTION_BENCHMARK_ENGINE "rmt"
+#elif STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+#define MOTION_BENCHMARK_ENGINE "timer"
+#else
+#define MOTION_BENCHMARK_ENGINE "ledc"
+#endif
+
+/** One rotate_motor or rotate_angle style move of the accuracy case */
+typedef struct
+{
+    const char *Command;           // Console command the move stands for
+    uint32_t Frequency_Hz;         // Cruise frequency
+    uint32_t Steps_Per_Revolution; // Steps of one revolution, the --step argument
+    uint64_t Angle_udeg;           // Angle to rotate in micro degrees, rotations are a multiple of 360
+} Accuracy_Case_t;
+
+static const Accuracy_Case_t Accuracy_Cases[] = {
+    {"rotate_motor", 2000, 200, 1800000000},   // 5 rotations of a full step motor
+    {"rotate_motor", 10000, 3200, 1080000000}, // 3 rotations at 1/16 microstepping
+    {"rotate_angle", 4000, 1600, 90000000},    // Quarter turn at 1/8 microstepping
+    {"rotate_angle", 20000, 3200, 720000000},  // Two turns at 1/16 microstepping
+};
+
+static Motion_Profile_t Benchmark_Profile; // Profile the measured moves are compared with
+static volatile uint32_t Edge_Count = 0;   // Rising edges seen since Start_Edge_Capture()
+static volatile int64_t First_Edge_us = 0; // Time of the first edge
+static volatile int64_t Last_Edge_us = 0;  // Time of the last edge
+
+/**
+ * @brief Rising edge interrupt of the pulse pin, times the steps.
+ */
+static void Step_Edge_ISR(void *arg)
+{
+    int64_t Now_us = esp_timer_get_time();
+
+    if (Edge_Count == 0)
+    {
+        First_Edge_us = Now_us;
+    }
+
+    Last_Edge_us = Now_us;
+    Edge_Count++;
+}
+
+/**
+ * @brief Forget the edges seen so far and time the following ones.
+ */
+static void Start_Edge_Capture(void)
+{
+    Edge_Count = 0;
+    First_Edge_us = 0;
+    Last_Edge_us = 0;
+
+    gpio_intr_enable(STEPPER_MOTOR_PUL_PIN);
+}
+
+/**
+ * @brief Stop timing the edges, the results stay readable.
+ */
+static void Stop_Edge_Capture(void)
+{
+    gpio_intr_disable(STEPPER_MOTOR_PUL_PIN);
+}
+
+/**
+ * @brief Plan a move with the same limits the motor driver uses.
+ *
+ * @return Planned time from the first to the last step in microseconds.
+ */
+static uint32_t Plan_Benchmark_Move(uint32_t Frequency_Hz, uint32_t Steps)
+{
+    Motion_Planner_Config_t Config = {
+        .Max_Frequency_Hz = Frequency_Hz,            // Cruise frequency of the move
+        .Acceleration = MOTION_DEFAULT_ACCELERATION, // Default acceleration limit
+        .Jerk = MOTION_DEFAULT_JERK,                 // Default jerk limit
+        .Segment_Time_us = MOTION_SEGMENT_TIME_US,   // One ramp segment per RTOS tick
+    };
+
+    if (!Motion_Planner_Plan_Move(&Config, Steps, &Benchmark_Profile) || (Benchmark_Profile.Segment_Count == 0))
+    {
+        return 0;
+    }
+
+    // The last step starts one period before the end of the profile
+    uint32_t Last_Frequency = Benchmark_Profile.Segments[Benchmark_Profile.Segment_Count - 1].Frequency_Hz;
+    uint32_t Last_Period_us = (1000000 + (Last_Frequency / 2)) / Last_Frequency;
+
+    return (Benchmark_Profile.Duration_us > Last_Period_us) ? (Benchmark_Profile.Duration_us - Last_Period_us) : 0;
+}
+
+/**
+ * @brief Deviation of a measured value from the expected one in parts per million.
+ */
+static int32_t Error_ppm(uint32_t Measured, uint32_t Expected)
+{
+    if (Expected == 0)
+    {
+        return 0;
+    }
+
+    return (int32_t)((((int64_t)Measured - (int64_t)Expected) * 1000000LL) / (int64_t)Expected);
+}
+
+/**
+ * @brief Print the fields every JSON record starts with, without closing it.
+ */
+static void Print_Record_Header(const char *Case)
+{
+    printf("{\"suite\":\"motion_bench\",\"schema\":%d,\"target\":\"%s\",\"engine\":\"%s\",\"case\":\"%s\"",
+           MOTION_BENCHMARK_SCHEMA_VERSION, MOTION_BENCHMARK_TARGET, MOTION_BENCHMARK_ENGINE, Case);
+}
+
+#ifndef STEPPER_HOST_SIM
+static volatile bool Load_Running = false; // Keeps the console load task printing
+
+/**
+ * @brief Keep the console UART busy like a chatty command handler would.
+ *
+ * Runs at the console priority on the console CPU and prints without
+ * pause. Without a TX buffer every printf waits for the UART, as the
+ * console output does.
+ */
+static void Console_Load_Task(void *arg)
+{
+    while (Load_Running)
+    {
+        printf("# console load ..................................................\n");
+    }
+
+    vTaskDelete(NULL);
+}
+#endif
+
+/**
+ * @brief Start or stop the console load.
+ *
+ * The host simulation has a single task, so a simulated console writer
+ * takes MOTION_BENCHMARK_SIM_LOAD_BUSY_US of the CPU of every
+ * MOTION_BENCHMARK_SIM_LOAD_PERIOD_US instead, see Sim_Set_Console_Load().
+ *
+ * @return false if the load cannot be generated.
+ */
+static bool Set_Console_Load(bool Enable)
+{
+#ifdef STEPPER_HOST_SIM
+    Sim_Set_Console_Load(Enable ? MOTION_BENCHMARK_SIM_LOAD_PERIOD_US : 0, MOTION_BENCHMARK_SIM_LOAD_BUSY_US);
+
+    return true;
+#else
+    if (Enable)
+    {
+        Load_Running = true;
+
+        return xTaskCreatePinnedToCore(Console_Load_Task, "bench_load", MOTION_BENCHMARK_LOAD_STACK_SIZE, NULL, MOTION_BENCHMARK_LOAD_PRIORITY, NULL, MOTION_BENCHMARK_LOAD_CORE) == pdPASS;
+    }
+
+    Load_Running = false;
+
+    vTaskDelay(pdMS_TO_TICKS(100)); // Let the load task finish its line and delete itself
+
+    return true;
+#endif
+}
+
+/**
+ * @brief Time the first step of a series of short moves.
+ */
+static void Run_Latency_Case(Motion_Benchmark_Latency_t *Result)
+{
+    uint64_t Total_us = 0;
+    uint32_t Executed_Steps = 0;
+
+    memset(Result, 0, sizeof(*Result));
+
+    Result->Min_us = UINT32_MAX;
+
+    for (uint32_t Run = 0; Run < MOTION_BENCHMARK_LATENCY_RUNS; Run++)
+    {
+        Start_Edge_Capture();
+
+        int64_t Start_us = esp_timer_get_time();
+
+        esp_err_t Function_Error = Rotate_Stepper_Motor(MOTION_BENCHMARK_LATENCY_FREQUENCY_HZ, MOTOR_DIRECTION_FORWARD, MOTION_BENCHMARK_LATENCY_STEPS, &Executed_Steps);
+
+        Stop_Edge_Capture();
+
+        Result->Runs++;
+
+        if ((Function_Error != ESP_OK) || (Edge_Count == 0))
+        {
+            Result->Missed++;
+            continue;
+        }
+
+        uint32_t Latency_us = (uint32_t)(First_Edge_us - Start_us);
+
+        Result->Min_us = (Latency_us < Result->Min_us) ? Latency_us : Result->Min_us;
+        Result->Max_us = (Latency_us > Result->Max_us) ? Latency_us : Result->Max_us;
+        Total_us += Latency_us;
+    }
+
+    uint32_t Timed = Result->Runs - Result->Missed;
+
+    Result->Mean_us = (Timed > 0) ? (uint32_t)(Total_us / Timed) : 0;
+    Result->Min_us = (Timed > 0) ? Result->Min_us : 0;
+}
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+/**
+ * @brief Collect the step timer interrupt latency while a frequency is held.
+ *
+ * The histogram is cleared once the ramp up is done, so it only holds
+ * interrupts of the held frequency.
+ */
+static esp_err_t Run_Isr_Latency_Case(Timer_Pulse_Engine_Latency_t *Result)
+{
+    esp_err_t Function_Error = Start_Stepper_Motor(MOTOR_DIRECTION_FORWARD, MOTION_BENCHMARK_ISR_FREQUENCY_HZ, PWM_DUTY_CYCLE_50);
+
+    Timer_Pulse_Engine_Reset_Latency();
+
+    vTaskDelay(pdMS_TO_TICKS(MOTION_BENCHMARK_ISR_WINDOW_MS));
+
+    Timer_Pulse_Engine_Get_Latency(Result);
+
+    Function_Error += Stop_Stepper_Motor();
+
+    return Function_Error;
+}
+
+/**
+ * @brief Print the record of an interrupt latency case.
+ */
+static void Print_Isr_Latency(const Timer_Pulse_Engine_Latency_t *Result, bool Console_Load)
+{
+    const uint32_t Tick_ns = 1000000000UL / TIMER_PULSE_ENGINE_TICK_HZ;
+    uint32_t Mean_Ticks = (Result->Count > 0) ? (uint32_t)(Result->Sum_Ticks / Result->Count) : 0;
+
+    Print_Record_Header("isr_latency");
+    printf(",\"load\":%s,\"core\":%d,\"frequency_hz\":%d,\"samples\":%" PRIu32, Console_Load ? "true" : "false", TIMER_PULSE_ENGINE_CORE, MOTION_BENCHMARK_ISR_FREQUENCY_HZ, Result->Count);
+    printf(",\"min_ns\":%" PRIu32 ",\"mean_ns\":%" PRIu32 ",\"max_ns\":%" PRIu32 ",\"jitter_ns\":%" PRIu32 ",\"bins\":[",
+           Result->Min_Ticks * Tick_ns, Mean_Ticks * Tick_ns, Result->Max_Ticks * Tick_ns, (Result->Max_Ticks - Result->Min_Ticks) * Tick_ns);
+
+    for (uint8_t Bin = 0; Bin < TIMER_PULSE_ENGINE_LATENCY_BINS; Bin++)
+    {
+        printf("%s%" PRIu32, (Bin > 0) ? "," : "", Result->Bins[Bin]);
+    }
+
+    printf("]}\n");
+}
+#endif
+
+/**
+ * @brief Run one move of the accuracy case and measure the held frequency.
+ */
+static void Run_Accuracy_Case(const Accuracy_Case_t *Case, Motion_Benchmark_Accuracy_t *Result)
+{
+    memset(Result, 0, sizeof(*Result));
+
+    Result->Command = Case->Command;
+    Result->Requested_Hz = Case->Frequency_Hz;
+    Motion_Math_Steps_For_Angle(Case->Steps_Per_Revolution, Case->Angle_udeg, &Result->Requested_Steps); // Same conversion as the console commands
+    Result->Planned_us = Plan_Benchmark_Move(Case->Frequency_Hz, Result->Requested_Steps);
+
+    Start_Edge_Capture();
+
+    Result->Result = Rotate_Stepper_Motor(Case->Frequency_Hz, MOTOR_DIRECTION_FORWARD, Result->Requested_Steps, &Result->Reported_Steps);
+
+    Stop_Edge_Capture();
+
+    Result->Observed_Steps = Edge_Count;
+    Result->Measured_us = (Edge_Count > 1) ? (uint32_t)(Last_Edge_us - First_Edge_us) : 0;
+
+    if (Start_Stepper_Motor(MOTOR_DIRECTION_FORWARD, Case->Frequency_Hz, PWM_DUTY_CYCLE_50) == ESP_OK)
+    {
+        Start_Edge_Capture();
+
+        vTaskDelay(pdMS_TO_TICKS(MOTION_BENCHMARK_RATE_WINDOW_MS));
+
+        Stop_Edge_Capture();
+
+        if ((Edge_Count > 1) && (Last_Edge_us > First_Edge_us))
+        {
+            Result->Achieved_Hz = (uint32_t)llround(((Edge_Count - 1) * 1000000.0) / (double)(Last_Edge_us - First_Edge_us));
+        }
+    }
+
+    Stop_Stepper_Motor();
+}
+
+/**
+ * @brief Run a move that cruises at the given step rate and check it completes in time.
+ */
+static bool Ceiling_Move_Passes(uint32_t Frequency_Hz)
+{
+    uint32_t Executed_Steps = 0;
+    uint64_t Ramp_Steps = ((uint64_t)Frequency_Hz * Frequency_Hz) / MOTION_DEFAULT_ACCELERATION; // Accel and decel ramp together
+    uint32_t Steps = (uint32_t)(Ramp_Steps + (((uint64_t)Frequency_Hz * MOTION_BENCHMARK_CEILING_CRUISE_MS) / 1000));
+
+    Plan_Benchmark_Move(Frequency_Hz, Steps);
+
+    uint64_t Allowed_us = Benchmark_Profile.Duration_us + (((uint64_t)Benchmark_Profile.Duration_us * MOTION_BENCHMARK_TOLERANCE_PPM) / 1000000) + (2 * MOTION_SEGMENT_TIME_US);
+
+    int64_t Start_us = esp_timer_get_time();
+
+    esp_err_t Function_Error = Rotate_Stepper_Motor(Frequency_Hz, MOTOR_DIRECTION_FORWARD, Steps, &Executed_Steps);
+
+    uint64_t Elapsed_us = (uint64_t)(esp_timer_get_time() - Start_us);
+
+    return (Function_Error == ESP_OK) && (Executed_Steps == Steps) && (Elapsed_us <= Allowed_us);
+}
+
+/**
+ * @brief Search the highest cruise step rate a move still completes at.
+ *
+ * @param Moves Returns the number of moves run by the search.
+ * @return Highest passing step rate, 0 if even the lowest one fails.
+ */
+static uint32_t Run_Ceiling_Case(uint32_t *Moves)
+{
+    uint32_t Low = MOTION_BENCHMARK_CEILING_LOW_HZ;
+    uint32_t High = MOTION_BENCHMARK_CEILING_HIGH_HZ;
+
+    *Moves = 2;
+
+    if (!Ceiling_Move_Passes(Low))
+    {
+        return 0;
+    }
+
+    if (Ceiling_Move_Passes(High))
+    {
+        return High;
+    }
+
+    while ((High - Low) > MOTION_BENCHMARK_CEILING_RESOLUTION_HZ)
+    {
+        uint32_t Middle = Low + ((High - Low) / 2);
+
+        if (Ceiling_Move_Passes(Middle))
+        {
+            Low = Middle;
+        }
+        else
+        {
+            High = Middle;
+        }
+
+        (*Moves)++;
+    }
+
+    return Low;
+}
+
+/**
+ * @brief Print the record of a latency case.
+ */
+static void Print_Latency(const Motion_Benchmark_Latency_t *Result, bool Console_Load)
+{
+    Print_Record_Header("latency");
+    printf(",\"load\":%s,\"runs\":%" PRIu32 ",\"missed\":%" PRIu32 ",\"min_us\":%" PRIu32 ",\"mean_us\":%" PRIu32 ",\"max_us\":%" PRIu32 ",\"jitter_us\":%" PRIu32 ",\"limit_us\":%d}\n",
+           Console_Load ? "true" : "false", Result->Runs, Result->Missed, Result->Min_us, Result->Mean_us, Result->Max_us, Result->Max_us - Result->Min_us, MOTION_BENCHMARK_LATENCY_LIMIT_US);
+}
+
+/**
+ * @brief Print the record of one accuracy move.
+ */
+static void Print_Accuracy(const Motion_Benchmark_Accuracy_t *Result)
+{
+    Print_Record_Header("accuracy");
+    printf(",\"command\":\"%s\",\"requested_hz\":%" PRIu32 ",\"achieved_hz\":%" PRIu32 ",\"frequency_error_ppm\":%" PRId32, Result->Command, Result->Requested_Hz, Result->Achieved_Hz, Error_ppm(Result->Achieved_Hz, Result->Requested_Hz));
+    printf(",\"requested_steps\":%" PRIu32 ",\"reported_steps\":%" PRIu32 ",\"observed_steps\":%" PRIu32, Result->Requested_Steps, Result->Reported_Steps, Result->Observed_Steps);
+    printf(",\"planned_us\":%" PRIu32 ",\"measured_us\":%" PRIu32 ",\"duration_error_ppm\":%" PRId32 ",\"result\":\"%s\"}\n", Result->Planned_us, Result->Measured_us, Error_ppm(Result->Measured_us, Result->Planned_us), esp_err_to_name(Result->Result));
+}
+
+/**
+ * @brief Run the whole benchmark suite and print one JSON record per result.
+ *
+ * Records, all with the fields suite, schema, target, engine and case:
+ *   latency     : move request to first step over
+ *                 MOTION_BENCHMARK_LATENCY_RUNS moves, once idle and once
+ *                 under console load. The difference of both jitter_us
+ *                 values is the console impact. A case fails if max_us is
+ *                 above limit_us, MOTION_BENCHMARK_LATENCY_LIMIT_US.
+ *   isr_latency : timer engine only, alarm to interrupt latency of the step
+ *                 timer while a frequency is held, idle and under console
+ *                 load, with a histogram of power of two tick bins.
+ *   accuracy    : requested, reported and observed steps, requested and
+ *                 achieved frequency and the planned and measured duration
+ *                 of rotate_motor and rotate_angle style moves.
+ *   ceiling     : highest cruise step rate a move still completes at.
+ *   summary     : number of failed checks.
+ *
+ * The motion task has to be idle, and the motor may run up to
+ * MOTION_BENCHMARK_CEILING_HIGH_HZ.
+ *
+ * @param Console_Load Repeat the latency cases while the console is printing.
+ * @return ESP_OK if every check passed, ESP_FAIL if one failed, or the error
+ *         of the edge interrupt setup.
+ */
+esp_err_t Motion_Benchmark_Run(bool Console_Load)
+{
+    esp_err_t Function_Error = gpio_install_isr_service(0);
+    Motion_Benchmark_Latency_t Latency;
+    Motion_Benchmark_Accuracy_t Accuracy;
+    uint32_t Failed = 0;
+    uint32_t Moves = 0;
+
+    if (Function_Error == ESP_ERR_INVALID_STATE)
+    {
+        Function_Error = ESP_OK; // Service installed by someone else
+    }
+
+    Function_Error += gpio_set_intr_type(STEPPER_MOTOR_PUL_PIN, GPIO_INTR_POSEDGE);
+    Function_Error += gpio_isr_handler_add(STEPPER_MOTOR_PUL_PIN, Step_Edge_ISR, NULL);
+
+    Stop_Edge_Capture();
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    Clear_Stepper_Motor_Abort();
+
+    Run_Latency_Case(&Latency);
+    Print_Latency(&Latency, false);
+    Failed += ((Latency.Missed > 0) || (Latency.Max_us > MOTION_BENCHMARK_LATENCY_LIMIT_US)) ? 1 : 0;
+
+    if (Console_Load && Set_Console_Load(true))
+    {
+        Run_Latency_Case(&Latency);
+        Set_Console_Load(false);
+        Print_Latency(&Latency, true);
+        Failed += ((Latency.Missed > 0) || (Latency.Max_us > MOTION_BENCHMARK_LATENCY_LIMIT_US)) ? 1 : 0;
+    }
+
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    Timer_Pulse_Engine_Latency_t Isr_Latency;
+
+    Failed += ((Run_Isr_Latency_Case(&Isr_Latency) != ESP_OK) || (Isr_Latency.Count == 0)) ? 1 : 0;
+    Print_Isr_Latency(&Isr_Latency, false);
+
+    if (Console_Load && Set_Console_Load(true))
+    {
+        esp_err_t Isr_Error = Run_Isr_Latency_Case(&Isr_Latency);
+
+        Set_Console_Load(false);
+        Print_Isr_Latency(&Isr_Latency, true);
+        Failed += ((Isr_Error != ESP_OK) || (Isr_Latency.Count == 0)) ? 1 : 0;
+    }
+#endif
+
+    for (size_t Index = 0; Index < (sizeof(Accuracy_Cases) / sizeof(Accuracy_Cases[0])); Index++)
+    {
+        Run_Accuracy_Case(&Accuracy_Cases[Index], &Accuracy);
+        Print_Accuracy(&Accuracy);
+        Failed += ((Accuracy.Result != ESP_OK) || (Accuracy.Reported_Steps != Accuracy.Requested_Steps) || (Accuracy.Observed_Steps != Accuracy.Requested_Steps)) ? 1 : 0;
+    }
+
+    uint32_t Ceiling_Hz = Run_Ceiling_Case(&Moves);
+
+    Print_Record_Header("ceiling");
+    printf(",\"max_step_rate_hz\":%" PRIu32 ",\"resolution_hz\":%d,\"moves\":%" PRIu32 "}\n", Ceiling_Hz, MOTION_BENCHMARK_CEILING_RESOLUTION_HZ, Moves);
+    Failed += (Ceiling_Hz == 0) ? 1 : 0;
+
+    Print_Record_Header("summary");
+    printf(",\"failed\":%" PRIu32 "}\n", Failed);
+
+    gpio_isr_handler_remove(STEPPER_MOTOR_PUL_PIN);
+    gpio_set_intr_type(STEPPER_MOTOR_PUL_PIN, GPIO_INTR_DISABLE);
+
+    Stop_Stepper_Motor();
+
+    return (Failed == 0) ? ESP_OK : ESP_FAIL;
+}
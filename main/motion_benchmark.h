@@ -0,0 +1,77 @@
+/*H**********************************************************************
+ * FILENAME :        motion_benchmark.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Benchmark suite of the single axis motor control.
+ *
+ * NOTES :
+ *       Measures the time from a move request to its first step pulse,
+ *       the step count and frequency achieved by rotate_motor and
+ *       rotate_angle style moves, the latency jitter under console load
+ *       and the highest step rate a move still runs at. The step pulses
+ *       are read back through an edge interrupt on the pulse pin and timed
+ *       with esp_timer, so the same suite runs on the ESP32 and on the
+ *       simulated hardware of host/sim.
+ *
+ *       Every result is printed as one line holding a JSON object, see
+ *       Motion_Benchmark_Run(). Other lines are diagnostics.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTION_BENCHMARK_H
+#define MOTION_BENCHMARK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#define MOTION_BENCHMARK_SCHEMA_VERSION 1          // Version of the JSON records, raised on incompatible changes
+#define MOTION_BENCHMARK_LATENCY_RUNS 20           // Moves timed per latency case
+#define MOTION_BENCHMARK_LATENCY_FREQUENCY_HZ 1000 // Cruise frequency of the latency moves
+#define MOTION_BENCHMARK_LATENCY_STEPS 20          // Steps of one latency move
+#define MOTION_BENCHMARK_LATENCY_LIMIT_US 1000     // Longest allowed request to first step latency, idle and under console load
+#define MOTION_BENCHMARK_RATE_WINDOW_MS 200        // Time the achieved frequency is measured over
+#define MOTION_BENCHMARK_CEILING_LOW_HZ 1000       // Lowest step rate of the ceiling search, expected to pass
+#define MOTION_BENCHMARK_CEILING_HIGH_HZ 400000    // Highest step rate of the ceiling search
+#define MOTION_BENCHMARK_CEILING_RESOLUTION_HZ 500 // The ceiling search stops at this step rate interval
+#define MOTION_BENCHMARK_CEILING_CRUISE_MS 50      // Cruise time of the ceiling moves
+#define MOTION_BENCHMARK_TOLERANCE_PPM 20000       // Allowed duration error of a ceiling move
+#define MOTION_BENCHMARK_LOAD_PRIORITY 1           // Priority of the console load task, the same as the console
+#define MOTION_BENCHMARK_LOAD_STACK_SIZE 2048      // Stack size of the console load task in bytes
+#define MOTION_BENCHMARK_LOAD_CORE 0               // PRO CPU, where the console runs
+#define MOTION_BENCHMARK_SIM_LOAD_PERIOD_US 1000   // Interval of the console writer turns in the host simulation
+#define MOTION_BENCHMARK_SIM_LOAD_BUSY_US 100      // CPU time the simulated writer takes per turn
+#define MOTION_BENCHMARK_ISR_FREQUENCY_HZ 20000    // Held frequency of the interrupt latency case, timer engine only
+#define MOTION_BENCHMARK_ISR_WINDOW_MS 1000        // Time the interrupt latency is collected over
+
+/** Statistics of the command to first step latency */
+typedef struct
+{
+    uint32_t Runs;    // Moves timed
+    uint32_t Missed;  // Moves without a step or with an error
+    uint32_t Min_us;  // Shortest latency
+    uint32_t Mean_us; // Average latency
+    uint32_t Max_us;  // Longest latency
+} Motion_Benchmark_Latency_t;
+
+/** Result of one rotate_motor or rotate_angle style move */
+typedef struct
+{
+    const char *Command;      // Console command the move stands for
+    uint32_t Requested_Hz;    // Cruise frequency asked for
+    uint32_t Achieved_Hz;     // Step rate measured while holding that frequency
+    uint32_t Requested_Steps; // Steps of the move
+    uint32_t Reported_Steps;  // Steps counted by the pulse engine
+    uint32_t Observed_Steps;  // Rising edges seen on the pulse pin
+    uint32_t Planned_us;      // Planned time from the first to the last step
+    uint32_t Measured_us;     // Measured time from the first to the last step
+    esp_err_t Result;         // Result of the move
+} Motion_Benchmark_Accuracy_t;
+
+esp_err_t Motion_Benchmark_Run(bool Console_Load);
+
+#endif // MOTION_BENCHMARK_H
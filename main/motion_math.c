@@ -0,0 +1,323 @@
+/*H**********************************************************************
+ * FILENAME :        motion_math.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Integer fixed-point math of the stepper motor example.
+ *
+ * NOTES :
+ *       The 128 bit products and quotients are built from 32 bit halves,
+ *       the ESP32 compiler has no 128 bit integer type. The common case of
+ *       a product that fits 64 bits takes a single 64 bit division.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stddef.h>
+#include "motion_math.h"
+
+/**
+ * @brief Full 128 bit product of two 64 bit values.
+ */
+static void Multiply_128(uint64_t A, uint64_t B, uint64_t *High, uint64_t *Low)
+{
+    uint64_t A_Low = (uint32_t)A;
+    uint64_t A_High = A >> 32;
+    uint64_t B_Low = (uint32_t)B;
+    uint64_t B_High = B >> 32;
+
+    uint64_t Low_Low = A_Low * B_Low;
+    uint64_t High_Low = A_High * B_Low;
+    uint64_t Low_High = A_Low * B_High;
+    uint64_t Cross = (Low_Low >> 32) + (uint32_t)High_Low + Low_High; // At most 2^64 - 1, cannot overflow
+
+    *Low = (Cross << 32) | (uint32_t)Low_Low;
+    *High = (A_High * B_High) + (High_Low >> 32) + (Cross >> 32);
+}
+
+/**
+ * @brief Divide a 128 bit value by a 64 bit divisor, the quotient must fit 64 bits.
+ *
+ * @param High Upper half of the dividend, lower than the divisor.
+ * @param Low Lower half of the dividend.
+ * @param Divisor Divisor, not 0.
+ * @param Remainder Returns the remainder.
+ * @return Quotient.
+ */
+static uint64_t Divide_128(uint64_t High, uint64_t Low, uint64_t Divisor, uint64_t *Remainder)
+{
+    for (uint8_t Bit = 0; Bit < 64; Bit++)
+    {
+        bool Carry = (High >> 63) != 0; // Bit shifted out of the partial remainder
+
+        High = (High << 1) | (Low >> 63);
+        Low <<= 1;
+
+        if (Carry || (High >= Divisor))
+        {
+            High -= Divisor;
+            Low |= 1; // Quotient bits are shifted in where the dividend bits left
+        }
+    }
+
+    *Remainder = High;
+
+    return Low;
+}
+
+/**
+ * @brief Quotient and remainder of A * B / Divisor.
+ *
+ * @return false if the quotient does not fit 64 bits or the divisor is 0.
+ */
+static bool Mul_Div_Remainder(uint64_t A, uint64_t B, uint64_t Divisor, uint64_t *Quotient, uint64_t *Remainder)
+{
+    uint64_t High = 0;
+    uint64_t Low = 0;
+
+    if (Divisor == 0)
+    {
+        return false;
+    }
+
+    Multiply_128(A, B, &High, &Low);
+
+    if (High == 0)
+    {
+        *Quotient = Low / Divisor;
+        *Remainder = Low % Divisor;
+
+        return true;
+    }
+
+    if (High >= Divisor)
+    {
+        return false; // Quotient needs more than 64 bits
+    }
+
+    *Quotient = Divide_128(High, Low, Divisor, Remainder);
+
+    return true;
+}
+
+/**
+ * @brief Product of two values, saturated at UINT64_MAX.
+ */
+uint64_t Motion_Math_Mul_Sat(uint64_t A, uint64_t B)
+{
+    uint64_t High = 0;
+    uint64_t Low = 0;
+
+    Multiply_128(A, B, &High, &Low);
+
+    return (High == 0) ? Low : UINT64_MAX;
+}
+
+/**
+ * @brief A * B / Divisor rounded down, with a 128 bit intermediate product.
+ *
+ * @return The quotient, UINT64_MAX if it does not fit or the divisor is 0.
+ */
+uint64_t Motion_Math_Mul_Div(uint64_t A, uint64_t B, uint64_t Divisor)
+{
+    uint64_t Quotient = 0;
+    uint64_t Remainder = 0;
+
+    if (!Mul_Div_Remainder(A, B, Divisor, &Quotient, &Remainder))
+    {
+        return UINT64_MAX;
+    }
+
+    return Quotient;
+}
+
+/**
+ * @brief A * B / Divisor rounded half up, with a 128 bit intermediate product.
+ *
+ * @return The quotient, UINT64_MAX if it does not fit or the divisor is 0.
+ */
+uint64_t Motion_Math_Mul_Div_Round(uint64_t A, uint64_t B, uint64_t Divisor)
+{
+    uint64_t Quotient = 0;
+    uint64_t Remainder = 0;
+
+    if (!Mul_Div_Remainder(A, B, Divisor, &Quotient, &Remainder))
+    {
+        return UINT64_MAX;
+    }
+
+    if ((Remainder >= (Divisor - Remainder)) && (Quotient < UINT64_MAX))
+    {
+        Quotient++; // Remainder is at least half the divisor
+    }
+
+    return Quotient;
+}
+
+/**
+ * @brief Integer square root, rounded down.
+ */
+uint32_t Motion_Math_Isqrt(uint64_t Value)
+{
+    uint64_t Result = 0;
+    uint64_t Bit = 1ULL << 62; // Highest power of four
+
+    while (Bit > Value)
+    {
+        Bit >>= 2;
+    }
+
+    while (Bit != 0)
+    {
+        if (Value >= (Result + Bit))
+        {
+            Value -= Result + Bit;
+            Result = (Result >> 1) + Bit;
+        }
+        else
+        {
+            Result >>= 1;
+        }
+
+        Bit >>= 2;
+    }
+
+    return (uint32_t)Result;
+}
+
+/**
+ * @brief Parse a decimal number into a fixed-point integer without floating point.
+ *
+ * "90.5" with 6 decimals gives 90500000. Digits beyond the requested
+ * decimals are rounded half away from zero.
+ *
+ * @param Text Number with an optional sign and an optional fraction.
+ * @param Decimals Decimal places of the result.
+ * @param Value Returns the scaled value.
+ * @return false if the text is not a number or the value does not fit.
+ */
+bool Motion_Math_Parse_Fixed(const char *Text, uint8_t Decimals, int64_t *Value)
+{
+    uint64_t Magnitude = 0;
+    uint8_t Fraction_Digits = 0;
+    bool Negative = false;
+    bool Fraction = false;
+    bool Round_Up = false;
+    bool Digits = false;
+
+    if ((Text == NULL) || (Value == NULL))
+    {
+        return false;
+    }
+
+    if ((*Text == '-') || (*Text == '+'))
+    {
+        Negative = (*Text == '-');
+        Text++;
+    }
+
+    for (; *Text != '\0'; Text++)
+    {
+        if ((*Text == '.') && !Fraction)
+        {
+            Fraction = true;
+            continue;
+        }
+
+        if ((*Text < '0') || (*Text > '9'))
+        {
+            return false;
+        }
+
+        Digits = true;
+
+        if (Fraction && (Fraction_Digits >= Decimals))
+        {
+            Round_Up = Round_Up || ((Fraction_Digits == Decimals) && (*Text >= '5')); // Only the first dropped digit decides
+            Fraction_Digits = Decimals + 1;
+            continue;
+        }
+
+        uint64_t Digit = (uint64_t)(*Text - '0');
+
+        if (Magnitude > ((INT64_MAX - Digit) / 10))
+        {
+            return false;
+        }
+
+        Magnitude = (Magnitude * 10) + Digit;
+        Fraction_Digits += Fraction ? 1 : 0;
+    }
+
+    if (!Digits)
+    {
+        return false;
+    }
+
+    for (uint8_t Digit = (Fraction_Digits > Decimals) ? Decimals : Fraction_Digits; Digit < Decimals; Digit++)
+    {
+        if (Magnitude > (INT64_MAX / 10))
+        {
+            return false;
+        }
+
+        Magnitude *= 10; // Scale missing decimal places
+    }
+
+    Magnitude += Round_Up ? 1 : 0;
+
+    if (Magnitude > INT64_MAX)
+    {
+        return false;
+    }
+
+    *Value = Negative ? -(int64_t)Magnitude : (int64_t)Magnitude;
+
+    return true;
+}
+
+/**
+ * @brief Steps to rotate a motor by an angle, rounded to the nearest step.
+ *
+ * @param Steps_Per_Revolution Steps of one revolution.
+ * @param Angle_udeg Angle in micro degrees.
+ * @param Steps Returns the number of steps.
+ * @return false if the result does not fit 32 bits.
+ */
+bool Motion_Math_Steps_For_Angle(uint32_t Steps_Per_Revolution, uint64_t Angle_udeg, uint32_t *Steps)
+{
+    uint64_t Result = Motion_Math_Mul_Div_Round(Steps_Per_Revolution, Angle_udeg, MOTION_MATH_REVOLUTION_UDEG);
+
+    if (Result > UINT32_MAX)
+    {
+        return false;
+    }
+
+    *Steps = (uint32_t)Result;
+
+    return true;
+}
+
+/**
+ * @brief Steps to rotate a motor by whole revolutions.
+ *
+ * @param Steps_Per_Revolution Steps of one revolution.
+ * @param Rotations Number of revolutions.
+ * @param Steps Returns the number of steps.
+ * @return false if the result does not fit 32 bits.
+ */
+bool Motion_Math_Steps_For_Rotations(uint32_t Steps_Per_Revolution, uint32_t Rotations, uint32_t *Steps)
+{
+    uint64_t Result = (uint64_t)Steps_Per_Revolution * Rotations;
+
+    if (Result > UINT32_MAX)
+    {
+        return false;
+    }
+
+    *Steps = (uint32_t)Result;
+
+    return true;
+}
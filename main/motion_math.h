@@ -0,0 +1,41 @@
+/*H**********************************************************************
+ * FILENAME :        motion_math.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Integer fixed-point math of the stepper motor example.
+ *
+ * NOTES :
+ *       Steps, frequencies and times are plain integers, angles are held
+ *       in micro degrees. Products that can exceed 64 bits are formed as
+ *       128 bit intermediates, so the results are exact, deterministic on
+ *       every target and saturate instead of wrapping. No floating point
+ *       is used, neither hardware nor soft-float.
+ *
+ *       This module only depends on the C standard library so it can be
+ *       compiled and exercised on a Linux host as well as on the ESP32.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTION_MATH_H
+#define MOTION_MATH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MOTION_MATH_ANGLE_DECIMALS 6                                               // Decimal places of an angle, micro degrees
+#define MOTION_MATH_ANGLE_SCALE 1000000ULL                                         // Micro degrees per degree
+#define MOTION_MATH_REVOLUTION_UDEG (360ULL * MOTION_MATH_ANGLE_SCALE)             // Micro degrees per revolution
+
+uint64_t Motion_Math_Mul_Sat(uint64_t A, uint64_t B);
+uint64_t Motion_Math_Mul_Div(uint64_t A, uint64_t B, uint64_t Divisor);
+uint64_t Motion_Math_Mul_Div_Round(uint64_t A, uint64_t B, uint64_t Divisor);
+uint32_t Motion_Math_Isqrt(uint64_t Value);
+bool Motion_Math_Parse_Fixed(const char *Text, uint8_t Decimals, int64_t *Value);
+bool Motion_Math_Steps_For_Angle(uint32_t Steps_Per_Revolution, uint64_t Angle_udeg, uint32_t *Steps);
+bool Motion_Math_Steps_For_Rotations(uint32_t Steps_Per_Revolution, uint32_t Rotations, uint32_t *Steps);
+
+#endif // MOTION_MATH_H
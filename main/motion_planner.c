@@ -0,0 +1,614 @@
+/*H**********************************************************************
+ * FILENAME :        motion_planner.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent motion planner for the stepper motor example.
+ *
+ * NOTES :
+ *       The ramp is cut into equal time slices. The step count of every
+ *       slice comes from the rounded position at the slice boundaries, so
+ *       the sum of all segment steps is always exactly the requested move.
+ *
+ *       Trapezoidal profiles and path blocks are planned in integer math,
+ *       see motion_math.h, so the same move gives the same segments on every
+ *       target. Accel ramps of common settings are looked up from the tables
+ *       generated at build time by ramp_table_gen.py. S-curve ramps (jerk
+ *       limit set) are still planned in floating point.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <math.h>
+#include <string.h>
+#include "motion_planner.h"
+#include "motion_math.h"
+#include "ramp_tables.h"
+
+/** Shape of one acceleration ramp from standstill to the peak velocity */
+typedef struct
+{
+    float Peak_Velocity; // Velocity at the end of the ramp (steps/s)
+    float Acceleration;  // Acceleration reached during the ramp (steps/s^2)
+    float Jerk;          // Jerk used during the ramp (steps/s^3), 0 for trapezoidal
+    float Jerk_Time;     // Duration of each jerk phase (s)
+    float Const_Time;    // Duration of the constant acceleration phase (s)
+    float Duration;      // Total ramp duration (s)
+    float Distance;      // Steps covered by the ramp
+} Ramp_Shape_t;
+
+/**
+ * @brief Compute the timing of a ramp from standstill to the given velocity.
+ *
+ * With a jerk limit the ramp is a 7 segment S-curve accel half (jerk up,
+ * constant acceleration, jerk down). If the velocity is too low to ever reach
+ * the acceleration limit, the constant acceleration phase is dropped.
+ */
+static void Build_Ramp_Shape(float Peak_Velocity, float Acceleration, float Jerk, Ramp_Shape_t *Shape)
+{
+    Shape->Peak_Velocity = Peak_Velocity;
+    Shape->Jerk = Jerk;
+
+    if (Jerk <= 0.0f) // Trapezoidal ramp
+    {
+        Shape->Acceleration = Acceleration;
+        Shape->Jerk_Time = 0.0f;
+        Shape->Const_Time = Peak_Velocity / Acceleration;
+    }
+    else if ((Peak_Velocity * Jerk) >= (Acceleration * Acceleration)) // Acceleration limit is reached
+    {
+        Shape->Acceleration = Acceleration;
+        Shape->Jerk_Time = Acceleration / Jerk;
+        Shape->Const_Time = (Peak_Velocity / Acceleration) - Shape->Jerk_Time;
+    }
+    else // Pure S ramp, acceleration limit never reached
+    {
+        Shape->Jerk_Time = sqrtf(Peak_Velocity / Jerk);
+        Shape->Acceleration = Jerk * Shape->Jerk_Time;
+        Shape->Const_Time = 0.0f;
+    }
+
+    Shape->Duration = (2.0f * Shape->Jerk_Time) + Shape->Const_Time;
+    Shape->Distance = (Peak_Velocity * Shape->Duration) / 2.0f; // Ramp is point symmetric around its midpoint
+}
+
+/**
+ * @brief Position reached after the given time on the ramp.
+ */
+static float Ramp_Position(const Ramp_Shape_t *Shape, float Time)
+{
+    float Jerk_End = Shape->Jerk_Time;
+    float Const_End = Shape->Jerk_Time + Shape->Const_Time;
+
+    if (Time <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    if (Time >= Shape->Duration)
+    {
+        return Shape->Distance;
+    }
+
+    if (Time <= Jerk_End) // Jerk up phase
+    {
+        return (Shape->Jerk * Time * Time * Time) / 6.0f;
+    }
+
+    if (Time <= Const_End) // Constant acceleration phase
+    {
+        float Start_Position = (Shape->Jerk * Jerk_End * Jerk_End * Jerk_End) / 6.0f;
+        float Start_Velocity = (Shape->Acceleration * Jerk_End) / 2.0f;
+        float Elapsed = Time - Jerk_End;
+
+        return Start_Position + (Start_Velocity * Elapsed) + ((Shape->Acceleration * Elapsed * Elapsed) / 2.0f);
+    }
+
+    // Jerk down phase, mirrored from the end of the ramp
+    float Remaining = Shape->Duration - Time;
+
+    return Shape->Distance - ((Shape->Peak_Velocity * Remaining) - ((Shape->Jerk * Remaining * Remaining * Remaining) / 6.0f));
+}
+
+/**
+ * @brief Find the highest S-curve peak velocity whose accel and decel ramps fit in the given steps.
+ */
+static float Fit_Peak_Velocity(const Motion_Planner_Config_t *Config, uint32_t Steps)
+{
+    Ramp_Shape_t Shape;
+    float Half_Distance = Steps / 2.0f;
+
+    Build_Ramp_Shape((float)Config->Max_Frequency_Hz, (float)Config->Acceleration, (float)Config->Jerk, &Shape);
+
+    if (Shape.Distance <= Half_Distance) // Cruise speed is reachable
+    {
+        return Shape.Peak_Velocity;
+    }
+
+    // Ramp distance grows monotonically with the peak velocity, so bisect it
+    float Low = 0.0f;
+    float High = Shape.Peak_Velocity;
+
+    for (uint8_t Iteration = 0; Iteration < 24; Iteration++)
+    {
+        float Middle = (Low + High) / 2.0f;
+
+        Build_Ramp_Shape(Middle, (float)Config->Acceleration, (float)Config->Jerk, &Shape);
+
+        if (Shape.Distance <= Half_Distance)
+        {
+            Low = Middle;
+        }
+        else
+        {
+            High = Middle;
+        }
+    }
+
+    return Low;
+}
+
+/**
+ * @brief Cut one ramp into equal time slices of constant frequency.
+ *
+ * Slices that would not contain a single step are merged into the next one,
+ * so every emitted segment has at least one step.
+ *
+ * @param Shape Ramp timing.
+ * @param Ramp_Steps Exact number of steps the ramp has to cover.
+ * @param Segment_Time_us Nominal slice duration.
+ * @param Segments Output table, at least MOTION_PLANNER_MAX_RAMP_SEGMENTS entries.
+ * @return Number of segments written.
+ */
+static uint16_t Build_Ramp_Segments(const Ramp_Shape_t *Shape, uint32_t Ramp_Steps, uint32_t Segment_Time_us, Motion_Segment_t *Segments)
+{
+    uint16_t Segment_Count = 0;
+
+    if ((Ramp_Steps == 0) || (Shape->Duration <= 0.0f))
+    {
+        return 0;
+    }
+
+    uint32_t Slices = (uint32_t)ceilf((Shape->Duration * 1000000.0f) / Segment_Time_us); // Number of nominal slices in the ramp
+
+    if (Slices == 0)
+    {
+        Slices = 1;
+    }
+
+    if (Slices > MOTION_PLANNER_MAX_RAMP_SEGMENTS)
+    {
+        Slices = MOTION_PLANNER_MAX_RAMP_SEGMENTS; // Long ramps use longer slices
+    }
+
+    float Slice_Time = Shape->Duration / Slices; // Equal slices, no short remainder slice
+    float Scale = Ramp_Steps / Shape->Distance;  // Map the ideal distance onto the integer step count
+    uint32_t Previous_Position = 0;
+    float Pending_Time = 0.0f;
+
+    for (uint32_t Slice = 1; Slice <= Slices; Slice++)
+    {
+        uint32_t Position = (Slice == Slices) ? Ramp_Steps : (uint32_t)lroundf(Ramp_Position(Shape, Slice * Slice_Time) * Scale);
+
+        Pending_Time += Slice_Time;
+
+        if (Position <= Previous_Position)
+        {
+            continue; // No step in this slice, carry its time into the next one
+        }
+
+        uint32_t Steps = Position - Previous_Position;
+        uint32_t Frequency = (uint32_t)lroundf(Steps / Pending_Time);
+
+        Segments[Segment_Count].Frequency_Hz = (Frequency > 0) ? Frequency : 1;
+        Segments[Segment_Count].Steps = Steps;
+        Segment_Count++;
+
+        Previous_Position = Position;
+        Pending_Time = 0.0f;
+    }
+
+    return Segment_Count;
+}
+
+/**
+ * @brief Cut a constant acceleration ramp between two frequencies into equal time slices.
+ *
+ * Same slicing as Build_Ramp_Segments(), in integer math. The ramp lasts
+ * 2 * Ramp_Steps / (Start + End) seconds, and slice k of S ends at the
+ * position Ramp_Steps * (Start * (2kS - k^2) + End * k^2) / ((Start + End) * S^2).
+ * A decelerating ramp passes an End_Frequency_Hz lower than the
+ * Start_Frequency_Hz.
+ *
+ * @param Start_Frequency_Hz Frequency at the start of the ramp.
+ * @param End_Frequency_Hz Frequency at the end of the ramp.
+ * @param Ramp_Steps Exact number of steps the ramp has to cover.
+ * @param Segment_Time_us Nominal slice duration.
+ * @param Segments Output table, at least MOTION_PLANNER_MAX_RAMP_SEGMENTS entries.
+ * @return Number of segments written.
+ */
+uint16_t Motion_Planner_Build_Linear_Ramp(uint32_t Start_Frequency_Hz, uint32_t End_Frequency_Hz, uint32_t Ramp_Steps, uint32_t Segment_Time_us, Motion_Segment_t *Segments)
+{
+    uint16_t Segment_Count = 0;
+    uint64_t Frequency_Sum = (uint64_t)Start_Frequency_Hz + End_Frequency_Hz; // Twice the average frequency
+
+    if ((Ramp_Steps == 0) || (Frequency_Sum == 0) || (Segment_Time_us == 0))
+    {
+        return 0;
+    }
+
+    uint64_t Duration_Numerator = 2ULL * Ramp_Steps * 1000000ULL;                      // Ramp duration in us times Frequency_Sum
+    uint64_t Slice_Denominator = Motion_Math_Mul_Sat(Frequency_Sum, Segment_Time_us); // Nominal slice duration times Frequency_Sum
+    uint64_t Slices = (Duration_Numerator / Slice_Denominator) + (((Duration_Numerator % Slice_Denominator) != 0) ? 1 : 0); // Number of nominal slices in the ramp
+
+    if (Slices == 0)
+    {
+        Slices = 1;
+    }
+
+    if (Slices > MOTION_PLANNER_MAX_RAMP_SEGMENTS)
+    {
+        Slices = MOTION_PLANNER_MAX_RAMP_SEGMENTS; // Long ramps use longer slices
+    }
+
+    uint64_t Position_Divisor = Frequency_Sum * Slices * Slices;
+    uint32_t Previous_Position = 0;
+    uint32_t Pending_Slices = 0;
+
+    for (uint32_t Slice = 1; Slice <= Slices; Slice++)
+    {
+        uint64_t Weight = ((uint64_t)Start_Frequency_Hz * ((2ULL * Slice * Slices) - ((uint64_t)Slice * Slice))) + ((uint64_t)End_Frequency_Hz * Slice * Slice);
+        uint32_t Position = (Slice == Slices) ? Ramp_Steps : (uint32_t)Motion_Math_Mul_Div_Round(Ramp_Steps, Weight, Position_Divisor);
+
+        Pending_Slices++;
+
+        if (Position <= Previous_Position)
+        {
+            continue; // No step in this slice, carry its time into the next one
+        }
+
+        // One slice lasts 2 * Ramp_Steps / (Frequency_Sum * Slices) seconds
+        uint32_t Steps = Position - Previous_Position;
+        uint64_t Frequency = Motion_Math_Mul_Div_Round((uint64_t)Steps * Slices, Frequency_Sum, 2ULL * Pending_Slices * Ramp_Steps);
+
+        if (Frequency > UINT32_MAX)
+        {
+            Frequency = UINT32_MAX;
+        }
+
+        Segments[Segment_Count].Frequency_Hz = (Frequency > 0) ? (uint32_t)Frequency : 1;
+        Segments[Segment_Count].Steps = Steps;
+        Segment_Count++;
+
+        Previous_Position = Position;
+        Pending_Slices = 0;
+    }
+
+    return Segment_Count;
+}
+
+/**
+ * @brief Steps a constant acceleration ramp from standstill to the given frequency covers.
+ *
+ * @param Frequency_Hz Frequency at the end of the ramp.
+ * @param Acceleration Acceleration (steps/s^2), not 0.
+ * @return v^2 / 2a rounded to the nearest step.
+ */
+uint32_t Motion_Planner_Ramp_Steps(uint32_t Frequency_Hz, uint32_t Acceleration)
+{
+    uint64_t Ramp_Steps = Motion_Math_Mul_Div_Round(Frequency_Hz, Frequency_Hz, 2ULL * Acceleration);
+
+    return (Ramp_Steps > UINT32_MAX) ? UINT32_MAX : (uint32_t)Ramp_Steps;
+}
+
+/**
+ * @brief Build a trapezoidal accel ramp from standstill, from a generated table if there is one.
+ *
+ * A table is only used if it was generated for the same acceleration,
+ * frequency, slice duration and step count, so the result is always the
+ * same as that of Motion_Planner_Build_Linear_Ramp().
+ */
+static uint16_t Build_Accel_Ramp(const Motion_Planner_Config_t *Config, uint32_t Frequency_Hz, uint32_t Ramp_Steps, Motion_Segment_t *Segments)
+{
+    for (uint16_t Index = 0; Index < Motion_Ramp_Table_Count; Index++)
+    {
+        const Motion_Ramp_Table_t *Table = &Motion_Ramp_Tables[Index];
+
+        if ((Table->Acceleration == Config->Acceleration) && (Table->Frequency_Hz == Frequency_Hz) && (Table->Segment_Time_us == Config->Segment_Time_us) && (Table->Ramp_Steps == Ramp_Steps))
+        {
+            memcpy(Segments, Table->Segments, Table->Segment_Count * sizeof(Motion_Segment_t));
+
+            return Table->Segment_Count;
+        }
+    }
+
+    return Motion_Planner_Build_Linear_Ramp(0, Frequency_Hz, Ramp_Steps, Config->Segment_Time_us, Segments);
+}
+
+/**
+ * @brief Check the planner configuration for values that cannot produce a profile.
+ */
+static bool Config_Is_Valid(const Motion_Planner_Config_t *Config)
+{
+    return (Config != NULL) && (Config->Max_Frequency_Hz > 0) && (Config->Acceleration > 0) && (Config->Segment_Time_us > 0);
+}
+
+/**
+ * @brief Fill in the totals of a finished profile.
+ *
+ * Used by the planner and by callers that assemble a profile from stored
+ * segments, e.g. the ramp cache.
+ *
+ * @param Profile Profile with its segments and phase counts set.
+ */
+void Motion_Planner_Finish_Profile(Motion_Profile_t *Profile)
+{
+    Profile->Segment_Count = Profile->Accel_Segments + Profile->Cruise_Segments + Profile->Decel_Segments;
+    Profile->Total_Steps = 0;
+    Profile->Duration_us = 0;
+
+    for (uint16_t Index = 0; Index < Profile->Segment_Count; Index++)
+    {
+        Profile->Total_Steps += Profile->Segments[Index].Steps;
+        Profile->Duration_us += Motion_Segment_Duration_us(&Profile->Segments[Index]);
+
+        if (Profile->Segments[Index].Frequency_Hz > Profile->Peak_Frequency_Hz)
+        {
+            Profile->Peak_Frequency_Hz = Profile->Segments[Index].Frequency_Hz;
+        }
+    }
+}
+
+/**
+ * @brief Plan a move of a fixed number of steps.
+ *
+ * The profile accelerates towards Max_Frequency_Hz, cruises and decelerates
+ * back to standstill. If the move is too short to reach the cruise speed the
+ * peak velocity is lowered so the accel and decel ramps meet in the middle.
+ *
+ * @param Config Motion limits.
+ * @param Steps Number of steps to move.
+ * @param Profile Output profile.
+ * @return true if a profile was produced, false if the configuration is invalid.
+ */
+bool Motion_Planner_Plan_Move(const Motion_Planner_Config_t *Config, uint32_t Steps, Motion_Profile_t *Profile)
+{
+    if (!Config_Is_Valid(Config) || (Profile == NULL))
+    {
+        return false;
+    }
+
+    memset(Profile, 0, sizeof(*Profile));
+
+    if (Steps == 0)
+    {
+        return true; // Nothing to move
+    }
+
+    Ramp_Shape_t Shape = {0};
+    uint32_t Peak_Frequency = 0;
+    uint32_t Ramp_Steps = 0; // Steps in each of the accel and decel ramps
+
+    if (Config->Jerk == 0) // Trapezoid, a triangle if the ramps meet at v^2 = a * Steps
+    {
+        uint64_t Meet_Squared = Motion_Math_Mul_Sat(Config->Acceleration, Steps);
+
+        Peak_Frequency = (((uint64_t)Config->Max_Frequency_Hz * Config->Max_Frequency_Hz) <= Meet_Squared) ? Config->Max_Frequency_Hz : Motion_Math_Isqrt(Meet_Squared);
+        Ramp_Steps = Motion_Planner_Ramp_Steps(Peak_Frequency, Config->Acceleration);
+    }
+    else
+    {
+        float Peak_Velocity = Fit_Peak_Velocity(Config, Steps);
+
+        Build_Ramp_Shape(Peak_Velocity, (float)Config->Acceleration, (float)Config->Jerk, &Shape);
+
+        Peak_Frequency = (uint32_t)lroundf(Peak_Velocity);
+        Ramp_Steps = (uint32_t)lroundf(Shape.Distance);
+    }
+
+    if (Ramp_Steps > (Steps / 2))
+    {
+        Ramp_Steps = Steps / 2;
+    }
+
+    if (Config->Jerk == 0)
+    {
+        Profile->Accel_Segments = Build_Accel_Ramp(Config, Peak_Frequency, Ramp_Steps, Profile->Segments);
+    }
+    else
+    {
+        Profile->Accel_Segments = Build_Ramp_Segments(&Shape, Ramp_Steps, Config->Segment_Time_us, Profile->Segments);
+    }
+
+    uint32_t Cruise_Steps = Steps - (2 * Ramp_Steps);
+
+    if (Cruise_Steps > 0)
+    {
+        Profile->Segments[Profile->Accel_Segments].Frequency_Hz = (Peak_Frequency > 0) ? Peak_Frequency : 1;
+        Profile->Segments[Profile->Accel_Segments].Steps = Cruise_Steps;
+        Profile->Cruise_Segments = 1;
+    }
+
+    // Decel ramp is the accel ramp played backwards
+    uint16_t Decel_Start = Profile->Accel_Segments + Profile->Cruise_Segments;
+
+    for (uint16_t Index = 0; Index < Profile->Accel_Segments; Index++)
+    {
+        Profile->Segments[Decel_Start + Index] = Profile->Segments[Profile->Accel_Segments - 1 - Index];
+    }
+
+    Profile->Decel_Segments = Profile->Accel_Segments;
+
+    Motion_Planner_Finish_Profile(Profile);
+
+    return true;
+}
+
+/**
+ * @brief Plan one block of a continuous path with given entry and exit frequencies.
+ *
+ * Used for look-ahead planned paths, where consecutive blocks join without
+ * stopping. The block accelerates from the entry frequency towards
+ * Max_Frequency_Hz, cruises and decelerates to the exit frequency. Blocks
+ * always use trapezoidal ramps, the jerk limit is not applied.
+ *
+ * @param Config Motion limits, Max_Frequency_Hz is the nominal frequency of the block.
+ * @param Steps Number of steps of the block.
+ * @param Entry_Frequency_Hz Frequency at the start of the block.
+ * @param Exit_Frequency_Hz Frequency at the end of the block.
+ * @param Profile Output profile.
+ * @return true if a profile was produced, false if the configuration is invalid.
+ */
+bool Motion_Planner_Plan_Block(const Motion_Planner_Config_t *Config, uint32_t Steps, uint32_t Entry_Frequency_Hz, uint32_t Exit_Frequency_Hz, Motion_Profile_t *Profile)
+{
+    if (!Config_Is_Valid(Config) || (Profile == NULL))
+    {
+        return false;
+    }
+
+    memset(Profile, 0, sizeof(*Profile));
+
+    if (Steps == 0)
+    {
+        return true; // Nothing to move
+    }
+
+    uint64_t Two_Acceleration = 2ULL * Config->Acceleration;
+    uint32_t Peak_Frequency = Config->Max_Frequency_Hz;
+    uint32_t Entry_Frequency = (Entry_Frequency_Hz < Peak_Frequency) ? Entry_Frequency_Hz : Peak_Frequency;
+    uint32_t Exit_Frequency = (Exit_Frequency_Hz < Peak_Frequency) ? Exit_Frequency_Hz : Peak_Frequency;
+    uint64_t Peak_Squared = (uint64_t)Peak_Frequency * Peak_Frequency;
+    uint64_t Entry_Squared = (uint64_t)Entry_Frequency * Entry_Frequency;
+    uint64_t Exit_Squared = (uint64_t)Exit_Frequency * Exit_Frequency;
+    uint64_t Accel_Distance = Peak_Squared - Entry_Squared;                 // Accel ramp steps times 2a
+    uint64_t Decel_Distance = Peak_Squared - Exit_Squared;                  // Decel ramp steps times 2a
+    uint64_t Block_Distance = Motion_Math_Mul_Sat(Two_Acceleration, Steps); // Block steps times 2a
+
+    bool Ramps_Meet = (Accel_Distance > Block_Distance) || (Decel_Distance > (Block_Distance - Accel_Distance));
+
+    if (Ramps_Meet) // Cruise speed is not reached, ramps meet at a lower peak
+    {
+        // v^2 = (2a * Steps + Entry^2 + Exit^2) / 2, below the cruise speed so it fits 64 bits
+        Peak_Squared = (Block_Distance / 2) + (Entry_Squared / 2) + (Exit_Squared / 2);
+        Peak_Frequency = Motion_Math_Isqrt(Peak_Squared);
+        Peak_Frequency = (Peak_Frequency > Entry_Frequency) ? Peak_Frequency : Entry_Frequency;
+        Peak_Frequency = (Peak_Frequency > Exit_Frequency) ? Peak_Frequency : Exit_Frequency;
+        Peak_Squared = (uint64_t)Peak_Frequency * Peak_Frequency;
+        Accel_Distance = Peak_Squared - Entry_Squared;
+    }
+
+    uint64_t Accel_Ramp = Motion_Math_Mul_Div_Round(Accel_Distance, 1, Two_Acceleration);
+    uint64_t Decel_Ramp = Motion_Math_Mul_Div_Round(Decel_Distance, 1, Two_Acceleration);
+    uint32_t Accel_Steps = (Accel_Ramp < Steps) ? (uint32_t)Accel_Ramp : Steps;
+    uint32_t Decel_Steps = Steps - Accel_Steps; // The decel ramp takes the rest of the block if the ramps meet
+
+    if (!Ramps_Meet && (Decel_Ramp < Decel_Steps))
+    {
+        Decel_Steps = (uint32_t)Decel_Ramp;
+    }
+
+    Profile->Accel_Segments = Motion_Planner_Build_Linear_Ramp(Entry_Frequency, Peak_Frequency, Accel_Steps, Config->Segment_Time_us, Profile->Segments);
+
+    uint32_t Cruise_Steps = Steps - Accel_Steps - Decel_Steps;
+
+    if (Cruise_Steps > 0)
+    {
+        Profile->Segments[Profile->Accel_Segments].Frequency_Hz = (Peak_Frequency > 0) ? Peak_Frequency : 1;
+        Profile->Segments[Profile->Accel_Segments].Steps = Cruise_Steps;
+        Profile->Cruise_Segments = 1;
+    }
+
+    Profile->Decel_Segments = Motion_Planner_Build_Linear_Ramp(Peak_Frequency, Exit_Frequency, Decel_Steps, Config->Segment_Time_us, &Profile->Segments[Profile->Accel_Segments + Profile->Cruise_Segments]);
+
+    Motion_Planner_Finish_Profile(Profile);
+
+    return true;
+}
+
+/**
+ * @brief Plan a ramp to Max_Frequency_Hz that is then held until the motor is stopped.
+ *
+ * The last segment is the cruise segment with a step count of 0, meaning it
+ * has no planned end.
+ *
+ * @param Config Motion limits.
+ * @param Profile Output profile.
+ * @return true if a profile was produced, false if the configuration is invalid.
+ */
+bool Motion_Planner_Plan_Ramp(const Motion_Planner_Config_t *Config, Motion_Profile_t *Profile)
+{
+    if (!Config_Is_Valid(Config) || (Profile == NULL))
+    {
+        return false;
+    }
+
+    memset(Profile, 0, sizeof(*Profile));
+
+    if (Config->Jerk == 0)
+    {
+        Profile->Accel_Segments = Build_Accel_Ramp(Config, Config->Max_Frequency_Hz, Motion_Planner_Ramp_Steps(Config->Max_Frequency_Hz, Config->Acceleration), Profile->Segments);
+    }
+    else
+    {
+        Ramp_Shape_t Shape;
+
+        Build_Ramp_Shape((float)Config->Max_Frequency_Hz, (float)Config->Acceleration, (float)Config->Jerk, &Shape);
+
+        Profile->Accel_Segments = Build_Ramp_Segments(&Shape, (uint32_t)lroundf(Shape.Distance), Config->Segment_Time_us, Profile->Segments);
+    }
+
+    Profile->Segments[Profile->Accel_Segments].Frequency_Hz = Config->Max_Frequency_Hz;
+    Profile->Segments[Profile->Accel_Segments].Steps = 0;
+    Profile->Cruise_Segments = 1;
+    Profile->Continuous = true;
+
+    Motion_Planner_Finish_Profile(Profile);
+
+    return true;
+}
+
+/**
+ * @brief Plan a stop from a running frequency at a fixed deceleration.
+ *
+ * The profile is a single decel ramp from Frequency_Hz to standstill over
+ * v^2 / 2a steps. It is empty if the motor is slow enough to stop at once.
+ *
+ * @param Frequency_Hz Frequency the motor runs at.
+ * @param Deceleration Deceleration limit (steps/s^2), not 0.
+ * @param Segment_Time_us Nominal duration of one ramp segment.
+ * @param Profile Output profile.
+ * @return true if a profile was produced, false if the limits are invalid.
+ */
+bool Motion_Planner_Plan_Stop(uint32_t Frequency_Hz, uint32_t Deceleration, uint32_t Segment_Time_us, Motion_Profile_t *Profile)
+{
+    if ((Deceleration == 0) || (Segment_Time_us == 0) || (Profile == NULL))
+    {
+        return false;
+    }
+
+    memset(Profile, 0, sizeof(*Profile));
+
+    Profile->Decel_Segments = Motion_Planner_Build_Linear_Ramp(Frequency_Hz, 0, Motion_Planner_Ramp_Steps(Frequency_Hz, Deceleration), Segment_Time_us, Profile->Segments);
+
+    Motion_Planner_Finish_Profile(Profile);
+
+    return true;
+}
+
+/**
+ * @brief Time needed to emit all steps of a segment.
+ *
+ * @param Segment Segment to measure.
+ * @return Duration in microseconds, 0 for a held (open ended) segment.
+ */
+uint32_t Motion_Segment_Duration_us(const Motion_Segment_t *Segment)
+{
+    if ((Segment->Frequency_Hz == 0) || (Segment->Steps == 0))
+    {
+        return 0;
+    }
+
+    return (uint32_t)((((uint64_t)Segment->Steps * 1000000ULL) + (Segment->Frequency_Hz / 2)) / Segment->Frequency_Hz);
+}
@@ -0,0 +1,67 @@
+/*H**********************************************************************
+ * FILENAME :        motion_planner.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent motion planner for the stepper motor example.
+ *       Builds trapezoidal and S-curve velocity profiles as a table of
+ *       constant frequency segments for the accel, cruise and decel phases.
+ *
+ * NOTES :
+ *       This module only depends on the C standard library so it can be
+ *       compiled and exercised on a Linux host as well as on the ESP32.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTION_PLANNER_H
+#define MOTION_PLANNER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MOTION_PLANNER_MAX_RAMP_SEGMENTS 64                                      // Maximum number of segments used for one ramp (accel or decel)
+#define MOTION_PROFILE_MAX_SEGMENTS ((2 * MOTION_PLANNER_MAX_RAMP_SEGMENTS) + 1) // Accel + cruise + decel
+
+/** One constant frequency piece of a planned move */
+typedef struct
+{
+    uint32_t Frequency_Hz; // Step frequency held during this segment
+    uint32_t Steps;        // Number of steps emitted at this frequency
+} Motion_Segment_t;
+
+/** Motion limits used to build a profile */
+typedef struct
+{
+    uint32_t Max_Frequency_Hz; // Cruise step frequency (steps/s)
+    uint32_t Acceleration;     // Acceleration limit (steps/s^2)
+    uint32_t Jerk;             // Jerk limit (steps/s^3), 0 selects a trapezoidal profile
+    uint32_t Segment_Time_us;  // Nominal duration of one ramp segment
+} Motion_Planner_Config_t;
+
+/** Precomputed step frequency table for one move */
+typedef struct
+{
+    Motion_Segment_t Segments[MOTION_PROFILE_MAX_SEGMENTS]; // Accel segments, optional cruise segment, decel segments
+    uint16_t Segment_Count;                                 // Number of valid entries in Segments
+    uint16_t Accel_Segments;                                // Number of segments in the accel phase
+    uint16_t Cruise_Segments;                               // Number of segments in the cruise phase (0 or 1)
+    uint16_t Decel_Segments;                                // Number of segments in the decel phase
+    uint32_t Total_Steps;                                   // Sum of all segment steps
+    uint32_t Peak_Frequency_Hz;                             // Highest frequency reached by the profile
+    uint32_t Duration_us;                                   // Planned duration of the whole profile
+    bool Continuous;                                        // True if the cruise segment is held until stopped
+} Motion_Profile_t;
+
+bool Motion_Planner_Plan_Move(const Motion_Planner_Config_t *Config, uint32_t Steps, Motion_Profile_t *Profile);
+bool Motion_Planner_Plan_Block(const Motion_Planner_Config_t *Config, uint32_t Steps, uint32_t Entry_Frequency_Hz, uint32_t Exit_Frequency_Hz, Motion_Profile_t *Profile);
+bool Motion_Planner_Plan_Ramp(const Motion_Planner_Config_t *Config, Motion_Profile_t *Profile);
+bool Motion_Planner_Plan_Stop(uint32_t Frequency_Hz, uint32_t Deceleration, uint32_t Segment_Time_us, Motion_Profile_t *Profile);
+uint16_t Motion_Planner_Build_Linear_Ramp(uint32_t Start_Frequency_Hz, uint32_t End_Frequency_Hz, uint32_t Ramp_Steps, uint32_t Segment_Time_us, Motion_Segment_t *Segments);
+uint32_t Motion_Planner_Ramp_Steps(uint32_t Frequency_Hz, uint32_t Acceleration);
+void Motion_Planner_Finish_Profile(Motion_Profile_t *Profile);
+uint32_t Motion_Segment_Duration_us(const Motion_Segment_t *Segment);
+
+#endif // MOTION_PLANNER_H
@@ -0,0 +1,654 @@
+/*H**********************************************************************
+ * FILENAME :        motion_queue.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Asynchronous motion command queue for the stepper motor example.
+ *
+ * NOTES :
+ *       Only the motion task touches the motor driver functions. Other
+ *       tasks talk to it through the queue, or through
+ *       Abort_Stepper_Motor() which is safe to call from any task, or
+ *       through Motion_Queue_Stop() which is safe from interrupts too.
+ *
+ *       The motion task is pinned to the APP CPU, so the console, its UART
+ *       and heap traffic on the PRO CPU do not delay segment changes.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdlib.h>
+#include "motion_queue.h"
+#include "esp_timer.h"
+#include "motion_math.h"
+#include "main.h"
+#include "homing.h"
+#include "trajectory_player.h"
+
+static QueueHandle_t Motion_Queue = NULL;                       // Commands waiting for the motion task
+static TaskHandle_t Motion_Task_Handle = NULL;                  // Motion task
+static Motion_Queue_Status_t Motion_Status;                     // State reported by Motion_Queue_Get_Status()
+static uint32_t Next_Command_Id = 1;                            // Id given to the next queued command
+static portMUX_TYPE Status_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards Motion_Status and Next_Command_Id
+static bool Hold_Enabled = false;                               // Driver stays enabled while idle, set by MOTION_COMMAND_ENABLE
+static bool Path_Stopped = true;                                // True unless the last block ended at a non-zero frequency
+static int32_t Jog_Target_Hz = 0;                               // Latest jog set-point, guarded by Status_Lock
+static bool Jog_Requested = false;                              // Jog command queued or jog loop running, guarded by Status_Lock
+static int64_t Command_Start_us = 0;                            // Start of the command being executed, guarded by Status_Lock
+
+/**
+ * @brief Execute one block of a look-ahead planned path.
+ *
+ * A block may only end at speed if the next block is already queued, since
+ * nothing would take over the motion otherwise. If it is not, the block is
+ * brought to a stop instead, and the next block starts from standstill with
+ * its exit lowered to what it can reach from there. Lowering speeds never
+ * makes the planned deceleration of later blocks infeasible.
+ */
+static esp_err_t Execute_Motion_Block(const Motion_Command_t *Command, uint32_t *Executed_Steps)
+{
+    uint32_t Entry_Frequency = Command->Entry_Frequency_Hz;
+    uint32_t Exit_Frequency = Command->Exit_Frequency_Hz;
+
+    if (Path_Stopped)
+    {
+        uint32_t Major_Steps = 0;
+
+        for (uint8_t Axis = 0; Axis < DDA_MAX_AXES; Axis++)
+        {
+            uint32_t Abs_Steps = (uint32_t)abs(Command->Axis_Steps[Axis]);
+
+            Major_Steps = (Abs_Steps > Major_Steps) ? Abs_Steps : Major_Steps;
+        }
+
+        uint32_t Reachable = Motion_Math_Isqrt(2ULL * Command->Acceleration * Major_Steps); // Fastest exit from standstill
+
+        Entry_Frequency = 0;
+        Exit_Frequency = (Exit_Frequency < Reachable) ? Exit_Frequency : Reachable;
+    }
+
+    if (uxQueueMessagesWaiting(Motion_Queue) == 0)
+    {
+        Exit_Frequency = 0; // No next block to continue with
+    }
+
+    esp_err_t Function_Error = Move_Stepper_Axes_Block(Command->Axis_Steps, Command->Frequency_Hz, Entry_Frequency, Exit_Frequency, Command->Acceleration, Executed_Steps);
+
+    Path_Stopped = (Exit_Frequency == 0) || (Function_Error != ESP_OK);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Ramp the running motor to a velocity under the acceleration limit, see Set_Stepper_Motor_Limits().
+ *
+ * Used by the jog mode and by a run command while the motor is already
+ * running, neither stops the motor first. With Streamed set the target is
+ * the jog set-point, re-read on every update, and the ramp ends at
+ * standstill once the set-point is 0 or another command is waiting. Without
+ * it the ramp ends when the fixed target is reached. A stop request ends
+ * the ramp right away, the caller decelerates.
+ *
+ * @param Streamed Follow the jog set-point instead of Target_Hz.
+ * @param Target_Hz Signed target frequency when not streamed.
+ * @param PWM_Duty_Cycle The PWM duty cycle of the step pulses.
+ * @return Result of Set_Stepper_Motor_Velocity(), ESP_OK if aborted.
+ */
+static esp_err_t Ramp_To_Velocity(bool Streamed, int32_t Target_Hz, uint32_t PWM_Duty_Cycle)
+{
+    esp_err_t Function_Error = ESP_OK;
+    Velocity_Ramp_t Ramp;
+    TickType_t Last_Update = xTaskGetTickCount();
+    bool Done = false;
+    uint32_t Max_Frequency_Hz = 0;
+    uint32_t Acceleration = 0;
+
+    Get_Stepper_Motor_Limits(&Max_Frequency_Hz, &Acceleration); // Ramped like the planned moves
+
+    Velocity_Ramp_Begin(&Ramp, Get_Stepper_Motor_Velocity(), Acceleration, MOTION_JOG_MIN_FREQUENCY_HZ);
+
+    while (!Done)
+    {
+        vTaskDelay(1); // One update per RTOS tick
+
+        TickType_t Now = xTaskGetTickCount();
+        int32_t Target = Target_Hz;
+
+        if (Stepper_Motor_Abort_Requested())
+        {
+            break; // Abort_Stepper_Motor() already stopped the output
+        }
+
+        if (Stepper_Motor_Stop_Requested() != 0)
+        {
+            break; // Decelerate_Stepper_Motor() ramps down at the requested deceleration
+        }
+
+        if (Streamed)
+        {
+            portENTER_CRITICAL(&Status_Lock);
+            Target = Jog_Target_Hz;
+            portEXIT_CRITICAL(&Status_Lock);
+
+            Target = (uxQueueMessagesWaiting(Motion_Queue) > 0) ? 0 : Target; // Stop for the next command
+        }
+
+        int32_t Velocity = Velocity_Ramp_Update(&Ramp, Target, (uint32_t)(Now - Last_Update) * MOTION_SEGMENT_TIME_US);
+
+        Last_Update = Now;
+
+        Function_Error = Set_Stepper_Motor_Velocity(Velocity, PWM_Duty_Cycle);
+
+        portENTER_CRITICAL(&Status_Lock);
+        Motion_Status.Velocity_Hz = Get_Stepper_Motor_Velocity(); // Outside the resonance bands, see Motor_Resonance_Snap()
+
+        if (Function_Error != ESP_OK)
+        {
+            Done = true;
+        }
+        else if (!Streamed)
+        {
+            Done = (Velocity == Target);
+        }
+        else if ((Velocity == 0) && ((Jog_Target_Hz == 0) || (uxQueueMessagesWaiting(Motion_Queue) > 0)))
+        {
+            Done = true; // Checked under the lock, a new set-point either arrives before or queues a new jog command
+        }
+        portEXIT_CRITICAL(&Status_Lock);
+    }
+
+    if (Stepper_Motor_Abort_Requested())
+    {
+        Stop_Stepper_Motor();
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Follow the jog set-point until the jog mode ends.
+ *
+ * @param Executed_Steps Returns the steps emitted by the jog, see Decelerate_Stepper_Motor().
+ */
+static esp_err_t Execute_Jog(uint32_t *Executed_Steps)
+{
+    portENTER_CRITICAL(&Status_Lock);
+    Motion_Status.Jogging = true;
+    portEXIT_CRITICAL(&Status_Lock);
+
+    esp_err_t Function_Error = Ramp_To_Velocity(true, 0, PWM_DUTY_CYCLE_50);
+
+    Function_Error += Decelerate_Stepper_Motor(Executed_Steps); // Stands still already unless a stop was requested
+
+    portENTER_CRITICAL(&Status_Lock);
+    Motion_Status.Jogging = false;
+    Motion_Status.Velocity_Hz = Get_Stepper_Motor_Velocity();
+    Jog_Requested = false;
+    portEXIT_CRITICAL(&Status_Lock);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Execute one motion command.
+ *
+ * @param Command Command to execute.
+ * @param Driver_Enabled Tracks whether the driver is left enabled.
+ * @param Executed_Steps Returns the steps emitted by a move, or the ticks of an interpolated move.
+ * @return Result of the motor driver call.
+ */
+static esp_err_t Execute_Motion_Command(const Motion_Command_t *Command, bool *Driver_Enabled, uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    *Executed_Steps = 0;
+
+    if (Command->Type != MOTION_COMMAND_BLOCK)
+    {
+        Path_Stopped = true; // Any other command ends a continuous path
+    }
+
+    if (Motion_Status.Running && (Command->Type != MOTION_COMMAND_RUN) && (Command->Type != MOTION_COMMAND_JOG) && (Command->Type != MOTION_COMMAND_STOP))
+    {
+        Decelerate_Stepper_Motor(NULL); // Leave continuous mode before any other command
+        Stop_Stepper_Motor();
+
+        *Driver_Enabled = false;
+    }
+
+    switch (Command->Type)
+    {
+    case MOTION_COMMAND_MOVE:
+        Function_Error = Move_Stepper_Motor(Command->Frequency_Hz, Command->Direction, Command->Steps, Executed_Steps);
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_RUN:
+        if (Get_Stepper_Motor_Velocity() != 0)
+        {
+            int32_t Velocity = (Command->Direction == MOTOR_DIRECTION_FORWARD) ? (int32_t)Command->Frequency_Hz : -(int32_t)Command->Frequency_Hz;
+
+            Velocity = (Command->Frequency_Hz < MOTION_JOG_MIN_FREQUENCY_HZ) ? 0 : Velocity; // Too slow to run, the ramp stops instead
+
+            Function_Error = Ramp_To_Velocity(false, Velocity, Command->Duty_Cycle); // Already running, change speed from the current one
+
+            if ((Velocity == 0) || (Stepper_Motor_Stop_Requested() != 0))
+            {
+                Function_Error += Decelerate_Stepper_Motor(Executed_Steps); // Ramped to standstill, or a stop was requested
+            }
+        }
+        else
+        {
+            Function_Error = Start_Stepper_Motor(Command->Direction, Command->Frequency_Hz, Command->Duty_Cycle);
+        }
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_JOG:
+        Function_Error = Execute_Jog(Executed_Steps);
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_MOVE_TO:
+        Function_Error = Move_Stepper_Motor_To(Command->Frequency_Hz, Command->Position, Executed_Steps);
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_HOME:
+    {
+        Homing_Config_t Config = {
+            .Fast_Frequency_Hz = Command->Frequency_Hz,
+            .Slow_Frequency_Hz = Command->Slow_Frequency_Hz,
+            .Backoff_Steps = Command->Backoff_Steps,
+            .Max_Travel_Steps = Command->Steps,
+            .Direction = Command->Direction,
+        };
+
+        Function_Error = Home_Stepper_Motor(&Config);
+        *Driver_Enabled = true;
+        break;
+    }
+
+    case MOTION_COMMAND_SWEEP:
+    {
+        Resonance_Sweep_Config_t Config = {
+            .Start_Hz = Command->Entry_Frequency_Hz,
+            .End_Hz = Command->Frequency_Hz,
+            .Step_Hz = Command->Step_Frequency_Hz,
+            .Dwell_ms = Command->Dwell_ms,
+            .Threshold = Command->Threshold,
+            .Direction = Command->Direction,
+            .Save = Command->Save,
+        };
+
+        Function_Error = Motor_Resonance_Sweep(&Config);
+        *Driver_Enabled = true;
+        break;
+    }
+
+    case MOTION_COMMAND_AUTOTUNE:
+    {
+        Autotune_Config_t Config;
+
+        Motor_Encoder_Get_Default_Autotune(&Config);
+
+        Config.Max_Frequency_Hz = Command->Frequency_Hz;
+        Config.Max_Acceleration = Command->Acceleration;
+
+        Function_Error = Motor_Encoder_Autotune(&Config, Command->Steps, Command->Save);
+        *Driver_Enabled = true;
+        break;
+    }
+
+    case MOTION_COMMAND_SCRIPT:
+        Function_Error = Motor_Script_Run(&Command->Script, Command->Repeat, Executed_Steps);
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_TRAJECTORY:
+        Function_Error = Trajectory_Player_Run(Executed_Steps);
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_LINEAR:
+        Function_Error = Move_Stepper_Axes_Linear(Command->Frequency_Hz, Command->Axis_Steps, Executed_Steps);
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_ARC:
+        Function_Error = Move_Stepper_Axes_Arc(Command->Frequency_Hz, Command->Axis_Steps[0], Command->Axis_Steps[1], Command->Center[0], Command->Center[1], Command->Clockwise, Executed_Steps);
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_BLOCK:
+        Function_Error = Execute_Motion_Block(Command, Executed_Steps);
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_DWELL:
+        vTaskDelay(pdMS_TO_TICKS(Command->Dwell_ms));
+        break;
+
+    case MOTION_COMMAND_ENABLE:
+        Function_Error = gpio_set_level(STEPPER_MOTOR_EN_PIN, SET_GPIO_LEVEL_LOW); // Enable the Motor drivers
+        MOTION_TRACE(MOTION_TRACE_ENABLE, 0);
+        Hold_Enabled = true;
+        *Driver_Enabled = true;
+        break;
+
+    case MOTION_COMMAND_STOP:
+    default:
+        Function_Error = Decelerate_Stepper_Motor(Executed_Steps); // Ramp a continuous run down, the steps stay counted
+        Function_Error += Stop_Stepper_Motor();
+        Clear_Stepper_Motor_Stop();
+        Hold_Enabled = false;
+        *Driver_Enabled = false;
+        break;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Motion task, executes the queued commands one after the other.
+ *
+ * While the driver is enabled the queue is polled without waiting, so the
+ * next move starts right after the previous one. The driver is only
+ * disabled once the queue has run empty, unless MOTION_COMMAND_ENABLE asked
+ * to keep it enabled.
+ */
+static void Motion_Task(void *arg)
+{
+    Motion_Command_t Command;
+    bool Driver_Enabled = false;
+    uint32_t Executed_Steps = 0;
+
+    while (true)
+    {
+        Clear_Stepper_Motor_Abort(); // An abort only affects commands taken before it
+
+        TickType_t Wait = (Driver_Enabled && !Motion_Status.Running && !Hold_Enabled) ? 0 : portMAX_DELAY;
+
+        if (xQueueReceive(Motion_Queue, &Command, Wait) != pdTRUE)
+        {
+            Stop_Stepper_Motor(); // Queue ran empty after a move, disable the driver
+
+            Driver_Enabled = false;
+
+            continue;
+        }
+
+        MOTION_TRACE(MOTION_TRACE_QUEUE_POP, Command.Id);
+
+        if (Stepper_Motor_Stop_Requested() != 0)
+        {
+            Motion_Queue_Flush(); // A stop request drops everything queued
+
+            Command.Type = MOTION_COMMAND_STOP;
+        }
+
+        portENTER_CRITICAL(&Status_Lock);
+        Motion_Status.Busy = true;
+        Motion_Status.Current_Id = Command.Id;
+        Command_Start_us = esp_timer_get_time();
+        portEXIT_CRITICAL(&Status_Lock);
+
+        esp_err_t Function_Error = Execute_Motion_Command(&Command, &Driver_Enabled, &Executed_Steps);
+        int64_t End_us = esp_timer_get_time();
+
+        MOTION_TRACE(MOTION_TRACE_QUEUE_DONE, Function_Error);
+
+        portENTER_CRITICAL(&Status_Lock);
+        Motion_Status.Busy = false;
+        Motion_Status.Running = (Get_Stepper_Motor_Velocity() != 0) && (Function_Error == ESP_OK);
+        Motion_Status.Velocity_Hz = Get_Stepper_Motor_Velocity();
+        Motion_Status.Completed++;
+        if ((Command.Type != MOTION_COMMAND_STOP) || (Executed_Steps != 0))
+        {
+            Motion_Status.Last_Executed_Steps = Executed_Steps; // A stop after a move keeps the count of that move
+        }
+        Motion_Status.Last_Error = Function_Error;
+        Motion_Status.Missed_Deadlines += ((Function_Error == ESP_ERR_TIMEOUT) || (Function_Error == ESP_FAIL)) ? 1 : 0; // Move did not end in time, or the timer engine ran dry
+        Motion_Status.Busy_us += (uint64_t)(End_us - Command_Start_us);
+        portEXIT_CRITICAL(&Status_Lock);
+    }
+}
+
+/**
+ * @brief Create the motion queue and start the motion task.
+ *
+ * @return
+ *     - ESP_OK: Successfully started the motion task
+ *     - ESP_ERR_NO_MEM: Insufficient memory for the queue or the task
+ */
+esp_err_t Initialize_Motion_Queue(void)
+{
+    Motion_Queue = xQueueCreate(MOTION_QUEUE_LENGTH, sizeof(Motion_Command_t));
+
+    if (Motion_Queue == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreatePinnedToCore(Motion_Task, "motion", MOTION_TASK_STACK_SIZE, NULL, MOTION_TASK_PRIORITY, &Motion_Task_Handle, MOTION_TASK_CORE) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Queue a motion command for the motion task.
+ *
+ * @param Command Command to queue, its Id is filled in.
+ * @return
+ *     - ESP_OK: Command queued
+ *     - ESP_ERR_TIMEOUT: Queue full
+ */
+esp_err_t Motion_Queue_Enqueue(Motion_Command_t *Command)
+{
+    return Motion_Queue_Enqueue_Wait(Command, pdMS_TO_TICKS(MOTION_QUEUE_ENQUEUE_TIMEOUT_MS));
+}
+
+/**
+ * @brief Queue a motion command, waiting for space in the queue.
+ *
+ * Used by producers that stream commands and rely on the queue for flow control.
+ *
+ * @param Command Command to queue, its Id is filled in.
+ * @param Wait Longest time to wait for space, portMAX_DELAY to wait forever.
+ * @return
+ *     - ESP_OK: Command queued
+ *     - ESP_ERR_TIMEOUT: Queue still full after the wait
+ */
+esp_err_t Motion_Queue_Enqueue_Wait(Motion_Command_t *Command, TickType_t Wait)
+{
+    portENTER_CRITICAL(&Status_Lock);
+    Command->Id = Next_Command_Id++;
+    portEXIT_CRITICAL(&Status_Lock);
+
+    MOTION_TRACE(MOTION_TRACE_QUEUE_PUSH, Command->Id); // Before the send, the motion task may take it right away
+
+    if (xQueueSendToBack(Motion_Queue, Command, Wait) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Take a snapshot of the motion task state.
+ *
+ * Busy_us includes the command being executed up to now.
+ *
+ * @param Status Output snapshot.
+ */
+void Motion_Queue_Get_Status(Motion_Queue_Status_t *Status)
+{
+    portENTER_CRITICAL(&Status_Lock);
+    *Status = Motion_Status;
+    if (Status->Busy)
+    {
+        Status->Busy_us += (uint64_t)(esp_timer_get_time() - Command_Start_us); // The command being executed so far
+    }
+    portEXIT_CRITICAL(&Status_Lock);
+
+    Status->Pending = uxQueueMessagesWaiting(Motion_Queue);
+}
+
+/**
+ * @brief Drop all commands that have not been started yet.
+ *
+ * The command being executed runs to completion.
+ *
+ * @return ESP_OK
+ */
+esp_err_t Motion_Queue_Flush(void)
+{
+    xQueueReset(Motion_Queue);
+
+    portENTER_CRITICAL(&Status_Lock);
+    Jog_Requested = Motion_Status.Jogging; // A dropped jog command is queued again by the next set-point
+    portEXIT_CRITICAL(&Status_Lock);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Set the jog velocity, entering the jog mode if needed.
+ *
+ * Safe to call at a high rate. The motion task ramps toward the latest
+ * set-point under the default acceleration, through zero for a reversal.
+ *
+ * @param Velocity_Hz Signed target step frequency, positive forward, 0 to stop.
+ * @return
+ *     - ESP_OK: Set-point taken
+ *     - ESP_ERR_INVALID_ARG: Above MOTION_JOG_MAX_FREQUENCY_HZ
+ *     - ESP_ERR_TIMEOUT: Queue full, the jog mode could not be entered
+ */
+esp_err_t Motion_Queue_Jog(int32_t Velocity_Hz)
+{
+    Motion_Command_t Jog_Command = {
+        .Type = MOTION_COMMAND_JOG, // Follow the set-point
+    };
+    bool Enter_Jog = false;
+
+    if ((Velocity_Hz > MOTION_JOG_MAX_FREQUENCY_HZ) || (Velocity_Hz < -MOTION_JOG_MAX_FREQUENCY_HZ))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&Status_Lock);
+    Jog_Target_Hz = Velocity_Hz;
+    Enter_Jog = !Jog_Requested;
+    Jog_Requested = true;
+    portEXIT_CRITICAL(&Status_Lock);
+
+    if (!Enter_Jog)
+    {
+        return ESP_OK; // The jog loop takes the new set-point on its next update
+    }
+
+    esp_err_t Function_Error = Motion_Queue_Enqueue(&Jog_Command);
+
+    if (Function_Error != ESP_OK)
+    {
+        portENTER_CRITICAL(&Status_Lock);
+        Jog_Requested = false;
+        portEXIT_CRITICAL(&Status_Lock);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Stop the motor along a decel ramp and drop all waiting commands.
+ *
+ * Safe to call from interrupts, e.g. an e-stop input. The running move
+ * decelerates right away, see Request_Stepper_Motor_Stop(), and a stop
+ * command is put in front of the queue to wake up the motion task. The
+ * motion task drops the waiting commands when it takes the next one, the
+ * queue cannot be reset from an interrupt. The steps emitted stay counted:
+ * Last_Executed_Steps of the status reports those of the stopped move or
+ * continuous run.
+ *
+ * @param Quick Stop at the quick-stop deceleration instead of the default acceleration.
+ * @return ESP_OK, the stop is requested even if the queue is full
+ */
+esp_err_t Motion_Queue_Stop(bool Quick)
+{
+    Motion_Command_t Stop_Command = {
+        .Type = MOTION_COMMAND_STOP, // Decelerate, stop the output and disable the driver
+    };
+
+    if (Quick)
+    {
+        Quick_Stop_Stepper_Motor();
+    }
+    else
+    {
+        Request_Stepper_Motor_Stop(MOTION_DEFAULT_ACCELERATION);
+    }
+
+    portENTER_CRITICAL_SAFE(&Status_Lock);
+    Stop_Command.Id = Next_Command_Id++;
+    Jog_Target_Hz = 0; // A stopped jog does not resume
+    portEXIT_CRITICAL_SAFE(&Status_Lock);
+
+    MOTION_TRACE(MOTION_TRACE_QUEUE_PUSH, Stop_Command.Id);
+
+    if (xPortInIsrContext())
+    {
+        BaseType_t Higher_Priority_Task_Woken = pdFALSE;
+
+        xQueueSendToFrontFromISR(Motion_Queue, &Stop_Command, &Higher_Priority_Task_Woken); // A full queue keeps the motion task busy, it sees the request anyway
+
+        if (Higher_Priority_Task_Woken == pdTRUE)
+        {
+            portYIELD_FROM_ISR();
+        }
+    }
+    else
+    {
+        xQueueSendToFront(Motion_Queue, &Stop_Command, 0); // A full queue keeps the motion task busy, it sees the request anyway
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Drop all waiting commands, abort the running one and stop the motor.
+ *
+ * @return
+ *     - ESP_OK: Abort requested
+ *     - ESP_ERR_TIMEOUT: The stop command could not be queued
+ */
+esp_err_t Motion_Queue_Abort(void)
+{
+    Motion_Command_t Stop_Command = {
+        .Type = MOTION_COMMAND_STOP, // Stop the output and disable the driver
+    };
+
+    xQueueReset(Motion_Queue);
+
+    Abort_Stepper_Motor();
+
+    portENTER_CRITICAL(&Status_Lock);
+    Stop_Command.Id = Next_Command_Id++;
+    Jog_Target_Hz = 0; // An aborted jog does not resume
+    Jog_Requested = Motion_Status.Jogging;
+    portEXIT_CRITICAL(&Status_Lock);
+
+    MOTION_TRACE(MOTION_TRACE_QUEUE_PUSH, Stop_Command.Id);
+
+    if (xQueueSendToFront(Motion_Queue, &Stop_Command, 0) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
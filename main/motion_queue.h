@@ -0,0 +1,117 @@
+/*H**********************************************************************
+ * FILENAME :        motion_queue.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Asynchronous motion command queue for the stepper motor example.
+ *
+ * NOTES :
+ *       Console commands only enqueue motion commands and return. A
+ *       dedicated high priority motion task executes them in order and
+ *       keeps the driver enabled while commands are waiting, so queued
+ *       moves run back to back.
+ *
+ *       The jog mode is entered with Motion_Queue_Jog(). Only the first
+ *       set-point is queued, later ones just replace the target the jog
+ *       loop ramps toward every RTOS tick, so they can be streamed at a
+ *       high rate. The jog mode ends once the motor stood still at a target
+ *       of 0; a queued command ramps the motor down and ends it too.
+ *
+ *       Motion_Queue_Stop() brings the motor to standstill along a decel
+ *       ramp at any time, from interrupts too, and drops the queue;
+ *       Motion_Queue_Abort() stops the output right away.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTION_QUEUE_H
+#define MOTION_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_err.h"
+#include "dda_interpolator.h"
+#include "motor_script.h"
+
+#define MOTION_QUEUE_LENGTH 32            // Number of commands that can wait in the queue
+#define MOTION_TASK_STACK_SIZE 4096       // Stack size of the motion task in bytes
+#define MOTION_TASK_PRIORITY 10           // Above the console task so moves are never held up by it
+#define MOTION_TASK_CORE 1                // APP CPU, away from the console and the UART on the PRO CPU
+#define MOTION_QUEUE_ENQUEUE_TIMEOUT_MS 0 // Wait for space in the queue, 0 fails immediately if full
+
+/** Kind of motion command */
+typedef enum
+{
+    MOTION_COMMAND_MOVE = 0,   // Move a fixed number of steps
+    MOTION_COMMAND_RUN,        // Ramp up and keep running until the next command
+    MOTION_COMMAND_STOP,       // Ramp a continuous run down, stop the output and disable the driver
+    MOTION_COMMAND_LINEAR,     // Interpolated straight line over several axes
+    MOTION_COMMAND_ARC,        // Interpolated circular arc on axes X and Y
+    MOTION_COMMAND_BLOCK,      // Look-ahead planned straight block of a continuous path
+    MOTION_COMMAND_DWELL,      // Wait with the motors stopped
+    MOTION_COMMAND_ENABLE,     // Enable the driver and keep it enabled while idle
+    MOTION_COMMAND_JOG,        // Follow the jog set-point, see Motion_Queue_Jog()
+    MOTION_COMMAND_MOVE_TO,    // Move to an absolute position
+    MOTION_COMMAND_HOME,       // Home against the limit switch, see Home_Stepper_Motor()
+    MOTION_COMMAND_SWEEP,      // Find the resonance bands, see Motor_Resonance_Sweep()
+    MOTION_COMMAND_SCRIPT,     // Run a compiled motion script, see Motor_Script_Run()
+    MOTION_COMMAND_TRAJECTORY, // Play the trajectory of the trajectory partition, see Trajectory_Player_Run()
+    MOTION_COMMAND_AUTOTUNE,   // Find the speed and acceleration limits, see Motor_Encoder_Autotune()
+} Motion_Command_Type_t;
+
+/** One queued motion command */
+typedef struct
+{
+    Motion_Command_Type_t Type;       // Kind of command
+    uint32_t Id;                      // Sequence number assigned when queued
+    uint32_t Frequency_Hz;            // Cruise step frequency, of the fast approach for MOTION_COMMAND_HOME, the last one of MOTION_COMMAND_SWEEP or MOTION_COMMAND_AUTOTUNE
+    uint32_t Steps;                   // Steps to move, MOTION_COMMAND_MOVE, the longest search of MOTION_COMMAND_HOME or trial of MOTION_COMMAND_AUTOTUNE
+    uint32_t Duty_Cycle;              // PWM duty cycle, MOTION_COMMAND_RUN only
+    uint8_t Direction;                // MOTOR_DIRECTION_FORWARD or MOTOR_DIRECTION_BACKWARD, toward the switch for MOTION_COMMAND_HOME
+    int32_t Position;                 // Target position, MOTION_COMMAND_MOVE_TO only
+    uint32_t Slow_Frequency_Hz;       // Frequency of the slow approach, MOTION_COMMAND_HOME only
+    uint32_t Backoff_Steps;           // Back-off distance, MOTION_COMMAND_HOME only
+    int32_t Axis_Steps[DDA_MAX_AXES]; // Signed steps per axis, or the X, Y end point of an arc
+    int32_t Center[2];                // Arc center relative to the start, MOTION_COMMAND_ARC only
+    bool Clockwise;                   // Arc direction, MOTION_COMMAND_ARC only
+    uint32_t Entry_Frequency_Hz;      // Frequency at the start, MOTION_COMMAND_BLOCK, or the first one of MOTION_COMMAND_SWEEP
+    uint32_t Exit_Frequency_Hz;       // Frequency at the end, MOTION_COMMAND_BLOCK only
+    uint32_t Acceleration;            // Acceleration in steps/s^2, MOTION_COMMAND_BLOCK, or the highest one of MOTION_COMMAND_AUTOTUNE
+    uint32_t Dwell_ms;                // Dwell time, MOTION_COMMAND_DWELL, or at every frequency of MOTION_COMMAND_SWEEP
+    uint32_t Step_Frequency_Hz;       // Frequency increment, MOTION_COMMAND_SWEEP only
+    uint32_t Threshold;               // Sense edges marking a resonant frequency, MOTION_COMMAND_SWEEP only
+    bool Save;                        // Write the result to NVS, MOTION_COMMAND_SWEEP and MOTION_COMMAND_AUTOTUNE only
+    Motor_Script_Handle_t Script;     // Script from Motor_Script_Load(), MOTION_COMMAND_SCRIPT only
+    uint32_t Repeat;                  // Runs of the script, MOTION_COMMAND_SCRIPT only
+} Motion_Command_t;
+
+/** Snapshot of the motion task state */
+typedef struct
+{
+    uint32_t Pending;             // Commands waiting in the queue
+    bool Busy;                    // True while a command is being executed
+    bool Running;                 // True while the motor is held at a continuous speed
+    bool Jogging;                 // True while the jog mode follows the set-point
+    int32_t Velocity_Hz;          // Signed step frequency of a continuous run or jog, positive forward
+    uint32_t Current_Id;          // Command being executed, or the last one executed
+    uint32_t Completed;           // Number of commands finished since boot
+    uint32_t Last_Executed_Steps; // Steps emitted by the last finished move, or by the continuous run or jog a stop ended
+    esp_err_t Last_Error;         // Result of the last finished command
+    uint32_t Missed_Deadlines;    // Commands ended by a move overrunning its timeout or by a pulse engine underrun
+    uint64_t Busy_us;             // Time spent executing commands since boot
+} Motion_Queue_Status_t;
+
+esp_err_t Initialize_Motion_Queue(void);
+esp_err_t Motion_Queue_Enqueue(Motion_Command_t *Command);
+esp_err_t Motion_Queue_Enqueue_Wait(Motion_Command_t *Command, TickType_t Wait);
+void Motion_Queue_Get_Status(Motion_Queue_Status_t *Status);
+esp_err_t Motion_Queue_Flush(void);
+esp_err_t Motion_Queue_Abort(void);
+esp_err_t Motion_Queue_Stop(bool Quick);
+esp_err_t Motion_Queue_Jog(int32_t Velocity_Hz);
+
+#endif // MOTION_QUEUE_H
@@ -0,0 +1,391 @@
+/*H**********************************************************************
+ * FILENAME :        motion_script.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent compiler of motion scripts into a compact
+ *       bytecode for the stepper motor example.
+ *
+ * NOTES :
+ *       The text is parsed in place in one pass, without copies and without
+ *       the C library number parsing, so it needs no terminating NUL and
+ *       does not depend on the locale. A loop compiles to a LOOP operation
+ *       and an END operation that points back to the first operation of
+ *       the body, so the executor needs no search and no text at run time.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "motion_script.h"
+
+/** Statement of the script language */
+typedef struct
+{
+    const char *Keyword;           // Statement word, lower case
+    Motion_Script_Opcode_t Opcode; // Operation it compiles to
+    bool Has_Argument;             // A number follows the word
+    int64_t Min;                   // Smallest valid argument
+    int64_t Max;                   // Largest valid argument
+} Motion_Script_Statement_t;
+
+static const Motion_Script_Statement_t Statements[] = {
+    {"speed", MOTION_SCRIPT_OP_SPEED, true, 1, MOTION_SCRIPT_MAX_SPEED_HZ},
+    {"move", MOTION_SCRIPT_OP_MOVE, true, -INT32_MAX, INT32_MAX},
+    {"move_to", MOTION_SCRIPT_OP_MOVE_TO, true, INT32_MIN, INT32_MAX},
+    {"dwell", MOTION_SCRIPT_OP_DWELL, true, 0, MOTION_SCRIPT_MAX_DWELL_MS},
+    {"loop", MOTION_SCRIPT_OP_LOOP, true, 1, MOTION_SCRIPT_MAX_LOOP_COUNT},
+    {"end", MOTION_SCRIPT_OP_END, false, 0, 0},
+};
+
+/**
+ * @brief Add without overflow, saturating at UINT64_MAX.
+ */
+static uint64_t Saturating_Add(uint64_t A, uint64_t B)
+{
+    uint64_t Sum;
+
+    return __builtin_add_overflow(A, B, &Sum) ? UINT64_MAX : Sum;
+}
+
+/**
+ * @brief Multiply without overflow, saturating at UINT64_MAX.
+ */
+static uint64_t Saturating_Multiply(uint64_t A, uint64_t B)
+{
+    uint64_t Product;
+
+    return __builtin_mul_overflow(A, B, &Product) ? UINT64_MAX : Product;
+}
+
+/**
+ * @brief Add the repetitions of a move to the moves per run, saturating at UINT32_MAX.
+ */
+static void Count_Moves(Motion_Script_t *Script, uint64_t Repetitions)
+{
+    uint64_t Moves = Saturating_Add(Script->Moves_Per_Run, Repetitions);
+
+    Script->Moves_Per_Run = (Moves > UINT32_MAX) ? UINT32_MAX : (uint32_t)Moves;
+}
+
+/**
+ * @brief Space inside a line, a CR of a CRLF line end included.
+ */
+static bool Is_Blank(char Character)
+{
+    return (Character == ' ') || (Character == '\t') || (Character == '\r');
+}
+
+/**
+ * @brief Character of a statement word.
+ */
+static bool Is_Word(char Character)
+{
+    return ((Character >= 'a') && (Character <= 'z')) || ((Character >= 'A') && (Character <= 'Z')) || (Character == '_');
+}
+
+/**
+ * @brief Compare a word of the text with a keyword, ignoring the case of the text.
+ */
+static bool Word_Equals(const char *Word, size_t Length, const char *Keyword)
+{
+    if (strlen(Keyword) != Length)
+    {
+        return false;
+    }
+
+    for (size_t Index = 0; Index < Length; Index++)
+    {
+        char Character = ((Word[Index] >= 'A') && (Word[Index] <= 'Z')) ? (char)(Word[Index] - 'A' + 'a') : Word[Index];
+
+        if (Character != Keyword[Index])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Parse a signed decimal number, an optional sign and digits.
+ *
+ * @param Cursor Start of the number, advanced past it.
+ * @param End End of the line.
+ * @param Value Returns the number, clamped beyond +-2^40 so out of range values stay out of range.
+ * @return false if no digit follows the sign.
+ */
+static bool Parse_Number(const char **Cursor, const char *End, int64_t *Value)
+{
+    const char *Position = *Cursor;
+    bool Negative = false;
+    int64_t Magnitude = 0;
+    bool Digits = false;
+
+    if ((Position < End) && ((*Position == '+') || (*Position == '-')))
+    {
+        Negative = (*Position == '-');
+        Position++;
+    }
+
+    while ((Position < End) && (*Position >= '0') && (*Position <= '9'))
+    {
+        Magnitude = (Magnitude < (1LL << 40)) ? ((Magnitude * 10) + (*Position - '0')) : Magnitude;
+        Digits = true;
+        Position++;
+    }
+
+    *Cursor = Position;
+    *Value = Negative ? -Magnitude : Magnitude;
+
+    return Digits;
+}
+
+/**
+ * @brief Look up the statement of a word.
+ *
+ * @return The statement, NULL for an unknown word.
+ */
+static const Motion_Script_Statement_t *Find_Statement(const char *Word, size_t Length)
+{
+    for (size_t Index = 0; Index < (sizeof(Statements) / sizeof(Statements[0])); Index++)
+    {
+        if (Word_Equals(Word, Length, Statements[Index].Keyword))
+        {
+            return &Statements[Index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Parse one line into a statement.
+ *
+ * @param Line Start of the line.
+ * @param End End of the line, the newline is not included.
+ * @param Statement Returns the statement, NULL for a blank or comment line.
+ * @param Argument Returns the argument of the statement.
+ * @return NULL if parsed, else the error message.
+ */
+static const char *Parse_Line(const char *Line, const char *End, const Motion_Script_Statement_t **Statement, int64_t *Argument)
+{
+    const char *Cursor = Line;
+
+    *Statement = NULL;
+    *Argument = 0;
+
+    while ((Cursor < End) && Is_Blank(*Cursor))
+    {
+        Cursor++;
+    }
+
+    if ((Cursor == End) || (*Cursor == '#') || (*Cursor == ';'))
+    {
+        return NULL; // Blank or comment line
+    }
+
+    const char *Word = Cursor;
+
+    while ((Cursor < End) && Is_Word(*Cursor))
+    {
+        Cursor++;
+    }
+
+    *Statement = Find_Statement(Word, (size_t)(Cursor - Word));
+
+    if (*Statement == NULL)
+    {
+        return "unknown statement";
+    }
+
+    while ((Cursor < End) && Is_Blank(*Cursor))
+    {
+        Cursor++;
+    }
+
+    if ((*Statement)->Has_Argument)
+    {
+        if ((Cursor == End) || (*Cursor == '#') || (*Cursor == ';'))
+        {
+            return "missing argument";
+        }
+
+        if (!Parse_Number(&Cursor, End, Argument))
+        {
+            return "argument is not a number";
+        }
+
+        if ((*Argument < (*Statement)->Min) || (*Argument > (*Statement)->Max))
+        {
+            return "argument out of range";
+        }
+
+        if (((*Statement)->Opcode == MOTION_SCRIPT_OP_MOVE) && (*Argument == 0))
+        {
+            return "move of 0 steps";
+        }
+
+        while ((Cursor < End) && Is_Blank(*Cursor))
+        {
+            Cursor++;
+        }
+    }
+
+    if ((Cursor < End) && (*Cursor != '#') && (*Cursor != ';'))
+    {
+        return "unexpected text after the statement";
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Compile a motion script into bytecode.
+ *
+ * Checks the whole script, every statement, the loop nesting and the
+ * operation limit, and fills in the per run summary with the loops
+ * unrolled. On an error the script is left incomplete.
+ *
+ * @param Text Script text, need not be NUL terminated.
+ * @param Length Bytes of the text.
+ * @param Script Returns the bytecode.
+ * @param Error Returns the first error, Line 0 if the script as a whole is wrong; may be NULL.
+ * @return false if the script has an error.
+ */
+bool Motion_Script_Compile(const char *Text, size_t Length, Motion_Script_t *Script, Motion_Script_Error_t *Error)
+{
+    const char *Cursor = Text;
+    const char *Text_End = Text + Length;
+    const char *Message = NULL;
+    uint32_t Line = 0;
+    uint16_t Loop_Start[MOTION_SCRIPT_MAX_DEPTH];           // First operation of the body of every open loop
+    uint32_t Loop_Line[MOTION_SCRIPT_MAX_DEPTH];            // Line of every open loop statement
+    uint64_t Multiplier[MOTION_SCRIPT_MAX_DEPTH + 1] = {1}; // Repetitions per run at every depth
+    uint8_t Depth = 0;
+
+    memset(Script, 0, sizeof(*Script));
+
+    while ((Message == NULL) && (Cursor < Text_End))
+    {
+        const char *Line_End = memchr(Cursor, '\n', (size_t)(Text_End - Cursor));
+        const Motion_Script_Statement_t *Statement;
+        int64_t Argument;
+
+        Line_End = (Line_End != NULL) ? Line_End : Text_End;
+        Line++;
+
+        Message = Parse_Line(Cursor, Line_End, &Statement, &Argument);
+
+        Cursor = (Line_End < Text_End) ? (Line_End + 1) : Text_End;
+
+        if ((Message != NULL) || (Statement == NULL))
+        {
+            continue;
+        }
+
+        if (Script->Op_Count >= MOTION_SCRIPT_MAX_OPS)
+        {
+            Message = "too many statements";
+            continue;
+        }
+
+        Motion_Script_Op_t *Op = &Script->Ops[Script->Op_Count];
+
+        Op->Opcode = (uint8_t)Statement->Opcode;
+        Op->Argument = (int32_t)Argument;
+
+        switch (Statement->Opcode)
+        {
+        case MOTION_SCRIPT_OP_MOVE:
+            Script->Steps_Per_Run = Saturating_Add(Script->Steps_Per_Run, Saturating_Multiply((uint64_t)((Argument > 0) ? Argument : -Argument), Multiplier[Depth]));
+            Count_Moves(Script, Multiplier[Depth]);
+            break;
+
+        case MOTION_SCRIPT_OP_MOVE_TO:
+            Count_Moves(Script, Multiplier[Depth]);
+            break;
+
+        case MOTION_SCRIPT_OP_DWELL:
+            Script->Dwell_ms_Per_Run = Saturating_Add(Script->Dwell_ms_Per_Run, Saturating_Multiply((uint64_t)Argument, Multiplier[Depth]));
+            break;
+
+        case MOTION_SCRIPT_OP_LOOP:
+            if (Depth >= MOTION_SCRIPT_MAX_DEPTH)
+            {
+                Message = "loops nested too deep";
+                break;
+            }
+
+            Loop_Start[Depth] = (uint16_t)(Script->Op_Count + 1);
+            Loop_Line[Depth] = Line;
+            Multiplier[Depth + 1] = Saturating_Multiply(Multiplier[Depth], (uint64_t)Argument);
+            Depth++;
+            break;
+
+        case MOTION_SCRIPT_OP_END:
+            if (Depth == 0)
+            {
+                Message = "end without loop";
+                break;
+            }
+
+            Depth--;
+
+            if (Loop_Start[Depth] == Script->Op_Count)
+            {
+                Message = "empty loop";
+                break;
+            }
+
+            Op->Argument = Loop_Start[Depth];
+            break;
+
+        case MOTION_SCRIPT_OP_SPEED:
+        default:
+            break;
+        }
+
+        Script->Op_Count++;
+    }
+
+    if ((Message == NULL) && (Depth > 0))
+    {
+        Message = "loop without end";
+        Line = Loop_Line[Depth - 1];
+    }
+
+    if ((Message == NULL) && (Script->Op_Count == 0))
+    {
+        Message = "no statements";
+        Line = 0;
+    }
+
+    if (Error != NULL)
+    {
+        Error->Line = (Message != NULL) ? Line : 0;
+        Error->Message = Message;
+    }
+
+    return Message == NULL;
+}
+
+/**
+ * @brief Statement word of an operation, for listings.
+ *
+ * @return The word, "?" for an invalid code.
+ */
+const char *Motion_Script_Op_Name(uint8_t Opcode)
+{
+    for (size_t Index = 0; Index < (sizeof(Statements) / sizeof(Statements[0])); Index++)
+    {
+        if ((uint8_t)Statements[Index].Opcode == Opcode)
+        {
+            return Statements[Index].Keyword;
+        }
+    }
+
+    return "?";
+}
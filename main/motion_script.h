@@ -0,0 +1,80 @@
+/*H**********************************************************************
+ * FILENAME :        motion_script.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent compiler of motion scripts into a compact
+ *       bytecode for the stepper motor example.
+ *
+ * NOTES :
+ *       A script holds one statement per line, '#' or ';' starts a comment:
+ *         speed <Hz>       Cruise frequency of the following moves
+ *         move <steps>     Relative move, the sign gives the direction
+ *         move_to <pos>    Move to an absolute position
+ *         dwell <ms>       Wait with the motor stopped
+ *         loop <count>     Repeat the statements up to the matching end
+ *         end              Close the innermost loop
+ *
+ *       The compiler checks the whole script and reports the first error
+ *       with its line, so a script can be validated offline on the host,
+ *       see host/script_check.c. Moves before the first speed statement
+ *       run at MOTION_SCRIPT_DEFAULT_SPEED_HZ.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTION_SCRIPT_H
+#define MOTION_SCRIPT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MOTION_SCRIPT_MAX_OPS 128            // Operations of one compiled script
+#define MOTION_SCRIPT_MAX_DEPTH 8            // Deepest nesting of loops
+#define MOTION_SCRIPT_DEFAULT_SPEED_HZ 1000  // Cruise frequency of moves before the first speed statement
+#define MOTION_SCRIPT_MAX_SPEED_HZ 70000     // Highest speed, the jog limit of the RMT and timer pulse engines
+#define MOTION_SCRIPT_MAX_DWELL_MS 3600000   // Longest dwell, one hour
+#define MOTION_SCRIPT_MAX_LOOP_COUNT 1000000 // Most repetitions of one loop
+
+/** Operation codes of the bytecode */
+typedef enum
+{
+    MOTION_SCRIPT_OP_SPEED = 0, // Set the cruise frequency to Argument Hz
+    MOTION_SCRIPT_OP_MOVE,      // Move Argument steps, negative backward
+    MOTION_SCRIPT_OP_MOVE_TO,   // Move to position Argument
+    MOTION_SCRIPT_OP_DWELL,     // Wait Argument ms
+    MOTION_SCRIPT_OP_LOOP,      // Enter a loop of Argument repetitions
+    MOTION_SCRIPT_OP_END,       // Repeat from operation Argument, the first of the loop body, until the count is used up
+} Motion_Script_Opcode_t;
+
+/** One operation of the bytecode, 8 bytes */
+typedef struct
+{
+    uint8_t Opcode;   // Motion_Script_Opcode_t
+    int32_t Argument; // Operand, see Motion_Script_Opcode_t
+} Motion_Script_Op_t;
+
+/** Compiled script */
+typedef struct
+{
+    Motion_Script_Op_t Ops[MOTION_SCRIPT_MAX_OPS]; // Bytecode, executed from the first operation
+    uint16_t Op_Count;                             // Valid entries in Ops
+    uint32_t Moves_Per_Run;                        // Moves of one run with the loops unrolled, saturated
+    uint64_t Steps_Per_Run;                        // Steps of the relative moves of one run, saturated, move_to not included
+    uint64_t Dwell_ms_Per_Run;                     // Dwell time of one run, saturated
+} Motion_Script_t;
+
+/** First error found by the compiler */
+typedef struct
+{
+    uint32_t Line;       // Line of the error, counted from 1
+    const char *Message; // Static description
+} Motion_Script_Error_t;
+
+bool Motion_Script_Compile(const char *Text, size_t Length, Motion_Script_t *Script, Motion_Script_Error_t *Error);
+const char *Motion_Script_Op_Name(uint8_t Opcode);
+
+#endif // MOTION_SCRIPT_H
@@ -0,0 +1,350 @@
+/*H**********************************************************************
+ * FILENAME :        motion_trace.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Step event trace of the stepper motor example.
+ *
+ * NOTES :
+ *       Every recorder takes its own slot with an atomic increment of the
+ *       head index, so concurrent recorders never share a slot. A slot
+ *       holds the index of its event plus one, written last; a reader only
+ *       accepts a slot whose index is the expected one before and after
+ *       copying it, which drops slots that are being rewritten meanwhile.
+ *
+ *       Timestamps are the low 32 bits of esp_timer_get_time(). They wrap
+ *       after about 71 minutes, the latency differences stay correct.
+ *
+ *       The latency histograms are computed from the events still in the
+ *       ring when they are printed:
+ *         queue wait       QUEUE_PUSH to the QUEUE_POP of the same command
+ *         first pulse      MOVE_START to the following PULSE_START
+ *         frequency update SEGMENT to the following FREQUENCY, the time
+ *                          the new frequency of a segment comes late
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "motion_trace.h"
+#include "esp_timer.h"
+
+#if MOTION_TRACE_ENABLED
+
+/** One recorded event */
+typedef struct
+{
+    uint32_t Sequence; // Index of the event plus one, 0 while the slot is written
+    uint32_t Time_us;  // Low 32 bits of esp_timer_get_time()
+    uint32_t Argument; // Event specific value
+    uint8_t Event;     // Motion_Trace_Event_t
+} Motion_Trace_Entry_t;
+
+/** Latency statistics of one event pair */
+typedef struct
+{
+    uint32_t Count;                             // Samples
+    uint32_t Min_us;                            // Shortest latency
+    uint32_t Max_us;                            // Longest latency
+    uint64_t Sum_us;                            // Sum of all latencies, for the mean
+    uint32_t Bins[MOTION_TRACE_HISTOGRAM_BINS]; // Bin N counts latencies from 2^N to 2^(N+1) - 1 us, bin 0 also 0 us
+} Motion_Trace_Histogram_t;
+
+static const char *const Event_Names[MOTION_TRACE_EVENT_COUNT] = {
+    "ENABLE",
+    "DISABLE",
+    "DIRECTION",
+    "MOVE_START",
+    "PULSE_START",
+    "SEGMENT",
+    "FREQUENCY",
+    "MOVE_STOP",
+    "ABORT",
+    "STOP",
+    "QUEUE_PUSH",
+    "QUEUE_POP",
+    "QUEUE_DONE",
+    "HOME_LATCH",
+};
+
+static Motion_Trace_Entry_t Trace_Ring[MOTION_TRACE_DEPTH]; // Recorded events, slot = index modulo depth
+static Motion_Trace_Entry_t Snapshot[MOTION_TRACE_DEPTH];   // Copy of the ring taken by the console
+static uint32_t Trace_Head = 0;                             // Index of the next event
+static uint32_t Trace_Start = 0;                            // First index reported, moved by Motion_Trace_Clear()
+
+/**
+ * @brief Record one event, safe from any task and from interrupts.
+ *
+ * @param Event Kind of event.
+ * @param Argument Event specific value, see Motion_Trace_Event_t.
+ */
+void Motion_Trace_Record(Motion_Trace_Event_t Event, uint32_t Argument)
+{
+    uint32_t Index = __atomic_fetch_add(&Trace_Head, 1, __ATOMIC_RELAXED);
+    Motion_Trace_Entry_t *Entry = &Trace_Ring[Index & (MOTION_TRACE_DEPTH - 1)];
+
+    __atomic_store_n(&Entry->Sequence, 0, __ATOMIC_RELAXED); // Readers drop the slot until it is complete
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    Entry->Time_us = (uint32_t)esp_timer_get_time();
+    Entry->Argument = Argument;
+    Entry->Event = (uint8_t)Event;
+
+    __atomic_store_n(&Entry->Sequence, Index + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Copy the events still in the ring, oldest first.
+ *
+ * @param Lost Returns the events recorded since the last clear that were overwritten or torn.
+ * @return Number of events copied to Snapshot.
+ */
+static uint32_t Take_Snapshot(uint32_t *Lost)
+{
+    uint32_t Head = __atomic_load_n(&Trace_Head, __ATOMIC_ACQUIRE);
+    uint32_t First = Trace_Start;
+    uint32_t Count = 0;
+
+    if ((Head - First) > MOTION_TRACE_DEPTH)
+    {
+        First = Head - MOTION_TRACE_DEPTH; // Older events are overwritten
+    }
+
+    for (uint32_t Index = First; Index != Head; Index++)
+    {
+        const Motion_Trace_Entry_t *Entry = &Trace_Ring[Index & (MOTION_TRACE_DEPTH - 1)];
+
+        if (__atomic_load_n(&Entry->Sequence, __ATOMIC_ACQUIRE) != (Index + 1))
+        {
+            continue; // Being written, or already overwritten by a newer event
+        }
+
+        Snapshot[Count].Time_us = Entry->Time_us;
+        Snapshot[Count].Argument = Entry->Argument;
+        Snapshot[Count].Event = Entry->Event;
+        Snapshot[Count].Sequence = Index + 1;
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&Entry->Sequence, __ATOMIC_RELAXED) == (Index + 1))
+        {
+            Count++; // Slot did not change while it was copied
+        }
+    }
+
+    *Lost = (Head - Trace_Start) - Count;
+
+    return Count;
+}
+
+/**
+ * @brief Add one latency sample to a histogram.
+ */
+static void Histogram_Add(Motion_Trace_Histogram_t *Histogram, uint32_t Latency_us)
+{
+    uint8_t Bin = 0;
+
+    while (((Latency_us >> Bin) > 1) && (Bin < (MOTION_TRACE_HISTOGRAM_BINS - 1)))
+    {
+        Bin++;
+    }
+
+    Histogram->Min_us = ((Histogram->Count == 0) || (Latency_us < Histogram->Min_us)) ? Latency_us : Histogram->Min_us;
+    Histogram->Max_us = (Latency_us > Histogram->Max_us) ? Latency_us : Histogram->Max_us;
+    Histogram->Sum_us += Latency_us;
+    Histogram->Count++;
+    Histogram->Bins[Bin]++;
+}
+
+/**
+ * @brief Print one latency histogram, empty bins are left out.
+ */
+static void Histogram_Print(const char *Name, const Motion_Trace_Histogram_t *Histogram)
+{
+    printf("%-16s : '%" PRIu32 "' samples", Name, Histogram->Count);
+
+    if (Histogram->Count == 0)
+    {
+        printf("\n");
+        return;
+    }
+
+    printf(", min '%" PRIu32 "' mean '%" PRIu64 "' max '%" PRIu32 "' us\n", Histogram->Min_us, Histogram->Sum_us / Histogram->Count, Histogram->Max_us);
+
+    for (uint8_t Bin = 0; Bin < MOTION_TRACE_HISTOGRAM_BINS; Bin++)
+    {
+        if (Histogram->Bins[Bin] == 0)
+        {
+            continue;
+        }
+
+        if (Bin == (MOTION_TRACE_HISTOGRAM_BINS - 1))
+        {
+            printf("  >= %6" PRIu32 " us : %" PRIu32 "\n", (uint32_t)1 << Bin, Histogram->Bins[Bin]);
+        }
+        else
+        {
+            printf("  <  %6" PRIu32 " us : %" PRIu32 "\n", (uint32_t)2 << Bin, Histogram->Bins[Bin]);
+        }
+    }
+}
+
+/**
+ * @brief Print the events still in the ring, oldest first.
+ *
+ * @return ESP_OK
+ */
+esp_err_t Motion_Trace_Dump(void)
+{
+    uint32_t Lost = 0;
+    uint32_t Count = Take_Snapshot(&Lost);
+
+    printf("EVENTS    : '%" PRIu32 "'\n", Count);
+    printf("LOST      : '%" PRIu32 "'\n", Lost);
+
+    for (uint32_t Index = 0; Index < Count; Index++)
+    {
+        const Motion_Trace_Entry_t *Entry = &Snapshot[Index];
+        const char *Name = (Entry->Event < MOTION_TRACE_EVENT_COUNT) ? Event_Names[Entry->Event] : "?";
+
+        printf("%10" PRIu32 " %10" PRIu32 " us  %-11s %" PRIu32 "\n", Entry->Sequence - 1, Entry->Time_us, Name, Entry->Argument);
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Print the event counts and latency histograms of the events in the ring.
+ *
+ * @return ESP_OK
+ */
+esp_err_t Motion_Trace_Print_Stats(void)
+{
+    Motion_Trace_Histogram_t Queue_Wait = {0};
+    Motion_Trace_Histogram_t First_Pulse = {0};
+    Motion_Trace_Histogram_t Frequency_Update = {0};
+    uint32_t Event_Counts[MOTION_TRACE_EVENT_COUNT] = {0};
+    uint32_t Move_Start_us = 0;
+    uint32_t Segment_us = 0;
+    bool Move_Pending = false;    // MOVE_START seen, PULSE_START not yet
+    bool Segment_Pending = false; // SEGMENT seen, FREQUENCY not yet
+    uint32_t Lost = 0;
+    uint32_t Count = Take_Snapshot(&Lost);
+
+    for (uint32_t Index = 0; Index < Count; Index++)
+    {
+        const Motion_Trace_Entry_t *Entry = &Snapshot[Index];
+
+        if (Entry->Event >= MOTION_TRACE_EVENT_COUNT)
+        {
+            continue;
+        }
+
+        Event_Counts[Entry->Event]++;
+
+        switch (Entry->Event)
+        {
+        case MOTION_TRACE_MOVE_START:
+            Move_Start_us = Entry->Time_us;
+            Move_Pending = true;
+            Segment_Pending = false;
+            break;
+
+        case MOTION_TRACE_PULSE_START:
+            if (Move_Pending)
+            {
+                Histogram_Add(&First_Pulse, Entry->Time_us - Move_Start_us);
+            }
+            Move_Pending = false;
+            break;
+
+        case MOTION_TRACE_SEGMENT:
+            Segment_us = Entry->Time_us;
+            Segment_Pending = true;
+            break;
+
+        case MOTION_TRACE_FREQUENCY:
+            if (Segment_Pending)
+            {
+                Histogram_Add(&Frequency_Update, Entry->Time_us - Segment_us);
+            }
+            Segment_Pending = false;
+            break;
+
+        case MOTION_TRACE_MOVE_STOP:
+        case MOTION_TRACE_ABORT:
+            Move_Pending = false;
+            Segment_Pending = false;
+            break;
+
+        case MOTION_TRACE_QUEUE_POP:
+            for (uint32_t Earlier = Index; Earlier-- > 0;)
+            {
+                if ((Snapshot[Earlier].Event == MOTION_TRACE_QUEUE_PUSH) && (Snapshot[Earlier].Argument == Entry->Argument))
+                {
+                    Histogram_Add(&Queue_Wait, Entry->Time_us - Snapshot[Earlier].Time_us);
+                    break;
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    printf("EVENTS    : '%" PRIu32 "'\n", Count);
+    printf("LOST      : '%" PRIu32 "'\n", Lost);
+
+    for (uint8_t Event = 0; Event < MOTION_TRACE_EVENT_COUNT; Event++)
+    {
+        printf("  %-11s : %" PRIu32 "\n", Event_Names[Event], Event_Counts[Event]);
+    }
+
+    Histogram_Print("QUEUE WAIT", &Queue_Wait);
+    Histogram_Print("FIRST PULSE", &First_Pulse);
+    Histogram_Print("FREQUENCY UPDATE", &Frequency_Update);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Drop the recorded events, recording goes on.
+ *
+ * @return ESP_OK
+ */
+esp_err_t Motion_Trace_Clear(void)
+{
+    Trace_Start = __atomic_load_n(&Trace_Head, __ATOMIC_ACQUIRE);
+
+    return ESP_OK;
+}
+
+#else
+
+void Motion_Trace_Record(Motion_Trace_Event_t Event, uint32_t Argument)
+{
+}
+
+esp_err_t Motion_Trace_Dump(void)
+{
+    printf("Tracing not built in, set MOTION_TRACE_ENABLED to 1\n");
+
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t Motion_Trace_Print_Stats(void)
+{
+    return Motion_Trace_Dump();
+}
+
+esp_err_t Motion_Trace_Clear(void)
+{
+    return Motion_Trace_Dump();
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*H**********************************************************************
+ * FILENAME :        motion_trace.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Step event trace of the stepper motor example.
+ *
+ * NOTES :
+ *       The motor paths record their events with MOTION_TRACE() into a
+ *       statically allocated ring of MOTION_TRACE_DEPTH entries. Recording
+ *       takes one atomic increment, one esp_timer read and four stores, no
+ *       lock, so it may be used from tasks on both cores and from
+ *       interrupts. The oldest events are overwritten when the ring is full.
+ *
+ *       Set MOTION_TRACE_ENABLED to 0 to compile every MOTION_TRACE() out,
+ *       the console command then reports that tracing is not built in.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTION_TRACE_H
+#define MOTION_TRACE_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifndef MOTION_TRACE_ENABLED
+#define MOTION_TRACE_ENABLED 1 // 0 compiles the trace points out
+#endif
+
+#define MOTION_TRACE_DEPTH 256         // Events held in the ring, a power of two
+#define MOTION_TRACE_HISTOGRAM_BINS 16 // Power of two latency bins, the last one is open ended
+
+/** Kind of a traced event */
+typedef enum
+{
+    MOTION_TRACE_ENABLE = 0,  // Driver enabled
+    MOTION_TRACE_DISABLE,     // Driver disabled
+    MOTION_TRACE_DIRECTION,   // Direction pin set, argument is the direction
+    MOTION_TRACE_MOVE_START,  // Motor function called, argument is the steps or ticks, 0 for a continuous run
+    MOTION_TRACE_PULSE_START, // Step output started, argument is the first frequency
+    MOTION_TRACE_SEGMENT,     // Segment boundary reached, argument is the new segment index
+    MOTION_TRACE_FREQUENCY,   // Step frequency applied, argument is the frequency
+    MOTION_TRACE_MOVE_STOP,   // Move finished, argument is the steps or ticks emitted
+    MOTION_TRACE_ABORT,       // Abort requested
+    MOTION_TRACE_STOP,        // Stop along a decel ramp requested, argument is the deceleration
+    MOTION_TRACE_QUEUE_PUSH,  // Command queued, argument is its id
+    MOTION_TRACE_QUEUE_POP,   // Command taken by the motion task, argument is its id
+    MOTION_TRACE_QUEUE_DONE,  // Command finished, argument is its result
+    MOTION_TRACE_HOME_LATCH,  // Home switch latched, argument is the position
+    MOTION_TRACE_EVENT_COUNT, // Number of event kinds
+} Motion_Trace_Event_t;
+
+#if MOTION_TRACE_ENABLED
+#define MOTION_TRACE(Event, Argument) Motion_Trace_Record((Event), (uint32_t)(Argument))
+#else
+#define MOTION_TRACE(Event, Argument) ((void)0)
+#endif
+
+void Motion_Trace_Record(Motion_Trace_Event_t Event, uint32_t Argument);
+esp_err_t Motion_Trace_Dump(void);
+esp_err_t Motion_Trace_Print_Stats(void);
+esp_err_t Motion_Trace_Clear(void);
+
+#endif // MOTION_TRACE_H
@@ -0,0 +1,507 @@
+/*H**********************************************************************
+ * FILENAME :        motor_encoder.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Optional quadrature encoder of the single axis motor: following
+ *       error and stall detection during the moves, and the autotune of the
+ *       speed and acceleration limits, persisted in NVS.
+ *
+ * NOTES :
+ *       The 16 bit counter resets at +/-MOTOR_ENCODER_PCNT_LIMIT and its
+ *       interrupt adds the limit to a 32 bit overflow count. A read takes
+ *       the counter again if an overflow was added meanwhile. Between the
+ *       reset of the counter and its interrupt a read can still be one limit
+ *       off, the monitor sees that as a following error.
+ *
+ *       The monitor runs in the task that executes the motion, only the
+ *       status copy is shared with the console.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "motor_encoder.h"
+#include "main.h"
+#include "nvs.h"
+#include "motion_math.h"
+
+#define MOTOR_ENCODER_NVS_KEY "limits" // NVS key of the tuned limits
+#define MOTOR_ENCODER_COUNTS_PER_STEP_Q16 (((int64_t)MOTOR_ENCODER_COUNTS_PER_REV << 16) / (MOTOR_FULL_STEPS_PER_REV * STEPPER_MOTOR_MICROSTEPS)) // Counts of one step in 16.16
+
+/** Tuned limits as stored in NVS */
+typedef struct
+{
+    uint32_t Version;          // MOTOR_ENCODER_NVS_VERSION of the writer
+    uint32_t Max_Frequency_Hz; // Highest cruise frequency
+    uint32_t Acceleration;     // Acceleration in steps/s^2
+} Motor_Encoder_Record_t;
+
+static bool Encoder_Active = false;                              // Encoder configured, the moves are monitored
+static int32_t Overflow_Counts = 0;                              // Counts of the counter resets, accessed atomically
+static Closed_Loop_Config_t Monitor_Config;                      // Encoder and limits of the monitor
+static Closed_Loop_Monitor_t Monitor;                            // Monitor of the current move, motion task only
+static Motor_Encoder_Status_t Status;                            // Statistics of the monitor, without the live counts
+static Motor_Encoder_Autotune_Report_t Last_Autotune = {         // Result of the last autotune
+    .Result = ESP_ERR_INVALID_STATE,                             // No autotune since boot
+};
+static portMUX_TYPE Encoder_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards Status and Last_Autotune
+
+#if STEPPER_MOTOR_ENCODER
+/**
+ * @brief Limit interrupt of the encoder counter, adds the range of the reset counter.
+ */
+static void Motor_Encoder_ISR(void *arg)
+{
+    uint32_t Event_Status = 0;
+
+    pcnt_get_event_status(MOTOR_ENCODER_PCNT_UNIT, &Event_Status);
+
+    if (Event_Status & PCNT_EVT_H_LIM)
+    {
+        __atomic_add_fetch(&Overflow_Counts, MOTOR_ENCODER_PCNT_LIMIT, __ATOMIC_RELEASE);
+    }
+    else if (Event_Status & PCNT_EVT_L_LIM)
+    {
+        __atomic_sub_fetch(&Overflow_Counts, MOTOR_ENCODER_PCNT_LIMIT, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief Configure both channels of the encoder counter and start it.
+ *
+ * A rising edge of A while B is low counts up, so A leading B counts
+ * forward. Swap the A and B pins if the encoder counts backward.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+static esp_err_t Initialize_Encoder_Counter(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    // Configuration structure for the encoder counter
+    pcnt_config_t Encoder_Config = {}; // Zero-initialize the config structure
+
+    Encoder_Config.pulse_gpio_num = MOTOR_ENCODER_A_PIN;      // Count the edges of phase A
+    Encoder_Config.ctrl_gpio_num = MOTOR_ENCODER_B_PIN;       // Phase B gives the direction
+    Encoder_Config.unit = MOTOR_ENCODER_PCNT_UNIT;            // Counter unit
+    Encoder_Config.channel = PCNT_CHANNEL_0;                  // First channel
+    Encoder_Config.pos_mode = PCNT_COUNT_DEC;                 // Rising edge of A while B is high counts down
+    Encoder_Config.neg_mode = PCNT_COUNT_INC;                 // Falling edge of A while B is high counts up
+    Encoder_Config.lctrl_mode = PCNT_MODE_REVERSE;            // Reversed while B is low
+    Encoder_Config.hctrl_mode = PCNT_MODE_KEEP;               // Kept while B is high
+    Encoder_Config.counter_h_lim = MOTOR_ENCODER_PCNT_LIMIT;  // Overflow forward
+    Encoder_Config.counter_l_lim = -MOTOR_ENCODER_PCNT_LIMIT; // Overflow backward
+
+    Function_Error += pcnt_unit_config(&Encoder_Config);
+
+    Encoder_Config.pulse_gpio_num = MOTOR_ENCODER_B_PIN; // Count the edges of phase B
+    Encoder_Config.ctrl_gpio_num = MOTOR_ENCODER_A_PIN;  // Phase A gives the direction
+    Encoder_Config.channel = PCNT_CHANNEL_1;             // Second channel
+    Encoder_Config.pos_mode = PCNT_COUNT_INC;            // Rising edge of B while A is high counts up
+    Encoder_Config.neg_mode = PCNT_COUNT_DEC;            // Falling edge of B while A is high counts down
+
+    Function_Error += pcnt_unit_config(&Encoder_Config);
+
+    Function_Error += pcnt_set_filter_value(MOTOR_ENCODER_PCNT_UNIT, MOTOR_ENCODER_FILTER); // Ignore glitches shorter than the filter
+    Function_Error += pcnt_filter_enable(MOTOR_ENCODER_PCNT_UNIT);
+
+    Function_Error += pcnt_event_enable(MOTOR_ENCODER_PCNT_UNIT, PCNT_EVT_H_LIM); // Interrupt on every overflow forward
+    Function_Error += pcnt_event_enable(MOTOR_ENCODER_PCNT_UNIT, PCNT_EVT_L_LIM); // and backward
+
+    Function_Error += pcnt_counter_pause(MOTOR_ENCODER_PCNT_UNIT);
+    Function_Error += pcnt_counter_clear(MOTOR_ENCODER_PCNT_UNIT);
+
+    esp_err_t Service_Error = pcnt_isr_service_install(0);
+
+    if (Service_Error != ESP_ERR_INVALID_STATE) // Already installed by the pulse counter otherwise
+    {
+        Function_Error += Service_Error;
+    }
+
+    Function_Error += pcnt_isr_handler_add(MOTOR_ENCODER_PCNT_UNIT, Motor_Encoder_ISR, NULL);
+
+    Function_Error += pcnt_counter_resume(MOTOR_ENCODER_PCNT_UNIT);
+
+    return Function_Error;
+}
+#endif
+
+/**
+ * @brief Write the limits to NVS.
+ *
+ * @return ESP_OK or the error of the NVS access.
+ */
+static esp_err_t Store_Limits(uint32_t Max_Frequency_Hz, uint32_t Acceleration)
+{
+    Motor_Encoder_Record_t Record = {
+        .Version = MOTOR_ENCODER_NVS_VERSION,
+        .Max_Frequency_Hz = Max_Frequency_Hz,
+        .Acceleration = Acceleration,
+    };
+    nvs_handle_t Handle = 0;
+    esp_err_t Function_Error = nvs_open(MOTOR_ENCODER_NVS_NAMESPACE, NVS_READWRITE, &Handle);
+
+    if (Function_Error == ESP_OK)
+    {
+        Function_Error = nvs_set_blob(Handle, MOTOR_ENCODER_NVS_KEY, &Record, sizeof(Record));
+        Function_Error = (Function_Error == ESP_OK) ? nvs_commit(Handle) : Function_Error;
+        nvs_close(Handle);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Apply the limits stored by an autotune and configure the encoder.
+ *
+ * Needs nvs_flash_init() to be called first. If the stored limits cannot be
+ * read the motor starts with the default limits. The encoder is only
+ * configured with STEPPER_MOTOR_ENCODER set.
+ *
+ * @return
+ *     - Sum of the ESP return values of the counter configuration
+ */
+esp_err_t Initialize_Motor_Encoder(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+    nvs_handle_t Handle = 0;
+    Motor_Encoder_Record_t Record;
+    size_t Length = sizeof(Record);
+
+    Closed_Loop_Default_Config(&Monitor_Config, (int32_t)MOTOR_ENCODER_COUNTS_PER_STEP_Q16);
+
+    esp_err_t Nvs_Error = nvs_open(MOTOR_ENCODER_NVS_NAMESPACE, NVS_READONLY, &Handle);
+
+    if (Nvs_Error == ESP_OK)
+    {
+        Nvs_Error = nvs_get_blob(Handle, MOTOR_ENCODER_NVS_KEY, &Record, &Length);
+
+        nvs_close(Handle);
+    }
+
+    if (Nvs_Error == ESP_OK)
+    {
+        if ((Length != sizeof(Record)) || (Record.Version != MOTOR_ENCODER_NVS_VERSION) || (Set_Stepper_Motor_Limits(Record.Max_Frequency_Hz, Record.Acceleration) != ESP_OK))
+        {
+            printf("Autotune: stored limits not valid, starting with the defaults\n");
+        }
+    }
+    else if (Nvs_Error != ESP_ERR_NVS_NOT_FOUND)
+    {
+        printf("Autotune: NVS not readable, starting with the defaults\n");
+    }
+
+#if STEPPER_MOTOR_ENCODER
+    Function_Error = Initialize_Encoder_Counter();
+
+    Encoder_Active = (Function_Error == ESP_OK);
+#endif
+
+    return Function_Error;
+}
+
+/**
+ * @brief True if the encoder is configured and the moves are monitored.
+ */
+bool Motor_Encoder_Active(void)
+{
+    return Encoder_Active;
+}
+
+/**
+ * @brief Encoder count since start-up, positive forward.
+ *
+ * @return 0 without an active encoder.
+ */
+int32_t Motor_Encoder_Get_Counts(void)
+{
+    int32_t Overflow = 0;
+    int16_t Count = 0;
+
+    if (!Encoder_Active)
+    {
+        return 0;
+    }
+
+    do
+    {
+        Overflow = __atomic_load_n(&Overflow_Counts, __ATOMIC_ACQUIRE);
+
+        pcnt_get_counter_value(MOTOR_ENCODER_PCNT_UNIT, &Count);
+    } while (Overflow != __atomic_load_n(&Overflow_Counts, __ATOMIC_ACQUIRE)); // Counter reset meanwhile, read it again
+
+    return (int32_t)((uint32_t)Overflow + (uint32_t)(int32_t)Count);
+}
+
+/**
+ * @brief Start monitoring a move from the current position.
+ *
+ * Called by the motor control before the first step of every planned move
+ * and continuous run. Does nothing without an active encoder.
+ */
+void Motor_Encoder_Begin_Move(void)
+{
+    if (!Encoder_Active)
+    {
+        return;
+    }
+
+    Closed_Loop_Begin(&Monitor, &Monitor_Config, Get_Stepper_Motor_Position(), Motor_Encoder_Get_Counts());
+
+    portENTER_CRITICAL(&Encoder_Lock);
+    Status.Moves++;
+    Status.Error = 0;
+    Status.Max_Error = 0;
+    portEXIT_CRITICAL(&Encoder_Lock);
+}
+
+/**
+ * @brief Compare the commanded position of the running move with the encoder.
+ *
+ * Called by the motor control while a move runs and once it ended. The
+ * fault of a move is latched, it is returned by every later check of the
+ * same move.
+ *
+ * @return
+ *     - ESP_OK: Following, or no active encoder
+ *     - ESP_ERR_INVALID_RESPONSE: Following error or stall, see Motor_Encoder_Get_Status()
+ */
+esp_err_t Motor_Encoder_Check(void)
+{
+    if (!Encoder_Active)
+    {
+        return ESP_OK;
+    }
+
+    bool Following = (Monitor.Fault == CLOSED_LOOP_OK);
+    Closed_Loop_Fault_t Fault = Closed_Loop_Update(&Monitor, Get_Stepper_Motor_Position(), Motor_Encoder_Get_Counts());
+
+    portENTER_CRITICAL(&Encoder_Lock);
+    Status.Checks++;
+    Status.Error = Monitor.Error;
+    Status.Max_Error = Monitor.Max_Error;
+    Status.Faults += (Following && (Fault != CLOSED_LOOP_OK)) ? 1 : 0;
+    Status.Last_Fault = (Fault != CLOSED_LOOP_OK) ? Fault : Status.Last_Fault;
+    portEXIT_CRITICAL(&Encoder_Lock);
+
+    return (Fault == CLOSED_LOOP_OK) ? ESP_OK : ESP_ERR_INVALID_RESPONSE;
+}
+
+/**
+ * @brief Copy of the encoder state and the statistics of the monitor.
+ */
+void Motor_Encoder_Get_Status(Motor_Encoder_Status_t *Encoder_Status)
+{
+    portENTER_CRITICAL(&Encoder_Lock);
+    *Encoder_Status = Status;
+    portEXIT_CRITICAL(&Encoder_Lock);
+
+    Encoder_Status->Active = Encoder_Active;
+    Encoder_Status->Config = Monitor_Config;
+    Encoder_Status->Counts = Motor_Encoder_Get_Counts();
+    Encoder_Status->Measured_Steps = Closed_Loop_Counts_To_Steps(&Monitor_Config, Encoder_Status->Counts);
+}
+
+/**
+ * @brief Set the speed and acceleration limits by hand, e.g. without an encoder.
+ *
+ * @param Max_Frequency_Hz Highest cruise frequency.
+ * @param Acceleration Acceleration in steps/s^2.
+ * @param Save Also write them to NVS, they are applied on the next boot.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG if Set_Stepper_Motor_Limits() refuses them, or the error of the NVS write.
+ */
+esp_err_t Motor_Encoder_Set_Limits(uint32_t Max_Frequency_Hz, uint32_t Acceleration, bool Save)
+{
+    esp_err_t Function_Error = Set_Stepper_Motor_Limits(Max_Frequency_Hz, Acceleration);
+
+    if ((Function_Error == ESP_OK) && Save)
+    {
+        Function_Error = Store_Limits(Max_Frequency_Hz, Acceleration);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Fill an autotune configuration with the defaults.
+ *
+ * The frequency is raised from 2 kHz up to the jog maximum at a quarter of
+ * the default acceleration, then the acceleration up to ten times the
+ * default one. Every passed trial raises the value by 25 %, the search ends
+ * at a resolution of 3 % and keeps 80 % of the highest passed values.
+ */
+void Motor_Encoder_Get_Default_Autotune(Autotune_Config_t *Config)
+{
+    Config->Start_Frequency_Hz = 2000;
+    Config->Max_Frequency_Hz = MOTION_JOG_MAX_FREQUENCY_HZ;
+    Config->Start_Acceleration = MOTION_DEFAULT_ACCELERATION / 4;
+    Config->Max_Acceleration = 10 * MOTION_DEFAULT_ACCELERATION;
+    Config->Growth_Percent = 25;
+    Config->Resolution_Percent = 3;
+    Config->Margin_Percent = 80;
+}
+
+/**
+ * @brief Move forward and back again under the limits of one trial.
+ *
+ * Each move ramps up to the frequency, cruises for 100 ms and ramps down,
+ * shortened to the travel if that is too short.
+ *
+ * @return ESP_OK if passed, ESP_ERR_INVALID_RESPONSE on a fault, else the error of the motor functions.
+ */
+static esp_err_t Run_Autotune_Trial(uint32_t Frequency_Hz, uint32_t Acceleration, uint32_t Travel)
+{
+    uint64_t Steps = (((uint64_t)Frequency_Hz * Frequency_Hz) / Acceleration) + (Frequency_Hz / 10); // Both ramps and the cruise
+
+    Steps = (Steps > Travel) ? Travel : Steps;
+
+    esp_err_t Function_Error = Set_Stepper_Motor_Limits(Frequency_Hz, Acceleration);
+
+    Function_Error = (Function_Error == ESP_OK) ? Move_Stepper_Motor(Frequency_Hz, MOTOR_DIRECTION_FORWARD, (uint32_t)Steps, NULL) : Function_Error;
+    Function_Error = (Function_Error == ESP_OK) ? Move_Stepper_Motor(Frequency_Hz, MOTOR_DIRECTION_BACKWARD, (uint32_t)Steps, NULL) : Function_Error;
+
+    vTaskDelay(pdMS_TO_TICKS(MOTOR_ENCODER_AUTOTUNE_SETTLE_MS));
+
+    return Function_Error;
+}
+
+/**
+ * @brief Move back to where the encoder was at the start, gently, after a failed trial.
+ *
+ * @return Result of Move_Stepper_Motor(), ESP_OK if already there.
+ */
+static esp_err_t Return_To_Start(int32_t Start_Counts, const Autotune_Config_t *Config)
+{
+    int32_t Offset = Closed_Loop_Counts_To_Steps(&Monitor_Config, (int32_t)((uint32_t)Motor_Encoder_Get_Counts() - (uint32_t)Start_Counts));
+    esp_err_t Function_Error = Set_Stepper_Motor_Limits(Config->Start_Frequency_Hz, Config->Start_Acceleration);
+
+    if ((Function_Error == ESP_OK) && (Offset != 0))
+    {
+        uint32_t Steps = (Offset < 0) ? (uint32_t)(-(int64_t)Offset) : (uint32_t)Offset;
+
+        Function_Error = Move_Stepper_Motor(Config->Start_Frequency_Hz, (Offset < 0) ? MOTOR_DIRECTION_FORWARD : MOTOR_DIRECTION_BACKWARD, Steps, NULL);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Find the highest safe cruise frequency and acceleration and make them the limits.
+ *
+ * Runs in the task that executes the motion and blocks until the search
+ * ended, see closed_loop.h. Every trial moves forward and back by at most
+ * Travel steps, so the motor ends where it started. After a failed trial
+ * the motor is moved back to the start by the encoder count, at the start
+ * frequency; its position is then no longer referenced. The frequency
+ * trials are capped at what the start acceleration reaches within the
+ * travel. The found limits replace those of Set_Stepper_Motor_Limits(),
+ * the earlier ones are restored if the autotune fails. The result is kept
+ * for Motor_Encoder_Get_Autotune().
+ *
+ * @param Config Range and steps of the search, see Motor_Encoder_Get_Default_Autotune().
+ * @param Travel Longest trial move in steps.
+ * @param Save Also write the found limits to NVS.
+ * @return
+ *     - ESP_OK: Limits found and taken
+ *     - ESP_ERR_NOT_SUPPORTED: No active encoder
+ *     - ESP_ERR_INVALID_ARG: Travel of 0, range outside the jog limits or invalid search steps
+ *     - ESP_ERR_NOT_FOUND: Already the start frequency or acceleration failed
+ *     - ESP_ERR_INVALID_STATE: Stopped or aborted from outside
+ *     - Error of the motor functions or of the NVS write otherwise
+ */
+esp_err_t Motor_Encoder_Autotune(const Autotune_Config_t *Config, uint32_t Travel, bool Save)
+{
+    Motor_Encoder_Autotune_Report_t Report = {
+        .Result = ESP_OK,
+        .Travel = Travel,
+    };
+    Autotune_Config_t Bounded = *Config;
+    Autotune_Search_t Search;
+    uint32_t Saved_Frequency_Hz = 0;
+    uint32_t Saved_Acceleration = 0;
+    uint32_t Frequency_Hz = 0;
+    uint32_t Acceleration = 0;
+    int32_t Start_Counts = Motor_Encoder_Get_Counts();
+    uint32_t Reached_Hz = Motion_Math_Isqrt((uint64_t)Config->Start_Acceleration * Travel); // Peak of a triangular move over the travel
+
+    Bounded.Max_Frequency_Hz = (Reached_Hz < Config->Max_Frequency_Hz) ? Reached_Hz : Config->Max_Frequency_Hz;
+
+    if (!Encoder_Active)
+    {
+        Report.Result = ESP_ERR_NOT_SUPPORTED;
+    }
+    else if ((Travel == 0) || (Config->Start_Frequency_Hz < MOTION_JOG_MIN_FREQUENCY_HZ) || (Config->Max_Frequency_Hz > MOTION_JOG_MAX_FREQUENCY_HZ) ||
+             !Autotune_Begin(&Search, &Bounded))
+    {
+        Report.Result = ESP_ERR_INVALID_ARG;
+    }
+
+    if (Report.Result == ESP_OK)
+    {
+        Get_Stepper_Motor_Limits(&Saved_Frequency_Hz, &Saved_Acceleration);
+
+        while ((Report.Result == ESP_OK) && Autotune_Next_Trial(&Search, &Frequency_Hz, &Acceleration))
+        {
+            esp_err_t Trial_Error = Run_Autotune_Trial(Frequency_Hz, Acceleration, Travel);
+
+            if ((Stepper_Motor_Stop_Requested() != 0) || Stepper_Motor_Abort_Requested())
+            {
+                Report.Result = ESP_ERR_INVALID_STATE;
+            }
+            else if (Trial_Error == ESP_ERR_INVALID_RESPONSE)
+            {
+                Autotune_Report(&Search, false);
+
+                Report.Result = Return_To_Start(Start_Counts, &Bounded);
+            }
+            else if (Trial_Error != ESP_OK)
+            {
+                Report.Result = Trial_Error;
+            }
+            else
+            {
+                Autotune_Report(&Search, true);
+            }
+        }
+
+        Report.Trials = Search.Trials;
+        Report.Failed_Trials = Search.Failed_Trials;
+
+        if ((Report.Result == ESP_OK) && !Autotune_Result(&Search, &Report.Max_Frequency_Hz, &Report.Acceleration))
+        {
+            Report.Result = ESP_ERR_NOT_FOUND;
+        }
+
+        Report.Result = (Report.Result == ESP_OK) ? Set_Stepper_Motor_Limits(Report.Max_Frequency_Hz, Report.Acceleration) : Report.Result;
+
+        if (Report.Result != ESP_OK)
+        {
+            Set_Stepper_Motor_Limits(Saved_Frequency_Hz, Saved_Acceleration);
+        }
+        else if (Save)
+        {
+            Report.Result = Store_Limits(Report.Max_Frequency_Hz, Report.Acceleration);
+            Report.Saved = (Report.Result == ESP_OK);
+        }
+    }
+
+    portENTER_CRITICAL(&Encoder_Lock);
+    Last_Autotune = Report;
+    portEXIT_CRITICAL(&Encoder_Lock);
+
+    return Report.Result;
+}
+
+/**
+ * @brief Copy of the result of the last autotune.
+ */
+void Motor_Encoder_Get_Autotune(Motor_Encoder_Autotune_Report_t *Report)
+{
+    portENTER_CRITICAL(&Encoder_Lock);
+    *Report = Last_Autotune;
+    portEXIT_CRITICAL(&Encoder_Lock);
+}
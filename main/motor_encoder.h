@@ -0,0 +1,100 @@
+/*H**********************************************************************
+ * FILENAME :        motor_encoder.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Optional quadrature encoder of the single axis motor: following
+ *       error and stall detection during the moves, and the autotune of the
+ *       speed and acceleration limits, persisted in NVS.
+ *
+ * NOTES :
+ *       The encoder is counted on all four edges by MOTOR_ENCODER_PCNT_UNIT,
+ *       channel 0 counts the edges of A and channel 1 those of B, the level
+ *       of the other phase gives the direction. Build with
+ *       STEPPER_MOTOR_ENCODER=1 once an encoder is wired to the A and B pins.
+ *       Without it the moves are not monitored and the autotune is not
+ *       available, stored limits are still applied.
+ *
+ *       Every planned move and continuous run is monitored, see
+ *       closed_loop.h. With the LEDC pulse engine the position is compared
+ *       every MOTOR_ENCODER_CHECK_TICKS while the move runs and a fault
+ *       stops the output. The RMT and timer engines only count their steps
+ *       at the end, so their moves are compared once they ended. A move
+ *       with a fault returns ESP_ERR_INVALID_RESPONSE and the position is
+ *       no longer referenced.
+ *
+ *       The autotune runs trial moves forward and back at rising speeds and
+ *       accelerations until the monitor finds a fault, see
+ *       Motor_Encoder_Autotune().
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTOR_ENCODER_H
+#define MOTOR_ENCODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver/gpio.h"
+#include "driver/pcnt.h"
+#include "esp_err.h"
+#include "closed_loop.h"
+
+#ifndef STEPPER_MOTOR_ENCODER
+#define STEPPER_MOTOR_ENCODER 0 // 1 if a quadrature encoder is wired to MOTOR_ENCODER_A_PIN and MOTOR_ENCODER_B_PIN, may be given by the build
+#endif
+
+#define MOTOR_ENCODER_A_PIN GPIO_NUM_32        // Encoder phase A
+#define MOTOR_ENCODER_B_PIN GPIO_NUM_33        // Encoder phase B
+#define MOTOR_ENCODER_PCNT_UNIT PCNT_UNIT_1    // Counter unit of the encoder, unit 0 counts the steps
+#define MOTOR_ENCODER_PCNT_LIMIT 30000         // Counter range, every overflow is added by the interrupt
+#define MOTOR_ENCODER_FILTER 100               // Ignore glitches shorter than this many APB clock cycles
+#define MOTOR_ENCODER_COUNTS_PER_REV 4000      // Counts of one revolution, 1000 lines counted on all four edges
+#define MOTOR_FULL_STEPS_PER_REV 200           // Full steps of one revolution of the motor
+#define MOTOR_ENCODER_CHECK_TICKS 1            // RTOS ticks between two checks of a running LEDC move
+#define MOTOR_ENCODER_AUTOTUNE_TRAVEL 32000    // Default steps of one trial move
+#define MOTOR_ENCODER_AUTOTUNE_SETTLE_MS 200   // Standstill after a trial, the load settles
+#define MOTOR_ENCODER_NVS_NAMESPACE "autotune" // NVS namespace of the tuned limits
+#define MOTOR_ENCODER_NVS_VERSION 1            // Version of the stored limits
+
+/** State of the encoder and the monitor */
+typedef struct
+{
+    bool Active;                    // Encoder configured, moves are monitored
+    int32_t Counts;                 // Encoder count since start-up
+    int32_t Measured_Steps;         // Encoder count in steps
+    Closed_Loop_Config_t Config;    // Encoder and limits of the monitor
+    int32_t Error;                  // Commanded minus measured position at the last check
+    uint32_t Max_Error;             // Largest distance of the last monitored move
+    uint32_t Checks;                // Checks since start-up
+    uint32_t Moves;                 // Monitored moves since start-up
+    uint32_t Faults;                // Moves ended by a fault
+    Closed_Loop_Fault_t Last_Fault; // Fault of the last move with one, CLOSED_LOOP_OK if none yet
+} Motor_Encoder_Status_t;
+
+/** Result of the last autotune */
+typedef struct
+{
+    esp_err_t Result;          // Result of the autotune, ESP_ERR_INVALID_STATE before the first one
+    uint32_t Travel;           // Steps of one trial move
+    uint16_t Trials;           // Trials run
+    uint16_t Failed_Trials;    // Trials ended by a fault
+    uint32_t Max_Frequency_Hz; // Found frequency limit, margin applied
+    uint32_t Acceleration;     // Found acceleration limit, margin applied
+    bool Saved;                // Written to NVS
+} Motor_Encoder_Autotune_Report_t;
+
+esp_err_t Initialize_Motor_Encoder(void);
+bool Motor_Encoder_Active(void);
+int32_t Motor_Encoder_Get_Counts(void);
+void Motor_Encoder_Begin_Move(void);
+esp_err_t Motor_Encoder_Check(void);
+void Motor_Encoder_Get_Status(Motor_Encoder_Status_t *Encoder_Status);
+esp_err_t Motor_Encoder_Set_Limits(uint32_t Max_Frequency_Hz, uint32_t Acceleration, bool Save);
+void Motor_Encoder_Get_Default_Autotune(Autotune_Config_t *Config);
+esp_err_t Motor_Encoder_Autotune(const Autotune_Config_t *Config, uint32_t Travel, bool Save);
+void Motor_Encoder_Get_Autotune(Motor_Encoder_Autotune_Report_t *Report);
+
+#endif // MOTOR_ENCODER_H
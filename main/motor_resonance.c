@@ -0,0 +1,379 @@
+/*H**********************************************************************
+ * FILENAME :        motor_resonance.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Resonance bands of the single axis motor, persisted in NVS, and the
+ *       sweep that finds them.
+ *
+ * NOTES :
+ *       The table is read by the motion task for every move and written by
+ *       the console, a critical section keeps a copy consistent. The bands
+ *       are switched off while a sweep runs, so the sweep reaches the
+ *       frequencies it measures.
+ *
+ *       A point of the sweep is only counted once the velocity ramp reached
+ *       its frequency, the edges of the sense pin during the ramp are
+ *       ignored.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "motor_resonance.h"
+#include "main.h"
+#include "nvs.h"
+
+#define RESONANCE_NVS_KEY "bands" // NVS key of the table
+
+/** Table as stored in NVS */
+typedef struct
+{
+    uint32_t Version;        // RESONANCE_NVS_VERSION of the writer
+    Resonance_Table_t Table; // Stored table
+} Resonance_Record_t;
+
+static Resonance_Table_t Active_Table;                         // Bands avoided by the motor control
+static bool Sweeping = false;                                  // A sweep runs, the bands are not applied
+static portMUX_TYPE Table_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards Active_Table and Sweeping
+static uint32_t Sense_Count = 0;                               // Edges of the sense pin while armed, accessed atomically
+static bool Sense_Armed = false;                               // Sense edges are counted, accessed atomically
+static Resonance_Sweep_Report_t Last_Sweep = {                 // Measurements of the last sweep
+    .Result = ESP_ERR_INVALID_STATE,                           // No sweep since boot
+};
+
+/**
+ * @brief Edge interrupt of the sense pin, counts the edges of a sweep point.
+ */
+static void Resonance_Sense_ISR(void *arg)
+{
+    if (__atomic_load_n(&Sense_Armed, __ATOMIC_RELAXED))
+    {
+        __atomic_add_fetch(&Sense_Count, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Rebuild a table through Resonance_Add_Band(), so only sorted, valid bands are taken.
+ *
+ * @return false if a band was rejected.
+ */
+static bool Copy_Valid_Table(const Resonance_Table_t *Source, Resonance_Table_t *Table)
+{
+    bool Valid = Source->Band_Count <= RESONANCE_MAX_BANDS;
+
+    Resonance_Init_Table(Table);
+
+    Table->Crossing_Acceleration = Source->Crossing_Acceleration;
+
+    for (uint8_t Index = 0; Valid && (Index < Source->Band_Count); Index++)
+    {
+        Valid = Resonance_Add_Band(Table, Source->Bands[Index].Low_Hz, Source->Bands[Index].High_Hz);
+    }
+
+    return Valid;
+}
+
+/**
+ * @brief Configure the sense input and load the bands stored in NVS.
+ *
+ * Needs nvs_flash_init() to be called first. If the stored table cannot
+ * be read the motor starts without bands.
+ *
+ * @return
+ *     - Sum of the ESP return values of the sense input configuration
+ */
+esp_err_t Initialize_Motor_Resonance(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+    nvs_handle_t Handle = 0;
+    Resonance_Record_t Record;
+    size_t Length = sizeof(Record);
+
+    Resonance_Init_Table(&Active_Table);
+
+    esp_err_t Nvs_Error = nvs_open(RESONANCE_NVS_NAMESPACE, NVS_READONLY, &Handle);
+
+    if (Nvs_Error == ESP_OK)
+    {
+        Nvs_Error = nvs_get_blob(Handle, RESONANCE_NVS_KEY, &Record, &Length);
+
+        nvs_close(Handle);
+    }
+
+    if (Nvs_Error == ESP_OK)
+    {
+        if ((Length != sizeof(Record)) || (Record.Version != RESONANCE_NVS_VERSION) || !Copy_Valid_Table(&Record.Table, &Active_Table))
+        {
+            printf("Resonance: stored bands not valid, starting without bands\n");
+
+            Resonance_Init_Table(&Active_Table);
+        }
+    }
+    else if (Nvs_Error != ESP_ERR_NVS_NOT_FOUND)
+    {
+        printf("Resonance: NVS not readable, starting without bands\n");
+    }
+
+    // Configuration structure for the sense input
+    gpio_config_t io_conf = {}; // Zero-initialize the config structure
+
+    io_conf.intr_type = GPIO_INTR_POSEDGE;                // Count the rising edges
+    io_conf.mode = GPIO_MODE_INPUT;                       // Input only
+    io_conf.pin_bit_mask = (1ULL << RESONANCE_SENSE_PIN); // Sense pin
+    io_conf.pull_up_en = GPIO_PULLUP_DISABLE;             // Driven by the sensor
+    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;         // Driven by the sensor
+
+    Function_Error += gpio_config(&io_conf);
+
+    esp_err_t Service_Error = gpio_install_isr_service(0);
+
+    if (Service_Error != ESP_ERR_INVALID_STATE) // Already installed by someone else otherwise
+    {
+        Function_Error += Service_Error;
+    }
+
+    Function_Error += gpio_isr_handler_add(RESONANCE_SENSE_PIN, Resonance_Sense_ISR, NULL);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Copy of the bands avoided by the motor control.
+ */
+void Motor_Resonance_Get_Table(Resonance_Table_t *Table)
+{
+    portENTER_CRITICAL(&Table_Lock);
+    *Table = Active_Table;
+    portEXIT_CRITICAL(&Table_Lock);
+}
+
+/**
+ * @brief Replace the bands avoided by the motor control.
+ *
+ * Takes effect with the next planned move or velocity change.
+ *
+ * @param Table New bands.
+ * @param Persist Also write them to NVS.
+ * @return
+ *     - ESP_OK: Table taken, and stored if requested
+ *     - ESP_ERR_INVALID_ARG: Bands not sorted, overlapping or invalid, nothing is changed
+ *     - Error of the NVS access otherwise, the table is taken anyway
+ */
+esp_err_t Motor_Resonance_Set_Table(const Resonance_Table_t *Table, bool Persist)
+{
+    Resonance_Record_t Record;
+
+    memset(&Record, 0, sizeof(Record)); // Padding is written as well
+
+    if (!Copy_Valid_Table(Table, &Record.Table))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Record.Version = RESONANCE_NVS_VERSION;
+
+    portENTER_CRITICAL(&Table_Lock);
+    Active_Table = Record.Table;
+    portEXIT_CRITICAL(&Table_Lock);
+
+    if (!Persist)
+    {
+        return ESP_OK;
+    }
+
+    nvs_handle_t Handle = 0;
+    esp_err_t Function_Error = nvs_open(RESONANCE_NVS_NAMESPACE, NVS_READWRITE, &Handle);
+
+    if (Function_Error == ESP_OK)
+    {
+        Function_Error = nvs_set_blob(Handle, RESONANCE_NVS_KEY, &Record, sizeof(Record));
+        Function_Error = (Function_Error == ESP_OK) ? nvs_commit(Handle) : Function_Error;
+        nvs_close(Handle);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Nearest frequency outside the bands, see Resonance_Snap_Frequency().
+ *
+ * @return Frequency_Hz unchanged while a sweep runs.
+ */
+uint32_t Motor_Resonance_Snap(uint32_t Frequency_Hz)
+{
+    portENTER_CRITICAL(&Table_Lock);
+    uint32_t Snapped_Hz = Sweeping ? Frequency_Hz : Resonance_Snap_Frequency(&Active_Table, Frequency_Hz);
+    portEXIT_CRITICAL(&Table_Lock);
+
+    return Snapped_Hz;
+}
+
+/**
+ * @brief Let a planned profile cross the bands, see Resonance_Apply_To_Profile().
+ *
+ * Does nothing while a sweep runs.
+ */
+void Motor_Resonance_Apply(Motion_Profile_t *Profile)
+{
+    Resonance_Table_t Table;
+
+    portENTER_CRITICAL(&Table_Lock);
+    Table = Active_Table;
+    Table.Band_Count = Sweeping ? 0 : Table.Band_Count;
+    portEXIT_CRITICAL(&Table_Lock);
+
+    if (Table.Band_Count > 0)
+    {
+        Resonance_Apply_To_Profile(&Table, Profile);
+    }
+}
+
+/**
+ * @brief Fill a sweep configuration with the defaults of motor_resonance.h.
+ *
+ * The default range runs from the start/stop frequency to 10 kHz in 100 Hz
+ * steps, forward, without saving the result.
+ */
+void Motor_Resonance_Get_Default_Sweep(Resonance_Sweep_Config_t *Config)
+{
+    Config->Start_Hz = MOTION_JOG_MIN_FREQUENCY_HZ;
+    Config->End_Hz = 10000;
+    Config->Step_Hz = 100;
+    Config->Dwell_ms = RESONANCE_SWEEP_DWELL_MS;
+    Config->Threshold = RESONANCE_SWEEP_THRESHOLD;
+    Config->Direction = MOTOR_DIRECTION_FORWARD;
+    Config->Save = false;
+}
+
+/**
+ * @brief Ramp the running sweep to a frequency, one velocity update per RTOS tick.
+ *
+ * @return ESP_ERR_INVALID_STATE if stopped or aborted from outside, else the result of Set_Stepper_Motor_Velocity().
+ */
+static esp_err_t Ramp_Sweep_To(Velocity_Ramp_t *Ramp, int32_t Target_Hz)
+{
+    esp_err_t Function_Error = ESP_OK;
+    TickType_t Last_Update = xTaskGetTickCount();
+    int32_t Velocity = Get_Stepper_Motor_Velocity();
+
+    while ((Function_Error == ESP_OK) && (Velocity != Target_Hz))
+    {
+        if ((Stepper_Motor_Stop_Requested() != 0) || Stepper_Motor_Abort_Requested())
+        {
+            return ESP_ERR_INVALID_STATE;
+        }
+
+        vTaskDelay(1); // One update per RTOS tick
+
+        TickType_t Now = xTaskGetTickCount();
+
+        Velocity = Velocity_Ramp_Update(Ramp, Target_Hz, (uint32_t)(Now - Last_Update) * MOTION_SEGMENT_TIME_US);
+
+        Function_Error = Set_Stepper_Motor_Velocity(Velocity, PWM_DUTY_CYCLE_50);
+
+        Last_Update = Now;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Find the resonance bands of the motor and make them the active table.
+ *
+ * Runs in the task that executes the motion and blocks until the motor
+ * stands still again. The motor is ramped from point to point at the
+ * default acceleration and held at every one for the dwell time while the
+ * sense edges are counted. The counts are kept for
+ * Motor_Resonance_Get_Sweep(), also if the sweep fails; the table is only
+ * replaced by a complete sweep and keeps its crossing acceleration.
+ *
+ * @param Config Sweep parameters, see Motor_Resonance_Get_Default_Sweep().
+ * @return
+ *     - ESP_OK: Swept, the found bands are active
+ *     - ESP_ERR_INVALID_ARG: Range outside the jog limits, step of 0 or more than RESONANCE_SWEEP_MAX_POINTS points
+ *     - ESP_ERR_INVALID_STATE: Stopped or aborted from outside
+ *     - Error of the motor functions or of the NVS write otherwise
+ */
+esp_err_t Motor_Resonance_Sweep(const Resonance_Sweep_Config_t *Config)
+{
+    esp_err_t Function_Error = ESP_OK;
+    Resonance_Sweep_Report_t Report;
+    int32_t Toward = (Config->Direction == MOTOR_DIRECTION_FORWARD) ? 1 : -1;
+    Velocity_Ramp_t Ramp;
+
+    memset(&Report, 0, sizeof(Report));
+
+    Report.Start_Hz = Config->Start_Hz;
+    Report.Step_Hz = Config->Step_Hz;
+
+    if ((Config->Step_Hz == 0) || (Config->Start_Hz < MOTION_JOG_MIN_FREQUENCY_HZ) || (Config->End_Hz > MOTION_JOG_MAX_FREQUENCY_HZ) ||
+        (Config->End_Hz < Config->Start_Hz) || (((Config->End_Hz - Config->Start_Hz) / Config->Step_Hz) >= RESONANCE_SWEEP_MAX_POINTS))
+    {
+        Report.Result = ESP_ERR_INVALID_ARG;
+        Last_Sweep = Report;
+
+        return Report.Result;
+    }
+
+    portENTER_CRITICAL(&Table_Lock);
+    Sweeping = true;
+    portEXIT_CRITICAL(&Table_Lock);
+
+    Velocity_Ramp_Begin(&Ramp, Get_Stepper_Motor_Velocity(), MOTION_DEFAULT_ACCELERATION, MOTION_JOG_MIN_FREQUENCY_HZ);
+
+    for (uint32_t Frequency_Hz = Config->Start_Hz; (Function_Error == ESP_OK) && (Frequency_Hz <= Config->End_Hz); Frequency_Hz += Config->Step_Hz)
+    {
+        Function_Error = Ramp_Sweep_To(&Ramp, Toward * (int32_t)Frequency_Hz);
+
+        if (Function_Error != ESP_OK)
+        {
+            break;
+        }
+
+        __atomic_store_n(&Sense_Count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&Sense_Armed, true, __ATOMIC_RELEASE);
+
+        vTaskDelay(pdMS_TO_TICKS(Config->Dwell_ms)); // Count at the reached frequency
+
+        __atomic_store_n(&Sense_Armed, false, __ATOMIC_RELEASE);
+
+        Report.Counts[Report.Points++] = __atomic_load_n(&Sense_Count, __ATOMIC_RELAXED);
+
+        Function_Error = ((Stepper_Motor_Stop_Requested() != 0) || Stepper_Motor_Abort_Requested()) ? ESP_ERR_INVALID_STATE : ESP_OK;
+    }
+
+    Function_Error += Decelerate_Stepper_Motor(NULL); // Ramps down under a pending stop, takes the count into the position
+
+    portENTER_CRITICAL(&Table_Lock);
+    Sweeping = false;
+    portEXIT_CRITICAL(&Table_Lock);
+
+    if (Function_Error == ESP_OK)
+    {
+        Resonance_Table_t Table;
+
+        Motor_Resonance_Get_Table(&Table);
+
+        Report.Bands_Found = Resonance_Find_Bands(Report.Counts, Report.Points, Config->Start_Hz, Config->Step_Hz, Config->Threshold, &Table);
+
+        Function_Error = Motor_Resonance_Set_Table(&Table, Config->Save);
+    }
+
+    Report.Result = Function_Error;
+    Last_Sweep = Report;
+
+    return Function_Error;
+}
+
+/**
+ * @brief Measurements of the last sweep.
+ *
+ * @param Report Output copy, Result is ESP_ERR_INVALID_STATE if there was no sweep since boot.
+ */
+void Motor_Resonance_Get_Sweep(Resonance_Sweep_Report_t *Report)
+{
+    *Report = Last_Sweep;
+}
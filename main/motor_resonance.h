@@ -0,0 +1,74 @@
+/*H**********************************************************************
+ * FILENAME :        motor_resonance.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Resonance bands of the single axis motor, persisted in NVS, and the
+ *       sweep that finds them.
+ *
+ * NOTES :
+ *       The motor control snaps every cruise frequency out of the bands and
+ *       lets every planned ramp cross them at the crossing acceleration,
+ *       see resonance.h. A jog or a velocity ramp changes its frequency once
+ *       per RTOS tick and jumps across a band from edge to edge.
+ *
+ *       The sweep runs the motor through a range of frequencies and counts
+ *       the edges of RESONANCE_SENSE_PIN at every one of them. The pin is
+ *       driven by a vibration sensor, e.g. the threshold output of an
+ *       accelerometer, or by the stall output of the driver. Frequencies
+ *       with at least the threshold count become the new bands.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTOR_RESONANCE_H
+#define MOTOR_RESONANCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver/gpio.h"
+#include "esp_err.h"
+#include "resonance.h"
+
+#define RESONANCE_SENSE_PIN GPIO_NUM_34     // Vibration sense input, input only pad without pulls
+#define RESONANCE_SWEEP_MAX_POINTS 64       // Frequencies of one sweep
+#define RESONANCE_SWEEP_DWELL_MS 200        // Default time the sense edges are counted at every frequency
+#define RESONANCE_SWEEP_THRESHOLD 4         // Default sense edges marking a resonant frequency
+#define RESONANCE_NVS_NAMESPACE "resonance" // NVS namespace of the table
+#define RESONANCE_NVS_VERSION 1             // Version of the stored table
+
+/** Parameters of one sweep */
+typedef struct
+{
+    uint32_t Start_Hz;  // First frequency, at least MOTION_JOG_MIN_FREQUENCY_HZ
+    uint32_t End_Hz;    // Last frequency, at most MOTION_JOG_MAX_FREQUENCY_HZ
+    uint32_t Step_Hz;   // Frequency increment
+    uint32_t Dwell_ms;  // Time the sense edges are counted at every frequency
+    uint32_t Threshold; // Sense edges marking a resonant frequency
+    uint8_t Direction;  // Direction of the run, MOTOR_DIRECTION_FORWARD or MOTOR_DIRECTION_BACKWARD
+    bool Save;          // Write the found bands to NVS
+} Resonance_Sweep_Config_t;
+
+/** Measurements of the last sweep */
+typedef struct
+{
+    esp_err_t Result;                            // Result of the sweep
+    uint32_t Start_Hz;                           // Frequency of the first point
+    uint32_t Step_Hz;                            // Frequency increment between the points
+    uint16_t Points;                             // Points measured
+    uint32_t Counts[RESONANCE_SWEEP_MAX_POINTS]; // Sense edges counted at every point
+    uint8_t Bands_Found;                         // Bands found, also those that did not fit the table
+} Resonance_Sweep_Report_t;
+
+esp_err_t Initialize_Motor_Resonance(void);
+void Motor_Resonance_Get_Table(Resonance_Table_t *Table);
+esp_err_t Motor_Resonance_Set_Table(const Resonance_Table_t *Table, bool Persist);
+uint32_t Motor_Resonance_Snap(uint32_t Frequency_Hz);
+void Motor_Resonance_Apply(Motion_Profile_t *Profile);
+void Motor_Resonance_Get_Default_Sweep(Resonance_Sweep_Config_t *Config);
+esp_err_t Motor_Resonance_Sweep(const Resonance_Sweep_Config_t *Config);
+void Motor_Resonance_Get_Sweep(Resonance_Sweep_Report_t *Report);
+
+#endif // MOTOR_RESONANCE_H
@@ -0,0 +1,496 @@
+/*H**********************************************************************
+ * FILENAME :        motor_script.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Cache of compiled motion scripts and their executor on the single
+ *       axis motor.
+ *
+ * NOTES :
+ *       The console loads and compiles scripts, the motion task executes
+ *       them. A slot is marked running for the time of a run and is never
+ *       replaced while it runs; a handle whose slot was compiled again
+ *       since is refused by Motor_Script_Run(), so a queued run never
+ *       executes another script than the one it was queued for.
+ *
+ *       A file counts as unchanged while its size and modification time
+ *       stay the same, SPIFFS keeps the time with CONFIG_SPIFFS_USE_MTIME.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include <sys/stat.h>
+#include "motor_script.h"
+#include "main.h"
+#include "esp_timer.h"
+#ifndef STEPPER_HOST_SIM // The host simulator reads the scripts from the host file system
+#include "esp_spiffs.h"
+#endif
+
+/** One slot of the cache */
+typedef struct
+{
+    char Path[MOTOR_SCRIPT_MAX_PATH]; // File the script was compiled from
+    off_t Size;                       // Size of the file when compiled
+    time_t Modified;                  // Modification time of the file when compiled
+    uint32_t Generation;              // Compilation held, 0 for an empty slot
+    uint32_t Last_Used;               // Load counter at the last use, the oldest slot is replaced first
+    bool Running;                     // The motion task executes the script
+    Motion_Script_t Script;           // Bytecode
+    Motor_Script_Stats_t Stats;       // Summary and run timing
+} Motor_Script_Slot_t;
+
+static Motor_Script_Slot_t Slots[MOTOR_SCRIPT_CACHE_SLOTS];    // Compiled scripts
+static uint32_t Next_Generation = 1;                           // Generation of the next compilation
+static uint32_t Use_Counter = 0;                               // Loads since boot
+static portMUX_TYPE Cache_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards the slots
+static char Text[MOTOR_SCRIPT_MAX_TEXT + 1];                   // File text while compiling, console task only
+static Motion_Script_t Compiled;                               // Compilation before it is copied to a slot, console task only
+
+/**
+ * @brief Mount the script partition.
+ *
+ * An empty partition is formatted. Without a script partition in the
+ * partition table the motor control runs without scripts.
+ *
+ * @return
+ *     - ESP_OK: Mounted, or no script partition
+ *     - Error of esp_vfs_spiffs_register() otherwise
+ */
+esp_err_t Initialize_Motor_Script(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+#ifndef STEPPER_HOST_SIM
+    esp_vfs_spiffs_conf_t Config = {
+        .base_path = MOTOR_SCRIPT_BASE_PATH,       // Mount point
+        .partition_label = MOTOR_SCRIPT_PARTITION, // Script partition
+        .max_files = MOTOR_SCRIPT_MAX_FILES,       // Files open at the same time
+        .format_if_mount_failed = true,            // Start a partition that was never flashed empty
+    };
+
+    Function_Error = esp_vfs_spiffs_register(&Config);
+
+    if (Function_Error == ESP_ERR_NOT_FOUND)
+    {
+        printf("Script: no '%s' partition, scripts are not available\n", MOTOR_SCRIPT_PARTITION);
+
+        Function_Error = ESP_OK;
+    }
+#endif
+
+    return Function_Error;
+}
+
+/**
+ * @brief Find the slot holding a file, under Cache_Lock.
+ *
+ * @return The slot index, MOTOR_SCRIPT_CACHE_SLOTS if the file is not cached.
+ */
+static uint8_t Find_Slot(const char *Path)
+{
+    for (uint8_t Slot = 0; Slot < MOTOR_SCRIPT_CACHE_SLOTS; Slot++)
+    {
+        if ((Slots[Slot].Generation != 0) && (strcmp(Slots[Slot].Path, Path) == 0))
+        {
+            return Slot;
+        }
+    }
+
+    return MOTOR_SCRIPT_CACHE_SLOTS;
+}
+
+/**
+ * @brief Slot a new file is compiled into, under Cache_Lock: an empty one, else the least recently used one not running.
+ *
+ * @return The slot index, MOTOR_SCRIPT_CACHE_SLOTS if every slot runs.
+ */
+static uint8_t Free_Slot(void)
+{
+    uint8_t Oldest = MOTOR_SCRIPT_CACHE_SLOTS;
+
+    for (uint8_t Slot = 0; Slot < MOTOR_SCRIPT_CACHE_SLOTS; Slot++)
+    {
+        if (Slots[Slot].Generation == 0)
+        {
+            return Slot;
+        }
+
+        if (!Slots[Slot].Running && ((Oldest == MOTOR_SCRIPT_CACHE_SLOTS) || ((int32_t)(Slots[Slot].Last_Used - Slots[Oldest].Last_Used) < 0)))
+        {
+            Oldest = Slot;
+        }
+    }
+
+    return Oldest;
+}
+
+/**
+ * @brief Read a script file into Text.
+ *
+ * @return
+ *     - ESP_OK: Read, Length holds its size
+ *     - ESP_ERR_INVALID_SIZE: Larger than MOTOR_SCRIPT_MAX_TEXT
+ *     - ESP_ERR_NOT_FOUND: Not readable
+ */
+static esp_err_t Read_Script_File(const char *Path, size_t *Length)
+{
+    FILE *File = fopen(Path, "rb");
+
+    if (File == NULL)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    *Length = fread(Text, 1, sizeof(Text), File);
+
+    bool Read_Error = ferror(File) != 0;
+
+    fclose(File);
+
+    if (Read_Error)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    return (*Length > MOTOR_SCRIPT_MAX_TEXT) ? ESP_ERR_INVALID_SIZE : ESP_OK;
+}
+
+/**
+ * @brief Get a script from the cache, compiling the file if it is not cached or changed.
+ *
+ * Called from the console task only, the file text and the compilation
+ * are kept in static buffers. A changed file is compiled into its old
+ * slot unless that slot runs at the moment.
+ *
+ * @param Path Full path of the script file.
+ * @param Handle Returns the reference to the compiled script.
+ * @param Error Returns the compile error, Message is NULL for errors of the file; may be NULL.
+ * @return
+ *     - ESP_OK: Compiled or taken from the cache
+ *     - ESP_ERR_INVALID_ARG: Path too long, or the script has an error
+ *     - ESP_ERR_NOT_FOUND: File not readable
+ *     - ESP_ERR_INVALID_SIZE: File larger than MOTOR_SCRIPT_MAX_TEXT
+ *     - ESP_ERR_INVALID_STATE: The slot to compile into runs the script right now
+ */
+esp_err_t Motor_Script_Load(const char *Path, Motor_Script_Handle_t *Handle, Motion_Script_Error_t *Error)
+{
+    esp_err_t Function_Error = ESP_OK;
+    Motion_Script_Error_t Compile_Error = {0, NULL};
+    struct stat Info;
+    size_t Length = 0;
+    uint8_t Slot;
+
+    if (strlen(Path) >= MOTOR_SCRIPT_MAX_PATH)
+    {
+        Function_Error = ESP_ERR_INVALID_ARG;
+    }
+    else if (stat(Path, &Info) != 0)
+    {
+        Function_Error = ESP_ERR_NOT_FOUND;
+    }
+
+    if (Function_Error == ESP_OK)
+    {
+        portENTER_CRITICAL(&Cache_Lock);
+        Slot = Find_Slot(Path);
+
+        bool Hit = (Slot < MOTOR_SCRIPT_CACHE_SLOTS) && (Slots[Slot].Size == Info.st_size) && (Slots[Slot].Modified == Info.st_mtime);
+
+        if (Hit)
+        {
+            Slots[Slot].Last_Used = ++Use_Counter;
+
+            Handle->Slot = Slot;
+            Handle->Generation = Slots[Slot].Generation;
+            Handle->Cached = true;
+        }
+        portEXIT_CRITICAL(&Cache_Lock);
+
+        if (Hit)
+        {
+            if (Error != NULL)
+            {
+                *Error = Compile_Error;
+            }
+
+            return ESP_OK;
+        }
+
+        Function_Error = Read_Script_File(Path, &Length);
+    }
+
+    if ((Function_Error == ESP_OK) && !Motion_Script_Compile(Text, Length, &Compiled, &Compile_Error))
+    {
+        Function_Error = ESP_ERR_INVALID_ARG;
+    }
+
+    if (Function_Error == ESP_OK)
+    {
+        portENTER_CRITICAL(&Cache_Lock);
+        Slot = Find_Slot(Path);
+
+        uint32_t Compiles = (Slot < MOTOR_SCRIPT_CACHE_SLOTS) ? Slots[Slot].Stats.Compiles : 0;
+
+        Slot = (Slot < MOTOR_SCRIPT_CACHE_SLOTS) ? Slot : Free_Slot();
+
+        if ((Slot >= MOTOR_SCRIPT_CACHE_SLOTS) || Slots[Slot].Running)
+        {
+            Function_Error = ESP_ERR_INVALID_STATE;
+        }
+        else
+        {
+            Motor_Script_Slot_t *Entry = &Slots[Slot];
+
+            strcpy(Entry->Path, Path);
+            Entry->Size = Info.st_size;
+            Entry->Modified = Info.st_mtime;
+            Entry->Generation = Next_Generation++;
+            Entry->Last_Used = ++Use_Counter;
+            Entry->Script = Compiled; // Bytecode copy, at most MOTION_SCRIPT_MAX_OPS operations
+
+            memset(&Entry->Stats, 0, sizeof(Entry->Stats));
+            Entry->Stats.Op_Count = Compiled.Op_Count;
+            Entry->Stats.Moves_Per_Run = Compiled.Moves_Per_Run;
+            Entry->Stats.Steps_Per_Run = Compiled.Steps_Per_Run;
+            Entry->Stats.Dwell_ms_Per_Run = Compiled.Dwell_ms_Per_Run;
+            Entry->Stats.Compiles = Compiles + 1;
+            Entry->Stats.Last_Error = ESP_ERR_INVALID_STATE; // Not run yet
+
+            Handle->Slot = Slot;
+            Handle->Generation = Entry->Generation;
+            Handle->Cached = false;
+        }
+        portEXIT_CRITICAL(&Cache_Lock);
+    }
+
+    if (Error != NULL)
+    {
+        *Error = Compile_Error;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Execute the bytecode once.
+ *
+ * @param Script Compiled script.
+ * @param Executed_Steps Returns the steps emitted by the moves.
+ * @return ESP_ERR_INVALID_STATE if stopped or aborted from outside, else the result of the motor functions.
+ */
+static esp_err_t Execute_Script(const Motion_Script_t *Script, uint64_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+    uint32_t Remaining[MOTION_SCRIPT_MAX_DEPTH]; // Repetitions left of every open loop
+    uint8_t Depth = 0;
+    uint32_t Speed_Hz = MOTION_SCRIPT_DEFAULT_SPEED_HZ;
+    uint16_t Next = 0;
+
+    *Executed_Steps = 0;
+
+    while ((Function_Error == ESP_OK) && (Next < Script->Op_Count))
+    {
+        const Motion_Script_Op_t *Op = &Script->Ops[Next++];
+        uint32_t Steps = 0;
+
+        switch (Op->Opcode)
+        {
+        case MOTION_SCRIPT_OP_SPEED:
+            Speed_Hz = (uint32_t)Op->Argument;
+            break;
+
+        case MOTION_SCRIPT_OP_MOVE:
+            if (Op->Argument > 0)
+            {
+                Function_Error = Move_Stepper_Motor(Speed_Hz, MOTOR_DIRECTION_FORWARD, (uint32_t)Op->Argument, &Steps);
+            }
+            else
+            {
+                Function_Error = Move_Stepper_Motor(Speed_Hz, MOTOR_DIRECTION_BACKWARD, (uint32_t)(-Op->Argument), &Steps);
+            }
+            break;
+
+        case MOTION_SCRIPT_OP_MOVE_TO:
+            Function_Error = Move_Stepper_Motor_To(Speed_Hz, Op->Argument, &Steps);
+            break;
+
+        case MOTION_SCRIPT_OP_DWELL:
+            vTaskDelay(pdMS_TO_TICKS((uint32_t)Op->Argument));
+            break;
+
+        case MOTION_SCRIPT_OP_LOOP:
+            Remaining[Depth++] = (uint32_t)Op->Argument; // Nesting checked by the compiler
+            break;
+
+        case MOTION_SCRIPT_OP_END:
+            if (--Remaining[Depth - 1] > 0)
+            {
+                Next = (uint16_t)Op->Argument; // Body again
+            }
+            else
+            {
+                Depth--;
+            }
+            break;
+
+        default:
+            Function_Error = ESP_ERR_INVALID_ARG;
+            break;
+        }
+
+        *Executed_Steps += Steps;
+
+        if ((Function_Error == ESP_OK) && ((Stepper_Motor_Stop_Requested() != 0) || Stepper_Motor_Abort_Requested()))
+        {
+            Function_Error = ESP_ERR_INVALID_STATE;
+        }
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Run a cached script, repeated back to back.
+ *
+ * Runs in the task that executes the motion and blocks until the last
+ * run ended. Every run is timed from its first to its last operation and
+ * counted in the statistics of the slot. A stop or an abort ends the
+ * script after the operation it arrived in.
+ *
+ * @param Handle Script from Motor_Script_Load().
+ * @param Repeat Runs to execute.
+ * @param Executed_Steps Returns the steps emitted by all runs, saturated; may be NULL.
+ * @return
+ *     - ESP_OK: Every run finished
+ *     - ESP_ERR_INVALID_STATE: The slot was compiled again since the handle was taken, or stopped or aborted from outside
+ *     - Error of the motor functions otherwise
+ */
+esp_err_t Motor_Script_Run(const Motor_Script_Handle_t *Handle, uint32_t Repeat, uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+    uint64_t Total_Steps = 0;
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = 0;
+    }
+
+    if (Handle->Slot >= MOTOR_SCRIPT_CACHE_SLOTS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Motor_Script_Slot_t *Entry = &Slots[Handle->Slot];
+
+    portENTER_CRITICAL(&Cache_Lock);
+    bool Valid = (Entry->Generation == Handle->Generation) && !Entry->Running;
+
+    Entry->Running = Entry->Running || Valid;
+    portEXIT_CRITICAL(&Cache_Lock);
+
+    if (!Valid)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (uint32_t Run = 0; (Function_Error == ESP_OK) && (Run < Repeat); Run++)
+    {
+        uint64_t Steps = 0;
+        int64_t Start_us = esp_timer_get_time();
+
+        Function_Error = Execute_Script(&Entry->Script, &Steps);
+
+        uint64_t Run_us = (uint64_t)(esp_timer_get_time() - Start_us);
+
+        Total_Steps += Steps;
+
+        portENTER_CRITICAL(&Cache_Lock);
+        Motor_Script_Stats_t *Stats = &Entry->Stats;
+
+        if (Function_Error == ESP_OK)
+        {
+            Stats->Min_Run_us = ((Stats->Runs == 0) || (Run_us < Stats->Min_Run_us)) ? Run_us : Stats->Min_Run_us;
+            Stats->Max_Run_us = (Run_us > Stats->Max_Run_us) ? Run_us : Stats->Max_Run_us;
+            Stats->Sum_Run_us += Run_us;
+            Stats->Runs++;
+        }
+        else
+        {
+            Stats->Failed_Runs++;
+        }
+
+        Stats->Last_Run_us = Run_us;
+        Stats->Executed_Steps += Steps;
+        Stats->Last_Error = Function_Error;
+        portEXIT_CRITICAL(&Cache_Lock);
+    }
+
+    portENTER_CRITICAL(&Cache_Lock);
+    Entry->Running = false;
+    portEXIT_CRITICAL(&Cache_Lock);
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = (Total_Steps > UINT32_MAX) ? UINT32_MAX : (uint32_t)Total_Steps;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Summary and run timing of a cached script.
+ *
+ * @return ESP_ERR_INVALID_STATE if the slot was compiled again since the handle was taken.
+ */
+esp_err_t Motor_Script_Get_Stats(const Motor_Script_Handle_t *Handle, Motor_Script_Stats_t *Stats)
+{
+    esp_err_t Function_Error = ESP_ERR_INVALID_STATE;
+
+    if (Handle->Slot >= MOTOR_SCRIPT_CACHE_SLOTS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&Cache_Lock);
+    if (Slots[Handle->Slot].Generation == Handle->Generation)
+    {
+        *Stats = Slots[Handle->Slot].Stats;
+        Function_Error = ESP_OK;
+    }
+    portEXIT_CRITICAL(&Cache_Lock);
+
+    return Function_Error;
+}
+
+/**
+ * @brief One operation of a cached script, for listings.
+ *
+ * @return ESP_ERR_INVALID_STATE if the slot was compiled again since the handle was taken, ESP_ERR_INVALID_ARG past the last operation.
+ */
+esp_err_t Motor_Script_Get_Op(const Motor_Script_Handle_t *Handle, uint16_t Index, Motion_Script_Op_t *Op)
+{
+    esp_err_t Function_Error = ESP_ERR_INVALID_STATE;
+
+    if (Handle->Slot >= MOTOR_SCRIPT_CACHE_SLOTS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&Cache_Lock);
+    if (Slots[Handle->Slot].Generation == Handle->Generation)
+    {
+        Function_Error = (Index < Slots[Handle->Slot].Script.Op_Count) ? ESP_OK : ESP_ERR_INVALID_ARG;
+
+        if (Function_Error == ESP_OK)
+        {
+            *Op = Slots[Handle->Slot].Script.Ops[Index];
+        }
+    }
+    portEXIT_CRITICAL(&Cache_Lock);
+
+    return Function_Error;
+}
@@ -0,0 +1,73 @@
+/*H**********************************************************************
+ * FILENAME :        motor_script.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Cache of compiled motion scripts and their executor on the single
+ *       axis motor.
+ *
+ * NOTES :
+ *       Scripts are read from the SPIFFS partition MOTOR_SCRIPT_PARTITION,
+ *       mounted at MOTOR_SCRIPT_BASE_PATH and flashed from the scripts/
+ *       directory of the project. A script is compiled once, see
+ *       motion_script.h, and kept in one of MOTOR_SCRIPT_CACHE_SLOTS slots
+ *       until the file changes, so repeated runs neither read nor parse
+ *       the text again.
+ *
+ *       Motor_Script_Run() executes the bytecode in the motion task, the
+ *       moves follow each other without a console or a queue in between.
+ *       Every run is timed and the timing is kept per slot.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MOTOR_SCRIPT_H
+#define MOTOR_SCRIPT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "motion_script.h"
+
+#define MOTOR_SCRIPT_BASE_PATH "/scripts" // Mount point of the script partition
+#define MOTOR_SCRIPT_PARTITION "storage"  // Label of the SPIFFS partition, see partitions.csv
+#define MOTOR_SCRIPT_MAX_FILES 2          // Files open at the same time on the partition
+#define MOTOR_SCRIPT_CACHE_SLOTS 4        // Compiled scripts kept in RAM
+#define MOTOR_SCRIPT_MAX_TEXT 4096        // Largest script file in bytes
+#define MOTOR_SCRIPT_MAX_PATH 64          // Longest path of a script, NUL included
+
+/** Reference to a compiled script in the cache */
+typedef struct
+{
+    uint8_t Slot;        // Cache slot of the script
+    uint32_t Generation; // Compilation the reference was taken from, a later one invalidates it
+    bool Cached;         // Taken from the cache without reading the file
+} Motor_Script_Handle_t;
+
+/** Summary and run timing of a cached script */
+typedef struct
+{
+    uint16_t Op_Count;         // Operations of the bytecode
+    uint32_t Moves_Per_Run;    // Moves of one run, see Motion_Script_t
+    uint64_t Steps_Per_Run;    // Steps of the relative moves of one run, see Motion_Script_t
+    uint64_t Dwell_ms_Per_Run; // Dwell time of one run
+    uint32_t Compiles;         // Times the file was compiled into the slot
+    uint32_t Runs;             // Complete runs since the last compile
+    uint32_t Failed_Runs;      // Runs ended by an error, a stop or an abort
+    uint64_t Min_Run_us;       // Shortest complete run
+    uint64_t Max_Run_us;       // Longest complete run
+    uint64_t Sum_Run_us;       // Time of all complete runs
+    uint64_t Last_Run_us;      // Time of the last run, also a failed one
+    uint64_t Executed_Steps;   // Steps emitted by all runs
+    esp_err_t Last_Error;      // Result of the last run
+} Motor_Script_Stats_t;
+
+esp_err_t Initialize_Motor_Script(void);
+esp_err_t Motor_Script_Load(const char *Path, Motor_Script_Handle_t *Handle, Motion_Script_Error_t *Error);
+esp_err_t Motor_Script_Run(const Motor_Script_Handle_t *Handle, uint32_t Repeat, uint32_t *Executed_Steps);
+esp_err_t Motor_Script_Get_Stats(const Motor_Script_Handle_t *Handle, Motor_Script_Stats_t *Stats);
+esp_err_t Motor_Script_Get_Op(const Motor_Script_Handle_t *Handle, uint16_t Index, Motion_Script_Op_t *Op);
+
+#endif // MOTOR_SCRIPT_H
@@ -0,0 +1,385 @@
+/*H**********************************************************************
+ * FILENAME :        multi_axis.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Timer driven step generator for coordinated multi-axis moves.
+ *
+ * NOTES :
+ *       The step timer runs with auto reload and fires twice per pulse
+ *       item of the profile encoder: at the rising edge, where the pulse
+ *       pins of the stepping axes are raised, and at the falling edge,
+ *       where they are cleared and the next interpolator tick is computed
+ *       and its direction pins written, a whole low time ahead of its step.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "multi_axis.h"
+#include "main.h"
+#include "segment_encoder.h"
+#include "soc/gpio_struct.h"
+#include "soc/gpio_sig_map.h"
+#include "esp32/rom/gpio.h"
+#include "esp_timer.h"
+
+_Static_assert((MULTI_AXIS_COUNT >= 2) && (MULTI_AXIS_COUNT <= DDA_MAX_AXES), "MULTI_AXIS_COUNT out of range");
+_Static_assert((STEPPER_MOTOR_PUL_PIN < 32) && (AXIS_Y_PUL_PIN < 32) && (AXIS_Z_PUL_PIN < 32) && (AXIS_A_PUL_PIN < 32), "Pulse pins must be in the first GPIO output register");
+_Static_assert((STEPPER_MOTOR_DIR_PIN < 32) && (AXIS_Y_DIR_PIN < 32) && (AXIS_Z_DIR_PIN < 32) && (AXIS_A_DIR_PIN < 32), "Direction pins must be in the first GPIO output register");
+
+static const gpio_num_t Axis_Pul_Pins[DDA_MAX_AXES] = {STEPPER_MOTOR_PUL_PIN, AXIS_Y_PUL_PIN, AXIS_Z_PUL_PIN, AXIS_A_PUL_PIN}; // Pulse pins of X, Y, Z and A
+static const gpio_num_t Axis_Dir_Pins[DDA_MAX_AXES] = {STEPPER_MOTOR_DIR_PIN, AXIS_Y_DIR_PIN, AXIS_Z_DIR_PIN, AXIS_A_DIR_PIN}; // Direction pins of X, Y, Z and A
+
+static uint32_t Pul_Pin_Masks[DDA_MAX_AXES];                          // GPIO output register bit of every pulse pin
+static uint32_t Dir_Pin_Masks[DDA_MAX_AXES];                          // GPIO output register bit of every direction pin
+static Multi_Axis_Path_t Path;                                        // Path of the running move
+static Segment_Encoder_t Encoder;                                     // Timing of the running move
+static uint32_t Pending_Pul_Mask = 0;                                 // Pulse pins to raise on the next step
+static Pulse_Item_t Current_Item;                                     // Pulse item being emitted
+static bool Rising_Edge_Next = true;                                  // Which half of the pulse item the next alarm starts
+static TaskHandle_t Waiting_Task = NULL;                              // Task waiting for the end of the move
+static portMUX_TYPE Interpolator_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards the path and encoder between the timer interrupt and an abort
+
+/**
+ * @brief Run one interpolator tick and convert it to pin masks.
+ *
+ * @param Dir_Set Returns the direction pins to drive high.
+ * @param Dir_Clear Returns the direction pins to drive low.
+ * @return Pulse pins of the axes stepping in this tick.
+ */
+static uint32_t Interpolate_Tick(uint32_t *Dir_Set, uint32_t *Dir_Clear)
+{
+    uint8_t Direction_Mask = 0;
+    uint8_t Step_Mask = Path.Arc ? DDA_Arc_Step(&Path.Circle, &Direction_Mask) : DDA_Line_Step(&Path.Line, &Direction_Mask);
+    uint32_t Pul_Mask = 0;
+
+    *Dir_Set = 0;
+    *Dir_Clear = 0;
+
+    for (uint8_t Axis = 0; Axis < MULTI_AXIS_COUNT; Axis++)
+    {
+        if ((Step_Mask & (1U << Axis)) == 0)
+        {
+            continue; // Direction of an idle axis is left alone
+        }
+
+        Pul_Mask |= Pul_Pin_Masks[Axis];
+
+        if (Direction_Mask & (1U << Axis))
+        {
+            *Dir_Clear |= Dir_Pin_Masks[Axis]; // Negative direction, DIR low like MOTOR_DIRECTION_BACKWARD
+        }
+        else
+        {
+            *Dir_Set |= Dir_Pin_Masks[Axis];
+        }
+    }
+
+    return Pul_Mask;
+}
+
+/**
+ * @brief Compute the next tick and write its direction pins.
+ *
+ * Every output register is written once, so the pulse pins to lower can be
+ * cleared in the same write as the direction pins going low.
+ *
+ * @param Pul_Clear Pulse pins of the previous tick to drive low.
+ */
+static void Prepare_Next_Step(uint32_t Pul_Clear)
+{
+    uint32_t Dir_Set = 0;
+    uint32_t Dir_Clear = 0;
+
+    Pending_Pul_Mask = Interpolate_Tick(&Dir_Set, &Dir_Clear);
+
+    GPIO.out_w1tc = Pul_Clear | Dir_Clear;
+    GPIO.out_w1ts = Dir_Set;
+}
+
+/**
+ * @brief Step timer interrupt, starts one half of a pulse item per alarm.
+ */
+static void Multi_Axis_Timer_ISR(void *arg)
+{
+    uint32_t Alarm_Ticks = 0;   // Duration of the half that starts now
+    BaseType_t Woken = pdFALSE; // Set if the notified task should run next
+
+    timer_group_clr_intr_status_in_isr(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX);
+
+    portENTER_CRITICAL_ISR(&Interpolator_Lock);
+
+    if (Rising_Edge_Next)
+    {
+        if (Segment_Encoder_Fill(&Encoder, &Current_Item, 1, NULL) == 0)
+        {
+            // Profile done or aborted, stop the timer and wake the task
+            timer_group_set_counter_enable_in_isr(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX, TIMER_PAUSE);
+
+            portEXIT_CRITICAL_ISR(&Interpolator_Lock);
+
+            if (Waiting_Task != NULL)
+            {
+                xTaskNotifyFromISR(Waiting_Task, MULTI_AXIS_NOTIFY_DONE, eSetBits, &Woken);
+            }
+
+            if (Woken == pdTRUE)
+            {
+                portYIELD_FROM_ISR();
+            }
+
+            return;
+        }
+
+        if (Current_Item.Level0)
+        {
+            GPIO.out_w1ts = Pending_Pul_Mask; // All stepping axes rise together
+        }
+
+        Alarm_Ticks = Current_Item.Duration0;
+    }
+    else
+    {
+        if (Current_Item.Level0)
+        {
+            Prepare_Next_Step(Pending_Pul_Mask); // Pulse falls, directions of the next tick are set up
+        }
+
+        Alarm_Ticks = Current_Item.Duration1;
+    }
+
+    portEXIT_CRITICAL_ISR(&Interpolator_Lock);
+
+    Rising_Edge_Next = !Rising_Edge_Next;
+
+    if (Alarm_Ticks < MULTI_AXIS_MIN_ALARM_TICKS)
+    {
+        Alarm_Ticks = MULTI_AXIS_MIN_ALARM_TICKS; // An alarm already passed would only fire after the counter wraps
+    }
+
+    timer_group_set_alarm_value_in_isr(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX, Alarm_Ticks);
+    timer_group_enable_alarm_in_isr(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX);
+}
+
+/**
+ * @brief Give the X pulse pin back to the selected pulse engine.
+ */
+static void Restore_Pulse_Engine_Routing(void)
+{
+#if STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_RMT
+    gpio_matrix_out(STEPPER_MOTOR_PUL_PIN, RMT_SIG_OUT0_IDX + RMT_PULSE_ENGINE_CHANNEL, false, false);
+#elif STEPPER_PULSE_ENGINE == STEPPER_PULSE_ENGINE_TIMER
+    gpio_matrix_out(STEPPER_MOTOR_PUL_PIN, SIG_GPIO_OUT_IDX, false, false); // Both drive the pin from the GPIO output register
+#else
+    Stepper_Route_Output(Stepper_Get(0)); // LEDC channel of motor 0
+#endif
+}
+
+/**
+ * @brief Initialize the pins and the step timer of the interpolated axes.
+ *
+ * Axis X uses the pins of the single axis motor, which are set up by
+ * Initialize_Stepper_Motor() and the pulse engine.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t Initialize_Multi_Axis(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    // Configuration structure for the GPIO settings of axes Y, Z and A
+    gpio_config_t io_conf = {}; // Zero-initialize the config structure
+
+    for (uint8_t Axis = 0; Axis < MULTI_AXIS_COUNT; Axis++)
+    {
+        Pul_Pin_Masks[Axis] = 1UL << Axis_Pul_Pins[Axis];
+        Dir_Pin_Masks[Axis] = 1UL << Axis_Dir_Pins[Axis];
+
+        if (Axis > 0)
+        {
+            io_conf.pin_bit_mask |= (1ULL << Axis_Pul_Pins[Axis]) | (1ULL << Axis_Dir_Pins[Axis]);
+        }
+    }
+
+    io_conf.intr_type = GPIO_PIN_INTR_DISABLE;  // Disable interrupt for the GPIO pins
+    io_conf.mode = GPIO_MODE_OUTPUT;            // Set the GPIO pins to output mode
+    io_conf.pull_down_en = GPIO_PULLUP_DISABLE; // Disable pull-down mode for the GPIO pins
+    io_conf.pull_up_en = GPIO_PULLDOWN_DISABLE; // Disable pull-up mode for the GPIO pins
+
+    Function_Error += gpio_config(&io_conf);
+
+    // Configuration structure for the step timer
+    timer_config_t Step_Timer = {}; // Zero-initialize the config structure
+
+    Step_Timer.divider = MULTI_AXIS_TIMER_DIVIDER; // Tick rate of the alarms
+    Step_Timer.counter_dir = TIMER_COUNT_UP;       // Count up to the alarm value
+    Step_Timer.counter_en = TIMER_PAUSE;           // Started for every move
+    Step_Timer.alarm_en = TIMER_ALARM_EN;          // Interrupt on the alarm value
+    Step_Timer.auto_reload = TIMER_AUTORELOAD_EN;  // Restart from 0 on every alarm, so alarm values are intervals
+    Step_Timer.intr_type = TIMER_INTR_LEVEL;       // Level interrupt
+
+    Function_Error += timer_init(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX, &Step_Timer);
+    Function_Error += timer_set_counter_value(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX, 0);
+    Function_Error += timer_enable_intr(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX);
+    Function_Error += timer_isr_register(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX, Multi_Axis_Timer_ISR, NULL, 0, NULL);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Emit an interpolated path along a planned profile and wait for its end.
+ *
+ * The profile is planned over the interpolator ticks of the path, so its
+ * frequencies are the step rate of the longest axis of a line, or the tick
+ * rate along an arc.
+ *
+ * @param Profile Profile planned over the ticks of the path.
+ * @param Path_To_Run Path to follow, copied before the move starts.
+ * @param Timeout Longest time to wait for the move to end.
+ * @param Abort_Requested Flag set by Multi_Axis_Abort() callers, checked before starting.
+ * @param Executed_Ticks Returns the number of interpolator ticks emitted, may be NULL.
+ * @return ESP_OK if successful, ESP_ERR_TIMEOUT if the move did not end in
+ *         time, or the error of the failing timer call.
+ */
+esp_err_t Multi_Axis_Run(const Motion_Profile_t *Profile, const Multi_Axis_Path_t *Path_To_Run, TickType_t Timeout, const volatile bool *Abort_Requested, uint32_t *Executed_Ticks)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    portENTER_CRITICAL(&Interpolator_Lock);
+    Path = *Path_To_Run;
+    Segment_Encoder_Begin(&Encoder, Profile, MULTI_AXIS_TICK_HZ, MULTI_AXIS_HIGH_TICKS);
+    Rising_Edge_Next = true;
+    Waiting_Task = xTaskGetCurrentTaskHandle();
+    portEXIT_CRITICAL(&Interpolator_Lock);
+
+    xTaskNotifyWait(0, ULONG_MAX, NULL, 0); // Drop events left over from an earlier move
+
+    if ((Profile->Total_Steps > 0) && !(*Abort_Requested))
+    {
+        gpio_matrix_out(STEPPER_MOTOR_PUL_PIN, SIG_GPIO_OUT_IDX, false, false); // X pulse pin driven by the GPIO output register
+
+        Prepare_Next_Step(0); // First tick and its directions
+
+        Function_Error += timer_set_counter_value(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX, 0);
+        Function_Error += timer_set_alarm_value(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX, MULTI_AXIS_DIR_SETUP_TICKS);
+        Function_Error += timer_set_alarm(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX, TIMER_ALARM_EN);
+        Function_Error += timer_start(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX);
+
+        MOTION_TRACE(MOTION_TRACE_PULSE_START, (Profile->Segment_Count > 0) ? Profile->Segments[0].Frequency_Hz : 0);
+
+        if ((Function_Error == ESP_OK) && (xTaskNotifyWait(0, ULONG_MAX, NULL, Timeout) != pdTRUE))
+        {
+            Function_Error = ESP_ERR_TIMEOUT;
+        }
+
+        timer_pause(MULTI_AXIS_TIMER_GROUP, MULTI_AXIS_TIMER_IDX);
+
+        uint32_t Pul_Clear = 0;
+
+        for (uint8_t Axis = 0; Axis < MULTI_AXIS_COUNT; Axis++)
+        {
+            Pul_Clear |= Pul_Pin_Masks[Axis];
+        }
+
+        GPIO.out_w1tc = Pul_Clear; // Leave every pulse pin low
+
+        Restore_Pulse_Engine_Routing();
+    }
+
+    Waiting_Task = NULL;
+
+    if (Executed_Ticks != NULL)
+    {
+        *Executed_Ticks = Encoder.Steps_Encoded;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief End the running multi-axis move after the current pulse item.
+ *
+ * Safe to call from any task. The axes stop without deceleration.
+ */
+void Multi_Axis_Abort(void)
+{
+    portENTER_CRITICAL(&Interpolator_Lock);
+    Segment_Encoder_Abort(&Encoder);
+    portEXIT_CRITICAL(&Interpolator_Lock);
+}
+
+/**
+ * @brief Measure the throughput of the interpolator core on this CPU.
+ *
+ * Times MULTI_AXIS_BENCHMARK_TICKS ticks of a 4 axis line and of a circle
+ * without driving any pins, and one line tick together with the profile
+ * encoding done by the step timer interrupt. Must not be called while a
+ * multi-axis move is running.
+ *
+ * @param Result Measured rates.
+ */
+void Multi_Axis_Benchmark(Multi_Axis_Benchmark_t *Result)
+{
+    static Motion_Profile_t Benchmark_Profile; // Single segment profile for the encoding cost
+    const int32_t Delta[DDA_MAX_AXES] = {MULTI_AXIS_BENCHMARK_TICKS, -71234, 33333, -777};
+    DDA_Line_t Line;
+    DDA_Arc_t Arc;
+    Pulse_Item_t Item;
+    uint8_t Direction_Mask = 0;
+    uint32_t Steps = 0;
+
+    DDA_Line_Begin(&Line, Delta, DDA_MAX_AXES);
+
+    int64_t Start_us = esp_timer_get_time();
+
+    while (!DDA_Line_Done(&Line))
+    {
+        uint8_t Step_Mask = DDA_Line_Step(&Line, &Direction_Mask);
+
+        Steps += __builtin_popcount(Step_Mask);
+    }
+
+    int64_t Line_us = esp_timer_get_time() - Start_us;
+
+    DDA_Arc_Begin(&Arc, MULTI_AXIS_BENCHMARK_TICKS / 6, 0, MULTI_AXIS_BENCHMARK_TICKS / 6, 0, false); // Full circle of about the same tick count
+
+    uint32_t Arc_Ticks = 0;
+
+    Start_us = esp_timer_get_time();
+
+    while (!DDA_Arc_Done(&Arc))
+    {
+        DDA_Arc_Step(&Arc, &Direction_Mask);
+
+        Arc_Ticks++;
+    }
+
+    int64_t Arc_us = esp_timer_get_time() - Start_us;
+
+    Benchmark_Profile.Segments[0].Frequency_Hz = MULTI_AXIS_MAX_FREQUENCY_HZ;
+    Benchmark_Profile.Segments[0].Steps = MULTI_AXIS_BENCHMARK_TICKS;
+    Benchmark_Profile.Segment_Count = 1;
+    Benchmark_Profile.Total_Steps = MULTI_AXIS_BENCHMARK_TICKS;
+
+    Segment_Encoder_t Benchmark_Encoder;
+
+    Segment_Encoder_Begin(&Benchmark_Encoder, &Benchmark_Profile, MULTI_AXIS_TICK_HZ, MULTI_AXIS_HIGH_TICKS);
+    DDA_Line_Begin(&Line, Delta, DDA_MAX_AXES);
+
+    Start_us = esp_timer_get_time();
+
+    while (Segment_Encoder_Fill(&Benchmark_Encoder, &Item, 1, NULL) > 0)
+    {
+        DDA_Line_Step(&Line, &Direction_Mask);
+    }
+
+    int64_t Tick_us = esp_timer_get_time() - Start_us;
+
+    Result->Line_Ticks_Per_Second = (Line_us > 0) ? (uint32_t)((MULTI_AXIS_BENCHMARK_TICKS * 1000000LL) / Line_us) : 0;
+    Result->Line_Steps_Per_Second = (Line_us > 0) ? (uint32_t)((Steps * 1000000LL) / Line_us) : 0;
+    Result->Arc_Ticks_Per_Second = (Arc_us > 0) ? (uint32_t)((Arc_Ticks * 1000000LL) / Arc_us) : 0;
+    Result->Tick_Cost_ns = (uint32_t)((Tick_us * 1000) / MULTI_AXIS_BENCHMARK_TICKS);
+}
@@ -0,0 +1,74 @@
+/*H**********************************************************************
+ * FILENAME :        multi_axis.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Timer driven step generator for coordinated multi-axis moves.
+ *
+ * NOTES :
+ *       One hardware timer walks the planned profile of the interpolated
+ *       path. On every tick the DDA interpolator decides which axes step,
+ *       and all of their pulse pins are raised with one register write so
+ *       the axes stay in sync. Axis X shares the pins of the single axis
+ *       motor; its pulse pin is handed from the pulse engine to the GPIO
+ *       for the duration of a multi-axis move.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef MULTI_AXIS_H
+#define MULTI_AXIS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+#include "driver/timer.h"
+#include "motion_planner.h"
+#include "dda_interpolator.h"
+
+#define MULTI_AXIS_COUNT 2 // Axes driven by the interpolator, 2 to DDA_MAX_AXES
+
+#define AXIS_Y_PUL_PIN GPIO_NUM_18 // Step pulse of axis Y
+#define AXIS_Y_DIR_PIN GPIO_NUM_19 // Direction of axis Y
+#define AXIS_Z_PUL_PIN GPIO_NUM_21 // Step pulse of axis Z
+#define AXIS_Z_DIR_PIN GPIO_NUM_22 // Direction of axis Z
+#define AXIS_A_PUL_PIN GPIO_NUM_23 // Step pulse of axis A
+#define AXIS_A_DIR_PIN GPIO_NUM_25 // Direction of axis A
+
+#define MULTI_AXIS_TIMER_GROUP TIMER_GROUP_0                                                // Timer group of the step timer
+#define MULTI_AXIS_TIMER_IDX TIMER_0                                                        // Step timer
+#define MULTI_AXIS_TIMER_DIVIDER 8                                                          // 80 MHz APB clock / 8 = 10 MHz tick
+#define MULTI_AXIS_TICK_HZ (TIMER_BASE_CLK / MULTI_AXIS_TIMER_DIVIDER)                      // Tick rate of the step timer
+#define MULTI_AXIS_HIGH_TICKS 50                                                            // Step pulse high time, 5 us
+#define MULTI_AXIS_MIN_ALARM_TICKS 50                                                       // Shortest timer interval the interrupt can keep up with
+#define MULTI_AXIS_DIR_SETUP_TICKS 50                                                       // Direction setup time before the first step, 5 us
+#define MULTI_AXIS_MAX_FREQUENCY_HZ (MULTI_AXIS_TICK_HZ / (2 * MULTI_AXIS_MIN_ALARM_TICKS)) // Highest interpolator tick rate
+#define MULTI_AXIS_NOTIFY_DONE 0x08                                                         // Task notification bit: the multi-axis move ended
+#define MULTI_AXIS_BENCHMARK_TICKS 100000                                                   // Ticks timed by Multi_Axis_Benchmark()
+
+/** Interpolated path of one multi-axis move */
+typedef struct
+{
+    bool Arc;         // True for a circular arc, false for a straight line
+    DDA_Line_t Line;  // Line state, used if Arc is false
+    DDA_Arc_t Circle; // Arc state, used if Arc is true
+} Multi_Axis_Path_t;
+
+/** Result of Multi_Axis_Benchmark() */
+typedef struct
+{
+    uint32_t Line_Ticks_Per_Second; // Interpolator ticks of a 4 axis line per second
+    uint32_t Line_Steps_Per_Second; // Aggregate axis steps of that line per second
+    uint32_t Arc_Ticks_Per_Second;  // Interpolator ticks of a circle per second
+    uint32_t Tick_Cost_ns;          // Time of one complete line tick including the profile encoding
+} Multi_Axis_Benchmark_t;
+
+esp_err_t Initialize_Multi_Axis(void);
+esp_err_t Multi_Axis_Run(const Motion_Profile_t *Profile, const Multi_Axis_Path_t *Path, TickType_t Timeout, const volatile bool *Abort_Requested, uint32_t *Executed_Ticks);
+void Multi_Axis_Abort(void);
+void Multi_Axis_Benchmark(Multi_Axis_Benchmark_t *Result);
+
+#endif // MULTI_AXIS_H
@@ -0,0 +1,332 @@
+/*H**********************************************************************
+ * FILENAME :        pulse_counter.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       PCNT based step pulse counting for the stepper motors.
+ *
+ * NOTES :
+ *       The PCNT unit is fed from the same pad that the LEDC channel
+ *       drives. The high limit event is used as the end of a counting
+ *       window; when it fires the counter resets to 0 by hardware and the
+ *       interrupt programs the next window. Every unit has its own handler
+ *       argument, so one interrupt routine serves all motors.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "pulse_counter.h"
+#include "main.h"
+#include "soc/gpio_sig_map.h"
+#include "soc/gpio_periph.h"
+#include "soc/io_mux_reg.h"
+#include "esp32/rom/gpio.h"
+
+/**
+ * @brief Read the hardware count and restart the counter at 0.
+ *
+ * Called with the lock of the counter held.
+ *
+ * @return Pulses counted since the last clear or limit reset.
+ */
+static uint32_t Read_And_Clear_Count(const Pulse_Counter_t *Counter)
+{
+    int16_t Count = 0;
+
+    pcnt_get_counter_value((pcnt_unit_t)Counter->Resources.Pcnt_Unit, &Count);
+    pcnt_counter_clear((pcnt_unit_t)Counter->Resources.Pcnt_Unit); // Clearing also loads the new limit value
+
+    return (Count > 0) ? (uint32_t)Count : 0;
+}
+
+/**
+ * @brief Stop the LEDC channel of the counted motor, idle level low.
+ */
+static void Stop_Output(const Pulse_Counter_t *Counter)
+{
+    ledc_stop((ledc_mode_t)Counter->Resources.Speed_Mode, (ledc_channel_t)Counter->Resources.Channel, 0);
+}
+
+/**
+ * @brief Pulse counter high limit interrupt.
+ *
+ * Stops the PWM output right at the last step of the move, otherwise
+ * programs the next counting window and tells the waiting task when a
+ * segment boundary was reached so it can change the frequency. The window
+ * accounting runs under the lock of the counter, so Pulse_Counter_Retarget()
+ * on the other core never sees it half done.
+ */
+static void Pulse_Counter_ISR(void *arg)
+{
+    Pulse_Counter_t *Counter = (Pulse_Counter_t *)arg;
+    BaseType_t Higher_Priority_Task_Woken = pdFALSE;
+    uint32_t Notification = 0;
+
+    portENTER_CRITICAL_ISR(&Counter->Lock);
+
+    if (Counter->Counting)
+    {
+        uint32_t Early_Steps = Read_And_Clear_Count(Counter); // Steps emitted since the limit reset the counter
+
+        Step_Counter_Event_t Event = Step_Counter_Window_End(&Counter->Step_Counter, Early_Steps);
+
+        if (Event == STEP_COUNTER_MOVE_DONE)
+        {
+            if (!Counter->Step_Counter.Profile->Continuous)
+            {
+                Stop_Output(Counter); // Stop on the exact step
+            }
+
+            Counter->Counting = false;
+            Notification = PULSE_COUNTER_NOTIFY_DONE;
+        }
+        else
+        {
+            pcnt_set_event_value((pcnt_unit_t)Counter->Resources.Pcnt_Unit, PCNT_EVT_H_LIM, (int16_t)Counter->Step_Counter.Window_Steps);
+
+            Counter->Step_Counter.Counted_Steps += Read_And_Clear_Count(Counter); // Apply the new limit, keep any step seen meanwhile
+
+            if (Event == STEP_COUNTER_SEGMENT_DONE)
+            {
+                if (Counter->Traced)
+                {
+                    MOTION_TRACE(MOTION_TRACE_SEGMENT, Counter->Step_Counter.Segment_Index);
+                }
+
+                Notification = PULSE_COUNTER_NOTIFY_SEGMENT;
+            }
+        }
+    }
+
+    portEXIT_CRITICAL_ISR(&Counter->Lock);
+
+    if (Notification != 0)
+    {
+        xTaskNotifyFromISR(Counter->Notify_Task, Notification, eSetBits, &Higher_Priority_Task_Woken);
+    }
+
+    if (Higher_Priority_Task_Woken == pdTRUE)
+    {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Initialize the PCNT unit counting the step pulses of a motor.
+ *
+ * Must be called after the LEDC channel of the motor is configured and the
+ * PCNT interrupt service is installed. Routing the pad into the PCNT turns
+ * it into an input, so the LEDC signal is routed back to the pad afterwards
+ * while keeping the input path enabled.
+ *
+ * @param Counter Counter to initialize.
+ * @param Step_Pin Step pin of the motor.
+ * @param Resources LEDC channel and PCNT unit of the motor.
+ * @param Traced Whether the segment boundaries go to the motion trace.
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t Initialize_Pulse_Counter(Pulse_Counter_t *Counter, gpio_num_t Step_Pin, const Stepper_Resource_t *Resources, bool Traced)
+{
+    esp_err_t Function_Error = ESP_OK;
+    pcnt_unit_t Unit = (pcnt_unit_t)Resources->Pcnt_Unit;
+
+    memset(Counter, 0, sizeof(*Counter));
+
+    Counter->Step_Pin = Step_Pin;
+    Counter->Resources = *Resources;
+    Counter->Traced = Traced;
+    Counter->Lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+
+    // Configuration structure for the pulse counter
+    pcnt_config_t Pulse_Counter_Config = {}; // Zero-initialize the config structure
+
+    Pulse_Counter_Config.pulse_gpio_num = Step_Pin;                // Count the pulses of the step pin
+    Pulse_Counter_Config.ctrl_gpio_num = PCNT_PIN_NOT_USED;        // No control pin, always count up
+    Pulse_Counter_Config.unit = Unit;                              // Counter unit of the motor
+    Pulse_Counter_Config.channel = PULSE_COUNTER_CHANNEL;          // Counter channel
+    Pulse_Counter_Config.pos_mode = PCNT_COUNT_INC;                // Count every rising edge
+    Pulse_Counter_Config.neg_mode = PCNT_COUNT_DIS;                // Ignore falling edges
+    Pulse_Counter_Config.lctrl_mode = PCNT_MODE_KEEP;              // Control pin not used
+    Pulse_Counter_Config.hctrl_mode = PCNT_MODE_KEEP;              // Control pin not used
+    Pulse_Counter_Config.counter_h_lim = STEP_COUNTER_MAX_WINDOW;  // Window limit, reprogrammed for every move
+    Pulse_Counter_Config.counter_l_lim = -STEP_COUNTER_MAX_WINDOW; // Never reached, the counter only counts up
+
+    Function_Error += pcnt_unit_config(&Pulse_Counter_Config);
+
+    Function_Error += pcnt_set_filter_value(Unit, PULSE_COUNTER_FILTER); // Ignore glitches shorter than the filter
+    Function_Error += pcnt_filter_enable(Unit);
+
+    Function_Error += pcnt_event_enable(Unit, PCNT_EVT_H_LIM); // Interrupt at the end of every window
+
+    Function_Error += pcnt_counter_pause(Unit);
+    Function_Error += pcnt_counter_clear(Unit);
+
+    Function_Error += pcnt_isr_handler_add(Unit, Pulse_Counter_ISR, Counter);
+
+    Function_Error += gpio_set_direction(Step_Pin, GPIO_MODE_OUTPUT);
+    Pulse_Counter_Route_Output(Counter);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Give the step pad back to the LEDC channel and keep it readable by the PCNT.
+ *
+ * Also used after another peripheral drove the pad, e.g. a multi-axis move.
+ */
+void Pulse_Counter_Route_Output(const Pulse_Counter_t *Counter)
+{
+    uint32_t Signal = (Counter->Resources.Speed_Mode == LEDC_LOW_SPEED_MODE) ? LEDC_LS_SIG_OUT0_IDX : LEDC_HS_SIG_OUT0_IDX;
+
+    gpio_matrix_out(Counter->Step_Pin, Signal + Counter->Resources.Channel, false, false);
+    PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[Counter->Step_Pin]);
+}
+
+/**
+ * @brief Start counting the steps of a profile.
+ *
+ * Must be called before the PWM output is started so no step is missed.
+ *
+ * @param Counter Counter of the motor.
+ * @param Profile Profile that is about to be executed.
+ * @param Task Task to notify on segment boundaries and at the end of the move.
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t Pulse_Counter_Start(Pulse_Counter_t *Counter, const Motion_Profile_t *Profile, TaskHandle_t Task)
+{
+    esp_err_t Function_Error = ESP_OK;
+    pcnt_unit_t Unit = (pcnt_unit_t)Counter->Resources.Pcnt_Unit;
+
+    Counter->Counting = false;
+
+    Function_Error += pcnt_counter_pause(Unit);
+
+    uint32_t Window = Step_Counter_Begin(&Counter->Step_Counter, Profile);
+
+    if (Window > 0)
+    {
+        Function_Error += pcnt_set_event_value(Unit, PCNT_EVT_H_LIM, (int16_t)Window);
+    }
+
+    Function_Error += pcnt_counter_clear(Unit);
+
+    Counter->Notify_Task = Task;
+    Counter->Counting = (Window > 0);
+
+    Function_Error += pcnt_counter_resume(Unit);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Continue the running move with another profile, exact to the step.
+ *
+ * The count of the running window is taken and the counter restarted on
+ * the first window of the new profile in one critical section, steps
+ * emitted meanwhile are kept like in the interrupt. A window that is about
+ * to end is left alone, the limit event could otherwise fire between the
+ * read and the restart. An empty profile stops the output right away.
+ *
+ * @param Counter Counter of the motor.
+ * @param Profile Profile that continues the move from the current step.
+ * @param Task Task to notify on segment boundaries and at the end of the move.
+ * @return
+ *     - ESP_OK: Profile taken, the caller applies its first frequency
+ *     - ESP_ERR_INVALID_STATE: No counted move running, or it ends before the new profile would
+ *     - ESP_ERR_TIMEOUT: The running window is about to end, try again after it
+ */
+esp_err_t Pulse_Counter_Retarget(Pulse_Counter_t *Counter, const Motion_Profile_t *Profile, TaskHandle_t Task)
+{
+    esp_err_t Function_Error = ESP_ERR_INVALID_STATE;
+    int16_t Count = 0;
+    uint32_t Window = 0;
+
+    portENTER_CRITICAL(&Counter->Lock);
+
+    pcnt_get_counter_value((pcnt_unit_t)Counter->Resources.Pcnt_Unit, &Count);
+
+    uint32_t Window_Count = (Count > 0) ? (uint32_t)Count : 0;
+
+    if (!Counter->Counting)
+    {
+        // Nothing to retarget
+    }
+    else if ((Window_Count + STEP_COUNTER_RETARGET_MARGIN) >= Counter->Step_Counter.Window_Steps)
+    {
+        Function_Error = ESP_ERR_TIMEOUT;
+    }
+    else if (Step_Counter_Retarget(&Counter->Step_Counter, Profile, Window_Count, &Window))
+    {
+        if (Window > 0)
+        {
+            pcnt_set_event_value((pcnt_unit_t)Counter->Resources.Pcnt_Unit, PCNT_EVT_H_LIM, (int16_t)Window);
+        }
+        else
+        {
+            Stop_Output(Counter); // Slow enough to stop right here
+
+            Counter->Counting = false;
+        }
+
+        Counter->Step_Counter.Counted_Steps += Read_And_Clear_Count(Counter) - Window_Count; // Apply the new limit, keep any step seen meanwhile
+
+        Counter->Notify_Task = Task;
+        Function_Error = ESP_OK;
+    }
+
+    portEXIT_CRITICAL(&Counter->Lock);
+
+    if ((Function_Error == ESP_OK) && (Window == 0))
+    {
+        xTaskNotify(Task, PULSE_COUNTER_NOTIFY_DONE, eSetBits);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Index of the profile segment that is currently being emitted.
+ */
+uint16_t Pulse_Counter_Get_Segment(const Pulse_Counter_t *Counter)
+{
+    return Counter->Step_Counter.Segment_Index;
+}
+
+/**
+ * @brief Steps emitted since Pulse_Counter_Start(), while the move is running.
+ *
+ * Safe to call from interrupts, e.g. to latch the position on an input edge.
+ */
+uint32_t Pulse_Counter_Get_Steps(Pulse_Counter_t *Counter)
+{
+    int16_t Count = 0;
+    uint32_t Steps = 0;
+
+    portENTER_CRITICAL_SAFE(&Counter->Lock);
+    pcnt_get_counter_value((pcnt_unit_t)Counter->Resources.Pcnt_Unit, &Count);
+    Steps = Step_Counter_Executed(&Counter->Step_Counter, (Count > 0) ? (uint32_t)Count : 0);
+    portEXIT_CRITICAL_SAFE(&Counter->Lock);
+
+    return Steps;
+}
+
+/**
+ * @brief Stop counting and return the exact number of steps emitted.
+ *
+ * The PWM output has to be stopped before, otherwise steps emitted after
+ * this call are not included.
+ *
+ * @return Steps emitted since Pulse_Counter_Start().
+ */
+uint32_t Pulse_Counter_Stop(Pulse_Counter_t *Counter)
+{
+    Counter->Counting = false;
+
+    pcnt_counter_pause((pcnt_unit_t)Counter->Resources.Pcnt_Unit);
+
+    return Pulse_Counter_Get_Steps(Counter);
+}
@@ -0,0 +1,58 @@
+/*H**********************************************************************
+ * FILENAME :        pulse_counter.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       PCNT based step pulse counting for the stepper motors.
+ *
+ * NOTES :
+ *       The pulse counter reads back the step pulses on the step pin of a
+ *       motor and stops its LEDC channel from its interrupt once the last
+ *       planned step has been emitted, so moves are exact to the step. A
+ *       running move can be retargeted to a decel ramp without losing the
+ *       count, continuous runs are counted until the counter is stopped.
+ *       Every motor of stepper.h owns one Pulse_Counter_t.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef PULSE_COUNTER_H
+#define PULSE_COUNTER_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "driver/pcnt.h"
+#include "motion_planner.h"
+#include "step_counter.h"
+#include "stepper_resources.h"
+
+#define PULSE_COUNTER_CHANNEL PCNT_CHANNEL_0 // PCNT channel counting the step pulses
+#define PULSE_COUNTER_FILTER 10              // Glitch filter in APB cycles (125 ns)
+
+#define PULSE_COUNTER_NOTIFY_SEGMENT 0x01 // Task notification bit: a segment boundary was reached
+#define PULSE_COUNTER_NOTIFY_DONE 0x02    // Task notification bit: the last counted step was reached
+
+/** Step counting of one motor */
+typedef struct
+{
+    gpio_num_t Step_Pin;          // Pad driven by the LEDC channel and read back by the PCNT unit
+    Stepper_Resource_t Resources; // LEDC channel stopped on the last step, PCNT unit counting
+    bool Traced;                  // Segment boundaries go to the motion trace, which has no motor number
+    Step_Counter_t Step_Counter;  // Window accounting of the running move
+    TaskHandle_t Notify_Task;     // Task waiting for the move events
+    volatile bool Counting;       // True while a counted move is running
+    portMUX_TYPE Lock;            // Keeps the read and clear of the counter together
+} Pulse_Counter_t;
+
+esp_err_t Initialize_Pulse_Counter(Pulse_Counter_t *Counter, gpio_num_t Step_Pin, const Stepper_Resource_t *Resources, bool Traced);
+void Pulse_Counter_Route_Output(const Pulse_Counter_t *Counter);
+esp_err_t Pulse_Counter_Start(Pulse_Counter_t *Counter, const Motion_Profile_t *Profile, TaskHandle_t Notify_Task);
+esp_err_t Pulse_Counter_Retarget(Pulse_Counter_t *Counter, const Motion_Profile_t *Profile, TaskHandle_t Notify_Task);
+uint16_t Pulse_Counter_Get_Segment(const Pulse_Counter_t *Counter);
+uint32_t Pulse_Counter_Get_Steps(Pulse_Counter_t *Counter);
+uint32_t Pulse_Counter_Stop(Pulse_Counter_t *Counter);
+
+#endif // PULSE_COUNTER_H
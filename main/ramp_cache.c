@@ -0,0 +1,396 @@
+/*H**********************************************************************
+ * FILENAME :        ramp_cache.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Cache of the planned start_motor ramps, persisted in NVS.
+ *
+ * NOTES :
+ *       Only the accel segments are stored, the held cruise segment of a
+ *       ramp follows from the key. The RAM cache is shared by the motion
+ *       task and the console, a critical section keeps every lookup and
+ *       update together. NVS is only accessed outside of it, by the motion
+ *       task after the ramp is running or by the console.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "nvs.h"
+#include "ramp_cache.h"
+
+#define RAMP_CACHE_NVS_KEY_FORMAT "ramp%u"                                    // NVS key of a slot
+#define RAMP_CACHE_RECORD_HEADER_SIZE offsetof(Ramp_Cache_Record_t, Segments) // Bytes of a record before its segments
+
+/** Ramp as stored in NVS, only the used entries of Segments are written */
+typedef struct
+{
+    uint32_t Version;                                            // RAMP_CACHE_NVS_VERSION of the writer
+    Ramp_Cache_Key_t Key;                                        // Parameters the ramp was planned for
+    uint32_t Segment_Count;                                      // Accel segments of the ramp
+    Motion_Segment_t Segments[MOTION_PLANNER_MAX_RAMP_SEGMENTS]; // Accel segments
+} Ramp_Cache_Record_t;
+
+/** One ramp of the RAM cache */
+typedef struct
+{
+    Ramp_Cache_Record_t Record; // Cached ramp
+    uint32_t Uses;              // Times the ramp was planned or taken from the cache
+    uint32_t Last_Used;         // Use stamp, the oldest entry is evicted first
+    bool Valid;                 // Entry holds a ramp
+    bool Persisted;             // Ramp is stored in NVS, or failed to be
+} Ramp_Cache_Entry_t;
+
+static Ramp_Cache_Entry_t Cache[RAMP_CACHE_ENTRIES];           // RAM cache
+static Ramp_Cache_Stats_t Stats;                               // Counters reported by Ramp_Cache_Get_Stats()
+static uint32_t Use_Stamp = 0;                                 // Stamp given to the next use
+static Ramp_Cache_Key_t Nvs_Slot_Keys[RAMP_CACHE_NVS_SLOTS];   // Ramps held by the NVS slots
+static bool Nvs_Slot_Used[RAMP_CACHE_NVS_SLOTS];               // NVS slot holds a ramp
+static uint8_t Next_Nvs_Slot = 0;                              // Slot overwritten when all are taken
+static Ramp_Cache_Record_t Nvs_Record;                         // Record being loaded or written, too large for the stack
+static portMUX_TYPE Cache_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards Cache, Stats and Use_Stamp
+
+/**
+ * @brief Entry holding the ramp of a key, NULL if not cached. Call with Cache_Lock held.
+ */
+static Ramp_Cache_Entry_t *Find_Entry(const Ramp_Cache_Key_t *Key)
+{
+    for (uint8_t Index = 0; Index < RAMP_CACHE_ENTRIES; Index++)
+    {
+        if (Cache[Index].Valid && (memcmp(&Cache[Index].Record.Key, Key, sizeof(*Key)) == 0))
+        {
+            return &Cache[Index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Store a ramp in a free entry or in place of the least recently used one. Call with Cache_Lock held.
+ */
+static Ramp_Cache_Entry_t *Insert_Entry(const Ramp_Cache_Key_t *Key, const Motion_Segment_t *Segments, uint16_t Segment_Count)
+{
+    Ramp_Cache_Entry_t *Entry = Find_Entry(Key);
+
+    for (uint8_t Index = 0; (Entry == NULL) && (Index < RAMP_CACHE_ENTRIES); Index++)
+    {
+        Entry = !Cache[Index].Valid ? &Cache[Index] : NULL;
+    }
+
+    if (Entry == NULL)
+    {
+        Entry = &Cache[0];
+
+        for (uint8_t Index = 1; Index < RAMP_CACHE_ENTRIES; Index++)
+        {
+            Entry = (Cache[Index].Last_Used < Entry->Last_Used) ? &Cache[Index] : Entry;
+        }
+
+        Stats.Evictions++;
+        Stats.Entries--;
+    }
+
+    if (!Entry->Valid || (memcmp(&Entry->Record.Key, Key, sizeof(*Key)) != 0))
+    {
+        Stats.Entries++;
+        Entry->Uses = 0;
+        Entry->Persisted = false;
+    }
+
+    Entry->Record.Version = RAMP_CACHE_NVS_VERSION;
+    Entry->Record.Key = *Key;
+    Entry->Record.Segment_Count = Segment_Count;
+    memcpy(Entry->Record.Segments, Segments, Segment_Count * sizeof(Motion_Segment_t));
+    Entry->Last_Used = ++Use_Stamp;
+    Entry->Valid = true;
+
+    return Entry;
+}
+
+/**
+ * @brief Check a record read from NVS.
+ */
+static bool Record_Is_Valid(const Ramp_Cache_Record_t *Record, size_t Length)
+{
+    return (Length >= RAMP_CACHE_RECORD_HEADER_SIZE) && (Record->Version == RAMP_CACHE_NVS_VERSION) && (Record->Segment_Count > 0) &&
+           (Record->Segment_Count <= MOTION_PLANNER_MAX_RAMP_SEGMENTS) && (Length == (RAMP_CACHE_RECORD_HEADER_SIZE + (Record->Segment_Count * sizeof(Motion_Segment_t))));
+}
+
+/**
+ * @brief Clear the RAM cache and load the ramps stored in NVS.
+ *
+ * Needs nvs_flash_init() to be called first. If NVS cannot be read the
+ * cache starts empty and still works in RAM.
+ *
+ * @return ESP_OK, or the error of the NVS access.
+ */
+esp_err_t Initialize_Ramp_Cache(void)
+{
+    nvs_handle_t Handle = 0;
+
+    Ramp_Cache_Clear(false);
+
+    portENTER_CRITICAL(&Cache_Lock);
+    memset(&Stats, 0, sizeof(Stats));
+    portEXIT_CRITICAL(&Cache_Lock);
+
+    memset(Nvs_Slot_Used, 0, sizeof(Nvs_Slot_Used));
+    Next_Nvs_Slot = 0;
+
+    esp_err_t Function_Error = nvs_open(RAMP_CACHE_NVS_NAMESPACE, NVS_READONLY, &Handle);
+
+    if (Function_Error == ESP_ERR_NVS_NOT_FOUND)
+    {
+        return ESP_OK; // Nothing stored yet
+    }
+
+    if (Function_Error != ESP_OK)
+    {
+        Stats.Nvs_Errors++;
+        return Function_Error;
+    }
+
+    for (uint8_t Slot = 0; Slot < RAMP_CACHE_NVS_SLOTS; Slot++)
+    {
+        char Key_Name[NVS_KEY_NAME_MAX_SIZE];
+        size_t Length = sizeof(Nvs_Record);
+
+        snprintf(Key_Name, sizeof(Key_Name), RAMP_CACHE_NVS_KEY_FORMAT, Slot);
+
+        esp_err_t Read_Error = nvs_get_blob(Handle, Key_Name, &Nvs_Record, &Length);
+
+        if (Read_Error == ESP_ERR_NVS_NOT_FOUND)
+        {
+            continue;
+        }
+
+        if ((Read_Error != ESP_OK) || !Record_Is_Valid(&Nvs_Record, Length))
+        {
+            Stats.Nvs_Errors += (Read_Error != ESP_OK) ? 1 : 0; // Records of an older version are skipped quietly
+            continue;
+        }
+
+        Nvs_Slot_Keys[Slot] = Nvs_Record.Key;
+        Nvs_Slot_Used[Slot] = true;
+
+        portENTER_CRITICAL(&Cache_Lock);
+        Ramp_Cache_Entry_t *Entry = Insert_Entry(&Nvs_Record.Key, Nvs_Record.Segments, (uint16_t)Nvs_Record.Segment_Count);
+        Entry->Uses = RAMP_CACHE_HOT_USES;
+        Entry->Persisted = true;
+        Stats.Nvs_Loaded++;
+        portEXIT_CRITICAL(&Cache_Lock);
+    }
+
+    nvs_close(Handle);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Plan a ramp like Motion_Planner_Plan_Ramp(), taking it from the cache if possible.
+ *
+ * @param Config Motion limits.
+ * @param Microsteps Microstep setting of the driver, part of the key.
+ * @param Profile Output profile.
+ * @return true if a profile was produced, false if the configuration is invalid.
+ */
+bool Ramp_Cache_Plan_Ramp(const Motion_Planner_Config_t *Config, uint32_t Microsteps, Motion_Profile_t *Profile)
+{
+    if ((Config == NULL) || (Profile == NULL))
+    {
+        return false;
+    }
+
+    Ramp_Cache_Key_t Key = {
+        .Max_Frequency_Hz = Config->Max_Frequency_Hz, // Cruise frequency
+        .Acceleration = Config->Acceleration,         // Acceleration limit
+        .Jerk = Config->Jerk,                         // Jerk limit
+        .Segment_Time_us = Config->Segment_Time_us,   // Nominal segment duration
+        .Microsteps = Microsteps,                     // Microstep setting of the driver
+    };
+
+    memset(Profile, 0, sizeof(*Profile));
+
+    portENTER_CRITICAL(&Cache_Lock);
+
+    Ramp_Cache_Entry_t *Entry = Find_Entry(&Key);
+
+    if (Entry != NULL)
+    {
+        memcpy(Profile->Segments, Entry->Record.Segments, Entry->Record.Segment_Count * sizeof(Motion_Segment_t));
+        Profile->Accel_Segments = (uint16_t)Entry->Record.Segment_Count;
+        Entry->Uses++;
+        Entry->Last_Used = ++Use_Stamp;
+        Stats.Hits++;
+    }
+
+    portEXIT_CRITICAL(&Cache_Lock);
+
+    if (Entry == NULL)
+    {
+        if (!Motion_Planner_Plan_Ramp(Config, Profile))
+        {
+            return false;
+        }
+
+        portENTER_CRITICAL(&Cache_Lock);
+        Stats.Misses++;
+        Insert_Entry(&Key, Profile->Segments, Profile->Accel_Segments)->Uses++;
+        portEXIT_CRITICAL(&Cache_Lock);
+
+        return true;
+    }
+
+    // The held cruise segment follows the ramp, like Motion_Planner_Plan_Ramp() builds it
+    Profile->Segments[Profile->Accel_Segments].Frequency_Hz = Config->Max_Frequency_Hz;
+    Profile->Segments[Profile->Accel_Segments].Steps = 0;
+    Profile->Cruise_Segments = 1;
+    Profile->Continuous = true;
+
+    Motion_Planner_Finish_Profile(Profile);
+
+    return true;
+}
+
+/**
+ * @brief Write the hot ramps that are not stored yet to NVS.
+ *
+ * Writing flash stalls the CPUs for a moment, so call this while no
+ * segment changes are due, e.g. once a ramp reached its held frequency.
+ * A ramp is written once, also if the write failed, so a failing flash is
+ * not retried on every start.
+ *
+ * @return ESP_OK, or the error of the last failed NVS access.
+ */
+esp_err_t Ramp_Cache_Persist_Hot(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    while (true)
+    {
+        Ramp_Cache_Entry_t *Entry = NULL;
+
+        portENTER_CRITICAL(&Cache_Lock);
+
+        for (uint8_t Index = 0; (Entry == NULL) && (Index < RAMP_CACHE_ENTRIES); Index++)
+        {
+            if (Cache[Index].Valid && !Cache[Index].Persisted && (Cache[Index].Uses >= RAMP_CACHE_HOT_USES))
+            {
+                Entry = &Cache[Index];
+                Entry->Persisted = true;
+                Nvs_Record = Entry->Record;
+            }
+        }
+
+        portEXIT_CRITICAL(&Cache_Lock);
+
+        if (Entry == NULL)
+        {
+            return Function_Error;
+        }
+
+        uint8_t Slot = RAMP_CACHE_NVS_SLOTS;
+
+        for (uint8_t Index = 0; Index < RAMP_CACHE_NVS_SLOTS; Index++) // The slot of the same ramp, else a free one
+        {
+            if (Nvs_Slot_Used[Index] && (memcmp(&Nvs_Slot_Keys[Index], &Nvs_Record.Key, sizeof(Nvs_Record.Key)) == 0))
+            {
+                Slot = Index;
+            }
+            else if (!Nvs_Slot_Used[Index] && (Slot == RAMP_CACHE_NVS_SLOTS))
+            {
+                Slot = Index;
+            }
+        }
+
+        if (Slot == RAMP_CACHE_NVS_SLOTS)
+        {
+            Slot = Next_Nvs_Slot; // All taken, overwrite the slots in turn
+            Next_Nvs_Slot = (Next_Nvs_Slot + 1) % RAMP_CACHE_NVS_SLOTS;
+        }
+
+        nvs_handle_t Handle = 0;
+        char Key_Name[NVS_KEY_NAME_MAX_SIZE];
+        esp_err_t Write_Error = nvs_open(RAMP_CACHE_NVS_NAMESPACE, NVS_READWRITE, &Handle);
+
+        snprintf(Key_Name, sizeof(Key_Name), RAMP_CACHE_NVS_KEY_FORMAT, Slot);
+
+        if (Write_Error == ESP_OK)
+        {
+            Write_Error = nvs_set_blob(Handle, Key_Name, &Nvs_Record, RAMP_CACHE_RECORD_HEADER_SIZE + (Nvs_Record.Segment_Count * sizeof(Motion_Segment_t)));
+            Write_Error = (Write_Error == ESP_OK) ? nvs_commit(Handle) : Write_Error;
+            nvs_close(Handle);
+        }
+
+        portENTER_CRITICAL(&Cache_Lock);
+
+        if (Write_Error == ESP_OK)
+        {
+            Nvs_Slot_Keys[Slot] = Nvs_Record.Key;
+            Nvs_Slot_Used[Slot] = true;
+            Stats.Nvs_Writes++;
+        }
+        else
+        {
+            Stats.Nvs_Errors++;
+            Function_Error = Write_Error;
+        }
+
+        portEXIT_CRITICAL(&Cache_Lock);
+    }
+}
+
+/**
+ * @brief Read the counters of the cache.
+ *
+ * @param Stats_Out Returns the counters.
+ */
+void Ramp_Cache_Get_Stats(Ramp_Cache_Stats_t *Stats_Out)
+{
+    portENTER_CRITICAL(&Cache_Lock);
+    *Stats_Out = Stats;
+    portEXIT_CRITICAL(&Cache_Lock);
+}
+
+/**
+ * @brief Drop all cached ramps.
+ *
+ * @param Erase_Nvs Also erase the ramps stored in NVS.
+ * @return ESP_OK, or the error of the NVS access.
+ */
+esp_err_t Ramp_Cache_Clear(bool Erase_Nvs)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    portENTER_CRITICAL(&Cache_Lock);
+    memset(Cache, 0, sizeof(Cache));
+    Stats.Entries = 0;
+    portEXIT_CRITICAL(&Cache_Lock);
+
+    if (!Erase_Nvs)
+    {
+        return ESP_OK;
+    }
+
+    nvs_handle_t Handle = 0;
+
+    Function_Error = nvs_open(RAMP_CACHE_NVS_NAMESPACE, NVS_READWRITE, &Handle);
+
+    if (Function_Error == ESP_OK)
+    {
+        Function_Error = nvs_erase_all(Handle);
+        Function_Error = (Function_Error == ESP_OK) ? nvs_commit(Handle) : Function_Error;
+        nvs_close(Handle);
+    }
+
+    memset(Nvs_Slot_Used, 0, sizeof(Nvs_Slot_Used));
+    Next_Nvs_Slot = 0;
+
+    return Function_Error;
+}
@@ -0,0 +1,67 @@
+/*H**********************************************************************
+ * FILENAME :        ramp_cache.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Cache of the planned start_motor ramps, persisted in NVS.
+ *
+ * NOTES :
+ *       A ramp is keyed by everything its segments depend on: the cruise
+ *       frequency, the acceleration and jerk limits, the segment time and
+ *       the microstep setting of the driver. The RAM cache holds
+ *       RAMP_CACHE_ENTRIES ramps and evicts the least recently used one.
+ *       A ramp used RAMP_CACHE_HOT_USES times is hot and is written to one
+ *       of the RAMP_CACHE_NVS_SLOTS slots in NVS, from where
+ *       Initialize_Ramp_Cache() loads it again after a reboot.
+ *
+ *       Records carry RAMP_CACHE_NVS_VERSION, raise it whenever the planner
+ *       output or the record layout changes so stale ramps are dropped.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef RAMP_CACHE_H
+#define RAMP_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "motion_planner.h"
+
+#define RAMP_CACHE_ENTRIES 8                  // Ramps held in RAM
+#define RAMP_CACHE_HOT_USES 3                 // Uses after which a ramp is written to NVS
+#define RAMP_CACHE_NVS_SLOTS 4                // Ramps held in NVS
+#define RAMP_CACHE_NVS_NAMESPACE "ramp_cache" // NVS namespace of the records
+#define RAMP_CACHE_NVS_VERSION 1              // Version of the stored records
+
+/** Parameters a cached ramp was planned for */
+typedef struct
+{
+    uint32_t Max_Frequency_Hz; // Cruise frequency
+    uint32_t Acceleration;     // Acceleration limit (steps/s^2)
+    uint32_t Jerk;             // Jerk limit (steps/s^3)
+    uint32_t Segment_Time_us;  // Nominal segment duration
+    uint32_t Microsteps;       // Microstep setting of the driver
+} Ramp_Cache_Key_t;
+
+/** Counters of the cache */
+typedef struct
+{
+    uint32_t Hits;       // Ramps taken from the cache
+    uint32_t Misses;     // Ramps planned because they were not cached
+    uint32_t Evictions;  // Ramps dropped to make room
+    uint32_t Entries;    // Ramps held in RAM
+    uint32_t Nvs_Loaded; // Ramps loaded from NVS at start up
+    uint32_t Nvs_Writes; // Hot ramps written to NVS
+    uint32_t Nvs_Errors; // Failed NVS accesses
+} Ramp_Cache_Stats_t;
+
+esp_err_t Initialize_Ramp_Cache(void);
+bool Ramp_Cache_Plan_Ramp(const Motion_Planner_Config_t *Config, uint32_t Microsteps, Motion_Profile_t *Profile);
+esp_err_t Ramp_Cache_Persist_Hot(void);
+void Ramp_Cache_Get_Stats(Ramp_Cache_Stats_t *Stats_Out);
+esp_err_t Ramp_Cache_Clear(bool Erase_Nvs);
+
+#endif // RAMP_CACHE_H
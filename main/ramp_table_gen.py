@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+FILENAME :        ramp_table_gen.py             DESIGN REF: NA
+
+DESCRIPTION :
+      Generates ramp_tables.c, the accel ramp tables of the motion planner,
+      see ramp_tables.h.
+
+NOTES :
+      The segments are computed with the same integer math as
+      Motion_Planner_Build_Linear_Ramp() in motion_planner.c, so a table
+      and the runtime computation give the same result bit for bit. Keep
+      both in step when changing one of them.
+
+      Usage: ramp_table_gen.py --segment-time-us <us> --output <file>
+
+      Copyright: All rights reserved.
+
+AUTHOR     :  Saurabh kadam.
+START DATE :  17 Oct 2026
+"""
+
+import argparse
+
+ACCELERATIONS = (50000, 100000, 200000)                        # Common acceleration settings in steps/s^2
+FREQUENCIES = (500, 1000, 2000, 5000, 10000, 20000, 50000)     # Common cruise frequencies in Hz
+MAX_RAMP_SEGMENTS = 64                                         # MOTION_PLANNER_MAX_RAMP_SEGMENTS
+UINT32_MAX = 0xFFFFFFFF
+
+
+def mul_div_round(a, b, divisor):
+    """Motion_Math_Mul_Div_Round(), rounded half up."""
+    quotient, remainder = divmod(a * b, divisor)
+    return quotient + (1 if remainder >= divisor - remainder else 0)
+
+
+def ramp_steps(frequency, acceleration):
+    """Motion_Planner_Ramp_Steps()."""
+    return min(mul_div_round(frequency, frequency, 2 * acceleration), UINT32_MAX)
+
+
+def build_linear_ramp(start, end, steps, segment_time_us):
+    """Motion_Planner_Build_Linear_Ramp(), returns a list of (frequency, steps)."""
+    frequency_sum = start + end
+    if steps == 0 or frequency_sum == 0 or segment_time_us == 0:
+        return []
+
+    numerator = 2 * steps * 1000000
+    denominator = min(frequency_sum * segment_time_us, 0xFFFFFFFFFFFFFFFF)
+    slices = -(-numerator // denominator)
+    slices = min(max(slices, 1), MAX_RAMP_SEGMENTS)
+
+    divisor = frequency_sum * slices * slices
+    segments = []
+    previous = 0
+    pending = 0
+
+    for k in range(1, slices + 1):
+        weight = start * (2 * k * slices - k * k) + end * k * k
+        position = steps if k == slices else mul_div_round(steps, weight, divisor)
+        pending += 1
+
+        if position <= previous:
+            continue
+
+        segment_steps = position - previous
+        frequency = min(mul_div_round(segment_steps * slices, frequency_sum, 2 * pending * steps), UINT32_MAX)
+        segments.append((frequency if frequency > 0 else 1, segment_steps))
+        previous = position
+        pending = 0
+
+    return segments
+
+
+def generate(segment_time_us):
+    lines = [
+        "/* Generated by ramp_table_gen.py, do not edit. */",
+        "",
+        '#include "ramp_tables.h"',
+        "",
+    ]
+    entries = []
+
+    for acceleration in ACCELERATIONS:
+        for frequency in FREQUENCIES:
+            steps = ramp_steps(frequency, acceleration)
+            segments = build_linear_ramp(0, frequency, steps, segment_time_us)
+            if not segments:
+                continue
+
+            name = "Ramp_%d_%d" % (acceleration, frequency)
+            lines.append("static const Motion_Segment_t %s[] = {" % name)
+            lines.extend("    {%d, %d}," % segment for segment in segments)
+            lines.append("};")
+            lines.append("")
+            entries.append("    {%d, %d, %d, %d, %d, %s}," % (acceleration, frequency, segment_time_us, steps, len(segments), name))
+
+    lines.append("const Motion_Ramp_Table_t Motion_Ramp_Tables[] = {")
+    lines.extend(entries)
+    lines.append("};")
+    lines.append("")
+    lines.append("const uint16_t Motion_Ramp_Table_Count = %d;" % len(entries))
+
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the accel ramp tables of the motion planner.")
+    parser.add_argument("--segment-time-us", type=int, required=True, help="nominal ramp slice duration, one RTOS tick")
+    parser.add_argument("--output", required=True, help="C file to write")
+    args = parser.parse_args()
+
+    with open(args.output, "w") as output:
+        output.write(generate(args.segment_time_us))
+
+
+if __name__ == "__main__":
+    main()
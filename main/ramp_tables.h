@@ -0,0 +1,42 @@
+/*H**********************************************************************
+ * FILENAME :        ramp_tables.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Accel ramp tables of the motion planner, generated at build time.
+ *
+ * NOTES :
+ *       ramp_tables.c is written into the build directory by
+ *       ramp_table_gen.py, for the accelerations and frequencies listed
+ *       there and the ramp slice duration of the build (one RTOS tick).
+ *       The tables are const, so on the ESP32 they stay in flash. Every
+ *       table holds exactly the segments Motion_Planner_Build_Linear_Ramp()
+ *       computes for a ramp from standstill, host/motion_math_check.c
+ *       checks this.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef RAMP_TABLES_H
+#define RAMP_TABLES_H
+
+#include <stdint.h>
+#include "motion_planner.h"
+
+/** Precomputed accel ramp from standstill */
+typedef struct
+{
+    uint32_t Acceleration;            // Acceleration of the ramp (steps/s^2)
+    uint32_t Frequency_Hz;            // Frequency at the end of the ramp
+    uint32_t Segment_Time_us;         // Nominal slice duration the ramp was cut with
+    uint32_t Ramp_Steps;              // Steps covered by the ramp
+    uint16_t Segment_Count;           // Number of entries in Segments
+    const Motion_Segment_t *Segments; // Ramp segments
+} Motion_Ramp_Table_t;
+
+extern const Motion_Ramp_Table_t Motion_Ramp_Tables[];
+extern const uint16_t Motion_Ramp_Table_Count;
+
+#endif // RAMP_TABLES_H
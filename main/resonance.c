@@ -0,0 +1,389 @@
+/*H**********************************************************************
+ * FILENAME :        resonance.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent resonance band avoidance of the stepper motor
+ *       example.
+ *
+ * NOTES :
+ *       Ramps are monotonic within their accel and decel phase, so a run of
+ *       segments inside a band either passes through it or turns back at
+ *       the peak of a short move. Only a passing run gets a crossing
+ *       segment; a run that turns back is held at the edge it came from.
+ *
+ *       A crossing segment takes (High^2 - Low^2) / (2 * acceleration)
+ *       steps at the band middle, the time a linear crossing at that
+ *       acceleration takes. The steps are taken from the two edge segments,
+ *       so the profile length is unchanged. If the profile has no room for
+ *       the extra segments the band is jumped across instead.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "resonance.h"
+
+#define RESONANCE_SIDE_NONE -1 // No segment next to the run
+#define RESONANCE_SIDE_BELOW 0 // Neighbour at or below the low edge
+#define RESONANCE_SIDE_ABOVE 1 // Neighbour at or above the high edge
+
+/**
+ * @brief Start an empty table with the default crossing acceleration.
+ */
+void Resonance_Init_Table(Resonance_Table_t *Table)
+{
+    memset(Table, 0, sizeof(*Table));
+
+    Table->Crossing_Acceleration = RESONANCE_DEFAULT_CROSSING_ACCELERATION;
+}
+
+/**
+ * @brief Add a band, merging it with the bands it overlaps or touches.
+ *
+ * @param Table Table to add to.
+ * @param Low_Hz Highest safe frequency below the band, at least 1.
+ * @param High_Hz Lowest safe frequency above the band, above Low_Hz + 1.
+ * @return false if the edges are invalid or the table is full.
+ */
+bool Resonance_Add_Band(Resonance_Table_t *Table, uint32_t Low_Hz, uint32_t High_Hz)
+{
+    Resonance_Band_t Merged = {Low_Hz, High_Hz};
+    Resonance_Table_t Result = *Table;
+
+    if ((Low_Hz == 0) || (High_Hz <= (Low_Hz + 1)))
+    {
+        return false; // Stopping is no safe edge, and a band needs a forbidden frequency
+    }
+
+    Result.Band_Count = 0;
+
+    for (uint8_t Index = 0; Index < Table->Band_Count; Index++)
+    {
+        const Resonance_Band_t *Band = &Table->Bands[Index];
+
+        if ((Band->High_Hz < Merged.Low_Hz) || (Band->Low_Hz > Merged.High_Hz))
+        {
+            Result.Bands[Result.Band_Count++] = *Band; // Apart, kept as it is
+        }
+        else
+        {
+            Merged.Low_Hz = (Band->Low_Hz < Merged.Low_Hz) ? Band->Low_Hz : Merged.Low_Hz;
+            Merged.High_Hz = (Band->High_Hz > Merged.High_Hz) ? Band->High_Hz : Merged.High_Hz;
+        }
+    }
+
+    if (Result.Band_Count >= RESONANCE_MAX_BANDS)
+    {
+        return false;
+    }
+
+    uint8_t Position = Result.Band_Count;
+
+    while ((Position > 0) && (Result.Bands[Position - 1].Low_Hz > Merged.Low_Hz))
+    {
+        Result.Bands[Position] = Result.Bands[Position - 1]; // Keep the bands sorted
+        Position--;
+    }
+
+    Result.Bands[Position] = Merged;
+    Result.Band_Count++;
+
+    *Table = Result;
+
+    return true;
+}
+
+/**
+ * @brief Band a frequency lies in.
+ *
+ * @return The band, or NULL if the frequency is safe.
+ */
+static const Resonance_Band_t *Find_Band(const Resonance_Table_t *Table, uint32_t Frequency_Hz)
+{
+    for (uint8_t Index = 0; Index < Table->Band_Count; Index++)
+    {
+        if ((Frequency_Hz > Table->Bands[Index].Low_Hz) && (Frequency_Hz < Table->Bands[Index].High_Hz))
+        {
+            return &Table->Bands[Index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Nearest safe frequency, the low edge on a tie.
+ *
+ * @param Table Bands to avoid.
+ * @param Frequency_Hz Requested frequency, 0 stays 0.
+ * @return Frequency_Hz if it is safe, the nearer edge of its band otherwise.
+ */
+uint32_t Resonance_Snap_Frequency(const Resonance_Table_t *Table, uint32_t Frequency_Hz)
+{
+    const Resonance_Band_t *Band = Find_Band(Table, Frequency_Hz);
+
+    if (Band == NULL)
+    {
+        return Frequency_Hz;
+    }
+
+    return ((Frequency_Hz - Band->Low_Hz) <= (Band->High_Hz - Frequency_Hz)) ? Band->Low_Hz : Band->High_Hz;
+}
+
+/**
+ * @brief Side of a band a neighbour of a run lies on.
+ */
+static int8_t Neighbour_Side(const Motion_Profile_t *Profile, int32_t Index, const Resonance_Band_t *Band)
+{
+    if ((Index < 0) || (Index >= Profile->Segment_Count))
+    {
+        return RESONANCE_SIDE_NONE;
+    }
+
+    return (Profile->Segments[Index].Frequency_Hz >= Band->High_Hz) ? RESONANCE_SIDE_ABOVE : RESONANCE_SIDE_BELOW;
+}
+
+/**
+ * @brief Replace a run of segments inside a band by at most three segments.
+ *
+ * @return false if the profile has no room, nothing is changed then.
+ */
+static bool Replace_Run(Motion_Profile_t *Profile, uint16_t First, uint16_t End, const Motion_Segment_t *New_Segments, uint16_t New_Count)
+{
+    int32_t Delta = (int32_t)New_Count - (int32_t)(End - First);
+
+    if ((Profile->Segment_Count + Delta) > MOTION_PROFILE_MAX_SEGMENTS)
+    {
+        return false;
+    }
+
+    memmove(&Profile->Segments[End + Delta], &Profile->Segments[End], (Profile->Segment_Count - End) * sizeof(Motion_Segment_t));
+    memcpy(&Profile->Segments[First], New_Segments, New_Count * sizeof(Motion_Segment_t));
+
+    if (First < Profile->Accel_Segments)
+    {
+        Profile->Accel_Segments += Delta;
+    }
+    else if (First < (Profile->Accel_Segments + Profile->Cruise_Segments))
+    {
+        Profile->Cruise_Segments += Delta;
+    }
+    else
+    {
+        Profile->Decel_Segments += Delta;
+    }
+
+    Profile->Segment_Count += Delta;
+
+    return true;
+}
+
+/**
+ * @brief Let a profile pass its resonance bands quickly.
+ *
+ * Segments inside a band are moved to its edges, a ramp passing the band
+ * crosses it in one segment at the crossing acceleration, see the NOTES.
+ * Totals, peak and duration are recomputed.
+ *
+ * @param Table Bands to avoid.
+ * @param Profile Planned profile, changed in place.
+ * @return true if a segment was changed.
+ */
+bool Resonance_Apply_To_Profile(const Resonance_Table_t *Table, Motion_Profile_t *Profile)
+{
+    bool Changed = false;
+
+    for (uint8_t Band_Index = 0; Band_Index < Table->Band_Count; Band_Index++)
+    {
+        const Resonance_Band_t *Band = &Table->Bands[Band_Index];
+        uint16_t Index = 0;
+
+        while (Index < Profile->Segment_Count)
+        {
+            uint32_t Frequency_Hz = Profile->Segments[Index].Frequency_Hz;
+
+            if ((Frequency_Hz <= Band->Low_Hz) || (Frequency_Hz >= Band->High_Hz))
+            {
+                Index++;
+                continue;
+            }
+
+            uint16_t End = Index;
+
+            while ((End < Profile->Segment_Count) && (Profile->Segments[End].Frequency_Hz > Band->Low_Hz) && (Profile->Segments[End].Frequency_Hz < Band->High_Hz))
+            {
+                End++;
+            }
+
+            int8_t Entry_Side = Neighbour_Side(Profile, (int32_t)Index - 1, Band);
+            int8_t Exit_Side = Neighbour_Side(Profile, End, Band);
+
+            Changed = true;
+
+            if ((Entry_Side == RESONANCE_SIDE_NONE) || (Exit_Side == RESONANCE_SIDE_NONE) || (Entry_Side == Exit_Side))
+            {
+                // Turns back inside the band, or starts or ends there: hold the edge it belongs to
+                for (uint16_t Run = Index; Run < End; Run++)
+                {
+                    int8_t Side = (Entry_Side != RESONANCE_SIDE_NONE) ? Entry_Side : Exit_Side;
+                    uint32_t Run_Frequency_Hz = Profile->Segments[Run].Frequency_Hz;
+
+                    if (Side == RESONANCE_SIDE_NONE)
+                    {
+                        Profile->Segments[Run].Frequency_Hz = Resonance_Snap_Frequency(Table, Run_Frequency_Hz);
+                    }
+                    else
+                    {
+                        Profile->Segments[Run].Frequency_Hz = (Side == RESONANCE_SIDE_ABOVE) ? Band->High_Hz : Band->Low_Hz;
+                    }
+                }
+
+                Index = End;
+                continue;
+            }
+
+            // Passes the band: entry edge, crossing, exit edge
+            uint32_t Entry_Edge_Hz = (Entry_Side == RESONANCE_SIDE_ABOVE) ? Band->High_Hz : Band->Low_Hz;
+            uint32_t Exit_Edge_Hz = (Entry_Side == RESONANCE_SIDE_ABOVE) ? Band->Low_Hz : Band->High_Hz;
+            uint32_t Middle_Hz = Band->Low_Hz + ((Band->High_Hz - Band->Low_Hz) / 2);
+            uint32_t Entry_Steps = 0;
+            uint32_t Exit_Steps = 0;
+            uint32_t Crossing_Steps = 0;
+
+            for (uint16_t Run = Index; Run < End; Run++)
+            {
+                uint32_t Run_Frequency_Hz = Profile->Segments[Run].Frequency_Hz;
+                uint32_t To_Entry = (Run_Frequency_Hz > Entry_Edge_Hz) ? (Run_Frequency_Hz - Entry_Edge_Hz) : (Entry_Edge_Hz - Run_Frequency_Hz);
+                uint32_t To_Exit = (Run_Frequency_Hz > Exit_Edge_Hz) ? (Run_Frequency_Hz - Exit_Edge_Hz) : (Exit_Edge_Hz - Run_Frequency_Hz);
+
+                if (To_Entry <= To_Exit)
+                {
+                    Entry_Steps += Profile->Segments[Run].Steps;
+                }
+                else
+                {
+                    Exit_Steps += Profile->Segments[Run].Steps;
+                }
+            }
+
+            if (Table->Crossing_Acceleration != 0)
+            {
+                uint64_t Span = ((uint64_t)Band->High_Hz * Band->High_Hz) - ((uint64_t)Band->Low_Hz * Band->Low_Hz);
+                uint64_t Divisor = 2ULL * Table->Crossing_Acceleration;
+                uint64_t Steps = (Span + Divisor - 1) / Divisor;
+
+                Crossing_Steps = (Steps < (uint64_t)(Entry_Steps + Exit_Steps)) ? (uint32_t)Steps : (Entry_Steps + Exit_Steps);
+            }
+
+            // Take the crossing from the larger edge segment first
+            uint32_t *Larger = (Entry_Steps >= Exit_Steps) ? &Entry_Steps : &Exit_Steps;
+            uint32_t *Smaller = (Entry_Steps >= Exit_Steps) ? &Exit_Steps : &Entry_Steps;
+            uint32_t Taken = (Crossing_Steps < *Larger) ? Crossing_Steps : *Larger;
+
+            *Larger -= Taken;
+            *Smaller -= Crossing_Steps - Taken;
+
+            Motion_Segment_t New_Segments[3];
+            uint16_t New_Count = 0;
+
+            if (Entry_Steps > 0)
+            {
+                New_Segments[New_Count++] = (Motion_Segment_t){Entry_Edge_Hz, Entry_Steps};
+            }
+
+            if (Crossing_Steps > 0)
+            {
+                New_Segments[New_Count++] = (Motion_Segment_t){Middle_Hz, Crossing_Steps};
+            }
+
+            if (Exit_Steps > 0)
+            {
+                New_Segments[New_Count++] = (Motion_Segment_t){Exit_Edge_Hz, Exit_Steps};
+            }
+
+            if ((New_Count == 0) || !Replace_Run(Profile, Index, End, New_Segments, New_Count))
+            {
+                // No steps to place, or no room: jump from edge to edge
+                for (uint16_t Run = Index; Run < End; Run++)
+                {
+                    Profile->Segments[Run].Frequency_Hz = (Run == Index) ? Entry_Edge_Hz : Exit_Edge_Hz;
+                }
+
+                Index = End;
+                continue;
+            }
+
+            Index += New_Count;
+        }
+    }
+
+    if (Changed)
+    {
+        Profile->Peak_Frequency_Hz = 0;
+
+        Motion_Planner_Finish_Profile(Profile);
+    }
+
+    return Changed;
+}
+
+/**
+ * @brief Turn the sense counts of a frequency sweep into bands.
+ *
+ * Point N was measured at Start_Hz + N * Step_Hz. Consecutive points with
+ * at least Threshold counts form one band, whose edges lie half a step
+ * outside the first and the last of them.
+ *
+ * @param Counts Sense edges counted at every point.
+ * @param Points Number of points.
+ * @param Start_Hz Frequency of the first point.
+ * @param Step_Hz Frequency increment between the points.
+ * @param Threshold Counts marking a resonant point, at least 1.
+ * @param Table Output, its bands are replaced, the crossing acceleration is kept.
+ * @return Bands found, the table keeps the first RESONANCE_MAX_BANDS of them.
+ */
+uint8_t Resonance_Find_Bands(const uint32_t *Counts, uint16_t Points, uint32_t Start_Hz, uint32_t Step_Hz, uint32_t Threshold, Resonance_Table_t *Table)
+{
+    uint8_t Found = 0;
+    uint16_t Point = 0;
+
+    Table->Band_Count = 0;
+    Threshold = (Threshold == 0) ? 1 : Threshold;
+
+    while (Point < Points)
+    {
+        if (Counts[Point] < Threshold)
+        {
+            Point++;
+            continue;
+        }
+
+        uint16_t Last = Point;
+
+        while (((Last + 1) < Points) && (Counts[Last + 1] >= Threshold))
+        {
+            Last++;
+        }
+
+        uint32_t First_Hz = Start_Hz + (Point * Step_Hz);
+        uint32_t Last_Hz = Start_Hz + (Last * Step_Hz);
+        uint32_t Low_Hz = (First_Hz > ((Step_Hz / 2) + 1)) ? (First_Hz - (Step_Hz / 2)) : 1;
+        uint32_t High_Hz = Last_Hz + (Step_Hz / 2);
+
+        High_Hz = (High_Hz <= (Low_Hz + 1)) ? (Low_Hz + 2) : High_Hz;
+
+        Found++;
+
+        if (Table->Band_Count < RESONANCE_MAX_BANDS)
+        {
+            Table->Bands[Table->Band_Count++] = (Resonance_Band_t){Low_Hz, High_Hz}; // Ascending points give sorted, apart bands
+        }
+
+        Point = Last + 1;
+    }
+
+    return Found;
+}
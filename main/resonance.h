@@ -0,0 +1,53 @@
+/*H**********************************************************************
+ * FILENAME :        resonance.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent resonance band avoidance of the stepper motor
+ *       example.
+ *
+ * NOTES :
+ *       A band forbids the step frequencies strictly between its low and
+ *       high edge, the edges themselves are safe. A set-point inside a band
+ *       is snapped to the nearer edge. A planned ramp that passes through a
+ *       band holds the edge it enters from, crosses the band in one segment
+ *       at the band middle, timed for the crossing acceleration, and goes on
+ *       from the other edge. The steps of the profile stay the same.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef RESONANCE_H
+#define RESONANCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "motion_planner.h"
+
+#define RESONANCE_MAX_BANDS 8                          // Bands of one motor
+#define RESONANCE_DEFAULT_CROSSING_ACCELERATION 500000 // Acceleration a band is crossed at in steps/s^2
+
+/** Forbidden step frequencies, strictly between the edges */
+typedef struct
+{
+    uint32_t Low_Hz;  // Highest safe frequency below the band
+    uint32_t High_Hz; // Lowest safe frequency above the band
+} Resonance_Band_t;
+
+/** Resonance bands of one motor */
+typedef struct
+{
+    Resonance_Band_t Bands[RESONANCE_MAX_BANDS]; // Sorted by frequency, never overlapping
+    uint8_t Band_Count;                          // Valid entries in Bands
+    uint32_t Crossing_Acceleration;              // Acceleration a ramp crosses a band at in steps/s^2, 0 jumps across
+} Resonance_Table_t;
+
+void Resonance_Init_Table(Resonance_Table_t *Table);
+bool Resonance_Add_Band(Resonance_Table_t *Table, uint32_t Low_Hz, uint32_t High_Hz);
+uint32_t Resonance_Snap_Frequency(const Resonance_Table_t *Table, uint32_t Frequency_Hz);
+bool Resonance_Apply_To_Profile(const Resonance_Table_t *Table, Motion_Profile_t *Profile);
+uint8_t Resonance_Find_Bands(const uint32_t *Counts, uint16_t Points, uint32_t Start_Hz, uint32_t Step_Hz, uint32_t Threshold, Resonance_Table_t *Table);
+
+#endif // RESONANCE_H
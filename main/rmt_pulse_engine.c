@@ -0,0 +1,210 @@
+/*H**********************************************************************
+ * FILENAME :        rmt_pulse_engine.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       RMT based pulse engine for the stepper motor example.
+ *
+ * NOTES :
+ *       rmt_write_sample() is given the profile as its source with a size
+ *       of one byte per step. The driver never reads the source itself, it
+ *       only passes it to the translator and counts the consumed size down,
+ *       so the transmission ends exactly when the last step is encoded.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "rmt_pulse_engine.h"
+#include "main.h"
+#include "segment_encoder.h"
+
+_Static_assert(sizeof(Pulse_Item_t) == sizeof(rmt_item32_t), "Pulse_Item_t must match the RMT item layout");
+
+#define RMT_PULSE_ENGINE_HOLD_ITEMS 8 // Items used to loop the held cruise frequency
+
+static Segment_Encoder_t Encoder;                                // Encoding state of the running profile
+static Motion_Profile_t Hold_Profile;                            // One step at the held cruise frequency
+static rmt_item32_t Hold_Items[RMT_PULSE_ENGINE_HOLD_ITEMS];     // Looped items of the held cruise frequency
+static volatile bool Holding = false;                            // True while the cruise frequency is looped
+static portMUX_TYPE Encoder_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards the encoder between the RMT interrupt and an abort
+
+/**
+ * @brief RMT translator, called by the driver whenever its memory needs refilling.
+ *
+ * @param src Source handed to rmt_write_sample(), unused.
+ * @param dest RMT items to fill.
+ * @param src_size Steps left to encode.
+ * @param wanted_num Number of items the driver wants.
+ * @param translated_size Returns the number of steps completed.
+ * @param item_num Returns the number of items written.
+ */
+static void RMT_Translator(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num, size_t *translated_size, size_t *item_num)
+{
+    uint32_t Steps_Done = 0;
+
+    portENTER_CRITICAL_ISR(&Encoder_Lock);
+    *item_num = Segment_Encoder_Fill(&Encoder, (Pulse_Item_t *)dest, wanted_num, &Steps_Done);
+    portEXIT_CRITICAL_ISR(&Encoder_Lock);
+
+    *translated_size = Steps_Done;
+}
+
+/**
+ * @brief Start looping one step period of the given frequency.
+ */
+static esp_err_t Hold_Frequency(uint32_t Frequency_Hz)
+{
+    esp_err_t Function_Error = ESP_OK;
+    Segment_Encoder_t Hold_Encoder;
+
+    if (Holding)
+    {
+        Function_Error += rmt_tx_stop(RMT_PULSE_ENGINE_CHANNEL); // The loop is rewritten, at most one step period is lost
+    }
+
+    Hold_Profile.Segments[0].Frequency_Hz = Frequency_Hz;
+    Hold_Profile.Segments[0].Steps = 1;
+    Hold_Profile.Segment_Count = 1;
+    Hold_Profile.Total_Steps = 1;
+
+    Segment_Encoder_Begin(&Hold_Encoder, &Hold_Profile, RMT_PULSE_ENGINE_TICK_HZ, RMT_PULSE_ENGINE_HIGH_TICKS);
+
+    size_t Item_Count = Segment_Encoder_Fill(&Hold_Encoder, (Pulse_Item_t *)Hold_Items, RMT_PULSE_ENGINE_HOLD_ITEMS, NULL);
+
+    Function_Error += rmt_set_tx_loop_mode(RMT_PULSE_ENGINE_CHANNEL, true);                          // Repeat the period until stopped
+    Function_Error += rmt_write_items(RMT_PULSE_ENGINE_CHANNEL, Hold_Items, (int)Item_Count, false); // One step period
+
+    Holding = true;
+
+    return Function_Error;
+}
+
+/**
+ * @brief Initialize the RMT channel driving the step pulses.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t Initialize_RMT_Pulse_Engine(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    // Configuration structure for the RMT channel
+    rmt_config_t RMT_channel_for_stepper_motor = {}; // Zero-initialize the config structure
+
+    RMT_channel_for_stepper_motor.rmt_mode = RMT_MODE_TX;                      // Transmit only
+    RMT_channel_for_stepper_motor.channel = RMT_PULSE_ENGINE_CHANNEL;          // RMT channel
+    RMT_channel_for_stepper_motor.gpio_num = STEPPER_MOTOR_PUL_PIN;            // Assign the GPIO pin for the stepper motor pulse
+    RMT_channel_for_stepper_motor.clk_div = RMT_PULSE_ENGINE_CLK_DIV;          // Tick rate of the items
+    RMT_channel_for_stepper_motor.mem_block_num = RMT_PULSE_ENGINE_MEM_BLOCKS; // Larger memory means fewer refill interrupts
+    RMT_channel_for_stepper_motor.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;   // Pulse pin low between moves
+    RMT_channel_for_stepper_motor.tx_config.idle_output_en = true;             // Drive the idle level
+    RMT_channel_for_stepper_motor.tx_config.carrier_en = false;                // No carrier modulation
+    RMT_channel_for_stepper_motor.tx_config.loop_en = false;                   // Single transmission per move
+
+    Function_Error += rmt_config(&RMT_channel_for_stepper_motor);
+    Function_Error += rmt_driver_install(RMT_PULSE_ENGINE_CHANNEL, 0, 0);
+    Function_Error += rmt_translator_init(RMT_PULSE_ENGINE_CHANNEL, RMT_Translator);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Emit a planned profile and wait for its last step.
+ *
+ * For a continuous profile the held cruise frequency is looped after the
+ * ramp and the function returns with the motor still running.
+ *
+ * @param Profile The profile to execute.
+ * @param Timeout Longest time to wait for the transmission to end.
+ * @param Abort_Requested Flag set by RMT_Pulse_Engine_Abort() callers, checked before starting.
+ * @param Executed_Steps Returns the number of steps handed to the RMT, may be NULL.
+ * @return ESP_OK if successful, ESP_ERR_TIMEOUT if the transmission did not
+ *         end in time, or the error of the failing RMT call.
+ */
+esp_err_t RMT_Pulse_Engine_Run(const Motion_Profile_t *Profile, TickType_t Timeout, const volatile bool *Abort_Requested, uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    portENTER_CRITICAL(&Encoder_Lock);
+    Segment_Encoder_Begin(&Encoder, Profile, RMT_PULSE_ENGINE_TICK_HZ, RMT_PULSE_ENGINE_HIGH_TICKS);
+    portEXIT_CRITICAL(&Encoder_Lock);
+
+    if ((Profile->Total_Steps > 0) && !(*Abort_Requested))
+    {
+        Function_Error += rmt_set_tx_loop_mode(RMT_PULSE_ENGINE_CHANNEL, false);
+        Function_Error += rmt_write_sample(RMT_PULSE_ENGINE_CHANNEL, (const uint8_t *)Profile, Profile->Total_Steps, false); // One source byte per step
+
+        MOTION_TRACE(MOTION_TRACE_PULSE_START, (Profile->Segment_Count > 0) ? Profile->Segments[0].Frequency_Hz : 0);
+
+        if ((Function_Error == ESP_OK) && (rmt_wait_tx_done(RMT_PULSE_ENGINE_CHANNEL, Timeout) != ESP_OK))
+        {
+            rmt_tx_stop(RMT_PULSE_ENGINE_CHANNEL);
+
+            Function_Error = ESP_ERR_TIMEOUT;
+        }
+    }
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Encoder.Steps_Encoded;
+    }
+
+    if (Profile->Continuous && (Profile->Segment_Count > 0) && (Function_Error == ESP_OK) && !(*Abort_Requested))
+    {
+        Function_Error = Hold_Frequency(Profile->Segments[Profile->Segment_Count - 1].Frequency_Hz); // Held cruise frequency
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Run the step pulses continuously at a frequency, used by the jog mode.
+ *
+ * @param Frequency_Hz Step frequency, not 0.
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t RMT_Pulse_Engine_Hold(uint32_t Frequency_Hz)
+{
+    return Hold_Frequency(Frequency_Hz);
+}
+
+/**
+ * @brief End the running profile after the items already handed to the RMT.
+ *
+ * The translator stops producing items, so the driver ends the transmission
+ * normally within one refill and the steps already encoded are emitted.
+ * A looped cruise frequency is stopped immediately.
+ */
+void RMT_Pulse_Engine_Abort(void)
+{
+    portENTER_CRITICAL(&Encoder_Lock);
+    Segment_Encoder_Abort(&Encoder);
+    portEXIT_CRITICAL(&Encoder_Lock);
+
+    if (Holding)
+    {
+        RMT_Pulse_Engine_Stop();
+    }
+}
+
+/**
+ * @brief Stop the step pulses immediately.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t RMT_Pulse_Engine_Stop(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    Holding = false;
+
+    Function_Error += rmt_tx_stop(RMT_PULSE_ENGINE_CHANNEL);
+    Function_Error += rmt_set_tx_loop_mode(RMT_PULSE_ENGINE_CHANNEL, false);
+
+    return Function_Error;
+}
@@ -0,0 +1,38 @@
+/*H**********************************************************************
+ * FILENAME :        rmt_pulse_engine.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       RMT based pulse engine for the stepper motor example.
+ *
+ * NOTES :
+ *       The planned profile is streamed into the RMT memory by the driver
+ *       interrupt through a translator, so every step has its own period
+ *       and no frequency change has to be made from task context.
+ *       Selected with STEPPER_PULSE_ENGINE in main.h, LEDC is the default.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef RMT_PULSE_ENGINE_H
+#define RMT_PULSE_ENGINE_H
+
+#include "freertos/FreeRTOS.h"
+#include "driver/rmt.h"
+#include "motion_planner.h"
+
+#define RMT_PULSE_ENGINE_CHANNEL RMT_CHANNEL_0 // RMT channel driving the PUL pin
+#define RMT_PULSE_ENGINE_CLK_DIV 8             // 80 MHz APB clock / 8 = 10 MHz tick
+#define RMT_PULSE_ENGINE_TICK_HZ 10000000      // Tick rate resulting from RMT_PULSE_ENGINE_CLK_DIV
+#define RMT_PULSE_ENGINE_HIGH_TICKS 25         // Step pulse high time, 2.5 us
+#define RMT_PULSE_ENGINE_MEM_BLOCKS 4          // Memory blocks of the channel, channels 1 to 3 give theirs up
+
+esp_err_t Initialize_RMT_Pulse_Engine(void);
+esp_err_t RMT_Pulse_Engine_Run(const Motion_Profile_t *Profile, TickType_t Timeout, const volatile bool *Abort_Requested, uint32_t *Executed_Steps);
+esp_err_t RMT_Pulse_Engine_Hold(uint32_t Frequency_Hz);
+void RMT_Pulse_Engine_Abort(void);
+esp_err_t RMT_Pulse_Engine_Stop(void);
+
+#endif // RMT_PULSE_ENGINE_H
@@ -0,0 +1,267 @@
+/*H**********************************************************************
+ * FILENAME :        segment_encoder.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent encoder turning a planned profile into a
+ *       stream of timed pulse items for a streaming pulse engine.
+ *
+ * NOTES :
+ *       Called from the RMT driver interrupt while a move is running, so
+ *       nothing in here may block or allocate. A duration of 0 ends an RMT
+ *       transmission, so no item half is ever encoded with 0 ticks.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "segment_encoder.h"
+
+/**
+ * @brief Load the next segment that has steps to encode.
+ *
+ * Held (open ended) segments are not encoded, they end the stream.
+ */
+static void Load_Next_Segment(Segment_Encoder_t *Encoder)
+{
+    const Motion_Profile_t *Profile = Encoder->Profile;
+
+    while ((Encoder->Segment_Steps_Left == 0) && (Encoder->Segment_Index < Profile->Segment_Count))
+    {
+        const Motion_Segment_t *Segment = &Profile->Segments[Encoder->Segment_Index++];
+
+        if (Segment->Steps == 0)
+        {
+            Encoder->Segment_Index = Profile->Segment_Count; // Held segment, nothing left to encode
+
+            break;
+        }
+
+        Encoder->Segment_Steps_Left = Segment->Steps;
+        Encoder->Period_Q16 = ((uint64_t)Encoder->Tick_Hz << 16) / Segment->Frequency_Hz;
+    }
+}
+
+/**
+ * @brief Book a step whose last item has been emitted.
+ */
+static void Complete_Step(Segment_Encoder_t *Encoder)
+{
+    Encoder->Steps_Encoded++;
+    Encoder->Ticks_Encoded += Encoder->Step_Ticks;
+    Encoder->Step_Ticks = 0;
+}
+
+/**
+ * @brief Emit one all-low item covering part of the pending low time.
+ *
+ * Both halves get at least one tick; the split keeps at least two ticks
+ * pending for the next item whenever the pending time does not fit.
+ */
+static Pulse_Item_t Encode_Low_Item(Segment_Encoder_t *Encoder)
+{
+    Pulse_Item_t Item = {0};
+    uint32_t Pending = Encoder->Low_Ticks_Pending;
+
+    if (Pending > (2 * SEGMENT_ENCODER_MAX_DURATION))
+    {
+        Item.Duration0 = SEGMENT_ENCODER_MAX_DURATION;
+        Item.Duration1 = SEGMENT_ENCODER_MAX_DURATION - 1; // Leaves at least 2 ticks pending
+    }
+    else
+    {
+        Item.Duration0 = Pending / 2;
+        Item.Duration1 = Pending - (Pending / 2);
+    }
+
+    Encoder->Low_Ticks_Pending -= Item.Duration0 + Item.Duration1;
+
+    if (Encoder->Low_Ticks_Pending == 0)
+    {
+        Complete_Step(Encoder);
+    }
+
+    return Item;
+}
+
+/**
+ * @brief Emit the pulse item of the next step.
+ *
+ * Periods too long for one item leave the rest of their low time pending.
+ */
+static Pulse_Item_t Encode_Step_Item(Segment_Encoder_t *Encoder)
+{
+    Pulse_Item_t Item = {0};
+
+    uint64_t Period_Q16 = Encoder->Phase_Q16 + Encoder->Period_Q16;
+    uint32_t Period = (uint32_t)(Period_Q16 >> 16);
+
+    Encoder->Phase_Q16 = (uint32_t)(Period_Q16 & 0xFFFF);
+
+    if (Period < 2)
+    {
+        Period = 2; // Shortest representable pulse: one tick high, one tick low
+    }
+
+    uint32_t High = (Encoder->High_Ticks < (Period / 2)) ? Encoder->High_Ticks : (Period / 2);
+    uint32_t Low = Period - High;
+
+    if (High == 0)
+    {
+        High = 1;
+        Low = Period - 1;
+    }
+
+    if (Low > SEGMENT_ENCODER_MAX_DURATION)
+    {
+        Encoder->Low_Ticks_Pending = Low - (SEGMENT_ENCODER_MAX_DURATION - 1); // At least 2 ticks pending
+        Low = SEGMENT_ENCODER_MAX_DURATION - 1;
+    }
+
+    Item.Duration0 = High;
+    Item.Level0 = 1;
+    Item.Duration1 = Low;
+    Item.Level1 = 0;
+
+    Encoder->Step_Ticks = Period;
+    Encoder->Segment_Steps_Left--;
+
+    if (Encoder->Low_Ticks_Pending == 0)
+    {
+        Complete_Step(Encoder);
+    }
+
+    return Item;
+}
+
+/**
+ * @brief Prepare the encoder for a new profile.
+ *
+ * @param Encoder Encoder state.
+ * @param Profile Profile to encode.
+ * @param Tick_Hz Tick rate of the pulse engine.
+ * @param High_Ticks High time of every step pulse, shortened if the period is too short.
+ */
+void Segment_Encoder_Begin(Segment_Encoder_t *Encoder, const Motion_Profile_t *Profile, uint32_t Tick_Hz, uint32_t High_Ticks)
+{
+    Encoder->Profile = Profile;
+    Encoder->Tick_Hz = Tick_Hz;
+    Encoder->High_Ticks = High_Ticks;
+    Encoder->Segment_Index = 0;
+    Encoder->Segment_Steps_Left = 0;
+    Encoder->Period_Q16 = 0;
+    Encoder->Phase_Q16 = 0;
+    Encoder->Low_Ticks_Pending = 0;
+    Encoder->Step_Ticks = 0;
+    Encoder->Steps_Encoded = 0;
+    Encoder->Ticks_Encoded = 0;
+
+    Load_Next_Segment(Encoder);
+}
+
+/**
+ * @brief Encode the next items of the profile.
+ *
+ * Fills the buffer completely unless the end of the profile is reached.
+ *
+ * @param Encoder Encoder state.
+ * @param Items Output buffer.
+ * @param Max_Items Size of the output buffer.
+ * @param Steps_Done Returns the number of steps completed by the written items, may be NULL.
+ * @return Number of items written, 0 once the profile is fully encoded.
+ */
+size_t Segment_Encoder_Fill(Segment_Encoder_t *Encoder, Pulse_Item_t *Items, size_t Max_Items, uint32_t *Steps_Done)
+{
+    size_t Item_Count = 0;
+    uint32_t Steps_Before = Encoder->Steps_Encoded;
+
+    while (Item_Count < Max_Items)
+    {
+        if (Encoder->Low_Ticks_Pending > 0)
+        {
+            Items[Item_Count++] = Encode_Low_Item(Encoder); // Rest of a long period
+        }
+        else if (Encoder->Segment_Steps_Left > 0)
+        {
+            Items[Item_Count++] = Encode_Step_Item(Encoder);
+
+            if (Encoder->Segment_Steps_Left == 0)
+            {
+                Load_Next_Segment(Encoder);
+            }
+        }
+        else
+        {
+            break; // Profile fully encoded
+        }
+    }
+
+    if (Steps_Done != NULL)
+    {
+        *Steps_Done = Encoder->Steps_Encoded - Steps_Before;
+    }
+
+    return Item_Count;
+}
+
+/**
+ * @brief End the stream after the items already encoded.
+ *
+ * A step whose high time has been emitted counts as completed, its
+ * pending low time is dropped.
+ */
+void Segment_Encoder_Abort(Segment_Encoder_t *Encoder)
+{
+    if (Encoder->Profile == NULL)
+    {
+        return; // Nothing encoded yet
+    }
+
+    if (Encoder->Low_Ticks_Pending > 0)
+    {
+        Encoder->Step_Ticks -= Encoder->Low_Ticks_Pending;
+        Encoder->Low_Ticks_Pending = 0;
+
+        Complete_Step(Encoder);
+    }
+
+    Encoder->Segment_Steps_Left = 0;
+    Encoder->Segment_Index = Encoder->Profile->Segment_Count;
+}
+
+/**
+ * @brief Check whether the whole profile has been encoded.
+ */
+bool Segment_Encoder_Done(const Segment_Encoder_t *Encoder)
+{
+    return (Encoder->Low_Ticks_Pending == 0) && (Encoder->Segment_Steps_Left == 0);
+}
+
+/**
+ * @brief Difference between the encoded and the ideal duration of the encoded steps.
+ *
+ * The ideal duration is the exact sum of 1/frequency over every encoded step.
+ *
+ * @param Encoder Encoder state.
+ * @return Encoded minus ideal duration in nanoseconds.
+ */
+int64_t Segment_Encoder_Timing_Error_ns(const Segment_Encoder_t *Encoder)
+{
+    const Motion_Profile_t *Profile = Encoder->Profile;
+    uint32_t Steps_Left = Encoder->Steps_Encoded;
+    uint64_t Ideal_ns = 0;
+
+    for (uint16_t Index = 0; (Index < Profile->Segment_Count) && (Steps_Left > 0); Index++)
+    {
+        const Motion_Segment_t *Segment = &Profile->Segments[Index];
+        uint32_t Steps = (Segment->Steps < Steps_Left) ? Segment->Steps : Steps_Left;
+
+        Ideal_ns += ((uint64_t)Steps * 1000000000ULL) / Segment->Frequency_Hz;
+        Steps_Left -= Steps;
+    }
+
+    uint64_t Encoded_ns = (Encoder->Ticks_Encoded * 1000000000ULL) / Encoder->Tick_Hz;
+
+    return (int64_t)Encoded_ns - (int64_t)Ideal_ns;
+}
@@ -0,0 +1,61 @@
+/*H**********************************************************************
+ * FILENAME :        segment_encoder.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent encoder turning a planned profile into a
+ *       stream of timed pulse items for a streaming pulse engine.
+ *
+ * NOTES :
+ *       Pulse_Item_t has the same layout as the ESP32 rmt_item32_t, so the
+ *       RMT backend can hand the encoded items to the driver unchanged.
+ *       Periods are tracked in Q16 fractions of a tick so the rounding of
+ *       individual periods does not accumulate over a segment.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef SEGMENT_ENCODER_H
+#define SEGMENT_ENCODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "motion_planner.h"
+
+#define SEGMENT_ENCODER_MAX_DURATION 32767 // Longest duration of one item half in ticks (15 bits)
+
+/** One pulse item: level0 for duration0 ticks, then level1 for duration1 ticks */
+typedef struct
+{
+    uint32_t Duration0 : 15; // Ticks of the first half
+    uint32_t Level0 : 1;     // Output level of the first half
+    uint32_t Duration1 : 15; // Ticks of the second half
+    uint32_t Level1 : 1;     // Output level of the second half
+} Pulse_Item_t;
+
+/** Encoding state of one profile */
+typedef struct
+{
+    const Motion_Profile_t *Profile; // Profile being encoded
+    uint32_t Tick_Hz;                // Tick rate of the pulse engine
+    uint32_t High_Ticks;             // High time of every step pulse
+    uint16_t Segment_Index;          // Next segment to load
+    uint32_t Segment_Steps_Left;     // Steps left in the current segment
+    uint64_t Period_Q16;             // Step period of the current segment in Q16 ticks
+    uint32_t Phase_Q16;              // Fraction of a tick carried to the next step
+    uint32_t Low_Ticks_Pending;      // Low time of a long period not yet emitted
+    uint32_t Step_Ticks;             // Period of the step being emitted
+    uint32_t Steps_Encoded;          // Steps completely encoded so far
+    uint64_t Ticks_Encoded;          // Total duration of all completed steps
+} Segment_Encoder_t;
+
+void Segment_Encoder_Begin(Segment_Encoder_t *Encoder, const Motion_Profile_t *Profile, uint32_t Tick_Hz, uint32_t High_Ticks);
+size_t Segment_Encoder_Fill(Segment_Encoder_t *Encoder, Pulse_Item_t *Items, size_t Max_Items, uint32_t *Steps_Done);
+void Segment_Encoder_Abort(Segment_Encoder_t *Encoder);
+bool Segment_Encoder_Done(const Segment_Encoder_t *Encoder);
+int64_t Segment_Encoder_Timing_Error_ns(const Segment_Encoder_t *Encoder);
+
+#endif // SEGMENT_ENCODER_H
@@ -0,0 +1,120 @@
+/*H**********************************************************************
+ * FILENAME :        segment_ring.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Lock-free single producer, single consumer ring of step segments
+ *       between a task and a step interrupt.
+ *
+ * NOTES :
+ *       Only the producer writes Head and only the consumer writes Tail,
+ *       each publishes its index with a release store after the item
+ *       access, so the ring works across both cores without a lock. The
+ *       functions are forced inline so they end up in the IRAM of an
+ *       interrupt handler placed there.
+ *
+ *       A segment with SEGMENT_RING_HOLD steps repeats its period until the
+ *       producer pushes the next segment or the consumer is stopped.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef SEGMENT_RING_H
+#define SEGMENT_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SEGMENT_RING_SIZE 32         // Segments the ring holds, a power of two
+#define SEGMENT_RING_HOLD UINT32_MAX // Steps of a segment held until the next one arrives
+
+#define SEGMENT_RING_INLINE static inline __attribute__((always_inline))
+
+_Static_assert((SEGMENT_RING_SIZE & (SEGMENT_RING_SIZE - 1)) == 0, "SEGMENT_RING_SIZE must be a power of two");
+
+/** One segment of constant step period */
+typedef struct
+{
+    uint64_t Period_Q16; // Step period in Q16 ticks of the consumer
+    uint32_t Steps;      // Steps of the segment, SEGMENT_RING_HOLD to repeat it
+} Segment_Ring_Item_t;
+
+/** Ring state, free running indices wrap at 2^32 */
+typedef struct
+{
+    Segment_Ring_Item_t Items[SEGMENT_RING_SIZE]; // Segment storage
+    uint32_t Head;                                // Next index to write, written by the producer only
+    uint32_t Tail;                                // Next index to read, written by the consumer only
+} Segment_Ring_t;
+
+/**
+ * @brief Empty the ring, only while neither side is using it.
+ */
+SEGMENT_RING_INLINE void Segment_Ring_Reset(Segment_Ring_t *Ring)
+{
+    __atomic_store_n(&Ring->Head, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&Ring->Tail, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Number of segments waiting, exact for the consumer, a lower bound for the producer.
+ */
+SEGMENT_RING_INLINE uint32_t Segment_Ring_Count(const Segment_Ring_t *Ring)
+{
+    return __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE) - __atomic_load_n(&Ring->Tail, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Append a segment, producer side.
+ *
+ * @return false if the ring is full.
+ */
+SEGMENT_RING_INLINE bool Segment_Ring_Push(Segment_Ring_t *Ring, uint64_t Period_Q16, uint32_t Steps)
+{
+    uint32_t Head = Ring->Head; // Own index, no other writer
+
+    if ((Head - __atomic_load_n(&Ring->Tail, __ATOMIC_ACQUIRE)) >= SEGMENT_RING_SIZE)
+    {
+        return false;
+    }
+
+    Ring->Items[Head & (SEGMENT_RING_SIZE - 1)].Period_Q16 = Period_Q16;
+    Ring->Items[Head & (SEGMENT_RING_SIZE - 1)].Steps = Steps;
+
+    __atomic_store_n(&Ring->Head, Head + 1, __ATOMIC_RELEASE); // Item complete before it is visible
+
+    return true;
+}
+
+/**
+ * @brief Take the oldest segment, consumer side.
+ *
+ * @return false if the ring is empty.
+ */
+SEGMENT_RING_INLINE bool Segment_Ring_Pop(Segment_Ring_t *Ring, Segment_Ring_Item_t *Item)
+{
+    uint32_t Tail = Ring->Tail; // Own index, no other writer
+
+    if (__atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE) == Tail)
+    {
+        return false;
+    }
+
+    *Item = Ring->Items[Tail & (SEGMENT_RING_SIZE - 1)];
+
+    __atomic_store_n(&Ring->Tail, Tail + 1, __ATOMIC_RELEASE); // Slot read before the producer may reuse it
+
+    return true;
+}
+
+/**
+ * @brief Drop every waiting segment, consumer side.
+ */
+SEGMENT_RING_INLINE void Segment_Ring_Drain(Segment_Ring_t *Ring)
+{
+    __atomic_store_n(&Ring->Tail, __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+#endif // SEGMENT_RING_H
@@ -0,0 +1,164 @@
+/*H**********************************************************************
+ * FILENAME :        step_counter.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent step accounting for pulse counted moves.
+ *
+ * NOTES :
+ *       Called from the pulse counter interrupt, so nothing in here may
+ *       block or allocate.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <stddef.h>
+#include "step_counter.h"
+
+/**
+ * @brief Size of the next counting window from the current position.
+ */
+static uint32_t Next_Window(const Step_Counter_t *Counter)
+{
+    uint32_t Remaining = Counter->Segment_End - Counter->Counted_Steps;
+
+    return (Remaining > STEP_COUNTER_MAX_WINDOW) ? STEP_COUNTER_MAX_WINDOW : Remaining;
+}
+
+/**
+ * @brief Move to the segment that contains the current counted position.
+ *
+ * @return true if at least one segment boundary was crossed.
+ */
+static bool Advance_Segments(Step_Counter_t *Counter)
+{
+    bool Advanced = false;
+
+    while ((Counter->Counted_Steps >= Counter->Segment_End) && (Counter->Segment_End < Counter->Target_Steps))
+    {
+        if ((Counter->Segment_Index + 1) >= Counter->Profile->Segment_Count)
+        {
+            Counter->Segment_End = Counter->Target_Steps; // Held segment of a continuous profile, counted without end
+            break;
+        }
+
+        Counter->Segment_Index++;
+        Counter->Segment_End += Counter->Profile->Segments[Counter->Segment_Index].Steps;
+        Advanced = true;
+    }
+
+    return Advanced;
+}
+
+/**
+ * @brief Load a profile that starts at the current counted position.
+ *
+ * @return Size of the first counting window, 0 if there is nothing to count.
+ */
+static uint32_t Load_Profile(Step_Counter_t *Counter, const Motion_Profile_t *Profile)
+{
+    Counter->Profile = Profile;
+    Counter->Segment_Index = 0;
+    Counter->Segment_End = Counter->Counted_Steps + ((Profile->Segment_Count > 0) ? Profile->Segments[0].Steps : 0);
+    Counter->Target_Steps = (Profile->Continuous && (Profile->Segment_Count > 0)) ? STEP_COUNTER_ENDLESS : (Counter->Counted_Steps + Profile->Total_Steps);
+    Counter->Window_Steps = 0;
+
+    if (Counter->Target_Steps == Counter->Counted_Steps)
+    {
+        return 0;
+    }
+
+    Advance_Segments(Counter); // Skip leading segments without steps
+
+    Counter->Window_Steps = Next_Window(Counter);
+
+    return Counter->Window_Steps;
+}
+
+/**
+ * @brief Reset the counter for a new move.
+ *
+ * A continuous profile is counted without end: once its accel ramp is done
+ * the held cruise segment is counted until the move is retargeted or the
+ * counter is stopped.
+ *
+ * @param Counter Counter state.
+ * @param Profile Profile that is about to be executed.
+ * @return Size of the first counting window, 0 if there is nothing to count.
+ */
+uint32_t Step_Counter_Begin(Step_Counter_t *Counter, const Motion_Profile_t *Profile)
+{
+    Counter->Counted_Steps = 0;
+
+    return Load_Profile(Counter, Profile);
+}
+
+/**
+ * @brief Replace the rest of the running move by another profile.
+ *
+ * The new profile starts at the current position, the steps emitted so far
+ * stay counted. Used to stop a move early along a decel ramp, so the
+ * replacement is only taken if it ends before the running move would.
+ *
+ * @param Counter Counter state.
+ * @param Profile Profile that continues the move from here.
+ * @param Window_Count Hardware count inside the running window, the caller restarts the counter at 0.
+ * @param Window Returns the size of the next counting window, 0 if the move is done.
+ * @return true if the profile was taken, false if the running move ends first.
+ */
+bool Step_Counter_Retarget(Step_Counter_t *Counter, const Motion_Profile_t *Profile, uint32_t Window_Count, uint32_t *Window)
+{
+    uint32_t Position = Counter->Counted_Steps + Window_Count;
+
+    if ((Counter->Target_Steps - Position) <= Profile->Total_Steps)
+    {
+        return false; // Already stops within the replacement
+    }
+
+    Counter->Counted_Steps = Position;
+
+    *Window = Load_Profile(Counter, Profile);
+
+    return true;
+}
+
+/**
+ * @brief Account for a window whose limit has been reached.
+ *
+ * @param Counter Counter state.
+ * @param Early_Steps Steps already counted in the new window before it
+ *                    could be reprogrammed (interrupt latency).
+ * @return What happened; Window_Steps holds the next window to program
+ *         unless the move is done.
+ */
+Step_Counter_Event_t Step_Counter_Window_End(Step_Counter_t *Counter, uint32_t Early_Steps)
+{
+    Counter->Counted_Steps += Counter->Window_Steps + Early_Steps;
+
+    if (Counter->Counted_Steps >= Counter->Target_Steps)
+    {
+        Counter->Window_Steps = 0;
+
+        return STEP_COUNTER_MOVE_DONE;
+    }
+
+    bool Advanced = Advance_Segments(Counter);
+
+    Counter->Window_Steps = Next_Window(Counter);
+
+    return Advanced ? STEP_COUNTER_SEGMENT_DONE : STEP_COUNTER_CONTINUE;
+}
+
+/**
+ * @brief Total steps emitted so far.
+ *
+ * @param Counter Counter state.
+ * @param Window_Count Current hardware count inside the running window.
+ * @return Exact number of steps emitted since Step_Counter_Begin(), across retargets.
+ */
+uint32_t Step_Counter_Executed(const Step_Counter_t *Counter, uint32_t Window_Count)
+{
+    return Counter->Counted_Steps + Window_Count;
+}
@@ -0,0 +1,54 @@
+/*H**********************************************************************
+ * FILENAME :        step_counter.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent step accounting for pulse counted moves.
+ *
+ * NOTES :
+ *       The pulse counter hardware only counts up to a 16 bit limit, so a
+ *       move is split into counting windows that end on every segment
+ *       boundary and never exceed STEP_COUNTER_MAX_WINDOW. This module keeps
+ *       track of the windows; the peripheral glue only programs them.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef STEP_COUNTER_H
+#define STEP_COUNTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "motion_planner.h"
+
+#define STEP_COUNTER_MAX_WINDOW 32767   // Highest limit the 16 bit signed counter can reach
+#define STEP_COUNTER_ENDLESS UINT32_MAX // Target of a continuous profile, never reached
+#define STEP_COUNTER_RETARGET_MARGIN 2  // Steps before a window end in which the window is not retargeted
+
+/** Result of a finished counting window */
+typedef enum
+{
+    STEP_COUNTER_CONTINUE = 0, // Same segment, counting goes on
+    STEP_COUNTER_SEGMENT_DONE, // One or more segment boundaries were reached
+    STEP_COUNTER_MOVE_DONE,    // The last planned step was reached
+} Step_Counter_Event_t;
+
+/** Counting state of one move */
+typedef struct
+{
+    const Motion_Profile_t *Profile; // Profile being executed
+    uint16_t Segment_Index;          // Segment currently being emitted
+    uint32_t Segment_End;            // Absolute step count at the end of the current segment
+    uint32_t Target_Steps;           // Absolute step count at the end of the move
+    uint32_t Counted_Steps;          // Steps confirmed by finished windows
+    uint32_t Window_Steps;           // Steps programmed for the running window
+} Step_Counter_t;
+
+uint32_t Step_Counter_Begin(Step_Counter_t *Counter, const Motion_Profile_t *Profile);
+bool Step_Counter_Retarget(Step_Counter_t *Counter, const Motion_Profile_t *Profile, uint32_t Window_Count, uint32_t *Window);
+Step_Counter_Event_t Step_Counter_Window_End(Step_Counter_t *Counter, uint32_t Early_Steps);
+uint32_t Step_Counter_Executed(const Step_Counter_t *Counter, uint32_t Window_Count);
+
+#endif // STEP_COUNTER_H
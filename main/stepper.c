@@ -0,0 +1,1512 @@
+/*H**********************************************************************
+ * FILENAME :        stepper.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Handle based stepper motor driver: motor 0 of main.c and further
+ *       motors, the stations of a fixture, each with its own pins, LEDC
+ *       timer and channel, PCNT unit, limits, position and stop requests.
+ *
+ * NOTES :
+ *       All motors share one step engine: pulse_counter.c counts the steps
+ *       with the unit of the motor and Follow_Profile() sets the segment
+ *       frequencies on its timer. The motion trace, the resonance bands and
+ *       the encoder belong to motor 0, only its moves use them. All state
+ *       lives in a static array, only the queues and tasks of the stations
+ *       come from the RTOS heap, once at start-up.
+ *
+ *       A stop request only makes the deceleration steeper and an abort
+ *       stays set until they are cleared: main.c clears them for motor 0,
+ *       the task of a station when it takes the next command. A stop or
+ *       abort of a station also bumps its generation, so commands queued
+ *       before it are dropped and a move queued right after it runs.
+ *
+ *       The host simulator has no queues or tasks and only runs motor 0.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "stepper.h"
+#include "main.h"
+#include "pulse_counter.h"
+#include "freertos/queue.h"
+
+#define STEPPER_TRACE(Motor, Event, Argument) \
+    do                                        \
+    {                                         \
+        if ((Motor)->Number == 0)             \
+        {                                     \
+            MOTION_TRACE(Event, Argument);    \
+        }                                     \
+    } while (0) // The motion trace has no motor number, it follows motor 0
+
+/** One queued command of a motor */
+typedef struct
+{
+    bool Absolute;         // Target is a position, else a signed step count
+    int32_t Target;        // Signed steps or absolute position
+    uint32_t Frequency_Hz; // Cruise step frequency, capped at the limit of the motor
+    uint32_t Generation;   // Generation of the motor when queued
+} Stepper_Command_t;
+
+/** State of one motor */
+struct Stepper
+{
+    uint8_t Number;                    // Motor number, 0 for the motor of main.c, 1 for the first station
+    Stepper_Config_t Config;           // Configuration, Resources holds the allocation
+    QueueHandle_t Queue;               // Commands waiting for the motor task, NULL for motor 0
+    TaskHandle_t Task;                 // Task following the running move, accessed atomically
+    portMUX_TYPE Lock;                 // Guards the position, the step clock, the limits and the status
+    Pulse_Counter_t Counter;           // Step counting of the motor
+    int8_t Direction;                  // Sign of the steps for the direction pin, 1 forward, -1 backward
+    int8_t Counted_Direction;          // Sign of the steps being counted, 0 while none are
+    uint32_t Counted_Folded;           // Steps of the running count already added to Position
+    bool Holding;                      // The counter still counts the steps of a continuous run or jog
+    int32_t Position;                  // Absolute position in steps, without the running count
+    uint32_t Emitted_Steps;            // Steps emitted in both directions, without the running count, wraps
+    uint8_t Min_Bits;                  // Lowest duty resolution the duty of the running output needs
+    uint32_t Frequency_Hz;             // Step frequency applied last, 0 while stopped
+    Ledc_Range_t Step_Clock;           // LEDC timer setting of the step frequency applied last
+    uint32_t Resolution_Changes;       // Duty resolution switches of the LEDC timer
+    volatile bool Abort_Requested;     // Set by an abort, cleared before the next move
+    uint32_t Stop_Deceleration;        // Deceleration of a requested stop, 0 if none, accessed atomically
+    uint32_t Generation;               // Bumped by every stop or abort of a station, guarded by Lock
+    bool Busy;                         // A command is being executed, guarded by Lock
+    uint32_t Completed;                // Moves finished, guarded by Lock
+    uint32_t Last_Executed_Steps;      // Steps of the last finished move, guarded by Lock
+    esp_err_t Last_Error;              // Result of the last finished move, guarded by Lock
+    Motion_Profile_t Profile;          // Profile of the running move of a station
+    Motion_Profile_t Stop_Profiles[2]; // Decel ramps replacing the rest of a move, a steeper one can replace the first
+};
+
+static struct Stepper Motors[STEPPER_MAX_MOTORS + 1];           // Motor 0, then the station motors
+static uint8_t Motor_Count = 0;                                 // Station motors created
+static Stepper_Resources_t Resources;                           // LEDC and PCNT resources in use
+static bool Resources_Ready = false;                            // Motor 0 created and the encoder unit reserved
+static portMUX_TYPE Create_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards Resources and Motor_Count
+static const Motion_Profile_t Hold_Profile = {                  // Counts the steps of a jog started by Stepper_Start_Output()
+    .Segment_Count = 1,                                         // Single held segment
+    .Cruise_Segments = 1,                                       // Counted without end
+    .Continuous = true,                                         // Held until stopped
+};
+
+/**
+ * @brief Stop the step output of a motor right away, idle level low.
+ *
+ * Safe to call from interrupts. The counter keeps the exact count. Does
+ * nothing if another pulse engine drives the step pin.
+ */
+void Stepper_Stop_Output(stepper_t Motor)
+{
+    if (Motor->Config.Step_Output)
+    {
+        ledc_stop((ledc_mode_t)Motor->Config.Resources.Speed_Mode, (ledc_channel_t)Motor->Config.Resources.Channel, 0);
+    }
+}
+
+/**
+ * @brief Give the step pad back to the LEDC channel of a motor, e.g. after a multi-axis move.
+ */
+void Stepper_Route_Output(stepper_t Motor)
+{
+    if (Motor->Config.Step_Output)
+    {
+        Pulse_Counter_Route_Output(&Motor->Counter);
+    }
+}
+
+/**
+ * @brief Duty register of the step output for a move up to a peak frequency.
+ *
+ * Called while the output is stopped, before the first frequency of the
+ * move is set. The duty is scaled at the resolution of the peak frequency
+ * and every later frequency keeps at least the resolution it needs, so the
+ * register is not written again while the output runs.
+ *
+ * @param Motor Motor about to move.
+ * @param Peak_Frequency_Hz Highest frequency of the move.
+ * @param Duty Duty of the step pulses, PWM_DUTY_CYCLE_50 is half.
+ * @return Value for Stepper_Start_Output().
+ */
+uint32_t Stepper_Prepare_Duty(stepper_t Motor, uint32_t Peak_Frequency_Hz, uint32_t Duty)
+{
+    Ledc_Range_t Peak;
+    uint32_t Duty_Register = 0;
+
+    Peak_Frequency_Hz = (Peak_Frequency_Hz > LEDC_RANGE_MAX_FREQUENCY_HZ) ? LEDC_RANGE_MAX_FREQUENCY_HZ : Peak_Frequency_Hz; // Faster segments fail once they are set
+
+    if (Ledc_Range_Select(Peak_Frequency_Hz, LEDC_RANGE_MIN_BITS, &Peak))
+    {
+        Duty_Register = Ledc_Range_Duty(&Peak, Duty);
+    }
+
+    Motor->Min_Bits = Ledc_Range_Duty_Bits(Duty_Register);
+
+    return Duty_Register;
+}
+
+/**
+ * @brief Apply a step frequency to the LEDC timer of a motor.
+ *
+ * The range manager picks the clock, divider and duty resolution, at least
+ * the resolution the duty of the running output needs. The timer takes
+ * them together at its next overflow, a switch of the resolution neither
+ * cuts a period nor drops a pulse, see ledc_range.h.
+ *
+ * @param Motor Motor to set.
+ * @param Frequency_Hz Step frequency.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG if no timer setting reaches the frequency, or the error of ledc_timer_set().
+ */
+esp_err_t Stepper_Set_Frequency(stepper_t Motor, uint32_t Frequency_Hz)
+{
+    Ledc_Range_t Range;
+
+    if (!Ledc_Range_Select(Frequency_Hz, Motor->Min_Bits, &Range))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t Function_Error = ledc_timer_set((ledc_mode_t)Motor->Config.Resources.Speed_Mode, (ledc_timer_t)Motor->Config.Resources.Timer, Range.Divider, Range.Resolution_Bits,
+                                              (Range.Clock == LEDC_RANGE_REF_TICK) ? LEDC_REF_TICK : LEDC_APB_CLK);
+
+    if (Function_Error == ESP_OK)
+    {
+        portENTER_CRITICAL(&Motor->Lock);
+
+        if ((Motor->Step_Clock.Resolution_Bits != 0) && (Motor->Step_Clock.Resolution_Bits != Range.Resolution_Bits))
+        {
+            Motor->Resolution_Changes++;
+        }
+
+        Motor->Step_Clock = Range;
+        Motor->Frequency_Hz = Frequency_Hz;
+
+        portEXIT_CRITICAL(&Motor->Lock);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Timer setting of the step frequency applied last, with the achieved frequency and its error.
+ *
+ * @param Motor Motor to read.
+ * @param Range Returns the setting, Requested_Hz is 0 before the first frequency.
+ * @param Resolution_Changes Returns the duty resolution switches since the motor was created.
+ */
+void Stepper_Get_Step_Clock(stepper_t Motor, Ledc_Range_t *Range, uint32_t *Resolution_Changes)
+{
+    portENTER_CRITICAL(&Motor->Lock);
+    *Range = Motor->Step_Clock;
+    *Resolution_Changes = Motor->Resolution_Changes;
+    portEXIT_CRITICAL(&Motor->Lock);
+}
+
+/**
+ * @brief Start counting the steps of a profile into the position, before the output starts.
+ */
+static esp_err_t Begin_Count(struct Stepper *Motor, const Motion_Profile_t *Profile)
+{
+    TaskHandle_t Task = xTaskGetCurrentTaskHandle();
+
+    __atomic_store_n(&Motor->Task, Task, __ATOMIC_RELEASE);
+
+    esp_err_t Function_Error = Pulse_Counter_Start(&Motor->Counter, Profile, Task);
+
+    portENTER_CRITICAL_SAFE(&Motor->Lock);
+    Motor->Counted_Direction = Motor->Direction;
+    Motor->Counted_Folded = 0;
+    portEXIT_CRITICAL_SAFE(&Motor->Lock);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Stop counting, add the exact count to the position and return it.
+ *
+ * The output has to be stopped before.
+ */
+static uint32_t End_Count(struct Stepper *Motor)
+{
+    uint32_t Steps = Pulse_Counter_Stop(&Motor->Counter);
+
+    portENTER_CRITICAL_SAFE(&Motor->Lock);
+    Motor->Position += Motor->Counted_Direction * (int32_t)(Steps - Motor->Counted_Folded);
+    Motor->Emitted_Steps += Steps - Motor->Counted_Folded;
+    Motor->Counted_Direction = 0;
+    Motor->Counted_Folded = 0;
+    Motor->Frequency_Hz = 0;
+    portEXIT_CRITICAL_SAFE(&Motor->Lock);
+
+    return Steps;
+}
+
+/**
+ * @brief Counted steps of a motor not in its position yet, called with its lock held.
+ */
+static int32_t Pending_Steps(struct Stepper *Motor)
+{
+    if (Motor->Counted_Direction == 0)
+    {
+        return 0;
+    }
+
+    return Motor->Counted_Direction * (int32_t)(Pulse_Counter_Get_Steps(&Motor->Counter) - Motor->Counted_Folded);
+}
+
+/**
+ * @brief Set the direction pin, the steps counted so far keep their direction.
+ *
+ * Only called while the output is stopped; a continuous run that reverses
+ * goes on counting in the new direction.
+ *
+ * @param Motor Motor to set.
+ * @param Forward Direction of the next steps.
+ * @return Result of gpio_set_level().
+ */
+esp_err_t Stepper_Set_Direction(stepper_t Motor, bool Forward)
+{
+    int8_t Direction = Forward ? 1 : -1;
+
+    portENTER_CRITICAL_SAFE(&Motor->Lock);
+
+    if (Motor->Counted_Direction != 0)
+    {
+        uint32_t Steps = Pulse_Counter_Get_Steps(&Motor->Counter);
+
+        Motor->Position += Motor->Counted_Direction * (int32_t)(Steps - Motor->Counted_Folded);
+        Motor->Emitted_Steps += Steps - Motor->Counted_Folded;
+        Motor->Counted_Folded = Steps;
+        Motor->Counted_Direction = Direction;
+    }
+
+    Motor->Direction = Direction;
+
+    portEXIT_CRITICAL_SAFE(&Motor->Lock);
+
+    return gpio_set_level(Motor->Config.Dir_Pin, Forward ? SET_GPIO_LEVEL_HIGH : SET_GPIO_LEVEL_LOW);
+}
+
+/**
+ * @brief Sign of the steps for the direction pin, 1 forward, -1 backward.
+ */
+int8_t Stepper_Get_Direction(stepper_t Motor)
+{
+    portENTER_CRITICAL_SAFE(&Motor->Lock);
+    int8_t Direction = Motor->Direction;
+    portEXIT_CRITICAL_SAFE(&Motor->Lock);
+
+    return Direction;
+}
+
+/**
+ * @brief Add steps that another pulse engine emitted to the position.
+ *
+ * @param Motor Motor that moved.
+ * @param Steps Signed steps, positive forward.
+ */
+void Stepper_Add_Steps(stepper_t Motor, int32_t Steps)
+{
+    portENTER_CRITICAL_SAFE(&Motor->Lock);
+    Motor->Position += Steps;
+    Motor->Emitted_Steps += (Steps < 0) ? (uint32_t)(-(int64_t)Steps) : (uint32_t)Steps;
+    portEXIT_CRITICAL_SAFE(&Motor->Lock);
+}
+
+/**
+ * @brief Absolute position of a motor, with the steps of the running move as the counter sees them.
+ *
+ * Safe to call from any task and from interrupts.
+ *
+ * @return Position in steps, positive forward.
+ */
+int32_t Stepper_Get_Position(stepper_t Motor)
+{
+    portENTER_CRITICAL_SAFE(&Motor->Lock);
+    int32_t Position = Motor->Position + Pending_Steps(Motor);
+    portEXIT_CRITICAL_SAFE(&Motor->Lock);
+
+    return Position;
+}
+
+/**
+ * @brief Steps a motor emitted in both directions, with those of the running move.
+ *
+ * Setting the position does not change the count. The count wraps at 2^32.
+ */
+uint32_t Stepper_Get_Emitted_Steps(stepper_t Motor)
+{
+    portENTER_CRITICAL_SAFE(&Motor->Lock);
+
+    uint32_t Steps = Motor->Emitted_Steps;
+
+    if (Motor->Counted_Direction != 0)
+    {
+        Steps += Pulse_Counter_Get_Steps(&Motor->Counter) - Motor->Counted_Folded;
+    }
+
+    portEXIT_CRITICAL_SAFE(&Motor->Lock);
+
+    return Steps;
+}
+
+/**
+ * @brief Give the current position of a motor a new value.
+ *
+ * Safe to call from interrupts. Also allowed while the motor moves, the
+ * steps still to come are added to the new value.
+ */
+void Stepper_Set_Position(stepper_t Motor, int32_t Position)
+{
+    portENTER_CRITICAL_SAFE(&Motor->Lock);
+    Motor->Position = Position - Pending_Steps(Motor);
+    portEXIT_CRITICAL_SAFE(&Motor->Lock);
+}
+
+/**
+ * @brief Wake up the task following the move of a motor, from a task or an interrupt.
+ */
+static void Notify_Motor_Task(struct Stepper *Motor, uint32_t Notification)
+{
+    TaskHandle_t Task = __atomic_load_n(&Motor->Task, __ATOMIC_ACQUIRE);
+
+    if (Task == NULL)
+    {
+        return; // No move ran yet
+    }
+
+    if (xPortInIsrContext())
+    {
+        BaseType_t Higher_Priority_Task_Woken = pdFALSE;
+
+        xTaskNotifyFromISR(Task, Notification, eSetBits, &Higher_Priority_Task_Woken);
+
+        if (Higher_Priority_Task_Woken == pdTRUE)
+        {
+            portYIELD_FROM_ISR();
+        }
+    }
+    else
+    {
+        xTaskNotify(Task, Notification, eSetBits);
+    }
+}
+
+/**
+ * @brief Store a stop request unless a steeper or equal one is pending.
+ *
+ * @return true if the request was taken.
+ */
+static bool Raise_Stop(struct Stepper *Motor, uint32_t Deceleration)
+{
+    uint32_t Current = __atomic_load_n(&Motor->Stop_Deceleration, __ATOMIC_RELAXED);
+
+    while ((Deceleration > Current) && !__atomic_compare_exchange_n(&Motor->Stop_Deceleration, &Current, Deceleration, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    {
+        // Current was reloaded, retry unless another request was steeper
+    }
+
+    return Deceleration > Current;
+}
+
+/**
+ * @brief Request the running move of a motor to stop along a decel ramp.
+ *
+ * Safe to call from any task and from interrupts. A counted move switches
+ * to a decel ramp from its current frequency and still stops exact to the
+ * step. The request stays set until Stepper_Clear_Stop(); a second request
+ * can only make the deceleration steeper.
+ *
+ * @param Motor Motor to stop.
+ * @param Deceleration Deceleration in steps/s^2, 0 is ignored.
+ * @return true if the request was taken, false if a steeper or equal stop is already on its way.
+ */
+bool Stepper_Request_Stop(stepper_t Motor, uint32_t Deceleration)
+{
+    if (!Raise_Stop(Motor, Deceleration))
+    {
+        return false;
+    }
+
+    Notify_Motor_Task(Motor, MOTION_NOTIFY_STOP);
+
+    return true;
+}
+
+/**
+ * @brief Deceleration of the pending stop request of a motor, 0 if there is none.
+ */
+uint32_t Stepper_Stop_Requested(stepper_t Motor)
+{
+    return __atomic_load_n(&Motor->Stop_Deceleration, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Stop request of a motor for a pulse engine that follows the move itself.
+ *
+ * @return Deceleration in steps/s^2, 0 if there is none, to be read atomically.
+ */
+const uint32_t *Stepper_Stop_Deceleration(stepper_t Motor)
+{
+    return &Motor->Stop_Deceleration;
+}
+
+/**
+ * @brief Clear the stop request of a motor once it stands still.
+ */
+void Stepper_Clear_Stop(stepper_t Motor)
+{
+    __atomic_store_n(&Motor->Stop_Deceleration, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Stop the output of a motor right away and end its running move.
+ *
+ * Safe to call from any task and from interrupts. The steps emitted so far
+ * stay counted into the position. The request stays set until
+ * Stepper_Clear_Abort(), so a move that is about to start is aborted as well.
+ */
+void Stepper_Request_Abort(stepper_t Motor)
+{
+    Motor->Abort_Requested = true;
+
+    Stepper_Stop_Output(Motor);
+
+    Notify_Motor_Task(Motor, MOTION_NOTIFY_ABORT);
+}
+
+/**
+ * @brief Abort request of a motor, for the pulse engines that poll it.
+ */
+const volatile bool *Stepper_Abort_Flag(stepper_t Motor)
+{
+    return &Motor->Abort_Requested;
+}
+
+/**
+ * @brief Clear the abort request of a motor so the next move can run.
+ */
+void Stepper_Clear_Abort(stepper_t Motor)
+{
+    Motor->Abort_Requested = false;
+}
+
+/**
+ * @brief Highest segment frequency of a profile, also of those the planner did not build.
+ */
+static uint32_t Get_Profile_Peak_Frequency(const Motion_Profile_t *Profile)
+{
+    uint32_t Peak_Frequency_Hz = 0;
+
+    for (uint16_t Segment = 0; Segment < Profile->Segment_Count; Segment++)
+    {
+        if (Profile->Segments[Segment].Frequency_Hz > Peak_Frequency_Hz)
+        {
+            Peak_Frequency_Hz = Profile->Segments[Segment].Frequency_Hz;
+        }
+    }
+
+    return Peak_Frequency_Hz;
+}
+
+/**
+ * @brief Replace the rest of the counted move by a decel ramp to standstill.
+ *
+ * @param Motor Motor running the move.
+ * @param Frequency_Hz Frequency the motor currently runs at.
+ * @param Stop_Profile Output decel ramp, not the profile being counted.
+ * @return Result of Pulse_Counter_Retarget(), or the error of the LEDC call.
+ */
+static esp_err_t Begin_Stop(struct Stepper *Motor, uint32_t Frequency_Hz, Motion_Profile_t *Stop_Profile)
+{
+    if (!Motion_Planner_Plan_Stop(Frequency_Hz, Stepper_Stop_Requested(Motor), MOTION_SEGMENT_TIME_US, Stop_Profile))
+    {
+        return ESP_ERR_INVALID_ARG; // Request already cleared
+    }
+
+    if (Motor->Number == 0)
+    {
+        Motor_Resonance_Apply(Stop_Profile); // Cross the bands on the way down
+    }
+
+    esp_err_t Function_Error = Pulse_Counter_Retarget(&Motor->Counter, Stop_Profile, xTaskGetCurrentTaskHandle());
+
+    if ((Function_Error == ESP_OK) && (Stop_Profile->Segment_Count > 0))
+    {
+        Function_Error = Stepper_Set_Frequency(Motor, Stop_Profile->Segments[0].Frequency_Hz); // First decel frequency, below the running one
+
+        STEPPER_TRACE(Motor, MOTION_TRACE_FREQUENCY, Stop_Profile->Segments[0].Frequency_Hz);
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Apply the segment frequencies of a counted profile until it ends.
+ *
+ * On a stop request the rest of the profile is replaced by a decel ramp
+ * from the current segment frequency, unless the profile stops sooner by
+ * itself; a steeper request later replaces that ramp the same way. Returns
+ * at the last counted step, on an abort, or for a continuous profile once
+ * its held segment is reached. With an encoder on motor 0 the position is
+ * checked every MOTOR_ENCODER_CHECK_TICKS and on every counter event, a
+ * fault stops the output.
+ *
+ * @param Motor Motor running the profile.
+ * @param Profile Profile the pulse counter was started with.
+ * @param Holding Returns true if the output keeps running at the held frequency.
+ * @return ESP_OK if successful, ESP_ERR_TIMEOUT if the pulses were not counted
+ *         in time, ESP_ERR_INVALID_RESPONSE if the encoder found a following
+ *         error or a stall, or the error of the failing LEDC call.
+ */
+static esp_err_t Follow_Profile(struct Stepper *Motor, const Motion_Profile_t *Profile, bool *Holding)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    bool Encoder = (Motor->Number == 0);                                                          // The encoder is mounted on motor 0
+    uint32_t Notification = 0;                                                                    // Event bits set by the pulse counter
+    uint16_t Segment_Index = 0;                                                                   // Segment whose frequency is applied
+    TickType_t Timeout = pdMS_TO_TICKS((Profile->Duration_us / 1000) + MOTION_TIMEOUT_MARGIN_MS); // Longest wait for a counter event
+    TickType_t Retry_Ticks = 0;                                                                   // Ticks spent retrying a stop near a window end
+    TickType_t Waited = 0;                                                                        // Ticks waited since the last counter event
+    bool Stop_Pending = (Stepper_Stop_Requested(Motor) != 0);                                     // Stop requested, decel ramp not taken yet
+
+    *Holding = false;
+
+    while (Function_Error == ESP_OK)
+    {
+        if (Pulse_Counter_Get_Segment(&Motor->Counter) != Segment_Index)
+        {
+            Segment_Index = Pulse_Counter_Get_Segment(&Motor->Counter);
+
+            Function_Error = Stepper_Set_Frequency(Motor, Profile->Segments[Segment_Index].Frequency_Hz); // Set the PWM frequency
+
+            if (Function_Error != ESP_OK) // Check for errors while setting the frequency
+            {
+                printf("Error setting frequency: %" PRIu32 "HZ\n", Profile->Segments[Segment_Index].Frequency_Hz);
+
+                Stepper_Stop_Output(Motor);
+
+                break;
+            }
+
+            STEPPER_TRACE(Motor, MOTION_TRACE_FREQUENCY, Profile->Segments[Segment_Index].Frequency_Hz);
+        }
+
+        if (Stop_Pending)
+        {
+            Motion_Profile_t *Stop_Profile = (Profile == &Motor->Stop_Profiles[0]) ? &Motor->Stop_Profiles[1] : &Motor->Stop_Profiles[0]; // Not the one being counted
+
+            esp_err_t Stop_Error = Begin_Stop(Motor, Profile->Segments[Segment_Index].Frequency_Hz, Stop_Profile);
+
+            Stop_Pending = (Stop_Error == ESP_ERR_TIMEOUT) && (Retry_Ticks++ < Timeout); // Window about to end, retry after it
+
+            if (Stop_Error == ESP_OK)
+            {
+                Profile = Stop_Profile;
+                Segment_Index = 0;
+                Timeout = pdMS_TO_TICKS((Profile->Duration_us / 1000) + MOTION_TIMEOUT_MARGIN_MS);
+                Waited = 0;
+            }
+            else if ((Stop_Error != ESP_ERR_TIMEOUT) && (Stop_Error != ESP_ERR_INVALID_STATE) && (Stop_Error != ESP_ERR_INVALID_ARG))
+            {
+                Function_Error = Stop_Error; // Decel frequency could not be set
+                Stepper_Stop_Output(Motor);
+                break;
+            }
+        }
+
+        if (Profile->Continuous && ((Segment_Index + 1) >= Profile->Segment_Count))
+        {
+            *Holding = true; // Ramp done, the counter goes on counting the held frequency
+
+            break;
+        }
+
+        if (Profile->Total_Steps == 0)
+        {
+            break; // Nothing counted, nothing to wait for
+        }
+
+        TickType_t Wait = Stop_Pending ? 1 : (Timeout - Waited);
+
+        if (Encoder && Motor_Encoder_Active() && (Wait > MOTOR_ENCODER_CHECK_TICKS))
+        {
+            Wait = MOTOR_ENCODER_CHECK_TICKS; // Wake up for the next encoder check
+        }
+
+        BaseType_t Notified = xTaskNotifyWait(0, ULONG_MAX, &Notification, Wait);
+
+        if (Encoder && (Motor_Encoder_Check() != ESP_OK))
+        {
+            Stepper_Stop_Output(Motor); // Motor lost steps, stop the output
+
+            Function_Error = ESP_ERR_INVALID_RESPONSE;
+
+            break;
+        }
+
+        if (Notified != pdTRUE)
+        {
+            Waited += Stop_Pending ? 0 : Wait;
+
+            if (Stop_Pending || (Waited < Timeout))
+            {
+                continue;
+            }
+
+            Stepper_Stop_Output(Motor); // Counter did not see the pulses, stop the output
+
+            Function_Error = ESP_ERR_TIMEOUT;
+
+            break;
+        }
+
+        Waited = 0;
+
+        if (Notification & MOTION_NOTIFY_ABORT)
+        {
+            Stepper_Stop_Output(Motor); // Also if the output started after the abort stopped it
+
+            break;
+        }
+
+        if (Notification & PULSE_COUNTER_NOTIFY_DONE)
+        {
+            break; // Last counted step reached
+        }
+
+        if (Notification & MOTION_NOTIFY_STOP)
+        {
+            Stop_Pending = (Stepper_Stop_Requested(Motor) != 0); // Only taken if it stops sooner than a running decel
+        }
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Execute a planned profile on the LEDC output of a motor, in the calling task.
+ *
+ * The step pulses are counted by the PCNT unit of the motor. Its interrupt
+ * stops the output on the last step of the move and signals every segment
+ * boundary, on which the next segment frequency is applied to the LEDC
+ * timer. The wait also ends on Stepper_Request_Abort(), a stop request
+ * decelerates the move to standstill instead. For a continuous profile the
+ * held cruise frequency is applied after the ramp and the function returns
+ * with the motor still running. The steps of a continuous profile stay
+ * counted, also if a stop request ended its ramp early, until
+ * Stepper_End_Hold() takes the count.
+ *
+ * @param Motor Motor to move, its direction set before.
+ * @param Profile The profile to execute.
+ * @param Duty Duty of the step pulses, PWM_DUTY_CYCLE_50 is half.
+ * @param Executed_Steps Returns the number of steps actually emitted, may be NULL.
+ * @param Holding Returns true if the output keeps running at the held frequency.
+ * @return ESP_OK if successful, ESP_ERR_TIMEOUT if the pulses were not counted
+ *         in time, or the error of Follow_Profile() or of the failing LEDC call.
+ */
+esp_err_t Stepper_Run_Profile(stepper_t Motor, const Motion_Profile_t *Profile, uint32_t Duty, uint32_t *Executed_Steps, bool *Holding)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    *Holding = false;
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = 0;
+    }
+
+    if (Profile->Segment_Count == 0)
+    {
+        return ESP_OK; // Nothing to move
+    }
+
+    uint32_t Peak_Frequency_Hz = Get_Profile_Peak_Frequency(Profile);
+
+    if (Profile->Continuous && (Peak_Frequency_Hz < MOTION_JOG_MAX_FREQUENCY_HZ))
+    {
+        Peak_Frequency_Hz = MOTION_JOG_MAX_FREQUENCY_HZ; // A held run may be jogged faster later
+    }
+
+    uint32_t Duty_Register = Stepper_Prepare_Duty(Motor, Peak_Frequency_Hz, Duty); // Fits every frequency of the move
+
+    Function_Error = Stepper_Set_Frequency(Motor, Profile->Segments[0].Frequency_Hz); // Set the first PWM frequency
+
+    if (Function_Error != ESP_OK) // Check for errors while setting the frequency
+    {
+        printf("Error setting frequency: %" PRIu32 "HZ\n", Profile->Segments[0].Frequency_Hz);
+
+        return Function_Error;
+    }
+
+    STEPPER_TRACE(Motor, MOTION_TRACE_FREQUENCY, Profile->Segments[0].Frequency_Hz);
+
+    xTaskNotifyWait(0, ULONG_MAX, NULL, 0); // Drop events left over from an earlier move
+
+    if (Motor->Abort_Requested)
+    {
+        return ESP_OK; // Aborted before the first step
+    }
+
+    Motor->Holding = false; // Restarting the counter ends the count of an earlier run
+
+    Function_Error += Begin_Count(Motor, Profile);
+    Function_Error += ledc_set_duty_and_update((ledc_mode_t)Motor->Config.Resources.Speed_Mode, (ledc_channel_t)Motor->Config.Resources.Channel, Duty_Register, 0); // Start emitting the steps
+
+    STEPPER_TRACE(Motor, MOTION_TRACE_PULSE_START, Profile->Segments[0].Frequency_Hz);
+
+    if (Function_Error == ESP_OK)
+    {
+        Function_Error = Follow_Profile(Motor, Profile, Holding);
+    }
+    else
+    {
+        Stepper_Stop_Output(Motor);
+    }
+
+    uint32_t Steps = 0;
+
+    if (Profile->Continuous && (Function_Error == ESP_OK) && !Motor->Abort_Requested)
+    {
+        Steps = Pulse_Counter_Get_Steps(&Motor->Counter); // Steps of the ramp, counting goes on
+        Motor->Holding = true;
+    }
+    else
+    {
+        Steps = End_Count(Motor); // Exact number of steps emitted
+    }
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Steps;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Start or resume the step output of a jog at the frequency set last.
+ *
+ * The steps are counted from the first start on, also across pauses and
+ * direction changes, until Stepper_End_Hold().
+ *
+ * @param Motor Motor to run.
+ * @param Duty_Register Result of Stepper_Prepare_Duty() for the fastest jog frequency.
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t Stepper_Start_Output(stepper_t Motor, uint32_t Duty_Register)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    if (!Motor->Holding)
+    {
+        Function_Error += Begin_Count(Motor, &Hold_Profile);
+
+        Motor->Holding = true;
+    }
+
+    Function_Error += ledc_set_duty_and_update((ledc_mode_t)Motor->Config.Resources.Speed_Mode, (ledc_channel_t)Motor->Config.Resources.Channel, Duty_Register, 0); // Start emitting the steps
+
+    return Function_Error;
+}
+
+/**
+ * @brief Hold the step output of a motor low at the end of the running period, the count goes on.
+ */
+esp_err_t Stepper_Pause_Output(stepper_t Motor)
+{
+    return ledc_set_duty_and_update((ledc_mode_t)Motor->Config.Resources.Speed_Mode, (ledc_channel_t)Motor->Config.Resources.Channel, PWM_DUTY_CYCLE_00, 0); // Output stays low
+}
+
+/**
+ * @brief Whether the counter of a motor still counts a continuous run or jog.
+ */
+bool Stepper_Holding(stepper_t Motor)
+{
+    return Motor->Holding;
+}
+
+/**
+ * @brief Take the count of a continuous run or jog once the output stands still.
+ *
+ * @param Motor Motor that ran.
+ * @param Executed_Steps Returns the steps emitted since the run started, may be NULL.
+ * @return false if no run was being counted, nothing is returned then.
+ */
+bool Stepper_End_Hold(stepper_t Motor, uint32_t *Executed_Steps)
+{
+    if (!Motor->Holding)
+    {
+        return false;
+    }
+
+    uint32_t Steps = End_Count(Motor);
+
+    Motor->Holding = false;
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Steps;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Configure the pins, LEDC timer and channel and PCNT unit of a motor.
+ *
+ * The step pad is routed back to the LEDC channel after the PCNT took it
+ * as input. Without Step_Output only the direction and enable pins are set
+ * up, the pulse engine of main.c sets up the step pin.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+static esp_err_t Configure_Motor(struct Stepper *Motor)
+{
+    esp_err_t Function_Error = ESP_OK;
+    const Stepper_Resource_t *Allocation = &Motor->Config.Resources;
+    Ledc_Range_t Start_Range = {0}; // Clock and resolution of the start frequency
+
+    gpio_config_t io_conf = {}; // Zero-initialize the config structure
+    uint64_t Pin_Mask = 1ULL << Motor->Config.Dir_Pin;
+
+    if (Motor->Config.Enable_Pin != GPIO_NUM_NC)
+    {
+        Pin_Mask |= 1ULL << Motor->Config.Enable_Pin;
+    }
+
+    io_conf.intr_type = GPIO_PIN_INTR_DISABLE;  // Disable interrupt for the GPIO pins
+    io_conf.mode = GPIO_MODE_OUTPUT;            // Set the GPIO pins to output mode
+    io_conf.pin_bit_mask = Pin_Mask;            // Direction and enable pins
+    io_conf.pull_down_en = GPIO_PULLUP_DISABLE; // Disable pull-down mode for the GPIO pins
+    io_conf.pull_up_en = GPIO_PULLDOWN_DISABLE; // Disable pull-up mode for the GPIO pins
+
+    Function_Error += gpio_config(&io_conf);
+
+    if (Motor->Config.Enable_Pin != GPIO_NUM_NC)
+    {
+        Function_Error += gpio_set_level(Motor->Config.Enable_Pin, SET_GPIO_LEVEL_HIGH); // Driver disabled until the first move
+    }
+
+    Function_Error += gpio_set_level(Motor->Config.Dir_Pin, SET_GPIO_LEVEL_HIGH);
+
+    if (!Motor->Config.Step_Output)
+    {
+        return Function_Error;
+    }
+
+    Ledc_Range_Select(PWM_FREQUENCY_1KHZ, LEDC_RANGE_MIN_BITS, &Start_Range);
+
+    ledc_timer_config_t Step_Timer = {}; // Zero-initialize the config structure
+
+    Step_Timer.speed_mode = (ledc_mode_t)Allocation->Speed_Mode;                                            // Speed mode of the motor
+    Step_Timer.duty_resolution = (ledc_timer_bit_t)Start_Range.Resolution_Bits;                             // Resolution of the start frequency, switched with the step rate
+    Step_Timer.timer_num = (ledc_timer_t)Allocation->Timer;                                                 // Timer of the motor
+    Step_Timer.freq_hz = PWM_FREQUENCY_1KHZ;                                                                // Start at 1 kHz
+    Step_Timer.clk_cfg = (Start_Range.Clock == LEDC_RANGE_REF_TICK) ? LEDC_USE_REF_TICK : LEDC_USE_APB_CLK; // Clock of the range manager, not the automatic choice
+
+    Function_Error += ledc_timer_config(&Step_Timer);
+
+    Motor->Min_Bits = LEDC_RANGE_MIN_BITS;
+
+    Function_Error += Stepper_Set_Frequency(Motor, PWM_FREQUENCY_1KHZ); // Rounded divider of the range manager
+    Motor->Frequency_Hz = 0;
+
+    ledc_channel_config_t Step_Channel = {}; // Zero-initialize the config structure
+
+    Step_Channel.gpio_num = Motor->Config.Step_Pin;                // Step pulse pin of the motor
+    Step_Channel.speed_mode = (ledc_mode_t)Allocation->Speed_Mode; // Speed mode of the motor
+    Step_Channel.channel = (ledc_channel_t)Allocation->Channel;    // Channel of the motor
+    Step_Channel.timer_sel = (ledc_timer_t)Allocation->Timer;      // Timer of the motor
+    Step_Channel.duty = 0;                                         // Output stays low
+    Step_Channel.hpoint = 0;                                       // Set the high point to 0
+
+    Function_Error += ledc_channel_config(&Step_Channel);
+
+    Function_Error += Initialize_Pulse_Counter(&Motor->Counter, Motor->Config.Step_Pin, Allocation, Motor->Number == 0);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Set up the state of a motor in its slot and configure its hardware.
+ */
+static esp_err_t Setup_Motor(struct Stepper *Motor, uint8_t Number, const Stepper_Config_t *Config, const Stepper_Resource_t *Allocation)
+{
+    memset(Motor, 0, sizeof(*Motor));
+
+    Motor->Number = Number;
+    Motor->Config = *Config;
+    Motor->Config.Resources = *Allocation;
+    Motor->Lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    Motor->Direction = 1;
+
+    return Configure_Motor(Motor);
+}
+
+/**
+ * @brief Whether a pin can drive an output, GPIO_NUM_NC cannot.
+ */
+static bool Valid_Output_Pin(gpio_num_t Pin)
+{
+    return (Pin >= 0) && GPIO_IS_VALID_OUTPUT_GPIO(Pin);
+}
+
+/**
+ * @brief Whether the pins, limits and duty of a motor configuration are usable.
+ */
+static bool Valid_Config(const Stepper_Config_t *Config)
+{
+    return Valid_Output_Pin(Config->Step_Pin) && Valid_Output_Pin(Config->Dir_Pin) && ((Config->Enable_Pin == GPIO_NUM_NC) || Valid_Output_Pin(Config->Enable_Pin)) &&
+           (Config->Max_Frequency_Hz >= MOTION_JOG_MIN_FREQUENCY_HZ) && (Config->Max_Frequency_Hz <= STEPPER_MAX_FREQUENCY_HZ) && (Config->Acceleration != 0) && (Config->Duty != 0) &&
+           (Config->Duty < (1UL << LEDC_RANGE_DUTY_BITS));
+}
+
+/**
+ * @brief Create motor 0, reserve the encoder unit and install the shared services.
+ *
+ * Must be called once at start-up, before Initialize_Motor_Encoder() and
+ * the first Stepper_Create().
+ *
+ * @param Config Pins, wanted resources and limits of motor 0.
+ * @param Motor Returns the handle of motor 0.
+ * @return
+ *     - ESP_OK: Motor 0 created
+ *     - ESP_ERR_INVALID_ARG: Pin, limit or duty invalid
+ *     - ESP_ERR_INVALID_STATE: The wanted resources or the encoder unit are not free
+ *     - Sum of the ESP return values of the hardware configuration otherwise
+ */
+esp_err_t Initialize_Steppers(const Stepper_Config_t *Config, stepper_t *Motor)
+{
+    esp_err_t Function_Error = ESP_OK;
+    Stepper_Resource_t Allocation;
+
+    if (!Valid_Config(Config))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&Create_Lock);
+
+    Stepper_Resources_Init(&Resources);
+    Motor_Count = 0;
+
+    bool Reserved = Stepper_Resources_Allocate(&Resources, &Config->Resources, &Allocation);
+#if STEPPER_MOTOR_ENCODER
+    Reserved = Reserved && Stepper_Resources_Reserve_Unit(&Resources, MOTOR_ENCODER_PCNT_UNIT);
+#endif
+
+    portEXIT_CRITICAL(&Create_Lock);
+
+    if (!Reserved)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t Service_Error = pcnt_isr_service_install(0);
+
+    if (Service_Error != ESP_ERR_INVALID_STATE) // Already installed otherwise
+    {
+        Function_Error += Service_Error;
+    }
+
+    Service_Error = ledc_fade_func_install(0);
+
+    if (Service_Error != ESP_ERR_INVALID_STATE) // Already installed otherwise
+    {
+        Function_Error += Service_Error;
+    }
+
+    Function_Error += Setup_Motor(&Motors[0], 0, Config, &Allocation);
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    __atomic_store_n(&Resources_Ready, true, __ATOMIC_RELEASE);
+
+    *Motor = &Motors[0];
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Configuration of a new motor with the default limits and any free resources.
+ *
+ * The pins are GPIO_NUM_NC and have to be set by the caller.
+ */
+void Stepper_Get_Default_Config(Stepper_Config_t *Config)
+{
+    Config->Step_Pin = GPIO_NUM_NC;
+    Config->Step_Output = true;
+    Config->Dir_Pin = GPIO_NUM_NC;
+    Config->Enable_Pin = GPIO_NUM_NC;
+    Config->Resources = (Stepper_Resource_t){STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY, STEPPER_RESOURCE_ANY};
+    Config->Max_Frequency_Hz = STEPPER_DEFAULT_MAX_FREQUENCY_HZ;
+    Config->Acceleration = STEPPER_DEFAULT_ACCELERATION;
+    Config->Duty = PWM_DUTY_CYCLE_50;
+}
+
+/**
+ * @brief Handle of a motor.
+ *
+ * @param Number Motor number, 0 for the motor of main.c, 1 for the first station.
+ * @return The handle, NULL if there is no such motor.
+ */
+stepper_t Stepper_Get(uint8_t Number)
+{
+    if (!__atomic_load_n(&Resources_Ready, __ATOMIC_ACQUIRE))
+    {
+        return NULL;
+    }
+
+    return (Number <= Stepper_Count()) ? &Motors[Number] : NULL;
+}
+
+/**
+ * @brief Number of station motors created.
+ */
+uint8_t Stepper_Count(void)
+{
+    return __atomic_load_n(&Motor_Count, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Set the highest cruise frequency and the acceleration of the moves of a motor.
+ *
+ * Takes effect with the next move, see Set_Stepper_Motor_Limits().
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG for a frequency outside the jog
+ *         range or an acceleration of 0.
+ */
+esp_err_t Stepper_Set_Limits(stepper_t Motor, uint32_t Max_Frequency_Hz, uint32_t Acceleration)
+{
+    if ((Max_Frequency_Hz < MOTION_JOG_MIN_FREQUENCY_HZ) || (Max_Frequency_Hz > STEPPER_MAX_FREQUENCY_HZ) || (Acceleration == 0))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&Motor->Lock);
+    Motor->Config.Max_Frequency_Hz = Max_Frequency_Hz;
+    Motor->Config.Acceleration = Acceleration;
+    portEXIT_CRITICAL(&Motor->Lock);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Configuration of a motor, with the resources it was given and its current limits.
+ */
+void Stepper_Get_Config(stepper_t Motor, Stepper_Config_t *Config)
+{
+    portENTER_CRITICAL(&Motor->Lock);
+    *Config = Motor->Config;
+    portEXIT_CRITICAL(&Motor->Lock);
+}
+
+#ifndef STEPPER_HOST_SIM // The host simulator has no queues or tasks, it only runs motor 0
+/**
+ * @brief Execute one move of a station and wait for its last step.
+ *
+ * @param Motor Motor to move.
+ * @param Command Move to execute.
+ * @param Executed_Steps Returns the steps emitted.
+ * @return ESP_OK if successful, ESP_ERR_INVALID_ARG if no move could be
+ *         planned, or the error of Stepper_Run_Profile().
+ */
+static esp_err_t Execute_Move(struct Stepper *Motor, const Stepper_Command_t *Command, uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+    bool Holding = false;
+
+    *Executed_Steps = 0;
+
+    portENTER_CRITICAL(&Motor->Lock);
+    int64_t Distance = Command->Absolute ? ((int64_t)Command->Target - Motor->Position) : Command->Target; // Only this task moves the motor, the position holds
+    uint32_t Max_Frequency_Hz = Motor->Config.Max_Frequency_Hz;
+    uint32_t Acceleration = Motor->Config.Acceleration;
+    portEXIT_CRITICAL(&Motor->Lock);
+
+    if (Distance == 0)
+    {
+        return ESP_OK; // Nothing to move
+    }
+
+    if ((Distance > INT32_MAX) || (Distance < -INT32_MAX))
+    {
+        return ESP_ERR_INVALID_ARG; // Position out of reach of one move
+    }
+
+    int32_t Steps = (int32_t)Distance;
+
+    Motion_Planner_Config_t Config = {
+        .Max_Frequency_Hz = (Command->Frequency_Hz > Max_Frequency_Hz) ? Max_Frequency_Hz : Command->Frequency_Hz, // Cruise frequency requested by the caller
+        .Acceleration = Acceleration,                                                                              // Acceleration limit of the motor
+        .Jerk = MOTION_DEFAULT_JERK,                                                                               // Default jerk limit
+        .Segment_Time_us = MOTION_SEGMENT_TIME_US,                                                                 // One ramp segment per RTOS tick
+    };
+
+    if (!Motion_Planner_Plan_Move(&Config, (uint32_t)((Steps < 0) ? -Steps : Steps), &Motor->Profile) || (Motor->Profile.Segment_Count == 0))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Function_Error += Stepper_Set_Direction(Motor, Steps > 0);
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    return Stepper_Run_Profile(Motor, &Motor->Profile, Motor->Config.Duty, Executed_Steps, &Holding);
+}
+
+/**
+ * @brief Motor task, executes the queued moves of one station in order.
+ *
+ * The command is peeked before it is taken, so Stepper_Wait() always sees
+ * it either waiting or busy. Taking a command of the current generation
+ * clears the stop and abort requests. The driver stays enabled while
+ * commands are waiting.
+ */
+static void Stepper_Task(void *arg)
+{
+    struct Stepper *Motor = (struct Stepper *)arg;
+    Stepper_Command_t Command;
+
+    while (true)
+    {
+        xQueuePeek(Motor->Queue, &Command, portMAX_DELAY);
+
+        portENTER_CRITICAL(&Motor->Lock);
+        Motor->Busy = true;
+        portEXIT_CRITICAL(&Motor->Lock);
+
+        esp_err_t Function_Error = ESP_OK;
+        uint32_t Executed_Steps = 0;
+        bool Executed = false;
+
+        if (xQueueReceive(Motor->Queue, &Command, 0) == pdTRUE) // Flushed meanwhile otherwise
+        {
+            portENTER_CRITICAL(&Motor->Lock);
+
+            Executed = (Command.Generation == Motor->Generation); // Queued before a stop otherwise
+
+            if (Executed)
+            {
+                Stepper_Clear_Stop(Motor);
+                Stepper_Clear_Abort(Motor);
+            }
+
+            portEXIT_CRITICAL(&Motor->Lock);
+        }
+
+        if (Executed)
+        {
+            if (Motor->Config.Enable_Pin != GPIO_NUM_NC)
+            {
+                Function_Error += gpio_set_level(Motor->Config.Enable_Pin, SET_GPIO_LEVEL_LOW);
+            }
+
+            Function_Error += Execute_Move(Motor, &Command, &Executed_Steps);
+
+            if ((Motor->Config.Enable_Pin != GPIO_NUM_NC) && (uxQueueMessagesWaiting(Motor->Queue) == 0))
+            {
+                gpio_set_level(Motor->Config.Enable_Pin, SET_GPIO_LEVEL_HIGH); // Nothing waiting, let the motor cool down
+            }
+        }
+
+        portENTER_CRITICAL(&Motor->Lock);
+
+        if (Executed)
+        {
+            Motor->Completed++;
+            Motor->Last_Executed_Steps = Executed_Steps;
+            Motor->Last_Error = Function_Error;
+        }
+
+        Motor->Busy = false;
+
+        portEXIT_CRITICAL(&Motor->Lock);
+    }
+}
+
+/**
+ * @brief Create a station motor, configure its hardware and start its task.
+ *
+ * @param Config Pins, wanted resources and limits of the motor.
+ * @param Motor Returns the handle.
+ * @return
+ *     - ESP_OK: Motor created, numbered after the ones before
+ *     - ESP_ERR_INVALID_ARG: Pin, limit or duty invalid, or no step output
+ *     - ESP_ERR_INVALID_STATE: Initialize_Steppers() not called
+ *     - ESP_ERR_NOT_FOUND: The wanted resources are in use or none are free
+ *     - ESP_ERR_NO_MEM: STEPPER_MAX_MOTORS reached or the queue or task could not be created
+ *     - Sum of the ESP return values of the hardware configuration otherwise
+ */
+esp_err_t Stepper_Create(const Stepper_Config_t *Config, stepper_t *Motor)
+{
+    if (!Valid_Config(Config) || !Config->Step_Output)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t Function_Error = ESP_OK;
+    Stepper_Resource_t Allocation;
+
+    portENTER_CRITICAL(&Create_Lock);
+
+    if (!Resources_Ready)
+    {
+        Function_Error = ESP_ERR_INVALID_STATE;
+    }
+    else if (Motor_Count >= STEPPER_MAX_MOTORS)
+    {
+        Function_Error = ESP_ERR_NO_MEM;
+    }
+    else if (!Stepper_Resources_Allocate(&Resources, &Config->Resources, &Allocation))
+    {
+        Function_Error = ESP_ERR_NOT_FOUND;
+    }
+
+    uint8_t Number = Motor_Count + 1;
+
+    portEXIT_CRITICAL(&Create_Lock);
+
+    if (Function_Error != ESP_OK)
+    {
+        return Function_Error;
+    }
+
+    struct Stepper *New_Motor = &Motors[Number]; // Callers create the motors from one task at start-up, the slot is not taken meanwhile
+
+    Function_Error = Setup_Motor(New_Motor, Number, Config, &Allocation);
+
+    if (Function_Error == ESP_OK)
+    {
+        New_Motor->Queue = xQueueCreate(STEPPER_QUEUE_LENGTH, sizeof(Stepper_Command_t));
+        Function_Error = (New_Motor->Queue != NULL) ? ESP_OK : ESP_ERR_NO_MEM;
+    }
+
+    if (Function_Error == ESP_OK)
+    {
+        char Name[configMAX_TASK_NAME_LEN];
+
+        snprintf(Name, sizeof(Name), "stepper%u", New_Motor->Number);
+
+        if (xTaskCreatePinnedToCore(Stepper_Task, Name, STEPPER_TASK_STACK_SIZE, New_Motor, STEPPER_TASK_PRIORITY, &New_Motor->Task, STEPPER_TASK_CORE) != pdPASS)
+        {
+            Function_Error = ESP_ERR_NO_MEM;
+        }
+    }
+
+    portENTER_CRITICAL(&Create_Lock);
+
+    if (Function_Error == ESP_OK)
+    {
+        Motor_Count++;
+    }
+    else
+    {
+        Stepper_Resources_Release(&Resources, &Allocation);
+    }
+
+    portEXIT_CRITICAL(&Create_Lock);
+
+    if (Function_Error != ESP_OK)
+    {
+        if (New_Motor->Queue != NULL)
+        {
+            vQueueDelete(New_Motor->Queue);
+        }
+
+        pcnt_isr_handler_remove((pcnt_unit_t)Allocation.Pcnt_Unit); // The slot is reused by the next motor
+
+        return Function_Error;
+    }
+
+    *Motor = New_Motor;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Queue a command for a motor, it starts once the commands before it ended.
+ */
+static esp_err_t Enqueue(stepper_t Motor, bool Absolute, int32_t Target, uint32_t Frequency_Hz)
+{
+    if (Motor->Queue == NULL)
+    {
+        return ESP_ERR_NOT_SUPPORTED; // Motor 0 takes its moves from the motion queue
+    }
+
+    if ((Frequency_Hz < MOTION_JOG_MIN_FREQUENCY_HZ) || (Frequency_Hz > STEPPER_MAX_FREQUENCY_HZ))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Stepper_Command_t Command = {
+        .Absolute = Absolute,
+        .Target = Target,
+        .Frequency_Hz = Frequency_Hz,
+    };
+
+    portENTER_CRITICAL(&Motor->Lock);
+    Command.Generation = Motor->Generation;
+    portEXIT_CRITICAL(&Motor->Lock);
+
+    return (xQueueSendToBack(Motor->Queue, &Command, 0) == pdTRUE) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+/**
+ * @brief Queue a relative move and return at once.
+ *
+ * @param Motor Motor to move.
+ * @param Steps Signed steps, positive forward.
+ * @param Frequency_Hz Cruise frequency, capped at the limit of the motor.
+ * @return ESP_OK if queued, ESP_ERR_INVALID_ARG for a frequency outside the
+ *         jog range, ESP_ERR_NO_MEM if the queue of the motor is full,
+ *         ESP_ERR_NOT_SUPPORTED for motor 0.
+ */
+esp_err_t Stepper_Move(stepper_t Motor, int32_t Steps, uint32_t Frequency_Hz)
+{
+    return Enqueue(Motor, false, Steps, Frequency_Hz);
+}
+
+/**
+ * @brief Queue a move to an absolute position and return at once.
+ *
+ * The distance is taken when the move starts, from where the moves before
+ * it ended.
+ *
+ * @return Same as Stepper_Move().
+ */
+esp_err_t Stepper_Move_To(stepper_t Motor, int32_t Position, uint32_t Frequency_Hz)
+{
+    return Enqueue(Motor, true, Position, Frequency_Hz);
+}
+
+/**
+ * @brief Drop the queued moves of a motor and ramp the running one down.
+ *
+ * The running move switches to a decel ramp from its current frequency
+ * unless it stops sooner by itself, see Stepper_Request_Stop(). Returns at
+ * once.
+ *
+ * @param Motor Motor to stop.
+ * @param Deceleration Deceleration in steps/s^2, 0 for the acceleration limit of the motor.
+ * @return ESP_OK.
+ */
+esp_err_t Stepper_Stop(stepper_t Motor, uint32_t Deceleration)
+{
+    portENTER_CRITICAL(&Motor->Lock);
+    Motor->Generation++;
+    bool Taken = Raise_Stop(Motor, (Deceleration != 0) ? Deceleration : Motor->Config.Acceleration); // With the generation, a command taken meanwhile is already stopped
+    portEXIT_CRITICAL(&Motor->Lock);
+
+    if (Motor->Queue != NULL)
+    {
+        xQueueReset(Motor->Queue);
+    }
+
+    if (Taken)
+    {
+        Notify_Motor_Task(Motor, MOTION_NOTIFY_STOP);
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Drop the queued moves of a motor and stop its output right away.
+ *
+ * The steps emitted so far stay counted into the position. Returns at once.
+ *
+ * @return ESP_OK.
+ */
+esp_err_t Stepper_Abort(stepper_t Motor)
+{
+    portENTER_CRITICAL(&Motor->Lock);
+    Motor->Generation++;
+    Motor->Abort_Requested = true;
+    portEXIT_CRITICAL(&Motor->Lock);
+
+    if (Motor->Queue != NULL)
+    {
+        xQueueReset(Motor->Queue);
+    }
+
+    Stepper_Request_Abort(Motor);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Wait until a station executed all its queued moves.
+ *
+ * Polls every STEPPER_WAIT_POLL_TICKS, the other motors keep running.
+ *
+ * @param Motor Motor to wait for.
+ * @param Wait Longest wait in ticks, portMAX_DELAY waits without end.
+ * @return ESP_OK once the motor is idle, ESP_ERR_TIMEOUT otherwise,
+ *         ESP_ERR_NOT_SUPPORTED for motor 0.
+ */
+esp_err_t Stepper_Wait(stepper_t Motor, TickType_t Wait)
+{
+    TickType_t Waited = 0;
+
+    if (Motor->Queue == NULL)
+    {
+        return ESP_ERR_NOT_SUPPORTED; // Motor 0 is waited for on the motion queue
+    }
+
+    while (true)
+    {
+        portENTER_CRITICAL(&Motor->Lock);
+        bool Busy = Motor->Busy;
+        portEXIT_CRITICAL(&Motor->Lock);
+
+        if (!Busy && (uxQueueMessagesWaiting(Motor->Queue) == 0))
+        {
+            return ESP_OK;
+        }
+
+        if ((Wait != portMAX_DELAY) && (Waited >= Wait))
+        {
+            return ESP_ERR_TIMEOUT;
+        }
+
+        vTaskDelay(STEPPER_WAIT_POLL_TICKS);
+        Waited += STEPPER_WAIT_POLL_TICKS;
+    }
+}
+
+/**
+ * @brief Snapshot of the state of a motor, the position includes the running count.
+ *
+ * Motor 0 has no queue, its moves are not counted in Completed.
+ */
+void Stepper_Get_Status(stepper_t Motor, Stepper_Status_t *Status)
+{
+    Status->Pending = (Motor->Queue != NULL) ? uxQueueMessagesWaiting(Motor->Queue) : 0;
+
+    portENTER_CRITICAL(&Motor->Lock);
+
+    Status->Number = Motor->Number;
+    Status->Resources = Motor->Config.Resources;
+    Status->Busy = Motor->Busy;
+    Status->Position = Motor->Position + Pending_Steps(Motor);
+    Status->Frequency_Hz = Motor->Frequency_Hz;
+    Status->Completed = Motor->Completed;
+    Status->Last_Executed_Steps = Motor->Last_Executed_Steps;
+    Status->Last_Error = Motor->Last_Error;
+
+    portEXIT_CRITICAL(&Motor->Lock);
+}
+#endif // STEPPER_HOST_SIM
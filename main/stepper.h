@@ -0,0 +1,124 @@
+/*H**********************************************************************
+ * FILENAME :        stepper.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Handle based stepper motor driver: motor 0 of main.c and further
+ *       motors, the stations of a fixture, each with its own pins, LEDC
+ *       timer and channel, PCNT unit, limits, position and stop requests.
+ *
+ * NOTES :
+ *       Every motor runs counted LEDC moves with one step engine: the PCNT
+ *       unit reads the step pad back, its interrupt stops the channel on the
+ *       last step and wakes the task following the move at every segment
+ *       boundary to set the next frequency of the motor's own timer, see
+ *       pulse_counter.h. Stepper_Run_Profile() runs one profile in the
+ *       calling task.
+ *
+ *       Initialize_Steppers() creates motor 0, which main.c drives from the
+ *       motion queue with all its features: jog mode, scripts, homing, the
+ *       encoder and the other pulse engines, for which the motor only
+ *       drives the direction and enable pins. Stepper_Create() adds motors
+ *       numbered from 1 with a command queue and a task of their own, so
+ *       Stepper_Move() returns at once and the motors run their profiles
+ *       concurrently; Stepper_Wait() waits for one of them.
+ *
+ *       The timers, channels and units are taken by stepper_resources.h,
+ *       Initialize_Steppers() takes those of motor 0 and reserves the unit
+ *       of the encoder first.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef STEPPER_H
+#define STEPPER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "ledc_range.h"
+#include "motion_planner.h"
+#include "stepper_resources.h"
+
+#define STEPPER_MAX_MOTORS (STEPPER_RESOURCES_MAX_MOTORS - 1) // Station motors, one timer is taken by motor 0
+#define STEPPER_QUEUE_LENGTH 8                                // Commands that can wait for one motor
+#define STEPPER_TASK_STACK_SIZE 3072                          // Stack size of one motor task in bytes
+#define STEPPER_TASK_PRIORITY 10                              // Same as the motion task of motor 0
+#define STEPPER_TASK_CORE 1                                   // APP CPU, like the motion task
+#define STEPPER_DEFAULT_MAX_FREQUENCY_HZ 20000                // Highest cruise frequency of a new motor
+#define STEPPER_DEFAULT_ACCELERATION 100000                   // Acceleration of a new motor in steps/s^2
+#define STEPPER_MAX_FREQUENCY_HZ 400000                       // Highest cruise frequency a motor can be given
+#define STEPPER_WAIT_POLL_TICKS 1                             // Poll interval of Stepper_Wait()
+
+/** Handle of a motor */
+typedef struct Stepper *stepper_t;
+
+/** Configuration of a motor */
+typedef struct
+{
+    gpio_num_t Step_Pin;          // Step pulse output, also read back by the PCNT unit
+    bool Step_Output;             // The LEDC channel drives the step pin, false if another pulse engine of main.c does
+    gpio_num_t Dir_Pin;           // Direction output, high forward
+    gpio_num_t Enable_Pin;        // Driver enable output, low active, GPIO_NUM_NC if the driver has none
+    Stepper_Resource_t Resources; // Wanted LEDC and PCNT resources, STEPPER_RESOURCE_ANY where any will do
+    uint32_t Max_Frequency_Hz;    // Highest cruise frequency of the planned moves
+    uint32_t Acceleration;        // Acceleration of the planned moves in steps/s^2
+    uint32_t Duty;                // Duty of the step pulses at LEDC_RANGE_DUTY_BITS, 512 is half
+} Stepper_Config_t;
+
+/** Snapshot of a motor */
+typedef struct
+{
+    uint8_t Number;               // Motor number, 0 for the motor of main.c, 1 for the first station
+    Stepper_Resource_t Resources; // LEDC and PCNT resources taken
+    uint32_t Pending;             // Commands waiting in the queue
+    bool Busy;                    // True while a move is being executed
+    int32_t Position;             // Absolute position in steps, with the running count
+    uint32_t Frequency_Hz;        // Step frequency applied last, 0 while stopped
+    uint32_t Completed;           // Moves finished since the motor was created
+    uint32_t Last_Executed_Steps; // Steps emitted by the last finished move
+    esp_err_t Last_Error;         // Result of the last finished move
+} Stepper_Status_t;
+
+esp_err_t Initialize_Steppers(const Stepper_Config_t *Config, stepper_t *Motor);
+void Stepper_Get_Default_Config(Stepper_Config_t *Config);
+esp_err_t Stepper_Create(const Stepper_Config_t *Config, stepper_t *Motor);
+stepper_t Stepper_Get(uint8_t Number);
+uint8_t Stepper_Count(void);
+esp_err_t Stepper_Move(stepper_t Motor, int32_t Steps, uint32_t Frequency_Hz);
+esp_err_t Stepper_Move_To(stepper_t Motor, int32_t Position, uint32_t Frequency_Hz);
+esp_err_t Stepper_Stop(stepper_t Motor, uint32_t Deceleration);
+esp_err_t Stepper_Abort(stepper_t Motor);
+esp_err_t Stepper_Wait(stepper_t Motor, TickType_t Wait);
+esp_err_t Stepper_Set_Limits(stepper_t Motor, uint32_t Max_Frequency_Hz, uint32_t Acceleration);
+void Stepper_Get_Config(stepper_t Motor, Stepper_Config_t *Config);
+void Stepper_Get_Status(stepper_t Motor, Stepper_Status_t *Status);
+esp_err_t Stepper_Run_Profile(stepper_t Motor, const Motion_Profile_t *Profile, uint32_t Duty, uint32_t *Executed_Steps, bool *Holding);
+uint32_t Stepper_Prepare_Duty(stepper_t Motor, uint32_t Peak_Frequency_Hz, uint32_t Duty);
+esp_err_t Stepper_Set_Frequency(stepper_t Motor, uint32_t Frequency_Hz);
+esp_err_t Stepper_Start_Output(stepper_t Motor, uint32_t Duty_Register);
+esp_err_t Stepper_Pause_Output(stepper_t Motor);
+void Stepper_Stop_Output(stepper_t Motor);
+void Stepper_Route_Output(stepper_t Motor);
+bool Stepper_Holding(stepper_t Motor);
+bool Stepper_End_Hold(stepper_t Motor, uint32_t *Executed_Steps);
+void Stepper_Get_Step_Clock(stepper_t Motor, Ledc_Range_t *Range, uint32_t *Resolution_Changes);
+esp_err_t Stepper_Set_Direction(stepper_t Motor, bool Forward);
+int8_t Stepper_Get_Direction(stepper_t Motor);
+void Stepper_Add_Steps(stepper_t Motor, int32_t Steps);
+int32_t Stepper_Get_Position(stepper_t Motor);
+uint32_t Stepper_Get_Emitted_Steps(stepper_t Motor);
+void Stepper_Set_Position(stepper_t Motor, int32_t Position);
+bool Stepper_Request_Stop(stepper_t Motor, uint32_t Deceleration);
+uint32_t Stepper_Stop_Requested(stepper_t Motor);
+const uint32_t *Stepper_Stop_Deceleration(stepper_t Motor);
+void Stepper_Clear_Stop(stepper_t Motor);
+void Stepper_Request_Abort(stepper_t Motor);
+const volatile bool *Stepper_Abort_Flag(stepper_t Motor);
+void Stepper_Clear_Abort(stepper_t Motor);
+
+#endif // STEPPER_H
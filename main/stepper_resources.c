@@ -0,0 +1,169 @@
+/*H**********************************************************************
+ * FILENAME :        stepper_resources.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent allocation of the LEDC timers and channels and
+ *       of the PCNT units to the motors of stepper.h.
+ *
+ * NOTES :
+ *       The callers serialize the calls, the allocator holds no lock.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "stepper_resources.h"
+
+#include <string.h>
+
+/**
+ * @brief Lowest free bit of a mask, or the wanted one if it is free.
+ *
+ * @param In_Use Bits in use.
+ * @param Count Number of valid bits.
+ * @param Wanted Bit asked for or STEPPER_RESOURCE_ANY.
+ * @return The bit, STEPPER_RESOURCE_ANY if it is in use, out of range or none is free.
+ */
+static uint8_t Pick_Bit(uint8_t In_Use, uint8_t Count, uint8_t Wanted)
+{
+    if (Wanted != STEPPER_RESOURCE_ANY)
+    {
+        return ((Wanted < Count) && ((In_Use & (1U << Wanted)) == 0)) ? Wanted : STEPPER_RESOURCE_ANY;
+    }
+
+    for (uint8_t Bit = 0; Bit < Count; Bit++)
+    {
+        if ((In_Use & (1U << Bit)) == 0)
+        {
+            return Bit;
+        }
+    }
+
+    return STEPPER_RESOURCE_ANY;
+}
+
+/**
+ * @brief Mark every resource free.
+ */
+void Stepper_Resources_Init(Stepper_Resources_t *Resources)
+{
+    memset(Resources, 0, sizeof(*Resources));
+}
+
+/**
+ * @brief Take the resources of one motor.
+ *
+ * The speed mode is the first one with a free timer and channel left,
+ * low speed first since its timers update glitch free.
+ *
+ * @param Resources Resources in use, updated on success.
+ * @param Request Wanted resources, STEPPER_RESOURCE_ANY where any will do.
+ * @param Allocation Returns the resources taken.
+ * @return false if a wanted resource is in use or invalid or none is free, nothing is taken then.
+ */
+bool Stepper_Resources_Allocate(Stepper_Resources_t *Resources, const Stepper_Resource_t *Request, Stepper_Resource_t *Allocation)
+{
+    static const uint8_t Mode_Order[STEPPER_RESOURCES_SPEED_MODES] = {1, 0}; // ledc_mode_t of low speed, then high speed
+
+    uint8_t Pcnt_Unit = Pick_Bit(Resources->Pcnt_Units, STEPPER_RESOURCES_PCNT_UNITS, Request->Pcnt_Unit);
+
+    if (Pcnt_Unit == STEPPER_RESOURCE_ANY)
+    {
+        return false;
+    }
+
+    for (uint8_t Index = 0; Index < STEPPER_RESOURCES_SPEED_MODES; Index++)
+    {
+        uint8_t Mode = Mode_Order[Index];
+
+        if ((Request->Speed_Mode != STEPPER_RESOURCE_ANY) && (Request->Speed_Mode != Mode))
+        {
+            continue;
+        }
+
+        uint8_t Timer = Pick_Bit(Resources->Timers[Mode], STEPPER_RESOURCES_TIMERS, Request->Timer);
+        uint8_t Channel = Pick_Bit(Resources->Channels[Mode], STEPPER_RESOURCES_CHANNELS, Request->Channel);
+
+        if ((Timer == STEPPER_RESOURCE_ANY) || (Channel == STEPPER_RESOURCE_ANY))
+        {
+            continue;
+        }
+
+        Resources->Timers[Mode] |= (uint8_t)(1U << Timer);
+        Resources->Channels[Mode] |= (uint8_t)(1U << Channel);
+        Resources->Pcnt_Units |= (uint8_t)(1U << Pcnt_Unit);
+
+        Allocation->Speed_Mode = Mode;
+        Allocation->Timer = Timer;
+        Allocation->Channel = Channel;
+        Allocation->Pcnt_Unit = Pcnt_Unit;
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Give back the resources of one motor.
+ */
+void Stepper_Resources_Release(Stepper_Resources_t *Resources, const Stepper_Resource_t *Allocation)
+{
+    if (Allocation->Speed_Mode < STEPPER_RESOURCES_SPEED_MODES)
+    {
+        if (Allocation->Timer < STEPPER_RESOURCES_TIMERS)
+        {
+            Resources->Timers[Allocation->Speed_Mode] &= (uint8_t)~(1U << Allocation->Timer);
+        }
+
+        if (Allocation->Channel < STEPPER_RESOURCES_CHANNELS)
+        {
+            Resources->Channels[Allocation->Speed_Mode] &= (uint8_t)~(1U << Allocation->Channel);
+        }
+    }
+
+    if (Allocation->Pcnt_Unit < STEPPER_RESOURCES_PCNT_UNITS)
+    {
+        Resources->Pcnt_Units &= (uint8_t)~(1U << Allocation->Pcnt_Unit);
+    }
+}
+
+/**
+ * @brief Take a PCNT unit used outside the motors, e.g. by the encoder.
+ *
+ * @return false if the unit is invalid or in use.
+ */
+bool Stepper_Resources_Reserve_Unit(Stepper_Resources_t *Resources, uint8_t Pcnt_Unit)
+{
+    if (Pick_Bit(Resources->Pcnt_Units, STEPPER_RESOURCES_PCNT_UNITS, Pcnt_Unit) == STEPPER_RESOURCE_ANY)
+    {
+        return false;
+    }
+
+    Resources->Pcnt_Units |= (uint8_t)(1U << Pcnt_Unit);
+
+    return true;
+}
+
+/**
+ * @brief Number of motors that can still be allocated with STEPPER_RESOURCE_ANY requests.
+ */
+uint8_t Stepper_Resources_Free_Motors(const Stepper_Resources_t *Resources)
+{
+    uint8_t Motors = 0;
+    uint8_t Units = 0;
+
+    for (uint8_t Mode = 0; Mode < STEPPER_RESOURCES_SPEED_MODES; Mode++)
+    {
+        uint8_t Timers = (uint8_t)(STEPPER_RESOURCES_TIMERS - __builtin_popcount(Resources->Timers[Mode]));
+        uint8_t Channels = (uint8_t)(STEPPER_RESOURCES_CHANNELS - __builtin_popcount(Resources->Channels[Mode]));
+
+        Motors += (Timers < Channels) ? Timers : Channels;
+    }
+
+    Units = (uint8_t)(STEPPER_RESOURCES_PCNT_UNITS - __builtin_popcount(Resources->Pcnt_Units));
+
+    return (Motors < Units) ? Motors : Units;
+}
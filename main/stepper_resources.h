@@ -0,0 +1,64 @@
+/*H**********************************************************************
+ * FILENAME :        stepper_resources.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent allocation of the LEDC timers and channels and
+ *       of the PCNT units to the motors of stepper.h.
+ *
+ * NOTES :
+ *       Every motor needs an LEDC channel driving its step pad, a timer of
+ *       its own in the same speed mode, since the timer sets the step
+ *       frequency, and a PCNT unit counting its steps. The ESP32 has two
+ *       speed modes of 4 timers and 8 channels each and 8 PCNT units, so
+ *       the timers limit the motors to 8 and half of the channels stay
+ *       free. Resources in use elsewhere, e.g. by the motor of main.c, are
+ *       reserved first.
+ *
+ *       A request names the speed mode, timer, channel and unit it needs or
+ *       leaves any of them to the allocator with STEPPER_RESOURCE_ANY,
+ *       which takes the lowest free one. A request is taken whole or not at
+ *       all.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef STEPPER_RESOURCES_H
+#define STEPPER_RESOURCES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define STEPPER_RESOURCES_SPEED_MODES 2                                                        // LEDC speed modes, high and low speed
+#define STEPPER_RESOURCES_TIMERS 4                                                             // LEDC timers of one speed mode
+#define STEPPER_RESOURCES_CHANNELS 8                                                           // LEDC channels of one speed mode
+#define STEPPER_RESOURCES_PCNT_UNITS 8                                                         // Pulse counter units
+#define STEPPER_RESOURCES_MAX_MOTORS (STEPPER_RESOURCES_SPEED_MODES * STEPPER_RESOURCES_TIMERS) // One timer per motor
+#define STEPPER_RESOURCE_ANY 0xFF                                                              // Let the allocator pick
+
+/** Resources of one motor, also a request with STEPPER_RESOURCE_ANY fields */
+typedef struct
+{
+    uint8_t Speed_Mode; // LEDC speed mode, the value of ledc_mode_t
+    uint8_t Timer;      // LEDC timer of that speed mode
+    uint8_t Channel;    // LEDC channel of that speed mode
+    uint8_t Pcnt_Unit;  // PCNT unit counting the steps
+} Stepper_Resource_t;
+
+/** Resources in use, one bit each */
+typedef struct
+{
+    uint8_t Timers[STEPPER_RESOURCES_SPEED_MODES];   // Timers in use per speed mode
+    uint8_t Channels[STEPPER_RESOURCES_SPEED_MODES]; // Channels in use per speed mode
+    uint8_t Pcnt_Units;                              // PCNT units in use
+} Stepper_Resources_t;
+
+void Stepper_Resources_Init(Stepper_Resources_t *Resources);
+bool Stepper_Resources_Allocate(Stepper_Resources_t *Resources, const Stepper_Resource_t *Request, Stepper_Resource_t *Allocation);
+void Stepper_Resources_Release(Stepper_Resources_t *Resources, const Stepper_Resource_t *Allocation);
+bool Stepper_Resources_Reserve_Unit(Stepper_Resources_t *Resources, uint8_t Pcnt_Unit);
+uint8_t Stepper_Resources_Free_Motors(const Stepper_Resources_t *Resources);
+
+#endif // STEPPER_RESOURCES_H
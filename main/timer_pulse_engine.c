@@ -0,0 +1,767 @@
+/*H**********************************************************************
+ * FILENAME :        timer_pulse_engine.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Timer interrupt based pulse engine for the stepper motor example,
+ *       running on the APP CPU.
+ *
+ * NOTES :
+ *       The step timer runs with auto reload and fires twice per step: at
+ *       the rising edge, where the next period is taken from the segment
+ *       ring, and at the falling edge. Periods are tracked in Q16 fractions
+ *       of a tick like in segment_encoder.c, the division is done by the
+ *       producer when it pushes a segment, the interrupt only adds.
+ *
+ *       The motion task is the only producer. Engine_Lock guards the run
+ *       state against a stop from the other core, it is never held while a
+ *       segment is pushed. On a stop request the motion task drops the
+ *       queued segments under the lock and hands the interrupt the first
+ *       segment of a decel ramp from the current period, the rest of the
+ *       ramp is queued like a profile.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "timer_pulse_engine.h"
+#include "main.h"
+#include "segment_ring.h"
+#include "soc/gpio_struct.h"
+#include "esp_attr.h"
+#include "esp_intr_alloc.h"
+
+_Static_assert(STEPPER_MOTOR_PUL_PIN < 32, "The pulse pin must be in the first GPIO output register");
+
+#define TIMER_PULSE_ENGINE_PUL_MASK (1UL << STEPPER_MOTOR_PUL_PIN) // GPIO output register bit of the pulse pin
+
+static Segment_Ring_t Ring;                                     // Segments from the motion task to the interrupt
+static Segment_Ring_Item_t Segment;                             // Segment being emitted, Steps counts down
+static uint32_t Phase_Q16 = 0;                                  // Fraction of a tick carried to the next step
+static uint32_t Low_Ticks = 0;                                  // Low time of the step being emitted
+static bool Rising_Edge_Next = true;                            // Which half of the step the next alarm starts
+static volatile bool Running = false;                           // Step timer running
+static volatile bool Holding = false;                           // The emitted segment repeats until the next one arrives
+static volatile bool Abort_Pending = false;                     // End the output at the next step
+static volatile uint32_t Steps_Emitted = 0;                     // Rising edges since the output started
+static TaskHandle_t Waiting_Task = NULL;                        // Task waiting in Timer_Pulse_Engine_Run()
+static Motion_Profile_t Stop_Profiles[2];                       // Decel ramps of a stop, a steeper one replaces the other
+static Timer_Pulse_Engine_Latency_t Latency_Stats;              // Alarm to interrupt latency
+static portMUX_TYPE Engine_Lock = portMUX_INITIALIZER_UNLOCKED; // Guards the run state between the interrupt and a stop
+#ifndef STEPPER_HOST_SIM
+static esp_err_t Setup_Error = ESP_OK; // Result of the interrupt allocation on TIMER_PULSE_ENGINE_CORE
+#endif
+
+/**
+ * @brief Add one latency sample to the histogram, called with Engine_Lock held.
+ */
+static void IRAM_ATTR Record_Latency(uint32_t Ticks)
+{
+    uint32_t Bin = (Ticks > 1) ? (uint32_t)(31 - __builtin_clz(Ticks)) : 0;
+
+    if (Bin >= TIMER_PULSE_ENGINE_LATENCY_BINS)
+    {
+        Bin = TIMER_PULSE_ENGINE_LATENCY_BINS - 1;
+    }
+
+    Latency_Stats.Min_Ticks = ((Latency_Stats.Count == 0) || (Ticks < Latency_Stats.Min_Ticks)) ? Ticks : Latency_Stats.Min_Ticks;
+    Latency_Stats.Max_Ticks = (Ticks > Latency_Stats.Max_Ticks) ? Ticks : Latency_Stats.Max_Ticks;
+    Latency_Stats.Sum_Ticks += Ticks;
+    Latency_Stats.Count++;
+    Latency_Stats.Bins[Bin]++;
+}
+
+/**
+ * @brief Period of the next step, taken from the ring when the segment ends.
+ *
+ * A held segment is left as soon as the producer pushed the next one.
+ *
+ * @param Step_Ticks Returns the period in ticks.
+ * @return false if the ring ran empty, the output has to stop.
+ */
+static bool IRAM_ATTR Next_Step(uint32_t *Step_Ticks)
+{
+    if ((Segment.Steps == 0) || ((Segment.Steps == SEGMENT_RING_HOLD) && (Segment_Ring_Count(&Ring) > 0)))
+    {
+        if (!Segment_Ring_Pop(&Ring, &Segment))
+        {
+            return false;
+        }
+
+        Holding = (Segment.Steps == SEGMENT_RING_HOLD);
+    }
+
+    uint64_t Period_Q16 = Phase_Q16 + Segment.Period_Q16;
+
+    *Step_Ticks = (uint32_t)(Period_Q16 >> 16);
+    Phase_Q16 = (uint32_t)(Period_Q16 & 0xFFFF);
+
+    if (Segment.Steps != SEGMENT_RING_HOLD)
+    {
+        Segment.Steps--;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Step timer interrupt, starts one half of a step per alarm.
+ */
+static void IRAM_ATTR Timer_Pulse_Engine_ISR(void *arg)
+{
+    uint32_t Latency_Ticks = (uint32_t)timer_group_get_counter_value_in_isr(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX); // Counter restarted at the alarm
+    uint32_t Alarm_Ticks = 0;                                                                                                 // Duration of the half that starts now
+    uint32_t Step_Ticks = 0;                                                                                                  // Period of a new step
+    BaseType_t Woken = pdFALSE;                                                                                               // Set if the notified task should run next
+
+    timer_group_clr_intr_status_in_isr(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX);
+
+    portENTER_CRITICAL_ISR(&Engine_Lock);
+
+    if (!Running)
+    {
+        portEXIT_CRITICAL_ISR(&Engine_Lock); // Stopped while the alarm was pending
+        return;
+    }
+
+    Record_Latency(Latency_Ticks);
+
+    if (Rising_Edge_Next)
+    {
+        if (Abort_Pending || !Next_Step(&Step_Ticks))
+        {
+            // Profile done, ring underrun or abort, stop the timer and wake the task
+            timer_group_set_counter_enable_in_isr(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, TIMER_PAUSE);
+
+            Segment_Ring_Drain(&Ring);
+            Segment.Steps = 0;
+            Running = false;
+            Holding = false;
+
+            TaskHandle_t Task = Waiting_Task;
+
+            portEXIT_CRITICAL_ISR(&Engine_Lock);
+
+            if (Task != NULL)
+            {
+                xTaskNotifyFromISR(Task, TIMER_PULSE_ENGINE_NOTIFY_DONE, eSetBits, &Woken);
+            }
+
+            if (Woken == pdTRUE)
+            {
+                portYIELD_FROM_ISR();
+            }
+
+            return;
+        }
+
+        GPIO.out_w1ts = TIMER_PULSE_ENGINE_PUL_MASK;
+
+        Steps_Emitted++;
+        Alarm_Ticks = TIMER_PULSE_ENGINE_HIGH_TICKS;
+        Low_Ticks = (Step_Ticks > TIMER_PULSE_ENGINE_HIGH_TICKS) ? (Step_Ticks - TIMER_PULSE_ENGINE_HIGH_TICKS) : 0;
+    }
+    else
+    {
+        GPIO.out_w1tc = TIMER_PULSE_ENGINE_PUL_MASK;
+
+        Alarm_Ticks = Low_Ticks;
+    }
+
+    Rising_Edge_Next = !Rising_Edge_Next;
+
+    portEXIT_CRITICAL_ISR(&Engine_Lock);
+
+    if (Alarm_Ticks < (Latency_Ticks + TIMER_PULSE_ENGINE_MIN_ALARM_TICKS))
+    {
+        Alarm_Ticks = Latency_Ticks + TIMER_PULSE_ENGINE_MIN_ALARM_TICKS; // An alarm already passed would only fire after the counter wraps
+    }
+
+    timer_group_set_alarm_value_in_isr(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, Alarm_Ticks);
+    timer_group_enable_alarm_in_isr(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX);
+}
+
+#ifndef STEPPER_HOST_SIM
+/**
+ * @brief Allocate the step timer interrupt on the CPU this task is pinned to.
+ *
+ * @param arg Task to notify when done.
+ */
+static void Setup_Task(void *arg)
+{
+    Setup_Error = timer_isr_register(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, Timer_Pulse_Engine_ISR, NULL, ESP_INTR_FLAG_IRAM, NULL);
+
+    xTaskNotify((TaskHandle_t)arg, TIMER_PULSE_ENGINE_NOTIFY_DONE, eSetBits);
+
+    vTaskDelete(NULL);
+}
+#endif
+
+/**
+ * @brief Step period of a frequency in Q16 ticks.
+ */
+static uint64_t Period_Q16(uint32_t Frequency_Hz)
+{
+    return ((uint64_t)TIMER_PULSE_ENGINE_TICK_HZ << 16) / Frequency_Hz;
+}
+
+/**
+ * @brief Queue the segments of a profile the ring has room for.
+ *
+ * A continuous profile ends with its last frequency held.
+ *
+ * @param Profile Profile being emitted.
+ * @param Segment_Index Next segment to queue, advanced past the queued ones.
+ * @return true once every segment is queued.
+ */
+static bool Push_Segments(const Motion_Profile_t *Profile, uint16_t *Segment_Index)
+{
+    while (*Segment_Index < Profile->Segment_Count)
+    {
+        const Motion_Segment_t *Next = &Profile->Segments[*Segment_Index];
+
+        if ((Next->Steps > 0) && (Next->Frequency_Hz > 0) && !Segment_Ring_Push(&Ring, Period_Q16(Next->Frequency_Hz), Next->Steps))
+        {
+            return false; // Ring full, topped up again on the next call
+        }
+
+        (*Segment_Index)++;
+    }
+
+    if (Profile->Continuous && (Profile->Segment_Count > 0) && (*Segment_Index == Profile->Segment_Count))
+    {
+        uint32_t Frequency_Hz = Profile->Segments[Profile->Segment_Count - 1].Frequency_Hz;
+
+        if ((Frequency_Hz > 0) && !Segment_Ring_Push(&Ring, Period_Q16(Frequency_Hz), SEGMENT_RING_HOLD))
+        {
+            return false;
+        }
+
+        (*Segment_Index)++; // Past the last segment, the held cruise frequency is queued
+    }
+
+    return true;
+}
+
+/**
+ * @brief Replace the segments not emitted yet by a decel ramp to standstill.
+ *
+ * The ramp starts from the period of the step being emitted, its first
+ * segment takes over at the next step and the caller queues the rest with
+ * Push_Segments(). A motor already slower than the ramp start stops at its
+ * next step. The stop is not taken if the output ends sooner by itself.
+ *
+ * @param Deceleration Deceleration of the stop request in steps/s^2.
+ * @param Remaining_Steps Steps left to the end of the output, UINT32_MAX if open ended.
+ * @param Stop_Profile Output decel ramp, not the profile being queued.
+ * @param Segment_Index Returns the next ramp segment to queue.
+ * @param Start_Steps Returns the steps emitted before the ramp.
+ * @return true if the ramp replaced the queued segments.
+ */
+static bool Begin_Stop(uint32_t Deceleration, uint32_t Remaining_Steps, Motion_Profile_t *Stop_Profile, uint16_t *Segment_Index, uint32_t *Start_Steps)
+{
+    portENTER_CRITICAL(&Engine_Lock);
+    uint64_t Running_Period_Q16 = Running ? Segment.Period_Q16 : 0; // 0 before the first step
+    portEXIT_CRITICAL(&Engine_Lock);
+
+    uint32_t Frequency_Hz = (Running_Period_Q16 > 0) ? (uint32_t)(((uint64_t)TIMER_PULSE_ENGINE_TICK_HZ << 16) / Running_Period_Q16) : 0;
+
+    if (!Motion_Planner_Plan_Stop(Frequency_Hz, Deceleration, MOTION_SEGMENT_TIME_US, Stop_Profile) || (Stop_Profile->Total_Steps >= Remaining_Steps))
+    {
+        return false;
+    }
+
+    Motor_Resonance_Apply(Stop_Profile); // Cross the bands on the way down
+
+    *Segment_Index = 0;
+
+    while ((*Segment_Index < Stop_Profile->Segment_Count) && ((Stop_Profile->Segments[*Segment_Index].Steps == 0) || (Stop_Profile->Segments[*Segment_Index].Frequency_Hz == 0)))
+    {
+        (*Segment_Index)++; // Skip to the first segment with steps
+    }
+
+    portENTER_CRITICAL(&Engine_Lock);
+    Segment_Ring_Drain(&Ring); // The interrupt is held off, nothing is popped meanwhile
+
+    if (*Segment_Index < Stop_Profile->Segment_Count)
+    {
+        Segment.Period_Q16 = Period_Q16(Stop_Profile->Segments[*Segment_Index].Frequency_Hz);
+        Segment.Steps = Stop_Profile->Segments[*Segment_Index].Steps;
+        (*Segment_Index)++;
+    }
+    else
+    {
+        Segment.Steps = 0; // Slower than the ramp start, the ring is empty at the next step
+    }
+
+    Holding = false;
+    *Start_Steps = Steps_Emitted;
+    portEXIT_CRITICAL(&Engine_Lock);
+
+    if (Stop_Profile->Segment_Count > 0)
+    {
+        MOTION_TRACE(MOTION_TRACE_FREQUENCY, Stop_Profile->Segments[0].Frequency_Hz);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Forget the state of the last output, the timer must be stopped.
+ *
+ * @param Task Task to notify when the output stops, may be NULL.
+ */
+static void Reset_Output(TaskHandle_t Task)
+{
+    portENTER_CRITICAL(&Engine_Lock);
+    Segment_Ring_Reset(&Ring);
+    Segment.Period_Q16 = 0; // No step emitted yet, a stop before the first one ends the output there
+    Segment.Steps = 0;
+    Phase_Q16 = 0;
+    Rising_Edge_Next = true;
+    Holding = false;
+    Abort_Pending = false;
+    Steps_Emitted = 0;
+    Waiting_Task = Task;
+    portEXIT_CRITICAL(&Engine_Lock);
+}
+
+/**
+ * @brief Start the step timer on the segments in the ring.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+static esp_err_t Start_Output(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    Function_Error += timer_set_counter_value(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, 0);
+    Function_Error += timer_set_alarm_value(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, TIMER_PULSE_ENGINE_MIN_ALARM_TICKS);
+    Function_Error += timer_set_alarm(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, TIMER_ALARM_EN);
+
+    Running = true;
+
+    Function_Error += timer_start(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Initialize the pulse pin and the step timer, and allocate the step
+ *        timer interrupt on TIMER_PULSE_ENGINE_CORE.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t Initialize_Timer_Pulse_Engine(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+    // Configuration structure for the GPIO settings of the pulse pin
+    gpio_config_t io_conf = {}; // Zero-initialize the config structure
+
+    io_conf.intr_type = GPIO_PIN_INTR_DISABLE;            // Disable interrupt for the GPIO pin
+    io_conf.mode = GPIO_MODE_OUTPUT;                      // Set the GPIO pin to output mode
+    io_conf.pin_bit_mask = 1ULL << STEPPER_MOTOR_PUL_PIN; // Driven by the GPIO output register
+    io_conf.pull_down_en = GPIO_PULLUP_DISABLE;           // Disable pull-down mode for the GPIO pin
+    io_conf.pull_up_en = GPIO_PULLDOWN_DISABLE;           // Disable pull-up mode for the GPIO pin
+
+    Function_Error += gpio_config(&io_conf);
+    Function_Error += gpio_set_level(STEPPER_MOTOR_PUL_PIN, SET_GPIO_LEVEL_LOW);
+
+    // Configuration structure for the step timer
+    timer_config_t Step_Timer = {}; // Zero-initialize the config structure
+
+    Step_Timer.divider = TIMER_PULSE_ENGINE_DIVIDER; // Tick rate of the alarms
+    Step_Timer.counter_dir = TIMER_COUNT_UP;         // Count up to the alarm value
+    Step_Timer.counter_en = TIMER_PAUSE;             // Started for every move
+    Step_Timer.alarm_en = TIMER_ALARM_EN;            // Interrupt on the alarm value
+    Step_Timer.auto_reload = TIMER_AUTORELOAD_EN;    // Restart from 0 on every alarm, so the counter is the latency
+    Step_Timer.intr_type = TIMER_INTR_LEVEL;         // Level interrupt
+
+    Function_Error += timer_init(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, &Step_Timer);
+    Function_Error += timer_set_counter_value(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, 0);
+    Function_Error += timer_enable_intr(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX);
+
+    Reset_Output(NULL);
+    Timer_Pulse_Engine_Reset_Latency();
+
+#ifdef STEPPER_HOST_SIM
+    Function_Error += timer_isr_register(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX, Timer_Pulse_Engine_ISR, NULL, ESP_INTR_FLAG_IRAM, NULL); // One simulated CPU
+#else
+    // An interrupt is allocated on the CPU calling timer_isr_register()
+    if (xTaskCreatePinnedToCore(Setup_Task, "pulse_setup", TIMER_PULSE_ENGINE_SETUP_STACK_SIZE, xTaskGetCurrentTaskHandle(), configMAX_PRIORITIES - 1, NULL, TIMER_PULSE_ENGINE_CORE) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskNotifyWait(0, TIMER_PULSE_ENGINE_NOTIFY_DONE, NULL, pdMS_TO_TICKS(1000)) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    Function_Error += Setup_Error;
+#endif
+
+    return Function_Error;
+}
+
+/**
+ * @brief Emit a planned profile and wait for its last step.
+ *
+ * The ring is topped up once per RTOS tick while the profile runs. For a
+ * continuous profile the function returns once the held cruise frequency
+ * is reached, with the motor still running. On a stop request the rest of
+ * the profile is replaced by a decel ramp from the current period, unless
+ * the profile stops sooner by itself; a steeper request later replaces
+ * that ramp the same way.
+ *
+ * @param Profile The profile to execute.
+ * @param Timeout Longest time to wait for the profile to end.
+ * @param Abort_Requested Flag set by Timer_Pulse_Engine_Abort() callers, checked before starting.
+ * @param Stop_Deceleration Deceleration of a stop request in steps/s^2, 0 if none, read atomically.
+ * @param Executed_Steps Returns the number of steps emitted, may be NULL.
+ * @return ESP_OK if successful, also after a stop, ESP_ERR_TIMEOUT if the
+ *         profile did not end in time, or the error of the failing timer call.
+ */
+esp_err_t Timer_Pulse_Engine_Run(const Motion_Profile_t *Profile, TickType_t Timeout, const volatile bool *Abort_Requested, const uint32_t *Stop_Deceleration, uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+    uint16_t Segment_Index = 0;
+    uint32_t Notified = 0;
+    uint32_t Stop_Taken = 0;  // Deceleration of the decel ramp being emitted, 0 before a stop
+    uint32_t Start_Steps = 0; // Steps emitted before the profile being queued
+
+    if (Running)
+    {
+        Function_Error += Timer_Pulse_Engine_Stop(); // A held frequency is replaced by the profile
+    }
+
+    Reset_Output(xTaskGetCurrentTaskHandle());
+
+    xTaskNotifyWait(0, ULONG_MAX, NULL, 0); // Drop events left over from an earlier move
+
+    if (((Profile->Total_Steps > 0) || Profile->Continuous) && !(*Abort_Requested) && (Function_Error == ESP_OK))
+    {
+        TickType_t Start_Ticks = xTaskGetTickCount();
+
+        Push_Segments(Profile, &Segment_Index);
+
+        Function_Error += Start_Output();
+
+        MOTION_TRACE(MOTION_TRACE_PULSE_START, (Profile->Segment_Count > 0) ? Profile->Segments[0].Frequency_Hz : 0);
+
+        while (Function_Error == ESP_OK)
+        {
+            uint32_t Deceleration = __atomic_load_n(Stop_Deceleration, __ATOMIC_ACQUIRE);
+
+            if (Deceleration > Stop_Taken)
+            {
+                Motion_Profile_t *Stop_Profile = (Profile == &Stop_Profiles[0]) ? &Stop_Profiles[1] : &Stop_Profiles[0]; // Not the one being queued
+                uint32_t Remaining_Steps = Profile->Continuous ? UINT32_MAX : (Profile->Total_Steps - (Steps_Emitted - Start_Steps));
+
+                Stop_Taken = Deceleration; // Not retried if the profile ends sooner
+
+                if (Begin_Stop(Deceleration, Remaining_Steps, Stop_Profile, &Segment_Index, &Start_Steps))
+                {
+                    Profile = Stop_Profile;
+                    Start_Ticks = xTaskGetTickCount();
+                    Timeout = pdMS_TO_TICKS((Profile->Duration_us / 1000) + MOTION_TIMEOUT_MARGIN_MS);
+                }
+            }
+
+            bool Queued = Push_Segments(Profile, &Segment_Index);
+
+            if ((Notified & TIMER_PULSE_ENGINE_NOTIFY_DONE) != 0)
+            {
+                Function_Error = (Queued || Abort_Pending) ? ESP_OK : ESP_FAIL; // The interrupt ran out of segments before the last one was queued
+                break;
+            }
+
+            if (Queued && Profile->Continuous && Holding)
+            {
+                break;
+            }
+
+            TickType_t Elapsed = xTaskGetTickCount() - Start_Ticks;
+
+            if (Elapsed >= Timeout)
+            {
+                Function_Error = ESP_ERR_TIMEOUT;
+                break;
+            }
+
+            // Wake every tick while segments are left to queue or the hold is not reached yet, a stop request wakes up at once
+            xTaskNotifyWait(0, ULONG_MAX, &Notified, (Queued && !Profile->Continuous) ? (Timeout - Elapsed) : 1);
+        }
+
+        if (Function_Error != ESP_OK)
+        {
+            Timer_Pulse_Engine_Stop();
+        }
+    }
+
+    portENTER_CRITICAL(&Engine_Lock);
+    Waiting_Task = NULL;
+    portEXIT_CRITICAL(&Engine_Lock);
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Steps_Emitted;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Queue the segments of a source the ring has room for.
+ *
+ * @param Source Segment source of the stream.
+ * @param Context Argument of the source.
+ * @param Pending Segment taken from the source that did not fit the ring yet, Steps 0 if none.
+ * @return true once the source is exhausted and every segment is queued.
+ */
+static bool Push_Source(Timer_Pulse_Engine_Source_t Source, void *Context, Segment_Ring_Item_t *Pending)
+{
+    while (true)
+    {
+        if ((Pending->Steps == 0) && !Source(Context, &Pending->Period_Q16, &Pending->Steps))
+        {
+            return true;
+        }
+
+        if ((Pending->Steps > 0) && (Pending->Steps != SEGMENT_RING_HOLD) && !Segment_Ring_Push(&Ring, Pending->Period_Q16, Pending->Steps))
+        {
+            return false; // Ring full, the segment is kept for the next call
+        }
+
+        Pending->Steps = 0;
+    }
+}
+
+/**
+ * @brief Emit segments pulled from a source and wait for the last step.
+ *
+ * The segments go from the source into the ring without an intermediate
+ * buffer, so a source reading memory mapped flash streams a trajectory of
+ * any length. The source is called from the calling task only, once per
+ * RTOS tick while the ring has room. On a stop request the segments not
+ * emitted yet are replaced by a decel ramp from the current period like in
+ * Timer_Pulse_Engine_Run(), the source is not called any more.
+ *
+ * @param Source Returns the next segment, Period_Q16 in ticks of TIMER_PULSE_ENGINE_TICK_HZ,
+ *               false once exhausted. Segments with 0 steps are skipped.
+ * @param Context Argument of the source.
+ * @param Timeout Longest time to wait for the stream to end.
+ * @param Abort_Requested Flag set by Timer_Pulse_Engine_Abort() callers, checked before starting.
+ * @param Stop_Deceleration Deceleration of a stop request in steps/s^2, 0 if none, read atomically.
+ * @param Executed_Steps Returns the number of steps emitted, may be NULL.
+ * @return ESP_OK if successful, ESP_FAIL if the ring ran empty before the
+ *         source was exhausted, ESP_ERR_TIMEOUT if the stream did not end
+ *         in time, or the error of the failing timer call.
+ */
+esp_err_t Timer_Pulse_Engine_Stream(Timer_Pulse_Engine_Source_t Source, void *Context, TickType_t Timeout, const volatile bool *Abort_Requested, const uint32_t *Stop_Deceleration, uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = ESP_OK;
+    Segment_Ring_Item_t Pending = {0};
+    uint32_t Notified = 0;
+    const Motion_Profile_t *Stop_Profile = NULL; // Decel ramp queued instead of the source after a stop
+    uint16_t Segment_Index = 0;                  // Next segment of the decel ramp to queue
+    uint32_t Stop_Taken = 0;                     // Deceleration of the decel ramp being emitted, 0 before a stop
+
+    if (Running)
+    {
+        Function_Error += Timer_Pulse_Engine_Stop(); // A held frequency is replaced by the stream
+    }
+
+    Reset_Output(xTaskGetCurrentTaskHandle());
+
+    xTaskNotifyWait(0, ULONG_MAX, NULL, 0); // Drop events left over from an earlier move
+
+    bool Queued = Push_Source(Source, Context, &Pending);
+
+    if ((Segment_Ring_Count(&Ring) > 0) && !(*Abort_Requested) && (Function_Error == ESP_OK))
+    {
+        TickType_t Start_Ticks = xTaskGetTickCount();
+
+        Function_Error += Start_Output();
+
+        MOTION_TRACE(MOTION_TRACE_PULSE_START, 0);
+
+        while (Function_Error == ESP_OK)
+        {
+            uint32_t Deceleration = __atomic_load_n(Stop_Deceleration, __ATOMIC_ACQUIRE);
+
+            if (Deceleration > Stop_Taken)
+            {
+                Motion_Profile_t *Next_Profile = (Stop_Profile == &Stop_Profiles[0]) ? &Stop_Profiles[1] : &Stop_Profiles[0]; // Not the one being queued
+                uint32_t Start_Steps = 0;
+
+                Stop_Taken = Deceleration;
+
+                if (Begin_Stop(Deceleration, UINT32_MAX, Next_Profile, &Segment_Index, &Start_Steps)) // The steps left in the source are not known
+                {
+                    Stop_Profile = Next_Profile;
+                    Start_Ticks = xTaskGetTickCount();
+                    Timeout = pdMS_TO_TICKS((Stop_Profile->Duration_us / 1000) + MOTION_TIMEOUT_MARGIN_MS);
+                }
+            }
+
+            if (Stop_Profile != NULL)
+            {
+                Queued = Push_Segments(Stop_Profile, &Segment_Index); // The source is left where the stop found it
+            }
+            else if (!Queued)
+            {
+                Queued = Push_Source(Source, Context, &Pending);
+            }
+
+            if ((Notified & TIMER_PULSE_ENGINE_NOTIFY_DONE) != 0)
+            {
+                Function_Error = (Queued || Abort_Pending) ? ESP_OK : ESP_FAIL; // The interrupt ran out of segments before the source was exhausted
+                break;
+            }
+
+            TickType_t Elapsed = xTaskGetTickCount() - Start_Ticks;
+
+            if (Elapsed >= Timeout)
+            {
+                Function_Error = ESP_ERR_TIMEOUT;
+                break;
+            }
+
+            // Wake every tick while the source has segments left, a stop request wakes up at once
+            xTaskNotifyWait(0, ULONG_MAX, &Notified, Queued ? (Timeout - Elapsed) : 1);
+        }
+
+        if (Function_Error != ESP_OK)
+        {
+            Timer_Pulse_Engine_Stop();
+        }
+    }
+
+    portENTER_CRITICAL(&Engine_Lock);
+    Waiting_Task = NULL;
+    portEXIT_CRITICAL(&Engine_Lock);
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Steps_Emitted;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Run the step pulses continuously at a frequency, used by the jog mode.
+ *
+ * A running output takes the new frequency at its next step.
+ *
+ * @param Frequency_Hz Step frequency, not 0.
+ * @return
+ *     - Sum of all ESP return values, ESP_ERR_NO_MEM if the ring is full
+ */
+esp_err_t Timer_Pulse_Engine_Hold(uint32_t Frequency_Hz)
+{
+    if (Running)
+    {
+        return Segment_Ring_Push(&Ring, Period_Q16(Frequency_Hz), SEGMENT_RING_HOLD) ? ESP_OK : ESP_ERR_NO_MEM;
+    }
+
+    Reset_Output(NULL);
+
+    Segment_Ring_Push(&Ring, Period_Q16(Frequency_Hz), SEGMENT_RING_HOLD);
+
+    return Start_Output();
+}
+
+/**
+ * @brief Wake the task waiting in Timer_Pulse_Engine_Run() for a stop request.
+ *
+ * Safe to call from any task, from both cores and from interrupts. The
+ * deceleration is read from the flag given to Timer_Pulse_Engine_Run(),
+ * which has to be set before.
+ */
+void Timer_Pulse_Engine_Request_Stop(void)
+{
+    portENTER_CRITICAL_SAFE(&Engine_Lock);
+    TaskHandle_t Task = Waiting_Task;
+    portEXIT_CRITICAL_SAFE(&Engine_Lock);
+
+    if (Task == NULL)
+    {
+        return; // Nothing running, or a held output ramped down by its owner
+    }
+
+    if (xPortInIsrContext())
+    {
+        BaseType_t Woken = pdFALSE;
+
+        xTaskNotifyFromISR(Task, MOTION_NOTIFY_STOP, eSetBits, &Woken);
+
+        if (Woken == pdTRUE)
+        {
+            portYIELD_FROM_ISR();
+        }
+    }
+    else
+    {
+        xTaskNotify(Task, MOTION_NOTIFY_STOP, eSetBits);
+    }
+}
+
+/**
+ * @brief End the output at its next step.
+ *
+ * Safe to call from any task, from both cores and from interrupts. A task
+ * waiting in Timer_Pulse_Engine_Run() is woken once the output stopped.
+ */
+void Timer_Pulse_Engine_Abort(void)
+{
+    Abort_Pending = true;
+}
+
+/**
+ * @brief Stop the step pulses immediately and leave the pulse pin low.
+ *
+ * @return
+ *     - Sum of all ESP return values
+ */
+esp_err_t Timer_Pulse_Engine_Stop(void)
+{
+    esp_err_t Function_Error = timer_pause(TIMER_PULSE_ENGINE_GROUP, TIMER_PULSE_ENGINE_IDX);
+
+    portENTER_CRITICAL(&Engine_Lock);
+    Running = false; // A pending alarm finds the output stopped
+    Holding = false;
+    Segment_Ring_Drain(&Ring);
+    Segment.Steps = 0;
+    GPIO.out_w1tc = TIMER_PULSE_ENGINE_PUL_MASK;
+    portEXIT_CRITICAL(&Engine_Lock);
+
+    return Function_Error;
+}
+
+/**
+ * @brief Copy the latency histogram of the step timer interrupt.
+ *
+ * @param Latency Returns the statistics since the last reset.
+ */
+void Timer_Pulse_Engine_Get_Latency(Timer_Pulse_Engine_Latency_t *Latency)
+{
+    portENTER_CRITICAL(&Engine_Lock);
+    *Latency = Latency_Stats;
+    portEXIT_CRITICAL(&Engine_Lock);
+}
+
+/**
+ * @brief Clear the latency histogram of the step timer interrupt.
+ */
+void Timer_Pulse_Engine_Reset_Latency(void)
+{
+    portENTER_CRITICAL(&Engine_Lock);
+    memset(&Latency_Stats, 0, sizeof(Latency_Stats));
+    portEXIT_CRITICAL(&Engine_Lock);
+}
@@ -0,0 +1,70 @@
+/*H**********************************************************************
+ * FILENAME :        timer_pulse_engine.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Timer interrupt based pulse engine for the stepper motor example,
+ *       running on the APP CPU.
+ *
+ * NOTES :
+ *       The step timer interrupt is placed in IRAM and allocated on
+ *       TIMER_PULSE_ENGINE_CORE, away from the console, the UART and the
+ *       WiFi stack on the PRO CPU. It takes its step segments from a
+ *       lock-free ring, see segment_ring.h, which the motion task tops up
+ *       while the move runs, so no lock is shared with the console side.
+ *
+ *       The interrupt reads the step timer at its entry. The timer reloads
+ *       at every alarm, so the value is the latency from the alarm to the
+ *       handler, collected in a histogram for the jitter measurement.
+ *       Selected with STEPPER_PULSE_ENGINE in main.h, LEDC is the default.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef TIMER_PULSE_ENGINE_H
+#define TIMER_PULSE_ENGINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "driver/timer.h"
+#include "motion_planner.h"
+
+#define TIMER_PULSE_ENGINE_GROUP TIMER_GROUP_1                                                                      // Timer group of the step timer, group 0 runs the multi-axis moves
+#define TIMER_PULSE_ENGINE_IDX TIMER_0                                                                              // Step timer
+#define TIMER_PULSE_ENGINE_CORE 1                                                                                   // APP CPU, the interrupt is allocated there
+#define TIMER_PULSE_ENGINE_DIVIDER 8                                                                                // 80 MHz APB clock / 8 = 10 MHz tick
+#define TIMER_PULSE_ENGINE_TICK_HZ (TIMER_BASE_CLK / TIMER_PULSE_ENGINE_DIVIDER)                                    // Tick rate of the step timer
+#define TIMER_PULSE_ENGINE_HIGH_TICKS 40                                                                            // Step pulse high time, 4 us
+#define TIMER_PULSE_ENGINE_MIN_ALARM_TICKS 40                                                                       // Shortest timer interval the interrupt can keep up with
+#define TIMER_PULSE_ENGINE_MAX_FREQUENCY_HZ (TIMER_PULSE_ENGINE_TICK_HZ / (2 * TIMER_PULSE_ENGINE_MIN_ALARM_TICKS)) // Highest step rate
+#define TIMER_PULSE_ENGINE_NOTIFY_DONE 0x10                                                                         // Task notification bit: the step output stopped
+#define TIMER_PULSE_ENGINE_SETUP_STACK_SIZE 2048                                                                    // Stack size of the task allocating the interrupt in bytes
+#define TIMER_PULSE_ENGINE_LATENCY_BINS 16                                                                          // Power of two latency bins, the last one is open ended
+
+/** Segment source of Timer_Pulse_Engine_Stream(), returns false once exhausted */
+typedef bool (*Timer_Pulse_Engine_Source_t)(void *Context, uint64_t *Period_Q16, uint32_t *Steps);
+
+/** Alarm to interrupt latency of the step timer */
+typedef struct
+{
+    uint32_t Count;                                 // Interrupts measured
+    uint32_t Min_Ticks;                             // Shortest latency
+    uint32_t Max_Ticks;                             // Longest latency
+    uint64_t Sum_Ticks;                             // Sum of all latencies
+    uint32_t Bins[TIMER_PULSE_ENGINE_LATENCY_BINS]; // Bin N counts latencies from 2^N to 2^(N+1) - 1 ticks, bin 0 also 0 ticks
+} Timer_Pulse_Engine_Latency_t;
+
+esp_err_t Initialize_Timer_Pulse_Engine(void);
+esp_err_t Timer_Pulse_Engine_Run(const Motion_Profile_t *Profile, TickType_t Timeout, const volatile bool *Abort_Requested, const uint32_t *Stop_Deceleration, uint32_t *Executed_Steps);
+esp_err_t Timer_Pulse_Engine_Stream(Timer_Pulse_Engine_Source_t Source, void *Context, TickType_t Timeout, const volatile bool *Abort_Requested, const uint32_t *Stop_Deceleration, uint32_t *Executed_Steps);
+esp_err_t Timer_Pulse_Engine_Hold(uint32_t Frequency_Hz);
+void Timer_Pulse_Engine_Request_Stop(void);
+void Timer_Pulse_Engine_Abort(void);
+esp_err_t Timer_Pulse_Engine_Stop(void);
+void Timer_Pulse_Engine_Get_Latency(Timer_Pulse_Engine_Latency_t *Latency);
+void Timer_Pulse_Engine_Reset_Latency(void);
+
+#endif // TIMER_PULSE_ENGINE_H
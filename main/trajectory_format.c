@@ -0,0 +1,351 @@
+/*H**********************************************************************
+ * FILENAME :        trajectory_format.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent binary format of precompiled trajectories, a
+ *       header followed by step segments, with its writer and its decoder.
+ *
+ * NOTES :
+ *       The writer merges a segment into the previous record if both have
+ *       the same direction and period, so cruise phases split by the
+ *       planner take one record. Trajectory_Open() checks everything the
+ *       player relies on once, Trajectory_Decode() then only unpacks.
+ *
+ *       The CRC-32 is the one of zlib and Ethernet, computed with a 16
+ *       entry table so the decoder stays small in flash.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include <string.h>
+#include "trajectory_format.h"
+
+#define TRAJECTORY_HEADER_CRC_BYTES offsetof(Trajectory_Header_t, Header_Crc32) // Header bytes covered by Header_Crc32
+
+/** CRC-32 of every nibble value, reflected polynomial 0xEDB88320 */
+static const uint32_t Crc32_Table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+/**
+ * @brief Continue a CRC-32 over more data.
+ *
+ * @param Crc CRC of the data before, 0 to start.
+ * @param Data Data to add.
+ * @param Length Bytes of the data.
+ * @return CRC of all data so far.
+ */
+uint32_t Trajectory_Crc32(uint32_t Crc, const void *Data, size_t Length)
+{
+    const uint8_t *Byte = Data;
+
+    Crc = ~Crc;
+
+    for (size_t Index = 0; Index < Length; Index++)
+    {
+        Crc ^= Byte[Index];
+        Crc = (Crc >> 4) ^ Crc32_Table[Crc & 0x0F];
+        Crc = (Crc >> 4) ^ Crc32_Table[Crc & 0x0F];
+    }
+
+    return ~Crc;
+}
+
+/**
+ * @brief Start a trajectory in a buffer.
+ *
+ * @param Writer Writer state.
+ * @param Buffer Output, 4 byte aligned.
+ * @param Capacity Bytes of the buffer.
+ * @param Tick_Hz Tick rate of the pulse engine that plays the trajectory.
+ */
+void Trajectory_Begin(Trajectory_Writer_t *Writer, void *Buffer, size_t Capacity, uint32_t Tick_Hz)
+{
+    memset(Writer, 0, sizeof(*Writer));
+
+    Writer->Buffer = Buffer;
+    Writer->Capacity = Capacity;
+    Writer->Header.Magic = TRAJECTORY_MAGIC;
+    Writer->Header.Version = TRAJECTORY_VERSION;
+    Writer->Header.Header_Size = sizeof(Trajectory_Header_t);
+    Writer->Header.Tick_Hz = Tick_Hz;
+    Writer->Overflow = Capacity < sizeof(Trajectory_Header_t);
+}
+
+/**
+ * @brief Last record written, NULL if there is none.
+ */
+static Trajectory_Record_t *Last_Record(Trajectory_Writer_t *Writer)
+{
+    if (Writer->Header.Record_Count == 0)
+    {
+        return NULL;
+    }
+
+    return (Trajectory_Record_t *)(Writer->Buffer + sizeof(Trajectory_Header_t)) + (Writer->Header.Record_Count - 1);
+}
+
+/**
+ * @brief Append a record, or merge it into the last one with the same period and flags.
+ *
+ * @return false if the buffer is full.
+ */
+static bool Append_Record(Trajectory_Writer_t *Writer, uint32_t Period_Q8, uint32_t Flags, uint32_t Steps)
+{
+    Trajectory_Record_t *Last = Last_Record(Writer);
+
+    if ((Last != NULL) && ((Last->Control & ~TRAJECTORY_STEPS_MASK) == Flags) && (Last->Period_Q8 == Period_Q8) &&
+        (((Last->Control & TRAJECTORY_STEPS_MASK) + (uint64_t)Steps) <= TRAJECTORY_STEPS_MASK))
+    {
+        Last->Control += Steps;
+        return true;
+    }
+
+    size_t End = sizeof(Trajectory_Header_t) + (((size_t)Writer->Header.Record_Count + 1) * sizeof(Trajectory_Record_t));
+
+    if (Writer->Overflow || (End > Writer->Capacity))
+    {
+        Writer->Overflow = true;
+        return false;
+    }
+
+    Trajectory_Record_t Record = {
+        .Period_Q8 = Period_Q8,
+        .Control = Flags | Steps,
+    };
+
+    memcpy(Writer->Buffer + End - sizeof(Record), &Record, sizeof(Record));
+    Writer->Header.Record_Count++;
+
+    return true;
+}
+
+/**
+ * @brief Append steps at a constant frequency.
+ *
+ * @param Writer Writer state.
+ * @param Forward Direction of the steps.
+ * @param Frequency_Hz Step frequency, the period has to fit 2^24 ticks.
+ * @param Steps Steps, 0 appends nothing.
+ * @return false if the frequency cannot be stored or the buffer is full.
+ */
+bool Trajectory_Add_Steps(Trajectory_Writer_t *Writer, bool Forward, uint32_t Frequency_Hz, uint32_t Steps)
+{
+    if (Steps == 0)
+    {
+        return true;
+    }
+
+    uint64_t Period_Q8 = (Frequency_Hz > 0) ? (((uint64_t)Writer->Header.Tick_Hz << 8) / Frequency_Hz) : UINT64_MAX;
+
+    if ((Period_Q8 > UINT32_MAX) || (Period_Q8 < ((uint64_t)TRAJECTORY_MIN_PERIOD_TICKS << 8)))
+    {
+        Writer->Overflow = true;
+        return false;
+    }
+
+    while (Steps > 0)
+    {
+        uint32_t Chunk = (Steps > TRAJECTORY_STEPS_MASK) ? TRAJECTORY_STEPS_MASK : Steps;
+
+        if (!Append_Record(Writer, (uint32_t)Period_Q8, Forward ? TRAJECTORY_FLAG_FORWARD : 0, Chunk))
+        {
+            return false;
+        }
+
+        Writer->Total_Steps += Chunk;
+        Writer->Duration_Q8 += Period_Q8 * Chunk;
+        Steps -= Chunk;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Append a pause with the motor standing still.
+ *
+ * @param Writer Writer state.
+ * @param Pause_us Duration, 0 appends nothing.
+ * @return false if the buffer is full.
+ */
+bool Trajectory_Add_Pause(Trajectory_Writer_t *Writer, uint32_t Pause_us)
+{
+    if (Pause_us == 0)
+    {
+        return true;
+    }
+
+    Trajectory_Record_t *Last = Last_Record(Writer);
+
+    if ((Last != NULL) && (Last->Control == TRAJECTORY_FLAG_PAUSE) && ((Last->Period_Q8 + (uint64_t)Pause_us) <= UINT32_MAX))
+    {
+        Last->Period_Q8 += Pause_us; // Pauses add up
+    }
+    else if (!Append_Record(Writer, Pause_us, TRAJECTORY_FLAG_PAUSE, 0))
+    {
+        return false;
+    }
+
+    Writer->Pause_us += Pause_us;
+
+    return true;
+}
+
+/**
+ * @brief Complete the header with the totals and the CRCs.
+ *
+ * @return Bytes of the trajectory, 0 if a record did not fit or the totals do not fit the header.
+ */
+size_t Trajectory_Finish(Trajectory_Writer_t *Writer)
+{
+    Trajectory_Header_t *Header = &Writer->Header;
+    uint64_t Ticks = Writer->Duration_Q8 >> 8;
+    uint64_t Duration_ms = ((Ticks / Header->Tick_Hz) * 1000) + (((Ticks % Header->Tick_Hz) * 1000) / Header->Tick_Hz) + (Writer->Pause_us / 1000);
+    size_t Records_Size = (size_t)Header->Record_Count * sizeof(Trajectory_Record_t);
+
+    if (Writer->Overflow || (Writer->Total_Steps > UINT32_MAX) || (Duration_ms > UINT32_MAX))
+    {
+        return 0;
+    }
+
+    Header->Total_Steps = (uint32_t)Writer->Total_Steps;
+    Header->Duration_ms = (uint32_t)Duration_ms;
+    Header->Records_Crc32 = Trajectory_Crc32(0, Writer->Buffer + sizeof(Trajectory_Header_t), Records_Size);
+    Header->Header_Crc32 = Trajectory_Crc32(0, Header, TRAJECTORY_HEADER_CRC_BYTES);
+
+    memcpy(Writer->Buffer, Header, sizeof(*Header));
+
+    return sizeof(Trajectory_Header_t) + Records_Size;
+}
+
+/**
+ * @brief Check a trajectory in place and point a view at it.
+ *
+ * Nothing is copied, the view points into Data, which has to stay mapped
+ * while the view is used.
+ *
+ * @param Data Trajectory, 4 byte aligned, e.g. memory mapped flash.
+ * @param Size Bytes available at Data, may be more than the trajectory.
+ * @param View Returns the header and the records.
+ * @return TRAJECTORY_OK or what is wrong with the trajectory.
+ */
+Trajectory_Result_t Trajectory_Open(const void *Data, size_t Size, Trajectory_View_t *View)
+{
+    const Trajectory_Header_t *Header = Data;
+
+    if (Size < sizeof(Trajectory_Header_t))
+    {
+        return TRAJECTORY_TOO_SMALL;
+    }
+
+    if (Header->Magic != TRAJECTORY_MAGIC)
+    {
+        return TRAJECTORY_BAD_MAGIC;
+    }
+
+    if (Header->Version != TRAJECTORY_VERSION)
+    {
+        return TRAJECTORY_BAD_VERSION;
+    }
+
+    if ((Trajectory_Crc32(0, Header, TRAJECTORY_HEADER_CRC_BYTES) != Header->Header_Crc32) ||
+        (Header->Header_Size < sizeof(Trajectory_Header_t)) || ((Header->Header_Size % sizeof(uint32_t)) != 0) || (Header->Tick_Hz == 0))
+    {
+        return TRAJECTORY_BAD_HEADER_CRC;
+    }
+
+    uint64_t Records_Size = (uint64_t)Header->Record_Count * sizeof(Trajectory_Record_t);
+
+    if ((Header->Header_Size + Records_Size) > Size)
+    {
+        return TRAJECTORY_TOO_SMALL;
+    }
+
+    const Trajectory_Record_t *Records = (const Trajectory_Record_t *)((const uint8_t *)Data + Header->Header_Size);
+
+    if (Trajectory_Crc32(0, Records, (size_t)Records_Size) != Header->Records_Crc32)
+    {
+        return TRAJECTORY_BAD_RECORD_CRC;
+    }
+
+    uint64_t Total_Steps = 0;
+
+    for (uint32_t Index = 0; Index < Header->Record_Count; Index++)
+    {
+        uint32_t Steps = Records[Index].Control & TRAJECTORY_STEPS_MASK;
+
+        if ((Records[Index].Control & TRAJECTORY_FLAG_PAUSE) != 0)
+        {
+            if (Steps != 0)
+            {
+                return TRAJECTORY_BAD_RECORD;
+            }
+        }
+        else if ((Steps == 0) || (Records[Index].Period_Q8 < (TRAJECTORY_MIN_PERIOD_TICKS << 8)))
+        {
+            return TRAJECTORY_BAD_RECORD;
+        }
+
+        Total_Steps += Steps;
+    }
+
+    if (Total_Steps != Header->Total_Steps)
+    {
+        return TRAJECTORY_BAD_TOTAL;
+    }
+
+    View->Header = Header;
+    View->Records = Records;
+
+    return TRAJECTORY_OK;
+}
+
+/**
+ * @brief Unpack one record of an opened trajectory.
+ *
+ * @param View Trajectory from Trajectory_Open().
+ * @param Index Record, below Header->Record_Count.
+ * @param Segment Returns the decoded segment.
+ */
+void Trajectory_Decode(const Trajectory_View_t *View, uint32_t Index, Trajectory_Segment_t *Segment)
+{
+    Trajectory_Record_t Record = View->Records[Index];
+
+    Segment->Pause = (Record.Control & TRAJECTORY_FLAG_PAUSE) != 0;
+    Segment->Forward = (Record.Control & TRAJECTORY_FLAG_FORWARD) != 0;
+    Segment->Steps = Record.Control & TRAJECTORY_STEPS_MASK;
+    Segment->Period_Q16 = Segment->Pause ? 0 : ((uint64_t)Record.Period_Q8 << 8);
+    Segment->Pause_us = Segment->Pause ? Record.Period_Q8 : 0;
+}
+
+/**
+ * @brief Name of a decoding result, for messages.
+ */
+const char *Trajectory_Result_Name(Trajectory_Result_t Result)
+{
+    switch (Result)
+    {
+    case TRAJECTORY_OK:
+        return "ok";
+    case TRAJECTORY_TOO_SMALL:
+        return "truncated";
+    case TRAJECTORY_BAD_MAGIC:
+        return "no trajectory";
+    case TRAJECTORY_BAD_VERSION:
+        return "unsupported version";
+    case TRAJECTORY_BAD_HEADER_CRC:
+        return "header damaged";
+    case TRAJECTORY_BAD_RECORD_CRC:
+        return "records damaged";
+    case TRAJECTORY_BAD_RECORD:
+        return "invalid record";
+    case TRAJECTORY_BAD_TOTAL:
+        return "step total mismatch";
+    default:
+        return "?";
+    }
+}
@@ -0,0 +1,115 @@
+/*H**********************************************************************
+ * FILENAME :        trajectory_format.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent binary format of precompiled trajectories, a
+ *       header followed by step segments, with its writer and its decoder.
+ *
+ * NOTES :
+ *       A trajectory is compiled on the host, see host/trajectory_compiler.c,
+ *       and written to the trajectory partition. The device decodes the
+ *       records in place, straight from memory mapped flash, so the layout
+ *       is fixed: little endian, as both the host and the ESP32 store it,
+ *       with explicit sizes and no padding.
+ *
+ *       Every record is one segment of steps at a constant period in Q8
+ *       fractions of a tick of Tick_Hz, the tick of the pulse engine, so
+ *       the device only shifts it. A pause record holds the motor for a
+ *       time instead. The header and the records carry their own CRC-32.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef TRAJECTORY_FORMAT_H
+#define TRAJECTORY_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TRAJECTORY_MAGIC 0x4A525453u        // "STRJ" in little endian
+#define TRAJECTORY_VERSION 1                // Version of the layout below
+#define TRAJECTORY_STEPS_MASK 0x3FFFFFFFu   // Steps of a record, bits 0 to 29
+#define TRAJECTORY_FLAG_PAUSE 0x40000000u   // Record holds the motor for Period_Q8 us instead of stepping
+#define TRAJECTORY_FLAG_FORWARD 0x80000000u // Steps go in MOTOR_DIRECTION_FORWARD
+#define TRAJECTORY_MIN_PERIOD_TICKS 2       // Shortest step period the format accepts, the engine has its own limit
+
+/** File header, records follow at Header_Size */
+typedef struct
+{
+    uint32_t Magic;         // TRAJECTORY_MAGIC
+    uint16_t Version;       // TRAJECTORY_VERSION
+    uint16_t Header_Size;   // sizeof(Trajectory_Header_t) of the writer
+    uint32_t Tick_Hz;       // Tick rate the periods are given in
+    uint32_t Record_Count;  // Records after the header
+    uint32_t Total_Steps;   // Steps of all records
+    uint32_t Duration_ms;   // Duration of all records, pauses included
+    uint32_t Records_Crc32; // CRC-32 of all records
+    uint32_t Header_Crc32;  // CRC-32 of the header up to this field
+} Trajectory_Header_t;
+
+/** One segment, 8 bytes */
+typedef struct
+{
+    uint32_t Period_Q8; // Step period in 1/256 ticks, or the pause in us
+    uint32_t Control;   // Steps in TRAJECTORY_STEPS_MASK, TRAJECTORY_FLAG_PAUSE, TRAJECTORY_FLAG_FORWARD
+} Trajectory_Record_t;
+
+_Static_assert(sizeof(Trajectory_Header_t) == 32, "The trajectory header layout is fixed");
+_Static_assert(sizeof(Trajectory_Record_t) == 8, "The trajectory record layout is fixed");
+
+/** Result of decoding a trajectory */
+typedef enum
+{
+    TRAJECTORY_OK = 0,         // Valid
+    TRAJECTORY_TOO_SMALL,      // Shorter than the header or the records it announces
+    TRAJECTORY_BAD_MAGIC,      // No trajectory, e.g. an erased partition
+    TRAJECTORY_BAD_VERSION,    // Written for another layout
+    TRAJECTORY_BAD_HEADER_CRC, // Header damaged
+    TRAJECTORY_BAD_RECORD_CRC, // Records damaged
+    TRAJECTORY_BAD_RECORD,     // A record with 0 steps or a period below TRAJECTORY_MIN_PERIOD_TICKS
+    TRAJECTORY_BAD_TOTAL,      // Steps of the records differ from Total_Steps
+} Trajectory_Result_t;
+
+/** Decoded trajectory, pointing into the memory it was decoded from */
+typedef struct
+{
+    const Trajectory_Header_t *Header;  // Header
+    const Trajectory_Record_t *Records; // First of Header->Record_Count records
+} Trajectory_View_t;
+
+/** One decoded segment */
+typedef struct
+{
+    bool Pause;          // Hold the motor for Pause_us, no steps
+    bool Forward;        // Direction of the steps
+    uint32_t Steps;      // Steps of the segment
+    uint64_t Period_Q16; // Step period in Q16 ticks
+    uint32_t Pause_us;   // Duration of a pause
+} Trajectory_Segment_t;
+
+/** Writer building a trajectory in a caller buffer */
+typedef struct
+{
+    uint8_t *Buffer;            // Output, the header first
+    size_t Capacity;            // Bytes of the buffer
+    Trajectory_Header_t Header; // Header filled in by Trajectory_Finish()
+    uint64_t Total_Steps;       // Steps written so far
+    uint64_t Duration_Q8;       // Ticks written so far, in Q8
+    uint64_t Pause_us;          // Pause time written so far
+    bool Overflow;              // A record did not fit, or the totals overflowed the header
+} Trajectory_Writer_t;
+
+uint32_t Trajectory_Crc32(uint32_t Crc, const void *Data, size_t Length);
+void Trajectory_Begin(Trajectory_Writer_t *Writer, void *Buffer, size_t Capacity, uint32_t Tick_Hz);
+bool Trajectory_Add_Steps(Trajectory_Writer_t *Writer, bool Forward, uint32_t Frequency_Hz, uint32_t Steps);
+bool Trajectory_Add_Pause(Trajectory_Writer_t *Writer, uint32_t Pause_us);
+size_t Trajectory_Finish(Trajectory_Writer_t *Writer);
+Trajectory_Result_t Trajectory_Open(const void *Data, size_t Size, Trajectory_View_t *View);
+void Trajectory_Decode(const Trajectory_View_t *View, uint32_t Index, Trajectory_Segment_t *Segment);
+const char *Trajectory_Result_Name(Trajectory_Result_t Result);
+
+#endif // TRAJECTORY_FORMAT_H
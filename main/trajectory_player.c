@@ -0,0 +1,179 @@
+/*H**********************************************************************
+ * FILENAME :        trajectory_player.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Playback of the precompiled trajectory in the trajectory flash
+ *       partition on the single axis motor.
+ *
+ * NOTES :
+ *       The partition stays mapped for the whole run time, the view of
+ *       Trajectory_Open() points into the flash cache. The image is checked
+ *       once when attached, including the limits of the timer pulse
+ *       engine, so a play never stops on a record it cannot emit.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "trajectory_player.h"
+#include "main.h"
+#include "esp_timer.h"
+#ifndef STEPPER_HOST_SIM // The host simulator attaches an image read from a host file
+#include "esp_partition.h"
+#endif
+
+#define TRAJECTORY_PLAYER_MIN_PERIOD_Q8 ((2 * TIMER_PULSE_ENGINE_MIN_ALARM_TICKS) << 8) // Shortest step period the timer pulse engine emits
+
+static Trajectory_View_t View;                                              // Attached trajectory, valid if Player_Info.State is ESP_OK
+static Trajectory_Player_Info_t Player_Info = {.State = ESP_ERR_NOT_FOUND}; // Attached trajectory and playback counters
+static portMUX_TYPE Player_Lock = portMUX_INITIALIZER_UNLOCKED;             // Keeps Player_Info consistent for readers on the other core
+
+/**
+ * @brief Map the trajectory partition and attach it.
+ *
+ * Without a trajectory partition, or with an empty or damaged one, the
+ * motor control runs without a trajectory.
+ *
+ * @return
+ *     - ESP_OK: Attached, or no playable trajectory
+ *     - Error of esp_partition_mmap() otherwise
+ */
+esp_err_t Initialize_Trajectory_Player(void)
+{
+    esp_err_t Function_Error = ESP_OK;
+
+#ifndef STEPPER_HOST_SIM
+    const esp_partition_t *Partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, TRAJECTORY_PLAYER_SUBTYPE, TRAJECTORY_PLAYER_PARTITION);
+    const void *Image = NULL;
+    spi_flash_mmap_handle_t Handle; // Never unmapped
+
+    if (Partition == NULL)
+    {
+        printf("Trajectory: no '%s' partition, trajectories are not available\n", TRAJECTORY_PLAYER_PARTITION);
+
+        return ESP_OK;
+    }
+
+    Function_Error = esp_partition_mmap(Partition, 0, Partition->size, SPI_FLASH_MMAP_DATA, &Image, &Handle);
+
+    if (Function_Error == ESP_OK)
+    {
+        esp_err_t Attach_Error = Trajectory_Player_Attach(Image, Partition->size);
+
+        if (Attach_Error != ESP_OK)
+        {
+            printf("Trajectory: '%s', %s\n", TRAJECTORY_PLAYER_PARTITION, (Player_Info.Result != TRAJECTORY_OK) ? Trajectory_Result_Name(Player_Info.Result) : "beyond the timer pulse engine");
+        }
+    }
+#endif
+
+    return Function_Error;
+}
+
+/**
+ * @brief Check a trajectory image and make it the one played.
+ *
+ * The image is not copied, it has to stay mapped.
+ *
+ * @param Image Trajectory, 4 byte aligned.
+ * @param Size Bytes of the image, may be more than the trajectory.
+ * @return
+ *     - ESP_OK: Attached
+ *     - ESP_ERR_INVALID_ARG: No valid trajectory, see Trajectory_Player_Info_t.Result
+ *     - ESP_ERR_NOT_SUPPORTED: Valid, but for another tick rate or faster than the timer pulse engine
+ */
+esp_err_t Trajectory_Player_Attach(const void *Image, size_t Size)
+{
+    Trajectory_View_t Opened;
+    Trajectory_Player_Info_t Attached = {
+        .Image_Size = Size,
+        .Result = Trajectory_Open(Image, Size, &Opened),
+        .State = ESP_ERR_INVALID_ARG,
+        .Last_Error = ESP_ERR_NOT_FOUND, // Not played yet
+    };
+
+    if (Attached.Result == TRAJECTORY_OK)
+    {
+        Attached.Version = Opened.Header->Version;
+        Attached.Tick_Hz = Opened.Header->Tick_Hz;
+        Attached.Record_Count = Opened.Header->Record_Count;
+        Attached.Total_Steps = Opened.Header->Total_Steps;
+        Attached.Duration_ms = Opened.Header->Duration_ms;
+        Attached.State = ESP_OK;
+
+        for (uint32_t Index = 0; Index < Opened.Header->Record_Count; Index++)
+        {
+            const Trajectory_Record_t *Record = &Opened.Records[Index];
+
+            if (((Record->Control & TRAJECTORY_FLAG_PAUSE) == 0) && ((Attached.Min_Period_Q8 == 0) || (Record->Period_Q8 < Attached.Min_Period_Q8)))
+            {
+                Attached.Min_Period_Q8 = Record->Period_Q8;
+            }
+        }
+
+        if ((Attached.Tick_Hz != TIMER_PULSE_ENGINE_TICK_HZ) || ((Attached.Min_Period_Q8 != 0) && (Attached.Min_Period_Q8 < TRAJECTORY_PLAYER_MIN_PERIOD_Q8)))
+        {
+            Attached.State = ESP_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    portENTER_CRITICAL(&Player_Lock);
+    View = Opened;
+    Player_Info = Attached;
+    portEXIT_CRITICAL(&Player_Lock);
+
+    return Attached.State;
+}
+
+/**
+ * @brief Play the attached trajectory once.
+ *
+ * Runs in the task that executes the motion and blocks until the last
+ * step. The play is timed and counted in the player info.
+ *
+ * @param Executed_Steps Returns the steps emitted, may be NULL.
+ * @return
+ *     - ESP_ERR_NOT_FOUND: No playable trajectory attached
+ *     - Result of Run_Stepper_Motor_Trajectory() otherwise
+ */
+esp_err_t Trajectory_Player_Run(uint32_t *Executed_Steps)
+{
+    esp_err_t Function_Error = (Player_Info.State == ESP_OK) ? ESP_OK : ESP_ERR_NOT_FOUND;
+    uint32_t Steps = 0;
+
+    if (Function_Error == ESP_OK)
+    {
+        int64_t Start_us = esp_timer_get_time();
+
+        Function_Error = Run_Stepper_Motor_Trajectory(&View, &Steps);
+
+        uint64_t Play_us = (uint64_t)(esp_timer_get_time() - Start_us);
+
+        portENTER_CRITICAL(&Player_Lock);
+        Player_Info.Plays += (Function_Error == ESP_OK) ? 1 : 0;
+        Player_Info.Failed_Plays += (Function_Error == ESP_OK) ? 0 : 1;
+        Player_Info.Last_Executed_Steps = Steps;
+        Player_Info.Last_Play_us = Play_us;
+        Player_Info.Last_Error = Function_Error;
+        portEXIT_CRITICAL(&Player_Lock);
+    }
+
+    if (Executed_Steps != NULL)
+    {
+        *Executed_Steps = Steps;
+    }
+
+    return Function_Error;
+}
+
+/**
+ * @brief Copy the state of the attached trajectory and its playback.
+ */
+void Trajectory_Player_Get_Info(Trajectory_Player_Info_t *Info)
+{
+    portENTER_CRITICAL(&Player_Lock);
+    *Info = Player_Info;
+    portEXIT_CRITICAL(&Player_Lock);
+}
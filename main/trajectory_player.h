@@ -0,0 +1,60 @@
+/*H**********************************************************************
+ * FILENAME :        trajectory_player.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Playback of the precompiled trajectory in the trajectory flash
+ *       partition on the single axis motor.
+ *
+ * NOTES :
+ *       The partition TRAJECTORY_PLAYER_PARTITION is memory mapped once at
+ *       start-up and checked with Trajectory_Open(). The records are then
+ *       read in place by the pulse engine feed, no part of the trajectory
+ *       is copied into RAM. Write a trajectory from host/trajectory_compiler
+ *       with
+ *         parttool.py write_partition --partition-name trajectory --input file.bin
+ *
+ *       Playback needs the timer pulse engine, see STEPPER_PULSE_ENGINE.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef TRAJECTORY_PLAYER_H
+#define TRAJECTORY_PLAYER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "trajectory_format.h"
+
+#define TRAJECTORY_PLAYER_PARTITION "trajectory" // Label of the trajectory partition, see partitions.csv
+#define TRAJECTORY_PLAYER_SUBTYPE 0x40           // Data subtype of the partition, in the custom range
+
+/** State of the mapped trajectory and its playback */
+typedef struct
+{
+    size_t Image_Size;            // Bytes mapped, the whole partition
+    Trajectory_Result_t Result;   // Result of Trajectory_Open() on the image
+    esp_err_t State;              // ESP_OK if playable, see Trajectory_Player_Attach()
+    uint16_t Version;             // Format version of the trajectory
+    uint32_t Tick_Hz;             // Tick rate of its periods
+    uint32_t Record_Count;        // Records of the trajectory
+    uint32_t Total_Steps;         // Steps of all records
+    uint32_t Duration_ms;         // Planned duration, pauses included
+    uint32_t Min_Period_Q8;       // Shortest step period in Q8 ticks, 0 without steps
+    uint32_t Plays;               // Complete plays
+    uint32_t Failed_Plays;        // Plays ended by an error, a stop or an abort
+    uint32_t Last_Executed_Steps; // Steps emitted by the last play
+    uint64_t Last_Play_us;        // Time of the last play
+    esp_err_t Last_Error;         // Result of the last play
+} Trajectory_Player_Info_t;
+
+esp_err_t Initialize_Trajectory_Player(void);
+esp_err_t Trajectory_Player_Attach(const void *Image, size_t Size);
+esp_err_t Trajectory_Player_Run(uint32_t *Executed_Steps);
+void Trajectory_Player_Get_Info(Trajectory_Player_Info_t *Info);
+
+#endif // TRAJECTORY_PLAYER_H
@@ -0,0 +1,102 @@
+/*H**********************************************************************
+ * FILENAME :        velocity_ramp.c             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent velocity ramp of the jog mode.
+ *
+ * NOTES :
+ *       Integer only, the velocity change is kept in millionths of a Hz
+ *       between updates so slow accelerations at short update intervals
+ *       are not rounded away.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#include "velocity_ramp.h"
+
+#define VELOCITY_RAMP_US_PER_S 1000000 // Microseconds per second
+
+/**
+ * @brief Start a ramp at the given velocity.
+ *
+ * @param Ramp Ramp to initialize.
+ * @param Velocity_Hz Signed step frequency the motor currently runs at.
+ * @param Acceleration Acceleration limit in steps/s^2.
+ * @param Min_Frequency_Hz Start/stop frequency of the motor.
+ */
+void Velocity_Ramp_Begin(Velocity_Ramp_t *Ramp, int32_t Velocity_Hz, uint32_t Acceleration, uint32_t Min_Frequency_Hz)
+{
+    Ramp->Velocity_Hz = Velocity_Hz;
+    Ramp->Acceleration = Acceleration;
+    Ramp->Min_Frequency_Hz = Min_Frequency_Hz;
+    Ramp->Remainder = 0;
+}
+
+/**
+ * @brief Move the velocity toward a target.
+ *
+ * @param Ramp Ramp to update.
+ * @param Target_Hz Signed target step frequency, targets below the start/stop frequency stop the motor.
+ * @param Elapsed_us Time since the previous update.
+ * @return The new velocity, 0 while the motor has to stand still.
+ */
+int32_t Velocity_Ramp_Update(Velocity_Ramp_t *Ramp, int32_t Target_Hz, uint32_t Elapsed_us)
+{
+    int64_t Velocity = Ramp->Velocity_Hz;
+    int64_t Goal = Target_Hz;
+
+    if (((Goal < 0) ? -Goal : Goal) < Ramp->Min_Frequency_Hz)
+    {
+        Goal = 0; // Too slow to run, stop instead
+    }
+
+    if (((Velocity > 0) && (Goal < 0)) || ((Velocity < 0) && (Goal > 0)))
+    {
+        Goal = 0; // Reversal, stop first
+    }
+
+    if (Velocity == Goal)
+    {
+        Ramp->Remainder = 0;
+
+        return Ramp->Velocity_Hz;
+    }
+
+    uint64_t Change_Scaled = ((uint64_t)Ramp->Acceleration * Elapsed_us) + Ramp->Remainder;
+    int64_t Change = (int64_t)(Change_Scaled / VELOCITY_RAMP_US_PER_S);
+
+    Ramp->Remainder = (uint32_t)(Change_Scaled % VELOCITY_RAMP_US_PER_S);
+
+    if (Velocity < Goal)
+    {
+        Velocity = ((Goal - Velocity) > Change) ? (Velocity + Change) : Goal;
+    }
+    else
+    {
+        Velocity = ((Velocity - Goal) > Change) ? (Velocity - Change) : Goal;
+    }
+
+    if ((Velocity != 0) && (((Velocity < 0) ? -Velocity : Velocity) < Ramp->Min_Frequency_Hz))
+    {
+        if (Goal == 0)
+        {
+            Velocity = 0; // Stop once below the start/stop frequency
+        }
+        else
+        {
+            Velocity = (Goal > 0) ? (int64_t)Ramp->Min_Frequency_Hz : -(int64_t)Ramp->Min_Frequency_Hz; // Start right at the start/stop frequency
+        }
+    }
+
+    if (Velocity == Goal)
+    {
+        Ramp->Remainder = 0;
+    }
+
+    Ramp->Velocity_Hz = (int32_t)Velocity;
+
+    return Ramp->Velocity_Hz;
+}
@@ -0,0 +1,38 @@
+/*H**********************************************************************
+ * FILENAME :        velocity_ramp.h             DESIGN REF: NA
+ *
+ * DESCRIPTION :
+ *       Hardware independent velocity ramp of the jog mode.
+ *
+ * NOTES :
+ *       The velocity is a signed step frequency, positive forward. Every
+ *       update moves it toward the target by at most the acceleration
+ *       times the elapsed time. A target on the other side of zero is
+ *       approached through zero, so a reversal decelerates to a stop
+ *       first. Speeds below the start/stop frequency are skipped: the motor
+ *       starts at that frequency and stops when falling below it.
+ *
+ *       Copyright: All rights reserved.
+ *
+ * AUTHOR     :  Saurabh kadam.
+ * START DATE :  17 Oct 2026
+ *H*/
+
+#ifndef VELOCITY_RAMP_H
+#define VELOCITY_RAMP_H
+
+#include <stdint.h>
+
+/** State of one velocity ramp */
+typedef struct
+{
+    int32_t Velocity_Hz;       // Current signed step frequency, positive forward
+    uint32_t Acceleration;     // Acceleration limit in steps/s^2
+    uint32_t Min_Frequency_Hz; // Start/stop frequency, lower speeds are skipped
+    uint32_t Remainder;        // Velocity change below 1 Hz carried to the next update, in Hz/1000000
+} Velocity_Ramp_t;
+
+void Velocity_Ramp_Begin(Velocity_Ramp_t *Ramp, int32_t Velocity_Hz, uint32_t Acceleration, uint32_t Min_Frequency_Hz);
+int32_t Velocity_Ramp_Update(Velocity_Ramp_t *Ramp, int32_t Target_Hz, uint32_t Elapsed_us);
+
+#endif // VELOCITY_RAMP_H